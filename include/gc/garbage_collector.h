@@ -17,7 +17,9 @@ public:
     virtual std::unique_ptr<GCContext>
     create_context(vm::ThreadContext* thread) = 0;
 
-    virtual void* allocate(size_t size) = 0;
+    /* Objects that own no memory outside the GC heap can skip the finalizer
+     * that runs their destructor */
+    virtual void* allocate(size_t size, bool finalize = true) = 0;
 
     virtual void start_gc() {}
 
@@ -19,7 +19,7 @@ public:
     virtual std::unique_ptr<GCContext>
     create_context(vm::ThreadContext* thread);
 
-    virtual void* allocate(size_t size);
+    virtual void* allocate(size_t size, bool finalize = true);
 
     virtual void start_gc();
 
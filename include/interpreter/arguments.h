@@ -41,6 +41,16 @@ public:
           keyword_values(keyword_values)
     {}
 
+    /* Positional arguments and keywords as passed by the caller, for
+     * callables that forward or inspect them without parsing */
+    std::size_t size() const { return args.size(); }
+    objects::M_BaseObject* operator[](std::size_t i) const { return args[i]; }
+    const std::vector<std::string>& get_keywords() const { return keywords; }
+    const std::vector<objects::M_BaseObject*>& get_keyword_values() const
+    {
+        return keyword_values;
+    }
+
     objects::M_BaseObject* front() const { return args.front(); }
     void pop_front() { args.pop_front(); }
     void prepend(objects::M_BaseObject* obj) { args.push_front(obj); }
@@ -137,6 +137,8 @@ public:
 
     void* operator new(size_t size) { return ::operator new(size); }
 
+    InterpFunction1 get_func() const { return func; }
+
     mtpython::objects::M_BaseObject*
     funcrun(vm::ThreadContext* context, mtpython::objects::M_BaseObject* func,
             Arguments& args)
@@ -169,6 +171,8 @@ public:
 
     void* operator new(size_t size) { return ::operator new(size); }
 
+    InterpFunction2 get_func() const { return func; }
+
     mtpython::objects::M_BaseObject*
     funcrun(vm::ThreadContext* context, mtpython::objects::M_BaseObject* func,
             Arguments& args)
@@ -201,6 +205,8 @@ public:
 
     void* operator new(size_t size) { return ::operator new(size); }
 
+    InterpFunction3 get_func() const { return func; }
+
     mtpython::objects::M_BaseObject*
     funcrun(vm::ThreadContext* context, mtpython::objects::M_BaseObject* func,
             Arguments& args)
@@ -69,6 +69,18 @@ public:
     BreakUnwinder() { why_code = WHY_BREAK; }
 };
 
+class ContinueUnwinder : public StackUnwinder {
+private:
+    int target;
+
+public:
+    ContinueUnwinder(int target) : target(target)
+    {
+        why_code = WHY_CONTINUE;
+    }
+    int get_target() { return target; }
+};
+
 class FrameBlock {
 protected:
     int handler;
@@ -172,6 +184,11 @@ protected:
     }
 
     mtpython::objects::M_BaseObject* peek_value() { return value_stack.back(); }
+    /* the item n slots below the top */
+    mtpython::objects::M_BaseObject* peek_value(int n)
+    {
+        return value_stack[value_stack.size() - 1 - n];
+    }
 
     FrameBlock* pop_block()
     {
@@ -226,6 +243,7 @@ protected:
     int jump_forward(int arg, int next_pc);
     int pop_jump_if_false(int arg, int next_pc);
     void dup_top(int arg, int next_pc);
+    void dup_top_two(int arg, int next_pc);
     void rot_two(int arg, int next_pc);
     void rot_three(int arg, int next_pc);
     void compare_op(int arg, int next_pc);
@@ -237,6 +255,7 @@ protected:
     int for_iter(int arg, int next_pc);
     void _pop_block(int arg, int next_pc);
     int break_loop(int arg, int next_pc);
+    int continue_loop(int arg, int next_pc);
     void unary_positive(int arg, int next_pc);
     void unary_negative(int arg, int next_pc);
     void unary_not(int arg, int next_pc);
@@ -255,19 +274,24 @@ protected:
     void binary_getitem(int arg, int next_pc);
     void binary_subscr(int arg, int next_pc);
     void build_list(int arg, int next_pc);
+    void list_append(int arg, int next_pc);
     void import_from(int arg, int next_pc);
     void import_star(int arg, int next_pc);
     void build_set(int arg, int next_pc);
     void load_build_class(int arg, int next_pc);
     void build_map(int arg, int next_pc);
+    void store_map(int arg, int next_pc);
     void load_closure(int arg, int next_pc);
     void load_deref(int arg, int next_pc);
     void store_deref(int arg, int next_pc);
     void setup_with(int arg, int next_pc);
     void with_cleanup(int arg, int next_pc);
     void yield_value(int arg, int next_pc);
+    void raise_varargs(int arg, int next_pc);
     void unpack_sequence(int arg, int next_pc);
     void store_subscr(int arg, int next_pc);
+    void delete_subscr(int arg, int next_pc);
+    void build_slice(int arg, int next_pc);
 
     objects::M_BaseObject* end_finally();
 
@@ -0,0 +1,18 @@
+#ifndef _BISECTMODULE_H_
+#define _BISECTMODULE_H_
+
+#include "interpreter/module.h"
+#include "objects/obj_space.h"
+
+namespace mtpython {
+namespace modules {
+
+class BisectModule : public interpreter::BuiltinModule {
+public:
+    BisectModule(objects::ObjSpace* space, objects::M_BaseObject* name);
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _BISECTMODULE_H_ */
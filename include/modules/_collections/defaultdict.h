@@ -0,0 +1,58 @@
+#ifndef _COLLECTIONS_DEFAULTDICT_H_
+#define _COLLECTIONS_DEFAULTDICT_H_
+
+#include "objects/obj_space.h"
+#include "objects/std/dict_object.h"
+#include "interpreter/arguments.h"
+#include "gc/garbage_collector.h"
+
+namespace mtpython {
+namespace modules {
+
+/* dict that fills in missing keys by calling default_factory. The lookup
+ * goes through M_StdDictObject::missing(), so a miss costs one call of the
+ * factory and one insertion. */
+class M_DefaultDict : public objects::M_StdDictObject {
+private:
+    objects::M_BaseObject* default_factory; /* None if unset */
+
+public:
+    M_DefaultDict(objects::ObjSpace* space,
+                  objects::M_BaseObject* default_factory)
+        : M_StdDictObject(space), default_factory(default_factory)
+    {}
+
+    virtual objects::M_BaseObject* missing(vm::ThreadContext* context,
+                                           objects::M_BaseObject* key);
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        M_StdDictObject::mark_children(gc);
+        gc->mark_object(default_factory);
+    }
+
+    static objects::M_BaseObject* __new__(vm::ThreadContext* context,
+                                          const interpreter::Arguments& args);
+    static objects::M_BaseObject* __repr__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* __missing__(vm::ThreadContext* context,
+                                              objects::M_BaseObject* self,
+                                              objects::M_BaseObject* key);
+    static objects::M_BaseObject* copy(vm::ThreadContext* context,
+                                       objects::M_BaseObject* self);
+
+    static objects::M_BaseObject*
+    default_factory_get(vm::ThreadContext* context,
+                        objects::M_BaseObject* self);
+    static void default_factory_set(vm::ThreadContext* context,
+                                    objects::M_BaseObject* self,
+                                    objects::M_BaseObject* value);
+
+    static interpreter::Typedef* _defaultdict_typedef();
+    interpreter::Typedef* get_typedef();
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _COLLECTIONS_DEFAULTDICT_H_ */
@@ -0,0 +1,200 @@
+#ifndef _COLLECTIONS_DEQUE_H_
+#define _COLLECTIONS_DEQUE_H_
+
+#include "objects/obj_space.h"
+#include "interpreter/arguments.h"
+#include "gc/garbage_collector.h"
+
+namespace mtpython {
+namespace modules {
+
+#define DEQUE_BLOCKLEN 64
+/* an empty deque starts in the middle of its block so that it can grow in
+ * both directions before allocating */
+#define DEQUE_CENTER ((DEQUE_BLOCKLEN - 1) / 2)
+
+/* Fixed-size chunk of a deque. Blocks are linked into a doubly-linked list
+ * and unused slots are always nullptr, so a block can mark its slots
+ * without knowing which of them are in use. */
+class DequeBlock : public objects::M_BaseObject {
+public:
+    DequeBlock* leftlink;
+    DequeBlock* rightlink;
+    objects::M_BaseObject* items[DEQUE_BLOCKLEN];
+
+    DequeBlock() : leftlink(nullptr), rightlink(nullptr), items{} {}
+
+    void* operator new(std::size_t size, vm::ThreadContext* context)
+    {
+        return context->get_gc()->allocate(size, false);
+    }
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        if (leftlink) gc->mark_object(leftlink);
+        if (rightlink) gc->mark_object(rightlink);
+        for (auto* item : items) {
+            if (item) gc->mark_object(item);
+        }
+    }
+};
+
+/* Double-ended queue stored in a list of blocks. The items run from
+ * leftblock->items[leftindex] to rightblock->items[rightindex], so
+ * appending or popping at either end is O(1) and never moves other items.
+ * Blocks are allocated as an end fills up and unlinked as soon as they are
+ * emptied. */
+class M_Deque : public objects::M_BaseObject {
+private:
+    DequeBlock* leftblock;
+    DequeBlock* rightblock;
+    int leftindex;
+    int rightindex;
+    std::size_t length;
+    long maxlen; /* -1 if unbounded */
+    /* bumped by every mutation so that iterators can detect them */
+    std::size_t state;
+
+    friend class M_DequeIter;
+
+    void push_right(vm::ThreadContext* context, objects::M_BaseObject* item);
+    void push_left(vm::ThreadContext* context, objects::M_BaseObject* item);
+    objects::M_BaseObject* pop_right();
+    objects::M_BaseObject* pop_left();
+    /* Append at one end, dropping an item from the other end if the deque
+     * is full */
+    void append_bounded(vm::ThreadContext* context,
+                        objects::M_BaseObject* item, bool left);
+    objects::M_BaseObject*& item_at(std::size_t i);
+    void clear_items(vm::ThreadContext* context);
+    void rotate_items(vm::ThreadContext* context, long n);
+    /* Index of item, or -1. Raises RuntimeError if the deque is mutated by
+     * a comparison */
+    long find_item(vm::ThreadContext* context, objects::M_BaseObject* item);
+    void delete_item(vm::ThreadContext* context, std::size_t i);
+
+public:
+    M_Deque(vm::ThreadContext* context);
+
+    /* deque items live in GC blocks, there is nothing to finalize */
+    void* operator new(std::size_t size, vm::ThreadContext* context)
+    {
+        return context->get_gc()->allocate(size, false);
+    }
+
+    std::size_t size() const { return length; }
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(leftblock);
+        gc->mark_object(rightblock);
+    }
+
+    static objects::M_BaseObject* __new__(vm::ThreadContext* context,
+                                          const interpreter::Arguments& args);
+    static objects::M_BaseObject* __init__(vm::ThreadContext* context,
+                                           const interpreter::Arguments& args);
+    static objects::M_BaseObject* __repr__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* __len__(vm::ThreadContext* context,
+                                          objects::M_BaseObject* self);
+    static objects::M_BaseObject* __iter__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* __reversed__(vm::ThreadContext* context,
+                                               objects::M_BaseObject* self);
+    static objects::M_BaseObject* __contains__(vm::ThreadContext* context,
+                                               objects::M_BaseObject* self,
+                                               objects::M_BaseObject* item);
+    static objects::M_BaseObject* __getitem__(vm::ThreadContext* context,
+                                              objects::M_BaseObject* self,
+                                              objects::M_BaseObject* index);
+    static objects::M_BaseObject* __setitem__(vm::ThreadContext* context,
+                                              objects::M_BaseObject* self,
+                                              objects::M_BaseObject* index,
+                                              objects::M_BaseObject* value);
+    static objects::M_BaseObject* __delitem__(vm::ThreadContext* context,
+                                              objects::M_BaseObject* self,
+                                              objects::M_BaseObject* index);
+    static objects::M_BaseObject* __eq__(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* other);
+    static objects::M_BaseObject* __ne__(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* other);
+    static objects::M_BaseObject* __iadd__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self,
+                                           objects::M_BaseObject* other);
+
+    static objects::M_BaseObject* append(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* item);
+    static objects::M_BaseObject* appendleft(vm::ThreadContext* context,
+                                             objects::M_BaseObject* self,
+                                             objects::M_BaseObject* item);
+    static objects::M_BaseObject* pop(vm::ThreadContext* context,
+                                      objects::M_BaseObject* self);
+    static objects::M_BaseObject* popleft(vm::ThreadContext* context,
+                                          objects::M_BaseObject* self);
+    static objects::M_BaseObject* extend(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* iterable);
+    static objects::M_BaseObject* extendleft(vm::ThreadContext* context,
+                                             objects::M_BaseObject* self,
+                                             objects::M_BaseObject* iterable);
+    static objects::M_BaseObject* clear(vm::ThreadContext* context,
+                                        objects::M_BaseObject* self);
+    static objects::M_BaseObject* copy(vm::ThreadContext* context,
+                                       objects::M_BaseObject* self);
+    static objects::M_BaseObject* count(vm::ThreadContext* context,
+                                        objects::M_BaseObject* self,
+                                        objects::M_BaseObject* item);
+    static objects::M_BaseObject* index(vm::ThreadContext* context,
+                                        objects::M_BaseObject* self,
+                                        objects::M_BaseObject* item);
+    static objects::M_BaseObject* remove(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* item);
+    static objects::M_BaseObject* reverse(vm::ThreadContext* context,
+                                          objects::M_BaseObject* self);
+    static objects::M_BaseObject* rotate(vm::ThreadContext* context,
+                                         const interpreter::Arguments& args);
+
+    static objects::M_BaseObject* maxlen_get(vm::ThreadContext* context,
+                                             objects::M_BaseObject* self);
+
+    static interpreter::Typedef* _deque_typedef();
+    interpreter::Typedef* get_typedef();
+};
+
+/* Iterator over a deque in either direction. The iterator gives up with
+ * RuntimeError once the deque has been mutated. */
+class M_DequeIter : public objects::M_BaseObject {
+private:
+    M_Deque* deque;
+    DequeBlock* block;
+    int index;
+    std::size_t remaining;
+    std::size_t state;
+    bool reversed;
+
+public:
+    M_DequeIter(M_Deque* deque, bool reversed);
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(deque);
+        if (block) gc->mark_object(block);
+    }
+
+    static objects::M_BaseObject* __iter__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* __next__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+
+    interpreter::Typedef* get_typedef();
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _COLLECTIONS_DEQUE_H_ */
@@ -0,0 +1,18 @@
+#ifndef _FUNCTOOLSMODULE_H_
+#define _FUNCTOOLSMODULE_H_
+
+#include "interpreter/module.h"
+#include "objects/obj_space.h"
+
+namespace mtpython {
+namespace modules {
+
+class FunctoolsModule : public interpreter::BuiltinModule {
+public:
+    FunctoolsModule(objects::ObjSpace* space, objects::M_BaseObject* name);
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _FUNCTOOLSMODULE_H_ */
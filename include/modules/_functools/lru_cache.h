@@ -0,0 +1,126 @@
+#ifndef _FUNCTOOLS_LRU_CACHE_H_
+#define _FUNCTOOLS_LRU_CACHE_H_
+
+#include "objects/obj_space.h"
+#include "objects/gc_array.h"
+#include "interpreter/arguments.h"
+#include "gc/garbage_collector.h"
+
+namespace mtpython {
+namespace modules {
+
+/* Cached call of an lru_cache wrapper. Links are kept on a circular list in
+ * order of use, the root link is the sentinel between the most and the least
+ * recently used ones. Each link is also chained into a bucket of the hash
+ * table by its hash. */
+class LRUCacheLink : public objects::M_BaseObject {
+public:
+    LRUCacheLink* prev;
+    LRUCacheLink* next;
+    LRUCacheLink* chain;
+    std::size_t hash;
+    /* The positional arguments, then pairs of keyword names and values,
+     * then the types of all argument values if the cache is typed */
+    objects::M_GCArray<objects::M_BaseObject*>* key;
+    std::size_t nargs;
+    std::size_t nkwargs;
+    objects::M_BaseObject* result;
+
+    LRUCacheLink()
+        : prev(this), next(this), chain(nullptr), hash(0), key(nullptr),
+          nargs(0), nkwargs(0), result(nullptr)
+    {}
+
+    void* operator new(std::size_t size, vm::ThreadContext* context)
+    {
+        return context->get_gc()->allocate(size, false);
+    }
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(prev);
+        gc->mark_object(next);
+        if (chain) gc->mark_object(chain);
+        if (key) gc->mark_object(key);
+        if (result) gc->mark_object(result);
+    }
+};
+
+/* Memoizing wrapper behind functools.lru_cache. A call is looked up by
+ * hashing and comparing its arguments in place, so a hit does not allocate;
+ * the key is only copied out of the arguments when a result is stored. */
+class M_LRUCacheWrapper : public objects::M_BaseObject {
+private:
+    objects::M_BaseObject* func;
+    long maxsize; /* -1 if unbounded */
+    bool typed;
+    objects::M_BaseObject* cache_info_type; /* None for plain tuples */
+    objects::M_BaseObject* dict;
+
+    LRUCacheLink* root;
+    objects::M_GCArray<LRUCacheLink*>* buckets;
+    std::size_t count;
+    std::size_t hits;
+    std::size_t misses;
+    /* bumped when links are added or removed, lookups restart if a
+     * comparison changed the cache under them */
+    std::size_t state;
+
+    std::size_t hash_args(objects::ObjSpace* space,
+                          const interpreter::Arguments& args);
+    bool key_matches(objects::ObjSpace* space, LRUCacheLink* link,
+                     const interpreter::Arguments& args);
+    LRUCacheLink* find(objects::ObjSpace* space, std::size_t hash,
+                       const interpreter::Arguments& args);
+    void insert(vm::ThreadContext* context, std::size_t hash,
+                const interpreter::Arguments& args,
+                objects::M_BaseObject* result);
+    void unlink(LRUCacheLink* link);
+    void resize(vm::ThreadContext* context, std::size_t nbuckets);
+    void clear();
+
+public:
+    M_LRUCacheWrapper(vm::ThreadContext* context, objects::M_BaseObject* func,
+                      long maxsize, bool typed,
+                      objects::M_BaseObject* cache_info_type);
+
+    void* operator new(std::size_t size, vm::ThreadContext* context)
+    {
+        return context->get_gc()->allocate(size, false);
+    }
+
+    objects::M_BaseObject* get_dict(objects::ObjSpace* space);
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(func);
+        gc->mark_object(cache_info_type);
+        if (dict) gc->mark_object(dict);
+        gc->mark_object(root);
+        gc->mark_object(buckets);
+    }
+
+    static objects::M_BaseObject* __new__(vm::ThreadContext* context,
+                                          const interpreter::Arguments& args);
+    static objects::M_BaseObject* __call__(vm::ThreadContext* context,
+                                           const interpreter::Arguments& args);
+    static objects::M_BaseObject* __get__(vm::ThreadContext* context,
+                                          objects::M_BaseObject* self,
+                                          objects::M_BaseObject* obj,
+                                          objects::M_BaseObject* type);
+    static objects::M_BaseObject* cache_info(vm::ThreadContext* context,
+                                             objects::M_BaseObject* self);
+    static objects::M_BaseObject* cache_clear(vm::ThreadContext* context,
+                                              objects::M_BaseObject* self);
+
+    static objects::M_BaseObject* __dict__get(vm::ThreadContext* context,
+                                              objects::M_BaseObject* self);
+
+    static interpreter::Typedef* _lru_cache_wrapper_typedef();
+    interpreter::Typedef* get_typedef();
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _FUNCTOOLS_LRU_CACHE_H_ */
@@ -0,0 +1,60 @@
+#ifndef _FUNCTOOLS_PARTIAL_H_
+#define _FUNCTOOLS_PARTIAL_H_
+
+#include "objects/obj_space.h"
+#include "interpreter/arguments.h"
+#include "gc/garbage_collector.h"
+
+namespace mtpython {
+namespace modules {
+
+/* Callable with some arguments of func filled in. A call builds one argument
+ * list out of the stored and the new arguments and passes it straight to
+ * ObjSpace::call_args(), without packing them into a tuple and a dict
+ * first. */
+class M_Partial : public objects::M_BaseObject {
+private:
+    objects::M_BaseObject* func;
+    objects::M_BaseObject* args;     /* tuple */
+    objects::M_BaseObject* keywords; /* dict */
+
+public:
+    M_Partial(objects::M_BaseObject* func, objects::M_BaseObject* args,
+              objects::M_BaseObject* keywords)
+        : func(func), args(args), keywords(keywords)
+    {}
+
+    void* operator new(std::size_t size, vm::ThreadContext* context)
+    {
+        return context->get_gc()->allocate(size, false);
+    }
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(func);
+        gc->mark_object(args);
+        gc->mark_object(keywords);
+    }
+
+    static objects::M_BaseObject* __new__(vm::ThreadContext* context,
+                                          const interpreter::Arguments& args);
+    static objects::M_BaseObject* __call__(vm::ThreadContext* context,
+                                           const interpreter::Arguments& args);
+    static objects::M_BaseObject* __repr__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+
+    static objects::M_BaseObject* func_get(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* args_get(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* keywords_get(vm::ThreadContext* context,
+                                               objects::M_BaseObject* self);
+
+    static interpreter::Typedef* _partial_typedef();
+    interpreter::Typedef* get_typedef();
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _FUNCTOOLS_PARTIAL_H_ */
@@ -0,0 +1,18 @@
+#ifndef _HEAPQMODULE_H_
+#define _HEAPQMODULE_H_
+
+#include "interpreter/module.h"
+#include "objects/obj_space.h"
+
+namespace mtpython {
+namespace modules {
+
+class HeapqModule : public interpreter::BuiltinModule {
+public:
+    HeapqModule(objects::ObjSpace* space, objects::M_BaseObject* name);
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _HEAPQMODULE_H_ */
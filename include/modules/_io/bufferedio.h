@@ -1,13 +1,19 @@
 #ifndef _BUFFEREDIO_H_
 #define _BUFFEREDIO_H_
 
+#include <cstdint>
+
 #include "interpreter/arguments.h"
 #include "objects/obj_space.h"
+#include "objects/gc_array.h"
+#include "gc/garbage_collector.h"
 #include "modules/_io/iobase.h"
 
 namespace mtpython {
 namespace modules {
 
+class M_FileIO;
+
 class M_BufferedIOBase : public M_IOBase {
 public:
     M_BufferedIOBase(objects::ObjSpace* space) : M_IOBase(space) {}
@@ -15,39 +21,135 @@ public:
     interpreter::Typedef* get_typedef();
 };
 
+/* Common part of the buffered readers and writers. The buffer is a GC array
+ * of buffer_size bytes allocated by __init__. If raw is a FileIO the buffer
+ * is filled and drained with direct calls on its descriptor, otherwise
+ * through the read() and write() methods of raw. */
 class BufferedBase : public M_BufferedIOBase {
 protected:
     objects::M_BaseObject* raw;
+    M_FileIO* raw_fileio; /* raw if it is a FileIO, nullptr otherwise */
+    objects::M_GCArray<std::uint8_t>* buffer;
+    std::size_t buffer_size;
+
+    void init(vm::ThreadContext* context, objects::M_BaseObject* raw,
+              int buffer_size);
+    void check_initialized(vm::ThreadContext* context);
+
+    /* One read of at most n bytes from raw, 0 at end of file */
+    std::size_t raw_read(vm::ThreadContext* context, std::uint8_t* dst,
+                         std::size_t n);
+    /* One write of at most n bytes to raw, returns the bytes written */
+    std::size_t raw_write(vm::ThreadContext* context, const std::uint8_t* src,
+                          std::size_t n);
 
 public:
-    BufferedBase(objects::ObjSpace* space) : M_BufferedIOBase(space) {}
+    BufferedBase(objects::ObjSpace* space)
+        : M_BufferedIOBase(space), raw(nullptr), raw_fileio(nullptr),
+          buffer(nullptr), buffer_size(0)
+    {}
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        M_BufferedIOBase::mark_children(gc);
+        if (raw) gc->mark_object(raw);
+        if (buffer) gc->mark_object(buffer);
+    }
 
     static objects::M_BaseObject* name_get(vm::ThreadContext* context,
                                            objects::M_BaseObject* self);
+    static objects::M_BaseObject* closed_get(vm::ThreadContext* context,
+                                             objects::M_BaseObject* self);
+    static objects::M_BaseObject* fileno(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self);
 };
 
+/* Reads are served from buffer[pos, end). Requests of at least buffer_size
+ * bytes bypass the buffer and go straight into the result. */
 class M_BufferedReader : public BufferedBase {
+private:
+    std::size_t pos;
+    std::size_t end;
+
+    std::size_t available() const { return end - pos; }
+    /* Refill the empty buffer with one raw read, 0 at end of file */
+    std::size_t fill_buffer(vm::ThreadContext* context);
+    /* Copy up to n bytes to dst, reading from raw until n bytes are copied
+     * or the end of file is reached */
+    std::size_t read_into(vm::ThreadContext* context, std::uint8_t* dst,
+                          std::size_t n);
+
 public:
-    M_BufferedReader(objects::ObjSpace* space) : BufferedBase(space) {}
+    M_BufferedReader(objects::ObjSpace* space)
+        : BufferedBase(space), pos(0), end(0)
+    {}
 
     interpreter::Typedef* get_typedef();
 
+    /* Unread part of the buffer for the text layer, refilled if it is
+     * empty. n is 0 at the end of file */
+    const std::uint8_t* buffered_data(vm::ThreadContext* context,
+                                      std::size_t& n);
+    void consume(std::size_t n) { pos += n; }
+
     static objects::M_BaseObject* __new__(vm::ThreadContext* context,
                                           const interpreter::Arguments& args);
     static objects::M_BaseObject* __init__(vm::ThreadContext* context,
                                            const interpreter::Arguments& args);
+
+    static objects::M_BaseObject* read(vm::ThreadContext* context,
+                                       const interpreter::Arguments& args);
+    static objects::M_BaseObject* read1(vm::ThreadContext* context,
+                                        const interpreter::Arguments& args);
+    static objects::M_BaseObject* readinto(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self,
+                                           objects::M_BaseObject* b);
+    static objects::M_BaseObject* peek(vm::ThreadContext* context,
+                                       const interpreter::Arguments& args);
+    static objects::M_BaseObject* readline(vm::ThreadContext* context,
+                                           const interpreter::Arguments& args);
+    static objects::M_BaseObject* readable(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* close(vm::ThreadContext* context,
+                                        objects::M_BaseObject* self);
 };
 
+/* Writes are collected in buffer[0, pending) and handed to raw when the
+ * buffer is full, on flush() and on close(). Writes of at least buffer_size
+ * bytes go straight to raw after the pending bytes. */
 class M_BufferedWriter : public BufferedBase {
+private:
+    std::size_t pending;
+
+    void flush_buffer(vm::ThreadContext* context);
+    void write_all(vm::ThreadContext* context, const std::uint8_t* src,
+                   std::size_t n);
+
 public:
-    M_BufferedWriter(objects::ObjSpace* space) : BufferedBase(space) {}
+    M_BufferedWriter(objects::ObjSpace* space)
+        : BufferedBase(space), pending(0)
+    {}
 
     interpreter::Typedef* get_typedef();
 
+    /* Buffer n bytes from src, used by write() and the text layer */
+    void write_data(vm::ThreadContext* context, const std::uint8_t* src,
+                    std::size_t n);
+
     static objects::M_BaseObject* __new__(vm::ThreadContext* context,
                                           const interpreter::Arguments& args);
     static objects::M_BaseObject* __init__(vm::ThreadContext* context,
                                            const interpreter::Arguments& args);
+
+    static objects::M_BaseObject* write(vm::ThreadContext* context,
+                                        objects::M_BaseObject* self,
+                                        objects::M_BaseObject* b);
+    static objects::M_BaseObject* flush(vm::ThreadContext* context,
+                                        objects::M_BaseObject* self);
+    static objects::M_BaseObject* writable(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* close(vm::ThreadContext* context,
+                                        objects::M_BaseObject* self);
 };
 
 } // namespace modules
@@ -1,7 +1,12 @@
 #ifndef _FILEIO_H_
 #define _FILEIO_H_
 
+#include <cstdint>
+
 #include "objects/obj_space.h"
+#include "objects/std/bytes_object.h"
+#include "interpreter/arguments.h"
+#include "gc/garbage_collector.h"
 #include "modules/_io/iobase.h"
 
 namespace mtpython {
@@ -13,16 +18,60 @@ private:
     int fd;
     bool closefd;
 
+    void check_closed(vm::ThreadContext* context);
+
 public:
-    M_FileIO(mtpython::objects::ObjSpace* space) : M_RawIOBase(space) {}
+    M_FileIO(mtpython::objects::ObjSpace* space)
+        : M_RawIOBase(space), name(nullptr), fd(-1), closefd(true)
+    {}
 
     interpreter::Typedef* get_typedef();
 
+    bool is_closed() const { return fd < 0; }
+
+    /* Single read()/write() calls on the descriptor, retried on EINTR.
+     * These are used by the buffered layer to skip the method calls. */
+    std::size_t read_some(vm::ThreadContext* context, std::uint8_t* dst,
+                          std::size_t n);
+    std::size_t write_some(vm::ThreadContext* context, const std::uint8_t* src,
+                           std::size_t n);
+    /* Bytes holding the prefix followed by the rest of the file. The result
+     * is preallocated from fstat() so that a regular file is read with one
+     * call until the end of file. */
+    objects::M_StdBytesObject* read_to_end(vm::ThreadContext* context,
+                                           const std::uint8_t* prefix,
+                                           std::size_t prefix_len);
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        M_RawIOBase::mark_children(gc);
+        if (name) gc->mark_object(name);
+    }
+
     static objects::M_BaseObject* __new__(vm::ThreadContext* context,
                                           const interpreter::Arguments& args);
     static objects::M_BaseObject* __init__(vm::ThreadContext* context,
                                            const interpreter::Arguments& args);
 
+    /* readinto() and write() work directly on the memory of any object
+     * supporting the buffer protocol */
+    static objects::M_BaseObject* readinto(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self,
+                                           objects::M_BaseObject* buffer);
+    static objects::M_BaseObject* write(vm::ThreadContext* context,
+                                        objects::M_BaseObject* self,
+                                        objects::M_BaseObject* buffer);
+    static objects::M_BaseObject* read(vm::ThreadContext* context,
+                                       const interpreter::Arguments& args);
+    static objects::M_BaseObject* readall(vm::ThreadContext* context,
+                                          objects::M_BaseObject* self);
+    static objects::M_BaseObject* fileno(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self);
+    static objects::M_BaseObject* close(vm::ThreadContext* context,
+                                        objects::M_BaseObject* self);
+
+    static objects::M_BaseObject* closed_get(vm::ThreadContext* context,
+                                             objects::M_BaseObject* self);
     static objects::M_BaseObject* name_get(vm::ThreadContext* context,
                                            objects::M_BaseObject* self);
     static void name_set(vm::ThreadContext* context, objects::M_BaseObject* obj,
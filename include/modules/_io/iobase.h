@@ -2,6 +2,8 @@
 #define _IOBASE_H_
 
 #include "objects/obj_space.h"
+#include "interpreter/arguments.h"
+#include "gc/garbage_collector.h"
 
 namespace mtpython {
 namespace modules {
@@ -14,6 +16,30 @@ public:
     M_IOBase(mtpython::objects::ObjSpace* space);
 
     objects::M_BaseObject* get_dict(objects::ObjSpace* space) { return dict; }
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(dict);
+    }
+
+    /* Context manager and line iteration on top of the close() and
+     * readline() methods of the concrete stream */
+    static objects::M_BaseObject* __enter__(vm::ThreadContext* context,
+                                            objects::M_BaseObject* self);
+    static objects::M_BaseObject* __exit__(vm::ThreadContext* context,
+                                           const interpreter::Arguments& args);
+    static objects::M_BaseObject* __iter__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* __next__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+
+    /* Defaults for streams that override none of them */
+    static objects::M_BaseObject* readable(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* writable(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* flush(vm::ThreadContext* context,
+                                        objects::M_BaseObject* self);
 };
 
 class M_RawIOBase : public M_IOBase {
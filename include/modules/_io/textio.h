@@ -1,38 +1,132 @@
 #ifndef _TEXTIO_H_
 #define _TEXTIO_H_
 
+#include <cstdint>
+#include <string>
+
 #include "objects/obj_space.h"
+#include "interpreter/arguments.h"
+#include "gc/garbage_collector.h"
 #include "modules/_io/iobase.h"
 
 namespace mtpython {
 namespace modules {
 
+class M_BufferedReader;
+class M_BufferedWriter;
+
 class M_TextIOBase : public M_IOBase {
 public:
     M_TextIOBase(mtpython::objects::ObjSpace* space) : M_IOBase(space) {}
 };
 
+/* Text stream over a buffered binary stream. Lines are split on the encoded
+ * bytes, which works for the supported codecs because newlines are ASCII and
+ * never occur inside a multi-byte UTF-8 sequence. The bytes of a line are
+ * collected into one string, with universal newlines translated on the way,
+ * and then decoded. Valid UTF-8 is moved into the str as it is. If buffer is
+ * a BufferedReader its buffer is scanned in place, other streams are read
+ * in chunks with read1(). */
 class M_TextIOWrapper : public M_TextIOBase {
 private:
+    enum class Newline {
+        TRANSLATE, /* None: \r and \r\n read as \n */
+        UNIVERSAL, /* "": lines end with \r, \n or \r\n, untranslated */
+        LF,
+        CR,
+        CRLF,
+    };
+
     objects::M_BaseObject* buffer;
     objects::M_BaseObject* encoding;
+    M_BufferedReader* reader; /* buffer if it is a BufferedReader */
+    M_BufferedWriter* writer; /* buffer if it is a BufferedWriter */
+    objects::M_BaseObject* chunk; /* last read1() result of other buffers */
+    std::size_t chunk_pos;
+
+    std::string codec;
+    std::string errors;
+    bool utf8;
+    Newline newline;
+    const char* write_newline; /* nullptr if \n is written as it is */
+    bool line_buffering;
+    bool skip_lf; /* a translated \r ended the last chunk */
+
+    void check_initialized(vm::ThreadContext* context);
+
+    /* Unread encoded bytes, nullptr at the end of file */
+    const std::uint8_t* next_chunk(vm::ThreadContext* context,
+                                   std::size_t& n);
+    void consume(std::size_t n);
+
+    /* Offset of the first byte in p[0, n) that ends a line or needs to be
+     * translated, n if there is none */
+    std::size_t find_special(const std::uint8_t* p, std::size_t n,
+                             bool line) const;
+    /* Append the bytes of up to limit characters to out, up to and
+     * including the first line ending if line is true */
+    void read_text(vm::ThreadContext* context, std::string& out,
+                   std::size_t limit, bool line);
+    /* Append n bytes to out with universal newlines translated if enabled */
+    void translate_into(std::string& out, const std::uint8_t* p,
+                        std::size_t n);
+    void read_all(vm::ThreadContext* context, std::string& out);
+    objects::M_BaseObject* make_str(vm::ThreadContext* context,
+                                    std::string& data);
 
 public:
-    M_TextIOWrapper(mtpython::objects::ObjSpace* space) : M_TextIOBase(space) {}
+    M_TextIOWrapper(mtpython::objects::ObjSpace* space)
+        : M_TextIOBase(space), buffer(nullptr), encoding(nullptr),
+          reader(nullptr), writer(nullptr), chunk(nullptr), chunk_pos(0),
+          utf8(true), newline(Newline::TRANSLATE), write_newline(nullptr),
+          line_buffering(false), skip_lf(false)
+    {}
 
     interpreter::Typedef* get_typedef();
 
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        M_TextIOBase::mark_children(gc);
+        if (buffer) gc->mark_object(buffer);
+        if (encoding) gc->mark_object(encoding);
+        if (chunk) gc->mark_object(chunk);
+    }
+
     static objects::M_BaseObject* __new__(vm::ThreadContext* context,
                                           const interpreter::Arguments& args);
     static objects::M_BaseObject* __init__(vm::ThreadContext* context,
                                            const interpreter::Arguments& args);
     static objects::M_BaseObject* __repr__(vm::ThreadContext* context,
                                            objects::M_BaseObject* self);
+    static objects::M_BaseObject* __next__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+
+    static objects::M_BaseObject* read(vm::ThreadContext* context,
+                                       const interpreter::Arguments& args);
+    static objects::M_BaseObject* readline(vm::ThreadContext* context,
+                                           const interpreter::Arguments& args);
+    static objects::M_BaseObject* write(vm::ThreadContext* context,
+                                        objects::M_BaseObject* self,
+                                        objects::M_BaseObject* text);
+    static objects::M_BaseObject* flush(vm::ThreadContext* context,
+                                        objects::M_BaseObject* self);
+    static objects::M_BaseObject* close(vm::ThreadContext* context,
+                                        objects::M_BaseObject* self);
+    static objects::M_BaseObject* readable(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* writable(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* fileno(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self);
 
     static objects::M_BaseObject* name_get(vm::ThreadContext* context,
                                            objects::M_BaseObject* self);
     static objects::M_BaseObject* buffer_get(vm::ThreadContext* context,
                                              objects::M_BaseObject* self);
+    static objects::M_BaseObject* encoding_get(vm::ThreadContext* context,
+                                               objects::M_BaseObject* self);
+    static objects::M_BaseObject* closed_get(vm::ThreadContext* context,
+                                             objects::M_BaseObject* self);
 };
 
 } // namespace modules
@@ -0,0 +1,83 @@
+#ifndef _JSON_BYTESCAN_H_
+#define _JSON_BYTESCAN_H_
+
+#include <cstdint>
+#include <cstring>
+
+namespace mtpython {
+namespace modules {
+
+/* Byte scanning shared by the decoder and the encoder. Both look at eight
+ * bytes per step with plain 64-bit arithmetic: (x - 0x01..01 * n) & ~x has
+ * the high bit set in every byte of x that is below n, with possible false
+ * positives only in bytes above a true one. So a non-zero result always
+ * means the word holds a match, and the byte loop that follows finds it. */
+
+static constexpr std::uint64_t swar_ones = 0x0101010101010101ULL;
+static constexpr std::uint64_t swar_highs = 0x8080808080808080ULL;
+
+static inline std::uint64_t swar_load(const char* p)
+{
+    std::uint64_t x;
+    std::memcpy(&x, p, sizeof(x));
+    return x;
+}
+
+/* High bit of every byte of x that is below n (n <= 0x80) */
+static inline std::uint64_t swar_less(std::uint64_t x, unsigned char n)
+{
+    return (x - swar_ones * n) & ~x & swar_highs;
+}
+
+/* High bit of every byte of x that equals c */
+static inline std::uint64_t swar_equal(std::uint64_t x, unsigned char c)
+{
+    return swar_less(x ^ (swar_ones * c), 1);
+}
+
+static inline bool is_json_whitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/* First byte in [p, end) that is not JSON whitespace. Indentation comes in
+ * runs of spaces, which are skipped a word at a time */
+static inline const char* skip_json_whitespace(const char* p, const char* end)
+{
+    for (;;) {
+        while (end - p >= 8 && swar_load(p) == swar_ones * ' ')
+            p += 8;
+        if (p == end || !is_json_whitespace(*p)) return p;
+        p++;
+    }
+}
+
+/* First byte in [p, end) that ends a run of literal string characters:
+ * a quote, a backslash or a control character. With non_ascii set, DEL and
+ * the bytes of multibyte UTF-8 sequences end a run too */
+static inline bool is_string_special(unsigned char c, bool non_ascii)
+{
+    return c == '"' || c == '\\' || c < 0x20 || (non_ascii && c >= 0x7f);
+}
+
+static inline const char* find_string_special(const char* p, const char* end,
+                                              bool non_ascii)
+{
+    while (end - p >= 8) {
+        std::uint64_t x = swar_load(p);
+        std::uint64_t hits =
+            swar_equal(x, '"') | swar_equal(x, '\\') | swar_less(x, 0x20);
+        if (non_ascii) hits |= (x & swar_highs) | swar_equal(x, 0x7f);
+        if (hits) break;
+        p += 8;
+    }
+
+    while (p < end && !is_string_special((unsigned char)*p, non_ascii))
+        p++;
+    return p;
+}
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _JSON_BYTESCAN_H_ */
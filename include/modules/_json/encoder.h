@@ -0,0 +1,79 @@
+#ifndef _JSON_ENCODER_H_
+#define _JSON_ENCODER_H_
+
+#include <string>
+
+#include "objects/obj_space.h"
+#include "interpreter/arguments.h"
+#include "gc/garbage_collector.h"
+
+namespace mtpython {
+namespace modules {
+
+/* Append s to out as a quoted JSON string. With ascii_only set everything
+ * outside printable ASCII is written as \uXXXX escapes, otherwise only
+ * quotes, backslashes and control characters are escaped */
+void encode_json_string(const std::string& s, bool ascii_only,
+                        std::string& out);
+
+/* The c_make_encoder() of a json.JSONEncoder without indentation. A call
+ * writes the whole document into one native buffer and returns it as the
+ * only chunk. Strings are escaped without calling back into the encoder
+ * function when it is one of the functions of _json. */
+class M_JSONEncoder : public objects::M_BaseObject {
+private:
+    objects::M_BaseObject* markers;
+    objects::M_BaseObject* default_fn;
+    objects::M_BaseObject* encoder;
+    objects::M_BaseObject* indent;
+    objects::M_BaseObject* key_separator;
+    objects::M_BaseObject* item_separator;
+    bool sort_keys;
+    bool skipkeys;
+    bool allow_nan;
+
+    friend class JSONEncodeState;
+
+public:
+    M_JSONEncoder(objects::M_BaseObject* markers,
+                  objects::M_BaseObject* default_fn,
+                  objects::M_BaseObject* encoder, objects::M_BaseObject* indent,
+                  objects::M_BaseObject* key_separator,
+                  objects::M_BaseObject* item_separator, bool sort_keys,
+                  bool skipkeys, bool allow_nan)
+        : markers(markers), default_fn(default_fn), encoder(encoder),
+          indent(indent), key_separator(key_separator),
+          item_separator(item_separator), sort_keys(sort_keys),
+          skipkeys(skipkeys), allow_nan(allow_nan)
+    {}
+
+    void* operator new(std::size_t size, vm::ThreadContext* context)
+    {
+        return context->get_gc()->allocate(size, false);
+    }
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(markers);
+        gc->mark_object(default_fn);
+        gc->mark_object(encoder);
+        gc->mark_object(indent);
+        gc->mark_object(key_separator);
+        gc->mark_object(item_separator);
+    }
+
+    static objects::M_BaseObject* __new__(vm::ThreadContext* context,
+                                          const interpreter::Arguments& args);
+    static objects::M_BaseObject* __call__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self,
+                                           objects::M_BaseObject* obj,
+                                           objects::M_BaseObject* indent_level);
+
+    static interpreter::Typedef* _encoder_typedef();
+    interpreter::Typedef* get_typedef();
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _JSON_ENCODER_H_ */
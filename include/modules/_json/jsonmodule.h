@@ -0,0 +1,29 @@
+#ifndef _JSONMODULE_H_
+#define _JSONMODULE_H_
+
+#include "interpreter/module.h"
+#include "objects/obj_space.h"
+
+namespace mtpython {
+namespace modules {
+
+class JsonModule : public interpreter::BuiltinModule {
+private:
+    static objects::M_BaseObject* ascii_escaper;
+    static objects::M_BaseObject* unicode_escaper;
+
+public:
+    JsonModule(objects::ObjSpace* space, objects::M_BaseObject* name);
+
+    /* _json.encode_basestring_ascii and _json.encode_basestring */
+    static objects::M_BaseObject* get_ascii_escaper() { return ascii_escaper; }
+    static objects::M_BaseObject* get_unicode_escaper()
+    {
+        return unicode_escaper;
+    }
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _JSONMODULE_H_ */
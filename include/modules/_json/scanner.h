@@ -0,0 +1,83 @@
+#ifndef _JSON_SCANNER_H_
+#define _JSON_SCANNER_H_
+
+#include <string>
+
+#include "objects/obj_space.h"
+#include "objects/std/unicode_object.h"
+#include "interpreter/arguments.h"
+#include "interpreter/error.h"
+#include "gc/garbage_collector.h"
+
+namespace mtpython {
+namespace modules {
+
+/* Decode the body of the JSON string in doc that starts at byte offset
+ * begin, just past the opening quote, and append it to out. Returns the
+ * byte offset past the closing quote */
+std::size_t decode_json_string(vm::ThreadContext* context,
+                               objects::M_StdUnicodeObject* doc,
+                               std::size_t begin, bool strict,
+                               std::string& out);
+
+/* ValueError for msg at byte offset pos of doc, with the line, column and
+ * character index of pos like json.decoder.errmsg() */
+interpreter::InterpError json_error(vm::ThreadContext* context,
+                                    objects::M_StdUnicodeObject* doc,
+                                    const char* msg, std::size_t pos);
+
+/* The scan_once() of a json.JSONDecoder. Objects and arrays are built
+ * directly into dicts and lists, and numbers are converted natively unless
+ * the decoder has its own parse_int or parse_float. */
+class M_JSONScanner : public objects::M_BaseObject {
+private:
+    bool strict;
+    objects::M_BaseObject* object_hook;
+    objects::M_BaseObject* object_pairs_hook;
+    objects::M_BaseObject* parse_float;
+    objects::M_BaseObject* parse_int;
+    objects::M_BaseObject* parse_constant;
+
+    friend class JSONDecodeState;
+
+public:
+    M_JSONScanner(bool strict, objects::M_BaseObject* object_hook,
+                  objects::M_BaseObject* object_pairs_hook,
+                  objects::M_BaseObject* parse_float,
+                  objects::M_BaseObject* parse_int,
+                  objects::M_BaseObject* parse_constant)
+        : strict(strict), object_hook(object_hook),
+          object_pairs_hook(object_pairs_hook), parse_float(parse_float),
+          parse_int(parse_int), parse_constant(parse_constant)
+    {}
+
+    void* operator new(std::size_t size, vm::ThreadContext* context)
+    {
+        return context->get_gc()->allocate(size, false);
+    }
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(object_hook);
+        gc->mark_object(object_pairs_hook);
+        gc->mark_object(parse_float);
+        gc->mark_object(parse_int);
+        gc->mark_object(parse_constant);
+    }
+
+    static objects::M_BaseObject* __new__(vm::ThreadContext* context,
+                                          objects::M_BaseObject* type,
+                                          objects::M_BaseObject* ctx);
+    static objects::M_BaseObject* __call__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self,
+                                           objects::M_BaseObject* string,
+                                           objects::M_BaseObject* idx);
+
+    static interpreter::Typedef* _scanner_typedef();
+    interpreter::Typedef* get_typedef();
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _JSON_SCANNER_H_ */
@@ -0,0 +1,90 @@
+#ifndef _RANDOM_RANDOM_H_
+#define _RANDOM_RANDOM_H_
+
+#include <cstdint>
+
+#include "objects/obj_space.h"
+#include "interpreter/arguments.h"
+#include "gc/garbage_collector.h"
+
+namespace mtpython {
+namespace modules {
+
+/* Mersenne Twister generator of _random.Random. Seeding follows CPython's
+ * init_by_array(), so the same int seed gives the same sequence of
+ * random() and getrandbits() values. Random may be subclassed, instances of
+ * a subclass keep their type and dict. */
+class M_Random : public objects::M_BaseObject {
+public:
+    static const int N = 624;
+
+private:
+    objects::M_BaseObject* cls;
+    objects::M_BaseObject* dict;
+    std::uint32_t state[N];
+    int index;
+
+    void init_genrand(std::uint32_t s);
+    void init_by_array(const std::uint32_t* key, std::size_t key_length);
+
+public:
+    M_Random(objects::M_BaseObject* cls, objects::M_BaseObject* dict)
+        : cls(cls), dict(dict), index(N + 1)
+    {}
+
+    void* operator new(std::size_t size, vm::ThreadContext* context)
+    {
+        return context->get_gc()->allocate(size, false);
+    }
+
+    std::uint32_t genrand_uint32();
+    /* Uniform double in [0.0, 1.0) with 53 random bits */
+    double genrand_double()
+    {
+        std::uint32_t a = genrand_uint32() >> 5;
+        std::uint32_t b = genrand_uint32() >> 6;
+        return (a * 67108864.0 + b) * (1.0 / 9007199254740992.0);
+    }
+    /* Uniform integer in [0, n), by rejection like random._randbelow() */
+    std::uint32_t randbelow(std::uint32_t n);
+
+    void seed_from(vm::ThreadContext* context, objects::M_BaseObject* arg);
+
+    objects::M_BaseObject* get_class(objects::ObjSpace* space) { return cls; }
+    objects::M_BaseObject* get_dict(objects::ObjSpace* space) { return dict; }
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(cls);
+        gc->mark_object(dict);
+    }
+
+    static objects::M_BaseObject* __new__(vm::ThreadContext* context,
+                                          const interpreter::Arguments& args);
+    static objects::M_BaseObject* seed(vm::ThreadContext* context,
+                                       const interpreter::Arguments& args);
+    static objects::M_BaseObject* random(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self);
+    static objects::M_BaseObject* getrandbits(vm::ThreadContext* context,
+                                              objects::M_BaseObject* self,
+                                              objects::M_BaseObject* k);
+    static objects::M_BaseObject* getstate(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* setstate(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self,
+                                           objects::M_BaseObject* state);
+    static objects::M_BaseObject* choices(vm::ThreadContext* context,
+                                          const interpreter::Arguments& args);
+    static objects::M_BaseObject* sample(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* population,
+                                         objects::M_BaseObject* k);
+
+    static interpreter::Typedef* _random_typedef();
+    virtual interpreter::Typedef* get_typedef();
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _RANDOM_RANDOM_H_ */
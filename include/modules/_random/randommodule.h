@@ -0,0 +1,18 @@
+#ifndef _RANDOMMODULE_H_
+#define _RANDOMMODULE_H_
+
+#include "interpreter/module.h"
+#include "objects/obj_space.h"
+
+namespace mtpython {
+namespace modules {
+
+class RandomModule : public interpreter::BuiltinModule {
+public:
+    RandomModule(objects::ObjSpace* space, objects::M_BaseObject* name);
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _RANDOMMODULE_H_ */
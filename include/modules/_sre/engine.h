@@ -0,0 +1,159 @@
+#ifndef _SRE_ENGINE_H_
+#define _SRE_ENGINE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "objects/obj_space.h"
+
+namespace mtpython {
+namespace modules {
+
+/* Compiled patterns are made of 32-bit code words (_sre.CODESIZE == 4).
+ * Interpreter ints are signed 32-bit, so code words above INT_MAX arrive as
+ * negative ints and MAXREPEAT is the largest int rather than 2**32-1 */
+typedef std::uint32_t SreCode;
+
+#define SRE_MAGIC 20031017
+#define SRE_CODESIZE 4
+#define SRE_MAXREPEAT 0x7fffffff
+#define SRE_MAXGROUPS 0x3fffffff
+
+/* sre_constants.OPCODES */
+enum SreOpcode {
+    SRE_OP_FAILURE = 0,
+    SRE_OP_SUCCESS = 1,
+    SRE_OP_ANY = 2,
+    SRE_OP_ANY_ALL = 3,
+    SRE_OP_ASSERT = 4,
+    SRE_OP_ASSERT_NOT = 5,
+    SRE_OP_AT = 6,
+    SRE_OP_BRANCH = 7,
+    SRE_OP_CALL = 8,
+    SRE_OP_CATEGORY = 9,
+    SRE_OP_CHARSET = 10,
+    SRE_OP_BIGCHARSET = 11,
+    SRE_OP_GROUPREF = 12,
+    SRE_OP_GROUPREF_EXISTS = 13,
+    SRE_OP_GROUPREF_IGNORE = 14,
+    SRE_OP_IN = 15,
+    SRE_OP_IN_IGNORE = 16,
+    SRE_OP_INFO = 17,
+    SRE_OP_JUMP = 18,
+    SRE_OP_LITERAL = 19,
+    SRE_OP_LITERAL_IGNORE = 20,
+    SRE_OP_MARK = 21,
+    SRE_OP_MAX_UNTIL = 22,
+    SRE_OP_MIN_UNTIL = 23,
+    SRE_OP_NOT_LITERAL = 24,
+    SRE_OP_NOT_LITERAL_IGNORE = 25,
+    SRE_OP_NEGATE = 26,
+    SRE_OP_RANGE = 27,
+    SRE_OP_REPEAT = 28,
+    SRE_OP_REPEAT_ONE = 29,
+    SRE_OP_SUBPATTERN = 30,
+    SRE_OP_MIN_REPEAT_ONE = 31,
+};
+
+/* sre_constants.SRE_FLAG_* and SRE_INFO_* */
+#define SRE_FLAG_IGNORECASE 2
+#define SRE_FLAG_LOCALE 4
+#define SRE_FLAG_MULTILINE 8
+#define SRE_FLAG_DOTALL 16
+#define SRE_FLAG_UNICODE 32
+
+#define SRE_INFO_PREFIX 1
+#define SRE_INFO_LITERAL 2
+#define SRE_INFO_CHARSET 4
+
+/* Lower case of ch the way a pattern compiled with flags folds it */
+std::uint32_t sre_getlower(std::uint32_t ch, int flags);
+
+/* The code of a compiled pattern together with what its INFO block tells
+ * about where a match can start */
+class SreProgram {
+private:
+    std::vector<SreCode> code;
+    int flags;
+    std::size_t body;       /* first code word after the INFO block */
+    std::size_t min_width;  /* lower bound of the match length */
+    std::vector<std::uint32_t> prefix; /* literal prefix of every match */
+    std::string prefix_bytes;          /* prefix if it is all below 256 */
+    bool prefix_is_bytes;
+    bool literal;            /* the prefix is the whole pattern */
+    std::size_t charset;     /* set of the first character, or 0 */
+
+    SreProgram() {}
+
+public:
+    /* The program of the code list built by sre_compile. Programs are cached
+     * by code and flags and shared by every pattern compiled to the same
+     * code */
+    static std::shared_ptr<const SreProgram>
+    get(vm::ThreadContext* context, objects::M_BaseObject* code, int flags);
+    static void clear_cache();
+
+    const SreCode* get_code() const { return code.data(); }
+    int get_flags() const { return flags; }
+
+    template <typename CharT> friend class SreEngine;
+};
+
+/* The string a pattern is matched against. ASCII str and bytes-like
+ * subjects are matched byte by byte, other str subjects are decoded to code
+ * points first. Positions are character indices either way. */
+struct SreSubject {
+    const unsigned char* narrow = nullptr;
+    const std::uint32_t* wide = nullptr;
+    std::size_t length = 0;
+    bool is_bytes = false;
+
+    std::string narrow_copy;
+    std::vector<std::uint32_t> wide_copy;
+
+    /* Fails with TypeError if obj is neither a str nor bytes-like */
+    void load(vm::ThreadContext* context, objects::M_BaseObject* obj);
+
+    std::uint32_t at(std::size_t i) const
+    {
+        return narrow ? narrow[i] : wide[i];
+    }
+};
+
+/* Where a match is tried and what it found. Group i (counting from 0, not
+ * from the whole match) spans marks[2i] to marks[2i + 1] if both are set
+ * and 2i + 1 is not beyond lastmark */
+struct SreState {
+    long start;
+    long end;
+    bool match_all; /* fullmatch() */
+
+    long match_start;
+    long match_end;
+    std::vector<long> marks;
+    int lastmark;
+    int lastindex;
+
+    SreState(long start, long end, std::size_t groups)
+        : start(start), end(end), match_all(false), match_start(-1),
+          match_end(-1), marks(groups * 2, -1), lastmark(-1), lastindex(-1)
+    {}
+
+    /* (start, end) of group i counting the whole match as group 0, -1 if
+     * the group did not take part in the match */
+    void get_span(std::size_t i, long& span_start, long& span_end) const;
+};
+
+/* Match the program at state.start or search for the first match in
+ * [state.start, state.end]. False if there is no match. */
+bool sre_match(vm::ThreadContext* context, const SreProgram& program,
+               const SreSubject& subject, SreState& state);
+bool sre_search(vm::ThreadContext* context, const SreProgram& program,
+                const SreSubject& subject, SreState& state);
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _SRE_ENGINE_H_ */
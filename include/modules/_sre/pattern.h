@@ -0,0 +1,186 @@
+#ifndef _SRE_PATTERN_H_
+#define _SRE_PATTERN_H_
+
+#include <memory>
+#include <vector>
+
+#include "modules/_sre/engine.h"
+#include "objects/obj_space.h"
+#include "interpreter/arguments.h"
+#include "interpreter/typedef.h"
+
+namespace mtpython {
+namespace modules {
+
+/* Compiled regular expression returned by _sre.compile() */
+class M_SrePattern : public objects::M_BaseObject {
+private:
+    objects::M_BaseObject* pattern; /* source str or bytes, may be None */
+    int flags;
+    std::size_t groups;
+    objects::M_BaseObject* groupindex; /* name -> group number */
+    objects::M_BaseObject* indexgroup; /* group number -> name or None */
+    std::shared_ptr<const SreProgram> program;
+
+public:
+    M_SrePattern(objects::M_BaseObject* pattern, int flags, std::size_t groups,
+                 objects::M_BaseObject* groupindex,
+                 objects::M_BaseObject* indexgroup,
+                 std::shared_ptr<const SreProgram> program)
+        : pattern(pattern), flags(flags), groups(groups),
+          groupindex(groupindex), indexgroup(indexgroup),
+          program(std::move(program))
+    {}
+
+    const SreProgram& get_program() const { return *program; }
+    std::size_t get_groups() const { return groups; }
+    objects::M_BaseObject* get_groupindex() const { return groupindex; }
+    objects::M_BaseObject* get_indexgroup() const { return indexgroup; }
+
+    /* Load string as the subject of the pattern, TypeError if it is bytes
+     * for a str pattern or the other way round */
+    void load_subject(vm::ThreadContext* context, objects::M_BaseObject* string,
+                      SreSubject& subject) const;
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(pattern);
+        gc->mark_object(groupindex);
+        gc->mark_object(indexgroup);
+    }
+
+    static objects::M_BaseObject* match(vm::ThreadContext* context,
+                                        const interpreter::Arguments& args);
+    static objects::M_BaseObject* fullmatch(vm::ThreadContext* context,
+                                            const interpreter::Arguments& args);
+    static objects::M_BaseObject* search(vm::ThreadContext* context,
+                                         const interpreter::Arguments& args);
+    static objects::M_BaseObject* findall(vm::ThreadContext* context,
+                                          const interpreter::Arguments& args);
+    static objects::M_BaseObject* finditer(vm::ThreadContext* context,
+                                           const interpreter::Arguments& args);
+    static objects::M_BaseObject* scanner(vm::ThreadContext* context,
+                                          const interpreter::Arguments& args);
+    static objects::M_BaseObject* sub(vm::ThreadContext* context,
+                                      const interpreter::Arguments& args);
+    static objects::M_BaseObject* subn(vm::ThreadContext* context,
+                                       const interpreter::Arguments& args);
+    static objects::M_BaseObject* split(vm::ThreadContext* context,
+                                        const interpreter::Arguments& args);
+
+    static objects::M_BaseObject* pattern_get(vm::ThreadContext* context,
+                                              objects::M_BaseObject* self);
+    static objects::M_BaseObject* flags_get(vm::ThreadContext* context,
+                                            objects::M_BaseObject* self);
+    static objects::M_BaseObject* groups_get(vm::ThreadContext* context,
+                                             objects::M_BaseObject* self);
+    static objects::M_BaseObject* groupindex_get(vm::ThreadContext* context,
+                                                 objects::M_BaseObject* self);
+
+    static interpreter::Typedef* _pattern_typedef();
+    virtual interpreter::Typedef* get_typedef();
+};
+
+/* Result of a successful match. regs holds the (start, end) character
+ * positions of every group, -1 for groups that did not take part */
+class M_SreMatch : public objects::M_BaseObject {
+private:
+    M_SrePattern* pattern;
+    objects::M_BaseObject* string;
+    long pos;
+    long endpos;
+    std::vector<long> regs;
+    int lastindex;
+
+public:
+    M_SreMatch(M_SrePattern* pattern, objects::M_BaseObject* string, long pos,
+               long endpos, const SreState& state);
+
+    M_SrePattern* get_pattern() const { return pattern; }
+
+    /* Text of group i of the match, default if it did not take part */
+    objects::M_BaseObject* get_group(vm::ThreadContext* context, std::size_t i,
+                                     objects::M_BaseObject* default_value);
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(pattern);
+        gc->mark_object(string);
+    }
+
+    static objects::M_BaseObject* __repr__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* group(vm::ThreadContext* context,
+                                        const interpreter::Arguments& args);
+    static objects::M_BaseObject* groups(vm::ThreadContext* context,
+                                         const interpreter::Arguments& args);
+    static objects::M_BaseObject* groupdict(vm::ThreadContext* context,
+                                            const interpreter::Arguments& args);
+    static objects::M_BaseObject* start(vm::ThreadContext* context,
+                                        const interpreter::Arguments& args);
+    static objects::M_BaseObject* end(vm::ThreadContext* context,
+                                      const interpreter::Arguments& args);
+    static objects::M_BaseObject* span(vm::ThreadContext* context,
+                                       const interpreter::Arguments& args);
+    static objects::M_BaseObject* expand(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* templ);
+
+    static objects::M_BaseObject* string_get(vm::ThreadContext* context,
+                                             objects::M_BaseObject* self);
+    static objects::M_BaseObject* re_get(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self);
+    static objects::M_BaseObject* pos_get(vm::ThreadContext* context,
+                                          objects::M_BaseObject* self);
+    static objects::M_BaseObject* endpos_get(vm::ThreadContext* context,
+                                             objects::M_BaseObject* self);
+    static objects::M_BaseObject* lastindex_get(vm::ThreadContext* context,
+                                                objects::M_BaseObject* self);
+    static objects::M_BaseObject* lastgroup_get(vm::ThreadContext* context,
+                                                objects::M_BaseObject* self);
+    static objects::M_BaseObject* regs_get(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+
+    static interpreter::Typedef* _match_typedef();
+    virtual interpreter::Typedef* get_typedef();
+};
+
+/* Successive matches of a pattern over a string, returned by
+ * Pattern.scanner() and used by finditer() and re.Scanner */
+class M_SreScanner : public objects::M_BaseObject {
+private:
+    M_SrePattern* pattern;
+    objects::M_BaseObject* string;
+    SreSubject subject;
+    long pos;
+    long endpos;
+    long start; /* where the next match is tried */
+
+public:
+    M_SreScanner(vm::ThreadContext* context, M_SrePattern* pattern,
+                 objects::M_BaseObject* string, long pos, long endpos);
+
+    /* Next match, or nullptr when the scanner is exhausted */
+    M_SreMatch* next_match(vm::ThreadContext* context, bool search);
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(pattern);
+        gc->mark_object(string);
+    }
+
+    static objects::M_BaseObject* match(vm::ThreadContext* context,
+                                        objects::M_BaseObject* self);
+    static objects::M_BaseObject* search(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self);
+    static objects::M_BaseObject* pattern_get(vm::ThreadContext* context,
+                                              objects::M_BaseObject* self);
+
+    static interpreter::Typedef* _scanner_typedef();
+    virtual interpreter::Typedef* get_typedef();
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _SRE_PATTERN_H_ */
@@ -0,0 +1,18 @@
+#ifndef _SREMODULE_H_
+#define _SREMODULE_H_
+
+#include "interpreter/module.h"
+#include "objects/obj_space.h"
+
+namespace mtpython {
+namespace modules {
+
+class SreModule : public interpreter::BuiltinModule {
+public:
+    SreModule(objects::ObjSpace* space, objects::M_BaseObject* name);
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _SREMODULE_H_ */
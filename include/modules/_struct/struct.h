@@ -0,0 +1,119 @@
+#ifndef _STRUCT_STRUCT_H_
+#define _STRUCT_STRUCT_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "objects/obj_space.h"
+#include "interpreter/arguments.h"
+#include "gc/garbage_collector.h"
+
+namespace mtpython {
+namespace modules {
+
+/* One packed value of a compiled format. Repeat counts are expanded except
+ * for 's' and 'p', whose size is the length of the string */
+struct StructCode {
+    char code;
+    std::size_t offset;
+    std::size_t size;
+};
+
+/* A format string compiled into the offsets and sizes of its values, so
+ * that packing and unpacking don't parse the format again */
+class StructLayout {
+private:
+    std::vector<StructCode> codes;
+    std::size_t size;
+    bool little_endian;
+
+    StructLayout() : size(0), little_endian(true) {}
+
+    static std::shared_ptr<const StructLayout>
+    compile(vm::ThreadContext* context, const std::string& format);
+
+public:
+    /* The layout of format. Layouts are cached by format string and shared
+     * with every Struct compiled from the same format */
+    static std::shared_ptr<const StructLayout>
+    get(vm::ThreadContext* context, objects::M_BaseObject* format);
+    static void clear_cache();
+
+    std::size_t get_size() const { return size; }
+    std::size_t get_count() const { return codes.size(); }
+
+    /* Pack values into get_size() bytes at dst */
+    void pack_values(vm::ThreadContext* context,
+                     objects::M_BaseObject* const* values,
+                     std::uint8_t* dst) const;
+    /* Tuple of the values stored in get_size() bytes at src */
+    objects::M_BaseObject* unpack_values(vm::ThreadContext* context,
+                                         const std::uint8_t* src) const;
+
+    /* The operations of Struct objects and the module functions. fname
+     * names the caller in errors about the number of values */
+    objects::M_BaseObject*
+    pack(vm::ThreadContext* context, const char* fname,
+         const std::vector<objects::M_BaseObject*>& values) const;
+    void pack_into(vm::ThreadContext* context, objects::M_BaseObject* buffer,
+                   objects::M_BaseObject* offset,
+                   const std::vector<objects::M_BaseObject*>& values) const;
+    objects::M_BaseObject* unpack(vm::ThreadContext* context,
+                                  objects::M_BaseObject* buffer) const;
+    objects::M_BaseObject* unpack_from(vm::ThreadContext* context,
+                                       objects::M_BaseObject* buffer,
+                                       objects::M_BaseObject* offset) const;
+};
+
+class M_Struct : public objects::M_BaseObject {
+private:
+    objects::M_BaseObject* format;
+    std::shared_ptr<const StructLayout> layout;
+
+public:
+    M_Struct(objects::M_BaseObject* format,
+             std::shared_ptr<const StructLayout> layout)
+        : format(format), layout(std::move(layout))
+    {}
+
+    const StructLayout& get_layout() const { return *layout; }
+
+    /* Iterator over the records in buffer */
+    objects::M_BaseObject* iter_records(vm::ThreadContext* context,
+                                        objects::M_BaseObject* buffer);
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(format);
+    }
+
+    static objects::M_BaseObject* __new__(vm::ThreadContext* context,
+                                          const interpreter::Arguments& args);
+    static objects::M_BaseObject* pack(vm::ThreadContext* context,
+                                       const interpreter::Arguments& args);
+    static objects::M_BaseObject* pack_into(vm::ThreadContext* context,
+                                            const interpreter::Arguments& args);
+    static objects::M_BaseObject* unpack(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* buffer);
+    static objects::M_BaseObject*
+    unpack_from(vm::ThreadContext* context, const interpreter::Arguments& args);
+    static objects::M_BaseObject* iter_unpack(vm::ThreadContext* context,
+                                              objects::M_BaseObject* self,
+                                              objects::M_BaseObject* buffer);
+
+    static objects::M_BaseObject* format_get(vm::ThreadContext* context,
+                                             objects::M_BaseObject* self);
+    static objects::M_BaseObject* size_get(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+
+    static interpreter::Typedef* _struct_typedef();
+    interpreter::Typedef* get_typedef();
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _STRUCT_STRUCT_H_ */
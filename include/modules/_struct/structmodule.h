@@ -0,0 +1,24 @@
+#ifndef _STRUCTMODULE_H_
+#define _STRUCTMODULE_H_
+
+#include "interpreter/module.h"
+#include "objects/obj_space.h"
+
+namespace mtpython {
+namespace modules {
+
+class StructModule : public interpreter::BuiltinModule {
+private:
+    static objects::M_BaseObject* error_type;
+
+public:
+    StructModule(objects::ObjSpace* space, objects::M_BaseObject* name);
+
+    /* struct.error */
+    static objects::M_BaseObject* get_error_type() { return error_type; }
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _STRUCTMODULE_H_ */
@@ -0,0 +1,202 @@
+#ifndef _ARRAY_ARRAY_H_
+#define _ARRAY_ARRAY_H_
+
+#include <cstdint>
+#include "objects/obj_space.h"
+#include "objects/gc_array.h"
+#include "objects/buffer.h"
+#include "interpreter/arguments.h"
+#include "gc/garbage_collector.h"
+
+namespace mtpython {
+namespace modules {
+
+/* Item type of an array */
+struct ArrayDescr {
+    char typecode;
+    std::size_t itemsize;
+    const char* format; /* struct module syntax, exported with the buffer */
+};
+
+/* Array of unboxed numbers of one C type. The items are stored back to back
+ * in a GC byte array with spare capacity at the end, like bytearray, and
+ * are exported through the buffer protocol with their struct format.
+ * Reductions, searches and comparisons run directly on the typed memory
+ * without boxing the items. */
+class M_Array : public objects::M_BaseObject {
+private:
+    const ArrayDescr* descr;
+    objects::M_GCArray<std::uint8_t>* storage; /* nullptr until first item */
+    std::size_t length;                        /* in items */
+
+    void reserve(vm::ThreadContext* context, std::size_t capacity);
+
+public:
+    M_Array(const ArrayDescr* descr)
+        : descr(descr), storage(nullptr), length(0)
+    {}
+
+    /* array storage lives in a GC array, there is nothing to finalize */
+    void* operator new(std::size_t size, vm::ThreadContext* context)
+    {
+        return context->get_gc()->allocate(size, false);
+    }
+
+    /* Item type for typecode, or nullptr if it is not supported */
+    static const ArrayDescr* find_descr(char typecode);
+
+    char typecode() const { return descr->typecode; }
+    std::size_t itemsize() const { return descr->itemsize; }
+    std::size_t size() const { return length; }
+    std::uint8_t* data() { return storage ? storage->begin() : nullptr; }
+
+    /* Change the length, new items are zero */
+    void resize(vm::ThreadContext* context, std::size_t size);
+    /* Replace the items in [lo, hi) with n items from src. src must not
+     * point into this array */
+    void replace_range(vm::ThreadContext* context, std::size_t lo,
+                       std::size_t hi, const std::uint8_t* src, std::size_t n);
+
+    objects::M_BaseObject* get_item(vm::ThreadContext* context,
+                                    std::size_t i);
+    /* Raises TypeError or OverflowError if value does not fit the item
+     * type */
+    void set_item(vm::ThreadContext* context, std::size_t i,
+                  objects::M_BaseObject* value);
+
+    /* start plus the sum of the items, or nullptr if start is not an exact
+     * int or float and the sum has to be computed generically */
+    objects::M_BaseObject* sum(vm::ThreadContext* context,
+                               objects::M_BaseObject* start);
+    /* Smallest or largest item of a non-empty array, picked with the same
+     * comparisons as min() and max() */
+    objects::M_BaseObject* extreme(vm::ThreadContext* context, bool largest);
+
+    virtual void get_buffer(objects::ObjSpace* space, objects::Buffer& view)
+    {
+        view.buf = data();
+        view.len = length;
+        view.itemsize = descr->itemsize;
+        view.stride = descr->itemsize;
+        view.readonly = false;
+        view.format = descr->format;
+    }
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        if (storage) gc->mark_object(storage);
+    }
+
+    static objects::M_BaseObject* __new__(vm::ThreadContext* context,
+                                          const interpreter::Arguments& args);
+    static objects::M_BaseObject* __repr__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* __len__(vm::ThreadContext* context,
+                                          objects::M_BaseObject* self);
+    static objects::M_BaseObject* __iter__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* __contains__(vm::ThreadContext* context,
+                                               objects::M_BaseObject* self,
+                                               objects::M_BaseObject* value);
+    static objects::M_BaseObject* __getitem__(vm::ThreadContext* context,
+                                              objects::M_BaseObject* self,
+                                              objects::M_BaseObject* index);
+    static objects::M_BaseObject* __setitem__(vm::ThreadContext* context,
+                                              objects::M_BaseObject* self,
+                                              objects::M_BaseObject* index,
+                                              objects::M_BaseObject* value);
+    static objects::M_BaseObject* __delitem__(vm::ThreadContext* context,
+                                              objects::M_BaseObject* self,
+                                              objects::M_BaseObject* index);
+
+    static objects::M_BaseObject* __eq__(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* other);
+    static objects::M_BaseObject* __ne__(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* other);
+    static objects::M_BaseObject* __lt__(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* other);
+    static objects::M_BaseObject* __le__(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* other);
+    static objects::M_BaseObject* __gt__(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* other);
+    static objects::M_BaseObject* __ge__(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* other);
+
+    static objects::M_BaseObject* __add__(vm::ThreadContext* context,
+                                          objects::M_BaseObject* self,
+                                          objects::M_BaseObject* other);
+    static objects::M_BaseObject* __iadd__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self,
+                                           objects::M_BaseObject* other);
+    static objects::M_BaseObject* __mul__(vm::ThreadContext* context,
+                                          objects::M_BaseObject* self,
+                                          objects::M_BaseObject* times);
+    static objects::M_BaseObject* __imul__(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self,
+                                           objects::M_BaseObject* times);
+
+    static objects::M_BaseObject* append(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* value);
+    static objects::M_BaseObject* extend(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* iterable);
+    static objects::M_BaseObject* insert(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* index,
+                                         objects::M_BaseObject* value);
+    static objects::M_BaseObject* pop(vm::ThreadContext* context,
+                                      const interpreter::Arguments& args);
+    static objects::M_BaseObject* remove(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* value);
+    static objects::M_BaseObject* index(vm::ThreadContext* context,
+                                        objects::M_BaseObject* self,
+                                        objects::M_BaseObject* value);
+    static objects::M_BaseObject* count(vm::ThreadContext* context,
+                                        objects::M_BaseObject* self,
+                                        objects::M_BaseObject* value);
+    static objects::M_BaseObject* reverse(vm::ThreadContext* context,
+                                          objects::M_BaseObject* self);
+    static objects::M_BaseObject* byteswap(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self);
+    static objects::M_BaseObject* copy(vm::ThreadContext* context,
+                                       objects::M_BaseObject* self);
+
+    static objects::M_BaseObject* frombytes(vm::ThreadContext* context,
+                                            objects::M_BaseObject* self,
+                                            objects::M_BaseObject* data);
+    static objects::M_BaseObject* tobytes(vm::ThreadContext* context,
+                                          objects::M_BaseObject* self);
+    static objects::M_BaseObject* fromlist(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self,
+                                           objects::M_BaseObject* list);
+    static objects::M_BaseObject* tolist(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self);
+    static objects::M_BaseObject* fromfile(vm::ThreadContext* context,
+                                           objects::M_BaseObject* self,
+                                           objects::M_BaseObject* file,
+                                           objects::M_BaseObject* n);
+    static objects::M_BaseObject* tofile(vm::ThreadContext* context,
+                                         objects::M_BaseObject* self,
+                                         objects::M_BaseObject* file);
+
+    static objects::M_BaseObject* typecode_get(vm::ThreadContext* context,
+                                               objects::M_BaseObject* self);
+    static objects::M_BaseObject* itemsize_get(vm::ThreadContext* context,
+                                               objects::M_BaseObject* self);
+
+    static interpreter::Typedef* _array_typedef();
+    interpreter::Typedef* get_typedef();
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _ARRAY_ARRAY_H_ */
@@ -0,0 +1,18 @@
+#ifndef _ARRAYMODULE_H_
+#define _ARRAYMODULE_H_
+
+#include "interpreter/module.h"
+#include "objects/obj_space.h"
+
+namespace mtpython {
+namespace modules {
+
+class ArrayModule : public interpreter::BuiltinModule {
+public:
+    ArrayModule(objects::ObjSpace* space, objects::M_BaseObject* name);
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _ARRAYMODULE_H_ */
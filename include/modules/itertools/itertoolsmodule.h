@@ -0,0 +1,18 @@
+#ifndef _ITERTOOLSMODULE_H_
+#define _ITERTOOLSMODULE_H_
+
+#include "interpreter/module.h"
+#include "objects/obj_space.h"
+
+namespace mtpython {
+namespace modules {
+
+class ItertoolsModule : public interpreter::BuiltinModule {
+public:
+    ItertoolsModule(objects::ObjSpace* space, objects::M_BaseObject* name);
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _ITERTOOLSMODULE_H_ */
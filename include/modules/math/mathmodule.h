@@ -0,0 +1,18 @@
+#ifndef _MATHMODULE_H_
+#define _MATHMODULE_H_
+
+#include "interpreter/module.h"
+#include "objects/obj_space.h"
+
+namespace mtpython {
+namespace modules {
+
+class MathModule : public interpreter::BuiltinModule {
+public:
+    MathModule(objects::ObjSpace* space, objects::M_BaseObject* name);
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _MATHMODULE_H_ */
@@ -0,0 +1,18 @@
+#ifndef _TIMEMODULE_H_
+#define _TIMEMODULE_H_
+
+#include "interpreter/module.h"
+#include "objects/obj_space.h"
+
+namespace mtpython {
+namespace modules {
+
+class TimeModule : public interpreter::BuiltinModule {
+public:
+    TimeModule(objects::ObjSpace* space, objects::M_BaseObject* name);
+};
+
+} // namespace modules
+} // namespace mtpython
+
+#endif /* _TIMEMODULE_H_ */
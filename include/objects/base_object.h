@@ -22,6 +22,7 @@ class GarbageCollector;
 namespace objects {
 
 class ObjSpace;
+struct Buffer;
 
 /* Base of all MTPython objects */
 class M_BaseObject {
@@ -61,6 +62,10 @@ public:
     {
         throw NotImplementedException("to_int()");
     }
+    virtual double to_float(ObjSpace* space)
+    {
+        throw NotImplementedException("to_float()");
+    }
     virtual M_BaseObject* get_repr(ObjSpace* space, const std::string& info);
     virtual std::string to_string(ObjSpace* space)
     {
@@ -73,6 +78,17 @@ public:
         throw NotImplementedException("unpack_iterable()");
     }
 
+    /* Advance an iterator, returning nullptr once it is exhausted. The
+     * default calls __next__ and catches StopIteration, native iterators
+     * override this so that exhaustion does not raise */
+    virtual M_BaseObject* next_item(vm::ThreadContext* context);
+
+    /* Export the memory of a bytes-like object */
+    virtual void get_buffer(ObjSpace* space, Buffer& view)
+    {
+        throw NotImplementedException("get_buffer()");
+    }
+
     void lock() {}
     void unlock() {}
 
@@ -2,6 +2,7 @@
 #define _BLTIN_EXCEPTIONS_H_
 
 #include "objects/obj_space.h"
+#include "interpreter/arguments.h"
 
 namespace mtpython {
 namespace objects {
@@ -10,6 +11,13 @@ class BaseException : public M_BaseObject {
 public:
     static M_BaseObject* get_bltin_exception_type(ObjSpace* space,
                                                   const std::string& name);
+
+    static M_BaseObject* __new__(vm::ThreadContext* context,
+                                 const interpreter::Arguments& args);
+    static M_BaseObject* __init__(vm::ThreadContext* context,
+                                  const interpreter::Arguments& args);
+    static M_BaseObject* __str__(vm::ThreadContext* context,
+                                 M_BaseObject* self);
 };
 
 } // namespace objects
@@ -0,0 +1,46 @@
+#ifndef _BUFFER_H_
+#define _BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace mtpython {
+namespace objects {
+
+/* Memory exported by an object through the buffer protocol. buf points to
+ * the first item and consecutive items are stride bytes apart, so the view
+ * is contiguous if stride equals itemsize. The memory is owned by the
+ * exporter and stays valid until the exporter is resized. */
+struct Buffer {
+    std::uint8_t* buf = nullptr;
+    std::size_t len = 0; /* in items */
+    std::size_t itemsize = 1;
+    std::ptrdiff_t stride = 1;
+    bool readonly = true;
+    const char* format = "B"; /* struct module syntax */
+
+    std::size_t nbytes() const { return len * itemsize; }
+    bool is_contiguous() const
+    {
+        return stride == (std::ptrdiff_t)itemsize || len <= 1;
+    }
+
+    /* Copy the items to nbytes() bytes at dst */
+    void copy_to(std::uint8_t* dst) const
+    {
+        if (is_contiguous()) {
+            if (len) std::memcpy(dst, buf, nbytes());
+            return;
+        }
+
+        const std::uint8_t* src = buf;
+        for (std::size_t i = 0; i < len; i++, src += stride, dst += itemsize)
+            std::memcpy(dst, src, itemsize);
+    }
+};
+
+} // namespace objects
+} // namespace mtpython
+
+#endif /* _BUFFER_H_ */
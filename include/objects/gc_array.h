@@ -0,0 +1,62 @@
+#ifndef _GC_ARRAY_H_
+#define _GC_ARRAY_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include "objects/base_object.h"
+#include "gc/garbage_collector.h"
+
+namespace mtpython {
+namespace objects {
+
+/* Fixed-length array on the GC heap with the elements stored inline after
+ * the header. Containers keep their elements in these arrays so that the
+ * collector accounts for the memory and traces it through mark_children().
+ * Arrays are allocated without a finalizer, so T must be trivially
+ * destructible. Elements are value-initialized; object pointers are marked
+ * if not null and class elements are marked through their own
+ * mark_children(). */
+template <typename T> class M_GCArray : public M_BaseObject {
+private:
+    std::size_t length;
+
+    M_GCArray(std::size_t length) : length(length)
+    {
+        for (std::size_t i = 0; i < length; i++)
+            ::new (begin() + i) T();
+    }
+
+public:
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "GC array elements are never destroyed");
+
+    static M_GCArray* create(vm::ThreadContext* context, std::size_t length)
+    {
+        void* mem = context->get_gc()->allocate(
+            sizeof(M_GCArray) + length * sizeof(T), false);
+        return ::new (mem) M_GCArray(length);
+    }
+
+    std::size_t size() const { return length; }
+    T* begin() { return reinterpret_cast<T*>(this + 1); }
+    T* end() { return begin() + length; }
+    T& operator[](std::size_t i) { return begin()[i]; }
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        if constexpr (std::is_pointer<T>::value) {
+            for (auto* obj : *this) {
+                if (obj) gc->mark_object(obj);
+            }
+        } else if constexpr (std::is_class<T>::value) {
+            for (auto& item : *this)
+                item.mark_children(gc);
+        }
+    }
+};
+
+} // namespace objects
+} // namespace mtpython
+
+#endif /* _GC_ARRAY_H_ */
@@ -7,6 +7,7 @@
 #include "objects/base_object.h"
 #include "interpreter/arguments.h"
 #include "objects/space_cache.h"
+#include "objects/type_slots.h"
 #include "exceptions.h"
 
 #include <memory>
@@ -44,6 +45,14 @@ private:
     M_BaseObject* type_KeyError;
     M_BaseObject* type_IndexError;
     M_BaseObject* type_SyntaxError;
+    M_BaseObject* type_ZeroDivisionError;
+    M_BaseObject* type_OverflowError;
+    M_BaseObject* type_LookupError;
+    M_BaseObject* type_UnicodeEncodeError;
+    M_BaseObject* type_UnicodeDecodeError;
+    M_BaseObject* type_OSError;
+    M_BaseObject* type_RuntimeError;
+    M_BaseObject* type_EOFError;
 
     void init_builtin_exceptions();
 
@@ -65,8 +74,9 @@ protected:
     void make_builtins();
     void setup_builtin_modules();
     M_BaseObject* get_builtin_module(const std::string& name);
-    M_BaseObject* execute_binop(M_BaseObject* impl, M_BaseObject* left,
-                                M_BaseObject* right);
+    M_BaseObject* call_binary_slots(BinarySlot left, BinarySlot right,
+                                    M_BaseObject* obj1, M_BaseObject* obj2,
+                                    bool compare = false);
 
 public:
     ObjSpace();
@@ -112,6 +122,10 @@ public:
         throw NotImplementedException("type()");
     }
     virtual std::string get_type_name(M_BaseObject* obj);
+    virtual const TypeSlots* type_slots(M_BaseObject* obj)
+    {
+        throw NotImplementedException("type_slots()");
+    }
 
     virtual M_BaseObject* lookup(M_BaseObject* obj, const std::string& name)
     {
@@ -154,6 +168,14 @@ public:
     M_BaseObject* KeyError_type() { return type_KeyError; }
     M_BaseObject* IndexError_type() { return type_IndexError; }
     M_BaseObject* SyntaxError_type() { return type_SyntaxError; }
+    M_BaseObject* ZeroDivisionError_type() { return type_ZeroDivisionError; }
+    M_BaseObject* OverflowError_type() { return type_OverflowError; }
+    M_BaseObject* LookupError_type() { return type_LookupError; }
+    M_BaseObject* UnicodeEncodeError_type() { return type_UnicodeEncodeError; }
+    M_BaseObject* UnicodeDecodeError_type() { return type_UnicodeDecodeError; }
+    M_BaseObject* OSError_type() { return type_OSError; }
+    M_BaseObject* RuntimeError_type() { return type_RuntimeError; }
+    M_BaseObject* EOFError_type() { return type_EOFError; }
     bool match_exception(M_BaseObject* type1, M_BaseObject* type2)
     {
         return type1 == type2;
@@ -163,6 +185,10 @@ public:
     {
         return wrap_int(context, x);
     }
+    virtual M_BaseObject* wrap(vm::ThreadContext* context, double x)
+    {
+        return wrap_float(context, x);
+    }
     virtual M_BaseObject* wrap(vm::ThreadContext* context, const std::string& x)
     {
         return wrap_str(context, x);
@@ -182,6 +208,16 @@ public:
         throw NotImplementedException("wrap_int()");
     }
 
+    virtual M_BaseObject* wrap_float(vm::ThreadContext* context, double x)
+    {
+        throw NotImplementedException("wrap_float()");
+    }
+    virtual M_BaseObject* wrap_float(vm::ThreadContext* context,
+                                     const std::string& x)
+    {
+        throw NotImplementedException("wrap_float()");
+    }
+
     virtual M_BaseObject* wrap_str(vm::ThreadContext* context,
                                    const std::string& x)
     {
@@ -204,6 +240,11 @@ public:
     {
         throw NotImplementedException("wrap_NotImplemented()");
     }
+    /* Preallocated one-character string for an ASCII character */
+    virtual M_BaseObject* wrap_ascii_char(unsigned char c)
+    {
+        throw NotImplementedException("wrap_ascii_char()");
+    }
 
     virtual M_BaseObject* new_bool(bool x)
     {
@@ -218,6 +259,17 @@ public:
     {
         throw NotImplementedException("new_tuple()");
     }
+    /* Tuple of size items that the caller stores through tuple_items()
+     * before the tuple is used */
+    virtual M_BaseObject* new_tuple(vm::ThreadContext* context,
+                                    std::size_t size)
+    {
+        throw NotImplementedException("new_tuple()");
+    }
+    virtual M_BaseObject** tuple_items(M_BaseObject* tuple)
+    {
+        throw NotImplementedException("tuple_items()");
+    }
     virtual M_BaseObject* new_list(vm::ThreadContext* context,
                                    const std::vector<M_BaseObject*>& items)
     {
@@ -231,13 +283,25 @@ public:
     {
         throw NotImplementedException("new_set()");
     }
+    virtual M_BaseObject* new_bytes(vm::ThreadContext* context,
+                                    const void* data, std::size_t size)
+    {
+        throw NotImplementedException("new_bytes()");
+    }
     virtual M_BaseObject* new_seqiter(vm::ThreadContext* context,
                                       M_BaseObject* obj)
     {
         throw NotImplementedException("new_seqiter()");
     }
+    virtual M_BaseObject* new_slice(vm::ThreadContext* context,
+                                    M_BaseObject* start, M_BaseObject* stop,
+                                    M_BaseObject* step)
+    {
+        throw NotImplementedException("new_slice()");
+    }
 
     virtual int unwrap_int(M_BaseObject* obj, bool allow_conversion = true);
+    virtual double unwrap_float(M_BaseObject* obj);
     virtual std::string unwrap_str(M_BaseObject* obj)
     {
         return obj->to_string(this);
@@ -245,6 +309,11 @@ public:
     virtual void unwrap_tuple(M_BaseObject* obj,
                               std::vector<M_BaseObject*>& list)
     {}
+    /* Memory of a bytes-like object. Raises TypeError if obj does not
+     * support the buffer protocol or the view does not have the requested
+     * properties */
+    void get_buffer(M_BaseObject* obj, Buffer& view, bool writable = false,
+                    bool contiguous = true);
 
     M_BaseObject* id(M_BaseObject* obj) { return obj->unique_id(this); }
 
@@ -268,13 +337,19 @@ public:
     call_function(vm::ThreadContext* context, M_BaseObject* func,
                   const std::initializer_list<M_BaseObject*> args);
 
+    /* Collect the items produced by an iterable */
+    void unpack_iterable(M_BaseObject* iterable,
+                         std::vector<M_BaseObject*>& items);
+
     M_BaseObject* getitem(M_BaseObject* obj, M_BaseObject* key);
-    M_BaseObject* getitem_str(M_BaseObject* obj, const std::string& key);
-    M_BaseObject* finditem(M_BaseObject* obj, M_BaseObject* key);
-    M_BaseObject* finditem_str(M_BaseObject* obj, const std::string& key);
+    virtual M_BaseObject* getitem_str(M_BaseObject* obj,
+                                      const std::string& key);
+    virtual M_BaseObject* finditem(M_BaseObject* obj, M_BaseObject* key);
+    virtual M_BaseObject* finditem_str(M_BaseObject* obj,
+                                       const std::string& key);
     void setitem(M_BaseObject* obj, M_BaseObject* key, M_BaseObject* value);
-    void setitem_str(M_BaseObject* obj, const std::string& key,
-                     M_BaseObject* value);
+    virtual void setitem_str(M_BaseObject* obj, const std::string& key,
+                             M_BaseObject* value);
     M_BaseObject* delitem(M_BaseObject* obj, M_BaseObject* key);
 
     M_BaseObject* getattr(M_BaseObject* obj, M_BaseObject* name);
@@ -295,6 +370,11 @@ public:
         return (!obj2) ? false : obj2->i_is(this, obj1);
     }
     bool i_eq(M_BaseObject* obj1, M_BaseObject* obj2);
+    /* obj1 < obj2 as a C++ bool */
+    virtual bool i_lt(M_BaseObject* obj1, M_BaseObject* obj2)
+    {
+        return is_true(lt(obj1, obj2));
+    }
     std::size_t i_hash(M_BaseObject* obj);
     virtual int i_get_index(M_BaseObject* obj, M_BaseObject* exc,
                             M_BaseObject* descr);
@@ -304,6 +384,8 @@ public:
 
     M_BaseObject* iter(M_BaseObject* obj);
     M_BaseObject* next(M_BaseObject* obj);
+    /* Like next() but returns nullptr instead of raising StopIteration */
+    M_BaseObject* next_item(M_BaseObject* obj);
 
     M_BaseObject* lt(M_BaseObject* obj1, M_BaseObject* obj2);
     M_BaseObject* le(M_BaseObject* obj1, M_BaseObject* obj2);
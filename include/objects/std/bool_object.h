@@ -24,6 +24,12 @@ public:
     static M_BaseObject* __and__(mtpython::vm::ThreadContext* context,
                                  mtpython::objects::M_BaseObject* self,
                                  mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __or__(mtpython::vm::ThreadContext* context,
+                                mtpython::objects::M_BaseObject* self,
+                                mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __xor__(mtpython::vm::ThreadContext* context,
+                                 mtpython::objects::M_BaseObject* self,
+                                 mtpython::objects::M_BaseObject* other);
 
     static interpreter::Typedef* _bool_typedef();
     virtual interpreter::Typedef* get_typedef();
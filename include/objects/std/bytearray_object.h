@@ -2,22 +2,84 @@
 #define _STD_BYTEARRAY_OBJECT_H_
 
 #include <string>
-#include "objects/base_object.h"
+#include <cstdint>
+#include "objects/obj_space.h"
+#include "objects/gc_array.h"
+#include "objects/buffer.h"
+#include "interpreter/arguments.h"
+#include "gc/garbage_collector.h"
 
 namespace mtpython {
 namespace objects {
 
 #define M_STDBYTEARRAYOBJECT(obj) (static_cast<M_StdByteArrayObject*>(obj))
 
+/* Mutable byte string. The bytes live in a GC array with spare capacity at
+ * the end, like the items of a list. Memoryviews of a bytearray fetch the
+ * buffer again on every access, so resizing never leaves them dangling. */
 class M_StdByteArrayObject : public M_BaseObject {
 private:
-    std::string array;
+    M_GCArray<std::uint8_t>* storage; /* nullptr until the first byte */
+    std::size_t length;
+
+    void reserve(vm::ThreadContext* context, std::size_t capacity);
 
 public:
-    M_StdByteArrayObject();
+    M_StdByteArrayObject() : storage(nullptr), length(0) {}
+
+    /* bytearray storage lives in a GC array, there is nothing to finalize */
+    void* operator new(std::size_t size, vm::ThreadContext* context)
+    {
+        return context->get_gc()->allocate(size, false);
+    }
+
+    static M_StdByteArrayObject* create(vm::ThreadContext* context,
+                                        const void* data, std::size_t size);
+
+    std::size_t size() const { return length; }
+    std::uint8_t* data() { return storage ? storage->begin() : nullptr; }
 
+    /* Change the length, new bytes are zero */
+    void resize(vm::ThreadContext* context, std::size_t size);
+    /* Replace the bytes in [lo, hi) with n bytes from src. src must not point
+     * into this bytearray */
+    void replace_range(vm::ThreadContext* context, std::size_t lo,
+                       std::size_t hi, const std::uint8_t* src, std::size_t n);
+
+    virtual void get_buffer(ObjSpace* space, Buffer& view)
+    {
+        view.buf = data();
+        view.len = length;
+        view.readonly = false;
+    }
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        if (storage) gc->mark_object(storage);
+    }
+
+    static M_BaseObject* __new__(vm::ThreadContext* context,
+                                 const interpreter::Arguments& args);
+    static M_BaseObject* __init__(vm::ThreadContext* context,
+                                  const interpreter::Arguments& args);
     static M_BaseObject* __iter__(mtpython::vm::ThreadContext* context,
                                   M_BaseObject* self);
+    static M_BaseObject* __setitem__(vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* index,
+                                     M_BaseObject* value);
+    static M_BaseObject* __delitem__(vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* index);
+    static M_BaseObject* __iadd__(vm::ThreadContext* context,
+                                  M_BaseObject* self, M_BaseObject* other);
+
+    static M_BaseObject* append(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* item);
+    static M_BaseObject* extend(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* iterable);
+    static M_BaseObject* pop(vm::ThreadContext* context,
+                             const interpreter::Arguments& args);
+    static M_BaseObject* clear(vm::ThreadContext* context, M_BaseObject* self);
+    static M_BaseObject* copy(vm::ThreadContext* context, M_BaseObject* self);
 
     static interpreter::Typedef* _bytearray_typedef();
     interpreter::Typedef* get_typedef();
@@ -2,17 +2,136 @@
 #define _STD_BYTES_OBJECT_H_
 
 #include <string>
+#include <cstdint>
 #include "objects/base_object.h"
+#include "objects/buffer.h"
+#include "interpreter/arguments.h"
 
 namespace mtpython {
 namespace objects {
 
 #define M_STDBYTESOBJECT(obj) (static_cast<M_StdBytesObject*>(obj))
 
+/* Contents of bytes(source, encoding, errors) or bytearray(...). encoding
+ * and errors may be nullptr */
+std::string bytes_from_object(vm::ThreadContext* context, M_BaseObject* source,
+                              M_BaseObject* encoding, M_BaseObject* errors);
+/* str.encode() and bytes.decode(). Only the UTF-8, ASCII and Latin-1 codecs
+ * are supported */
+std::string encode_str(ObjSpace* space, const std::string& s,
+                       const std::string& encoding, const std::string& errors);
+std::string decode_bytes(ObjSpace* space, const std::uint8_t* data,
+                         std::size_t size, const std::string& encoding,
+                         const std::string& errors);
+/* Canonical name of a codec, e.g. "utf-8" for "UTF8" */
+std::string normalize_encoding(const std::string& encoding);
+/* Number of leading bytes of data that are valid UTF-8 */
+std::size_t utf8_valid_prefix(const std::uint8_t* data, std::size_t size);
+
+/* Immutable byte string. Like tuples, bytes are allocated as a single GC
+ * object with the data stored inline right after it. */
 class M_StdBytesObject : public M_BaseObject {
 private:
+    std::size_t length;
+    mutable std::size_t hash_value;
+    mutable bool hash_cached;
+
+    M_StdBytesObject(std::size_t length)
+        : length(length), hash_value(0), hash_cached(false)
+    {}
+
+    void* operator new(std::size_t size, vm::ThreadContext* context,
+                       std::size_t length);
+
 public:
-    M_StdBytesObject();
+    /* Bytes holding a copy of data, or size zero bytes if data is nullptr */
+    static M_StdBytesObject* create(vm::ThreadContext* context,
+                                    const void* data, std::size_t size);
+
+    std::size_t size() const { return length; }
+    std::uint8_t* data() { return reinterpret_cast<std::uint8_t*>(this + 1); }
+
+    /* Drop the bytes after size. Only for the creator of a bytes object
+     * that was filled in place, before it is visible to anyone else */
+    void shrink(std::size_t size)
+    {
+        if (size < length) length = size;
+    }
+
+    std::size_t hash();
+
+    virtual void get_buffer(ObjSpace* space, Buffer& view)
+    {
+        view.buf = data();
+        view.len = length;
+    }
+
+    static M_BaseObject* __new__(vm::ThreadContext* context,
+                                 const interpreter::Arguments& args);
+    static M_BaseObject* __hash__(vm::ThreadContext* context,
+                                  M_BaseObject* self);
+
+    /* The methods below do not modify self and are shared with bytearray.
+     * They work on the exported buffer of self and return objects of the
+     * same type as self */
+    static M_BaseObject* __repr__(vm::ThreadContext* context,
+                                  M_BaseObject* self);
+    static M_BaseObject* __len__(vm::ThreadContext* context,
+                                 M_BaseObject* self);
+    static M_BaseObject* __iter__(vm::ThreadContext* context,
+                                  M_BaseObject* self);
+    static M_BaseObject* __getitem__(vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* index);
+    static M_BaseObject* __contains__(vm::ThreadContext* context,
+                                      M_BaseObject* self, M_BaseObject* obj);
+    static M_BaseObject* __eq__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* __ne__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* __lt__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* __le__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* __gt__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* __ge__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* __add__(vm::ThreadContext* context,
+                                 M_BaseObject* self, M_BaseObject* other);
+    static M_BaseObject* __mul__(vm::ThreadContext* context,
+                                 M_BaseObject* self, M_BaseObject* times);
+
+    static M_BaseObject* decode(vm::ThreadContext* context,
+                                const interpreter::Arguments& args);
+    static M_BaseObject* find(vm::ThreadContext* context,
+                              const interpreter::Arguments& args);
+    static M_BaseObject* rfind(vm::ThreadContext* context,
+                               const interpreter::Arguments& args);
+    static M_BaseObject* index(vm::ThreadContext* context,
+                               const interpreter::Arguments& args);
+    static M_BaseObject* count(vm::ThreadContext* context,
+                               const interpreter::Arguments& args);
+    static M_BaseObject* startswith(vm::ThreadContext* context,
+                                    const interpreter::Arguments& args);
+    static M_BaseObject* endswith(vm::ThreadContext* context,
+                                  const interpreter::Arguments& args);
+    static M_BaseObject* split(vm::ThreadContext* context,
+                               const interpreter::Arguments& args);
+    static M_BaseObject* join(vm::ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* iterable);
+    static M_BaseObject* strip(vm::ThreadContext* context,
+                               const interpreter::Arguments& args);
+    static M_BaseObject* lstrip(vm::ThreadContext* context,
+                                const interpreter::Arguments& args);
+    static M_BaseObject* rstrip(vm::ThreadContext* context,
+                                const interpreter::Arguments& args);
+    static M_BaseObject* replace(vm::ThreadContext* context,
+                                 const interpreter::Arguments& args);
+    static M_BaseObject* translate(vm::ThreadContext* context,
+                                   const interpreter::Arguments& args);
+    static M_BaseObject* lower(vm::ThreadContext* context, M_BaseObject* self);
+    static M_BaseObject* upper(vm::ThreadContext* context, M_BaseObject* self);
+    static M_BaseObject* hex(vm::ThreadContext* context, M_BaseObject* self);
 
     static interpreter::Typedef* _bytes_typedef();
     interpreter::Typedef* get_typedef();
@@ -2,13 +2,26 @@
 #define _STD_DICT_OBJECT_H_
 
 #include <string>
-#include <unordered_map>
+#include <vector>
+#include <cstdint>
 #include "objects/obj_space.h"
+#include "objects/gc_array.h"
+#include "interpreter/arguments.h"
 #include "gc/garbage_collector.h"
 
 namespace mtpython {
 namespace objects {
 
+/* Hash and equality of dict and set keys. Exact str and int keys are handled
+ * natively instead of calling __hash__ and __eq__ through the object space */
+std::size_t hash_key(ObjSpace* space, M_BaseObject* key);
+bool keys_equal(ObjSpace* space, M_BaseObject* lhs, M_BaseObject* rhs);
+
+class M_StdDictObject;
+/* Add the items of a mapping or of an iterable of key/value pairs */
+void update_dict(vm::ThreadContext* context, M_StdDictObject* dict,
+                 M_BaseObject* other);
+
 class M_StdObjectHasher {
 private:
     ObjSpace* space;
@@ -17,7 +30,7 @@ public:
     M_StdObjectHasher(ObjSpace* space) { this->space = space; }
     std::size_t operator()(M_BaseObject* const& key) const
     {
-        return space->i_hash(key);
+        return hash_key(space, key);
     }
 };
 
@@ -29,50 +42,169 @@ public:
     M_StdObjectEq(ObjSpace* space) { this->space = space; }
     bool operator()(M_BaseObject* const& lhs, M_BaseObject* const& rhs) const
     {
-        return space->i_eq(lhs, rhs);
+        return keys_equal(space, lhs, rhs);
     }
 };
 
+/* Insertion-ordered dict. Entries are stored densely in insertion order and
+ * a separate open-addressing table maps hash slots to entry indices. While
+ * all keys are exact str the lookup never calls back into the object
+ * space. */
 class M_StdDictObject : public M_BaseObject {
 private:
-    std::unordered_map<M_BaseObject*, M_BaseObject*, M_StdObjectHasher,
-                       M_StdObjectEq>
-        dict;
+    struct Entry {
+        std::size_t hash;
+        M_BaseObject* key; /* nullptr if the entry has been deleted */
+        M_BaseObject* value;
+
+        void mark_children(gc::GarbageCollector* gc)
+        {
+            if (!key) return;
+            gc->mark_object(key);
+            gc->mark_object(value);
+        }
+    };
+
+    static constexpr std::int32_t IX_EMPTY = -1;
+    static constexpr std::int32_t IX_DUMMY = -2;
+    static constexpr std::size_t MIN_SIZE = 8;
+
+    ObjSpace* space;
+    /* Both arrays are nullptr until the first insertion. The entry array
+     * holds two thirds as many entries as the index table has slots. */
+    M_GCArray<Entry>* entries;
+    M_GCArray<std::int32_t>* indices;
+    std::size_t nentries; /* entries in use, including deleted ones */
+    std::size_t used;
+    bool str_keys;
+    /* Class and attribute dict of instances of dict subclasses, both are
+     * nullptr for exact dicts */
+    M_BaseObject* obj_type;
+    M_BaseObject* obj_dict;
+
+    template <typename Eq>
+    std::int32_t lookup(std::size_t hash, Eq eq, std::size_t* free_slot);
+    std::int32_t lookup_key(M_BaseObject* key, std::size_t hash,
+                            std::size_t* free_slot = nullptr);
+    std::int32_t lookup_str(const std::string& key, std::size_t hash);
+    std::size_t find_free_slot(std::size_t hash) const;
+    void resize(std::size_t min_used);
+    void insert(M_BaseObject* key, std::size_t hash, M_BaseObject* value);
 
 public:
     M_StdDictObject(ObjSpace* space)
-        : dict(5, M_StdObjectHasher(space), M_StdObjectEq(space))
+        : space(space), entries(nullptr), indices(nullptr), nentries(0),
+          used(0), str_keys(true), obj_type(nullptr), obj_dict(nullptr)
     {}
 
+    /* dict storage lives in GC arrays, there is nothing to finalize */
+    void* operator new(std::size_t size, vm::ThreadContext* context)
+    {
+        return context->get_gc()->allocate(size, false);
+    }
+
+    M_BaseObject* get_class(ObjSpace* space)
+    {
+        return obj_type ? obj_type : M_BaseObject::get_class(space);
+    }
+    M_BaseObject* get_dict(ObjSpace* space) { return obj_dict; }
+
+    std::size_t size() const { return used; }
+
     M_BaseObject* getitem(M_BaseObject* key);
     void setitem(M_BaseObject* key, M_BaseObject* value);
+    /* Value slot of key, inserting key with value first if it is missing.
+     * The reference is only valid until the dict is modified again */
+    M_BaseObject*& lookup_or_insert(M_BaseObject* key, M_BaseObject* value);
+    M_BaseObject* delitem(M_BaseObject* key);
+    void clear_entries();
+
+    M_BaseObject* getitem_str(const std::string& key);
+    void setitem_str(vm::ThreadContext* context, const std::string& key,
+                     M_BaseObject* value);
 
-    virtual void mark_chidren(gc::GarbageCollector* gc)
+    /* Find the next live entry starting at pos. Returns false at the end */
+    bool next_entry(std::size_t& pos, M_BaseObject*& key, M_BaseObject*& value);
+
+    /* Value of d[key] for a key that is not in the dict, or nullptr to raise
+     * KeyError. Subtypes override this instead of defining __missing__ */
+    virtual M_BaseObject* missing(vm::ThreadContext* context,
+                                  M_BaseObject* key)
     {
-        for (const auto& [k, v] : dict) {
-            gc->mark_object(k);
-            gc->mark_object(v);
-        }
+        return nullptr;
     }
 
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(obj_type);
+        gc->mark_object(obj_dict);
+        if (!entries) return;
+        gc->mark_object(entries);
+        gc->mark_object(indices);
+    }
+
+    static M_BaseObject* __new__(vm::ThreadContext* context,
+                                 const interpreter::Arguments& args);
     static M_BaseObject* __repr__(vm::ThreadContext* context,
                                   M_BaseObject* self);
+    static M_BaseObject* __len__(vm::ThreadContext* context,
+                                 M_BaseObject* self);
+    static M_BaseObject* __iter__(vm::ThreadContext* context,
+                                  M_BaseObject* self);
     static M_BaseObject* __getitem__(mtpython::vm::ThreadContext* context,
                                      M_BaseObject* obj, M_BaseObject* key);
     static M_BaseObject* __setitem__(mtpython::vm::ThreadContext* context,
                                      M_BaseObject* obj, M_BaseObject* key,
                                      M_BaseObject* value);
+    static M_BaseObject* __delitem__(mtpython::vm::ThreadContext* context,
+                                     M_BaseObject* obj, M_BaseObject* key);
     static M_BaseObject* __contains__(vm::ThreadContext* context,
                                       M_BaseObject* self, M_BaseObject* obj);
 
     static M_BaseObject* keys(vm::ThreadContext* context, M_BaseObject* self);
     static M_BaseObject* values(vm::ThreadContext* context, M_BaseObject* self);
     static M_BaseObject* items(vm::ThreadContext* context, M_BaseObject* self);
+    static M_BaseObject* get(vm::ThreadContext* context,
+                             const interpreter::Arguments& args);
+    static M_BaseObject* pop(vm::ThreadContext* context,
+                             const interpreter::Arguments& args);
+    static M_BaseObject* setdefault(vm::ThreadContext* context,
+                                    const interpreter::Arguments& args);
+    static M_BaseObject* update(vm::ThreadContext* context,
+                                const interpreter::Arguments& args);
+    static M_BaseObject* clear(vm::ThreadContext* context, M_BaseObject* self);
+    static M_BaseObject* copy(vm::ThreadContext* context, M_BaseObject* self);
 
     static interpreter::Typedef* _dict_typedef();
     virtual interpreter::Typedef* get_typedef();
 };
 
+class M_StdDictIterObject : public M_BaseObject {
+private:
+    M_StdDictObject* dict;
+    std::size_t pos;
+    /* size of the dict when the iteration started. pos is only meaningful
+     * while the dict keeps that size, resizing compacts the entries */
+    std::size_t used;
+
+public:
+    M_StdDictIterObject(M_StdDictObject* dict)
+        : dict(dict), pos(0), used(dict->size())
+    {}
+
+    interpreter::Typedef* get_typedef();
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(dict);
+    }
+
+    static M_BaseObject* __iter__(vm::ThreadContext* context,
+                                  M_BaseObject* self);
+    static M_BaseObject* __next__(vm::ThreadContext* context,
+                                  M_BaseObject* self);
+};
+
 } // namespace objects
 } // namespace mtpython
 
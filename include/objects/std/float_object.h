@@ -0,0 +1,122 @@
+#ifndef _STD_FLOAT_OBJECT_H_
+#define _STD_FLOAT_OBJECT_H_
+
+#include <string>
+
+#include "objects/base_object.h"
+#include "interpreter/arguments.h"
+
+namespace mtpython {
+namespace objects {
+
+#define M_STDFLOATOBJECT(obj) (static_cast<M_StdFloatObject*>(obj))
+
+class M_StdFloatObject : public M_BaseObject {
+protected:
+    double floatval;
+
+public:
+    M_StdFloatObject(double x);
+    M_StdFloatObject(const std::string& x);
+
+    double get_value() const { return floatval; }
+
+    /* Shortest string that round-trips to x, formatted like repr(float) */
+    static std::string format_repr(double x);
+    static std::size_t hash_double(double x);
+
+    static M_BaseObject* __new__(mtpython::vm::ThreadContext* context,
+                                 const interpreter::Arguments& args);
+    static M_BaseObject* __repr__(mtpython::vm::ThreadContext* context,
+                                  mtpython::objects::M_BaseObject* self);
+    static M_BaseObject* __bool__(mtpython::vm::ThreadContext* context,
+                                  mtpython::objects::M_BaseObject* self);
+    static M_BaseObject* __hash__(mtpython::vm::ThreadContext* context,
+                                  mtpython::objects::M_BaseObject* self);
+    static M_BaseObject* __int__(mtpython::vm::ThreadContext* context,
+                                 mtpython::objects::M_BaseObject* self);
+    static M_BaseObject* __float__(mtpython::vm::ThreadContext* context,
+                                   mtpython::objects::M_BaseObject* self);
+    static M_BaseObject* is_integer(mtpython::vm::ThreadContext* context,
+                                    mtpython::objects::M_BaseObject* self);
+
+    static M_BaseObject* __add__(mtpython::vm::ThreadContext* context,
+                                 mtpython::objects::M_BaseObject* self,
+                                 mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __sub__(mtpython::vm::ThreadContext* context,
+                                 mtpython::objects::M_BaseObject* self,
+                                 mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __rsub__(mtpython::vm::ThreadContext* context,
+                                  mtpython::objects::M_BaseObject* self,
+                                  mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __mul__(mtpython::vm::ThreadContext* context,
+                                 mtpython::objects::M_BaseObject* self,
+                                 mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __truediv__(mtpython::vm::ThreadContext* context,
+                                     mtpython::objects::M_BaseObject* self,
+                                     mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __rtruediv__(mtpython::vm::ThreadContext* context,
+                                      mtpython::objects::M_BaseObject* self,
+                                      mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __floordiv__(mtpython::vm::ThreadContext* context,
+                                      mtpython::objects::M_BaseObject* self,
+                                      mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __rfloordiv__(mtpython::vm::ThreadContext* context,
+                                       mtpython::objects::M_BaseObject* self,
+                                       mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __mod__(mtpython::vm::ThreadContext* context,
+                                 mtpython::objects::M_BaseObject* self,
+                                 mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __rmod__(mtpython::vm::ThreadContext* context,
+                                  mtpython::objects::M_BaseObject* self,
+                                  mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __pow__(mtpython::vm::ThreadContext* context,
+                                 mtpython::objects::M_BaseObject* self,
+                                 mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __rpow__(mtpython::vm::ThreadContext* context,
+                                  mtpython::objects::M_BaseObject* self,
+                                  mtpython::objects::M_BaseObject* other);
+
+    static M_BaseObject* __eq__(mtpython::vm::ThreadContext* context,
+                                mtpython::objects::M_BaseObject* self,
+                                mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __ne__(mtpython::vm::ThreadContext* context,
+                                mtpython::objects::M_BaseObject* self,
+                                mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __lt__(mtpython::vm::ThreadContext* context,
+                                mtpython::objects::M_BaseObject* self,
+                                mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __le__(mtpython::vm::ThreadContext* context,
+                                mtpython::objects::M_BaseObject* self,
+                                mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __gt__(mtpython::vm::ThreadContext* context,
+                                mtpython::objects::M_BaseObject* self,
+                                mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __ge__(mtpython::vm::ThreadContext* context,
+                                mtpython::objects::M_BaseObject* self,
+                                mtpython::objects::M_BaseObject* other);
+
+    static M_BaseObject* __abs__(mtpython::vm::ThreadContext* context,
+                                 mtpython::objects::M_BaseObject* self);
+    static M_BaseObject* __neg__(mtpython::vm::ThreadContext* context,
+                                 mtpython::objects::M_BaseObject* self);
+    static M_BaseObject* __pos__(mtpython::vm::ThreadContext* context,
+                                 mtpython::objects::M_BaseObject* self);
+
+    static interpreter::Typedef* _float_typedef();
+    virtual interpreter::Typedef* get_typedef();
+
+    virtual int to_int(ObjSpace* space, bool allow_conversion);
+    virtual double to_float(ObjSpace* space) { return floatval; }
+    virtual std::string to_string(ObjSpace* space)
+    {
+        return format_repr(floatval);
+    }
+
+    virtual void dbg_print();
+};
+
+} // namespace objects
+} // namespace mtpython
+
+#endif /* _STD_FLOAT_OBJECT_H_ */
@@ -5,6 +5,7 @@
 #include <sstream>
 
 #include "objects/base_object.h"
+#include "interpreter/arguments.h"
 
 namespace mtpython {
 namespace objects {
@@ -19,15 +20,20 @@ public:
     M_StdIntObject(int x);
     M_StdIntObject(const std::string& x);
 
+    int get_value() const { return intval; }
+
     static M_BaseObject* __new__(mtpython::vm::ThreadContext* context,
-                                 mtpython::objects::M_BaseObject* int_type,
-                                 mtpython::objects::M_BaseObject* value);
+                                 const interpreter::Arguments& args);
     static M_BaseObject* __repr__(mtpython::vm::ThreadContext* context,
                                   mtpython::objects::M_BaseObject* self);
     static M_BaseObject* __str__(mtpython::vm::ThreadContext* context,
                                  mtpython::objects::M_BaseObject* self);
     static M_BaseObject* __bool__(mtpython::vm::ThreadContext* context,
                                   mtpython::objects::M_BaseObject* self);
+    static M_BaseObject* __hash__(mtpython::vm::ThreadContext* context,
+                                  mtpython::objects::M_BaseObject* self);
+    static M_BaseObject* __float__(mtpython::vm::ThreadContext* context,
+                                   mtpython::objects::M_BaseObject* self);
     static M_BaseObject* __add__(mtpython::vm::ThreadContext* context,
                                  mtpython::objects::M_BaseObject* self,
                                  mtpython::objects::M_BaseObject* other);
@@ -37,9 +43,30 @@ public:
     static M_BaseObject* __mul__(mtpython::vm::ThreadContext* context,
                                  mtpython::objects::M_BaseObject* self,
                                  mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __truediv__(mtpython::vm::ThreadContext* context,
+                                     mtpython::objects::M_BaseObject* self,
+                                     mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __floordiv__(mtpython::vm::ThreadContext* context,
+                                      mtpython::objects::M_BaseObject* self,
+                                      mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __mod__(mtpython::vm::ThreadContext* context,
+                                 mtpython::objects::M_BaseObject* self,
+                                 mtpython::objects::M_BaseObject* other);
     static M_BaseObject* __and__(mtpython::vm::ThreadContext* context,
                                  mtpython::objects::M_BaseObject* self,
                                  mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __or__(mtpython::vm::ThreadContext* context,
+                                mtpython::objects::M_BaseObject* self,
+                                mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __xor__(mtpython::vm::ThreadContext* context,
+                                 mtpython::objects::M_BaseObject* self,
+                                 mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __lshift__(mtpython::vm::ThreadContext* context,
+                                    mtpython::objects::M_BaseObject* self,
+                                    mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __rshift__(mtpython::vm::ThreadContext* context,
+                                    mtpython::objects::M_BaseObject* self,
+                                    mtpython::objects::M_BaseObject* other);
 
     static M_BaseObject* __eq__(mtpython::vm::ThreadContext* context,
                                 mtpython::objects::M_BaseObject* self,
@@ -64,6 +91,8 @@ public:
                                  mtpython::objects::M_BaseObject* self);
     static M_BaseObject* __neg__(mtpython::vm::ThreadContext* context,
                                  mtpython::objects::M_BaseObject* self);
+    static M_BaseObject* __invert__(mtpython::vm::ThreadContext* context,
+                                    mtpython::objects::M_BaseObject* self);
 
     static interpreter::Typedef* _int_typedef();
     virtual interpreter::Typedef* get_typedef();
@@ -72,6 +101,7 @@ public:
     {
         return intval;
     }
+    virtual double to_float(ObjSpace* space) { return (double)intval; }
     virtual std::string to_string(ObjSpace* space)
     {
         std::ostringstream stm;
@@ -4,12 +4,34 @@
 #include <string>
 #include <vector>
 #include "objects/obj_space.h"
+#include "objects/std/tuple_object.h"
 #include "gc/garbage_collector.h"
 
 namespace mtpython {
 namespace objects {
 
-class M_StdSeqIterObject : public M_BaseObject {
+/* Base of iterators implemented natively. Subclasses only provide
+ * next_item(), which returns nullptr once they are exhausted, so for loops
+ * and other native consumers never see StopIteration. Only __next__ called
+ * from Python code raises it. */
+class M_StdNativeIterObject : public M_BaseObject {
+public:
+    /* native iterators only hold GC references and counters, there is
+     * nothing to finalize */
+    void* operator new(std::size_t size, vm::ThreadContext* context)
+    {
+        return context->get_gc()->allocate(size, false);
+    }
+
+    virtual M_BaseObject* next_item(vm::ThreadContext* context) = 0;
+
+    static M_BaseObject* __iter__(vm::ThreadContext* context,
+                                  M_BaseObject* self);
+    static M_BaseObject* __next__(vm::ThreadContext* context,
+                                  M_BaseObject* self);
+};
+
+class M_StdSeqIterObject : public M_StdNativeIterObject {
 private:
     int index;
     M_BaseObject* obj;
@@ -20,37 +42,30 @@ public:
     {}
     interpreter::Typedef* get_typedef();
 
-    virtual void mark_chidren(gc::GarbageCollector* gc)
+    virtual void mark_children(gc::GarbageCollector* gc)
     {
-        gc->mark_object(obj);
+        if (obj) gc->mark_object(obj);
     }
 
-    static M_BaseObject* __next__(vm::ThreadContext* context,
-                                  M_BaseObject* self);
+    virtual M_BaseObject* next_item(vm::ThreadContext* context);
 };
 
-class M_StdTupleIterObject : public M_BaseObject {
+class M_StdTupleIterObject : public M_StdNativeIterObject {
 private:
     std::size_t index;
-    std::vector<M_BaseObject*> items;
+    M_StdTupleObject* tuple;
 
 public:
-    M_StdTupleIterObject(const std::vector<M_BaseObject*>& items) : items(items)
-    {
-        index = 0;
-    }
+    M_StdTupleIterObject(M_StdTupleObject* tuple) : index(0), tuple(tuple) {}
 
     interpreter::Typedef* get_typedef();
 
-    virtual void mark_chidren(gc::GarbageCollector* gc)
+    virtual void mark_children(gc::GarbageCollector* gc)
     {
-        for (const auto& obj : items) {
-            gc->mark_object(obj);
-        }
+        gc->mark_object(tuple);
     }
 
-    static M_BaseObject* __next__(vm::ThreadContext* context,
-                                  M_BaseObject* self);
+    virtual M_BaseObject* next_item(vm::ThreadContext* context);
 };
 
 } // namespace objects
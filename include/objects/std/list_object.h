@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 #include "objects/obj_space.h"
+#include "objects/gc_array.h"
+#include "interpreter/arguments.h"
 #include "gc/garbage_collector.h"
 
 namespace mtpython {
@@ -13,30 +15,58 @@ namespace objects {
 
 class M_StdListObject : public M_BaseObject {
 private:
-    std::vector<M_BaseObject*> items;
+    M_GCArray<M_BaseObject*>* items; /* nullptr until the first item */
+    std::size_t length;
+
+    void reserve(vm::ThreadContext* context, std::size_t capacity);
+    /* Make room for at least size items, over-allocating like push_back */
+    void grow(vm::ThreadContext* context, std::size_t size);
+    /* Replace the items in [lo, hi) with the n items at first */
+    void replace_range(vm::ThreadContext* context, std::size_t lo,
+                       std::size_t hi, M_BaseObject* const* first,
+                       std::size_t n);
 
 public:
-    M_StdListObject() {}
-    M_StdListObject(const std::vector<M_BaseObject*>& items) : items(items) {}
+    M_StdListObject() : items(nullptr), length(0) {}
+    M_StdListObject(vm::ThreadContext* context,
+                    const std::vector<M_BaseObject*>& items);
+
+    /* List of size items that are all nullptr until filled in */
+    static M_StdListObject* create(vm::ThreadContext* context,
+                                   std::size_t size);
+
+    /* list storage lives in a GC array, there is nothing to finalize */
+    void* operator new(std::size_t size, vm::ThreadContext* context)
+    {
+        return context->get_gc()->allocate(size, false);
+    }
+
+    std::size_t size() const { return length; }
+    M_BaseObject** begin() { return items ? items->begin() : nullptr; }
+    M_BaseObject** end() { return begin() + length; }
+    M_BaseObject*& operator[](std::size_t i) { return (*items)[i]; }
+
+    void push_back(vm::ThreadContext* context, M_BaseObject* item);
+    M_BaseObject* erase(std::size_t pos);
 
-    std::vector<M_BaseObject*>& get_items() { return items; }
     virtual void unpack_iterable(ObjSpace* space,
                                  std::vector<M_BaseObject*>& list)
     {
-        list.insert(list.end(), items.begin(), items.end());
+        list.insert(list.end(), begin(), end());
     }
 
     static interpreter::Typedef* _list_typedef();
     virtual interpreter::Typedef* get_typedef();
 
-    int size() { return items.size(); }
-
-    virtual void mark_chidren(gc::GarbageCollector* gc)
+    virtual void mark_children(gc::GarbageCollector* gc)
     {
-        for (const auto& obj : items)
-            gc->mark_object(obj);
+        if (items) gc->mark_object(items);
     }
 
+    static M_BaseObject* __new__(vm::ThreadContext* context,
+                                 const interpreter::Arguments& args);
+    static M_BaseObject* __init__(vm::ThreadContext* context,
+                                  const interpreter::Arguments& args);
     static M_BaseObject* __len__(vm::ThreadContext* context,
                                  M_BaseObject* self);
     static M_BaseObject* __repr__(vm::ThreadContext* context,
@@ -47,16 +77,44 @@ public:
                                   M_BaseObject* self);
     static M_BaseObject* __getitem__(vm::ThreadContext* context,
                                      M_BaseObject* self, M_BaseObject* index);
+    static M_BaseObject* __setitem__(vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* index,
+                                     M_BaseObject* value);
+    static M_BaseObject* __delitem__(vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* index);
 
+    static M_BaseObject* __eq__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* __ne__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+
+    static M_BaseObject* __add__(vm::ThreadContext* context,
+                                 M_BaseObject* self, M_BaseObject* other);
+    static M_BaseObject* __mul__(vm::ThreadContext* context,
+                                 M_BaseObject* self, M_BaseObject* times);
     static M_BaseObject* __iadd__(vm::ThreadContext* context,
                                   M_BaseObject* self, M_BaseObject* other);
+    static M_BaseObject* __imul__(vm::ThreadContext* context,
+                                  M_BaseObject* self, M_BaseObject* times);
 
     static M_BaseObject* append(vm::ThreadContext* context, M_BaseObject* self,
                                 M_BaseObject* item);
     static M_BaseObject* extend(vm::ThreadContext* context, M_BaseObject* self,
                                 M_BaseObject* iterable);
+    static M_BaseObject* insert(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* index, M_BaseObject* item);
     static M_BaseObject* pop(vm::ThreadContext* context,
                              const interpreter::Arguments& args);
+    static M_BaseObject* index(vm::ThreadContext* context,
+                               const interpreter::Arguments& args);
+    static M_BaseObject* count(vm::ThreadContext* context, M_BaseObject* self,
+                               M_BaseObject* value);
+    static M_BaseObject* remove(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* value);
+    static M_BaseObject* reverse(vm::ThreadContext* context,
+                                 M_BaseObject* self);
+    static M_BaseObject* sort(vm::ThreadContext* context,
+                              const interpreter::Arguments& args);
 };
 
 } // namespace objects
@@ -1,17 +1,92 @@
 #ifndef _STD_MEMORY_OBJECT_H_
 #define _STD_MEMORY_OBJECT_H_
 
-#include "objects/base_object.h"
+#include "objects/obj_space.h"
+#include "objects/buffer.h"
+#include "interpreter/arguments.h"
+#include "gc/garbage_collector.h"
 
 namespace mtpython {
 namespace objects {
 
-#define M_STDMEMORYOBJECT(obj) (static_cast<M_StdMemoryObject*>(obj))
+#define M_STDMEMORYOBJECT(obj) (static_cast<M_StdMemoryViewObject*>(obj))
 
+/* Window on the memory of another object. A view only records where its
+ * items are within the exporter's buffer, so slicing a view never copies:
+ * it yields a view of the same memory with a different offset, length and
+ * stride. The exporter's buffer is fetched again on every access, which
+ * keeps a view of a bytearray safe when the bytearray is resized. */
 class M_StdMemoryViewObject : public M_BaseObject {
 private:
+    M_BaseObject* obj; /* nullptr once released */
+    std::size_t offset; /* of the first item in the exporter's buffer */
+    std::size_t length; /* in items */
+    std::ptrdiff_t stride;
+    std::size_t itemsize;
+    const char* format;
+    bool readonly;
+
+    /* Current buffer of the view, raising ValueError if the view has been
+     * released or no longer fits in the exporter */
+    Buffer acquire(vm::ThreadContext* context);
+    M_StdMemoryViewObject* subview(vm::ThreadContext* context,
+                                   std::size_t start, std::size_t n,
+                                   std::ptrdiff_t step);
+
 public:
-    M_StdMemoryViewObject();
+    /* View of all of view, which has been exported by obj */
+    M_StdMemoryViewObject(M_BaseObject* obj, const Buffer& view);
+
+    virtual void get_buffer(ObjSpace* space, Buffer& view);
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        if (obj) gc->mark_object(obj);
+    }
+
+    static M_BaseObject* __new__(vm::ThreadContext* context,
+                                 M_BaseObject* type, M_BaseObject* object);
+    static M_BaseObject* __repr__(vm::ThreadContext* context,
+                                  M_BaseObject* self);
+    static M_BaseObject* __len__(vm::ThreadContext* context,
+                                 M_BaseObject* self);
+    static M_BaseObject* __iter__(vm::ThreadContext* context,
+                                  M_BaseObject* self);
+    static M_BaseObject* __getitem__(vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* index);
+    static M_BaseObject* __setitem__(vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* index,
+                                     M_BaseObject* value);
+    static M_BaseObject* __eq__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* __ne__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* __enter__(vm::ThreadContext* context,
+                                   M_BaseObject* self);
+    static M_BaseObject* __exit__(vm::ThreadContext* context,
+                                  const interpreter::Arguments& args);
+
+    static M_BaseObject* tobytes(vm::ThreadContext* context,
+                                 M_BaseObject* self);
+    static M_BaseObject* tolist(vm::ThreadContext* context, M_BaseObject* self);
+    static M_BaseObject* hex(vm::ThreadContext* context, M_BaseObject* self);
+    static M_BaseObject* release(vm::ThreadContext* context,
+                                 M_BaseObject* self);
+
+    static M_BaseObject* obj_get(vm::ThreadContext* context,
+                                 M_BaseObject* self);
+    static M_BaseObject* nbytes_get(vm::ThreadContext* context,
+                                    M_BaseObject* self);
+    static M_BaseObject* readonly_get(vm::ThreadContext* context,
+                                      M_BaseObject* self);
+    static M_BaseObject* itemsize_get(vm::ThreadContext* context,
+                                      M_BaseObject* self);
+    static M_BaseObject* format_get(vm::ThreadContext* context,
+                                    M_BaseObject* self);
+    static M_BaseObject* strides_get(vm::ThreadContext* context,
+                                     M_BaseObject* self);
+    static M_BaseObject* contiguous_get(vm::ThreadContext* context,
+                                        M_BaseObject* self);
 
     static interpreter::Typedef* _memoryview_typedef();
     interpreter::Typedef* get_typedef();
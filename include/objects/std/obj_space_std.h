@@ -16,6 +16,8 @@ private:
     M_BaseObject* wrapped_True;
     M_BaseObject* wrapped_False;
     M_BaseObject* wrapped_NotImplemented;
+    M_BaseObject* empty_tuple;
+    M_BaseObject* ascii_chars[128];
 
     std::unordered_map<std::string, M_BaseObject*> builtin_types;
 
@@ -42,6 +44,7 @@ public:
 
     M_BaseObject* type(M_BaseObject* obj) { return obj->get_class(this); }
     std::string get_type_name(M_BaseObject* obj);
+    const TypeSlots* type_slots(M_BaseObject* obj);
 
     M_BaseObject* get_type_by_name(const std::string& name);
 
@@ -53,24 +56,44 @@ public:
     M_BaseObject* wrap_int(vm::ThreadContext* context, int x);
     M_BaseObject* wrap_int(vm::ThreadContext* context, const std::string& x);
 
+    M_BaseObject* wrap_float(vm::ThreadContext* context, double x);
+    M_BaseObject* wrap_float(vm::ThreadContext* context, const std::string& x);
+
     M_BaseObject* wrap_str(vm::ThreadContext* context, const std::string& x);
+    M_BaseObject* new_interned_str(const std::string& x);
 
     M_BaseObject* wrap_None() { return wrapped_None; }
     M_BaseObject* wrap_True() { return wrapped_True; }
     M_BaseObject* wrap_False() { return wrapped_False; }
     M_BaseObject* wrap_NotImplemented() { return wrapped_NotImplemented; }
+    M_BaseObject* wrap_ascii_char(unsigned char c) { return ascii_chars[c]; }
+
+    /* Compares exact ints, floats and strs of the same type natively */
+    bool i_lt(M_BaseObject* obj1, M_BaseObject* obj2);
 
     int i_get_index(M_BaseObject* obj, M_BaseObject* exc, M_BaseObject* descr);
 
     M_BaseObject* new_tuple(vm::ThreadContext* context,
                             const std::vector<M_BaseObject*>& items);
+    M_BaseObject* new_tuple(vm::ThreadContext* context, std::size_t size);
+    M_BaseObject** tuple_items(M_BaseObject* tuple);
     M_BaseObject* new_list(vm::ThreadContext* context,
                            const std::vector<M_BaseObject*>& items);
     M_BaseObject* new_dict(vm::ThreadContext* context);
     M_BaseObject* new_set(vm::ThreadContext* context);
+    M_BaseObject* new_bytes(vm::ThreadContext* context, const void* data,
+                            std::size_t size);
     M_BaseObject* new_seqiter(vm::ThreadContext* context, M_BaseObject* obj);
+    M_BaseObject* new_slice(vm::ThreadContext* context, M_BaseObject* start,
+                            M_BaseObject* stop, M_BaseObject* step);
 
     void unwrap_tuple(M_BaseObject* obj, std::vector<M_BaseObject*>& list);
+
+    M_BaseObject* getitem_str(M_BaseObject* obj, const std::string& key);
+    M_BaseObject* finditem(M_BaseObject* obj, M_BaseObject* key);
+    M_BaseObject* finditem_str(M_BaseObject* obj, const std::string& key);
+    void setitem_str(M_BaseObject* obj, const std::string& key,
+                     M_BaseObject* value);
 };
 
 } // namespace objects
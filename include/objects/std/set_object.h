@@ -2,8 +2,9 @@
 #define _STD_SET_OBJECT_H_
 
 #include <string>
-#include <unordered_set>
+#include <cstdint>
 #include "objects/obj_space.h"
+#include "objects/gc_array.h"
 #include "objects/std/dict_object.h"
 #include "gc/garbage_collector.h"
 
@@ -15,10 +16,8 @@ class M_StdSetObject;
 class M_StdSetIterObject : public M_BaseObject {
 private:
     M_StdSetObject* set;
-    int index;
-    size_t size;
-    std::unordered_set<M_BaseObject*, M_StdObjectHasher,
-                       M_StdObjectEq>::iterator iter;
+    std::size_t pos;
+    std::size_t size;
 
 public:
     M_StdSetIterObject(M_StdSetObject* set);
@@ -30,56 +29,186 @@ public:
     virtual void mark_children(gc::GarbageCollector* gc);
 };
 
+/* Open-addressing hash set in the style of a Swiss table. Slots are split
+ * into groups of 16 with one control byte per slot holding either
+ * EMPTY, DELETED or the top 7 bits of the slot hash, so a probe compares a
+ * whole group of control bytes at once and only touches the slots whose
+ * bits match. Slots cache the full hash of their key, which makes resizing
+ * and set algebra between sets free of __hash__ calls. Both arrays live on
+ * the GC heap. */
 class M_StdSetObject : public M_BaseObject {
-private:
-    std::unordered_set<M_BaseObject*, M_StdObjectHasher, M_StdObjectEq> set;
-
+protected:
+    struct Slot {
+        std::size_t hash;
+        M_BaseObject* key; /* nullptr if the slot is not in use */
+
+        void mark_children(gc::GarbageCollector* gc)
+        {
+            if (key) gc->mark_object(key);
+        }
+    };
+
+    ObjSpace* space;
+    /* both nullptr until the first insertion */
+    M_GCArray<std::uint8_t>* ctrl;
+    M_GCArray<Slot>* slots;
+    std::size_t used;
+    std::size_t fill; /* used and deleted slots */
+
+    std::size_t lookup(M_BaseObject* key, std::size_t hash);
+    void resize(std::size_t min_used);
+    std::size_t find_free_slot(std::size_t hash);
+    void insert_hashed(M_BaseObject* key, std::size_t hash);
+    void erase_slot(std::size_t i);
+    void copy_from(vm::ThreadContext* context, M_StdSetObject* other);
     M_BaseObject* _discard(vm::ThreadContext* context, M_BaseObject* item);
 
+    /* Empty set of the same type */
+    virtual M_StdSetObject* new_empty(vm::ThreadContext* context)
+    {
+        return new (context) M_StdSetObject(space);
+    }
+
 public:
+    static constexpr std::size_t npos = (std::size_t)-1;
+
     M_StdSetObject(ObjSpace* space)
-        : set(5, M_StdObjectHasher(space), M_StdObjectEq(space))
+        : space(space), ctrl(nullptr), slots(nullptr), used(0), fill(0)
     {}
 
-    bool i_issubset(M_StdSetObject* other);
-    size_t size() { return set.size(); }
-    std::unordered_set<M_BaseObject*, M_StdObjectHasher,
-                       M_StdObjectEq>::iterator
-    begin()
+    /* set storage lives in GC arrays, there is nothing to finalize */
+    void* operator new(std::size_t size, vm::ThreadContext* context)
     {
-        return set.begin();
+        return context->get_gc()->allocate(size, false);
     }
 
+    std::size_t size() const { return used; }
+
+    bool contains(M_BaseObject* key);
+    void insert(M_BaseObject* key);
+    bool erase(M_BaseObject* key);
+    void clear_entries();
+
+    /* Add all items of an iterable. Items of other sets are inserted with
+     * their cached hashes */
+    void update_from(M_BaseObject* iterable);
+    bool i_issubset(M_StdSetObject* other);
+
+    /* Find the next element starting at slot pos. Returns false at the end */
+    bool next_entry(std::size_t& pos, M_BaseObject*& key);
+
     static objects::M_BaseObject* __new__(vm::ThreadContext* context,
                                           const interpreter::Arguments& args);
     static objects::M_BaseObject* __init__(vm::ThreadContext* context,
                                            const interpreter::Arguments& args);
     static M_BaseObject* __repr__(vm::ThreadContext* context,
                                   M_BaseObject* self);
+    static M_BaseObject* __len__(vm::ThreadContext* context,
+                                 M_BaseObject* self);
     static M_BaseObject* __contains__(vm::ThreadContext* context,
                                       M_BaseObject* self, M_BaseObject* obj);
-    static M_BaseObject* __le__(vm::ThreadContext* context, M_BaseObject* self,
-                                M_BaseObject* other);
     static M_BaseObject* __iter__(vm::ThreadContext* context,
                                   M_BaseObject* self);
 
+    static M_BaseObject* __eq__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* __ne__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* __le__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* __lt__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* __ge__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* __gt__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+
+    static M_BaseObject* __or__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* __and__(vm::ThreadContext* context,
+                                 M_BaseObject* self, M_BaseObject* other);
+    static M_BaseObject* __sub__(vm::ThreadContext* context,
+                                 M_BaseObject* self, M_BaseObject* other);
+    static M_BaseObject* __xor__(vm::ThreadContext* context,
+                                 M_BaseObject* self, M_BaseObject* other);
+    static M_BaseObject* __ior__(vm::ThreadContext* context,
+                                 M_BaseObject* self, M_BaseObject* other);
+    static M_BaseObject* __iand__(vm::ThreadContext* context,
+                                  M_BaseObject* self, M_BaseObject* other);
+    static M_BaseObject* __isub__(vm::ThreadContext* context,
+                                  M_BaseObject* self, M_BaseObject* other);
+    static M_BaseObject* __ixor__(vm::ThreadContext* context,
+                                  M_BaseObject* self, M_BaseObject* other);
+
+    static M_BaseObject* union_(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* intersection(vm::ThreadContext* context,
+                                      M_BaseObject* self, M_BaseObject* other);
+    static M_BaseObject* difference(vm::ThreadContext* context,
+                                    M_BaseObject* self, M_BaseObject* other);
+    static M_BaseObject* symmetric_difference(vm::ThreadContext* context,
+                                              M_BaseObject* self,
+                                              M_BaseObject* other);
+    static M_BaseObject* issubset(vm::ThreadContext* context,
+                                  M_BaseObject* self, M_BaseObject* other);
+    static M_BaseObject* issuperset(vm::ThreadContext* context,
+                                    M_BaseObject* self, M_BaseObject* other);
+    static M_BaseObject* isdisjoint(vm::ThreadContext* context,
+                                    M_BaseObject* self, M_BaseObject* other);
+    static M_BaseObject* copy(vm::ThreadContext* context, M_BaseObject* self);
+
     static M_BaseObject* add(vm::ThreadContext* context, M_BaseObject* self,
                              M_BaseObject* item);
     static M_BaseObject* remove(vm::ThreadContext* context, M_BaseObject* self,
                                 M_BaseObject* item);
     static M_BaseObject* discard(vm::ThreadContext* context, M_BaseObject* self,
                                  M_BaseObject* item);
+    static M_BaseObject* pop(vm::ThreadContext* context, M_BaseObject* self);
+    static M_BaseObject* clear(vm::ThreadContext* context, M_BaseObject* self);
+    static M_BaseObject* update(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* intersection_update(vm::ThreadContext* context,
+                                             M_BaseObject* self,
+                                             M_BaseObject* other);
+    static M_BaseObject* difference_update(vm::ThreadContext* context,
+                                           M_BaseObject* self,
+                                           M_BaseObject* other);
+    static M_BaseObject* symmetric_difference_update(vm::ThreadContext* context,
+                                                     M_BaseObject* self,
+                                                     M_BaseObject* other);
 
     static interpreter::Typedef* _set_typedef();
-    interpreter::Typedef* get_typedef();
+    virtual interpreter::Typedef* get_typedef();
 
     virtual void mark_children(gc::GarbageCollector* gc)
     {
-        for (const auto& obj : set)
-            gc->mark_object(obj);
+        if (!slots) return;
+        gc->mark_object(ctrl);
+        gc->mark_object(slots);
     }
 };
 
+/* Immutable set. It shares the table with set and only exposes the
+ * operations that do not modify it */
+class M_StdFrozenSetObject : public M_StdSetObject {
+protected:
+    virtual M_StdSetObject* new_empty(vm::ThreadContext* context)
+    {
+        return new (context) M_StdFrozenSetObject(space);
+    }
+
+public:
+    M_StdFrozenSetObject(ObjSpace* space) : M_StdSetObject(space) {}
+
+    static objects::M_BaseObject* __new__(vm::ThreadContext* context,
+                                          const interpreter::Arguments& args);
+    static M_BaseObject* __hash__(vm::ThreadContext* context,
+                                  M_BaseObject* self);
+
+    static interpreter::Typedef* _frozenset_typedef();
+    virtual interpreter::Typedef* get_typedef();
+};
+
 } // namespace objects
 } // namespace mtpython
 
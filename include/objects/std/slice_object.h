@@ -0,0 +1,57 @@
+#ifndef _STD_SLICE_OBJECT_H_
+#define _STD_SLICE_OBJECT_H_
+
+#include <string>
+#include "objects/obj_space.h"
+#include "interpreter/arguments.h"
+#include "gc/garbage_collector.h"
+
+namespace mtpython {
+namespace objects {
+
+class M_StdSliceObject : public M_BaseObject {
+private:
+    M_BaseObject* start;
+    M_BaseObject* stop;
+    M_BaseObject* step;
+
+public:
+    M_StdSliceObject(M_BaseObject* start, M_BaseObject* stop,
+                     M_BaseObject* step)
+        : start(start), stop(stop), step(step)
+    {}
+
+    /* Resolve the slice against a sequence of the given length, clamping
+     * start and stop like CPython. Returns the number of selected items */
+    std::size_t unpack_indices(ObjSpace* space, std::size_t length,
+                               long& start, long& stop, long& step);
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(start);
+        gc->mark_object(stop);
+        gc->mark_object(step);
+    }
+
+    static M_BaseObject* __new__(vm::ThreadContext* context,
+                                 const interpreter::Arguments& args);
+    static M_BaseObject* __repr__(vm::ThreadContext* context,
+                                  M_BaseObject* self);
+    static M_BaseObject* indices(vm::ThreadContext* context, M_BaseObject* self,
+                                 M_BaseObject* length);
+
+    static M_BaseObject* start_get(vm::ThreadContext* context,
+                                   M_BaseObject* self);
+    static M_BaseObject* stop_get(vm::ThreadContext* context,
+                                  M_BaseObject* self);
+    static M_BaseObject* step_get(vm::ThreadContext* context,
+                                  M_BaseObject* self);
+
+    static interpreter::Typedef* _slice_typedef();
+    virtual interpreter::Typedef* get_typedef();
+};
+
+} // namespace objects
+} // namespace mtpython
+
+#endif /* _STD_SLICE_OBJECT_H_ */
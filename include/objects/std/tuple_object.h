@@ -3,22 +3,54 @@
 
 #include <string>
 #include <vector>
+#include <algorithm>
 #include "objects/obj_space.h"
+#include "gc/garbage_collector.h"
 
 namespace mtpython {
 namespace objects {
 
 #define M_STDTUPLEOBJECT(obj) (static_cast<M_StdTupleObject*>(obj))
 
+/* Tuples are allocated as a single GC object with the items stored inline
+ * right after it */
 class M_StdTupleObject : public M_BaseObject {
 private:
-    std::vector<M_BaseObject*> items;
+    std::size_t count;
+
+    M_StdTupleObject(std::size_t count) : count(count)
+    {
+        std::fill(begin(), end(), nullptr);
+    }
+
+    void* operator new(std::size_t size, vm::ThreadContext* context,
+                       std::size_t count);
 
 public:
-    M_StdTupleObject() {}
-    M_StdTupleObject(const std::vector<M_BaseObject*>& items) : items(items) {}
+    /* Tuple of count items that are all nullptr until filled in */
+    static M_StdTupleObject* create(vm::ThreadContext* context,
+                                    std::size_t count);
+
+    std::size_t size() const { return count; }
+    M_BaseObject** begin()
+    {
+        return reinterpret_cast<M_BaseObject**>(this + 1);
+    }
+    M_BaseObject** end() { return begin() + count; }
+    M_BaseObject*& operator[](std::size_t i) { return begin()[i]; }
 
-    std::vector<M_BaseObject*>& get_items() { return items; }
+    virtual void unpack_iterable(ObjSpace* space,
+                                 std::vector<M_BaseObject*>& list)
+    {
+        list.insert(list.end(), begin(), end());
+    }
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        for (auto* item : *this) {
+            if (item) gc->mark_object(item);
+        }
+    }
 
     static interpreter::Typedef* _tuple_typedef();
     virtual interpreter::Typedef* get_typedef();
@@ -29,6 +61,12 @@ public:
                                  M_BaseObject* self);
     static M_BaseObject* __repr__(vm::ThreadContext* context,
                                   M_BaseObject* self);
+    static M_BaseObject* __hash__(vm::ThreadContext* context,
+                                  M_BaseObject* self);
+    static M_BaseObject* __eq__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
+    static M_BaseObject* __ne__(vm::ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other);
     static M_BaseObject* __getitem__(vm::ThreadContext* context,
                                      M_BaseObject* obj, M_BaseObject* key);
     static M_BaseObject* __contains__(vm::ThreadContext* context,
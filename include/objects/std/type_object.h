@@ -1,12 +1,14 @@
 #ifndef _STD_TYPE_OBJECT_H_
 #define _STD_TYPE_OBJECT_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
 
 #include "objects/base_object.h"
 #include "objects/space_cache.h"
+#include "objects/type_slots.h"
 #include "interpreter/arguments.h"
 #include "vm/vm.h"
 #include "gc/garbage_collector.h"
@@ -22,11 +24,16 @@ private:
     std::unordered_map<std::string, M_BaseObject*> dict;
     M_BaseObject* wrapped_dict;
     std::vector<M_BaseObject*> mro;
-    std::vector<M_BaseObject*> subclasses;
+    /* Subclasses are only weakly referenced through the handle each type
+     * owns, the handle expires when the type is finalized */
+    std::shared_ptr<M_StdTypeObject*> handle;
+    std::vector<std::weak_ptr<M_StdTypeObject*>> subclasses;
     bool _has_dict;
     M_BaseObject* cls;
+    TypeSlots slots;
 
     void init_mro();
+    void update_slots();
 
     void ready();
 
@@ -49,6 +56,9 @@ public:
     M_BaseObject* get_dict_value(ObjSpace* space, const std::string& attr);
     bool set_dict_value(ObjSpace* space, const std::string& attr,
                         M_BaseObject* value);
+    bool del_dict_value(ObjSpace* space, const std::string& attr);
+
+    const TypeSlots* get_slots() const { return &slots; }
 
     M_BaseObject* lookup(const std::string& name);
     M_BaseObject* lookup_starting_at(M_BaseObject* start,
@@ -56,7 +66,7 @@ public:
     M_BaseObject* lookup_cls(const std::string& attr, M_BaseObject*& cls);
 
     void add_subclass(M_BaseObject* cls);
-    const std::vector<M_BaseObject*>& get_subclasses();
+    std::vector<M_BaseObject*> get_subclasses();
     bool issubtype(M_BaseObject* type);
 
     virtual void mark_children(gc::GarbageCollector* gc);
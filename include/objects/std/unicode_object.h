@@ -2,7 +2,11 @@
 #define _STD_STR_OBJECT_H_
 
 #include <string>
+#include <vector>
+#include <cstdint>
 #include "objects/base_object.h"
+#include "interpreter/arguments.h"
+#include "gc/garbage_collector.h"
 
 namespace mtpython {
 namespace objects {
@@ -11,18 +15,97 @@ namespace objects {
 
 class M_StdUnicodeObject : public M_BaseObject {
 private:
-    std::string value;
+    /* Byte offset of every INDEX_STEP-th code point is recorded for non-ASCII
+     * strings so that indexing needs to scan at most INDEX_STEP code points */
+    static constexpr std::size_t INDEX_STEP = 64;
+    /* Concatenations shorter than this are copied right away */
+    static constexpr std::size_t ROPE_MIN_SIZE = 256;
+
+    /* UTF-8 encoded, lone surrogates are stored as three byte sequences.
+     * Values are validated when the str is created and malformed bytes are
+     * replaced with U+FFFD, so that lengths and offsets stay consistent */
+    mutable std::string value;
+    std::size_t size;          /* in bytes */
+    std::size_t length;        /* in code points */
+    bool ascii;
+    mutable std::vector<std::uint32_t> offsets;
+    mutable std::size_t hash_value;
+    mutable bool hash_cached;
+    bool interned;
+
+    /* Longer concatenations only keep their operands until the value is
+     * needed, so that building a string with repeated += takes linear time.
+     * Both are nullptr once value holds the result. */
+    mutable M_StdUnicodeObject* left;
+    mutable M_StdUnicodeObject* right;
+
+    void scan();
+    void replace_invalid(std::size_t pos);
+    std::size_t index_offsets(std::size_t prefix) const;
+    void flatten() const;
 
 public:
     M_StdUnicodeObject(const std::string& s);
+    M_StdUnicodeObject(std::string&& s);
+    M_StdUnicodeObject(M_StdUnicodeObject* left, M_StdUnicodeObject* right);
+
+    const std::string& get_value() const
+    {
+        if (left) flatten();
+        return value;
+    }
+    std::size_t byte_length() const { return size; }
+    bool is_ascii() const { return ascii; }
+    std::size_t char_length() const { return length; }
+
+    /* Length in bytes of the code point starting at byte offset pos */
+    std::size_t char_size(std::size_t pos) const;
+    /* Byte offset of the i-th code point */
+    std::size_t byte_offset(std::size_t i) const;
+    /* Number of code points before byte offset pos */
+    std::size_t char_index(std::size_t pos) const;
+    /* Code point starting at byte offset pos */
+    std::uint32_t code_point(std::size_t pos) const;
+    /* UTF-8 encoding of cp */
+    static std::string from_code_point(std::uint32_t cp);
+    /* One-character string for the code point at byte offset pos */
+    M_BaseObject* char_at(vm::ThreadContext* context, std::size_t pos) const;
+
+    /* Same value as hash() of a str holding s */
+    static std::size_t hash_string(const std::string& s);
+    std::size_t hash() const
+    {
+        if (!hash_cached) {
+            hash_value = hash_string(get_value());
+            hash_cached = true;
+        }
+        return hash_value;
+    }
+
+    /* Interned strings with equal values are the same object, so two
+     * different interned strings never compare equal */
+    bool is_interned() const { return interned; }
+    void set_interned() { interned = true; }
 
     bool i_is(ObjSpace* space, M_BaseObject* other);
 
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        if (left) {
+            gc->mark_object(left);
+            gc->mark_object(right);
+        }
+    }
+
     static M_BaseObject* __new__(mtpython::vm::ThreadContext* context,
                                  mtpython::objects::M_BaseObject* str_type,
                                  mtpython::objects::M_BaseObject* value);
     static M_BaseObject* __iter__(mtpython::vm::ThreadContext* context,
                                   M_BaseObject* self);
+    static M_BaseObject* __len__(mtpython::vm::ThreadContext* context,
+                                 M_BaseObject* self);
+    static M_BaseObject* __getitem__(mtpython::vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* index);
     static M_BaseObject* __repr__(mtpython::vm::ThreadContext* context,
                                   mtpython::objects::M_BaseObject* self);
     static M_BaseObject* __str__(mtpython::vm::ThreadContext* context,
@@ -32,15 +115,78 @@ public:
     static M_BaseObject* __eq__(mtpython::vm::ThreadContext* context,
                                 mtpython::objects::M_BaseObject* self,
                                 mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __add__(mtpython::vm::ThreadContext* context,
+                                 mtpython::objects::M_BaseObject* self,
+                                 mtpython::objects::M_BaseObject* other);
+    static M_BaseObject* __contains__(mtpython::vm::ThreadContext* context,
+                                      mtpython::objects::M_BaseObject* self,
+                                      mtpython::objects::M_BaseObject* other);
+
+    static M_BaseObject* find(mtpython::vm::ThreadContext* context,
+                              const interpreter::Arguments& args);
+    static M_BaseObject* rfind(mtpython::vm::ThreadContext* context,
+                               const interpreter::Arguments& args);
+    static M_BaseObject* index(mtpython::vm::ThreadContext* context,
+                               const interpreter::Arguments& args);
+    static M_BaseObject* rindex(mtpython::vm::ThreadContext* context,
+                                const interpreter::Arguments& args);
+    static M_BaseObject* count(mtpython::vm::ThreadContext* context,
+                               const interpreter::Arguments& args);
+    static M_BaseObject* split(mtpython::vm::ThreadContext* context,
+                               const interpreter::Arguments& args);
+    static M_BaseObject* rsplit(mtpython::vm::ThreadContext* context,
+                                const interpreter::Arguments& args);
+    static M_BaseObject* replace(mtpython::vm::ThreadContext* context,
+                                 const interpreter::Arguments& args);
+    static M_BaseObject* join(mtpython::vm::ThreadContext* context,
+                              mtpython::objects::M_BaseObject* self,
+                              mtpython::objects::M_BaseObject* iterable);
+    static M_BaseObject* strip(mtpython::vm::ThreadContext* context,
+                               const interpreter::Arguments& args);
+    static M_BaseObject* lstrip(mtpython::vm::ThreadContext* context,
+                                const interpreter::Arguments& args);
+    static M_BaseObject* rstrip(mtpython::vm::ThreadContext* context,
+                                const interpreter::Arguments& args);
+    static M_BaseObject* startswith(mtpython::vm::ThreadContext* context,
+                                    const interpreter::Arguments& args);
+    static M_BaseObject* endswith(mtpython::vm::ThreadContext* context,
+                                  const interpreter::Arguments& args);
+    static M_BaseObject* encode(mtpython::vm::ThreadContext* context,
+                                const interpreter::Arguments& args);
+    static M_BaseObject* isdigit(mtpython::vm::ThreadContext* context,
+                                 M_BaseObject* self);
+    static M_BaseObject* isidentifier(mtpython::vm::ThreadContext* context,
+                                      M_BaseObject* self);
 
     static interpreter::Typedef* _str_typedef();
     interpreter::Typedef* get_typedef();
 
-    std::string to_string(ObjSpace* space) { return value; }
+    std::string to_string(ObjSpace* space) { return get_value(); }
 
     void dbg_print();
 };
 
+class M_StdUnicodeIterObject : public M_BaseObject {
+private:
+    M_StdUnicodeObject* str;
+    std::size_t pos; /* byte offset */
+
+public:
+    M_StdUnicodeIterObject(M_StdUnicodeObject* str) : str(str), pos(0) {}
+
+    interpreter::Typedef* get_typedef();
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(str);
+    }
+
+    static M_BaseObject* __iter__(mtpython::vm::ThreadContext* context,
+                                  M_BaseObject* self);
+    static M_BaseObject* __next__(mtpython::vm::ThreadContext* context,
+                                  M_BaseObject* self);
+};
+
 } // namespace objects
 } // namespace mtpython
 
@@ -0,0 +1,94 @@
+#ifndef _TYPE_SLOTS_H_
+#define _TYPE_SLOTS_H_
+
+namespace mtpython {
+
+namespace vm {
+class ThreadContext;
+}
+
+namespace objects {
+
+class M_BaseObject;
+
+typedef M_BaseObject* (*UnarySlot)(vm::ThreadContext* context,
+                                   M_BaseObject* self);
+typedef M_BaseObject* (*BinarySlot)(vm::ThreadContext* context,
+                                    M_BaseObject* self, M_BaseObject* other);
+typedef M_BaseObject* (*TernarySlot)(vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* arg1,
+                                     M_BaseObject* arg2);
+
+/* Operator table of a type. Each slot points either to the native function
+ * behind a builtin dunder method or to a trampoline calling the dunder found
+ * by lookup. A null slot means the type does not implement the operation. */
+struct TypeSlots {
+    BinarySlot add = nullptr;
+    BinarySlot sub = nullptr;
+    BinarySlot mul = nullptr;
+    BinarySlot truediv = nullptr;
+    BinarySlot floordiv = nullptr;
+    BinarySlot mod = nullptr;
+    BinarySlot lshift = nullptr;
+    BinarySlot rshift = nullptr;
+    BinarySlot and_ = nullptr;
+    BinarySlot or_ = nullptr;
+    BinarySlot xor_ = nullptr;
+    BinarySlot pow = nullptr;
+
+    BinarySlot radd = nullptr;
+    BinarySlot rsub = nullptr;
+    BinarySlot rmul = nullptr;
+    BinarySlot rtruediv = nullptr;
+    BinarySlot rfloordiv = nullptr;
+    BinarySlot rmod = nullptr;
+    BinarySlot rlshift = nullptr;
+    BinarySlot rrshift = nullptr;
+    BinarySlot rand = nullptr;
+    BinarySlot ror = nullptr;
+    BinarySlot rxor = nullptr;
+    BinarySlot rpow = nullptr;
+
+    BinarySlot inplace_add = nullptr;
+    BinarySlot inplace_sub = nullptr;
+    BinarySlot inplace_mul = nullptr;
+    BinarySlot inplace_truediv = nullptr;
+    BinarySlot inplace_floordiv = nullptr;
+    BinarySlot inplace_mod = nullptr;
+    BinarySlot inplace_lshift = nullptr;
+    BinarySlot inplace_rshift = nullptr;
+    BinarySlot inplace_and = nullptr;
+    BinarySlot inplace_or = nullptr;
+    BinarySlot inplace_xor = nullptr;
+    BinarySlot inplace_pow = nullptr;
+
+    BinarySlot eq = nullptr;
+    BinarySlot ne = nullptr;
+    BinarySlot lt = nullptr;
+    BinarySlot le = nullptr;
+    BinarySlot gt = nullptr;
+    BinarySlot ge = nullptr;
+    BinarySlot contains = nullptr;
+
+    UnarySlot pos = nullptr;
+    UnarySlot neg = nullptr;
+    UnarySlot invert = nullptr;
+    UnarySlot abs = nullptr;
+
+    UnarySlot hash = nullptr;
+    UnarySlot bool_ = nullptr;
+    UnarySlot len = nullptr;
+    UnarySlot str = nullptr;
+    UnarySlot repr = nullptr;
+    UnarySlot iter = nullptr;
+    UnarySlot next = nullptr;
+
+    BinarySlot getitem = nullptr;
+    TernarySlot setitem = nullptr;
+    BinarySlot delitem = nullptr;
+};
+
+} // namespace objects
+} // namespace mtpython
+
+#endif /* _TYPE_SLOTS_H_ */
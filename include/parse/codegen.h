@@ -36,6 +36,9 @@ protected:
                    const std::vector<mtpython::tree::KeywordNode*>& keywords);
     void make_closure(mtpython::interpreter::PyCode* code, int args,
                       mtpython::objects::M_BaseObject* qualname);
+    void compile_comprehension(mtpython::tree::ASTNode* node,
+                               const std::string& name,
+                               mtpython::tree::ComprehensionNode* outermost);
 
     virtual int get_code_flags() { return CO_NEWLOCALS; }
 
@@ -66,13 +69,16 @@ public:
     mtpython::tree::ASTNode* visit_classdef(mtpython::tree::ClassDefNode* node);
     mtpython::tree::ASTNode* visit_compare(mtpython::tree::CompareNode* node);
     mtpython::tree::ASTNode* visit_const(mtpython::tree::ConstNode* node);
-    /*ASTNode* visit_continue(ContinueNode* node);
-    ASTNode* visit_delete(DeleteNode* node); */
+    mtpython::tree::ASTNode*
+    visit_continue(mtpython::tree::ContinueNode* node);
+    /*ASTNode* visit_delete(DeleteNode* node); */
     mtpython::tree::ASTNode* visit_dict(mtpython::tree::DictNode* node);
     mtpython::tree::ASTNode* visit_expr(mtpython::tree::ExprNode* node);
     mtpython::tree::ASTNode* visit_for(mtpython::tree::ForNode* node);
     mtpython::tree::ASTNode*
     visit_functiondef(mtpython::tree::FunctionDefNode* node);
+    mtpython::tree::ASTNode*
+    visit_generatorexp(mtpython::tree::GeneratorExpNode* node);
     mtpython::tree::ASTNode* visit_if(mtpython::tree::IfNode* node);
     mtpython::tree::ASTNode* visit_ifexp(mtpython::tree::IfExpNode* node);
     mtpython::tree::ASTNode* visit_import(mtpython::tree::ImportNode* node);
@@ -81,14 +87,16 @@ public:
     void import_as(mtpython::tree::AliasNode* node);
     mtpython::tree::ASTNode* visit_keyword(mtpython::tree::KeywordNode* node);
     mtpython::tree::ASTNode* visit_list(mtpython::tree::ListNode* node);
+    mtpython::tree::ASTNode* visit_listcomp(mtpython::tree::ListCompNode* node);
     mtpython::tree::ASTNode* visit_lambda(mtpython::tree::LambdaNode* node);
     mtpython::tree::ASTNode* visit_name(mtpython::tree::NameNode* node);
     mtpython::tree::ASTNode* visit_number(mtpython::tree::NumberNode* node);
     mtpython::tree::ASTNode* visit_string(mtpython::tree::StringNode* node);
     mtpython::tree::ASTNode* visit_pass(mtpython::tree::PassNode* node);
-    /*ASTNode* visit_raise(RaiseNode* node);*/
+    mtpython::tree::ASTNode* visit_raise(mtpython::tree::RaiseNode* node);
     mtpython::tree::ASTNode* visit_return(mtpython::tree::ReturnNode* node);
     mtpython::tree::ASTNode* visit_set(mtpython::tree::SetNode* node);
+    mtpython::tree::ASTNode* visit_slice(mtpython::tree::SliceNode* node);
     mtpython::tree::ASTNode*
     visit_subscript(mtpython::tree::SubscriptNode* node);
     mtpython::tree::ASTNode* visit_try(mtpython::tree::TryNode* node);
@@ -152,6 +160,23 @@ public:
                         int lineno, CompileInfo* info);
 };
 
+/* Body of a generator expression or list comprehension, called with the
+ * iterator of the outermost loop */
+class ComprehensionCodeGenerator : public AbstractFunctionCodeGenerator {
+private:
+    void compile(mtpython::tree::ASTNode* tree);
+    void
+    gen_loop(std::vector<mtpython::tree::ComprehensionNode*>& comprehensions,
+             std::size_t index, mtpython::tree::ASTNode* elt, bool is_list);
+
+public:
+    ComprehensionCodeGenerator(const std::string& name,
+                               mtpython::vm::ThreadContext* context,
+                               mtpython::tree::ASTNode* tree,
+                               SymtableVisitor* symtab, int lineno,
+                               CompileInfo* info);
+};
+
 class ClassCodeGenerator : public BaseCodeGenerator {
 private:
     void compile(mtpython::tree::ASTNode* tree);
@@ -151,6 +151,13 @@ private:
     void pop_scope();
 
     void add_name(const std::string& id, int flags);
+    void
+    visit_comprehension_scope(mtpython::tree::ASTNode* node,
+                              const std::string& name,
+                              mtpython::tree::ASTNode* elt,
+                              std::vector<mtpython::tree::ComprehensionNode*>&
+                                  comprehensions,
+                              bool is_generator);
 
 public:
     SymtableVisitor(mtpython::objects::ObjSpace* space,
@@ -175,9 +182,12 @@ public:
     /*ASTNode* visit_for(ForNode* node);*/
     mtpython::tree::ASTNode*
     visit_functiondef(mtpython::tree::FunctionDefNode* node);
+    mtpython::tree::ASTNode*
+    visit_generatorexp(mtpython::tree::GeneratorExpNode* node);
     /*ASTNode* visit_if(IfNode* node);
     ASTNode* visit_ifexp(IfExpNode* node);*/
     mtpython::tree::ASTNode* visit_lambda(mtpython::tree::LambdaNode* node);
+    mtpython::tree::ASTNode* visit_listcomp(mtpython::tree::ListCompNode* node);
     mtpython::tree::ASTNode* visit_name(mtpython::tree::NameNode* node);
     /*ASTNode* visit_number(NumberNode* node);
     ASTNode* visit_pass(PassNode* node);
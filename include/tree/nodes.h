@@ -40,6 +40,7 @@
 #include "tree/nodes/import_node.h"
 #include "tree/nodes/comprehension_node.h"
 #include "tree/nodes/generatorexp_node.h"
+#include "tree/nodes/listcomp_node.h"
 #include "tree/nodes/subscript_node.h"
 #include "tree/nodes/slice_node.h"
 #include "tree/nodes/list_node.h"
@@ -48,6 +48,7 @@ typedef enum {
     NT_IMPORT,
     NT_COMPREHENSION,
     NT_GENERATOREXP,
+    NT_LISTCOMP,
     NT_SUBSCRIPT,
     NT_INDEX,
     NT_LIST,
@@ -128,6 +129,7 @@ class ImportFromNode;
 class IndexNode;
 class KeywordNode;
 class LambdaNode;
+class ListCompNode;
 class ListNode;
 class NameNode;
 class NumberNode;
@@ -203,6 +205,7 @@ public:
     virtual ASTNode* visit_keyword(KeywordNode* node) { return nullptr; }
     virtual ASTNode* visit_lambda(LambdaNode* node) { return nullptr; }
     virtual ASTNode* visit_list(ListNode* node) { return nullptr; }
+    virtual ASTNode* visit_listcomp(ListCompNode* node) { return nullptr; }
     virtual ASTNode* visit_name(NameNode* node) { return nullptr; }
     virtual ASTNode* visit_string(StringNode* node) { return nullptr; }
     virtual ASTNode* visit_number(NumberNode* node) { return nullptr; }
@@ -95,7 +95,15 @@ public:
         return node;
     }
 
-    virtual ASTNode* visit_compare(CompareNode* node) { return node; }
+    virtual ASTNode* visit_compare(CompareNode* node)
+    {
+        node->get_left()->visit(this);
+        std::vector<ASTNode*>& comparators = node->get_comparators();
+        for (unsigned int i = 0; i < comparators.size(); i++) {
+            comparators[i]->visit(this);
+        }
+        return node;
+    }
 
     virtual ASTNode* visit_comprehension(ComprehensionNode* node)
     {
@@ -189,7 +197,13 @@ public:
         return node;
     }
 
-    virtual ASTNode* visit_ifexp(IfExpNode* node) { return node; }
+    virtual ASTNode* visit_ifexp(IfExpNode* node)
+    {
+        node->get_test()->visit(this);
+        node->get_body()->visit(this);
+        node->get_orelse()->visit(this);
+        return node;
+    }
 
     virtual ASTNode* visit_import(ImportNode* node)
     {
@@ -218,7 +232,11 @@ public:
         return node;
     }
 
-    virtual ASTNode* visit_keyword(KeywordNode* node) { return node; }
+    virtual ASTNode* visit_keyword(KeywordNode* node)
+    {
+        node->get_value()->visit(this);
+        return node;
+    }
 
     virtual ASTNode* visit_lambda(LambdaNode* node)
     {
@@ -237,6 +255,18 @@ public:
         return node;
     }
 
+    virtual ASTNode* visit_listcomp(ListCompNode* node)
+    {
+        node->get_elt()->visit(this);
+        std::vector<ComprehensionNode*>& comprehensions =
+            node->get_comprehensions();
+        for (unsigned int i = 0; i < comprehensions.size(); i++) {
+            comprehensions[i]->visit(this);
+        }
+
+        return node;
+    }
+
     virtual ASTNode* visit_name(NameNode* node) { return node; }
 
     virtual ASTNode* visit_number(NumberNode* node) { return node; }
@@ -245,7 +275,12 @@ public:
 
     virtual ASTNode* visit_pass(PassNode* node) { return node; }
 
-    virtual ASTNode* visit_raise(RaiseNode* node) { return node; }
+    virtual ASTNode* visit_raise(RaiseNode* node)
+    {
+        if (node->get_exc()) node->get_exc()->visit(this);
+        if (node->get_cause()) node->get_cause()->visit(this);
+        return node;
+    }
 
     virtual ASTNode* visit_return(ReturnNode* node)
     {
@@ -315,7 +350,11 @@ public:
         return node;
     }
 
-    virtual ASTNode* visit_unaryop(UnaryOpNode* node) { return node; }
+    virtual ASTNode* visit_unaryop(UnaryOpNode* node)
+    {
+        node->get_operand()->visit(this);
+        return node;
+    }
 
     virtual ASTNode* visit_while(WhileNode* node)
     {
@@ -355,7 +394,11 @@ public:
         return node;
     }
 
-    virtual ASTNode* visit_yieldfrom(YieldFromNode* node) { return node; }
+    virtual ASTNode* visit_yieldfrom(YieldFromNode* node)
+    {
+        node->get_value()->visit(this);
+        return node;
+    }
 };
 
 } // namespace tree
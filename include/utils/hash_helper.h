@@ -0,0 +1,17 @@
+#ifndef _HASH_HELPER_H_
+#define _HASH_HELPER_H_
+
+#include <cstddef>
+
+namespace mtpython {
+
+class HashHelper {
+public:
+    /* Non-cryptographic hash of a byte string (XXH64). Long inputs are
+     * consumed in 32-byte stripes by four independent accumulators */
+    static std::size_t hash_bytes(const void* data, std::size_t len);
+};
+
+} // namespace mtpython
+
+#endif /* _HASH_HELPER_H_ */
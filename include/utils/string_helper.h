@@ -0,0 +1,28 @@
+#ifndef _STRING_HELPER_H_
+#define _STRING_HELPER_H_
+
+#include <cstddef>
+#include <string>
+
+namespace mtpython {
+
+/* Byte string search used by str methods. Offsets are in bytes */
+class StringHelper {
+public:
+    static constexpr std::size_t npos = std::string::npos;
+
+    /* First occurrence of needle in haystack, or npos */
+    static std::size_t find(const char* haystack, std::size_t n,
+                            const char* needle, std::size_t m);
+    /* Last occurrence of needle in haystack, or npos */
+    static std::size_t rfind(const char* haystack, std::size_t n,
+                             const char* needle, std::size_t m);
+    /* Number of non-overlapping occurrences, at most maxcount */
+    static std::size_t count(const char* haystack, std::size_t n,
+                             const char* needle, std::size_t m,
+                             std::size_t maxcount = npos);
+};
+
+} // namespace mtpython
+
+#endif /* _STRING_HELPER_H_ */
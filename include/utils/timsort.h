@@ -0,0 +1,414 @@
+#ifndef _TIMSORT_H_
+#define _TIMSORT_H_
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+namespace mtpython {
+
+/* Stable natural merge sort, following the algorithm of CPython's listsort.
+ * less(a, b) must return true if a sorts strictly before b and may throw, in
+ * which case the range is left with unspecified contents */
+template <typename T, typename Less> class TimSort {
+private:
+    static constexpr std::ptrdiff_t MIN_GALLOP = 7;
+
+    struct Run {
+        std::ptrdiff_t start;
+        std::ptrdiff_t len;
+    };
+
+    T* base;
+    Less& less;
+    std::vector<T> tmp;
+    std::vector<Run> runs;
+    std::ptrdiff_t min_gallop;
+
+    static std::ptrdiff_t compute_minrun(std::ptrdiff_t n)
+    {
+        std::ptrdiff_t r = 0;
+        while (n >= 64) {
+            r |= n & 1;
+            n >>= 1;
+        }
+        return n + r;
+    }
+
+    /* Length of the run starting at lo. A descending run must be strictly
+     * descending so that reversing it keeps the sort stable */
+    std::ptrdiff_t count_run(T* lo, T* hi, bool& descending)
+    {
+        descending = false;
+        if (lo + 1 == hi) return 1;
+
+        T* p = lo + 1;
+        if (less(*p, *(p - 1))) {
+            descending = true;
+            for (p++; p < hi && less(*p, *(p - 1)); p++)
+                ;
+        } else {
+            for (p++; p < hi && !less(*p, *(p - 1)); p++)
+                ;
+        }
+
+        return p - lo;
+    }
+
+    /* Sort [lo, hi) given that [lo, start) is already sorted */
+    void binary_insertion_sort(T* lo, T* hi, T* start)
+    {
+        for (; start < hi; start++) {
+            T pivot = *start;
+            T* l = lo;
+            T* r = start;
+            while (l < r) {
+                T* m = l + ((r - l) >> 1);
+                if (less(pivot, *m))
+                    r = m;
+                else
+                    l = m + 1;
+            }
+            std::move_backward(l, start, start + 1);
+            *l = pivot;
+        }
+    }
+
+    /* Leftmost position k in the sorted a[0:n] such that a[k-1] < key <=
+     * a[k], searching outwards from hint */
+    std::ptrdiff_t gallop_left(const T& key, T* a, std::ptrdiff_t n,
+                               std::ptrdiff_t hint)
+    {
+        std::ptrdiff_t ofs = 1, lastofs = 0, maxofs, k;
+
+        a += hint;
+        if (less(*a, key)) {
+            maxofs = n - hint;
+            while (ofs < maxofs && less(a[ofs], key)) {
+                lastofs = ofs;
+                ofs = (ofs << 1) + 1;
+            }
+            if (ofs > maxofs) ofs = maxofs;
+            lastofs += hint;
+            ofs += hint;
+        } else {
+            maxofs = hint + 1;
+            while (ofs < maxofs && !less(*(a - ofs), key)) {
+                lastofs = ofs;
+                ofs = (ofs << 1) + 1;
+            }
+            if (ofs > maxofs) ofs = maxofs;
+            k = lastofs;
+            lastofs = hint - ofs;
+            ofs = hint - k;
+        }
+        a -= hint;
+
+        /* a[lastofs] < key <= a[ofs] */
+        lastofs++;
+        while (lastofs < ofs) {
+            std::ptrdiff_t m = lastofs + ((ofs - lastofs) >> 1);
+            if (less(a[m], key))
+                lastofs = m + 1;
+            else
+                ofs = m;
+        }
+        return ofs;
+    }
+
+    /* Rightmost position k in the sorted a[0:n] such that a[k-1] <= key <
+     * a[k], searching outwards from hint */
+    std::ptrdiff_t gallop_right(const T& key, T* a, std::ptrdiff_t n,
+                                std::ptrdiff_t hint)
+    {
+        std::ptrdiff_t ofs = 1, lastofs = 0, maxofs, k;
+
+        a += hint;
+        if (less(key, *a)) {
+            maxofs = hint + 1;
+            while (ofs < maxofs && less(key, *(a - ofs))) {
+                lastofs = ofs;
+                ofs = (ofs << 1) + 1;
+            }
+            if (ofs > maxofs) ofs = maxofs;
+            k = lastofs;
+            lastofs = hint - ofs;
+            ofs = hint - k;
+        } else {
+            maxofs = n - hint;
+            while (ofs < maxofs && !less(key, a[ofs])) {
+                lastofs = ofs;
+                ofs = (ofs << 1) + 1;
+            }
+            if (ofs > maxofs) ofs = maxofs;
+            lastofs += hint;
+            ofs += hint;
+        }
+        a -= hint;
+
+        /* a[lastofs] <= key < a[ofs] */
+        lastofs++;
+        while (lastofs < ofs) {
+            std::ptrdiff_t m = lastofs + ((ofs - lastofs) >> 1);
+            if (less(key, a[m]))
+                ofs = m;
+            else
+                lastofs = m + 1;
+        }
+        return ofs;
+    }
+
+    /* Merge the adjacent runs pa[0:na] and pb[0:nb] with na <= nb */
+    void merge_lo(T* pa, std::ptrdiff_t na, T* pb, std::ptrdiff_t nb)
+    {
+        std::ptrdiff_t k, acount, bcount, mg;
+        T *a, *b, *dest;
+
+        tmp.assign(pa, pa + na);
+        a = tmp.data();
+        b = pb;
+        dest = pa;
+
+        *dest++ = *b++;
+        if (--nb == 0) goto succeed;
+        if (na == 1) goto copy_b;
+
+        mg = min_gallop;
+        for (;;) {
+            acount = bcount = 0;
+
+            /* one at a time until one run wins consistently */
+            for (;;) {
+                if (less(*b, *a)) {
+                    *dest++ = *b++;
+                    bcount++;
+                    acount = 0;
+                    if (--nb == 0) goto succeed;
+                    if (bcount >= mg) break;
+                } else {
+                    *dest++ = *a++;
+                    acount++;
+                    bcount = 0;
+                    if (--na == 1) goto copy_b;
+                    if (acount >= mg) break;
+                }
+            }
+
+            /* galloping mode */
+            mg++;
+            do {
+                mg -= mg > 1;
+                min_gallop = mg;
+
+                k = gallop_right(*b, a, na, 0);
+                acount = k;
+                if (k) {
+                    dest = std::copy(a, a + k, dest);
+                    a += k;
+                    na -= k;
+                    if (na == 1) goto copy_b;
+                    if (na == 0) goto succeed;
+                }
+                *dest++ = *b++;
+                if (--nb == 0) goto succeed;
+
+                k = gallop_left(*a, b, nb, 0);
+                bcount = k;
+                if (k) {
+                    dest = std::copy(b, b + k, dest);
+                    b += k;
+                    nb -= k;
+                    if (nb == 0) goto succeed;
+                }
+                *dest++ = *a++;
+                if (--na == 1) goto copy_b;
+            } while (acount >= MIN_GALLOP || bcount >= MIN_GALLOP);
+
+            min_gallop = ++mg;
+        }
+
+    succeed:
+        std::copy(a, a + na, dest);
+        return;
+
+    copy_b:
+        /* the last element of a belongs at the end */
+        dest = std::copy(b, b + nb, dest);
+        *dest = *a;
+    }
+
+    /* Merge the adjacent runs pa[0:na] and pb[0:nb] with na >= nb */
+    void merge_hi(T* pa, std::ptrdiff_t na, T* pb, std::ptrdiff_t nb)
+    {
+        std::ptrdiff_t k, acount, bcount, mg;
+        T *a, *b, *dest, *baseb;
+
+        tmp.assign(pb, pb + nb);
+        baseb = tmp.data();
+        a = pa + na - 1;
+        b = baseb + nb - 1;
+        dest = pb + nb - 1;
+
+        *dest-- = *a--;
+        if (--na == 0) goto succeed;
+        if (nb == 1) goto copy_a;
+
+        mg = min_gallop;
+        for (;;) {
+            acount = bcount = 0;
+
+            for (;;) {
+                if (less(*b, *a)) {
+                    *dest-- = *a--;
+                    acount++;
+                    bcount = 0;
+                    if (--na == 0) goto succeed;
+                    if (acount >= mg) break;
+                } else {
+                    *dest-- = *b--;
+                    bcount++;
+                    acount = 0;
+                    if (--nb == 1) goto copy_a;
+                    if (bcount >= mg) break;
+                }
+            }
+
+            mg++;
+            do {
+                mg -= mg > 1;
+                min_gallop = mg;
+
+                k = na - gallop_right(*b, pa, na, na - 1);
+                acount = k;
+                if (k) {
+                    dest -= k;
+                    a -= k;
+                    std::copy_backward(a + 1, a + 1 + k, dest + 1 + k);
+                    na -= k;
+                    if (na == 0) goto succeed;
+                }
+                *dest-- = *b--;
+                if (--nb == 1) goto copy_a;
+
+                k = nb - gallop_left(*a, baseb, nb, nb - 1);
+                bcount = k;
+                if (k) {
+                    dest -= k;
+                    b -= k;
+                    std::copy(b + 1, b + 1 + k, dest + 1);
+                    nb -= k;
+                    if (nb == 1) goto copy_a;
+                    if (nb == 0) goto succeed;
+                }
+                *dest-- = *a--;
+                if (--na == 0) goto succeed;
+            } while (acount >= MIN_GALLOP || bcount >= MIN_GALLOP);
+
+            min_gallop = ++mg;
+        }
+
+    succeed:
+        std::copy(baseb, baseb + nb, dest - (nb - 1));
+        return;
+
+    copy_a:
+        /* the first element of b belongs at the front */
+        dest -= na;
+        a -= na;
+        std::copy_backward(a + 1, a + 1 + na, dest + 1 + na);
+        *dest = *b;
+    }
+
+    void merge_at(std::size_t i)
+    {
+        T* pa = base + runs[i].start;
+        std::ptrdiff_t na = runs[i].len;
+        T* pb = base + runs[i + 1].start;
+        std::ptrdiff_t nb = runs[i + 1].len;
+
+        runs[i].len = na + nb;
+        runs.erase(runs.begin() + i + 1);
+
+        /* elements of a already in place */
+        std::ptrdiff_t k = gallop_right(*pb, pa, na, 0);
+        pa += k;
+        na -= k;
+        if (na == 0) return;
+
+        /* elements of b already in place */
+        nb = gallop_left(pa[na - 1], pb, nb, nb - 1);
+        if (nb == 0) return;
+
+        if (na <= nb)
+            merge_lo(pa, na, pb, nb);
+        else
+            merge_hi(pa, na, pb, nb);
+    }
+
+    /* Keep the run lengths on the stack growing faster than the Fibonacci
+     * numbers so that merges stay balanced */
+    void merge_collapse()
+    {
+        while (runs.size() > 1) {
+            std::size_t n = runs.size() - 2;
+            if ((n > 0 && runs[n - 1].len <= runs[n].len + runs[n + 1].len) ||
+                (n > 1 && runs[n - 2].len <= runs[n - 1].len + runs[n].len)) {
+                if (runs[n - 1].len < runs[n + 1].len) n--;
+            } else if (runs[n].len > runs[n + 1].len) {
+                break;
+            }
+            merge_at(n);
+        }
+    }
+
+    void merge_force_collapse()
+    {
+        while (runs.size() > 1) {
+            std::size_t n = runs.size() - 2;
+            if (n > 0 && runs[n - 1].len < runs[n + 1].len) n--;
+            merge_at(n);
+        }
+    }
+
+public:
+    TimSort(T* base, Less& less)
+        : base(base), less(less), min_gallop(MIN_GALLOP)
+    {}
+
+    void sort(std::ptrdiff_t n)
+    {
+        if (n < 2) return;
+
+        std::ptrdiff_t minrun = compute_minrun(n);
+        std::ptrdiff_t lo = 0;
+
+        while (lo < n) {
+            bool descending;
+            std::ptrdiff_t len = count_run(base + lo, base + n, descending);
+            if (descending) std::reverse(base + lo, base + lo + len);
+
+            /* extend short runs to minrun */
+            if (len < minrun) {
+                std::ptrdiff_t force = std::min(n - lo, minrun);
+                binary_insertion_sort(base + lo, base + lo + force,
+                                      base + lo + len);
+                len = force;
+            }
+
+            runs.push_back({lo, len});
+            merge_collapse();
+            lo += len;
+        }
+
+        merge_force_collapse();
+    }
+};
+
+template <typename T, typename Less> void timsort(T* first, T* last, Less less)
+{
+    TimSort<T, Less>(first, less).sort(last - first);
+}
+
+} // namespace mtpython
+
+#endif /* _TIMSORT_H_ */
@@ -21,6 +21,7 @@ public:
     void init_bootstrap_path(const std::string& executable);
     void run_file(const std::string& filename);
     void run_toplevel(std::function<void()> f);
+    void flush_std_files();
 
     void mark_roots();
 
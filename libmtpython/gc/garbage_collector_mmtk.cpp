@@ -149,7 +149,7 @@ GarbageCollectorMmtk::create_context(vm::ThreadContext* thread)
     return std::make_unique<detail::Context>(thread);
 }
 
-void* GarbageCollectorMmtk::allocate(size_t size)
+void* GarbageCollectorMmtk::allocate(size_t size, bool finalize)
 {
     auto* context = static_cast<detail::Context*>(
         vm::ThreadContext::current_thread()->gc_context());
@@ -164,7 +164,7 @@ void* GarbageCollectorMmtk::allocate(size_t size)
     void* obj = (char*)addr + prefix_size;
     mmtk_post_alloc(context->mutator_, obj, mmtk_alloc_size, 0);
 
-    mmtk_add_finalizer(obj);
+    if (finalize) mmtk_add_finalizer(obj);
 
     return obj;
 }
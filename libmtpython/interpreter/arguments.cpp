@@ -1,4 +1,5 @@
 #include <memory>
+#include <algorithm>
 
 #include "interpreter/arguments.h"
 #include "objects/obj_space.h"
@@ -62,13 +63,11 @@ void Arguments::parse(const std::string& fname, M_BaseObject* first,
 
     /* extra positional arguments into vararg */
     if (sig.has_vararg()) {
-        std::vector<M_BaseObject*> starargs;
-        if (front > argcount) { /* collect all arguments into vararg */
-            starargs.push_back(first);
-            if (nargs > 0) {
-                starargs.insert(starargs.end(), args.begin(), args.end());
-            }
-        } else {
+        /* vararg gets args[skip:], preceded by first if it did not fill a
+         * named slot */
+        bool with_first = front > argcount;
+        int skip = 0;
+        if (!with_first) {
             int left = argcount - front;
             if (nargs > left) {
                 if (sig.get_varargname() == "*") {
@@ -80,13 +79,17 @@ void Arguments::parse(const std::string& fname, M_BaseObject* first,
                             ThreadContext::current_thread(),
                             argcount_err_msg(fname, nargs, nkwargs, sig)));
                 }
-                starargs.insert(starargs.end(), args.begin() + left,
-                                args.end());
+                skip = left;
             } else
-                starargs.clear();
+                skip = nargs;
         }
+
         M_BaseObject* wrapped_starargs =
-            space->new_tuple(ThreadContext::current_thread(), starargs);
+            space->new_tuple(ThreadContext::current_thread(),
+                             (std::size_t)(with_first + nargs - skip));
+        M_BaseObject** items = space->tuple_items(wrapped_starargs);
+        if (with_first) *items++ = first;
+        std::copy(args.begin() + skip, args.end(), items);
         scope[argcount] = wrapped_starargs;
     } else if (args_avail > argcount) { /* error */
         throw InterpError(
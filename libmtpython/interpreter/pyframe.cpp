@@ -4,6 +4,9 @@
 #include "interpreter/pyframe.h"
 #include "interpreter/function.h"
 #include "interpreter/generator.h"
+#include "objects/std/list_object.h"
+#include "objects/std/type_object.h"
+#include "objects/bltin_exceptions.h"
 #include "tools/opcode.h"
 #include "macros.h"
 #include "consts.h"
@@ -12,8 +15,6 @@ using namespace mtpython::interpreter;
 using namespace mtpython::objects;
 using namespace mtpython::vm;
 
-static BreakUnwinder break_unwinder;
-
 class ExitFrameException : public std::exception {};
 class ReturnException : public ExitFrameException {};
 class YieldException : public ExitFrameException {};
@@ -27,7 +28,10 @@ int LoopBlock::handle(PyFrame* frame, StackUnwinder* unwinder)
         return handler;
     }
 
-    return handler;
+    /* continue: the loop goes on, keep the block */
+    ContinueUnwinder* as_continue = static_cast<ContinueUnwinder*>(unwinder);
+    frame->push_block(this);
+    return as_continue->get_target();
 }
 
 int ExceptBlock::handle(PyFrame* frame, StackUnwinder* unwinder)
@@ -50,11 +54,9 @@ int ExceptBlock::handle(PyFrame* frame, StackUnwinder* unwinder)
 int FinallyBlock::handle(PyFrame* frame, StackUnwinder* unwinder)
 {
     cleanup(frame);
-    ExceptionUnwinder* as_exc = dynamic_cast<ExceptionUnwinder*>(unwinder);
-    if (as_exc) {
-        ObjSpace* space = frame->get_space();
-        frame->push_value(space->wrap(frame->get_context(), as_exc));
-    }
+    /* END_FINALLY resumes the unwinding after the finally clause */
+    ObjSpace* space = frame->get_space();
+    frame->push_value(space->wrap(frame->get_context(), unwinder));
 
     return handler;
 }
@@ -191,9 +193,6 @@ int PyFrame::handle_interp_error(InterpError& exc)
 {
     FrameBlock* block = unwind_stack(WhyCode::WHY_EXCEPTION);
 
-    /* for debug purpose */
-    std::string info = space->unwrap_str(exc.get_value());
-
     if (!block) { /* no handler */
         throw exc;
     }
@@ -368,6 +367,9 @@ int PyFrame::dispatch_bytecode(ThreadContext* context,
         case DUP_TOP:
             dup_top(arg, next_pc);
             break;
+        case DUP_TOP_TWO:
+            dup_top_two(arg, next_pc);
+            break;
         case ROT_THREE:
             rot_three(arg, next_pc);
             break;
@@ -401,6 +403,12 @@ int PyFrame::dispatch_bytecode(ThreadContext* context,
         case BREAK_LOOP:
             next_pc = break_loop(arg, next_pc);
             break;
+        case CONTINUE_LOOP:
+            next_pc = continue_loop(arg, next_pc);
+            break;
+        case RAISE_VARARGS:
+            raise_varargs(arg, next_pc);
+            break;
         case UNARY_POSITIVE:
             unary_positive(arg, next_pc);
             break;
@@ -452,6 +460,9 @@ int PyFrame::dispatch_bytecode(ThreadContext* context,
         case BUILD_LIST:
             build_list(arg, next_pc);
             break;
+        case LIST_APPEND:
+            list_append(arg, next_pc);
+            break;
         case IMPORT_FROM:
             import_from(arg, next_pc);
             break;
@@ -467,6 +478,9 @@ int PyFrame::dispatch_bytecode(ThreadContext* context,
         case BUILD_MAP:
             build_map(arg, next_pc);
             break;
+        case STORE_MAP:
+            store_map(arg, next_pc);
+            break;
         case LOAD_CLOSURE:
             load_closure(arg, next_pc);
             break;
@@ -491,6 +505,12 @@ int PyFrame::dispatch_bytecode(ThreadContext* context,
         case STORE_SUBSCR:
             store_subscr(arg, next_pc);
             break;
+        case DELETE_SUBSCR:
+            delete_subscr(arg, next_pc);
+            break;
+        case BUILD_SLICE:
+            build_slice(arg, next_pc);
+            break;
         }
     }
 }
@@ -614,15 +634,15 @@ void PyFrame::store_fast(int arg, int next_pc)
 void PyFrame::load_global(int arg, int next_pc)
 {
     M_BaseObject* name = get_name(arg);
-    std::string unwrapped_name = space->unwrap_str(name);
 
-    M_BaseObject* value = space->finditem_str(globals, unwrapped_name);
+    /* look up with the interned name object so its hash is cached */
+    M_BaseObject* value = space->finditem(globals, name);
     if (!value) {
-        value = space->get_builtin()->get_dict_value(space, unwrapped_name);
+        value = space->finditem(space->get_builtin()->get_dict(space), name);
         if (!value)
             throw InterpError::format(space, space->NameError_type(),
                                       "global name '%s' not found",
-                                      unwrapped_name.c_str());
+                                      space->unwrap_str(name).c_str());
     }
 
     push_value(value);
@@ -729,6 +749,15 @@ int PyFrame::pop_jump_if_false(int arg, int next_pc)
 
 void PyFrame::dup_top(int arg, int next_pc) { push_value(peek_value()); }
 
+void PyFrame::dup_top_two(int arg, int next_pc)
+{
+    M_BaseObject* v1 = pop_value();
+    M_BaseObject* v2 = peek_value();
+    push_value(v1);
+    push_value(v2);
+    push_value(v1);
+}
+
 void PyFrame::rot_three(int arg, int next_pc)
 {
     M_BaseObject* v1 = pop_value();
@@ -822,10 +851,12 @@ void PyFrame::rot_two(int arg, int next_pc)
 
 void PyFrame::build_tuple(int arg, int next_pc)
 {
-    std::vector<M_BaseObject*> args;
+    /* the items stay on the value stack until the tuple is allocated */
+    M_BaseObject* tup = space->new_tuple(context, (std::size_t)arg);
+    M_BaseObject** items = space->tuple_items(tup);
 
-    pop_values(arg, args);
-    M_BaseObject* tup = space->new_tuple(context, args);
+    for (int i = arg - 1; i >= 0; i--)
+        items[i] = pop_value();
     push_value(tup);
 }
 
@@ -845,15 +876,11 @@ void PyFrame::get_iter(int arg, int next_pc)
 int PyFrame::for_iter(int arg, int next_pc)
 {
     M_BaseObject* iterator = peek_value();
-    M_BaseObject* next_obj = nullptr;
-    try {
-        next_obj = space->next(iterator);
-        push_value(next_obj);
-    } catch (InterpError& e) {
-        if (!e.match(space, space->StopIteration_type())) {
-            throw e;
-        }
+    M_BaseObject* next_obj = space->next_item(iterator);
 
+    if (next_obj) {
+        push_value(next_obj);
+    } else {
         pop_value();
         next_pc += arg;
     }
@@ -870,7 +897,12 @@ void PyFrame::_pop_block(int arg, int next_pc)
 
 int PyFrame::break_loop(int arg, int next_pc)
 {
-    return unwind_stack_jump(&break_unwinder);
+    return unwind_stack_jump(new (context) BreakUnwinder());
+}
+
+int PyFrame::continue_loop(int arg, int next_pc)
+{
+    return unwind_stack_jump(new (context) ContinueUnwinder(arg));
 }
 
 #define DEF_UNARY_OPER(opname, name)                   \
@@ -982,31 +1014,30 @@ void PyFrame::import_name(int arg, int next_pc)
 void PyFrame::store_global(int arg, int next_pc)
 {
     M_BaseObject* w_name = get_name(arg);
-    std::string name = space->unwrap_str(w_name);
     M_BaseObject* value = pop_value();
-    space->setitem_str(globals, name, value);
+    space->setitem(globals, w_name, value);
 }
 
 void PyFrame::load_name(int arg, int next_pc)
 {
     M_BaseObject* w_name = get_name(arg);
-    std::string name = space->unwrap_str(w_name);
     M_BaseObject* value = nullptr;
 
     if (locals != globals) {
-        value = space->finditem_str(locals, name);
+        value = space->finditem(locals, w_name);
         if (value) {
             push_value(value);
             return;
         }
     }
 
-    value = space->finditem_str(globals, name);
+    value = space->finditem(globals, w_name);
     if (!value) {
-        value = space->get_builtin()->get_dict_value(space, name);
+        value = space->finditem(space->get_builtin()->get_dict(space), w_name);
         if (!value)
             throw InterpError::format(space, space->NameError_type(),
-                                      "name '%s' not found", name.c_str());
+                                      "name '%s' not found",
+                                      space->unwrap_str(w_name).c_str());
     }
 
     push_value(value);
@@ -1015,9 +1046,8 @@ void PyFrame::load_name(int arg, int next_pc)
 void PyFrame::store_name(int arg, int next_pc)
 {
     M_BaseObject* w_name = get_name(arg);
-    std::string name = space->unwrap_str(w_name);
     M_BaseObject* value = pop_value();
-    space->setitem_str(locals, name, value);
+    space->setitem(locals, w_name, value);
 }
 
 void PyFrame::build_list(int arg, int next_pc)
@@ -1093,6 +1123,12 @@ void PyFrame::import_star(int arg, int next_pc)
     set_locals(locals);
 }
 
+void PyFrame::list_append(int arg, int next_pc)
+{
+    M_BaseObject* value = pop_value();
+    M_StdListObject::append(context, peek_value(arg - 1), value);
+}
+
 void PyFrame::build_set(int arg, int next_pc)
 {
     std::vector<M_BaseObject*> args;
@@ -1124,6 +1160,15 @@ void PyFrame::build_map(int arg, int next_pc)
     push_value(dict);
 }
 
+void PyFrame::store_map(int arg, int next_pc)
+{
+    M_BaseObject* key = pop_value();
+    M_BaseObject* value = pop_value();
+    M_BaseObject* dict = peek_value();
+
+    space->setitem(dict, key, value);
+}
+
 void PyFrame::load_closure(int arg, int next_pc)
 {
     M_BaseObject* cell = cells[arg];
@@ -1216,6 +1261,40 @@ void PyFrame::with_cleanup(int arg, int next_pc)
 
 void PyFrame::yield_value(int arg, int next_pc) { throw YieldException(); }
 
+void PyFrame::raise_varargs(int arg, int next_pc)
+{
+    if (arg == 0) {
+        throw InterpError(
+            space->RuntimeError_type(),
+            space->wrap_str(context, "No active exception to reraise"));
+    }
+
+    if (arg == 2) pop_value(); /* the cause is not recorded */
+    M_BaseObject* exc = pop_value();
+
+    M_BaseObject* type;
+    M_BaseObject* value;
+    if (dynamic_cast<M_StdTypeObject*>(exc)) {
+        type = exc;
+        value = nullptr;
+    } else {
+        type = space->type(exc);
+        value = exc;
+    }
+
+    M_BaseObject* base =
+        BaseException::get_bltin_exception_type(space, "BaseException");
+    if (!space->i_issubtype(type, base)) {
+        throw InterpError(
+            space->TypeError_type(),
+            space->wrap_str(context,
+                            "exceptions must derive from BaseException"));
+    }
+
+    if (!value) value = space->call_function(context, type, {});
+    throw InterpError(type, value);
+}
+
 void PyFrame::unpack_sequence(int arg, int next_pc)
 {
     M_BaseObject* iterable = pop_value();
@@ -1237,3 +1316,22 @@ void PyFrame::store_subscr(int arg, int next_pc)
 
     space->setitem(obj, subscr, value);
 }
+
+void PyFrame::delete_subscr(int arg, int next_pc)
+{
+    ObjSpace* space = context->get_space();
+
+    M_BaseObject* subscr = pop_value();
+    M_BaseObject* obj = pop_value();
+
+    space->delitem(obj, subscr);
+}
+
+void PyFrame::build_slice(int arg, int next_pc)
+{
+    M_BaseObject* step = (arg == 3) ? pop_value() : space->wrap_None();
+    M_BaseObject* stop = pop_value();
+    M_BaseObject* start = pop_value();
+
+    push_value(space->new_slice(context, start, stop, step));
+}
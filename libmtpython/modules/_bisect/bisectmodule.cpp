@@ -0,0 +1,135 @@
+#include <typeinfo>
+#include <vector>
+
+#include "modules/_bisect/bisectmodule.h"
+#include "objects/std/list_object.h"
+#include "interpreter/arguments.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+namespace mtpython {
+namespace modules {
+
+/* Index where x goes in the sorted sequence a[lo:hi]. Exact lists are
+ * indexed directly and their items compared with ObjSpace::i_lt(), other
+ * sequences go through __getitem__ */
+static int bisect(ThreadContext* context, const char* fname,
+                  const Arguments& args, bool right, M_BaseObject*& seq,
+                  M_BaseObject*& item)
+{
+    static Signature bisect_signature({"a", "x", "lo", "hi"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse(fname, nullptr, bisect_signature, scope,
+               {space->wrap_int(context, 0), space->wrap_None()});
+    seq = scope[0];
+    item = scope[1];
+
+    int lo = space->unwrap_int(scope[2]);
+    if (lo < 0) {
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "lo must be non-negative"));
+    }
+    int hi = space->i_is(scope[3], space->wrap_None())
+                 ? space->unwrap_int(space->len(seq))
+                 : space->unwrap_int(scope[3]);
+
+    M_StdListObject* list = typeid(*seq) == typeid(M_StdListObject)
+                                ? static_cast<M_StdListObject*>(seq)
+                                : nullptr;
+
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        M_BaseObject* mid_item;
+
+        /* __lt__ may have shrunk the list since the last probe */
+        if (list && (std::size_t)mid < list->size()) {
+            mid_item = (*list)[mid];
+        } else {
+            mid_item = space->getitem(seq, space->wrap_int(context, mid));
+        }
+
+        if (right) {
+            if (space->i_lt(item, mid_item))
+                hi = mid;
+            else
+                lo = mid + 1;
+        } else {
+            if (space->i_lt(mid_item, item))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+static M_BaseObject* insort(ThreadContext* context, const char* fname,
+                            const Arguments& args, bool right)
+{
+    ObjSpace* space = context->get_space();
+    M_BaseObject *seq, *item;
+    int pos = bisect(context, fname, args, right, seq, item);
+    M_BaseObject* index = space->wrap_int(context, pos);
+
+    if (typeid(*seq) == typeid(M_StdListObject)) {
+        M_StdListObject::insert(context, seq, index, item);
+    } else {
+        space->call_function(context, space->getattr_str(seq, "insert"),
+                             {index, item});
+    }
+
+    return nullptr;
+}
+
+static M_BaseObject* bisect_bisect_right(ThreadContext* context,
+                                         const Arguments& args)
+{
+    M_BaseObject *seq, *item;
+    return context->get_space()->wrap_int(
+        context, bisect(context, "bisect_right", args, true, seq, item));
+}
+
+static M_BaseObject* bisect_bisect_left(ThreadContext* context,
+                                        const Arguments& args)
+{
+    M_BaseObject *seq, *item;
+    return context->get_space()->wrap_int(
+        context, bisect(context, "bisect_left", args, false, seq, item));
+}
+
+static M_BaseObject* bisect_insort_right(ThreadContext* context,
+                                         const Arguments& args)
+{
+    return insort(context, "insort_right", args, true);
+}
+
+static M_BaseObject* bisect_insort_left(ThreadContext* context,
+                                        const Arguments& args)
+{
+    return insort(context, "insort_left", args, false);
+}
+
+BisectModule::BisectModule(ObjSpace* space, M_BaseObject* name)
+    : BuiltinModule(space, name)
+{
+    add_def("bisect_right",
+            new InterpFunctionWrapper("bisect_right", bisect_bisect_right));
+    add_def("bisect", new InterpFunctionWrapper("bisect", bisect_bisect_right));
+    add_def("bisect_left",
+            new InterpFunctionWrapper("bisect_left", bisect_bisect_left));
+    add_def("insort_right",
+            new InterpFunctionWrapper("insort_right", bisect_insort_right));
+    add_def("insort", new InterpFunctionWrapper("insort", bisect_insort_right));
+    add_def("insort_left",
+            new InterpFunctionWrapper("insort_left", bisect_insort_left));
+}
+
+} // namespace modules
+} // namespace mtpython
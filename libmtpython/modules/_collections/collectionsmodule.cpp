@@ -1,38 +1,75 @@
+#include <typeinfo>
+
 #include "modules/_collections/collectionsmodule.h"
+#include "modules/_collections/deque.h"
+#include "modules/_collections/defaultdict.h"
 #include "interpreter/gateway.h"
 #include "interpreter/pycode.h"
 #include "interpreter/compiler.h"
 #include "interpreter/error.h"
 #include "interpreter/pyframe.h"
+#include "objects/std/dict_object.h"
+#include "objects/std/int_object.h"
 
 namespace mtpython {
 namespace modules {
 
-class M_Deque : public objects::M_BaseObject {
-public:
-    M_Deque() {}
+using namespace objects;
+using namespace interpreter;
 
-    static interpreter::Typedef* _deque_typedef()
-    {
-        static interpreter::Typedef deque_typedef("deque", {});
-        return &deque_typedef;
-    }
+/* Count the elements of iterable in mapping, the kernel of
+ * collections.Counter */
+static M_BaseObject* collections__count_elements(vm::ThreadContext* context,
+                                                 M_BaseObject* mapping,
+                                                 M_BaseObject* iterable)
+{
+    ObjSpace* space = context->get_space();
+    M_BaseObject* zero = space->wrap_int(context, 0);
+    M_BaseObject* one = space->wrap_int(context, 1);
+    M_BaseObject* iterator = space->iter(iterable);
+
+    /* exact dicts are updated in place with one lookup per element */
+    M_StdDictObject* dict = typeid(*mapping) == typeid(M_StdDictObject)
+                                ? static_cast<M_StdDictObject*>(mapping)
+                                : nullptr;
+    M_BaseObject* get = dict ? nullptr : space->getattr_str(mapping, "get");
 
-    interpreter::Typedef* get_typedef() { return _deque_typedef(); }
-};
+    while (true) {
+        M_BaseObject* item;
+        try {
+            item = space->next(iterator);
+        } catch (InterpError& e) {
+            if (!e.match(space, space->StopIteration_type())) throw e;
+            break;
+        }
 
-class M_DefaultDict : public objects::M_BaseObject {
-public:
-    M_DefaultDict() {}
+        if (!dict) {
+            M_BaseObject* count =
+                space->call_function(context, get, {item, zero});
+            space->setitem(mapping, item, space->add(count, one));
+            continue;
+        }
 
-    static interpreter::Typedef* _defaultdict_typedef()
-    {
-        static interpreter::Typedef defaultdict_typedef("defaultdict", {});
-        return &defaultdict_typedef;
+        dict->lock();
+        M_BaseObject*& slot = dict->lookup_or_insert(item, zero);
+        M_BaseObject* count = slot;
+        if (typeid(*count) == typeid(M_StdIntObject)) {
+            slot = space->wrap_int(context,
+                                   M_STDINTOBJECT(count)->get_value() + 1);
+            dict->unlock();
+            continue;
+        }
+        dict->unlock();
+
+        /* __add__ may run Python code that modifies the dict */
+        M_BaseObject* value = space->add(count, one);
+        dict->lock();
+        dict->setitem(item, value);
+        dict->unlock();
     }
 
-    interpreter::Typedef* get_typedef() { return _defaultdict_typedef(); }
-};
+    return nullptr;
+}
 
 CollectionsModule::CollectionsModule(mtpython::objects::ObjSpace* space,
                                      M_BaseObject* name)
@@ -41,6 +78,10 @@ CollectionsModule::CollectionsModule(mtpython::objects::ObjSpace* space,
     add_def("deque", space->get_typeobject(M_Deque::_deque_typedef()));
     add_def("defaultdict",
             space->get_typeobject(M_DefaultDict::_defaultdict_typedef()));
+
+    add_def("_count_elements",
+            new InterpFunctionWrapper("_count_elements",
+                                      collections__count_elements));
 }
 
 } // namespace modules
@@ -0,0 +1,136 @@
+#include <string>
+#include <vector>
+
+#include "modules/_collections/defaultdict.h"
+#include "interpreter/typedef.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+#include "interpreter/descriptor.h"
+#include "interpreter/function.h"
+
+using namespace mtpython::modules;
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+#define M_DEFAULTDICT(obj) (static_cast<M_DefaultDict*>(obj))
+
+static void check_factory(ThreadContext* context, M_BaseObject* factory)
+{
+    ObjSpace* space = context->get_space();
+
+    if (space->i_is(factory, space->wrap_None())) return;
+    if (dynamic_cast<Function*>(factory) || dynamic_cast<Method*>(factory))
+        return;
+    if (space->lookup(factory, "__call__")) return;
+
+    throw InterpError(space->TypeError_type(),
+                      space->wrap_str(context, "first argument must be "
+                                               "callable or None"));
+}
+
+M_BaseObject* M_DefaultDict::missing(ThreadContext* context, M_BaseObject* key)
+{
+    ObjSpace* space = context->get_space();
+
+    if (space->i_is(default_factory, space->wrap_None())) return nullptr;
+
+    M_BaseObject* value = space->call_function(context, default_factory, {});
+    lock();
+    setitem(key, value);
+    unlock();
+
+    return value;
+}
+
+M_BaseObject* M_DefaultDict::__new__(ThreadContext* context,
+                                     const Arguments& args)
+{
+    static Signature new_signature({"type", "default_factory", "iterable"}, "",
+                                   "kwargs", {});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("__new__", nullptr, new_signature, scope,
+               {space->wrap_None(), nullptr});
+    check_factory(context, scope[1]);
+
+    M_DefaultDict* dict = new (context) M_DefaultDict(space, scope[1]);
+    if (scope[2]) update_dict(context, dict, scope[2]);
+    if (scope[3]) update_dict(context, dict, scope[3]);
+
+    return dict;
+}
+
+M_BaseObject* M_DefaultDict::__repr__(ThreadContext* context,
+                                      M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_DefaultDict* as_dict = M_DEFAULTDICT(self);
+
+    std::string str = "defaultdict(";
+    str += space->unwrap_str(space->repr(as_dict->default_factory));
+    str += ", ";
+    str += space->unwrap_str(M_StdDictObject::__repr__(context, self));
+    str += ")";
+
+    return space->wrap_str(context, str);
+}
+
+M_BaseObject* M_DefaultDict::__missing__(ThreadContext* context,
+                                         M_BaseObject* self, M_BaseObject* key)
+{
+    ObjSpace* space = context->get_space();
+    M_BaseObject* value = M_DEFAULTDICT(self)->missing(context, key);
+
+    if (!value) throw InterpError(space->KeyError_type(), key);
+    return value;
+}
+
+M_BaseObject* M_DefaultDict::copy(ThreadContext* context, M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_DefaultDict* as_dict = M_DEFAULTDICT(self);
+    M_DefaultDict* result =
+        new (context) M_DefaultDict(space, as_dict->default_factory);
+
+    update_dict(context, result, self);
+    return result;
+}
+
+M_BaseObject* M_DefaultDict::default_factory_get(ThreadContext* context,
+                                                 M_BaseObject* self)
+{
+    return M_DEFAULTDICT(self)->default_factory;
+}
+
+void M_DefaultDict::default_factory_set(ThreadContext* context,
+                                        M_BaseObject* self, M_BaseObject* value)
+{
+    check_factory(context, value);
+    M_DEFAULTDICT(self)->default_factory = value;
+}
+
+Typedef* M_DefaultDict::_defaultdict_typedef()
+{
+    static Typedef defaultdict_typedef(
+        "defaultdict", {M_StdDictObject::_dict_typedef()},
+        {
+            {"__new__",
+             new InterpFunctionWrapper("__new__", M_DefaultDict::__new__)},
+            {"__repr__",
+             new InterpFunctionWrapper("__repr__", M_DefaultDict::__repr__)},
+            {"__missing__", new InterpFunctionWrapper(
+                                "__missing__", M_DefaultDict::__missing__)},
+            {"__copy__",
+             new InterpFunctionWrapper("__copy__", M_DefaultDict::copy)},
+            {"copy", new InterpFunctionWrapper("copy", M_DefaultDict::copy)},
+            {"default_factory",
+             new GetSetDescriptor(M_DefaultDict::default_factory_get,
+                                  M_DefaultDict::default_factory_set)},
+        });
+
+    return &defaultdict_typedef;
+}
+
+Typedef* M_DefaultDict::get_typedef() { return _defaultdict_typedef(); }
@@ -0,0 +1,662 @@
+#include <string>
+#include <vector>
+
+#include "modules/_collections/deque.h"
+#include "interpreter/typedef.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+#include "interpreter/descriptor.h"
+
+using namespace mtpython::modules;
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+#define M_DEQUE(obj) (static_cast<M_Deque*>(obj))
+
+M_Deque::M_Deque(ThreadContext* context)
+    : leftindex(DEQUE_CENTER + 1), rightindex(DEQUE_CENTER), length(0),
+      maxlen(-1), state(0)
+{
+    leftblock = rightblock = new (context) DequeBlock();
+}
+
+void M_Deque::push_right(ThreadContext* context, M_BaseObject* item)
+{
+    if (rightindex == DEQUE_BLOCKLEN - 1) {
+        DequeBlock* block = new (context) DequeBlock();
+        block->leftlink = rightblock;
+        rightblock->rightlink = block;
+        rightblock = block;
+        rightindex = -1;
+    }
+
+    rightblock->items[++rightindex] = item;
+    length++;
+    state++;
+}
+
+void M_Deque::push_left(ThreadContext* context, M_BaseObject* item)
+{
+    if (leftindex == 0) {
+        DequeBlock* block = new (context) DequeBlock();
+        block->rightlink = leftblock;
+        leftblock->leftlink = block;
+        leftblock = block;
+        leftindex = DEQUE_BLOCKLEN;
+    }
+
+    leftblock->items[--leftindex] = item;
+    length++;
+    state++;
+}
+
+M_BaseObject* M_Deque::pop_right()
+{
+    M_BaseObject* item = rightblock->items[rightindex];
+    rightblock->items[rightindex--] = nullptr;
+    length--;
+    state++;
+
+    if (length == 0) {
+        /* leftblock == rightblock, recenter */
+        leftindex = DEQUE_CENTER + 1;
+        rightindex = DEQUE_CENTER;
+    } else if (rightindex < 0) {
+        DequeBlock* prev = rightblock->leftlink;
+        prev->rightlink = nullptr;
+        rightblock = prev;
+        rightindex = DEQUE_BLOCKLEN - 1;
+    }
+
+    return item;
+}
+
+M_BaseObject* M_Deque::pop_left()
+{
+    M_BaseObject* item = leftblock->items[leftindex];
+    leftblock->items[leftindex++] = nullptr;
+    length--;
+    state++;
+
+    if (length == 0) {
+        leftindex = DEQUE_CENTER + 1;
+        rightindex = DEQUE_CENTER;
+    } else if (leftindex == DEQUE_BLOCKLEN) {
+        DequeBlock* next = leftblock->rightlink;
+        next->leftlink = nullptr;
+        leftblock = next;
+        leftindex = 0;
+    }
+
+    return item;
+}
+
+void M_Deque::append_bounded(ThreadContext* context, M_BaseObject* item,
+                             bool left)
+{
+    if (maxlen == 0) return;
+
+    if (left) {
+        push_left(context, item);
+        if (maxlen > 0 && length > (std::size_t)maxlen) pop_right();
+    } else {
+        push_right(context, item);
+        if (maxlen > 0 && length > (std::size_t)maxlen) pop_left();
+    }
+}
+
+M_BaseObject*& M_Deque::item_at(std::size_t i)
+{
+    /* walk from whichever end is closer */
+    if (i < length / 2) {
+        std::size_t pos = leftindex + i;
+        DequeBlock* block = leftblock;
+        for (std::size_t n = pos / DEQUE_BLOCKLEN; n > 0; n--)
+            block = block->rightlink;
+        return block->items[pos % DEQUE_BLOCKLEN];
+    }
+
+    std::size_t pos = (DEQUE_BLOCKLEN - 1 - rightindex) + (length - 1 - i);
+    DequeBlock* block = rightblock;
+    for (std::size_t n = pos / DEQUE_BLOCKLEN; n > 0; n--)
+        block = block->leftlink;
+    return block->items[DEQUE_BLOCKLEN - 1 - pos % DEQUE_BLOCKLEN];
+}
+
+void M_Deque::clear_items(ThreadContext* context)
+{
+    /* drop all blocks, the collector reclaims them */
+    leftblock = rightblock = new (context) DequeBlock();
+    leftindex = DEQUE_CENTER + 1;
+    rightindex = DEQUE_CENTER;
+    length = 0;
+    state++;
+}
+
+void M_Deque::rotate_items(ThreadContext* context, long n)
+{
+    if (length <= 1) return;
+
+    long len = (long)length;
+    n %= len;
+    if (n < 0) n += len;
+    /* rotate the shorter way round */
+    if (n > len / 2) n -= len;
+
+    /* moving an item never changes the length, so the end it is taken from
+     * always has it and push never triggers maxlen */
+    for (; n > 0; n--)
+        push_left(context, pop_right());
+    for (; n < 0; n++)
+        push_right(context, pop_left());
+}
+
+long M_Deque::find_item(ThreadContext* context, M_BaseObject* item)
+{
+    ObjSpace* space = context->get_space();
+    std::size_t start_state = state;
+    DequeBlock* block = leftblock;
+    int pos = leftindex;
+
+    for (std::size_t i = 0; i < length; i++) {
+        bool equal = space->i_eq(block->items[pos], item);
+
+        if (state != start_state)
+            throw InterpError(space->RuntimeError_type(),
+                              space->wrap_str(context, "deque mutated during "
+                                                       "iteration"));
+        if (equal) return (long)i;
+
+        if (++pos == DEQUE_BLOCKLEN) {
+            block = block->rightlink;
+            pos = 0;
+        }
+    }
+
+    return -1;
+}
+
+void M_Deque::delete_item(ThreadContext* context, std::size_t i)
+{
+    /* bring the item to the left end, pop it and rotate back */
+    rotate_items(context, -(long)i);
+    pop_left();
+    rotate_items(context, (long)i);
+}
+
+static std::size_t deque_index(ThreadContext* context, M_Deque* deque,
+                               M_BaseObject* index)
+{
+    ObjSpace* space = context->get_space();
+
+    int i = space->i_get_index(index, space->IndexError_type(),
+                               space->wrap_str(context, "deque index"));
+    if (i < 0) i += (int)deque->size();
+    if (i < 0 || i >= (int)deque->size())
+        throw InterpError(space->IndexError_type(),
+                          space->wrap_str(context, "deque index out of range"));
+
+    return (std::size_t)i;
+}
+
+M_BaseObject* M_Deque::__new__(ThreadContext* context, const Arguments& args)
+{
+    return new (context) M_Deque(context);
+}
+
+M_BaseObject* M_Deque::__init__(ThreadContext* context, const Arguments& args)
+{
+    static Signature init_signature({"self", "iterable", "maxlen"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("deque", nullptr, init_signature, scope,
+               {space->wrap_None(), space->wrap_None()});
+    M_Deque* as_deque = M_DEQUE(scope[0]);
+
+    long maxlen = -1;
+    if (!space->i_is(scope[2], space->wrap_None())) {
+        maxlen = space->unwrap_int(scope[2]);
+        if (maxlen < 0)
+            throw InterpError(space->ValueError_type(),
+                              space->wrap_str(context, "maxlen must be "
+                                                       "non-negative"));
+    }
+
+    {
+        ScopedObjectLock lock(as_deque);
+        as_deque->maxlen = maxlen;
+        if (as_deque->length) as_deque->clear_items(context);
+    }
+
+    if (!space->i_is(scope[1], space->wrap_None()))
+        extend(context, as_deque, scope[1]);
+
+    return nullptr;
+}
+
+M_BaseObject* M_Deque::__repr__(ThreadContext* context, M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_Deque* as_deque = M_DEQUE(self);
+
+    std::vector<M_BaseObject*> items;
+    space->unpack_iterable(self, items);
+
+    std::string str = "deque([";
+    for (std::size_t i = 0; i < items.size(); i++) {
+        if (i > 0) str += ", ";
+        str += space->unwrap_str(space->repr(items[i]));
+    }
+    str += "]";
+    if (as_deque->maxlen >= 0)
+        str += ", maxlen=" + std::to_string(as_deque->maxlen);
+    str += ")";
+
+    return space->wrap_str(context, str);
+}
+
+M_BaseObject* M_Deque::__len__(ThreadContext* context, M_BaseObject* self)
+{
+    return context->get_space()->wrap_int(context, (int)M_DEQUE(self)->length);
+}
+
+M_BaseObject* M_Deque::__iter__(ThreadContext* context, M_BaseObject* self)
+{
+    return new (context) M_DequeIter(M_DEQUE(self), false);
+}
+
+M_BaseObject* M_Deque::__reversed__(ThreadContext* context,
+                                    M_BaseObject* self)
+{
+    return new (context) M_DequeIter(M_DEQUE(self), true);
+}
+
+M_BaseObject* M_Deque::__contains__(ThreadContext* context,
+                                    M_BaseObject* self, M_BaseObject* item)
+{
+    long i = M_DEQUE(self)->find_item(context, item);
+    return context->get_space()->new_bool(i >= 0);
+}
+
+M_BaseObject* M_Deque::__getitem__(ThreadContext* context, M_BaseObject* self,
+                                   M_BaseObject* index)
+{
+    M_Deque* as_deque = M_DEQUE(self);
+    ScopedObjectLock lock(self);
+
+    return as_deque->item_at(deque_index(context, as_deque, index));
+}
+
+M_BaseObject* M_Deque::__setitem__(ThreadContext* context, M_BaseObject* self,
+                                   M_BaseObject* index, M_BaseObject* value)
+{
+    M_Deque* as_deque = M_DEQUE(self);
+    ScopedObjectLock lock(self);
+
+    as_deque->item_at(deque_index(context, as_deque, index)) = value;
+    return nullptr;
+}
+
+M_BaseObject* M_Deque::__delitem__(ThreadContext* context, M_BaseObject* self,
+                                   M_BaseObject* index)
+{
+    M_Deque* as_deque = M_DEQUE(self);
+    ScopedObjectLock lock(self);
+
+    as_deque->delete_item(context, deque_index(context, as_deque, index));
+    return nullptr;
+}
+
+M_BaseObject* M_Deque::__eq__(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_Deque* as_deque = M_DEQUE(self);
+    M_Deque* other_deque = dynamic_cast<M_Deque*>(other);
+
+    if (!other_deque) return space->wrap_NotImplemented();
+    if (as_deque->length != other_deque->length) return space->wrap_False();
+
+    std::vector<M_BaseObject*> lhs, rhs;
+    space->unpack_iterable(self, lhs);
+    space->unpack_iterable(other, rhs);
+    for (std::size_t i = 0; i < lhs.size(); i++) {
+        if (!space->i_eq(lhs[i], rhs[i])) return space->wrap_False();
+    }
+
+    return space->wrap_True();
+}
+
+M_BaseObject* M_Deque::__ne__(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_BaseObject* eq = __eq__(context, self, other);
+    if (eq == space->wrap_NotImplemented()) return eq;
+
+    return space->new_bool(eq != space->wrap_True());
+}
+
+M_BaseObject* M_Deque::__iadd__(ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other)
+{
+    extend(context, self, other);
+    return self;
+}
+
+M_BaseObject* M_Deque::append(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* item)
+{
+    ScopedObjectLock lock(self);
+    M_DEQUE(self)->append_bounded(context, item, false);
+    return nullptr;
+}
+
+M_BaseObject* M_Deque::appendleft(ThreadContext* context, M_BaseObject* self,
+                                  M_BaseObject* item)
+{
+    ScopedObjectLock lock(self);
+    M_DEQUE(self)->append_bounded(context, item, true);
+    return nullptr;
+}
+
+M_BaseObject* M_Deque::pop(ThreadContext* context, M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_Deque* as_deque = M_DEQUE(self);
+    ScopedObjectLock lock(self);
+
+    if (!as_deque->length)
+        throw InterpError(space->IndexError_type(),
+                          space->wrap_str(context, "pop from an empty deque"));
+
+    return as_deque->pop_right();
+}
+
+M_BaseObject* M_Deque::popleft(ThreadContext* context, M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_Deque* as_deque = M_DEQUE(self);
+    ScopedObjectLock lock(self);
+
+    if (!as_deque->length)
+        throw InterpError(space->IndexError_type(),
+                          space->wrap_str(context, "pop from an empty deque"));
+
+    return as_deque->pop_left();
+}
+
+M_BaseObject* M_Deque::extend(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* iterable)
+{
+    ObjSpace* space = context->get_space();
+    M_Deque* as_deque = M_DEQUE(self);
+
+    /* collect first, the iterable may be the deque itself */
+    std::vector<M_BaseObject*> items;
+    space->unpack_iterable(iterable, items);
+
+    ScopedObjectLock lock(self);
+    for (auto* item : items)
+        as_deque->append_bounded(context, item, false);
+
+    return nullptr;
+}
+
+M_BaseObject* M_Deque::extendleft(ThreadContext* context, M_BaseObject* self,
+                                  M_BaseObject* iterable)
+{
+    ObjSpace* space = context->get_space();
+    M_Deque* as_deque = M_DEQUE(self);
+
+    std::vector<M_BaseObject*> items;
+    space->unpack_iterable(iterable, items);
+
+    ScopedObjectLock lock(self);
+    for (auto* item : items)
+        as_deque->append_bounded(context, item, true);
+
+    return nullptr;
+}
+
+M_BaseObject* M_Deque::clear(ThreadContext* context, M_BaseObject* self)
+{
+    ScopedObjectLock lock(self);
+    M_DEQUE(self)->clear_items(context);
+    return nullptr;
+}
+
+M_BaseObject* M_Deque::copy(ThreadContext* context, M_BaseObject* self)
+{
+    M_Deque* as_deque = M_DEQUE(self);
+    M_Deque* result = new (context) M_Deque(context);
+
+    result->maxlen = as_deque->maxlen;
+    extend(context, result, self);
+
+    return result;
+}
+
+M_BaseObject* M_Deque::count(ThreadContext* context, M_BaseObject* self,
+                             M_BaseObject* item)
+{
+    ObjSpace* space = context->get_space();
+    M_Deque* as_deque = M_DEQUE(self);
+    std::size_t start_state = as_deque->state;
+    DequeBlock* block = as_deque->leftblock;
+    int pos = as_deque->leftindex;
+    int n = 0;
+
+    for (std::size_t i = 0; i < as_deque->length; i++) {
+        if (space->i_eq(block->items[pos], item)) n++;
+
+        if (as_deque->state != start_state)
+            throw InterpError(space->RuntimeError_type(),
+                              space->wrap_str(context, "deque mutated during "
+                                                       "iteration"));
+
+        if (++pos == DEQUE_BLOCKLEN) {
+            block = block->rightlink;
+            pos = 0;
+        }
+    }
+
+    return space->wrap_int(context, n);
+}
+
+M_BaseObject* M_Deque::index(ThreadContext* context, M_BaseObject* self,
+                             M_BaseObject* item)
+{
+    ObjSpace* space = context->get_space();
+    long i = M_DEQUE(self)->find_item(context, item);
+
+    if (i < 0)
+        throw InterpError::format(space, space->ValueError_type(),
+                                  "%s is not in deque",
+                                  space->unwrap_str(space->repr(item)).c_str());
+
+    return space->wrap_int(context, (int)i);
+}
+
+M_BaseObject* M_Deque::remove(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* item)
+{
+    ObjSpace* space = context->get_space();
+    M_Deque* as_deque = M_DEQUE(self);
+    long i = as_deque->find_item(context, item);
+
+    if (i < 0)
+        throw InterpError::format(space, space->ValueError_type(),
+                                  "%s is not in deque",
+                                  space->unwrap_str(space->repr(item)).c_str());
+
+    ScopedObjectLock lock(self);
+    as_deque->delete_item(context, (std::size_t)i);
+    return nullptr;
+}
+
+M_BaseObject* M_Deque::reverse(ThreadContext* context, M_BaseObject* self)
+{
+    M_Deque* as_deque = M_DEQUE(self);
+    ScopedObjectLock lock(self);
+
+    DequeBlock* lblock = as_deque->leftblock;
+    DequeBlock* rblock = as_deque->rightblock;
+    int lpos = as_deque->leftindex;
+    int rpos = as_deque->rightindex;
+
+    for (std::size_t n = as_deque->length / 2; n > 0; n--) {
+        std::swap(lblock->items[lpos], rblock->items[rpos]);
+
+        if (++lpos == DEQUE_BLOCKLEN) {
+            lblock = lblock->rightlink;
+            lpos = 0;
+        }
+        if (--rpos < 0) {
+            rblock = rblock->leftlink;
+            rpos = DEQUE_BLOCKLEN - 1;
+        }
+    }
+    as_deque->state++;
+
+    return nullptr;
+}
+
+M_BaseObject* M_Deque::rotate(ThreadContext* context, const Arguments& args)
+{
+    static Signature rotate_signature({"self", "n"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("rotate", nullptr, rotate_signature, scope,
+               {space->wrap_int(context, 1)});
+    int n = space->unwrap_int(scope[1]);
+
+    ScopedObjectLock lock(scope[0]);
+    M_DEQUE(scope[0])->rotate_items(context, n);
+
+    return nullptr;
+}
+
+M_BaseObject* M_Deque::maxlen_get(ThreadContext* context, M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_Deque* as_deque = M_DEQUE(self);
+
+    if (as_deque->maxlen < 0) return space->wrap_None();
+    return space->wrap_int(context, (int)as_deque->maxlen);
+}
+
+Typedef* M_Deque::_deque_typedef()
+{
+    static Typedef deque_typedef(
+        "deque",
+        {
+            {"__new__", new InterpFunctionWrapper("__new__", M_Deque::__new__)},
+            {"__init__",
+             new InterpFunctionWrapper("__init__", M_Deque::__init__)},
+            {"__repr__",
+             new InterpFunctionWrapper("__repr__", M_Deque::__repr__)},
+            {"__len__", new InterpFunctionWrapper("__len__", M_Deque::__len__)},
+            {"__iter__",
+             new InterpFunctionWrapper("__iter__", M_Deque::__iter__)},
+            {"__reversed__",
+             new InterpFunctionWrapper("__reversed__", M_Deque::__reversed__)},
+            {"__contains__",
+             new InterpFunctionWrapper("__contains__", M_Deque::__contains__)},
+            {"__getitem__",
+             new InterpFunctionWrapper("__getitem__", M_Deque::__getitem__)},
+            {"__setitem__",
+             new InterpFunctionWrapper("__setitem__", M_Deque::__setitem__)},
+            {"__delitem__",
+             new InterpFunctionWrapper("__delitem__", M_Deque::__delitem__)},
+            {"__eq__", new InterpFunctionWrapper("__eq__", M_Deque::__eq__)},
+            {"__ne__", new InterpFunctionWrapper("__ne__", M_Deque::__ne__)},
+            {"__iadd__",
+             new InterpFunctionWrapper("__iadd__", M_Deque::__iadd__)},
+            {"__copy__", new InterpFunctionWrapper("__copy__", M_Deque::copy)},
+            {"append", new InterpFunctionWrapper("append", M_Deque::append)},
+            {"appendleft",
+             new InterpFunctionWrapper("appendleft", M_Deque::appendleft)},
+            {"pop", new InterpFunctionWrapper("pop", M_Deque::pop)},
+            {"popleft",
+             new InterpFunctionWrapper("popleft", M_Deque::popleft)},
+            {"extend", new InterpFunctionWrapper("extend", M_Deque::extend)},
+            {"extendleft",
+             new InterpFunctionWrapper("extendleft", M_Deque::extendleft)},
+            {"clear", new InterpFunctionWrapper("clear", M_Deque::clear)},
+            {"copy", new InterpFunctionWrapper("copy", M_Deque::copy)},
+            {"count", new InterpFunctionWrapper("count", M_Deque::count)},
+            {"index", new InterpFunctionWrapper("index", M_Deque::index)},
+            {"remove", new InterpFunctionWrapper("remove", M_Deque::remove)},
+            {"reverse",
+             new InterpFunctionWrapper("reverse", M_Deque::reverse)},
+            {"rotate", new InterpFunctionWrapper("rotate", M_Deque::rotate)},
+            {"maxlen", new GetSetDescriptor(M_Deque::maxlen_get)},
+        });
+
+    return &deque_typedef;
+}
+
+Typedef* M_Deque::get_typedef() { return _deque_typedef(); }
+
+M_DequeIter::M_DequeIter(M_Deque* deque, bool reversed)
+    : deque(deque), remaining(deque->length), state(deque->state),
+      reversed(reversed)
+{
+    block = reversed ? deque->rightblock : deque->leftblock;
+    index = reversed ? deque->rightindex : deque->leftindex;
+}
+
+M_BaseObject* M_DequeIter::__iter__(ThreadContext* context, M_BaseObject* self)
+{
+    return self;
+}
+
+M_BaseObject* M_DequeIter::__next__(ThreadContext* context, M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_DequeIter* iter = static_cast<M_DequeIter*>(self);
+
+    if (iter->deque->state != iter->state) {
+        iter->remaining = 0;
+        throw InterpError(space->RuntimeError_type(),
+                          space->wrap_str(context, "deque mutated during "
+                                                   "iteration"));
+    }
+    if (!iter->remaining)
+        throw InterpError(space->StopIteration_type(), space->wrap_None());
+
+    M_BaseObject* item = iter->block->items[iter->index];
+    iter->remaining--;
+
+    if (iter->reversed) {
+        if (--iter->index < 0 && iter->remaining) {
+            iter->block = iter->block->leftlink;
+            iter->index = DEQUE_BLOCKLEN - 1;
+        }
+    } else {
+        if (++iter->index == DEQUE_BLOCKLEN && iter->remaining) {
+            iter->block = iter->block->rightlink;
+            iter->index = 0;
+        }
+    }
+
+    return item;
+}
+
+Typedef* M_DequeIter::get_typedef()
+{
+    static Typedef deque_iterator_typedef(
+        "deque_iterator",
+        {
+            {"__iter__",
+             new InterpFunctionWrapper("__iter__", M_DequeIter::__iter__)},
+            {"__next__",
+             new InterpFunctionWrapper("__next__", M_DequeIter::__next__)},
+        });
+
+    return &deque_iterator_typedef;
+}
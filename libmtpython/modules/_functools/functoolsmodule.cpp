@@ -0,0 +1,53 @@
+#include <vector>
+
+#include "modules/_functools/functoolsmodule.h"
+#include "modules/_functools/partial.h"
+#include "modules/_functools/lru_cache.h"
+#include "interpreter/arguments.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+namespace mtpython {
+namespace modules {
+
+static M_BaseObject* functools_reduce(ThreadContext* context,
+                                      const Arguments& args)
+{
+    static Signature reduce_signature({"function", "sequence", "initial"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("reduce", nullptr, reduce_signature, scope, {nullptr});
+    M_BaseObject* func = scope[0];
+    M_BaseObject* result = scope[2];
+
+    M_BaseObject* iterator = space->iter(scope[1]);
+    if (!result) result = space->next_item(iterator);
+    if (!result) {
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "reduce() of empty sequence "
+                                                   "with no initial value"));
+    }
+
+    while (M_BaseObject* item = space->next_item(iterator))
+        result = space->call_function(context, func, {result, item});
+
+    return result;
+}
+
+FunctoolsModule::FunctoolsModule(ObjSpace* space, M_BaseObject* name)
+    : BuiltinModule(space, name)
+{
+    add_def("partial", space->get_typeobject(M_Partial::_partial_typedef()));
+    add_def("_lru_cache_wrapper",
+            space->get_typeobject(
+                M_LRUCacheWrapper::_lru_cache_wrapper_typedef()));
+    add_def("reduce", new InterpFunctionWrapper("reduce", functools_reduce));
+}
+
+} // namespace modules
+} // namespace mtpython
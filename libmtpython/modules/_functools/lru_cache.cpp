@@ -0,0 +1,351 @@
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "modules/_functools/lru_cache.h"
+#include "objects/std/dict_object.h"
+#include "interpreter/typedef.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+#include "interpreter/descriptor.h"
+#include "interpreter/function.h"
+
+using namespace mtpython::modules;
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+#define M_LRUCACHEWRAPPER(obj) (static_cast<M_LRUCacheWrapper*>(obj))
+
+#define LRU_MIN_BUCKETS 8
+
+M_LRUCacheWrapper::M_LRUCacheWrapper(ThreadContext* context,
+                                     M_BaseObject* func, long maxsize,
+                                     bool typed, M_BaseObject* cache_info_type)
+    : func(func), maxsize(maxsize), typed(typed),
+      cache_info_type(cache_info_type), dict(nullptr), count(0), hits(0),
+      misses(0), state(0)
+{
+    root = new (context) LRUCacheLink();
+    buckets = M_GCArray<LRUCacheLink*>::create(context, LRU_MIN_BUCKETS);
+}
+
+M_BaseObject* M_LRUCacheWrapper::get_dict(ObjSpace* space)
+{
+    if (!dict) dict = space->new_dict(ThreadContext::current_thread());
+    return dict;
+}
+
+/* Combine the hashes of the argument values the way tuples do. Keyword names
+ * and, for typed caches, the argument types are mixed in as well. args[0] is
+ * the wrapper itself */
+std::size_t M_LRUCacheWrapper::hash_args(ObjSpace* space, const Arguments& args)
+{
+    std::size_t hash = 0x345678;
+    std::size_t mult = 1000003;
+    auto mix = [&hash, &mult](std::size_t value) {
+        hash = (hash ^ value) * mult;
+        mult += 82520;
+    };
+    auto mix_value = [this, space, &mix](M_BaseObject* value) {
+        mix(hash_key(space, value));
+        if (typed) mix(std::hash<M_BaseObject*>()(space->type(value)));
+    };
+
+    for (std::size_t i = 1; i < args.size(); i++)
+        mix_value(args[i]);
+
+    const std::vector<std::string>& names = args.get_keywords();
+    const std::vector<M_BaseObject*>& values = args.get_keyword_values();
+    for (std::size_t i = 0; i < names.size(); i++) {
+        mix(std::hash<std::string>()(names[i]));
+        mix_value(values[i]);
+    }
+
+    return hash + 97531;
+}
+
+bool M_LRUCacheWrapper::key_matches(ObjSpace* space, LRUCacheLink* link,
+                                    const Arguments& args)
+{
+    const std::vector<std::string>& names = args.get_keywords();
+    const std::vector<M_BaseObject*>& values = args.get_keyword_values();
+    std::size_t nargs = args.size() - 1;
+
+    if (link->nargs != nargs || link->nkwargs != names.size()) return false;
+
+    M_GCArray<M_BaseObject*>& key = *link->key;
+    std::size_t types = nargs + 2 * names.size();
+
+    for (std::size_t i = 0; i < nargs; i++) {
+        if (typed && key[types + i] != space->type(args[i + 1])) return false;
+        if (!keys_equal(space, key[i], args[i + 1])) return false;
+    }
+
+    for (std::size_t i = 0; i < names.size(); i++) {
+        if (typed && key[types + nargs + i] != space->type(values[i]))
+            return false;
+        if (space->unwrap_str(key[nargs + 2 * i]) != names[i]) return false;
+        if (!keys_equal(space, key[nargs + 2 * i + 1], values[i]))
+            return false;
+    }
+
+    return true;
+}
+
+LRUCacheLink* M_LRUCacheWrapper::find(ObjSpace* space, std::size_t hash,
+                                      const Arguments& args)
+{
+    bool restart = true;
+
+    while (restart) {
+        restart = false;
+        std::size_t saved_state = state;
+
+        LRUCacheLink* link = (*buckets)[hash & (buckets->size() - 1)];
+        for (; link; link = link->chain) {
+            if (link->hash != hash) continue;
+
+            /* __eq__ may have added or removed links */
+            bool match = key_matches(space, link, args);
+            if (state != saved_state) {
+                restart = true;
+                break;
+            }
+            if (match) return link;
+        }
+    }
+
+    return nullptr;
+}
+
+void M_LRUCacheWrapper::insert(ThreadContext* context, std::size_t hash,
+                               const Arguments& args, M_BaseObject* result)
+{
+    ObjSpace* space = context->get_space();
+    const std::vector<std::string>& names = args.get_keywords();
+    const std::vector<M_BaseObject*>& values = args.get_keyword_values();
+    std::size_t nargs = args.size() - 1;
+
+    /* the least recently used link makes room for the new one */
+    if (maxsize > 0 && count >= (std::size_t)maxsize) unlink(root->next);
+
+    std::size_t key_size = nargs + 2 * names.size();
+    if (typed) key_size += nargs + names.size();
+
+    LRUCacheLink* link = new (context) LRUCacheLink();
+    link->hash = hash;
+    link->nargs = nargs;
+    link->nkwargs = names.size();
+    link->result = result;
+    link->key = M_GCArray<M_BaseObject*>::create(context, key_size);
+
+    M_GCArray<M_BaseObject*>& key = *link->key;
+    std::size_t types = nargs + 2 * names.size();
+    for (std::size_t i = 0; i < nargs; i++) {
+        key[i] = args[i + 1];
+        if (typed) key[types + i] = space->type(args[i + 1]);
+    }
+    for (std::size_t i = 0; i < names.size(); i++) {
+        key[nargs + 2 * i] = space->new_interned_str(names[i]);
+        key[nargs + 2 * i + 1] = values[i];
+        if (typed) key[types + nargs + i] = space->type(values[i]);
+    }
+
+    LRUCacheLink*& bucket = (*buckets)[hash & (buckets->size() - 1)];
+    link->chain = bucket;
+    bucket = link;
+
+    link->prev = root->prev;
+    link->next = root;
+    root->prev->next = link;
+    root->prev = link;
+
+    count++;
+    state++;
+    if (count > buckets->size()) resize(context, buckets->size() * 2);
+}
+
+void M_LRUCacheWrapper::unlink(LRUCacheLink* link)
+{
+    LRUCacheLink** pp = &(*buckets)[link->hash & (buckets->size() - 1)];
+    while (*pp != link)
+        pp = &(*pp)->chain;
+    *pp = link->chain;
+    link->chain = nullptr;
+
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+
+    count--;
+    state++;
+}
+
+void M_LRUCacheWrapper::resize(ThreadContext* context, std::size_t nbuckets)
+{
+    buckets = M_GCArray<LRUCacheLink*>::create(context, nbuckets);
+
+    for (LRUCacheLink* link = root->next; link != root; link = link->next) {
+        LRUCacheLink*& bucket = (*buckets)[link->hash & (nbuckets - 1)];
+        link->chain = bucket;
+        bucket = link;
+    }
+}
+
+void M_LRUCacheWrapper::clear()
+{
+    std::fill(buckets->begin(), buckets->end(), nullptr);
+    root->prev = root->next = root;
+    count = 0;
+    state++;
+}
+
+M_BaseObject* M_LRUCacheWrapper::__new__(ThreadContext* context,
+                                         const Arguments& args)
+{
+    static Signature new_signature(
+        {"type", "user_function", "maxsize", "typed", "cache_info_type"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("_lru_cache_wrapper", nullptr, new_signature, scope,
+               {space->wrap_int(context, 128), space->wrap_False(),
+                space->wrap_None()});
+
+    M_BaseObject* func = scope[1];
+    if (!dynamic_cast<Function*>(func) && !dynamic_cast<Method*>(func) &&
+        !space->lookup(func, "__call__")) {
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "the first argument must "
+                                                   "be callable"));
+    }
+
+    long maxsize = -1;
+    if (!space->i_is(scope[2], space->wrap_None())) {
+        maxsize = space->unwrap_int(scope[2]);
+        if (maxsize < 0) maxsize = 0;
+    }
+
+    return new (context) M_LRUCacheWrapper(
+        context, func, maxsize, space->is_true(scope[3]), scope[4]);
+}
+
+M_BaseObject* M_LRUCacheWrapper::__call__(ThreadContext* context,
+                                          const Arguments& args)
+{
+    ObjSpace* space = context->get_space();
+    M_LRUCacheWrapper* self = M_LRUCACHEWRAPPER(args[0]);
+    auto call = [&]() {
+        std::vector<M_BaseObject*> positional;
+        for (std::size_t i = 1; i < args.size(); i++)
+            positional.push_back(args[i]);
+        Arguments call_args(space, positional, args.get_keywords(),
+                            args.get_keyword_values());
+        return space->call_args(context, self->func, call_args);
+    };
+
+    if (self->maxsize == 0) {
+        M_BaseObject* result = call();
+        self->misses++;
+        return result;
+    }
+
+    std::size_t hash = self->hash_args(space, args);
+    LRUCacheLink* link = self->find(space, hash, args);
+    if (link) {
+        /* move the link to the most recently used end */
+        link->prev->next = link->next;
+        link->next->prev = link->prev;
+        LRUCacheLink* root = self->root;
+        link->prev = root->prev;
+        link->next = root;
+        root->prev->next = link;
+        root->prev = link;
+
+        self->hits++;
+        return link->result;
+    }
+
+    M_BaseObject* result = call();
+    self->misses++;
+
+    /* a recursive call may have stored the same key already */
+    if (!self->find(space, hash, args))
+        self->insert(context, hash, args, result);
+
+    return result;
+}
+
+M_BaseObject* M_LRUCacheWrapper::__get__(ThreadContext* context,
+                                         M_BaseObject* self, M_BaseObject* obj,
+                                         M_BaseObject* type)
+{
+    ObjSpace* space = context->get_space();
+    if (!obj || space->i_is(obj, space->wrap_None())) return self;
+
+    return space->wrap(context, new (context) Method(space, self, obj));
+}
+
+M_BaseObject* M_LRUCacheWrapper::cache_info(ThreadContext* context,
+                                            M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_LRUCacheWrapper* wrapper = M_LRUCACHEWRAPPER(self);
+
+    M_BaseObject* hits = space->wrap_int(context, (int)wrapper->hits);
+    M_BaseObject* misses = space->wrap_int(context, (int)wrapper->misses);
+    M_BaseObject* maxsize = space->wrap_None();
+    if (wrapper->maxsize >= 0)
+        maxsize = space->wrap_int(context, (int)wrapper->maxsize);
+    M_BaseObject* currsize = space->wrap_int(context, (int)wrapper->count);
+
+    if (space->i_is(wrapper->cache_info_type, space->wrap_None()))
+        return space->new_tuple(context, {hits, misses, maxsize, currsize});
+
+    return space->call_function(context, wrapper->cache_info_type,
+                                {hits, misses, maxsize, currsize});
+}
+
+M_BaseObject* M_LRUCacheWrapper::cache_clear(ThreadContext* context,
+                                             M_BaseObject* self)
+{
+    M_LRUCacheWrapper* wrapper = M_LRUCACHEWRAPPER(self);
+
+    wrapper->clear();
+    wrapper->hits = wrapper->misses = 0;
+
+    return nullptr;
+}
+
+M_BaseObject* M_LRUCacheWrapper::__dict__get(ThreadContext* context,
+                                             M_BaseObject* self)
+{
+    return self->get_dict(context->get_space());
+}
+
+Typedef* M_LRUCacheWrapper::_lru_cache_wrapper_typedef()
+{
+    static Typedef lru_cache_wrapper_typedef(
+        "_lru_cache_wrapper",
+        {
+            {"__new__",
+             new InterpFunctionWrapper("__new__", M_LRUCacheWrapper::__new__)},
+            {"__call__", new InterpFunctionWrapper(
+                             "__call__", M_LRUCacheWrapper::__call__)},
+            {"__get__",
+             new InterpFunctionWrapper("__get__", M_LRUCacheWrapper::__get__)},
+            {"cache_info", new InterpFunctionWrapper(
+                               "cache_info", M_LRUCacheWrapper::cache_info)},
+            {"cache_clear", new InterpFunctionWrapper(
+                                "cache_clear", M_LRUCacheWrapper::cache_clear)},
+            {"__dict__", new GetSetDescriptor(M_LRUCacheWrapper::__dict__get)},
+        });
+
+    return &lru_cache_wrapper_typedef;
+}
+
+Typedef* M_LRUCacheWrapper::get_typedef()
+{
+    return _lru_cache_wrapper_typedef();
+}
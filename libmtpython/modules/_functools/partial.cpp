@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "modules/_functools/partial.h"
+#include "objects/std/dict_object.h"
+#include "objects/std/tuple_object.h"
+#include "interpreter/typedef.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+#include "interpreter/descriptor.h"
+#include "interpreter/function.h"
+
+using namespace mtpython::modules;
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+#define M_PARTIAL(obj) (static_cast<M_Partial*>(obj))
+
+static void check_callable(ThreadContext* context, M_BaseObject* func)
+{
+    ObjSpace* space = context->get_space();
+
+    if (dynamic_cast<Function*>(func) || dynamic_cast<Method*>(func)) return;
+    if (space->lookup(func, "__call__")) return;
+
+    throw InterpError(space->TypeError_type(),
+                      space->wrap_str(context, "the first argument must be "
+                                               "callable"));
+}
+
+M_BaseObject* M_Partial::__new__(ThreadContext* context, const Arguments& args)
+{
+    static Signature new_signature({"type", "func"}, "args", "keywords", {});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("partial", nullptr, new_signature, scope);
+    M_BaseObject* func = scope[1];
+    M_BaseObject* call_args = scope[2];
+    M_BaseObject* keywords = scope[3];
+    check_callable(context, func);
+
+    /* partial(partial(f, a), b) is flattened into partial(f, a, b) */
+    if (typeid(*func) == typeid(M_Partial)) {
+        M_Partial* inner = M_PARTIAL(func);
+        M_StdTupleObject* inner_args = M_STDTUPLEOBJECT(inner->args);
+        M_StdTupleObject* outer_args = M_STDTUPLEOBJECT(call_args);
+        std::vector<M_BaseObject*> items(inner_args->begin(),
+                                         inner_args->end());
+
+        items.insert(items.end(), outer_args->begin(), outer_args->end());
+        call_args = space->new_tuple(context, items);
+
+        M_StdDictObject* merged =
+            static_cast<M_StdDictObject*>(space->new_dict(context));
+        update_dict(context, merged, inner->keywords);
+        update_dict(context, merged, keywords);
+        keywords = merged;
+
+        func = inner->func;
+    }
+
+    return new (context) M_Partial(func, call_args, keywords);
+}
+
+M_BaseObject* M_Partial::__call__(ThreadContext* context, const Arguments& args)
+{
+    ObjSpace* space = context->get_space();
+    M_Partial* self = M_PARTIAL(args[0]);
+    M_StdTupleObject* stored = M_STDTUPLEOBJECT(self->args);
+    M_StdDictObject* stored_kw = static_cast<M_StdDictObject*>(self->keywords);
+
+    std::vector<M_BaseObject*> positional;
+    positional.reserve(stored->size() + args.size() - 1);
+    positional.insert(positional.end(), stored->begin(), stored->end());
+    for (std::size_t i = 1; i < args.size(); i++)
+        positional.push_back(args[i]);
+
+    const std::vector<std::string>& call_names = args.get_keywords();
+    const std::vector<M_BaseObject*>& call_values = args.get_keyword_values();
+    if (stored_kw->size() == 0) {
+        Arguments call(space, positional, call_names, call_values);
+        return space->call_args(context, self->func, call);
+    }
+
+    /* keywords of the call override the stored ones */
+    std::vector<std::string> names;
+    std::vector<M_BaseObject*> values;
+    std::size_t pos = 0;
+    M_BaseObject *key, *value;
+    while (stored_kw->next_entry(pos, key, value)) {
+        std::string name = space->unwrap_str(key);
+        if (std::find(call_names.begin(), call_names.end(), name) !=
+            call_names.end())
+            continue;
+        names.push_back(name);
+        values.push_back(value);
+    }
+    names.insert(names.end(), call_names.begin(), call_names.end());
+    values.insert(values.end(), call_values.begin(), call_values.end());
+
+    Arguments call(space, positional, names, values);
+    return space->call_args(context, self->func, call);
+}
+
+M_BaseObject* M_Partial::__repr__(ThreadContext* context, M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_Partial* as_partial = M_PARTIAL(self);
+    M_StdTupleObject* stored = M_STDTUPLEOBJECT(as_partial->args);
+    M_StdDictObject* stored_kw =
+        static_cast<M_StdDictObject*>(as_partial->keywords);
+
+    std::string str = "functools.partial(";
+    str += space->unwrap_str(space->repr(as_partial->func));
+    for (auto* item : *stored) {
+        str += ", ";
+        str += space->unwrap_str(space->repr(item));
+    }
+
+    std::size_t pos = 0;
+    M_BaseObject *key, *value;
+    while (stored_kw->next_entry(pos, key, value)) {
+        str += ", ";
+        str += space->unwrap_str(key);
+        str += "=";
+        str += space->unwrap_str(space->repr(value));
+    }
+    str += ")";
+
+    return space->wrap_str(context, str);
+}
+
+M_BaseObject* M_Partial::func_get(ThreadContext* context, M_BaseObject* self)
+{
+    return M_PARTIAL(self)->func;
+}
+
+M_BaseObject* M_Partial::args_get(ThreadContext* context, M_BaseObject* self)
+{
+    return M_PARTIAL(self)->args;
+}
+
+M_BaseObject* M_Partial::keywords_get(ThreadContext* context,
+                                      M_BaseObject* self)
+{
+    return M_PARTIAL(self)->keywords;
+}
+
+Typedef* M_Partial::_partial_typedef()
+{
+    static Typedef partial_typedef(
+        "partial",
+        {
+            {"__new__",
+             new InterpFunctionWrapper("__new__", M_Partial::__new__)},
+            {"__call__",
+             new InterpFunctionWrapper("__call__", M_Partial::__call__)},
+            {"__repr__",
+             new InterpFunctionWrapper("__repr__", M_Partial::__repr__)},
+            {"func", new GetSetDescriptor(M_Partial::func_get)},
+            {"args", new GetSetDescriptor(M_Partial::args_get)},
+            {"keywords", new GetSetDescriptor(M_Partial::keywords_get)},
+        });
+
+    return &partial_typedef;
+}
+
+Typedef* M_Partial::get_typedef() { return _partial_typedef(); }
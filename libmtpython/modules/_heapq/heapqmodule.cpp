@@ -0,0 +1,258 @@
+#include <utility>
+
+#include "modules/_heapq/heapqmodule.h"
+#include "objects/std/list_object.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+namespace mtpython {
+namespace modules {
+
+namespace {
+/* A list used as a binary heap, the smallest item first or the largest item
+ * first if max is set. Items are compared with ObjSpace::i_lt(), which
+ * compares ints, floats and strs without going through __lt__. A __lt__ in
+ * Python may still resize the list, so the size is checked after each
+ * comparison. */
+class Heap {
+private:
+    ThreadContext* context;
+    M_StdListObject* list;
+    std::size_t size;
+    bool max;
+
+    bool less(M_BaseObject* a, M_BaseObject* b)
+    {
+        ObjSpace* space = context->get_space();
+        bool result = max ? space->i_lt(b, a) : space->i_lt(a, b);
+
+        if (list->size() != size) {
+            throw InterpError(space->RuntimeError_type(),
+                              space->wrap_str(context, "list changed size "
+                                                       "during iteration"));
+        }
+
+        return result;
+    }
+
+public:
+    Heap(ThreadContext* context, M_StdListObject* list, bool max = false)
+        : context(context), list(list), size(list->size()), max(max)
+    {}
+
+    M_BaseObject*& operator[](std::size_t i) { return (*list)[i]; }
+
+    /* Move the item at pos up towards start until its parent is not larger */
+    void siftdown(std::size_t start, std::size_t pos)
+    {
+        M_BaseObject* item = (*list)[pos];
+
+        while (pos > start) {
+            std::size_t parent_pos = (pos - 1) >> 1;
+            M_BaseObject* parent = (*list)[parent_pos];
+            if (!less(item, parent)) break;
+            (*list)[pos] = parent;
+            pos = parent_pos;
+        }
+
+        (*list)[pos] = item;
+    }
+
+    /* Move the smaller child up until the item at pos reaches a leaf of the
+     * heap in [0, end), then bubble it back up to its place */
+    void siftup(std::size_t pos, std::size_t end)
+    {
+        std::size_t start = pos;
+        M_BaseObject* item = (*list)[pos];
+        std::size_t child = 2 * pos + 1;
+
+        while (child < end) {
+            std::size_t right = child + 1;
+            if (right < end && !less((*list)[child], (*list)[right]))
+                child = right;
+            (*list)[pos] = (*list)[child];
+            pos = child;
+            child = 2 * pos + 1;
+        }
+
+        (*list)[pos] = item;
+        siftdown(start, pos);
+    }
+
+    void siftup(std::size_t pos) { siftup(pos, size); }
+
+    void heapify()
+    {
+        for (std::size_t i = size / 2; i > 0; i--)
+            siftup(i - 1);
+    }
+
+    /* Sort a heap in place, the reverse of the heap order */
+    void sort()
+    {
+        for (std::size_t end = size; end > 1; end--) {
+            std::swap((*list)[0], (*list)[end - 1]);
+            siftup(0, end - 1);
+        }
+    }
+};
+} // namespace
+
+static M_StdListObject* heap_arg(ThreadContext* context, M_BaseObject* heap)
+{
+    ObjSpace* space = context->get_space();
+    M_StdListObject* list = dynamic_cast<M_StdListObject*>(heap);
+
+    if (!list) {
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "heap argument must be "
+                                                   "a list"));
+    }
+
+    return list;
+}
+
+static void check_not_empty(ThreadContext* context, M_StdListObject* list)
+{
+    ObjSpace* space = context->get_space();
+
+    if (list->size() == 0) {
+        throw InterpError(space->IndexError_type(),
+                          space->wrap_str(context, "index out of range"));
+    }
+}
+
+static M_BaseObject* heapq_heappush(ThreadContext* context, M_BaseObject* heap,
+                                    M_BaseObject* item)
+{
+    M_StdListObject* list = heap_arg(context, heap);
+
+    list->lock();
+    list->push_back(context, item);
+    list->unlock();
+
+    Heap(context, list).siftdown(0, list->size() - 1);
+    return nullptr;
+}
+
+static M_BaseObject* heapq_heappop(ThreadContext* context, M_BaseObject* heap)
+{
+    M_StdListObject* list = heap_arg(context, heap);
+    check_not_empty(context, list);
+
+    list->lock();
+    M_BaseObject* last = list->erase(list->size() - 1);
+    list->unlock();
+    if (list->size() == 0) return last;
+
+    Heap h(context, list);
+    M_BaseObject* result = h[0];
+    h[0] = last;
+    h.siftup(0);
+
+    return result;
+}
+
+static M_BaseObject* heapq_heapreplace(ThreadContext* context,
+                                       M_BaseObject* heap, M_BaseObject* item)
+{
+    M_StdListObject* list = heap_arg(context, heap);
+    check_not_empty(context, list);
+
+    Heap h(context, list);
+    M_BaseObject* result = h[0];
+    h[0] = item;
+    h.siftup(0);
+
+    return result;
+}
+
+static M_BaseObject* heapq_heappushpop(ThreadContext* context,
+                                       M_BaseObject* heap, M_BaseObject* item)
+{
+    ObjSpace* space = context->get_space();
+    M_StdListObject* list = heap_arg(context, heap);
+
+    if (list->size() == 0 || !space->i_lt((*list)[0], item)) return item;
+    /* __lt__ may have emptied the list */
+    check_not_empty(context, list);
+
+    Heap h(context, list);
+    M_BaseObject* result = h[0];
+    h[0] = item;
+    h.siftup(0);
+
+    return result;
+}
+
+static M_BaseObject* heapq_heapify(ThreadContext* context, M_BaseObject* heap)
+{
+    Heap(context, heap_arg(context, heap)).heapify();
+    return nullptr;
+}
+
+/* The n extreme items of iterable: the first n items are kept in a heap
+ * ordered the other way round, so its top is the item to evict next */
+static M_BaseObject* select_n(ThreadContext* context, M_BaseObject* n_obj,
+                              M_BaseObject* iterable, bool largest)
+{
+    ObjSpace* space = context->get_space();
+    int n = space->unwrap_int(n_obj);
+    M_StdListObject* result = new (context) M_StdListObject();
+    if (n <= 0) return result;
+
+    M_BaseObject* iterator = space->iter(iterable);
+    M_BaseObject* item = nullptr;
+    while ((int)result->size() < n && (item = space->next_item(iterator)))
+        result->push_back(context, item);
+
+    Heap h(context, result, !largest);
+    h.heapify();
+
+    if (item) {
+        while ((item = space->next_item(iterator))) {
+            bool better =
+                largest ? space->i_lt(h[0], item) : space->i_lt(item, h[0]);
+            if (!better) continue;
+            h[0] = item;
+            h.siftup(0);
+        }
+    }
+
+    h.sort();
+    return result;
+}
+
+static M_BaseObject* heapq_nlargest(ThreadContext* context, M_BaseObject* n,
+                                    M_BaseObject* iterable)
+{
+    return select_n(context, n, iterable, true);
+}
+
+static M_BaseObject* heapq_nsmallest(ThreadContext* context, M_BaseObject* n,
+                                     M_BaseObject* iterable)
+{
+    return select_n(context, n, iterable, false);
+}
+
+HeapqModule::HeapqModule(ObjSpace* space, M_BaseObject* name)
+    : BuiltinModule(space, name)
+{
+    add_def("heappush", new InterpFunctionWrapper("heappush", heapq_heappush));
+    add_def("heappop", new InterpFunctionWrapper("heappop", heapq_heappop));
+    add_def("heapreplace",
+            new InterpFunctionWrapper("heapreplace", heapq_heapreplace));
+    add_def("heappushpop",
+            new InterpFunctionWrapper("heappushpop", heapq_heappushpop));
+    add_def("heapify", new InterpFunctionWrapper("heapify", heapq_heapify));
+    add_def("nlargest", new InterpFunctionWrapper("nlargest", heapq_nlargest));
+    add_def("nsmallest",
+            new InterpFunctionWrapper("nsmallest", heapq_nsmallest));
+}
+
+} // namespace modules
+} // namespace mtpython
@@ -1,16 +1,103 @@
+#include <algorithm>
+#include <cstring>
+#include <string>
+
 #include "modules/_io/iomodule.h"
 #include "modules/_io/bufferedio.h"
+#include "modules/_io/fileio.h"
 #include "interpreter/gateway.h"
 #include "interpreter/pycode.h"
 #include "interpreter/compiler.h"
 #include "interpreter/error.h"
 #include "interpreter/pyframe.h"
+#include "objects/buffer.h"
+#include "objects/std/bytes_object.h"
 
 using namespace mtpython::modules;
 using namespace mtpython::objects;
 using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+/* size argument of the read methods, None means -1 */
+static int size_arg(ObjSpace* space, M_BaseObject* size)
+{
+    return space->i_is(size, space->wrap_None()) ? -1 : space->unwrap_int(size);
+}
+
+void BufferedBase::init(ThreadContext* context, M_BaseObject* raw,
+                        int buffer_size)
+{
+    ObjSpace* space = context->get_space();
+    if (buffer_size <= 0) {
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "buffer size must be "
+                                                   "strictly positive"));
+    }
+
+    this->raw = raw;
+    raw_fileio = dynamic_cast<M_FileIO*>(raw);
+    this->buffer_size = (std::size_t)buffer_size;
+    buffer = M_GCArray<std::uint8_t>::create(context, this->buffer_size);
+    space->setattr(this, space->wrap_str(context, "raw"), raw);
+}
+
+void BufferedBase::check_initialized(ThreadContext* context)
+{
+    ObjSpace* space = context->get_space();
+    if (!buffer) {
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "I/O operation on "
+                                                   "uninitialized object"));
+    }
+
+    bool closed = raw_fileio
+                      ? raw_fileio->is_closed()
+                      : space->is_true(space->getattr_str(raw, "closed"));
+    if (closed) {
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context,
+                                          "I/O operation on closed file"));
+    }
+}
+
+std::size_t BufferedBase::raw_read(ThreadContext* context, std::uint8_t* dst,
+                                   std::size_t n)
+{
+    if (raw_fileio) return raw_fileio->read_some(context, dst, n);
+
+    ObjSpace* space = context->get_space();
+    M_BaseObject* data =
+        space->call_function(context, space->getattr_str(raw, "read"),
+                             {space->wrap_int(context, (int)n)});
+    if (space->i_is(data, space->wrap_None())) return 0;
 
-M_BaseObject* BufferedBase::name_get(mtpython::vm::ThreadContext* context,
+    Buffer view;
+    space->get_buffer(data, view);
+    if (view.nbytes() > n) {
+        throw InterpError(space->OSError_type(),
+                          space->wrap_str(context, "raw read() returned "
+                                                   "too many bytes"));
+    }
+    view.copy_to(dst);
+
+    return view.nbytes();
+}
+
+std::size_t BufferedBase::raw_write(ThreadContext* context,
+                                    const std::uint8_t* src, std::size_t n)
+{
+    if (raw_fileio) return raw_fileio->write_some(context, src, n);
+
+    ObjSpace* space = context->get_space();
+    M_BaseObject* written =
+        space->call_function(context, space->getattr_str(raw, "write"),
+                             {space->new_bytes(context, src, n)});
+    if (space->i_is(written, space->wrap_None())) return 0;
+
+    return (std::size_t)space->unwrap_int(written);
+}
+
+M_BaseObject* BufferedBase::name_get(ThreadContext* context,
                                      M_BaseObject* self)
 {
     BufferedBase* bb = static_cast<BufferedBase*>(self);
@@ -18,7 +105,23 @@ M_BaseObject* BufferedBase::name_get(mtpython::vm::ThreadContext* context,
     return space->getattr_str(bb->raw, "name");
 }
 
-M_BaseObject* M_BufferedReader::__new__(mtpython::vm::ThreadContext* context,
+M_BaseObject* BufferedBase::closed_get(ThreadContext* context,
+                                       M_BaseObject* self)
+{
+    BufferedBase* bb = static_cast<BufferedBase*>(self);
+    ObjSpace* space = context->get_space();
+    return space->getattr_str(bb->raw, "closed");
+}
+
+M_BaseObject* BufferedBase::fileno(ThreadContext* context, M_BaseObject* self)
+{
+    BufferedBase* bb = static_cast<BufferedBase*>(self);
+    ObjSpace* space = context->get_space();
+    return space->call_function(context, space->getattr_str(bb->raw, "fileno"),
+                                {});
+}
+
+M_BaseObject* M_BufferedReader::__new__(ThreadContext* context,
                                         const Arguments& args)
 {
     ObjSpace* space = context->get_space();
@@ -26,7 +129,7 @@ M_BaseObject* M_BufferedReader::__new__(mtpython::vm::ThreadContext* context,
     return space->wrap(context, instance);
 }
 
-M_BaseObject* M_BufferedReader::__init__(mtpython::vm::ThreadContext* context,
+M_BaseObject* M_BufferedReader::__init__(ThreadContext* context,
                                          const Arguments& args)
 {
     static Signature init_signature({"self", "raw", "buffer_size"});
@@ -35,17 +138,227 @@ M_BaseObject* M_BufferedReader::__init__(mtpython::vm::ThreadContext* context,
     std::vector<M_BaseObject*> scope;
     args.parse("__init__", nullptr, init_signature, scope,
                {space->wrap_int(context, DEFAULT_BUFFER_SIZE)});
-    M_BaseObject* self = scope[0];
-    M_BaseObject* raw = scope[1];
 
-    M_BufferedReader* as_br = static_cast<M_BufferedReader*>(self);
-    as_br->raw = raw;
-    space->setattr(as_br, space->wrap_str(context, "raw"), raw);
+    M_BufferedReader* as_br = static_cast<M_BufferedReader*>(scope[0]);
+    as_br->init(context, scope[1], space->unwrap_int(scope[2]));
+    as_br->pos = as_br->end = 0;
 
     return nullptr;
 }
 
-M_BaseObject* M_BufferedWriter::__new__(mtpython::vm::ThreadContext* context,
+std::size_t M_BufferedReader::fill_buffer(ThreadContext* context)
+{
+    pos = end = 0;
+    end = raw_read(context, buffer->begin(), buffer_size);
+    return end;
+}
+
+const std::uint8_t* M_BufferedReader::buffered_data(ThreadContext* context,
+                                                   std::size_t& n)
+{
+    check_initialized(context);
+    if (!available()) fill_buffer(context);
+
+    n = available();
+    return buffer->begin() + pos;
+}
+
+std::size_t M_BufferedReader::read_into(ThreadContext* context,
+                                        std::uint8_t* dst, std::size_t n)
+{
+    std::size_t got = std::min(n, available());
+    std::memcpy(dst, buffer->begin() + pos, got);
+    pos += got;
+
+    while (got < n) {
+        std::size_t want = n - got;
+
+        if (want >= buffer_size) {
+            /* large reads skip the buffer */
+            std::size_t k = raw_read(context, dst + got, want);
+            if (!k) break;
+            got += k;
+        } else {
+            if (!fill_buffer(context)) break;
+            std::size_t k = std::min(want, end);
+            std::memcpy(dst + got, buffer->begin(), k);
+            pos = k;
+            got += k;
+        }
+    }
+
+    return got;
+}
+
+M_BaseObject* M_BufferedReader::read(ThreadContext* context,
+                                     const Arguments& args)
+{
+    static Signature read_signature({"self", "size"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("read", nullptr, read_signature, scope,
+               {space->wrap_int(context, -1)});
+    M_BufferedReader* as_br = static_cast<M_BufferedReader*>(scope[0]);
+    as_br->check_initialized(context);
+    int size = size_arg(space, scope[1]);
+
+    std::uint8_t* start = as_br->buffer->begin() + as_br->pos;
+    std::size_t avail = as_br->available();
+
+    if (size < 0) {
+        M_StdBytesObject* result;
+
+        if (as_br->raw_fileio) {
+            result = as_br->raw_fileio->read_to_end(context, start, avail);
+        } else {
+            M_BaseObject* rest = space->call_function(
+                context, space->getattr_str(as_br->raw, "readall"), {});
+            Buffer view;
+            if (!space->i_is(rest, space->wrap_None()))
+                space->get_buffer(rest, view);
+
+            result = M_StdBytesObject::create(context, nullptr,
+                                              avail + view.nbytes());
+            std::memcpy(result->data(), start, avail);
+            view.copy_to(result->data() + avail);
+        }
+
+        as_br->pos = as_br->end = 0;
+        return result;
+    }
+
+    if ((std::size_t)size <= avail) {
+        as_br->pos += size;
+        return M_StdBytesObject::create(context, start, size);
+    }
+
+    M_StdBytesObject* result =
+        M_StdBytesObject::create(context, nullptr, size);
+    result->shrink(as_br->read_into(context, result->data(), size));
+    return result;
+}
+
+M_BaseObject* M_BufferedReader::read1(ThreadContext* context,
+                                      const Arguments& args)
+{
+    static Signature read1_signature({"self", "size"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("read1", nullptr, read1_signature, scope,
+               {space->wrap_int(context, -1)});
+    M_BufferedReader* as_br = static_cast<M_BufferedReader*>(scope[0]);
+    as_br->check_initialized(context);
+    int size = size_arg(space, scope[1]);
+
+    if (!as_br->available()) {
+        if (size >= 0 && (std::size_t)size >= as_br->buffer_size) {
+            M_StdBytesObject* result =
+                M_StdBytesObject::create(context, nullptr, size);
+            result->shrink(as_br->raw_read(context, result->data(), size));
+            return result;
+        }
+
+        as_br->fill_buffer(context);
+    }
+
+    std::size_t n = as_br->available();
+    if (size >= 0) n = std::min(n, (std::size_t)size);
+
+    M_StdBytesObject* result =
+        M_StdBytesObject::create(context, as_br->buffer->begin() + as_br->pos,
+                                 n);
+    as_br->pos += n;
+    return result;
+}
+
+M_BaseObject* M_BufferedReader::readinto(ThreadContext* context,
+                                         M_BaseObject* self, M_BaseObject* b)
+{
+    ObjSpace* space = context->get_space();
+    M_BufferedReader* as_br = static_cast<M_BufferedReader*>(self);
+    as_br->check_initialized(context);
+
+    Buffer view;
+    space->get_buffer(b, view, true);
+
+    std::size_t n = as_br->read_into(context, view.buf, view.nbytes());
+    return space->wrap_int(context, (int)n);
+}
+
+M_BaseObject* M_BufferedReader::peek(ThreadContext* context,
+                                     const Arguments& args)
+{
+    static Signature peek_signature({"self", "size"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("peek", nullptr, peek_signature, scope,
+               {space->wrap_int(context, 0)});
+    M_BufferedReader* as_br = static_cast<M_BufferedReader*>(scope[0]);
+    as_br->check_initialized(context);
+
+    /* like CPython, at most one raw read and the size is only a hint */
+    if (!as_br->available()) as_br->fill_buffer(context);
+
+    return M_StdBytesObject::create(
+        context, as_br->buffer->begin() + as_br->pos, as_br->available());
+}
+
+M_BaseObject* M_BufferedReader::readline(ThreadContext* context,
+                                         const Arguments& args)
+{
+    static Signature readline_signature({"self", "size"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("readline", nullptr, readline_signature, scope,
+               {space->wrap_int(context, -1)});
+    M_BufferedReader* as_br = static_cast<M_BufferedReader*>(scope[0]);
+    as_br->check_initialized(context);
+    int size = size_arg(space, scope[1]);
+    std::size_t limit = size < 0 ? (std::size_t)-1 : (std::size_t)size;
+
+    std::string line;
+    while (line.size() < limit) {
+        if (!as_br->available() && !as_br->fill_buffer(context)) break;
+
+        std::uint8_t* start = as_br->buffer->begin() + as_br->pos;
+        std::size_t scan = std::min(as_br->available(), limit - line.size());
+        auto* nl = static_cast<std::uint8_t*>(std::memchr(start, '\n', scan));
+        std::size_t take = nl ? (nl - start) + 1 : scan;
+        as_br->pos += take;
+
+        /* lines inside the buffer are copied once into the result */
+        if (line.empty() && (nl || take == limit))
+            return M_StdBytesObject::create(context, start, take);
+
+        line.append(reinterpret_cast<const char*>(start), take);
+        if (nl) break;
+    }
+
+    return space->new_bytes(context, line.data(), line.size());
+}
+
+M_BaseObject* M_BufferedReader::readable(ThreadContext* context,
+                                         M_BaseObject* self)
+{
+    return context->get_space()->new_bool(true);
+}
+
+M_BaseObject* M_BufferedReader::close(ThreadContext* context,
+                                      M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_BufferedReader* as_br = static_cast<M_BufferedReader*>(self);
+    as_br->pos = as_br->end = 0;
+
+    return space->call_function(context,
+                                space->getattr_str(as_br->raw, "close"), {});
+}
+
+M_BaseObject* M_BufferedWriter::__new__(ThreadContext* context,
                                         const Arguments& args)
 {
     ObjSpace* space = context->get_space();
@@ -53,7 +366,7 @@ M_BaseObject* M_BufferedWriter::__new__(mtpython::vm::ThreadContext* context,
     return space->wrap(context, instance);
 }
 
-M_BaseObject* M_BufferedWriter::__init__(mtpython::vm::ThreadContext* context,
+M_BaseObject* M_BufferedWriter::__init__(ThreadContext* context,
                                          const Arguments& args)
 {
     static Signature init_signature({"self", "raw", "buffer_size"});
@@ -63,12 +376,113 @@ M_BaseObject* M_BufferedWriter::__init__(mtpython::vm::ThreadContext* context,
     args.parse("__init__", nullptr, init_signature, scope,
                {space->wrap_int(context, DEFAULT_BUFFER_SIZE)});
 
-    M_BaseObject* self = scope[0];
-    M_BaseObject* raw = scope[1];
+    M_BufferedWriter* as_bw = static_cast<M_BufferedWriter*>(scope[0]);
+    as_bw->init(context, scope[1], space->unwrap_int(scope[2]));
+    as_bw->pending = 0;
+
+    return nullptr;
+}
+
+void M_BufferedWriter::write_all(ThreadContext* context,
+                                 const std::uint8_t* src, std::size_t n)
+{
+    while (n) {
+        std::size_t written = raw_write(context, src, n);
+        if (!written) {
+            ObjSpace* space = context->get_space();
+            throw InterpError(space->OSError_type(),
+                              space->wrap_str(context, "write could not "
+                                                       "complete"));
+        }
+        src += written;
+        n -= written;
+    }
+}
+
+void M_BufferedWriter::flush_buffer(ThreadContext* context)
+{
+    std::size_t n = pending;
+    /* drop the pending bytes first so that a failed write is not repeated
+     * by close() */
+    pending = 0;
+    write_all(context, buffer->begin(), n);
+}
+
+void M_BufferedWriter::write_data(ThreadContext* context,
+                                  const std::uint8_t* src, std::size_t n)
+{
+    check_initialized(context);
+
+    if (pending + n <= buffer_size) {
+        std::memcpy(buffer->begin() + pending, src, n);
+        pending += n;
+        return;
+    }
+
+    flush_buffer(context);
+    if (n < buffer_size) {
+        std::memcpy(buffer->begin(), src, n);
+        pending = n;
+    } else {
+        write_all(context, src, n);
+    }
+}
+
+M_BaseObject* M_BufferedWriter::write(ThreadContext* context,
+                                      M_BaseObject* self, M_BaseObject* b)
+{
+    ObjSpace* space = context->get_space();
+    M_BufferedWriter* as_bw = static_cast<M_BufferedWriter*>(self);
+
+    Buffer view;
+    space->get_buffer(b, view);
+    std::size_t n = view.nbytes();
 
+    if (view.is_contiguous()) {
+        as_bw->write_data(context, view.buf, n);
+    } else {
+        std::string data(n, '\0');
+        view.copy_to(reinterpret_cast<std::uint8_t*>(&data[0]));
+        as_bw->write_data(
+            context, reinterpret_cast<const std::uint8_t*>(data.data()), n);
+    }
+
+    return space->wrap_int(context, (int)n);
+}
+
+M_BaseObject* M_BufferedWriter::flush(ThreadContext* context,
+                                      M_BaseObject* self)
+{
     M_BufferedWriter* as_bw = static_cast<M_BufferedWriter*>(self);
-    as_bw->raw = raw;
-    space->setattr(as_bw, space->wrap_str(context, "raw"), raw);
+    as_bw->check_initialized(context);
+    as_bw->flush_buffer(context);
 
     return nullptr;
 }
+
+M_BaseObject* M_BufferedWriter::writable(ThreadContext* context,
+                                         M_BaseObject* self)
+{
+    return context->get_space()->new_bool(true);
+}
+
+M_BaseObject* M_BufferedWriter::close(ThreadContext* context,
+                                      M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_BufferedWriter* as_bw = static_cast<M_BufferedWriter*>(self);
+
+    if (space->is_true(space->getattr_str(as_bw->raw, "closed")))
+        return nullptr;
+
+    try {
+        as_bw->flush_buffer(context);
+    } catch (const InterpError&) {
+        space->call_function(context, space->getattr_str(as_bw->raw, "close"),
+                             {});
+        throw;
+    }
+
+    return space->call_function(context,
+                                space->getattr_str(as_bw->raw, "close"), {});
+}
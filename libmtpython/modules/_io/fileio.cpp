@@ -1,9 +1,14 @@
 #include <stdexcept>
 #include <string>
+#include <cstring>
+#include <cerrno>
 #include <fcntl.h>
+#include <sys/stat.h>
 
 #ifdef _WIN32_
 #include <io.h>
+#else
+#include <unistd.h>
 #endif
 
 #include "modules/_io/iomodule.h"
@@ -13,10 +18,13 @@
 #include "interpreter/compiler.h"
 #include "interpreter/error.h"
 #include "interpreter/pyframe.h"
+#include "objects/buffer.h"
+#include "objects/std/bytes_object.h"
 
 using namespace mtpython::modules;
 using namespace mtpython::objects;
 using namespace mtpython::interpreter;
+using namespace mtpython::vm;
 
 M_BaseObject* M_FileIO::__new__(mtpython::vm::ThreadContext* context,
                                 const Arguments& args)
@@ -26,6 +34,13 @@ M_BaseObject* M_FileIO::__new__(mtpython::vm::ThreadContext* context,
     return space->wrap(context, instance);
 }
 
+static InterpError io_error(ThreadContext* context)
+{
+    ObjSpace* space = context->get_space();
+    return InterpError(space->OSError_type(),
+                       space->wrap_str(context, std::strerror(errno)));
+}
+
 static int decode_mode(const std::string& mode)
 {
     int flags = 0;
@@ -88,7 +103,7 @@ M_BaseObject* M_FileIO::__init__(mtpython::vm::ThreadContext* context,
 
     int flags = decode_mode(mode);
 
-    if (fd > 0) {
+    if (fd >= 0) {
         as_fio->fd = fd;
         as_fio->closefd = closefd;
     } else {
@@ -104,9 +119,7 @@ M_BaseObject* M_FileIO::__init__(mtpython::vm::ThreadContext* context,
         if (fd < 0) error = -fd;
 #endif
 
-        if (error) {
-            /* TODO: report error */
-        }
+        if (error) throw io_error(context);
 
         as_fio->fd = fd;
         space->setattr(as_fio, space->wrap_str(context, "name"), wrapped_name);
@@ -128,3 +141,166 @@ void M_FileIO::name_set(mtpython::vm::ThreadContext* context, M_BaseObject* obj,
     M_FileIO* as_fio = static_cast<M_FileIO*>(obj);
     as_fio->name = value;
 }
+
+void M_FileIO::check_closed(ThreadContext* context)
+{
+    if (fd < 0) {
+        ObjSpace* space = context->get_space();
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context,
+                                          "I/O operation on closed file"));
+    }
+}
+
+std::size_t M_FileIO::read_some(ThreadContext* context, std::uint8_t* dst,
+                                std::size_t n)
+{
+    check_closed(context);
+
+    ssize_t result;
+    do {
+        result = ::read(fd, dst, n);
+    } while (result < 0 && errno == EINTR);
+    if (result < 0) throw io_error(context);
+
+    return (std::size_t)result;
+}
+
+std::size_t M_FileIO::write_some(ThreadContext* context,
+                                 const std::uint8_t* src, std::size_t n)
+{
+    check_closed(context);
+
+    ssize_t result;
+    do {
+        result = ::write(fd, src, n);
+    } while (result < 0 && errno == EINTR);
+    if (result < 0) throw io_error(context);
+
+    return (std::size_t)result;
+}
+
+M_StdBytesObject* M_FileIO::read_to_end(ThreadContext* context,
+                                        const std::uint8_t* prefix,
+                                        std::size_t prefix_len)
+{
+    check_closed(context);
+
+    /* size the result by what is left of a regular file, a short read from
+     * such a file means the end of file has been reached */
+    bool regular = false;
+    std::size_t remaining = 0;
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        regular = true;
+        off_t cur = ::lseek(fd, 0, SEEK_CUR);
+        if (cur >= 0 && st.st_size > cur) remaining = st.st_size - cur;
+    }
+
+    std::size_t capacity =
+        prefix_len + (regular ? remaining + 1 : DEFAULT_BUFFER_SIZE);
+    M_StdBytesObject* bytes =
+        M_StdBytesObject::create(context, nullptr, capacity);
+    if (prefix_len) std::memcpy(bytes->data(), prefix, prefix_len);
+
+    std::size_t got = prefix_len;
+    while (true) {
+        if (got == capacity) {
+            /* the file grew or is not a regular file */
+            capacity += (capacity >> 1) + DEFAULT_BUFFER_SIZE;
+            M_StdBytesObject* larger =
+                M_StdBytesObject::create(context, nullptr, capacity);
+            std::memcpy(larger->data(), bytes->data(), got);
+            bytes = larger;
+        }
+
+        std::size_t n = read_some(context, bytes->data() + got, capacity - got);
+        got += n;
+        if (n == 0 || (regular && got < capacity)) break;
+    }
+    bytes->shrink(got);
+
+    return bytes;
+}
+
+M_BaseObject* M_FileIO::readinto(ThreadContext* context, M_BaseObject* self,
+                                 M_BaseObject* buffer)
+{
+    ObjSpace* space = context->get_space();
+    M_FileIO* as_fio = static_cast<M_FileIO*>(self);
+    as_fio->check_closed(context);
+
+    Buffer view;
+    space->get_buffer(buffer, view, true);
+
+    std::size_t n = as_fio->read_some(context, view.buf, view.nbytes());
+
+    return space->wrap_int(context, (int)n);
+}
+
+M_BaseObject* M_FileIO::write(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* buffer)
+{
+    ObjSpace* space = context->get_space();
+    M_FileIO* as_fio = static_cast<M_FileIO*>(self);
+    as_fio->check_closed(context);
+
+    Buffer view;
+    space->get_buffer(buffer, view);
+
+    std::size_t n = as_fio->write_some(context, view.buf, view.nbytes());
+
+    return space->wrap_int(context, (int)n);
+}
+
+M_BaseObject* M_FileIO::read(ThreadContext* context, const Arguments& args)
+{
+    static Signature read_signature({"self", "size"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("read", nullptr, read_signature, scope,
+               {space->wrap_int(context, -1)});
+    M_FileIO* as_fio = static_cast<M_FileIO*>(scope[0]);
+    as_fio->check_closed(context);
+
+    int size = space->i_is(scope[1], space->wrap_None())
+                   ? -1
+                   : space->unwrap_int(scope[1]);
+    if (size < 0) return readall(context, scope[0]);
+
+    /* read straight into the new bytes object */
+    M_StdBytesObject* bytes = M_StdBytesObject::create(context, nullptr, size);
+    bytes->shrink(as_fio->read_some(context, bytes->data(), size));
+
+    return bytes;
+}
+
+M_BaseObject* M_FileIO::readall(ThreadContext* context, M_BaseObject* self)
+{
+    M_FileIO* as_fio = static_cast<M_FileIO*>(self);
+    return as_fio->read_to_end(context, nullptr, 0);
+}
+
+M_BaseObject* M_FileIO::fileno(ThreadContext* context, M_BaseObject* self)
+{
+    M_FileIO* as_fio = static_cast<M_FileIO*>(self);
+    as_fio->check_closed(context);
+    return context->get_space()->wrap_int(context, as_fio->fd);
+}
+
+M_BaseObject* M_FileIO::close(ThreadContext* context, M_BaseObject* self)
+{
+    M_FileIO* as_fio = static_cast<M_FileIO*>(self);
+
+    if (as_fio->fd >= 0 && as_fio->closefd) ::close(as_fio->fd);
+    as_fio->fd = -1;
+
+    return nullptr;
+}
+
+M_BaseObject* M_FileIO::closed_get(ThreadContext* context, M_BaseObject* self)
+{
+    M_FileIO* as_fio = static_cast<M_FileIO*>(self);
+    return context->get_space()->new_bool(as_fio->fd < 0);
+}
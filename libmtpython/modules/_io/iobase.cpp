@@ -15,3 +15,53 @@ M_IOBase::M_IOBase(ObjSpace* space)
 {
     dict = space->new_dict(ThreadContext::current_thread());
 }
+
+M_BaseObject* M_IOBase::__enter__(ThreadContext* context, M_BaseObject* self)
+{
+    return self;
+}
+
+M_BaseObject* M_IOBase::__exit__(ThreadContext* context, const Arguments& args)
+{
+    static Signature exit_signature(
+        {"self", "exc_type", "exc_value", "traceback"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("__exit__", nullptr, exit_signature, scope,
+               {space->wrap_None(), space->wrap_None(), space->wrap_None()});
+
+    space->call_function(context, space->getattr_str(scope[0], "close"), {});
+    return space->wrap_None();
+}
+
+M_BaseObject* M_IOBase::__iter__(ThreadContext* context, M_BaseObject* self)
+{
+    return self;
+}
+
+M_BaseObject* M_IOBase::__next__(ThreadContext* context, M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_BaseObject* line =
+        space->call_function(context, space->getattr_str(self, "readline"), {});
+    if (!space->is_true(line))
+        throw InterpError(space->StopIteration_type(), space->wrap_None());
+
+    return line;
+}
+
+M_BaseObject* M_IOBase::readable(ThreadContext* context, M_BaseObject* self)
+{
+    return context->get_space()->new_bool(false);
+}
+
+M_BaseObject* M_IOBase::writable(ThreadContext* context, M_BaseObject* self)
+{
+    return context->get_space()->new_bool(false);
+}
+
+M_BaseObject* M_IOBase::flush(ThreadContext* context, M_BaseObject* self)
+{
+    return nullptr;
+}
@@ -17,7 +17,18 @@ using namespace mtpython::modules;
 using namespace mtpython::objects;
 using namespace mtpython::interpreter;
 
-static Typedef _IOBase_typedef("_io._IOBase", {});
+static Typedef _IOBase_typedef(
+    "_io._IOBase",
+    {
+        {"__enter__",
+         new InterpFunctionWrapper("__enter__", M_IOBase::__enter__)},
+        {"__exit__", new InterpFunctionWrapper("__exit__", M_IOBase::__exit__)},
+        {"__iter__", new InterpFunctionWrapper("__iter__", M_IOBase::__iter__)},
+        {"__next__", new InterpFunctionWrapper("__next__", M_IOBase::__next__)},
+        {"readable", new InterpFunctionWrapper("readable", M_IOBase::readable)},
+        {"writable", new InterpFunctionWrapper("writable", M_IOBase::writable)},
+        {"flush", new InterpFunctionWrapper("flush", M_IOBase::flush)},
+    });
 
 static Typedef _RawIOBase_typedef("_io._RawIOBase", {&_IOBase_typedef}, {});
 
@@ -30,6 +41,15 @@ static Typedef* _fileio_typedef()
              new InterpFunctionWrapper("__new__", M_FileIO::__new__)},
             {"__init__",
              new InterpFunctionWrapper("__init__", M_FileIO::__init__)},
+            {"readinto",
+             new InterpFunctionWrapper("readinto", M_FileIO::readinto)},
+            {"write", new InterpFunctionWrapper("write", M_FileIO::write)},
+            {"read", new InterpFunctionWrapper("read", M_FileIO::read)},
+            {"readall",
+             new InterpFunctionWrapper("readall", M_FileIO::readall)},
+            {"fileno", new InterpFunctionWrapper("fileno", M_FileIO::fileno)},
+            {"close", new InterpFunctionWrapper("close", M_FileIO::close)},
+            {"closed", new GetSetDescriptor(M_FileIO::closed_get)},
             {"name",
              new GetSetDescriptor(M_FileIO::name_get, M_FileIO::name_set)},
         });
@@ -50,6 +70,21 @@ static Typedef* _bufferedreader_typedef()
              new InterpFunctionWrapper("__new__", M_BufferedReader::__new__)},
             {"__init__",
              new InterpFunctionWrapper("__init__", M_BufferedReader::__init__)},
+            {"read", new InterpFunctionWrapper("read", M_BufferedReader::read)},
+            {"read1",
+             new InterpFunctionWrapper("read1", M_BufferedReader::read1)},
+            {"readinto",
+             new InterpFunctionWrapper("readinto", M_BufferedReader::readinto)},
+            {"peek", new InterpFunctionWrapper("peek", M_BufferedReader::peek)},
+            {"readline",
+             new InterpFunctionWrapper("readline", M_BufferedReader::readline)},
+            {"readable",
+             new InterpFunctionWrapper("readable", M_BufferedReader::readable)},
+            {"fileno",
+             new InterpFunctionWrapper("fileno", M_BufferedReader::fileno)},
+            {"close",
+             new InterpFunctionWrapper("close", M_BufferedReader::close)},
+            {"closed", new GetSetDescriptor(M_BufferedReader::closed_get)},
             {"name", new GetSetDescriptor(M_BufferedReader::name_get)},
         });
     return &BufferedReader_typedef;
@@ -65,6 +100,17 @@ static Typedef* _bufferwriter_typedef()
              new InterpFunctionWrapper("__new__", M_BufferedWriter::__new__)},
             {"__init__",
              new InterpFunctionWrapper("__init__", M_BufferedWriter::__init__)},
+            {"write",
+             new InterpFunctionWrapper("write", M_BufferedWriter::write)},
+            {"flush",
+             new InterpFunctionWrapper("flush", M_BufferedWriter::flush)},
+            {"writable",
+             new InterpFunctionWrapper("writable", M_BufferedWriter::writable)},
+            {"fileno",
+             new InterpFunctionWrapper("fileno", M_BufferedWriter::fileno)},
+            {"close",
+             new InterpFunctionWrapper("close", M_BufferedWriter::close)},
+            {"closed", new GetSetDescriptor(M_BufferedWriter::closed_get)},
             {"name", new GetSetDescriptor(M_BufferedWriter::name_get)},
         });
     return &BufferedWriter_typedef;
@@ -84,8 +130,27 @@ static Typedef* _textiowrapper_typedef()
              new InterpFunctionWrapper("__init__", M_TextIOWrapper::__init__)},
             {"__repr__",
              new InterpFunctionWrapper("__repr__", M_TextIOWrapper::__repr__)},
+            {"__next__",
+             new InterpFunctionWrapper("__next__", M_TextIOWrapper::__next__)},
+            {"read", new InterpFunctionWrapper("read", M_TextIOWrapper::read)},
+            {"readline",
+             new InterpFunctionWrapper("readline", M_TextIOWrapper::readline)},
+            {"write",
+             new InterpFunctionWrapper("write", M_TextIOWrapper::write)},
+            {"flush",
+             new InterpFunctionWrapper("flush", M_TextIOWrapper::flush)},
+            {"close",
+             new InterpFunctionWrapper("close", M_TextIOWrapper::close)},
+            {"readable",
+             new InterpFunctionWrapper("readable", M_TextIOWrapper::readable)},
+            {"writable",
+             new InterpFunctionWrapper("writable", M_TextIOWrapper::writable)},
+            {"fileno",
+             new InterpFunctionWrapper("fileno", M_TextIOWrapper::fileno)},
             {"name", new GetSetDescriptor(M_TextIOWrapper::name_get)},
             {"buffer", new GetSetDescriptor(M_TextIOWrapper::buffer_get)},
+            {"encoding", new GetSetDescriptor(M_TextIOWrapper::encoding_get)},
+            {"closed", new GetSetDescriptor(M_TextIOWrapper::closed_get)},
         });
 
     return &TextIOWrapper_typedef;
@@ -147,8 +212,21 @@ static M_BaseObject* io_open(mtpython::vm::ThreadContext* context,
                              {file, wrapped_mode, wrapped_closefd});
 
     bool line_buffering = false;
+    if (buffering == 1) {
+        line_buffering = true;
+        buffering = -1;
+    }
     if (buffering < 0) buffering = DEFAULT_BUFFER_SIZE;
 
+    if (buffering == 0) {
+        if (!binary) {
+            throw InterpError(space->ValueError_type(),
+                              space->wrap_str(context, "can't have unbuffered "
+                                                       "text I/O"));
+        }
+        return raw;
+    }
+
     M_BaseObject* buffer_cls;
     if (updating) {
 
@@ -166,7 +244,7 @@ static M_BaseObject* io_open(mtpython::vm::ThreadContext* context,
         wrapper = buffer;
     } else {
         wrapper = space->call_function(
-            context, space->get_typeobject(&_TextIOBase_typedef),
+            context, space->get_typeobject(_textiowrapper_typedef()),
             {buffer, wrapped_encoding, wrapped_errors, wrapped_newline,
              space->new_bool(line_buffering)});
         space->setattr(wrapper, space->wrap_str(context, "mode"), wrapped_mode);
@@ -188,6 +266,7 @@ IOModule::IOModule(ObjSpace* space, M_BaseObject* name)
     add_def("_BufferedIOBase", space->get_typeobject(&_BufferedIOBase_typedef));
 
     add_def("BufferedReader", space->get_typeobject(_bufferedreader_typedef()));
+    add_def("BufferedWriter", space->get_typeobject(_bufferwriter_typedef()));
 
     add_def("FileIO", space->get_typeobject(_fileio_typedef()));
     add_def("TextIOWrapper", space->get_typeobject(_textiowrapper_typedef()));
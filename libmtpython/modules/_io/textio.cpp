@@ -1,14 +1,38 @@
+#include <cstring>
+
 #include "modules/_io/iomodule.h"
 #include "modules/_io/textio.h"
+#include "modules/_io/bufferedio.h"
 #include "interpreter/gateway.h"
 #include "interpreter/pycode.h"
 #include "interpreter/compiler.h"
 #include "interpreter/error.h"
 #include "interpreter/pyframe.h"
+#include "objects/buffer.h"
+#include "objects/std/bytes_object.h"
+#include "objects/std/unicode_object.h"
 
 using namespace mtpython::modules;
 using namespace mtpython::objects;
 using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+static const std::size_t NO_LIMIT = (std::size_t)-1;
+
+/* Whether s ends inside a multi-byte UTF-8 sequence */
+static bool incomplete_utf8_tail(const std::string& s)
+{
+    std::size_t n = s.size();
+
+    for (std::size_t back = 1; back <= 4 && back <= n; back++) {
+        std::uint8_t c = s[n - back];
+        if ((c & 0xc0) == 0x80) continue;
+
+        std::size_t len = c < 0xc0 ? 1 : (c < 0xe0 ? 2 : (c < 0xf0 ? 3 : 4));
+        return back < len;
+    }
+    return false;
+}
 
 M_BaseObject* M_TextIOWrapper::__new__(mtpython::vm::ThreadContext* context,
                                        const Arguments& args)
@@ -35,12 +59,451 @@ M_BaseObject* M_TextIOWrapper::__init__(mtpython::vm::ThreadContext* context,
     M_TextIOWrapper* as_tio = static_cast<M_TextIOWrapper*>(self);
     M_BaseObject* buffer = scope[1];
     M_BaseObject* wrapped_encoding = scope[2];
+    M_BaseObject* wrapped_errors = scope[3];
+    M_BaseObject* wrapped_newline = scope[4];
+
+    /* sys passes empty strings for the defaults */
+    if (space->i_is(wrapped_encoding, space->wrap_None()) ||
+        space->unwrap_str(wrapped_encoding).empty())
+        wrapped_encoding = space->wrap_str(context, "utf-8");
+    std::string codec = normalize_encoding(space->unwrap_str(wrapped_encoding));
+    std::string errors;
+    if (!space->i_is(wrapped_errors, space->wrap_None()))
+        errors = space->unwrap_str(wrapped_errors);
+    if (errors.empty()) errors = "strict";
+    /* throws LookupError for codecs and error handlers we don't have */
+    decode_bytes(space, nullptr, 0, codec, errors);
+
+    Newline newline = Newline::TRANSLATE;
+    const char* write_newline = nullptr;
+    if (!space->i_is(wrapped_newline, space->wrap_None())) {
+        std::string value = space->unwrap_str(wrapped_newline);
+        if (value == "") {
+            newline = Newline::UNIVERSAL;
+        } else if (value == "\n") {
+            newline = Newline::LF;
+        } else if (value == "\r") {
+            newline = Newline::CR;
+            write_newline = "\r";
+        } else if (value == "\r\n") {
+            newline = Newline::CRLF;
+            write_newline = "\r\n";
+        } else {
+            throw InterpError::format(space, space->ValueError_type(),
+                                      "illegal newline value: %s",
+                                      value.c_str());
+        }
+    }
+
     as_tio->buffer = buffer;
     as_tio->encoding = wrapped_encoding;
+    as_tio->reader = dynamic_cast<M_BufferedReader*>(buffer);
+    as_tio->writer = dynamic_cast<M_BufferedWriter*>(buffer);
+    as_tio->chunk = nullptr;
+    as_tio->chunk_pos = 0;
+    as_tio->codec = codec;
+    as_tio->errors = errors;
+    as_tio->utf8 = codec == "utf-8";
+    as_tio->newline = newline;
+    as_tio->write_newline = write_newline;
+    as_tio->line_buffering = space->is_true(scope[5]);
+    as_tio->skip_lf = false;
 
     return space->wrap_None();
 }
 
+void M_TextIOWrapper::check_initialized(ThreadContext* context)
+{
+    if (!buffer) {
+        ObjSpace* space = context->get_space();
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "I/O operation on "
+                                                   "uninitialized object"));
+    }
+}
+
+const std::uint8_t* M_TextIOWrapper::next_chunk(ThreadContext* context,
+                                                std::size_t& n)
+{
+    if (reader) {
+        const std::uint8_t* p = reader->buffered_data(context, n);
+        return n ? p : nullptr;
+    }
+
+    ObjSpace* space = context->get_space();
+    Buffer view;
+    if (chunk) {
+        space->get_buffer(chunk, view);
+        if (chunk_pos < view.nbytes()) {
+            n = view.nbytes() - chunk_pos;
+            return view.buf + chunk_pos;
+        }
+    }
+
+    M_BaseObject* read1 = space->getattr_str(buffer, "read1");
+    chunk = space->call_function(
+        context, read1, {space->wrap_int(context, DEFAULT_BUFFER_SIZE)});
+    chunk_pos = 0;
+    n = 0;
+    if (!space->i_is(chunk, space->wrap_None())) {
+        space->get_buffer(chunk, view);
+        n = view.nbytes();
+    }
+    if (!n) {
+        chunk = nullptr;
+        return nullptr;
+    }
+
+    return view.buf;
+}
+
+void M_TextIOWrapper::consume(std::size_t n)
+{
+    if (reader)
+        reader->consume(n);
+    else
+        chunk_pos += n;
+}
+
+std::size_t M_TextIOWrapper::find_special(const std::uint8_t* p, std::size_t n,
+                                          bool line) const
+{
+    bool cr, lf;
+    switch (newline) {
+    case Newline::TRANSLATE:
+        cr = true;
+        lf = line;
+        break;
+    case Newline::UNIVERSAL:
+        cr = lf = line;
+        break;
+    case Newline::CR:
+        cr = line;
+        lf = false;
+        break;
+    default:
+        cr = false;
+        lf = line;
+        break;
+    }
+
+    /* memchr() is vectorized, search for \n first and then for \r in the
+     * part before it */
+    std::size_t end = n;
+    if (lf) {
+        const void* found = std::memchr(p, '\n', n);
+        if (found) end = static_cast<const std::uint8_t*>(found) - p;
+    }
+    if (cr) {
+        const void* found = std::memchr(p, '\r', end);
+        if (found) end = static_cast<const std::uint8_t*>(found) - p;
+    }
+
+    return end;
+}
+
+void M_TextIOWrapper::read_text(ThreadContext* context, std::string& out,
+                                std::size_t limit, bool line)
+{
+    std::size_t chars = 0, n;
+    const std::uint8_t* p;
+
+    while (chars < limit && (p = next_chunk(context, n)) != nullptr) {
+        if (skip_lf) {
+            skip_lf = false;
+            if (p[0] == '\n') {
+                consume(1);
+                continue;
+            }
+        }
+
+        std::size_t run = find_special(p, n, line);
+        if (limit != NO_LIMIT) {
+            /* stop before the first byte of character limit + 1 */
+            std::size_t i = 0;
+            for (; i < run; i++) {
+                if (utf8 && (p[i] & 0xc0) == 0x80) continue;
+                if (chars == limit) break;
+                chars++;
+            }
+            run = i;
+        }
+
+        out.append(reinterpret_cast<const char*>(p), run);
+        if (run == n || chars == limit) {
+            consume(run);
+            continue;
+        }
+
+        /* p[run] ends a line or is a \r to translate */
+        std::uint8_t c = p[run];
+        std::size_t used = run + 1;
+        chars++;
+        if (c == '\r' && newline == Newline::TRANSLATE) {
+            out += '\n';
+            if (used == n)
+                skip_lf = true;
+            else if (p[used] == '\n')
+                used++;
+        } else {
+            out += (char)c;
+        }
+        consume(used);
+
+        if (!line) continue;
+        if (c == '\r' && newline == Newline::UNIVERSAL) {
+            /* the \n of \r\n may be in the next chunk */
+            p = next_chunk(context, n);
+            if (p && p[0] == '\n') {
+                out += '\n';
+                consume(1);
+            }
+        } else if (newline == Newline::CRLF &&
+                   (out.size() < 2 || out[out.size() - 2] != '\r')) {
+            continue;
+        }
+        return;
+    }
+
+    /* finish a character split between two chunks */
+    while (utf8 && limit != NO_LIMIT && incomplete_utf8_tail(out) &&
+           (p = next_chunk(context, n)) != nullptr) {
+        std::size_t i = 0;
+        while (i < n && (p[i] & 0xc0) == 0x80 && incomplete_utf8_tail(out))
+            out += (char)p[i++];
+        consume(i);
+        if (!i) break;
+    }
+}
+
+void M_TextIOWrapper::translate_into(std::string& out, const std::uint8_t* p,
+                                     std::size_t n)
+{
+    out.reserve(out.size() + n);
+    if (newline != Newline::TRANSLATE) {
+        out.append(reinterpret_cast<const char*>(p), n);
+        return;
+    }
+
+    std::size_t i = 0;
+    if (skip_lf && n) {
+        skip_lf = false;
+        if (p[0] == '\n') i = 1;
+    }
+
+    while (i < n) {
+        const void* found = std::memchr(p + i, '\r', n - i);
+        std::size_t end = found ? static_cast<const std::uint8_t*>(found) - p
+                                : n;
+        out.append(reinterpret_cast<const char*>(p) + i, end - i);
+        if (!found) break;
+
+        out += '\n';
+        i = end + 1;
+        if (i == n)
+            skip_lf = true;
+        else if (p[i] == '\n')
+            i++;
+    }
+}
+
+void M_TextIOWrapper::read_all(ThreadContext* context, std::string& out)
+{
+    ObjSpace* space = context->get_space();
+    Buffer view;
+
+    if (chunk) {
+        space->get_buffer(chunk, view);
+        translate_into(out, view.buf + chunk_pos, view.nbytes() - chunk_pos);
+        chunk = nullptr;
+    }
+
+    /* BufferedReader.read() reads the rest of a file with one call */
+    M_BaseObject* data =
+        space->call_function(context, space->getattr_str(buffer, "read"), {});
+    if (space->i_is(data, space->wrap_None())) return;
+
+    space->get_buffer(data, view);
+    translate_into(out, view.buf, view.nbytes());
+}
+
+M_BaseObject* M_TextIOWrapper::make_str(ThreadContext* context,
+                                        std::string& data)
+{
+    const std::uint8_t* bytes =
+        reinterpret_cast<const std::uint8_t*>(data.data());
+
+    if (utf8 && utf8_valid_prefix(bytes, data.size()) == data.size())
+        return new (context) M_StdUnicodeObject(std::move(data));
+
+    ObjSpace* space = context->get_space();
+    return new (context) M_StdUnicodeObject(
+        decode_bytes(space, bytes, data.size(), codec, errors));
+}
+
+M_BaseObject* M_TextIOWrapper::__next__(ThreadContext* context,
+                                        M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_TextIOWrapper* as_tio = static_cast<M_TextIOWrapper*>(self);
+    as_tio->check_initialized(context);
+
+    std::string line;
+    as_tio->read_text(context, line, NO_LIMIT, true);
+    if (line.empty())
+        throw InterpError(space->StopIteration_type(), space->wrap_None());
+
+    return as_tio->make_str(context, line);
+}
+
+M_BaseObject* M_TextIOWrapper::read(ThreadContext* context,
+                                    const Arguments& args)
+{
+    static Signature read_signature({"self", "size"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("read", nullptr, read_signature, scope,
+               {space->wrap_int(context, -1)});
+    M_TextIOWrapper* as_tio = static_cast<M_TextIOWrapper*>(scope[0]);
+    as_tio->check_initialized(context);
+    int size = space->i_is(scope[1], space->wrap_None())
+                   ? -1
+                   : space->unwrap_int(scope[1]);
+
+    std::string text;
+    if (size < 0)
+        as_tio->read_all(context, text);
+    else
+        as_tio->read_text(context, text, size, false);
+
+    return as_tio->make_str(context, text);
+}
+
+M_BaseObject* M_TextIOWrapper::readline(ThreadContext* context,
+                                        const Arguments& args)
+{
+    static Signature readline_signature({"self", "size"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("readline", nullptr, readline_signature, scope,
+               {space->wrap_int(context, -1)});
+    M_TextIOWrapper* as_tio = static_cast<M_TextIOWrapper*>(scope[0]);
+    as_tio->check_initialized(context);
+    int size = space->i_is(scope[1], space->wrap_None())
+                   ? -1
+                   : space->unwrap_int(scope[1]);
+
+    std::string line;
+    as_tio->read_text(context, line, size < 0 ? NO_LIMIT : size, true);
+
+    return as_tio->make_str(context, line);
+}
+
+M_BaseObject* M_TextIOWrapper::write(ThreadContext* context, M_BaseObject* self,
+                                     M_BaseObject* text)
+{
+    ObjSpace* space = context->get_space();
+    M_TextIOWrapper* as_tio = static_cast<M_TextIOWrapper*>(self);
+    as_tio->check_initialized(context);
+
+    M_StdUnicodeObject* as_str = dynamic_cast<M_StdUnicodeObject*>(text);
+    if (!as_str) {
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "write() argument must be str, not %s",
+                                  space->get_type_name(text).c_str());
+    }
+
+    const std::string& value = as_str->get_value();
+    bool has_newline = value.find('\n') != std::string::npos;
+    const std::string* data = &value;
+
+    std::string translated;
+    if (as_tio->write_newline && has_newline) {
+        translated.reserve(value.size() + value.size() / 8);
+        for (char c : value) {
+            if (c == '\n')
+                translated += as_tio->write_newline;
+            else
+                translated += c;
+        }
+        data = &translated;
+    }
+
+    std::string encoded;
+    if (!as_tio->utf8) {
+        encoded = encode_str(space, *data, as_tio->codec, as_tio->errors);
+        data = &encoded;
+    }
+
+    if (as_tio->writer) {
+        as_tio->writer->write_data(
+            context, reinterpret_cast<const std::uint8_t*>(data->data()),
+            data->size());
+    } else {
+        space->call_function(
+            context, space->getattr_str(as_tio->buffer, "write"),
+            {space->new_bytes(context, data->data(), data->size())});
+    }
+
+    if (as_tio->line_buffering && has_newline) flush(context, self);
+
+    return space->wrap_int(context, (int)as_str->char_length());
+}
+
+M_BaseObject* M_TextIOWrapper::flush(ThreadContext* context, M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_TextIOWrapper* as_tio = static_cast<M_TextIOWrapper*>(self);
+    as_tio->check_initialized(context);
+
+    M_BaseObject* flush = space->findattr_str(as_tio->buffer, "flush");
+    if (flush) space->call_function(context, flush, {});
+
+    return nullptr;
+}
+
+M_BaseObject* M_TextIOWrapper::close(ThreadContext* context, M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_TextIOWrapper* as_tio = static_cast<M_TextIOWrapper*>(self);
+    as_tio->check_initialized(context);
+
+    if (space->is_true(space->getattr_str(as_tio->buffer, "closed")))
+        return nullptr;
+
+    return space->call_function(
+        context, space->getattr_str(as_tio->buffer, "close"), {});
+}
+
+M_BaseObject* M_TextIOWrapper::readable(ThreadContext* context,
+                                        M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_TextIOWrapper* as_tio = static_cast<M_TextIOWrapper*>(self);
+    return space->call_function(
+        context, space->getattr_str(as_tio->buffer, "readable"), {});
+}
+
+M_BaseObject* M_TextIOWrapper::writable(ThreadContext* context,
+                                        M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_TextIOWrapper* as_tio = static_cast<M_TextIOWrapper*>(self);
+    return space->call_function(
+        context, space->getattr_str(as_tio->buffer, "writable"), {});
+}
+
+M_BaseObject* M_TextIOWrapper::fileno(ThreadContext* context,
+                                      M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_TextIOWrapper* as_tio = static_cast<M_TextIOWrapper*>(self);
+    return space->call_function(
+        context, space->getattr_str(as_tio->buffer, "fileno"), {});
+}
+
 M_BaseObject* M_TextIOWrapper::__repr__(mtpython::vm::ThreadContext* context,
                                         M_BaseObject* self)
 {
@@ -83,3 +546,17 @@ M_BaseObject* M_TextIOWrapper::buffer_get(mtpython::vm::ThreadContext* context,
     M_TextIOWrapper* as_tio = static_cast<M_TextIOWrapper*>(self);
     return as_tio->buffer;
 }
+
+M_BaseObject* M_TextIOWrapper::encoding_get(ThreadContext* context,
+                                            M_BaseObject* self)
+{
+    M_TextIOWrapper* as_tio = static_cast<M_TextIOWrapper*>(self);
+    return as_tio->encoding;
+}
+
+M_BaseObject* M_TextIOWrapper::closed_get(ThreadContext* context,
+                                          M_BaseObject* self)
+{
+    M_TextIOWrapper* as_tio = static_cast<M_TextIOWrapper*>(self);
+    return context->get_space()->getattr_str(as_tio->buffer, "closed");
+}
@@ -0,0 +1,419 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "modules/_json/encoder.h"
+#include "modules/_json/bytescan.h"
+#include "modules/_json/jsonmodule.h"
+#include "objects/std/dict_object.h"
+#include "objects/std/float_object.h"
+#include "objects/std/int_object.h"
+#include "objects/std/list_object.h"
+#include "objects/std/tuple_object.h"
+#include "objects/std/unicode_object.h"
+#include "interpreter/typedef.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+namespace mtpython {
+namespace modules {
+
+#define M_JSONENCODER(obj) (static_cast<M_JSONEncoder*>(obj))
+
+static const int max_nesting_depth = 1000;
+
+/* Code point of the UTF-8 sequence at p. Bytes that don't start a valid
+ * sequence are taken as one character each */
+static const char* decode_utf8(const char* p, const char* end,
+                               std::uint32_t& cp)
+{
+    unsigned char lead = *p;
+    int n = lead >= 0xf0 ? 3 : lead >= 0xe0 ? 2 : 1;
+
+    cp = lead;
+    if (lead < 0xc0 || lead >= 0xf8 || end - p <= n) return p + 1;
+
+    std::uint32_t value = lead & (0x7f >> (n + 1));
+    for (int i = 1; i <= n; i++) {
+        unsigned char c = p[i];
+        if ((c & 0xc0) != 0x80) return p + 1;
+        value = (value << 6) | (c & 0x3f);
+    }
+
+    cp = value;
+    return p + n + 1;
+}
+
+static void append_u_escape(std::string& out, std::uint32_t cp)
+{
+    static const char hex_digits[] = "0123456789abcdef";
+
+    if (cp >= 0x10000) {
+        cp -= 0x10000;
+        append_u_escape(out, 0xd800 | (cp >> 10));
+        append_u_escape(out, 0xdc00 | (cp & 0x3ff));
+        return;
+    }
+
+    out += "\\u";
+    out.push_back(hex_digits[(cp >> 12) & 0xf]);
+    out.push_back(hex_digits[(cp >> 8) & 0xf]);
+    out.push_back(hex_digits[(cp >> 4) & 0xf]);
+    out.push_back(hex_digits[cp & 0xf]);
+}
+
+void encode_json_string(const std::string& s, bool ascii_only,
+                        std::string& out)
+{
+    const char* p = s.data();
+    const char* end = p + s.size();
+
+    out.reserve(out.size() + s.size() + 2);
+    out.push_back('"');
+
+    for (;;) {
+        const char* run = find_string_special(p, end, ascii_only);
+        out.append(p, run);
+        if (run == end) break;
+
+        unsigned char c = *run;
+        p = run + 1;
+        switch (c) {
+        case '"':
+            out += "\\\"";
+            continue;
+        case '\\':
+            out += "\\\\";
+            continue;
+        case '\b':
+            out += "\\b";
+            continue;
+        case '\f':
+            out += "\\f";
+            continue;
+        case '\n':
+            out += "\\n";
+            continue;
+        case '\r':
+            out += "\\r";
+            continue;
+        case '\t':
+            out += "\\t";
+            continue;
+        }
+
+        std::uint32_t cp = c;
+        if (c >= 0x80) p = decode_utf8(run, end, cp);
+        append_u_escape(out, cp);
+    }
+
+    out.push_back('"');
+}
+
+/* State of one encoder call. Containers being encoded are tracked in a
+ * native set instead of the markers dict, which only tells whether to check
+ * for cycles at all */
+class JSONEncodeState {
+private:
+    enum EscapeMode { ESCAPE_CALL, ESCAPE_ASCII, ESCAPE_UNICODE };
+
+    ThreadContext* context;
+    ObjSpace* space;
+    M_JSONEncoder* encoder;
+    std::string out;
+    std::string key_separator;
+    std::string item_separator;
+    EscapeMode escape_mode;
+    bool check_circular;
+    std::unordered_set<M_BaseObject*> active;
+    int depth;
+
+    void enter(M_BaseObject* obj)
+    {
+        if (++depth > max_nesting_depth) {
+            throw InterpError(space->RuntimeError_type(),
+                              space->wrap_str(context,
+                                              "maximum recursion depth "
+                                              "exceeded while encoding a "
+                                              "JSON object"));
+        }
+
+        if (check_circular && !active.insert(obj).second) {
+            throw InterpError(
+                space->ValueError_type(),
+                space->wrap_str(context, "Circular reference detected"));
+        }
+    }
+
+    void leave(M_BaseObject* obj)
+    {
+        depth--;
+        if (check_circular) active.erase(obj);
+    }
+
+    void encode_string(M_BaseObject* str)
+    {
+        const std::string& value = M_STDUNICODEOBJECT(str)->get_value();
+
+        switch (escape_mode) {
+        case ESCAPE_ASCII:
+            encode_json_string(value, true, out);
+            return;
+        case ESCAPE_UNICODE:
+            encode_json_string(value, false, out);
+            return;
+        default:
+            break;
+        }
+
+        M_BaseObject* encoded =
+            space->call_function(context, encoder->encoder, {str});
+        if (!dynamic_cast<M_StdUnicodeObject*>(encoded)) {
+            throw InterpError::format(space, space->TypeError_type(),
+                                      "encoder() must return a string, not %s",
+                                      space->get_type_name(encoded).c_str());
+        }
+        out += M_STDUNICODEOBJECT(encoded)->get_value();
+    }
+
+    void encode_float(double x)
+    {
+        if (std::isfinite(x)) {
+            out += M_StdFloatObject::format_repr(x);
+            return;
+        }
+
+        if (!encoder->allow_nan) {
+            throw InterpError(
+                space->ValueError_type(),
+                space->wrap_str(context, "Out of range float values are not "
+                                         "JSON compliant"));
+        }
+
+        if (std::isnan(x))
+            out += "NaN";
+        else
+            out += x > 0 ? "Infinity" : "-Infinity";
+    }
+
+    void encode_items(M_BaseObject* seq)
+    {
+        /* The list is read again on every step, default() may change it */
+        M_StdListObject* list = dynamic_cast<M_StdListObject*>(seq);
+        M_StdTupleObject* tuple = static_cast<M_StdTupleObject*>(seq);
+        std::size_t size = list ? list->size() : tuple->size();
+
+        if (size == 0) {
+            out += "[]";
+            return;
+        }
+
+        enter(seq);
+        out.push_back('[');
+        for (std::size_t i = 0; i < (list ? list->size() : tuple->size());
+             i++) {
+            if (i) out += item_separator;
+            encode(list ? list->begin()[i] : (*tuple)[i]);
+        }
+        out.push_back(']');
+        leave(seq);
+    }
+
+    /* Append key as a JSON string. Returns false for keys that skipkeys
+     * leaves out */
+    bool encode_key(M_BaseObject* key)
+    {
+        if (dynamic_cast<M_StdUnicodeObject*>(key)) {
+            encode_string(key);
+            return true;
+        }
+
+        std::string text;
+        if (M_StdFloatObject* f = dynamic_cast<M_StdFloatObject*>(key)) {
+            std::swap(out, text);
+            encode_float(f->get_value());
+            std::swap(out, text);
+        } else if (key == space->wrap_True()) {
+            text = "true";
+        } else if (key == space->wrap_False()) {
+            text = "false";
+        } else if (key == space->wrap_None()) {
+            text = "null";
+        } else if (M_StdIntObject* i = dynamic_cast<M_StdIntObject*>(key)) {
+            text = std::to_string(i->get_value());
+        } else if (encoder->skipkeys) {
+            return false;
+        } else {
+            throw InterpError::format(space, space->TypeError_type(),
+                                      "keys must be str, int, float, bool or "
+                                      "None, not %s",
+                                      space->get_type_name(key).c_str());
+        }
+
+        if (escape_mode == ESCAPE_CALL)
+            encode_string(space->wrap_str(context, text));
+        else
+            encode_json_string(text, escape_mode == ESCAPE_ASCII, out);
+        return true;
+    }
+
+    void encode_dict(M_StdDictObject* dict)
+    {
+        if (dict->size() == 0) {
+            out += "{}";
+            return;
+        }
+
+        std::vector<std::pair<M_BaseObject*, M_BaseObject*>> items;
+        items.reserve(dict->size());
+        std::size_t pos = 0;
+        M_BaseObject* key;
+        M_BaseObject* value;
+        while (dict->next_entry(pos, key, value))
+            items.emplace_back(key, value);
+
+        if (encoder->sort_keys) {
+            std::stable_sort(items.begin(), items.end(),
+                             [this](const auto& lhs, const auto& rhs) {
+                                 return space->i_lt(lhs.first, rhs.first);
+                             });
+        }
+
+        enter(dict);
+        out.push_back('{');
+        bool first = true;
+        for (const auto& item : items) {
+            std::size_t mark = out.size();
+            if (!first) out += item_separator;
+            if (!encode_key(item.first)) {
+                out.resize(mark);
+                continue;
+            }
+            first = false;
+            out += key_separator;
+            encode(item.second);
+        }
+        out.push_back('}');
+        leave(dict);
+    }
+
+public:
+    JSONEncodeState(ThreadContext* context, M_JSONEncoder* encoder)
+        : context(context), space(context->get_space()), encoder(encoder),
+          depth(0)
+    {
+        key_separator = space->unwrap_str(encoder->key_separator);
+        item_separator = space->unwrap_str(encoder->item_separator);
+
+        if (encoder->encoder == JsonModule::get_ascii_escaper())
+            escape_mode = ESCAPE_ASCII;
+        else if (encoder->encoder == JsonModule::get_unicode_escaper())
+            escape_mode = ESCAPE_UNICODE;
+        else
+            escape_mode = ESCAPE_CALL;
+
+        check_circular = encoder->markers != space->wrap_None();
+    }
+
+    std::string& get_output() { return out; }
+
+    void encode(M_BaseObject* obj)
+    {
+        if (obj == space->wrap_None()) {
+            out += "null";
+        } else if (obj == space->wrap_True()) {
+            out += "true";
+        } else if (obj == space->wrap_False()) {
+            out += "false";
+        } else if (dynamic_cast<M_StdUnicodeObject*>(obj)) {
+            encode_string(obj);
+        } else if (M_StdIntObject* i = dynamic_cast<M_StdIntObject*>(obj)) {
+            out += std::to_string(i->get_value());
+        } else if (M_StdFloatObject* f = dynamic_cast<M_StdFloatObject*>(obj)) {
+            encode_float(f->get_value());
+        } else if (dynamic_cast<M_StdListObject*>(obj) ||
+                   dynamic_cast<M_StdTupleObject*>(obj)) {
+            encode_items(obj);
+        } else if (M_StdDictObject* d = dynamic_cast<M_StdDictObject*>(obj)) {
+            encode_dict(d);
+        } else {
+            enter(obj);
+            encode(space->call_function(context, encoder->default_fn, {obj}));
+            leave(obj);
+        }
+    }
+};
+
+M_BaseObject* M_JSONEncoder::__new__(ThreadContext* context,
+                                     const Arguments& args)
+{
+    static Signature new_signature(
+        {"type", "markers", "default", "encoder", "indent", "key_separator",
+         "item_separator", "sort_keys", "skipkeys", "allow_nan"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("make_encoder", nullptr, new_signature, scope);
+
+    M_BaseObject* markers = scope[1];
+    if (markers != space->wrap_None() &&
+        !dynamic_cast<M_StdDictObject*>(markers)) {
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "make_encoder() argument 1 must be dict or "
+                                  "None, not %s",
+                                  space->get_type_name(markers).c_str());
+    }
+
+    for (int i = 5; i <= 6; i++) {
+        if (!dynamic_cast<M_StdUnicodeObject*>(scope[i])) {
+            throw InterpError::format(
+                space, space->TypeError_type(),
+                "make_encoder() argument %d must be str, not %s", i,
+                space->get_type_name(scope[i]).c_str());
+        }
+    }
+
+    return new (context) M_JSONEncoder(
+        markers, scope[2], scope[3], scope[4], scope[5], scope[6],
+        space->is_true(scope[7]), space->is_true(scope[8]),
+        space->is_true(scope[9]));
+}
+
+M_BaseObject* M_JSONEncoder::__call__(ThreadContext* context,
+                                      M_BaseObject* self, M_BaseObject* obj,
+                                      M_BaseObject* indent_level)
+{
+    ObjSpace* space = context->get_space();
+    JSONEncodeState state(context, M_JSONENCODER(self));
+
+    state.encode(obj);
+    return space->new_tuple(
+        context,
+        {new (context) M_StdUnicodeObject(std::move(state.get_output()))});
+}
+
+Typedef* M_JSONEncoder::_encoder_typedef()
+{
+    static Typedef encoder_typedef(
+        "Encoder", {
+                       {"__new__", new InterpFunctionWrapper(
+                                       "__new__", M_JSONEncoder::__new__)},
+                       {"__call__", new InterpFunctionWrapper(
+                                        "__call__", M_JSONEncoder::__call__)},
+                   });
+
+    return &encoder_typedef;
+}
+
+Typedef* M_JSONEncoder::get_typedef() { return _encoder_typedef(); }
+
+} // namespace modules
+} // namespace mtpython
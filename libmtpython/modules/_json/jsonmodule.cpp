@@ -0,0 +1,103 @@
+#include <string>
+#include <vector>
+
+#include "modules/_json/jsonmodule.h"
+#include "modules/_json/encoder.h"
+#include "modules/_json/scanner.h"
+#include "objects/std/unicode_object.h"
+#include "interpreter/arguments.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+namespace mtpython {
+namespace modules {
+
+M_BaseObject* JsonModule::ascii_escaper = nullptr;
+M_BaseObject* JsonModule::unicode_escaper = nullptr;
+
+static M_StdUnicodeObject* string_arg(ThreadContext* context, M_BaseObject* s)
+{
+    M_StdUnicodeObject* str = dynamic_cast<M_StdUnicodeObject*>(s);
+
+    if (!str) {
+        ObjSpace* space = context->get_space();
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "first argument must be a string, not %s",
+                                  space->get_type_name(s).c_str());
+    }
+
+    return str;
+}
+
+static M_BaseObject* json_scanstring(ThreadContext* context,
+                                     const Arguments& args)
+{
+    static Signature scanstring_signature({"s", "end", "strict"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("scanstring", nullptr, scanstring_signature, scope,
+               {space->new_bool(true)});
+    M_StdUnicodeObject* doc = string_arg(context, scope[0]);
+
+    int end = space->i_get_index(scope[1], space->TypeError_type(), nullptr);
+    if (end < 0 || (std::size_t)end > doc->char_length()) {
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "end is out of bounds"));
+    }
+
+    std::string value;
+    std::size_t pos = decode_json_string(context, doc, doc->byte_offset(end),
+                                         space->is_true(scope[2]), value);
+
+    return space->new_tuple(
+        context, {new (context) M_StdUnicodeObject(std::move(value)),
+                  space->wrap_int(context, (int)doc->char_index(pos))});
+}
+
+static M_BaseObject* json_encode_basestring_ascii(ThreadContext* context,
+                                                  M_BaseObject* s)
+{
+    std::string out;
+    encode_json_string(string_arg(context, s)->get_value(), true, out);
+    return new (context) M_StdUnicodeObject(std::move(out));
+}
+
+static M_BaseObject* json_encode_basestring(ThreadContext* context,
+                                            M_BaseObject* s)
+{
+    std::string out;
+    encode_json_string(string_arg(context, s)->get_value(), false, out);
+    return new (context) M_StdUnicodeObject(std::move(out));
+}
+
+JsonModule::JsonModule(ObjSpace* space, M_BaseObject* name)
+    : BuiltinModule(space, name)
+{
+    ThreadContext* context = ThreadContext::current_thread();
+
+    add_def("__doc__", space->wrap_str(context, "json speedups"));
+    add_def("scanstring",
+            new InterpFunctionWrapper("scanstring", json_scanstring));
+    add_def("encode_basestring_ascii",
+            new InterpFunctionWrapper("encode_basestring_ascii",
+                                      json_encode_basestring_ascii));
+    add_def("encode_basestring",
+            new InterpFunctionWrapper("encode_basestring",
+                                      json_encode_basestring));
+    add_def("make_scanner",
+            space->get_typeobject(M_JSONScanner::_scanner_typedef()));
+    add_def("make_encoder",
+            space->get_typeobject(M_JSONEncoder::_encoder_typedef()));
+
+    /* Encoders built with these escape strings without calling them */
+    ascii_escaper = get("encode_basestring_ascii");
+    unicode_escaper = get("encode_basestring");
+}
+
+} // namespace modules
+} // namespace mtpython
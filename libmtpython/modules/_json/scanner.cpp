@@ -0,0 +1,520 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+#include "modules/_json/scanner.h"
+#include "modules/_json/bytescan.h"
+#include "objects/std/dict_object.h"
+#include "objects/std/list_object.h"
+#include "interpreter/typedef.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+namespace mtpython {
+namespace modules {
+
+#define M_JSONSCANNER(obj) (static_cast<M_JSONScanner*>(obj))
+
+/* Objects and arrays are parsed recursively, so deeply nested documents
+ * are refused before they can exhaust the native stack */
+static const int max_nesting_depth = 1000;
+
+InterpError json_error(ThreadContext* context, M_StdUnicodeObject* doc,
+                       const char* msg, std::size_t pos)
+{
+    ObjSpace* space = context->get_space();
+    const std::string& s = doc->get_value();
+    std::size_t char_pos = doc->char_index(pos);
+    int lineno = 1 + (int)std::count(s.begin(), s.begin() + pos, '\n');
+    std::size_t colno;
+
+    if (lineno == 1)
+        colno = char_pos + 1;
+    else
+        colno = char_pos - doc->char_index(s.rfind('\n', pos - 1));
+
+    return InterpError::format(space, space->ValueError_type(),
+                               "%s: line %d column %d (char %d)", msg, lineno,
+                               (int)colno, (int)char_pos);
+}
+
+static int read_hex4(const char* p, const char* end)
+{
+    if (end - p < 4) return -1;
+
+    int value = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = p[i];
+        int digit;
+        if (c >= '0' && c <= '9')
+            digit = c - '0';
+        else if (c >= 'a' && c <= 'f')
+            digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            digit = c - 'A' + 10;
+        else
+            return -1;
+        value = (value << 4) | digit;
+    }
+
+    return value;
+}
+
+/* Lone surrogates are kept as three-byte sequences, as str does for any
+ * other string holding them */
+static void append_utf8(std::string& out, int cp)
+{
+    if (cp < 0x80) {
+        out.push_back((char)cp);
+    } else if (cp < 0x800) {
+        out.push_back((char)(0xc0 | (cp >> 6)));
+        out.push_back((char)(0x80 | (cp & 0x3f)));
+    } else if (cp < 0x10000) {
+        out.push_back((char)(0xe0 | (cp >> 12)));
+        out.push_back((char)(0x80 | ((cp >> 6) & 0x3f)));
+        out.push_back((char)(0x80 | (cp & 0x3f)));
+    } else {
+        out.push_back((char)(0xf0 | (cp >> 18)));
+        out.push_back((char)(0x80 | ((cp >> 12) & 0x3f)));
+        out.push_back((char)(0x80 | ((cp >> 6) & 0x3f)));
+        out.push_back((char)(0x80 | (cp & 0x3f)));
+    }
+}
+
+std::size_t decode_json_string(ThreadContext* context, M_StdUnicodeObject* doc,
+                               std::size_t begin, bool strict,
+                               std::string& out)
+{
+    const std::string& s = doc->get_value();
+    const char* base = s.data();
+    const char* end = base + s.size();
+    const char* p = base + begin;
+
+    for (;;) {
+        const char* run = find_string_special(p, end, false);
+        out.append(p, run);
+
+        if (run == end) {
+            throw json_error(context, doc, "Unterminated string starting at",
+                             begin - 1);
+        }
+
+        char c = *run;
+        if (c == '"') return run + 1 - base;
+
+        if (c != '\\') {
+            if (strict) {
+                throw json_error(context, doc, "Invalid control character at",
+                                 run - base);
+            }
+            out.push_back(c);
+            p = run + 1;
+            continue;
+        }
+
+        if (run + 1 == end) {
+            throw json_error(context, doc, "Unterminated string starting at",
+                             begin - 1);
+        }
+
+        p = run + 2;
+        switch (run[1]) {
+        case '"':
+        case '\\':
+        case '/':
+            out.push_back(run[1]);
+            break;
+        case 'b':
+            out.push_back('\b');
+            break;
+        case 'f':
+            out.push_back('\f');
+            break;
+        case 'n':
+            out.push_back('\n');
+            break;
+        case 'r':
+            out.push_back('\r');
+            break;
+        case 't':
+            out.push_back('\t');
+            break;
+        case 'u': {
+            int cp = read_hex4(p, end);
+            if (cp < 0) {
+                throw json_error(context, doc, "Invalid \\uXXXX escape",
+                                 run - base);
+            }
+            p += 4;
+
+            /* A high surrogate followed by an escaped low surrogate is one
+             * character outside the BMP */
+            if (cp >= 0xd800 && cp <= 0xdbff && end - p >= 6 && p[0] == '\\' &&
+                p[1] == 'u') {
+                int low = read_hex4(p + 2, end);
+                if (low >= 0xdc00 && low <= 0xdfff) {
+                    cp = 0x10000 + ((cp - 0xd800) << 10) + (low - 0xdc00);
+                    p += 6;
+                }
+            }
+
+            append_utf8(out, cp);
+            break;
+        }
+        default:
+            throw json_error(context, doc, "Invalid \\escape", run - base);
+        }
+    }
+}
+
+/* State of one scan_once() call. Byte offsets are used throughout and only
+ * converted to character indices at the edges */
+class JSONDecodeState {
+private:
+    ThreadContext* context;
+    ObjSpace* space;
+    M_JSONScanner* scanner;
+    M_StdUnicodeObject* doc;
+    const char* base;
+    std::size_t size;
+    int depth;
+
+    M_BaseObject* none;
+    M_BaseObject* float_type;
+    M_BaseObject* int_type;
+
+    /* Keys seen so far, so that the same key in many objects is one str */
+    std::unordered_map<std::string, M_BaseObject*> memo;
+    std::string buf;
+
+    std::size_t skip_whitespace(std::size_t pos) const
+    {
+        return skip_json_whitespace(base + pos, base + size) - base;
+    }
+
+    bool match(std::size_t pos, const char* literal, std::size_t len) const
+    {
+        return size - pos >= len && !std::memcmp(base + pos, literal, len);
+    }
+
+    M_BaseObject* call(M_BaseObject* func, M_BaseObject* arg)
+    {
+        return space->call_function(context, func, {arg});
+    }
+
+    M_BaseObject* expect_value(std::size_t& pos)
+    {
+        M_BaseObject* value = scan_value(pos);
+        if (!value) throw json_error(context, doc, "Expecting value", pos);
+        return value;
+    }
+
+    void enter(const char* what)
+    {
+        if (++depth > max_nesting_depth) {
+            throw InterpError::format(
+                space, space->RuntimeError_type(),
+                "maximum recursion depth exceeded while decoding a JSON %s",
+                what);
+        }
+    }
+
+    M_BaseObject* parse_string(std::size_t& pos)
+    {
+        buf.clear();
+        pos = decode_json_string(context, doc, pos, scanner->strict, buf);
+        return new (context) M_StdUnicodeObject(buf);
+    }
+
+    M_BaseObject* parse_key(std::size_t& pos)
+    {
+        buf.clear();
+        pos = decode_json_string(context, doc, pos, scanner->strict, buf);
+
+        auto found = memo.find(buf);
+        if (found != memo.end()) return found->second;
+
+        M_BaseObject* key = new (context) M_StdUnicodeObject(buf);
+        memo.emplace(buf, key);
+        return key;
+    }
+
+    M_BaseObject* parse_number(std::size_t& pos)
+    {
+        const char* start = base + pos;
+        const char* end = base + size;
+        const char* p = start;
+
+        if (p < end && *p == '-') p++;
+        if (p < end && *p >= '1' && *p <= '9') {
+            while (p < end && *p >= '0' && *p <= '9')
+                p++;
+        } else if (p < end && *p == '0') {
+            p++;
+        } else {
+            return nullptr;
+        }
+
+        bool is_float = false;
+        if (end - p >= 2 && *p == '.' && p[1] >= '0' && p[1] <= '9') {
+            p += 2;
+            while (p < end && *p >= '0' && *p <= '9')
+                p++;
+            is_float = true;
+        }
+
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            const char* exp = p++;
+            if (p < end && (*p == '-' || *p == '+')) p++;
+            const char* digits = p;
+            while (p < end && *p >= '0' && *p <= '9')
+                p++;
+            if (p == digits)
+                p = exp;
+            else
+                is_float = true;
+        }
+
+        std::string number(start, p);
+        pos = p - base;
+
+        if (is_float) {
+            if (scanner->parse_float == float_type)
+                return space->wrap_float(context,
+                                         std::strtod(number.c_str(), nullptr));
+            return call(scanner->parse_float, space->wrap_str(context, number));
+        }
+
+        if (scanner->parse_int == int_type && number.size() <= 11) {
+            long long value = std::strtoll(number.c_str(), nullptr, 10);
+            if (value >= INT32_MIN && value <= INT32_MAX)
+                return space->wrap_int(context, (int)value);
+        }
+        return call(scanner->parse_int, space->wrap_str(context, number));
+    }
+
+    M_BaseObject* parse_object(std::size_t& pos)
+    {
+        bool use_pairs = scanner->object_pairs_hook != none;
+        M_StdListObject* pairs = nullptr;
+        M_StdDictObject* dict = nullptr;
+
+        enter("object");
+        if (use_pairs)
+            pairs = new (context) M_StdListObject();
+        else
+            dict = new (context) M_StdDictObject(space);
+
+        pos = skip_whitespace(pos);
+        if (pos >= size || base[pos] != '}') {
+            for (;;) {
+                if (pos >= size || base[pos] != '"') {
+                    throw json_error(
+                        context, doc,
+                        "Expecting property name enclosed in double quotes",
+                        pos);
+                }
+                pos++;
+                M_BaseObject* key = parse_key(pos);
+
+                pos = skip_whitespace(pos);
+                if (pos >= size || base[pos] != ':') {
+                    throw json_error(context, doc, "Expecting ':' delimiter",
+                                     pos);
+                }
+                pos = skip_whitespace(pos + 1);
+                M_BaseObject* value = expect_value(pos);
+
+                if (use_pairs)
+                    pairs->push_back(context,
+                                     space->new_tuple(context, {key, value}));
+                else
+                    dict->setitem(key, value);
+
+                pos = skip_whitespace(pos);
+                if (pos < size && base[pos] == '}') break;
+                if (pos >= size || base[pos] != ',') {
+                    throw json_error(context, doc, "Expecting ',' delimiter",
+                                     pos);
+                }
+                pos = skip_whitespace(pos + 1);
+            }
+        }
+        pos++;
+        depth--;
+
+        if (use_pairs) return call(scanner->object_pairs_hook, pairs);
+        if (scanner->object_hook != none)
+            return call(scanner->object_hook, dict);
+        return dict;
+    }
+
+    M_BaseObject* parse_array(std::size_t& pos)
+    {
+        M_StdListObject* list = new (context) M_StdListObject();
+
+        enter("array");
+        pos = skip_whitespace(pos);
+        if (pos >= size || base[pos] != ']') {
+            for (;;) {
+                list->push_back(context, expect_value(pos));
+
+                pos = skip_whitespace(pos);
+                if (pos < size && base[pos] == ']') break;
+                if (pos >= size || base[pos] != ',') {
+                    throw json_error(context, doc, "Expecting ',' delimiter",
+                                     pos);
+                }
+                pos = skip_whitespace(pos + 1);
+            }
+        }
+        pos++;
+        depth--;
+
+        return list;
+    }
+
+public:
+    JSONDecodeState(ThreadContext* context, M_JSONScanner* scanner,
+                    M_StdUnicodeObject* doc)
+        : context(context), space(context->get_space()), scanner(scanner),
+          doc(doc), base(doc->get_value().data()),
+          size(doc->get_value().size()), depth(0)
+    {
+        none = space->wrap_None();
+        float_type = space->get_type_by_name("float");
+        int_type = space->get_type_by_name("int");
+    }
+
+    /* Value starting at byte offset pos, which is moved past it. Returns
+     * nullptr if no value starts at pos */
+    M_BaseObject* scan_value(std::size_t& pos)
+    {
+        if (pos >= size) return nullptr;
+
+        switch (base[pos]) {
+        case '"':
+            pos++;
+            return parse_string(pos);
+        case '{':
+            pos++;
+            return parse_object(pos);
+        case '[':
+            pos++;
+            return parse_array(pos);
+        case 'n':
+            if (match(pos, "null", 4)) {
+                pos += 4;
+                return none;
+            }
+            break;
+        case 't':
+            if (match(pos, "true", 4)) {
+                pos += 4;
+                return space->wrap_True();
+            }
+            break;
+        case 'f':
+            if (match(pos, "false", 5)) {
+                pos += 5;
+                return space->wrap_False();
+            }
+            break;
+        case 'N':
+            if (match(pos, "NaN", 3)) {
+                pos += 3;
+                return call(scanner->parse_constant,
+                            space->wrap_str(context, "NaN"));
+            }
+            break;
+        case 'I':
+            if (match(pos, "Infinity", 8)) {
+                pos += 8;
+                return call(scanner->parse_constant,
+                            space->wrap_str(context, "Infinity"));
+            }
+            break;
+        case '-':
+            if (match(pos, "-Infinity", 9)) {
+                pos += 9;
+                return call(scanner->parse_constant,
+                            space->wrap_str(context, "-Infinity"));
+            }
+            break;
+        }
+
+        return parse_number(pos);
+    }
+};
+
+M_BaseObject* M_JSONScanner::__new__(ThreadContext* context, M_BaseObject* type,
+                                     M_BaseObject* ctx)
+{
+    ObjSpace* space = context->get_space();
+
+    return new (context)
+        M_JSONScanner(space->is_true(space->getattr_str(ctx, "strict")),
+                      space->getattr_str(ctx, "object_hook"),
+                      space->getattr_str(ctx, "object_pairs_hook"),
+                      space->getattr_str(ctx, "parse_float"),
+                      space->getattr_str(ctx, "parse_int"),
+                      space->getattr_str(ctx, "parse_constant"));
+}
+
+M_BaseObject* M_JSONScanner::__call__(ThreadContext* context,
+                                      M_BaseObject* self, M_BaseObject* string,
+                                      M_BaseObject* idx)
+{
+    ObjSpace* space = context->get_space();
+    M_StdUnicodeObject* doc = dynamic_cast<M_StdUnicodeObject*>(string);
+
+    if (!doc) {
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "first argument must be a string, not %s",
+                                  space->get_type_name(string).c_str());
+    }
+
+    int index = space->i_get_index(idx, space->TypeError_type(), nullptr);
+    if (index < 0) {
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "idx cannot be negative"));
+    }
+
+    M_BaseObject* value = nullptr;
+    std::size_t pos = 0;
+    if ((std::size_t)index < doc->char_length()) {
+        JSONDecodeState state(context, M_JSONSCANNER(self), doc);
+        pos = doc->byte_offset(index);
+        value = state.scan_value(pos);
+    }
+
+    /* json.decoder turns this into "Expecting value" at idx */
+    if (!value) throw InterpError(space->StopIteration_type(), idx);
+
+    return space->new_tuple(
+        context, {value, space->wrap_int(context, (int)doc->char_index(pos))});
+}
+
+Typedef* M_JSONScanner::_scanner_typedef()
+{
+    static Typedef scanner_typedef(
+        "Scanner", {
+                       {"__new__", new InterpFunctionWrapper(
+                                       "__new__", M_JSONScanner::__new__)},
+                       {"__call__", new InterpFunctionWrapper(
+                                        "__call__", M_JSONScanner::__call__)},
+                   });
+
+    return &scanner_typedef;
+}
+
+Typedef* M_JSONScanner::get_typedef() { return _scanner_typedef(); }
+
+} // namespace modules
+} // namespace mtpython
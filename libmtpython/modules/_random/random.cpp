@@ -0,0 +1,399 @@
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include "modules/_random/random.h"
+#include "objects/std/int_object.h"
+#include "objects/std/type_object.h"
+#include "interpreter/typedef.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+
+using namespace mtpython::modules;
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+#define M_RANDOM(obj) (static_cast<M_Random*>(obj))
+
+/* MT19937 parameters */
+#define MT_M 397
+#define MT_MATRIX_A 0x9908b0dfU
+#define MT_UPPER_MASK 0x80000000U
+#define MT_LOWER_MASK 0x7fffffffU
+
+void M_Random::init_genrand(std::uint32_t s)
+{
+    state[0] = s;
+    for (int i = 1; i < N; i++) {
+        state[i] =
+            1812433253U * (state[i - 1] ^ (state[i - 1] >> 30)) + (unsigned)i;
+    }
+    index = N;
+}
+
+void M_Random::init_by_array(const std::uint32_t* key, std::size_t key_length)
+{
+    init_genrand(19650218U);
+
+    std::size_t i = 1, j = 0;
+    for (std::size_t k = std::max((std::size_t)N, key_length); k; k--) {
+        state[i] = (state[i] ^ ((state[i - 1] ^ (state[i - 1] >> 30)) *
+                                1664525U)) +
+                   key[j] + (std::uint32_t)j;
+        i++;
+        j++;
+        if (i >= N) {
+            state[0] = state[N - 1];
+            i = 1;
+        }
+        if (j >= key_length) j = 0;
+    }
+    for (std::size_t k = N - 1; k; k--) {
+        state[i] = (state[i] ^ ((state[i - 1] ^ (state[i - 1] >> 30)) *
+                                1566083941U)) -
+                   (std::uint32_t)i;
+        i++;
+        if (i >= N) {
+            state[0] = state[N - 1];
+            i = 1;
+        }
+    }
+
+    state[0] = 0x80000000U; /* MSB is 1, assuring a non-zero initial state */
+}
+
+std::uint32_t M_Random::genrand_uint32()
+{
+    static const std::uint32_t mag01[2] = {0x0U, MT_MATRIX_A};
+    std::uint32_t y;
+
+    if (index >= N) { /* generate N words at one time */
+        int kk;
+
+        for (kk = 0; kk < N - MT_M; kk++) {
+            y = (state[kk] & MT_UPPER_MASK) | (state[kk + 1] & MT_LOWER_MASK);
+            state[kk] = state[kk + MT_M] ^ (y >> 1) ^ mag01[y & 0x1U];
+        }
+        for (; kk < N - 1; kk++) {
+            y = (state[kk] & MT_UPPER_MASK) | (state[kk + 1] & MT_LOWER_MASK);
+            state[kk] = state[kk + (MT_M - N)] ^ (y >> 1) ^ mag01[y & 0x1U];
+        }
+        y = (state[N - 1] & MT_UPPER_MASK) | (state[0] & MT_LOWER_MASK);
+        state[N - 1] = state[MT_M - 1] ^ (y >> 1) ^ mag01[y & 0x1U];
+
+        index = 0;
+    }
+
+    y = state[index++];
+    y ^= (y >> 11);
+    y ^= (y << 7) & 0x9d2c5680U;
+    y ^= (y << 15) & 0xefc60000U;
+    y ^= (y >> 18);
+
+    return y;
+}
+
+std::uint32_t M_Random::randbelow(std::uint32_t n)
+{
+    if (n <= 1) return 0;
+
+    int k = 32;
+    while (!(n & (1U << (k - 1))))
+        k--;
+
+    std::uint32_t r = genrand_uint32() >> (32 - k);
+    while (r >= n)
+        r = genrand_uint32() >> (32 - k);
+
+    return r;
+}
+
+void M_Random::seed_from(ThreadContext* context, M_BaseObject* arg)
+{
+    ObjSpace* space = context->get_space();
+
+    if (!arg || space->i_is(arg, space->wrap_None())) {
+        std::random_device device;
+        std::uint32_t key[N];
+        for (auto& word : key)
+            word = device();
+        init_by_array(key, N);
+        return;
+    }
+
+    /* the key is the absolute value of an int seed or of the hash of any
+     * other object, ints fit in a single 32-bit word */
+    int n;
+    M_StdIntObject* as_int = dynamic_cast<M_StdIntObject*>(arg);
+    if (as_int)
+        n = as_int->get_value();
+    else
+        n = (int)space->i_hash(arg);
+
+    std::uint32_t key = n < 0 ? 0U - (std::uint32_t)n : (std::uint32_t)n;
+    init_by_array(&key, 1);
+}
+
+/* Items of a population as a vector, so that sampling indexes them
+ * directly */
+static void population_items(ThreadContext* context, M_BaseObject* population,
+                             std::vector<M_BaseObject*>& items)
+{
+    ObjSpace* space = context->get_space();
+
+    M_BaseObject* iterator = space->iter(population);
+    while (M_BaseObject* item = space->next_item(iterator))
+        items.push_back(item);
+}
+
+Typedef* M_Random::_random_typedef()
+{
+    static Typedef random_typedef(
+        "Random",
+        {
+            {"__new__",
+             new InterpFunctionWrapper("__new__", M_Random::__new__)},
+            {"seed", new InterpFunctionWrapper("seed", M_Random::seed)},
+            {"random", new InterpFunctionWrapper("random", M_Random::random)},
+            {"getrandbits",
+             new InterpFunctionWrapper("getrandbits", M_Random::getrandbits)},
+            {"getstate",
+             new InterpFunctionWrapper("getstate", M_Random::getstate)},
+            {"setstate",
+             new InterpFunctionWrapper("setstate", M_Random::setstate)},
+            {"choices",
+             new InterpFunctionWrapper("choices", M_Random::choices)},
+            {"sample", new InterpFunctionWrapper("sample", M_Random::sample)},
+        });
+
+    return &random_typedef;
+}
+
+Typedef* M_Random::get_typedef() { return _random_typedef(); }
+
+M_BaseObject* M_Random::__new__(ThreadContext* context, const Arguments& args)
+{
+    static Signature new_signature({"type"}, "args", "kwargs", {});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("Random", nullptr, new_signature, scope);
+
+    M_StdTypeObject* type = dynamic_cast<M_StdTypeObject*>(scope[0]);
+    if (!type)
+        throw InterpError::format(
+            space, space->TypeError_type(),
+            "Random.__new__(X): X is not a type object (%s)",
+            space->get_type_name(scope[0]).c_str());
+
+    std::vector<M_BaseObject*> seed_args;
+    space->unwrap_tuple(scope[1], seed_args);
+    if (seed_args.size() > 1)
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "Random() requires 0 or 1 "
+                                                   "argument"));
+
+    M_BaseObject* dict = type->has_dict() ? space->new_dict(context) : nullptr;
+    M_Random* random = new (context) M_Random(type, dict);
+    random->seed_from(context, seed_args.empty() ? nullptr : seed_args[0]);
+
+    return random;
+}
+
+M_BaseObject* M_Random::seed(ThreadContext* context, const Arguments& args)
+{
+    static Signature seed_signature({"self", "n"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("seed", nullptr, seed_signature, scope, {space->wrap_None()});
+    M_RANDOM(scope[0])->seed_from(context, scope[1]);
+
+    return space->wrap_None();
+}
+
+M_BaseObject* M_Random::random(ThreadContext* context, M_BaseObject* self)
+{
+    return context->get_space()->wrap_float(context,
+                                            M_RANDOM(self)->genrand_double());
+}
+
+M_BaseObject* M_Random::getrandbits(ThreadContext* context, M_BaseObject* self,
+                                    M_BaseObject* k)
+{
+    ObjSpace* space = context->get_space();
+    int bits = space->unwrap_int(k);
+
+    if (bits <= 0)
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "number of bits must be "
+                                                   "greater than zero"));
+    /* ints are 32-bit signed */
+    if (bits > 31)
+        throw InterpError(
+            space->OverflowError_type(),
+            space->wrap_str(context,
+                            "getrandbits() result does not fit in an int"));
+
+    return space->wrap_int(
+        context, (int)(M_RANDOM(self)->genrand_uint32() >> (32 - bits)));
+}
+
+/* The state is a tuple of the N state words followed by the index. Words
+ * with the top bit set come out as negative ints. */
+M_BaseObject* M_Random::getstate(ThreadContext* context, M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_Random* random = M_RANDOM(self);
+
+    std::vector<M_BaseObject*> items;
+    items.reserve(N + 1);
+    for (std::uint32_t word : random->state)
+        items.push_back(space->wrap_int(context, (int)word));
+    items.push_back(space->wrap_int(context, random->index));
+
+    return space->new_tuple(context, items);
+}
+
+M_BaseObject* M_Random::setstate(ThreadContext* context, M_BaseObject* self,
+                                 M_BaseObject* state)
+{
+    ObjSpace* space = context->get_space();
+    M_Random* random = M_RANDOM(self);
+
+    std::vector<M_BaseObject*> items;
+    space->unwrap_tuple(state, items);
+    if (items.size() != N + 1)
+        throw InterpError(
+            space->ValueError_type(),
+            space->wrap_str(context, "state vector is the wrong size"));
+
+    int index = space->unwrap_int(items[N]);
+    if (index < 0 || index > N)
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "invalid state"));
+
+    for (int i = 0; i < N; i++)
+        random->state[i] = (std::uint32_t)space->unwrap_int(items[i]);
+    random->index = index;
+
+    return space->wrap_None();
+}
+
+/* k items chosen with replacement, like random.Random.choices() */
+M_BaseObject* M_Random::choices(ThreadContext* context, const Arguments& args)
+{
+    static Signature choices_signature(
+        {"self", "population", "weights", "cum_weights", "k"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("choices", nullptr, choices_signature, scope,
+               {space->wrap_None(), space->wrap_None(),
+                space->wrap_int(context, 1)});
+    M_Random* random = M_RANDOM(scope[0]);
+    M_BaseObject* weights = scope[2];
+    M_BaseObject* cum_weights = scope[3];
+    int k = std::max(space->unwrap_int(scope[4]), 0);
+
+    std::vector<M_BaseObject*> items;
+    population_items(context, scope[1], items);
+    std::size_t n = items.size();
+    std::vector<M_BaseObject*> result(k);
+
+    bool has_weights = !space->i_is(weights, space->wrap_None());
+    bool has_cum_weights = !space->i_is(cum_weights, space->wrap_None());
+    if (!has_weights && !has_cum_weights) {
+        if (n == 0 && k > 0)
+            throw InterpError(
+                space->IndexError_type(),
+                space->wrap_str(context, "Cannot choose from an empty "
+                                         "sequence"));
+        for (auto& item : result)
+            item = items[(std::size_t)(random->genrand_double() * n)];
+        return space->new_list(context, result);
+    }
+
+    if (has_weights && has_cum_weights)
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "Cannot specify both "
+                                                   "weights and cumulative "
+                                                   "weights"));
+
+    std::vector<double> cum;
+    M_BaseObject* iterator = space->iter(has_weights ? weights : cum_weights);
+    double total = 0.0;
+    while (M_BaseObject* weight = space->next_item(iterator)) {
+        double w = space->unwrap_float(weight);
+        total = has_weights ? total + w : w;
+        cum.push_back(total);
+    }
+
+    if (cum.size() != n)
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "The number of weights "
+                                                   "does not match the "
+                                                   "population"));
+    if (n == 0 || total <= 0.0)
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "Total of weights must be "
+                                                   "greater than zero"));
+
+    for (auto& item : result) {
+        double x = random->genrand_double() * total;
+        std::size_t i =
+            std::upper_bound(cum.begin(), cum.end() - 1, x) - cum.begin();
+        item = items[i];
+    }
+
+    return space->new_list(context, result);
+}
+
+/* k unique items, like random.Random.sample(): a partial shuffle of a pool
+ * for small populations, rejection of indices already chosen otherwise */
+M_BaseObject* M_Random::sample(ThreadContext* context, M_BaseObject* self,
+                               M_BaseObject* population, M_BaseObject* k_obj)
+{
+    ObjSpace* space = context->get_space();
+    M_Random* random = M_RANDOM(self);
+
+    std::vector<M_BaseObject*> pool;
+    population_items(context, population, pool);
+    std::size_t n = pool.size();
+    int k = space->unwrap_int(k_obj);
+
+    if (k < 0 || (std::size_t)k > n)
+        throw InterpError(
+            space->ValueError_type(),
+            space->wrap_str(context, "Sample larger than population"));
+
+    std::vector<M_BaseObject*> result(k);
+
+    std::size_t setsize = 21;
+    if (k > 5)
+        setsize += (std::size_t)std::pow(
+            4.0, std::ceil(std::log((double)k * 3) / std::log(4.0)));
+
+    if (n <= setsize) {
+        for (int i = 0; i < k; i++) {
+            std::size_t j = random->randbelow((std::uint32_t)(n - i));
+            result[i] = pool[j];
+            pool[j] = pool[n - i - 1];
+        }
+    } else {
+        std::unordered_set<std::uint32_t> selected;
+        for (int i = 0; i < k; i++) {
+            std::uint32_t j = random->randbelow((std::uint32_t)n);
+            while (selected.count(j))
+                j = random->randbelow((std::uint32_t)n);
+            selected.insert(j);
+            result[i] = pool[j];
+        }
+    }
+
+    return space->new_list(context, result);
+}
@@ -0,0 +1,20 @@
+#include "modules/_random/randommodule.h"
+#include "modules/_random/random.h"
+
+using namespace mtpython::objects;
+
+namespace mtpython {
+namespace modules {
+
+RandomModule::RandomModule(ObjSpace* space, M_BaseObject* name)
+    : BuiltinModule(space, name)
+{
+    add_def("__doc__",
+            space->wrap_str(vm::ThreadContext::current_thread(),
+                            "Module implements the Mersenne Twister random "
+                            "number generator."));
+    add_def("Random", space->get_typeobject(M_Random::_random_typedef()));
+}
+
+} // namespace modules
+} // namespace mtpython
@@ -0,0 +1,1211 @@
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include "modules/_sre/engine.h"
+#include "objects/buffer.h"
+#include "objects/std/bytes_object.h"
+#include "objects/std/unicode_object.h"
+#include "interpreter/error.h"
+#include "utils/string_helper.h"
+
+using namespace mtpython::modules;
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+/* the cache is emptied when it is full, like the one of re.py */
+#define SRE_MAX_CACHE 100
+
+/* nested match() calls before giving up with RuntimeError instead of running
+ * out of stack */
+#define SRE_MAX_DEPTH 20000
+
+/* cap of the computed minimum width of a pattern */
+#define SRE_MAX_WIDTH ((std::size_t)1 << 30)
+
+/* sre_constants.AT_* */
+enum {
+    SRE_AT_BEGINNING = 0,
+    SRE_AT_BEGINNING_LINE = 1,
+    SRE_AT_BEGINNING_STRING = 2,
+    SRE_AT_BOUNDARY = 3,
+    SRE_AT_NON_BOUNDARY = 4,
+    SRE_AT_END = 5,
+    SRE_AT_END_LINE = 6,
+    SRE_AT_END_STRING = 7,
+    SRE_AT_LOC_BOUNDARY = 8,
+    SRE_AT_LOC_NON_BOUNDARY = 9,
+    SRE_AT_UNI_BOUNDARY = 10,
+    SRE_AT_UNI_NON_BOUNDARY = 11,
+};
+
+/* sre_constants.CH_* */
+enum {
+    SRE_CATEGORY_DIGIT = 0,
+    SRE_CATEGORY_NOT_DIGIT = 1,
+    SRE_CATEGORY_SPACE = 2,
+    SRE_CATEGORY_NOT_SPACE = 3,
+    SRE_CATEGORY_WORD = 4,
+    SRE_CATEGORY_NOT_WORD = 5,
+    SRE_CATEGORY_LINEBREAK = 6,
+    SRE_CATEGORY_NOT_LINEBREAK = 7,
+    SRE_CATEGORY_LOC_WORD = 8,
+    SRE_CATEGORY_LOC_NOT_WORD = 9,
+    SRE_CATEGORY_UNI_DIGIT = 10,
+    SRE_CATEGORY_UNI_NOT_DIGIT = 11,
+    SRE_CATEGORY_UNI_SPACE = 12,
+    SRE_CATEGORY_UNI_NOT_SPACE = 13,
+    SRE_CATEGORY_UNI_WORD = 14,
+    SRE_CATEGORY_UNI_NOT_WORD = 15,
+    SRE_CATEGORY_UNI_LINEBREAK = 16,
+    SRE_CATEGORY_UNI_NOT_LINEBREAK = 17,
+};
+
+static std::mutex cache_mutex;
+static std::unordered_map<std::string, std::shared_ptr<const SreProgram>>
+    program_cache;
+
+/* Character classes. There is no Unicode database in the interpreter, the
+ * UNI_* categories are approximated with the blocks that need them most. */
+
+static bool ascii_digit(std::uint32_t ch) { return ch >= '0' && ch <= '9'; }
+
+static bool ascii_space(std::uint32_t ch)
+{
+    return ch == ' ' || (ch >= '\t' && ch <= '\r');
+}
+
+static bool ascii_word(std::uint32_t ch)
+{
+    return ascii_digit(ch) || (ch >= 'a' && ch <= 'z') ||
+           (ch >= 'A' && ch <= 'Z') || ch == '_';
+}
+
+static bool uni_digit(std::uint32_t ch)
+{
+    static const std::uint32_t zeros[] = {
+        0x660,  0x6f0,  0x7c0,  0x966,  0x9e6,  0xa66,  0xae6,
+        0xb66,  0xbe6,  0xc66,  0xce6,  0xd66,  0xe50,  0xed0,
+        0xf20,  0x1040, 0x17e0, 0x1810, 0xff10,
+    };
+
+    if (ch < 128) return ascii_digit(ch);
+    for (std::uint32_t zero : zeros) {
+        if (ch >= zero && ch <= zero + 9) return true;
+    }
+    return false;
+}
+
+static bool uni_space(std::uint32_t ch)
+{
+    if (ch < 128) return ascii_space(ch) || (ch >= 0x1c && ch <= 0x1f);
+    return ch == 0x85 || ch == 0xa0 || ch == 0x1680 ||
+           (ch >= 0x2000 && ch <= 0x200a) || ch == 0x2028 || ch == 0x2029 ||
+           ch == 0x202f || ch == 0x205f || ch == 0x3000;
+}
+
+static bool uni_linebreak(std::uint32_t ch)
+{
+    return (ch >= '\n' && ch <= '\r') || (ch >= 0x1c && ch <= 0x1e) ||
+           ch == 0x85 || ch == 0x2028 || ch == 0x2029;
+}
+
+static bool uni_word(std::uint32_t ch)
+{
+    if (ch < 128) return ascii_word(ch);
+    if (ch < 256) {
+        return ch == 0xaa || ch == 0xb2 || ch == 0xb3 || ch == 0xb5 ||
+               ch == 0xb9 || ch == 0xba || (ch >= 0xbc && ch <= 0xbe) ||
+               (ch >= 0xc0 && ch != 0xd7 && ch != 0xf7);
+    }
+    if (uni_digit(ch)) return true;
+
+    /* everything but marks, punctuation, symbols and spaces */
+    static const std::uint32_t not_word[][2] = {
+        {0x2c2, 0x2c5},   {0x2d2, 0x2df},   {0x2e5, 0x2eb},
+        {0x300, 0x36f},   {0x37e, 0x37e},   {0x384, 0x385},
+        {0x387, 0x387},   {0x483, 0x489},   {0x55a, 0x55f},
+        {0x589, 0x58a},   {0x591, 0x5cf},   {0x600, 0x61f},
+        {0x64b, 0x65f},   {0x6d4, 0x6d4},   {0x1680, 0x1680},
+        {0x2000, 0x206f}, {0x20a0, 0x20ff}, {0x2190, 0x245f},
+        {0x2500, 0x2775}, {0x2794, 0x2bff}, {0x2e00, 0x2e7f},
+        {0x3000, 0x3004}, {0x3008, 0x3020}, {0x3030, 0x3030},
+        {0xd800, 0xf8ff}, {0xfe00, 0xfe6f}, {0xff00, 0xff0f},
+        {0xff1a, 0xff20}, {0xff3b, 0xff40}, {0xff5b, 0xff65},
+        {0xffe0, 0xffff}, {0x1f000, 0x1faff},
+    };
+    for (auto& range : not_word) {
+        if (ch >= range[0] && ch <= range[1]) return false;
+    }
+    return true;
+}
+
+static std::uint32_t ascii_lower(std::uint32_t ch)
+{
+    return (ch >= 'A' && ch <= 'Z') ? ch + ('a' - 'A') : ch;
+}
+
+static std::uint32_t uni_lower(std::uint32_t ch)
+{
+    if (ch < 128) return ascii_lower(ch);
+    /* Latin-1 */
+    if ((ch >= 0xc0 && ch <= 0xde && ch != 0xd7)) return ch + 0x20;
+    /* Latin Extended-A pairs */
+    if (ch >= 0x100 && ch <= 0x17f) {
+        if (ch == 0x130) return 'i';
+        if (ch == 0x178) return 0xff;
+        if ((ch >= 0x139 && ch <= 0x148) || (ch >= 0x179 && ch <= 0x17e))
+            return (ch & 1) ? ch + 1 : ch;
+        if (ch == 0x131 || ch == 0x138 || ch == 0x149 || ch == 0x17f)
+            return ch;
+        return (ch & 1) ? ch : ch + 1;
+    }
+    /* Greek */
+    if (ch == 0x386) return 0x3ac;
+    if (ch >= 0x388 && ch <= 0x38a) return ch + 0x25;
+    if (ch == 0x38c) return 0x3cc;
+    if (ch == 0x38e || ch == 0x38f) return ch + 0x3f;
+    if (ch >= 0x391 && ch <= 0x3ab && ch != 0x3a2) return ch + 0x20;
+    /* Cyrillic */
+    if (ch >= 0x400 && ch <= 0x40f) return ch + 0x50;
+    if (ch >= 0x410 && ch <= 0x42f) return ch + 0x20;
+    if (ch >= 0x460 && ch <= 0x4bf && ch != 0x482 && !(ch >= 0x483 &&
+                                                           ch <= 0x489))
+        return (ch & 1) ? ch : ch + 1;
+    /* Armenian */
+    if (ch >= 0x531 && ch <= 0x556) return ch + 0x30;
+    /* fullwidth forms */
+    if (ch >= 0xff21 && ch <= 0xff3a) return ch + 0x20;
+    return ch;
+}
+
+std::uint32_t mtpython::modules::sre_getlower(std::uint32_t ch, int flags)
+{
+    if (flags & SRE_FLAG_LOCALE) return ch < 256 ? ascii_lower(ch) : ch;
+    if (flags & SRE_FLAG_UNICODE) return uni_lower(ch);
+    return ascii_lower(ch);
+}
+
+static bool in_category(SreCode category, std::uint32_t ch)
+{
+    switch (category) {
+    case SRE_CATEGORY_DIGIT:
+        return ascii_digit(ch);
+    case SRE_CATEGORY_NOT_DIGIT:
+        return !ascii_digit(ch);
+    case SRE_CATEGORY_SPACE:
+        return ascii_space(ch);
+    case SRE_CATEGORY_NOT_SPACE:
+        return !ascii_space(ch);
+    case SRE_CATEGORY_WORD:
+    case SRE_CATEGORY_LOC_WORD:
+        return ascii_word(ch);
+    case SRE_CATEGORY_NOT_WORD:
+    case SRE_CATEGORY_LOC_NOT_WORD:
+        return !ascii_word(ch);
+    case SRE_CATEGORY_LINEBREAK:
+        return ch == '\n';
+    case SRE_CATEGORY_NOT_LINEBREAK:
+        return ch != '\n';
+    case SRE_CATEGORY_UNI_DIGIT:
+        return uni_digit(ch);
+    case SRE_CATEGORY_UNI_NOT_DIGIT:
+        return !uni_digit(ch);
+    case SRE_CATEGORY_UNI_SPACE:
+        return uni_space(ch);
+    case SRE_CATEGORY_UNI_NOT_SPACE:
+        return !uni_space(ch);
+    case SRE_CATEGORY_UNI_WORD:
+        return uni_word(ch);
+    case SRE_CATEGORY_UNI_NOT_WORD:
+        return !uni_word(ch);
+    case SRE_CATEGORY_UNI_LINEBREAK:
+        return uni_linebreak(ch);
+    case SRE_CATEGORY_UNI_NOT_LINEBREAK:
+        return !uni_linebreak(ch);
+    }
+    return false;
+}
+
+/* Whether ch is in the set starting at set and ending with FAILURE */
+static bool in_charset(const SreCode* set, std::uint32_t ch)
+{
+    bool ok = true;
+
+    for (;;) {
+        switch (*set++) {
+        case SRE_OP_FAILURE:
+            return !ok;
+        case SRE_OP_LITERAL:
+            if (ch == set[0]) return ok;
+            set++;
+            break;
+        case SRE_OP_CATEGORY:
+            if (in_category(set[0], ch)) return ok;
+            set++;
+            break;
+        case SRE_OP_CHARSET:
+            /* 256 bits in 8 words */
+            if (ch < 256 && (set[ch >> 5] & (1u << (ch & 31)))) return ok;
+            set += 8;
+            break;
+        case SRE_OP_RANGE:
+            if (set[0] <= ch && ch <= set[1]) return ok;
+            set += 2;
+            break;
+        case SRE_OP_NEGATE:
+            ok = !ok;
+            break;
+        case SRE_OP_BIGCHARSET: {
+            /* count, 256 block numbers packed in 64 words, count blocks of
+             * 256 bits. sre_compile packs the block numbers with
+             * array('I'), so they are laid out as bytes in native order */
+            std::size_t count = *set++;
+            if (ch < 65536) {
+                std::size_t block =
+                    reinterpret_cast<const unsigned char*>(set)[ch >> 8];
+                const SreCode* bits = set + 64 + block * 8;
+                if (bits[(ch & 255) >> 5] & (1u << (ch & 31))) return ok;
+            }
+            set += 64 + count * 8;
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+}
+
+/* Lower bound of the length of a match of the code from pattern on, up to
+ * the SUCCESS, JUMP or UNTIL that ends it. Operators whose width isn't
+ * obvious end the walk, which keeps the result a lower bound. */
+static std::size_t code_min_width(const SreCode* pattern)
+{
+    std::size_t width = 0;
+
+    for (;;) {
+        switch (*pattern++) {
+        case SRE_OP_ANY:
+        case SRE_OP_ANY_ALL:
+            width++;
+            break;
+
+        case SRE_OP_CATEGORY:
+        case SRE_OP_LITERAL:
+        case SRE_OP_NOT_LITERAL:
+        case SRE_OP_LITERAL_IGNORE:
+        case SRE_OP_NOT_LITERAL_IGNORE:
+            width++;
+            pattern++;
+            break;
+
+        case SRE_OP_IN:
+        case SRE_OP_IN_IGNORE:
+            width++;
+            pattern += pattern[0];
+            break;
+
+        case SRE_OP_AT:
+        case SRE_OP_MARK:
+        case SRE_OP_GROUPREF:
+        case SRE_OP_GROUPREF_IGNORE:
+            pattern++;
+            break;
+
+        case SRE_OP_INFO:
+        case SRE_OP_ASSERT:
+        case SRE_OP_ASSERT_NOT:
+            pattern += pattern[0];
+            break;
+
+        case SRE_OP_BRANCH: {
+            std::size_t shortest = SRE_MAX_WIDTH;
+            for (; pattern[0]; pattern += pattern[0])
+                shortest = std::min(shortest, code_min_width(pattern + 1));
+            width += shortest;
+            pattern++;
+            break;
+        }
+
+        case SRE_OP_REPEAT_ONE:
+        case SRE_OP_MIN_REPEAT_ONE:
+        case SRE_OP_REPEAT: {
+            /* skip min max item, the skip of REPEAT leads to its UNTIL */
+            bool until = pattern[-1] == SRE_OP_REPEAT;
+            std::size_t item = code_min_width(pattern + 3);
+            std::size_t mincount = pattern[1];
+            if (item && mincount > SRE_MAX_WIDTH / item)
+                width = SRE_MAX_WIDTH;
+            else
+                width += item * mincount;
+
+            pattern += pattern[0] + (until ? 1 : 0);
+            break;
+        }
+
+        default:
+            return std::min(width, SRE_MAX_WIDTH);
+        }
+
+        if (width >= SRE_MAX_WIDTH) return SRE_MAX_WIDTH;
+    }
+}
+
+std::shared_ptr<const SreProgram>
+SreProgram::get(ThreadContext* context, M_BaseObject* code_obj, int flags)
+{
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> items;
+    space->unpack_iterable(code_obj, items);
+
+    std::vector<SreCode> code;
+    code.reserve(items.size());
+    for (auto* item : items) {
+        /* words above INT_MAX, e.g. charset bitmaps, wrapped to negative */
+        code.push_back((SreCode)space->unwrap_int(item));
+    }
+
+    std::string key(reinterpret_cast<const char*>(&flags), sizeof(flags));
+    key.append(reinterpret_cast<const char*>(code.data()),
+               code.size() * sizeof(SreCode));
+
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto got = program_cache.find(key);
+        if (got != program_cache.end()) return got->second;
+    }
+
+    std::shared_ptr<SreProgram> program(new SreProgram());
+    program->flags = flags;
+    program->body = 0;
+    program->min_width = 0;
+    program->prefix_is_bytes = false;
+    program->literal = false;
+    program->charset = 0;
+
+    /* INFO skip flags min max [prefix_len prefix_skip prefix overlap |
+     * charset] */
+    if (code.size() >= 5 && code[0] == SRE_OP_INFO) {
+        std::size_t skip = code[1];
+        int info_flags = code[2];
+
+        program->body = 1 + skip;
+
+        /* sre_compile truncates the prefix to MAXCODE characters, and
+         * MAXCODE = 0xFFFFFFFF is -1 with 32-bit ints, so the last character
+         * is dropped and a one-character prefix is left out entirely */
+        if ((info_flags & SRE_INFO_PREFIX) && skip >= 6) {
+            std::size_t prefix_len = code[5];
+            program->prefix.assign(code.begin() + 7,
+                                   code.begin() + 7 + prefix_len);
+        } else if (info_flags & SRE_INFO_CHARSET) {
+            program->charset = 5;
+        }
+    }
+
+    /* The LITERALs the body starts with are a prefix of every match, they
+     * give back what the truncation dropped */
+    std::size_t lit = program->body;
+    std::vector<std::uint32_t> literals;
+    while (lit + 1 < code.size() && code[lit] == SRE_OP_LITERAL) {
+        literals.push_back(code[lit + 1]);
+        lit += 2;
+    }
+    if (program->prefix.size() <= literals.size() && !literals.empty()) {
+        program->prefix = std::move(literals);
+        program->literal = lit < code.size() && code[lit] == SRE_OP_SUCCESS;
+        program->charset = 0;
+    }
+
+    program->prefix_is_bytes = true;
+    for (std::uint32_t ch : program->prefix) {
+        if (ch > 255) program->prefix_is_bytes = false;
+        program->prefix_bytes.push_back((char)ch);
+    }
+
+    /* The width in the INFO block comes from sre_parse.getwidth(), whose
+     * sums overflow 32-bit ints for unbounded repeats, and is replaced by
+     * MAXCODE for the same reason as the prefix. Compute it here instead. */
+    if (program->body < code.size())
+        program->min_width = code_min_width(code.data() + program->body);
+    program->code = std::move(code);
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (program_cache.size() >= SRE_MAX_CACHE) program_cache.clear();
+    program_cache[key] = program;
+
+    return program;
+}
+
+void SreProgram::clear_cache()
+{
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    program_cache.clear();
+}
+
+void SreSubject::load(ThreadContext* context, M_BaseObject* obj)
+{
+    ObjSpace* space = context->get_space();
+    M_StdUnicodeObject* str = dynamic_cast<M_StdUnicodeObject*>(obj);
+
+    if (str) {
+        is_bytes = false;
+        length = str->char_length();
+
+        if (str->is_ascii()) {
+            narrow = reinterpret_cast<const unsigned char*>(
+                str->get_value().data());
+            return;
+        }
+
+        wide_copy.reserve(length);
+        std::size_t size = str->get_value().size();
+        for (std::size_t pos = 0; pos < size; pos += str->char_size(pos))
+            wide_copy.push_back(str->code_point(pos));
+        wide = wide_copy.data();
+        return;
+    }
+
+    Buffer view;
+    space->get_buffer(obj, view, false, false);
+    is_bytes = true;
+    length = view.nbytes();
+
+    if (typeid(*obj) == typeid(M_StdBytesObject)) {
+        /* immutable, the memory stays valid while the object is alive */
+        narrow = view.buf;
+        if (!narrow) narrow = reinterpret_cast<const unsigned char*>("");
+        return;
+    }
+
+    narrow_copy.resize(length);
+    view.copy_to(reinterpret_cast<std::uint8_t*>(&narrow_copy[0]));
+    narrow = reinterpret_cast<const unsigned char*>(narrow_copy.data());
+}
+
+void SreState::get_span(std::size_t i, long& span_start, long& span_end) const
+{
+    if (i == 0) {
+        span_start = match_start;
+        span_end = match_end;
+        return;
+    }
+
+    std::size_t mark = 2 * (i - 1);
+    span_start = span_end = -1;
+    if ((int)mark + 1 > lastmark) return;
+    if (marks[mark] < 0 || marks[mark + 1] < 0) return;
+    span_start = marks[mark];
+    span_end = marks[mark + 1];
+}
+
+namespace mtpython {
+namespace modules {
+
+/* Backtracking matcher over the characters of a subject. CharT is unsigned
+ * char for bytes and ASCII str subjects, where single characters and
+ * prefixes are found with memchr and StringHelper::find, and uint32_t for
+ * decoded str subjects. */
+template <typename CharT> class SreEngine {
+private:
+    /* an active REPEAT ... MAX_UNTIL/MIN_UNTIL loop */
+    struct Repeat {
+        long count;
+        const SreCode* pattern; /* skip min max of the REPEAT */
+        long last_ptr;          /* where the last iteration started */
+        Repeat* prev;
+    };
+
+    struct DepthGuard {
+        SreEngine& engine;
+
+        DepthGuard(SreEngine& engine) : engine(engine)
+        {
+            if (++engine.depth > SRE_MAX_DEPTH) {
+                engine.depth--;
+                ObjSpace* space = engine.context->get_space();
+                throw InterpError(space->RuntimeError_type(),
+                                  space->wrap_str(engine.context,
+                                                  "maximum recursion limit "
+                                                  "exceeded"));
+            }
+        }
+        ~DepthGuard() { engine.depth--; }
+    };
+
+    ThreadContext* context;
+    const SreProgram& program;
+    const CharT* str;
+    long end;
+    SreState& state;
+    int flags;
+
+    Repeat* repeat;
+    int depth;
+    /* lastmark, lastindex and marks saved before trying alternatives */
+    std::vector<long> mark_stack;
+
+    std::uint32_t lower(std::uint32_t ch) const
+    {
+        return sre_getlower(ch, flags);
+    }
+
+    bool at(long ptr, SreCode code) const;
+    long count_repeats(const SreCode* item, long ptr, long maxcount);
+    long find_prefix(long ptr) const;
+    long find_char(long ptr, long limit, std::uint32_t ch) const;
+    bool try_at(const SreCode* body, long ptr);
+
+    std::size_t save_marks();
+    void restore_marks(std::size_t saved);
+    void drop_marks(std::size_t saved) { mark_stack.resize(saved); }
+    void set_mark(int i, long ptr);
+    bool group_span(int group, long& group_start, long& group_end) const;
+
+    /* End of the match of pattern at ptr, or -1 */
+    long match(const SreCode* pattern, long ptr, bool toplevel);
+
+public:
+    SreEngine(ThreadContext* context, const SreProgram& program,
+              const CharT* str, SreState& state)
+        : context(context), program(program), str(str), end(state.end),
+          state(state), flags(program.flags), repeat(nullptr), depth(0)
+    {}
+
+    bool match_at();
+    bool search();
+};
+
+template <typename CharT>
+bool SreEngine<CharT>::at(long ptr, SreCode code) const
+{
+    bool this_word, that_word;
+
+    switch (code) {
+    case SRE_AT_BEGINNING:
+    case SRE_AT_BEGINNING_STRING:
+        return ptr == 0;
+    case SRE_AT_BEGINNING_LINE:
+        return ptr == 0 || str[ptr - 1] == '\n';
+    case SRE_AT_END:
+        return ptr == end || (ptr + 1 == end && str[ptr] == '\n');
+    case SRE_AT_END_LINE:
+        return ptr == end || str[ptr] == '\n';
+    case SRE_AT_END_STRING:
+        return ptr == end;
+    case SRE_AT_BOUNDARY:
+    case SRE_AT_NON_BOUNDARY:
+    case SRE_AT_LOC_BOUNDARY:
+    case SRE_AT_LOC_NON_BOUNDARY:
+        if (end == 0) return false;
+        that_word = ptr > 0 && ascii_word(str[ptr - 1]);
+        this_word = ptr < end && ascii_word(str[ptr]);
+        break;
+    case SRE_AT_UNI_BOUNDARY:
+    case SRE_AT_UNI_NON_BOUNDARY:
+        if (end == 0) return false;
+        that_word = ptr > 0 && uni_word(str[ptr - 1]);
+        this_word = ptr < end && uni_word(str[ptr]);
+        break;
+    default:
+        return false;
+    }
+
+    if (code == SRE_AT_BOUNDARY || code == SRE_AT_LOC_BOUNDARY ||
+        code == SRE_AT_UNI_BOUNDARY)
+        return this_word != that_word;
+    return this_word == that_word;
+}
+
+/* First position in [ptr, limit) holding ch, or limit */
+template <typename CharT>
+long SreEngine<CharT>::find_char(long ptr, long limit, std::uint32_t ch) const
+{
+    if constexpr (sizeof(CharT) == 1) {
+        if (ch > 255 || ptr >= limit) return limit;
+        const void* found = std::memchr(str + ptr, (int)ch, limit - ptr);
+        return found ? static_cast<const CharT*>(found) - str : limit;
+    } else {
+        while (ptr < limit && str[ptr] != ch)
+            ptr++;
+        return ptr;
+    }
+}
+
+/* Start of the first occurrence of the literal prefix at or after ptr, or
+ * -1 */
+template <typename CharT> long SreEngine<CharT>::find_prefix(long ptr) const
+{
+    const std::vector<std::uint32_t>& prefix = program.prefix;
+    long n = (long)prefix.size();
+
+    if constexpr (sizeof(CharT) == 1) {
+        if (!program.prefix_is_bytes) return -1;
+        if (n == 1) {
+            long found = find_char(ptr, end, prefix[0]);
+            return found < end ? found : -1;
+        }
+        if (end - ptr < n) return -1;
+
+        std::size_t found = StringHelper::find(
+            reinterpret_cast<const char*>(str + ptr), end - ptr,
+            program.prefix_bytes.data(), n);
+        return found == StringHelper::npos ? -1 : ptr + (long)found;
+    } else {
+        for (; ptr + n <= end; ptr++) {
+            ptr = find_char(ptr, end - n + 1, prefix[0]);
+            if (ptr + n > end) break;
+
+            long i = 1;
+            while (i < n && str[ptr + i] == prefix[i])
+                i++;
+            if (i == n) return ptr;
+        }
+        return -1;
+    }
+}
+
+template <typename CharT> std::size_t SreEngine<CharT>::save_marks()
+{
+    std::size_t saved = mark_stack.size();
+
+    for (int i = 0; i <= state.lastmark; i++)
+        mark_stack.push_back(state.marks[i]);
+    mark_stack.push_back(state.lastmark);
+    mark_stack.push_back(state.lastindex);
+
+    return saved;
+}
+
+template <typename CharT>
+void SreEngine<CharT>::restore_marks(std::size_t saved)
+{
+    std::size_t top = mark_stack.size();
+
+    state.lastindex = (int)mark_stack[top - 1];
+    state.lastmark = (int)mark_stack[top - 2];
+    for (int i = 0; i <= state.lastmark; i++)
+        state.marks[i] = mark_stack[saved + i];
+}
+
+template <typename CharT> void SreEngine<CharT>::set_mark(int i, long ptr)
+{
+    if (i & 1) state.lastindex = i / 2 + 1;
+    if (i > state.lastmark) {
+        for (int j = state.lastmark + 1; j < i; j++)
+            state.marks[j] = -1;
+        state.lastmark = i;
+    }
+    state.marks[i] = ptr;
+}
+
+template <typename CharT>
+bool SreEngine<CharT>::group_span(int group, long& group_start,
+                                  long& group_end) const
+{
+    int mark = group * 2;
+
+    if (mark + 1 > state.lastmark) return false;
+    group_start = state.marks[mark];
+    group_end = state.marks[mark + 1];
+    return group_start >= 0 && group_end >= group_start;
+}
+
+/* How many times the single-character item matches from ptr on, at most
+ * maxcount times */
+template <typename CharT>
+long SreEngine<CharT>::count_repeats(const SreCode* item, long ptr,
+                                     long maxcount)
+{
+    long limit = end;
+    if (maxcount != SRE_MAXREPEAT && maxcount < end - ptr)
+        limit = ptr + maxcount;
+
+    long i = ptr;
+    switch (item[0]) {
+    case SRE_OP_IN:
+        while (i < limit && in_charset(item + 2, str[i]))
+            i++;
+        break;
+    case SRE_OP_ANY:
+        i = find_char(i, limit, '\n');
+        break;
+    case SRE_OP_ANY_ALL:
+        i = limit;
+        break;
+    case SRE_OP_LITERAL:
+        while (i < limit && str[i] == item[1])
+            i++;
+        break;
+    case SRE_OP_LITERAL_IGNORE:
+        while (i < limit && lower(str[i]) == item[1])
+            i++;
+        break;
+    case SRE_OP_NOT_LITERAL:
+        i = find_char(i, limit, item[1]);
+        break;
+    case SRE_OP_NOT_LITERAL_IGNORE:
+        while (i < limit && lower(str[i]) != item[1])
+            i++;
+        break;
+    case SRE_OP_CATEGORY:
+        while (i < limit && in_category(item[1], str[i]))
+            i++;
+        break;
+    default:
+        /* any other single-character item */
+        while (i < limit) {
+            long next = match(item, i, false);
+            if (next < 0) break;
+            i = next;
+        }
+        break;
+    }
+
+    return i - ptr;
+}
+
+template <typename CharT>
+long SreEngine<CharT>::match(const SreCode* pattern, long ptr, bool toplevel)
+{
+    DepthGuard guard(*this);
+    std::size_t saved;
+    long next;
+
+    for (;;) {
+        switch (*pattern++) {
+        case SRE_OP_FAILURE:
+            return -1;
+
+        case SRE_OP_SUCCESS:
+            if (toplevel && state.match_all && ptr != end) return -1;
+            return ptr;
+
+        case SRE_OP_AT:
+            if (!at(ptr, pattern[0])) return -1;
+            pattern++;
+            break;
+
+        case SRE_OP_CATEGORY:
+            if (ptr >= end || !in_category(pattern[0], str[ptr])) return -1;
+            pattern++;
+            ptr++;
+            break;
+
+        case SRE_OP_ANY:
+            if (ptr >= end || str[ptr] == '\n') return -1;
+            ptr++;
+            break;
+
+        case SRE_OP_ANY_ALL:
+            if (ptr >= end) return -1;
+            ptr++;
+            break;
+
+        case SRE_OP_LITERAL:
+            if (ptr >= end || str[ptr] != pattern[0]) return -1;
+            pattern++;
+            ptr++;
+            break;
+
+        case SRE_OP_NOT_LITERAL:
+            if (ptr >= end || str[ptr] == pattern[0]) return -1;
+            pattern++;
+            ptr++;
+            break;
+
+        case SRE_OP_LITERAL_IGNORE:
+            if (ptr >= end || lower(str[ptr]) != pattern[0]) return -1;
+            pattern++;
+            ptr++;
+            break;
+
+        case SRE_OP_NOT_LITERAL_IGNORE:
+            if (ptr >= end || lower(str[ptr]) == pattern[0]) return -1;
+            pattern++;
+            ptr++;
+            break;
+
+        case SRE_OP_IN:
+            /* skip set... */
+            if (ptr >= end || !in_charset(pattern + 1, str[ptr])) return -1;
+            pattern += pattern[0];
+            ptr++;
+            break;
+
+        case SRE_OP_IN_IGNORE:
+            if (ptr >= end || !in_charset(pattern + 1, lower(str[ptr])))
+                return -1;
+            pattern += pattern[0];
+            ptr++;
+            break;
+
+        case SRE_OP_INFO:
+        case SRE_OP_JUMP:
+            pattern += pattern[0];
+            break;
+
+        case SRE_OP_MARK:
+            set_mark(pattern[0], ptr);
+            pattern++;
+            break;
+
+        case SRE_OP_BRANCH:
+            /* skip alternative JUMP ... skip alternative JUMP ... 0 */
+            saved = save_marks();
+            for (; pattern[0]; pattern += pattern[0]) {
+                const SreCode* alt = pattern + 1;
+
+                /* cheap rejects before recursing */
+                if (alt[0] == SRE_OP_LITERAL &&
+                    (ptr >= end || str[ptr] != alt[1]))
+                    continue;
+                if (alt[0] == SRE_OP_IN &&
+                    (ptr >= end || !in_charset(alt + 2, str[ptr])))
+                    continue;
+
+                next = match(alt, ptr, toplevel);
+                if (next >= 0) {
+                    drop_marks(saved);
+                    return next;
+                }
+                restore_marks(saved);
+            }
+            drop_marks(saved);
+            return -1;
+
+        case SRE_OP_REPEAT_ONE: {
+            /* skip min max item SUCCESS tail, greedy */
+            long mincount = pattern[1];
+            long maxcount = pattern[2];
+            const SreCode* tail = pattern + pattern[0];
+
+            if (ptr + mincount > end) return -1;
+            long count = count_repeats(pattern + 3, ptr, maxcount);
+            if (count < mincount) return -1;
+            ptr += count;
+
+            if (tail[0] == SRE_OP_SUCCESS &&
+                !(toplevel && state.match_all && ptr != end))
+                return ptr;
+
+            saved = save_marks();
+            if (tail[0] == SRE_OP_LITERAL) {
+                /* only try the tail where its first character is */
+                SreCode ch = tail[1];
+                for (;;) {
+                    while (count >= mincount &&
+                           (ptr >= end || str[ptr] != ch)) {
+                        ptr--;
+                        count--;
+                    }
+                    if (count < mincount) break;
+
+                    next = match(tail, ptr, toplevel);
+                    if (next >= 0) {
+                        drop_marks(saved);
+                        return next;
+                    }
+                    restore_marks(saved);
+                    ptr--;
+                    count--;
+                }
+            } else {
+                while (count >= mincount) {
+                    next = match(tail, ptr, toplevel);
+                    if (next >= 0) {
+                        drop_marks(saved);
+                        return next;
+                    }
+                    restore_marks(saved);
+                    ptr--;
+                    count--;
+                }
+            }
+            drop_marks(saved);
+            return -1;
+        }
+
+        case SRE_OP_MIN_REPEAT_ONE: {
+            /* skip min max item SUCCESS tail, lazy */
+            long mincount = pattern[1];
+            long maxcount = pattern[2];
+            const SreCode* tail = pattern + pattern[0];
+
+            if (ptr + mincount > end) return -1;
+            if (mincount > 0) {
+                if (count_repeats(pattern + 3, ptr, mincount) < mincount)
+                    return -1;
+                ptr += mincount;
+            }
+            long count = mincount;
+
+            if (tail[0] == SRE_OP_SUCCESS && !(toplevel && state.match_all))
+                return ptr;
+
+            saved = save_marks();
+            while (maxcount == SRE_MAXREPEAT || count <= maxcount) {
+                next = match(tail, ptr, toplevel);
+                if (next >= 0) {
+                    drop_marks(saved);
+                    return next;
+                }
+                restore_marks(saved);
+
+                if (ptr >= end || count_repeats(pattern + 3, ptr, 1) == 0)
+                    break;
+                ptr++;
+                count++;
+            }
+            drop_marks(saved);
+            return -1;
+        }
+
+        case SRE_OP_REPEAT: {
+            /* skip min max body MAX_UNTIL/MIN_UNTIL tail */
+            Repeat rep = {-1, pattern, -1, repeat};
+
+            repeat = &rep;
+            next = match(pattern + pattern[0], ptr, toplevel);
+            repeat = rep.prev;
+            return next;
+        }
+
+        case SRE_OP_MAX_UNTIL:
+        case SRE_OP_MIN_UNTIL: {
+            Repeat* rep = repeat;
+            if (!rep) {
+                ObjSpace* space = context->get_space();
+                throw InterpError(space->RuntimeError_type(),
+                                  space->wrap_str(context,
+                                                  "internal error in "
+                                                  "regular expression "
+                                                  "engine"));
+            }
+
+            bool lazy = pattern[-1] == SRE_OP_MIN_UNTIL;
+            const SreCode* body = rep->pattern + 3;
+            long mincount = rep->pattern[1];
+            long maxcount = rep->pattern[2];
+            long count = rep->count + 1;
+            bool may_repeat =
+                (maxcount == SRE_MAXREPEAT || count < maxcount) &&
+                ptr != rep->last_ptr;
+
+            if (count < mincount) {
+                rep->count = count;
+                next = match(body, ptr, toplevel);
+                if (next >= 0) return next;
+                rep->count = count - 1;
+                return -1;
+            }
+
+            if (!lazy && may_repeat) {
+                /* one more iteration first */
+                long last_ptr = rep->last_ptr;
+
+                rep->count = count;
+                rep->last_ptr = ptr;
+                saved = save_marks();
+                next = match(body, ptr, toplevel);
+                rep->last_ptr = last_ptr;
+                if (next >= 0) {
+                    drop_marks(saved);
+                    return next;
+                }
+                restore_marks(saved);
+                drop_marks(saved);
+                rep->count = count - 1;
+            }
+
+            /* the tail */
+            saved = save_marks();
+            repeat = rep->prev;
+            next = match(pattern, ptr, toplevel);
+            repeat = rep;
+            if (next >= 0) {
+                drop_marks(saved);
+                return next;
+            }
+            restore_marks(saved);
+            drop_marks(saved);
+
+            if (!lazy || !may_repeat) return -1;
+
+            /* the tail first, then one more iteration */
+            long last_ptr = rep->last_ptr;
+            rep->count = count;
+            rep->last_ptr = ptr;
+            next = match(body, ptr, toplevel);
+            rep->last_ptr = last_ptr;
+            if (next >= 0) return next;
+            rep->count = count - 1;
+            return -1;
+        }
+
+        case SRE_OP_GROUPREF:
+        case SRE_OP_GROUPREF_IGNORE: {
+            long group_start, group_end;
+            bool ignore = pattern[-1] == SRE_OP_GROUPREF_IGNORE;
+
+            if (!group_span(pattern[0], group_start, group_end)) return -1;
+            if (ptr + (group_end - group_start) > end) return -1;
+            for (long i = group_start; i < group_end; i++, ptr++) {
+                if (ignore ? lower(str[ptr]) != lower(str[i])
+                           : str[ptr] != str[i])
+                    return -1;
+            }
+            pattern++;
+            break;
+        }
+
+        case SRE_OP_GROUPREF_EXISTS: {
+            /* group skip yes JUMP no */
+            long group_start, group_end;
+
+            if (group_span(pattern[0], group_start, group_end))
+                pattern += 2;
+            else
+                pattern += pattern[1];
+            break;
+        }
+
+        case SRE_OP_ASSERT:
+            /* skip back pattern SUCCESS */
+            if (ptr - (long)pattern[1] < 0) return -1;
+            if (match(pattern + 2, ptr - pattern[1], false) < 0) return -1;
+            pattern += pattern[0];
+            break;
+
+        case SRE_OP_ASSERT_NOT:
+            if (ptr - (long)pattern[1] >= 0) {
+                saved = save_marks();
+                next = match(pattern + 2, ptr - pattern[1], false);
+                restore_marks(saved);
+                drop_marks(saved);
+                if (next >= 0) return -1;
+            }
+            pattern += pattern[0];
+            break;
+
+        default: {
+            ObjSpace* space = context->get_space();
+            throw InterpError(space->RuntimeError_type(),
+                              space->wrap_str(context,
+                                              "internal error in regular "
+                                              "expression engine"));
+        }
+        }
+    }
+}
+
+template <typename CharT>
+bool SreEngine<CharT>::try_at(const SreCode* body, long ptr)
+{
+    state.lastmark = -1;
+    state.lastindex = -1;
+    mark_stack.clear();
+    repeat = nullptr;
+
+    long match_end = match(body, ptr, true);
+    if (match_end < 0) return false;
+
+    state.match_start = ptr;
+    state.match_end = match_end;
+    return true;
+}
+
+template <typename CharT> bool SreEngine<CharT>::match_at()
+{
+    if (state.start > end) return false;
+    if (end - state.start < (long)program.min_width) return false;
+
+    return try_at(program.code.data() + program.body, state.start);
+}
+
+template <typename CharT> bool SreEngine<CharT>::search()
+{
+    const SreCode* body = program.code.data() + program.body;
+    long ptr = state.start;
+    long last = end - (long)program.min_width; /* last start of a match */
+
+    if (ptr > end || ptr > last) return false;
+
+    if (!program.prefix.empty()) {
+        while (ptr <= last) {
+            long found = find_prefix(ptr);
+            if (found < 0 || found > last) return false;
+
+            if (program.literal) {
+                state.lastmark = state.lastindex = -1;
+                state.match_start = found;
+                state.match_end = found + (long)program.prefix.size();
+                return true;
+            }
+            if (try_at(body, found)) return true;
+            ptr = found + 1;
+        }
+        return false;
+    }
+
+    if (program.charset) {
+        const SreCode* set = program.code.data() + program.charset;
+        for (; ptr <= last; ptr++) {
+            if (ptr < end && !in_charset(set, str[ptr])) continue;
+            if (try_at(body, ptr)) return true;
+        }
+        return false;
+    }
+
+    if (body[0] == SRE_OP_LITERAL) {
+        /* jump to the first character of every candidate */
+        while (ptr <= last) {
+            ptr = find_char(ptr, end, body[1]);
+            if (ptr > last) return false;
+            if (try_at(body, ptr)) return true;
+            ptr++;
+        }
+        return false;
+    }
+
+    for (; ptr <= last; ptr++) {
+        if (try_at(body, ptr)) return true;
+    }
+    return false;
+}
+
+} // namespace modules
+} // namespace mtpython
+
+bool mtpython::modules::sre_match(ThreadContext* context,
+                                  const SreProgram& program,
+                                  const SreSubject& subject, SreState& state)
+{
+    if (subject.narrow) {
+        SreEngine<unsigned char> engine(context, program, subject.narrow,
+                                        state);
+        return engine.match_at();
+    }
+
+    SreEngine<std::uint32_t> engine(context, program, subject.wide, state);
+    return engine.match_at();
+}
+
+bool mtpython::modules::sre_search(ThreadContext* context,
+                                   const SreProgram& program,
+                                   const SreSubject& subject, SreState& state)
+{
+    if (subject.narrow) {
+        SreEngine<unsigned char> engine(context, program, subject.narrow,
+                                        state);
+        return engine.search();
+    }
+
+    SreEngine<std::uint32_t> engine(context, program, subject.wide, state);
+    return engine.search();
+}
@@ -0,0 +1,866 @@
+#include <cstring>
+#include <limits>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "modules/_sre/pattern.h"
+#include "objects/buffer.h"
+#include "objects/std/bytes_object.h"
+#include "objects/std/iter_object.h"
+#include "objects/std/unicode_object.h"
+#include "interpreter/function.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+#include "interpreter/descriptor.h"
+
+using namespace mtpython::modules;
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+#define M_SRE_PATTERN(obj) (static_cast<M_SrePattern*>(obj))
+#define M_SRE_MATCH(obj) (static_cast<M_SreMatch*>(obj))
+#define M_SRE_SCANNER(obj) (static_cast<M_SreScanner*>(obj))
+
+/* Characters [start, end) of a str or bytes-like string */
+static M_BaseObject* string_slice(ThreadContext* context, M_BaseObject* string,
+                                  long start, long end)
+{
+    ObjSpace* space = context->get_space();
+    M_StdUnicodeObject* str = dynamic_cast<M_StdUnicodeObject*>(string);
+
+    if (str) {
+        const std::string& value = str->get_value();
+        if (str->is_ascii()) {
+            return new (context)
+                M_StdUnicodeObject(value.substr(start, end - start));
+        }
+
+        std::size_t first = str->byte_offset(start);
+        return new (context) M_StdUnicodeObject(
+            value.substr(first, str->byte_offset(end) - first));
+    }
+
+    if (typeid(*string) == typeid(M_StdBytesObject)) {
+        Buffer view;
+        space->get_buffer(string, view);
+        return space->new_bytes(context, view.buf + start, end - start);
+    }
+
+    return space->getitem(string, space->new_slice(
+                                      context, space->wrap_int(context, start),
+                                      space->wrap_int(context, end),
+                                      space->wrap_None()));
+}
+
+/* Append characters [start, end) of string to out, as UTF-8 for str */
+static void append_slice(ThreadContext* context, M_BaseObject* string,
+                         long start, long end, std::string& out)
+{
+    M_StdUnicodeObject* str = dynamic_cast<M_StdUnicodeObject*>(string);
+
+    if (str) {
+        if (!str->is_ascii()) {
+            start = str->byte_offset(start);
+            end = str->byte_offset(end);
+        }
+        out.append(str->get_value(), start, end - start);
+        return;
+    }
+
+    Buffer view;
+    context->get_space()->get_buffer(string, view);
+    out.append(reinterpret_cast<const char*>(view.buf) + start, end - start);
+}
+
+/* Value of a replacement or template as the string type of the subject */
+static void append_item(ThreadContext* context, M_BaseObject* item,
+                        bool is_bytes, std::string& out)
+{
+    ObjSpace* space = context->get_space();
+
+    if (!is_bytes) {
+        M_StdUnicodeObject* str = dynamic_cast<M_StdUnicodeObject*>(item);
+        if (!str) {
+            throw InterpError::format(space, space->TypeError_type(),
+                                      "expected str instance, %s found",
+                                      space->get_type_name(item).c_str());
+        }
+        out.append(str->get_value());
+        return;
+    }
+
+    if (dynamic_cast<M_StdUnicodeObject*>(item)) {
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "expected a bytes-like "
+                                                   "object, str found"));
+    }
+
+    Buffer view;
+    space->get_buffer(item, view);
+    std::size_t size = view.nbytes();
+    std::size_t offset = out.size();
+    out.resize(offset + size);
+    view.copy_to(reinterpret_cast<std::uint8_t*>(&out[offset]));
+}
+
+static M_BaseObject* new_string(ThreadContext* context, bool is_bytes,
+                                std::string&& value)
+{
+    if (is_bytes) {
+        return context->get_space()->new_bytes(context, value.data(),
+                                               value.size());
+    }
+    return new (context) M_StdUnicodeObject(std::move(value));
+}
+
+/* Function of the re module, imported on demand for the parts of the API
+ * that are implemented in Python */
+static M_BaseObject* re_function(ThreadContext* context, const char* name)
+{
+    ObjSpace* space = context->get_space();
+    M_BaseObject* import_func =
+        space->get_builtin()->get_dict_value(space, "__import__");
+    if (!import_func) {
+        throw InterpError(space->ImportError_type(),
+                          space->wrap_str(context, "__import__ not found"));
+    }
+
+    M_BaseObject* None = space->wrap_None();
+    M_BaseObject* module = space->call_function(
+        context, import_func,
+        {space->wrap_str(context, "re"), None, None, None,
+         space->wrap_int(context, 0)});
+    return space->getattr_str(module, name);
+}
+
+static bool is_callable(ObjSpace* space, M_BaseObject* obj)
+{
+    return dynamic_cast<Function*>(obj) || dynamic_cast<Method*>(obj) ||
+           space->lookup(obj, "__call__");
+}
+
+/* pos and endpos arguments clamped to the string */
+static void clamp_positions(ThreadContext* context, M_BaseObject* pos_obj,
+                            M_BaseObject* endpos_obj, std::size_t length,
+                            long& pos, long& endpos)
+{
+    ObjSpace* space = context->get_space();
+
+    pos = space->i_get_index(pos_obj, space->TypeError_type(), nullptr);
+    endpos = space->i_get_index(endpos_obj, space->TypeError_type(), nullptr);
+    if (pos < 0) pos = 0;
+    if (pos > (long)length) pos = length;
+    if (endpos < 0) endpos = 0;
+    if (endpos > (long)length) endpos = length;
+}
+
+/* Where the next search starts after a match, one character further for
+ * empty matches so that they are not found again */
+static long next_start(const SreState& state)
+{
+    return state.match_end == state.match_start ? state.match_end + 1
+                                                : state.match_end;
+}
+
+void M_SrePattern::load_subject(ThreadContext* context, M_BaseObject* string,
+                                SreSubject& subject) const
+{
+    ObjSpace* space = context->get_space();
+
+    subject.load(context, string);
+    if (space->i_is(pattern, space->wrap_None())) return;
+
+    bool pattern_is_bytes = !dynamic_cast<M_StdUnicodeObject*>(pattern);
+    if (subject.is_bytes && !pattern_is_bytes) {
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "can't use a string "
+                                                   "pattern on a bytes-like "
+                                                   "object"));
+    }
+    if (!subject.is_bytes && pattern_is_bytes) {
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "can't use a bytes "
+                                                   "pattern on a string-like "
+                                                   "object"));
+    }
+}
+
+enum SreMatchMode { SRE_MODE_MATCH, SRE_MODE_FULLMATCH, SRE_MODE_SEARCH };
+
+static M_BaseObject* pattern_match(ThreadContext* context, const char* fname,
+                                   const Arguments& args, SreMatchMode mode)
+{
+    static Signature match_signature({"self", "string", "pos", "endpos"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse(fname, nullptr, match_signature, scope,
+               {space->wrap_int(context, 0),
+                space->wrap_int(context, std::numeric_limits<int>::max())});
+    M_SrePattern* self = M_SRE_PATTERN(scope[0]);
+
+    SreSubject subject;
+    self->load_subject(context, scope[1], subject);
+
+    long pos, endpos;
+    clamp_positions(context, scope[2], scope[3], subject.length, pos, endpos);
+
+    SreState state(pos, endpos, self->get_groups());
+    state.match_all = mode == SRE_MODE_FULLMATCH;
+
+    bool found =
+        mode == SRE_MODE_SEARCH
+            ? sre_search(context, self->get_program(), subject, state)
+            : sre_match(context, self->get_program(), subject, state);
+    if (!found) return space->wrap_None();
+
+    return new (context) M_SreMatch(self, scope[1], pos, endpos, state);
+}
+
+M_BaseObject* M_SrePattern::match(ThreadContext* context, const Arguments& args)
+{
+    return pattern_match(context, "match", args, SRE_MODE_MATCH);
+}
+
+M_BaseObject* M_SrePattern::fullmatch(ThreadContext* context,
+                                      const Arguments& args)
+{
+    return pattern_match(context, "fullmatch", args, SRE_MODE_FULLMATCH);
+}
+
+M_BaseObject* M_SrePattern::search(ThreadContext* context,
+                                   const Arguments& args)
+{
+    return pattern_match(context, "search", args, SRE_MODE_SEARCH);
+}
+
+M_BaseObject* M_SrePattern::findall(ThreadContext* context,
+                                    const Arguments& args)
+{
+    static Signature findall_signature({"self", "string", "pos", "endpos"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("findall", nullptr, findall_signature, scope,
+               {space->wrap_int(context, 0),
+                space->wrap_int(context, std::numeric_limits<int>::max())});
+    M_SrePattern* self = M_SRE_PATTERN(scope[0]);
+    M_BaseObject* string = scope[1];
+
+    SreSubject subject;
+    self->load_subject(context, string, subject);
+
+    long pos, endpos;
+    clamp_positions(context, scope[2], scope[3], subject.length, pos, endpos);
+
+    std::vector<M_BaseObject*> items;
+    std::size_t groups = self->groups;
+    M_BaseObject* empty = nullptr;
+
+    while (pos <= endpos) {
+        SreState state(pos, endpos, groups);
+        if (!sre_search(context, *self->program, subject, state)) break;
+
+        if (groups == 0) {
+            items.push_back(string_slice(context, string, state.match_start,
+                                         state.match_end));
+        } else {
+            /* groups that did not match are empty strings */
+            if (!empty) empty = string_slice(context, string, 0, 0);
+
+            std::vector<M_BaseObject*> values;
+            for (std::size_t i = 1; i <= groups; i++) {
+                long group_start, group_end;
+                state.get_span(i, group_start, group_end);
+                values.push_back(group_start < 0
+                                     ? empty
+                                     : string_slice(context, string,
+                                                    group_start, group_end));
+            }
+
+            items.push_back(groups == 1 ? values[0]
+                                        : space->new_tuple(context, values));
+        }
+
+        pos = next_start(state);
+    }
+
+    return space->new_list(context, items);
+}
+
+namespace {
+
+class M_SreFindIter : public M_StdNativeIterObject {
+private:
+    M_SreScanner* scanner;
+
+public:
+    M_SreFindIter(M_SreScanner* scanner) : scanner(scanner) {}
+
+    M_BaseObject* next_item(ThreadContext* context)
+    {
+        return scanner->next_match(context, true);
+    }
+
+    virtual void mark_children(mtpython::gc::GarbageCollector* gc)
+    {
+        gc->mark_object(scanner);
+    }
+
+    static Typedef* _finditer_typedef()
+    {
+        static Typedef finditer_typedef(
+            "callable_iterator",
+            {
+                {"__iter__", new InterpFunctionWrapper(
+                                 "__iter__", M_StdNativeIterObject::__iter__)},
+                {"__next__", new InterpFunctionWrapper(
+                                 "__next__", M_StdNativeIterObject::__next__)},
+            });
+
+        return &finditer_typedef;
+    }
+
+    Typedef* get_typedef() { return _finditer_typedef(); }
+};
+
+} // namespace
+
+M_BaseObject* M_SrePattern::scanner(ThreadContext* context,
+                                    const Arguments& args)
+{
+    static Signature scanner_signature({"self", "string", "pos", "endpos"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("scanner", nullptr, scanner_signature, scope,
+               {space->wrap_int(context, 0),
+                space->wrap_int(context, std::numeric_limits<int>::max())});
+
+    /* positions are clamped once the subject is loaded */
+    long pos = space->i_get_index(scope[2], space->TypeError_type(), nullptr);
+    long endpos =
+        space->i_get_index(scope[3], space->TypeError_type(), nullptr);
+
+    return new (context)
+        M_SreScanner(context, M_SRE_PATTERN(scope[0]), scope[1], pos, endpos);
+}
+
+M_BaseObject* M_SrePattern::finditer(ThreadContext* context,
+                                     const Arguments& args)
+{
+    M_SreScanner* scanner = M_SRE_SCANNER(M_SrePattern::scanner(context, args));
+    return new (context) M_SreFindIter(scanner);
+}
+
+/* Pattern.sub() and Pattern.subn() */
+static M_BaseObject* pattern_subx(ThreadContext* context, const char* fname,
+                                  const Arguments& args, bool with_count)
+{
+    static Signature sub_signature({"self", "repl", "string", "count"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse(fname, nullptr, sub_signature, scope,
+               {space->wrap_int(context, 0)});
+    M_SrePattern* self = M_SRE_PATTERN(scope[0]);
+    M_BaseObject* repl = scope[1];
+    M_BaseObject* string = scope[2];
+    int count = space->i_get_index(scope[3], space->TypeError_type(), nullptr);
+
+    SreSubject subject;
+    self->load_subject(context, string, subject);
+
+    /* a template without backslashes is used as it is, other templates
+     * are compiled by re._subx() to a string or a function of the match */
+    M_BaseObject* filter = repl;
+    bool callable = is_callable(space, repl);
+    std::string literal;
+
+    if (!callable) {
+        append_item(context, repl, subject.is_bytes, literal);
+        if (literal.find('\\') != std::string::npos) {
+            filter = space->call_function(context,
+                                          re_function(context, "_subx"),
+                                          {self, repl});
+            callable = is_callable(space, filter);
+            literal.clear();
+            if (!callable)
+                append_item(context, filter, subject.is_bytes, literal);
+        }
+    }
+
+    std::string out;
+    long end = subject.length;
+    long pos = 0;
+    long last = 0; /* end of the last replaced match */
+    int n = 0;
+
+    while (pos <= end && (!count || n < count)) {
+        SreState state(pos, end, self->get_groups());
+        if (!sre_search(context, self->get_program(), subject, state)) break;
+
+        long match_start = state.match_start;
+        long match_end = state.match_end;
+        pos = next_start(state);
+
+        if (last < match_start) {
+            append_slice(context, string, last, match_start, out);
+        } else if (last == match_start && last == match_end && n > 0) {
+            /* an empty match right after the last one */
+            continue;
+        }
+
+        if (callable) {
+            M_BaseObject* match =
+                new (context) M_SreMatch(self, string, 0, end, state);
+            M_BaseObject* item = space->call_function(context, filter, {match});
+            if (!space->i_is(item, space->wrap_None()))
+                append_item(context, item, subject.is_bytes, out);
+        } else {
+            out.append(literal);
+        }
+
+        last = match_end;
+        n++;
+    }
+
+    if (last < end) append_slice(context, string, last, end, out);
+
+    M_BaseObject* result =
+        new_string(context, subject.is_bytes, std::move(out));
+    if (!with_count) return result;
+    return space->new_tuple(context, {result, space->wrap_int(context, n)});
+}
+
+M_BaseObject* M_SrePattern::sub(ThreadContext* context, const Arguments& args)
+{
+    return pattern_subx(context, "sub", args, false);
+}
+
+M_BaseObject* M_SrePattern::subn(ThreadContext* context, const Arguments& args)
+{
+    return pattern_subx(context, "subn", args, true);
+}
+
+M_BaseObject* M_SrePattern::split(ThreadContext* context,
+                                  const Arguments& args)
+{
+    static Signature split_signature({"self", "string", "maxsplit"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("split", nullptr, split_signature, scope,
+               {space->wrap_int(context, 0)});
+    M_SrePattern* self = M_SRE_PATTERN(scope[0]);
+    M_BaseObject* string = scope[1];
+    int maxsplit =
+        space->i_get_index(scope[2], space->TypeError_type(), nullptr);
+
+    SreSubject subject;
+    self->load_subject(context, string, subject);
+
+    std::vector<M_BaseObject*> items;
+    long end = subject.length;
+    long pos = 0;
+    long last = 0;
+    int n = 0;
+
+    while (pos <= end && (!maxsplit || n < maxsplit)) {
+        SreState state(pos, end, self->groups);
+        if (!sre_search(context, *self->program, subject, state)) break;
+
+        if (state.match_start == state.match_end) {
+            /* empty matches do not split */
+            if (last == end) break;
+            pos = state.match_end + 1;
+            continue;
+        }
+
+        items.push_back(string_slice(context, string, last, state.match_start));
+        for (std::size_t i = 1; i <= self->groups; i++) {
+            long group_start, group_end;
+            state.get_span(i, group_start, group_end);
+            items.push_back(group_start < 0
+                                ? space->wrap_None()
+                                : string_slice(context, string, group_start,
+                                               group_end));
+        }
+
+        n++;
+        last = pos = state.match_end;
+    }
+
+    items.push_back(string_slice(context, string, last, end));
+    return space->new_list(context, items);
+}
+
+M_BaseObject* M_SrePattern::pattern_get(ThreadContext* context,
+                                        M_BaseObject* self)
+{
+    return M_SRE_PATTERN(self)->pattern;
+}
+
+M_BaseObject* M_SrePattern::flags_get(ThreadContext* context,
+                                      M_BaseObject* self)
+{
+    return context->get_space()->wrap_int(context, M_SRE_PATTERN(self)->flags);
+}
+
+M_BaseObject* M_SrePattern::groups_get(ThreadContext* context,
+                                       M_BaseObject* self)
+{
+    return context->get_space()->wrap_int(context,
+                                          (int)M_SRE_PATTERN(self)->groups);
+}
+
+M_BaseObject* M_SrePattern::groupindex_get(ThreadContext* context,
+                                           M_BaseObject* self)
+{
+    return M_SRE_PATTERN(self)->groupindex;
+}
+
+Typedef* M_SrePattern::_pattern_typedef()
+{
+    static Typedef pattern_typedef(
+        "SRE_Pattern",
+        {
+            {"match", new InterpFunctionWrapper("match", M_SrePattern::match)},
+            {"fullmatch",
+             new InterpFunctionWrapper("fullmatch", M_SrePattern::fullmatch)},
+            {"search",
+             new InterpFunctionWrapper("search", M_SrePattern::search)},
+            {"findall",
+             new InterpFunctionWrapper("findall", M_SrePattern::findall)},
+            {"finditer",
+             new InterpFunctionWrapper("finditer", M_SrePattern::finditer)},
+            {"scanner",
+             new InterpFunctionWrapper("scanner", M_SrePattern::scanner)},
+            {"sub", new InterpFunctionWrapper("sub", M_SrePattern::sub)},
+            {"subn", new InterpFunctionWrapper("subn", M_SrePattern::subn)},
+            {"split", new InterpFunctionWrapper("split", M_SrePattern::split)},
+            {"pattern", new GetSetDescriptor(M_SrePattern::pattern_get)},
+            {"flags", new GetSetDescriptor(M_SrePattern::flags_get)},
+            {"groups", new GetSetDescriptor(M_SrePattern::groups_get)},
+            {"groupindex", new GetSetDescriptor(M_SrePattern::groupindex_get)},
+        });
+
+    return &pattern_typedef;
+}
+
+Typedef* M_SrePattern::get_typedef() { return _pattern_typedef(); }
+
+M_SreMatch::M_SreMatch(M_SrePattern* pattern, M_BaseObject* string, long pos,
+                       long endpos, const SreState& state)
+    : pattern(pattern), string(string), pos(pos), endpos(endpos),
+      regs(2 * (pattern->get_groups() + 1)), lastindex(state.lastindex)
+{
+    for (std::size_t i = 0; i <= pattern->get_groups(); i++)
+        state.get_span(i, regs[2 * i], regs[2 * i + 1]);
+}
+
+M_BaseObject* M_SreMatch::get_group(ThreadContext* context, std::size_t i,
+                                    M_BaseObject* default_value)
+{
+    if (regs[2 * i] < 0) return default_value;
+    return string_slice(context, string, regs[2 * i], regs[2 * i + 1]);
+}
+
+/* Group number of a group argument, which is a number or a name */
+static std::size_t group_index(ThreadContext* context, M_SrePattern* pattern,
+                               M_BaseObject* group)
+{
+    ObjSpace* space = context->get_space();
+
+    if (dynamic_cast<M_StdUnicodeObject*>(group)) {
+        group = space->finditem(pattern->get_groupindex(), group);
+        if (!group) {
+            throw InterpError(space->IndexError_type(),
+                              space->wrap_str(context, "no such group"));
+        }
+    }
+
+    int index = space->i_get_index(group, space->IndexError_type(), nullptr);
+    if (index < 0 || (std::size_t)index > pattern->get_groups()) {
+        throw InterpError(space->IndexError_type(),
+                          space->wrap_str(context, "no such group"));
+    }
+
+    return index;
+}
+
+M_BaseObject* M_SreMatch::__repr__(ThreadContext* context, M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_SreMatch* match = M_SRE_MATCH(self);
+
+    std::string text =
+        space->unwrap_str(space->repr(match->get_group(context, 0, nullptr)));
+    return space->wrap_str(
+        context, "<_sre.SRE_Match object; span=(" +
+                     std::to_string(match->regs[0]) + ", " +
+                     std::to_string(match->regs[1]) + "), match=" + text +
+                     ">");
+}
+
+M_BaseObject* M_SreMatch::group(ThreadContext* context, const Arguments& args)
+{
+    ObjSpace* space = context->get_space();
+    M_SreMatch* match = M_SRE_MATCH(args[0]);
+    M_BaseObject* none = space->wrap_None();
+
+    if (args.size() == 1) return match->get_group(context, 0, none);
+    if (args.size() == 2) {
+        return match->get_group(
+            context, group_index(context, match->pattern, args[1]),
+            none);
+    }
+
+    std::vector<M_BaseObject*> values;
+    for (std::size_t i = 1; i < args.size(); i++) {
+        values.push_back(match->get_group(
+            context, group_index(context, match->pattern, args[i]),
+            none));
+    }
+    return space->new_tuple(context, values);
+}
+
+M_BaseObject* M_SreMatch::groups(ThreadContext* context, const Arguments& args)
+{
+    static Signature groups_signature({"self", "default"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("groups", nullptr, groups_signature, scope,
+               {space->wrap_None()});
+    M_SreMatch* match = M_SRE_MATCH(scope[0]);
+
+    std::vector<M_BaseObject*> values;
+    for (std::size_t i = 1; i <= match->pattern->get_groups(); i++)
+        values.push_back(match->get_group(context, i, scope[1]));
+    return space->new_tuple(context, values);
+}
+
+M_BaseObject* M_SreMatch::groupdict(ThreadContext* context,
+                                    const Arguments& args)
+{
+    static Signature groupdict_signature({"self", "default"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("groupdict", nullptr, groupdict_signature, scope,
+               {space->wrap_None()});
+    M_SreMatch* match = M_SRE_MATCH(scope[0]);
+    M_BaseObject* groupindex = match->pattern->get_groupindex();
+
+    M_BaseObject* dict = space->new_dict(context);
+    std::vector<M_BaseObject*> names;
+    space->unpack_iterable(groupindex, names);
+    for (auto* name : names) {
+        std::size_t i = group_index(context, match->pattern, name);
+        space->setitem(dict, name, match->get_group(context, i, scope[1]));
+    }
+    return dict;
+}
+
+/* Group number of the optional group argument of start(), end() and
+ * span() */
+static std::size_t span_group(ThreadContext* context, const char* fname,
+                              const Arguments& args)
+{
+    static Signature span_signature({"self", "group"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse(fname, nullptr, span_signature, scope,
+               {space->wrap_int(context, 0)});
+    M_SreMatch* match = M_SRE_MATCH(scope[0]);
+
+    return group_index(context, match->get_pattern(), scope[1]);
+}
+
+M_BaseObject* M_SreMatch::start(ThreadContext* context, const Arguments& args)
+{
+    std::size_t i = span_group(context, "start", args);
+    return context->get_space()->wrap_int(context,
+                                          M_SRE_MATCH(args[0])->regs[2 * i]);
+}
+
+M_BaseObject* M_SreMatch::end(ThreadContext* context, const Arguments& args)
+{
+    std::size_t i = span_group(context, "end", args);
+    return context->get_space()->wrap_int(
+        context, M_SRE_MATCH(args[0])->regs[2 * i + 1]);
+}
+
+M_BaseObject* M_SreMatch::span(ThreadContext* context, const Arguments& args)
+{
+    ObjSpace* space = context->get_space();
+    M_SreMatch* match = M_SRE_MATCH(args[0]);
+    std::size_t i = span_group(context, "span", args);
+
+    return space->new_tuple(
+        context, {space->wrap_int(context, match->regs[2 * i]),
+                  space->wrap_int(context, match->regs[2 * i + 1])});
+}
+
+M_BaseObject* M_SreMatch::expand(ThreadContext* context, M_BaseObject* self,
+                                 M_BaseObject* templ)
+{
+    ObjSpace* space = context->get_space();
+    return space->call_function(context, re_function(context, "_expand"),
+                                {M_SRE_MATCH(self)->pattern, self, templ});
+}
+
+M_BaseObject* M_SreMatch::string_get(ThreadContext* context,
+                                     M_BaseObject* self)
+{
+    return M_SRE_MATCH(self)->string;
+}
+
+M_BaseObject* M_SreMatch::re_get(ThreadContext* context, M_BaseObject* self)
+{
+    return M_SRE_MATCH(self)->pattern;
+}
+
+M_BaseObject* M_SreMatch::pos_get(ThreadContext* context, M_BaseObject* self)
+{
+    return context->get_space()->wrap_int(context, M_SRE_MATCH(self)->pos);
+}
+
+M_BaseObject* M_SreMatch::endpos_get(ThreadContext* context,
+                                     M_BaseObject* self)
+{
+    return context->get_space()->wrap_int(context, M_SRE_MATCH(self)->endpos);
+}
+
+M_BaseObject* M_SreMatch::lastindex_get(ThreadContext* context,
+                                        M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    int lastindex = M_SRE_MATCH(self)->lastindex;
+
+    if (lastindex < 0) return space->wrap_None();
+    return space->wrap_int(context, lastindex);
+}
+
+M_BaseObject* M_SreMatch::lastgroup_get(ThreadContext* context,
+                                        M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_SreMatch* match = M_SRE_MATCH(self);
+    M_BaseObject* indexgroup = match->pattern->get_indexgroup();
+
+    if (match->lastindex < 0 || space->i_is(indexgroup, space->wrap_None()))
+        return space->wrap_None();
+    return space->getitem(indexgroup,
+                          space->wrap_int(context, match->lastindex));
+}
+
+M_BaseObject* M_SreMatch::regs_get(ThreadContext* context, M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_SreMatch* match = M_SRE_MATCH(self);
+
+    std::vector<M_BaseObject*> spans;
+    for (std::size_t i = 0; i < match->regs.size(); i += 2) {
+        spans.push_back(space->new_tuple(
+            context, {space->wrap_int(context, match->regs[i]),
+                      space->wrap_int(context, match->regs[i + 1])}));
+    }
+    return space->new_tuple(context, spans);
+}
+
+Typedef* M_SreMatch::_match_typedef()
+{
+    static Typedef match_typedef(
+        "SRE_Match",
+        {
+            {"__repr__",
+             new InterpFunctionWrapper("__repr__", M_SreMatch::__repr__)},
+            {"group", new InterpFunctionWrapper("group", M_SreMatch::group)},
+            {"groups", new InterpFunctionWrapper("groups", M_SreMatch::groups)},
+            {"groupdict",
+             new InterpFunctionWrapper("groupdict", M_SreMatch::groupdict)},
+            {"start", new InterpFunctionWrapper("start", M_SreMatch::start)},
+            {"end", new InterpFunctionWrapper("end", M_SreMatch::end)},
+            {"span", new InterpFunctionWrapper("span", M_SreMatch::span)},
+            {"expand", new InterpFunctionWrapper("expand", M_SreMatch::expand)},
+            {"string", new GetSetDescriptor(M_SreMatch::string_get)},
+            {"re", new GetSetDescriptor(M_SreMatch::re_get)},
+            {"pos", new GetSetDescriptor(M_SreMatch::pos_get)},
+            {"endpos", new GetSetDescriptor(M_SreMatch::endpos_get)},
+            {"lastindex", new GetSetDescriptor(M_SreMatch::lastindex_get)},
+            {"lastgroup", new GetSetDescriptor(M_SreMatch::lastgroup_get)},
+            {"regs", new GetSetDescriptor(M_SreMatch::regs_get)},
+        });
+
+    return &match_typedef;
+}
+
+Typedef* M_SreMatch::get_typedef() { return _match_typedef(); }
+
+M_SreScanner::M_SreScanner(ThreadContext* context, M_SrePattern* pattern,
+                           M_BaseObject* string, long pos, long endpos)
+    : pattern(pattern), string(string)
+{
+    pattern->load_subject(context, string, subject);
+
+    long length = subject.length;
+    this->pos = pos < 0 ? 0 : (pos > length ? length : pos);
+    this->endpos = endpos < 0 ? 0 : (endpos > length ? length : endpos);
+    start = this->pos;
+}
+
+M_SreMatch* M_SreScanner::next_match(ThreadContext* context, bool search)
+{
+    if (start > endpos) return nullptr;
+
+    SreState state(start, endpos, pattern->get_groups());
+    bool found =
+        search ? sre_search(context, pattern->get_program(), subject, state)
+               : sre_match(context, pattern->get_program(), subject, state);
+    if (!found) {
+        start = endpos + 1;
+        return nullptr;
+    }
+
+    start = next_start(state);
+    return new (context) M_SreMatch(pattern, string, pos, endpos, state);
+}
+
+M_BaseObject* M_SreScanner::match(ThreadContext* context, M_BaseObject* self)
+{
+    M_SreMatch* match = M_SRE_SCANNER(self)->next_match(context, false);
+    return match ? match : context->get_space()->wrap_None();
+}
+
+M_BaseObject* M_SreScanner::search(ThreadContext* context, M_BaseObject* self)
+{
+    M_SreMatch* match = M_SRE_SCANNER(self)->next_match(context, true);
+    return match ? match : context->get_space()->wrap_None();
+}
+
+M_BaseObject* M_SreScanner::pattern_get(ThreadContext* context,
+                                        M_BaseObject* self)
+{
+    return M_SRE_SCANNER(self)->pattern;
+}
+
+Typedef* M_SreScanner::_scanner_typedef()
+{
+    static Typedef scanner_typedef(
+        "SRE_Scanner",
+        {
+            {"match", new InterpFunctionWrapper("match", M_SreScanner::match)},
+            {"search",
+             new InterpFunctionWrapper("search", M_SreScanner::search)},
+            {"pattern", new GetSetDescriptor(M_SreScanner::pattern_get)},
+        });
+
+    return &scanner_typedef;
+}
+
+Typedef* M_SreScanner::get_typedef() { return _scanner_typedef(); }
@@ -0,0 +1,75 @@
+#include <vector>
+
+#include "modules/_sre/sremodule.h"
+#include "modules/_sre/engine.h"
+#include "modules/_sre/pattern.h"
+#include "interpreter/arguments.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+namespace mtpython {
+namespace modules {
+
+static M_BaseObject* sre_compile(ThreadContext* context, const Arguments& args)
+{
+    static Signature compile_signature(
+        {"pattern", "flags", "code", "groups", "groupindex", "indexgroup"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("compile", nullptr, compile_signature, scope,
+               {space->wrap_int(context, 0), space->wrap_None(),
+                space->wrap_None()});
+
+    int flags = space->unwrap_int(scope[1]);
+    int groups = space->unwrap_int(scope[3]);
+    if (groups < 0) groups = 0;
+
+    return new (context)
+        M_SrePattern(scope[0], flags, groups, scope[4], scope[5],
+                     SreProgram::get(context, scope[2], flags));
+}
+
+static M_BaseObject* sre_getcodesize(ThreadContext* context)
+{
+    return context->get_space()->wrap_int(context, SRE_CODESIZE);
+}
+
+static M_BaseObject* sre_getlower_func(ThreadContext* context,
+                                       M_BaseObject* character,
+                                       M_BaseObject* flags)
+{
+    ObjSpace* space = context->get_space();
+    return space->wrap_int(
+        context, (int)sre_getlower(space->unwrap_int(character),
+                                   space->unwrap_int(flags)));
+}
+
+SreModule::SreModule(ObjSpace* space, M_BaseObject* name)
+    : BuiltinModule(space, name)
+{
+    ThreadContext* context = ThreadContext::current_thread();
+
+    add_def("__doc__",
+            space->wrap_str(context, "Regular expression engine of the re "
+                                     "module."));
+    add_def("MAGIC", space->wrap_int(context, SRE_MAGIC));
+    add_def("CODESIZE", space->wrap_int(context, SRE_CODESIZE));
+    add_def("MAXREPEAT", space->wrap_int(context, SRE_MAXREPEAT));
+    add_def("MAXGROUPS", space->wrap_int(context, SRE_MAXGROUPS));
+    add_def("copyright",
+            space->wrap_str(context, "SRE 2.2.2 Copyright (c) 1997-2002 by "
+                                     "Secret Labs AB"));
+    add_def("compile", new InterpFunctionWrapper("compile", sre_compile));
+    add_def("getcodesize",
+            new InterpFunctionWrapper("getcodesize", sre_getcodesize));
+    add_def("getlower",
+            new InterpFunctionWrapper("getlower", sre_getlower_func));
+}
+
+} // namespace modules
+} // namespace mtpython
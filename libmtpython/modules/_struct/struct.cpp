@@ -0,0 +1,677 @@
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include "modules/_struct/struct.h"
+#include "modules/_struct/structmodule.h"
+#include "objects/std/int_object.h"
+#include "objects/std/float_object.h"
+#include "objects/std/bytes_object.h"
+#include "objects/std/bytearray_object.h"
+#include "objects/std/iter_object.h"
+#include "objects/std/tuple_object.h"
+#include "objects/std/unicode_object.h"
+#include "interpreter/typedef.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+#include "interpreter/descriptor.h"
+
+using namespace mtpython::modules;
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+#define M_STRUCT(obj) (static_cast<M_Struct*>(obj))
+
+/* the cache is emptied when it is full, like in CPython */
+#define STRUCT_MAX_CACHE 100
+
+/* values packed with a stack buffer instead of a heap allocation */
+#define STRUCT_STACK_BUFFER 256
+
+static std::mutex cache_mutex;
+static std::unordered_map<std::string, std::shared_ptr<const StructLayout>>
+    layout_cache;
+
+static bool host_is_little_endian()
+{
+    const std::uint16_t one = 1;
+    return *reinterpret_cast<const std::uint8_t*>(&one) == 1;
+}
+
+/* Size of a value of the format code, or 0 if the code is not valid in the
+ * mode */
+static std::size_t code_size(char code, bool native)
+{
+    switch (code) {
+    case 'x':
+    case 'c':
+    case 'b':
+    case 'B':
+    case 's':
+    case 'p':
+        return 1;
+    case '?':
+        return native ? sizeof(bool) : 1;
+    case 'h':
+    case 'H':
+        return native ? sizeof(short) : 2;
+    case 'i':
+    case 'I':
+        return native ? sizeof(int) : 4;
+    case 'l':
+    case 'L':
+        return native ? sizeof(long) : 4;
+    case 'q':
+    case 'Q':
+        return native ? sizeof(long long) : 8;
+    case 'n':
+    case 'N':
+        return native ? sizeof(std::size_t) : 0;
+    case 'P':
+        return native ? sizeof(void*) : 0;
+    case 'f':
+        return 4;
+    case 'd':
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+static bool code_is_signed(char code)
+{
+    return std::strchr("bhilqn", code) != nullptr;
+}
+
+static std::uint64_t load_uint(const std::uint8_t* p, std::size_t size,
+                               bool little)
+{
+    std::uint64_t x = 0;
+
+    if (little) {
+        for (std::size_t i = size; i-- > 0;)
+            x = (x << 8) | p[i];
+    } else {
+        for (std::size_t i = 0; i < size; i++)
+            x = (x << 8) | p[i];
+    }
+
+    return x;
+}
+
+static void store_uint(std::uint8_t* p, std::uint64_t x, std::size_t size,
+                       bool little)
+{
+    if (little) {
+        for (std::size_t i = 0; i < size; i++, x >>= 8)
+            p[i] = (std::uint8_t)x;
+    } else {
+        for (std::size_t i = size; i-- > 0; x >>= 8)
+            p[i] = (std::uint8_t)x;
+    }
+}
+
+static InterpError struct_error(ThreadContext* context, const std::string& msg)
+{
+    return InterpError(StructModule::get_error_type(),
+                       context->get_space()->wrap_str(context, msg));
+}
+
+std::shared_ptr<const StructLayout>
+StructLayout::compile(ThreadContext* context, const std::string& format)
+{
+    std::shared_ptr<StructLayout> layout(new StructLayout());
+    std::size_t i = 0;
+    bool native = true;
+
+    layout->little_endian = host_is_little_endian();
+    if (!format.empty() && std::strchr("@=<>!", format[0])) {
+        native = format[0] == '@';
+        if (format[0] == '<')
+            layout->little_endian = true;
+        else if (format[0] == '>' || format[0] == '!')
+            layout->little_endian = false;
+        i++;
+    }
+
+    std::size_t offset = 0;
+    while (i < format.size()) {
+        char c = format[i];
+        if (std::isspace((unsigned char)c)) {
+            i++;
+            continue;
+        }
+
+        std::size_t count = 1;
+        if (std::isdigit((unsigned char)c)) {
+            count = 0;
+            while (i < format.size() && std::isdigit((unsigned char)format[i]))
+                count = count * 10 + (format[i++] - '0');
+            if (i == format.size())
+                throw struct_error(context, "repeat count given without "
+                                            "format specifier");
+            c = format[i];
+        }
+        i++;
+
+        std::size_t size = code_size(c, native);
+        if (!size) throw struct_error(context, "bad char in struct format");
+
+        /* native mode aligns values like a C compiler */
+        if (native && size > 1) offset = (offset + size - 1) / size * size;
+
+        if (c == 's' || c == 'p') {
+            layout->codes.push_back({c, offset, count});
+            offset += count;
+        } else if (c == 'x') {
+            offset += count;
+        } else {
+            for (std::size_t k = 0; k < count; k++, offset += size)
+                layout->codes.push_back({c, offset, size});
+        }
+    }
+    layout->size = offset;
+
+    return layout;
+}
+
+std::shared_ptr<const StructLayout> StructLayout::get(ThreadContext* context,
+                                                      M_BaseObject* format)
+{
+    ObjSpace* space = context->get_space();
+    std::string key;
+
+    if (typeid(*format) == typeid(M_StdUnicodeObject)) {
+        key = space->unwrap_str(format);
+    } else if (typeid(*format) == typeid(M_StdBytesObject)) {
+        Buffer view;
+        space->get_buffer(format, view);
+        key.assign(reinterpret_cast<const char*>(view.buf), view.nbytes());
+    } else {
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "Struct() argument 1 must be a str or "
+                                  "bytes object, not %s",
+                                  space->get_type_name(format).c_str());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto got = layout_cache.find(key);
+        if (got != layout_cache.end()) return got->second;
+    }
+
+    std::shared_ptr<const StructLayout> layout = compile(context, key);
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (layout_cache.size() >= STRUCT_MAX_CACHE) layout_cache.clear();
+    layout_cache[key] = layout;
+
+    return layout;
+}
+
+void StructLayout::clear_cache()
+{
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    layout_cache.clear();
+}
+
+/* Memory of a bytes or bytearray value of 'c', 's' and 'p' codes */
+static void string_value(ThreadContext* context, const StructCode& code,
+                         M_BaseObject* value, Buffer& view)
+{
+    ObjSpace* space = context->get_space();
+
+    if (!dynamic_cast<M_StdBytesObject*>(value) &&
+        !dynamic_cast<M_StdByteArrayObject*>(value)) {
+        if (code.code == 'c')
+            throw struct_error(context, "char format requires a bytes "
+                                        "object of length 1");
+        throw struct_error(context, std::string("argument for '") +
+                                        code.code +
+                                        "' must be a bytes object");
+    }
+
+    space->get_buffer(value, view);
+    if (code.code == 'c' && view.len != 1)
+        throw struct_error(context, "char format requires a bytes object of "
+                                    "length 1");
+}
+
+static void pack_value(ThreadContext* context, const StructCode& code,
+                       M_BaseObject* value, std::uint8_t* dst, bool little)
+{
+    ObjSpace* space = context->get_space();
+    Buffer view;
+
+    switch (code.code) {
+    case 'c':
+        string_value(context, code, value, view);
+        dst[0] = view.buf[0];
+        return;
+    case 's': {
+        string_value(context, code, value, view);
+        std::memcpy(dst, view.buf, std::min(view.len, code.size));
+        return;
+    }
+    case 'p': {
+        string_value(context, code, value, view);
+        if (!code.size) return;
+        std::size_t n = std::min({view.len, code.size - 1, (std::size_t)255});
+        dst[0] = (std::uint8_t)n;
+        std::memcpy(dst + 1, view.buf, n);
+        return;
+    }
+    case '?':
+        dst[0] = space->is_true(value);
+        return;
+    case 'f':
+    case 'd': {
+        if (!dynamic_cast<M_StdIntObject*>(value) &&
+            !dynamic_cast<M_StdFloatObject*>(value))
+            throw struct_error(context, "required argument is not a float");
+
+        double x = space->unwrap_float(value);
+        if (code.code == 'd') {
+            std::uint64_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            store_uint(dst, bits, 8, little);
+            return;
+        }
+
+        float f = (float)x;
+        if (std::isinf(f) && !std::isinf(x)) {
+            throw InterpError(space->OverflowError_type(),
+                              space->wrap_str(context, "float too large to "
+                                                       "pack with f format"));
+        }
+        std::uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        store_uint(dst, bits, 4, little);
+        return;
+    }
+    default:
+        break;
+    }
+
+    if (!dynamic_cast<M_StdIntObject*>(value))
+        throw struct_error(context, "required argument is not an integer");
+
+    long long v = space->unwrap_int(value);
+    unsigned bits = 8 * code.size;
+    if (code_is_signed(code.code)) {
+        if (bits < 64) {
+            long long max = (1LL << (bits - 1)) - 1;
+            if (v < -max - 1 || v > max) {
+                throw InterpError::format(
+                    space, StructModule::get_error_type(),
+                    "'%c' format requires %lld <= number <= %lld", code.code,
+                    -max - 1, max);
+            }
+        }
+    } else if (v < 0 || (bits < 64 && (unsigned long long)v >> bits)) {
+        unsigned long long max =
+            bits < 64 ? (1ULL << bits) - 1
+                      : std::numeric_limits<unsigned long long>::max();
+        throw InterpError::format(space, StructModule::get_error_type(),
+                                  "'%c' format requires 0 <= number <= %llu",
+                                  code.code, max);
+    }
+
+    store_uint(dst, (std::uint64_t)v, code.size, little);
+}
+
+static M_BaseObject* unpack_value(ThreadContext* context,
+                                  const StructCode& code,
+                                  const std::uint8_t* src, bool little)
+{
+    ObjSpace* space = context->get_space();
+
+    switch (code.code) {
+    case 'c':
+        return space->new_bytes(context, src, 1);
+    case 's':
+        return space->new_bytes(context, src, code.size);
+    case 'p': {
+        std::size_t n =
+            code.size ? std::min((std::size_t)src[0], code.size - 1) : 0;
+        return space->new_bytes(context, src + 1, n);
+    }
+    case '?':
+        return space->new_bool(src[0] != 0);
+    case 'f': {
+        std::uint32_t bits = (std::uint32_t)load_uint(src, 4, little);
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return space->wrap_float(context, f);
+    }
+    case 'd': {
+        std::uint64_t bits = load_uint(src, 8, little);
+        double x;
+        std::memcpy(&x, &bits, sizeof(x));
+        return space->wrap_float(context, x);
+    }
+    default:
+        break;
+    }
+
+    std::uint64_t x = load_uint(src, code.size, little);
+    unsigned bits = 8 * code.size;
+    bool fits;
+
+    if (code_is_signed(code.code)) {
+        /* sign-extend to 64 bits */
+        if (bits < 64 && (x >> (bits - 1)) & 1) x |= ~0ULL << bits;
+        long long v = (long long)x;
+        fits = v >= std::numeric_limits<int>::min() &&
+               v <= std::numeric_limits<int>::max();
+    } else {
+        fits = x <= (std::uint64_t)std::numeric_limits<int>::max();
+    }
+
+    if (!fits) {
+        throw InterpError(space->OverflowError_type(),
+                          space->wrap_str(context, "unpacked value does not "
+                                                   "fit in an int"));
+    }
+
+    return space->wrap_int(context, (int)(long long)x);
+}
+
+void StructLayout::pack_values(ThreadContext* context,
+                               M_BaseObject* const* values,
+                               std::uint8_t* dst) const
+{
+    /* padding and the unused parts of strings are zero */
+    std::memset(dst, 0, size);
+
+    for (std::size_t i = 0; i < codes.size(); i++) {
+        pack_value(context, codes[i], values[i], dst + codes[i].offset,
+                   little_endian);
+    }
+}
+
+M_BaseObject* StructLayout::unpack_values(ThreadContext* context,
+                                          const std::uint8_t* src) const
+{
+    M_StdTupleObject* result = M_StdTupleObject::create(context, codes.size());
+
+    for (std::size_t i = 0; i < codes.size(); i++) {
+        (*result)[i] = unpack_value(context, codes[i], src + codes[i].offset,
+                                    little_endian);
+    }
+
+    return result;
+}
+
+static void check_count(ThreadContext* context, const char* fname,
+                        const StructLayout& layout, std::size_t count)
+{
+    if (count == layout.get_count()) return;
+
+    throw InterpError::format(
+        context->get_space(), StructModule::get_error_type(),
+        "%s expected %d items for packing (got %d)", fname,
+        (int)layout.get_count(), (int)count);
+}
+
+M_BaseObject*
+StructLayout::pack(ThreadContext* context, const char* fname,
+                   const std::vector<M_BaseObject*>& values) const
+{
+    ObjSpace* space = context->get_space();
+    check_count(context, fname, *this, values.size());
+
+    if (size <= STRUCT_STACK_BUFFER) {
+        std::uint8_t buf[STRUCT_STACK_BUFFER];
+        pack_values(context, values.data(), buf);
+        return space->new_bytes(context, buf, size);
+    }
+
+    std::vector<std::uint8_t> buf(size);
+    pack_values(context, values.data(), buf.data());
+    return space->new_bytes(context, buf.data(), size);
+}
+
+/* Offset into a buffer of length len, negative offsets count from the end.
+ * Raises struct.error if fewer than size bytes follow it */
+static std::size_t buffer_offset(ThreadContext* context, const char* fname,
+                                 M_BaseObject* offset, std::size_t len,
+                                 std::size_t size)
+{
+    ObjSpace* space = context->get_space();
+    long pos = space->unwrap_int(offset);
+
+    if (pos < 0) pos += (long)len;
+    if (pos < 0 || len - pos < size) {
+        throw InterpError::format(space, StructModule::get_error_type(),
+                                  "%s requires a buffer of at least %d bytes",
+                                  fname, (int)size);
+    }
+
+    return (std::size_t)pos;
+}
+
+void StructLayout::pack_into(ThreadContext* context, M_BaseObject* buffer,
+                             M_BaseObject* offset,
+                             const std::vector<M_BaseObject*>& values) const
+{
+    check_count(context, "pack_into", *this, values.size());
+
+    Buffer view;
+    context->get_space()->get_buffer(buffer, view, true);
+    std::size_t pos =
+        buffer_offset(context, "pack_into", offset, view.nbytes(), size);
+
+    /* packed in place, without a temporary bytes object */
+    pack_values(context, values.data(), view.buf + pos);
+}
+
+M_BaseObject* StructLayout::unpack(ThreadContext* context,
+                                   M_BaseObject* buffer) const
+{
+    Buffer view;
+    context->get_space()->get_buffer(buffer, view);
+
+    if (view.nbytes() != size) {
+        throw InterpError::format(context->get_space(),
+                                  StructModule::get_error_type(),
+                                  "unpack requires a bytes object of length "
+                                  "%d",
+                                  (int)size);
+    }
+
+    return unpack_values(context, view.buf);
+}
+
+M_BaseObject* StructLayout::unpack_from(ThreadContext* context,
+                                        M_BaseObject* buffer,
+                                        M_BaseObject* offset) const
+{
+    Buffer view;
+    context->get_space()->get_buffer(buffer, view);
+    std::size_t pos =
+        buffer_offset(context, "unpack_from", offset, view.nbytes(), size);
+
+    return unpack_values(context, view.buf + pos);
+}
+
+namespace {
+
+/* Unpacks one record per step straight out of the buffer. The buffer is
+ * requested again for every record as its exporter may have been resized */
+class M_StructUnpackIter : public M_StdNativeIterObject {
+private:
+    M_Struct* record;
+    M_BaseObject* buffer;
+    std::size_t offset;
+
+public:
+    M_StructUnpackIter(M_Struct* record, M_BaseObject* buffer)
+        : record(record), buffer(buffer), offset(0)
+    {}
+
+    M_BaseObject* next_item(ThreadContext* context)
+    {
+        const StructLayout& layout = record->get_layout();
+        Buffer view;
+        context->get_space()->get_buffer(buffer, view);
+
+        if (view.nbytes() < offset + layout.get_size()) return nullptr;
+
+        M_BaseObject* values = layout.unpack_values(context, view.buf + offset);
+        offset += layout.get_size();
+        return values;
+    }
+
+    virtual void mark_children(mtpython::gc::GarbageCollector* gc)
+    {
+        gc->mark_object(record);
+        gc->mark_object(buffer);
+    }
+
+    static Typedef* _unpack_iterator_typedef()
+    {
+        static Typedef unpack_iterator_typedef(
+            "unpack_iterator",
+            {
+                {"__iter__", new InterpFunctionWrapper(
+                                 "__iter__", M_StdNativeIterObject::__iter__)},
+                {"__next__", new InterpFunctionWrapper(
+                                 "__next__", M_StdNativeIterObject::__next__)},
+            });
+
+        return &unpack_iterator_typedef;
+    }
+
+    Typedef* get_typedef() { return _unpack_iterator_typedef(); }
+};
+
+} // namespace
+
+M_BaseObject* M_Struct::iter_records(ThreadContext* context,
+                                     M_BaseObject* buffer)
+{
+    std::size_t size = layout->get_size();
+    if (!size)
+        throw struct_error(context, "cannot iteratively unpack with a struct "
+                                    "of length 0");
+
+    Buffer view;
+    context->get_space()->get_buffer(buffer, view);
+    if (view.nbytes() % size) {
+        throw InterpError::format(context->get_space(),
+                                  StructModule::get_error_type(),
+                                  "iterative unpacking requires a bytes "
+                                  "length multiple of %d",
+                                  (int)size);
+    }
+
+    return new (context) M_StructUnpackIter(this, buffer);
+}
+
+M_BaseObject* M_Struct::__new__(ThreadContext* context, const Arguments& args)
+{
+    static Signature new_signature({"type", "format"});
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("Struct", nullptr, new_signature, scope);
+
+    return new (context)
+        M_Struct(scope[1], StructLayout::get(context, scope[1]));
+}
+
+M_BaseObject* M_Struct::pack(ThreadContext* context, const Arguments& args)
+{
+    std::vector<M_BaseObject*> values;
+    for (std::size_t i = 1; i < args.size(); i++)
+        values.push_back(args[i]);
+
+    return M_STRUCT(args[0])->layout->pack(context, "pack", values);
+}
+
+M_BaseObject* M_Struct::pack_into(ThreadContext* context, const Arguments& args)
+{
+    ObjSpace* space = context->get_space();
+    if (args.size() < 3) {
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "pack_into expected "
+                                                   "buffer and offset "
+                                                   "arguments"));
+    }
+
+    std::vector<M_BaseObject*> values;
+    for (std::size_t i = 3; i < args.size(); i++)
+        values.push_back(args[i]);
+
+    M_STRUCT(args[0])->layout->pack_into(context, args[1], args[2], values);
+    return nullptr;
+}
+
+M_BaseObject* M_Struct::unpack(ThreadContext* context, M_BaseObject* self,
+                               M_BaseObject* buffer)
+{
+    return M_STRUCT(self)->layout->unpack(context, buffer);
+}
+
+M_BaseObject* M_Struct::unpack_from(ThreadContext* context,
+                                    const Arguments& args)
+{
+    static Signature unpack_from_signature({"self", "buffer", "offset"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("unpack_from", nullptr, unpack_from_signature, scope,
+               {space->wrap_int(context, 0)});
+
+    return M_STRUCT(scope[0])->layout->unpack_from(context, scope[1],
+                                                    scope[2]);
+}
+
+M_BaseObject* M_Struct::iter_unpack(ThreadContext* context, M_BaseObject* self,
+                                    M_BaseObject* buffer)
+{
+    return M_STRUCT(self)->iter_records(context, buffer);
+}
+
+M_BaseObject* M_Struct::format_get(ThreadContext* context, M_BaseObject* self)
+{
+    return M_STRUCT(self)->format;
+}
+
+M_BaseObject* M_Struct::size_get(ThreadContext* context, M_BaseObject* self)
+{
+    return context->get_space()->wrap_int(
+        context, (int)M_STRUCT(self)->layout->get_size());
+}
+
+Typedef* M_Struct::_struct_typedef()
+{
+    static Typedef struct_typedef(
+        "Struct",
+        {
+            {"__new__",
+             new InterpFunctionWrapper("__new__", M_Struct::__new__)},
+            {"pack", new InterpFunctionWrapper("pack", M_Struct::pack)},
+            {"pack_into",
+             new InterpFunctionWrapper("pack_into", M_Struct::pack_into)},
+            {"unpack", new InterpFunctionWrapper("unpack", M_Struct::unpack)},
+            {"unpack_from",
+             new InterpFunctionWrapper("unpack_from", M_Struct::unpack_from)},
+            {"iter_unpack",
+             new InterpFunctionWrapper("iter_unpack", M_Struct::iter_unpack)},
+            {"format", new GetSetDescriptor(M_Struct::format_get)},
+            {"size", new GetSetDescriptor(M_Struct::size_get)},
+        });
+
+    return &struct_typedef;
+}
+
+Typedef* M_Struct::get_typedef() { return _struct_typedef(); }
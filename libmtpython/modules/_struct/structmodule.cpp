@@ -0,0 +1,138 @@
+#include <vector>
+
+#include "modules/_struct/structmodule.h"
+#include "modules/_struct/struct.h"
+#include "objects/bltin_exceptions.h"
+#include "interpreter/arguments.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+namespace mtpython {
+namespace modules {
+
+M_BaseObject* StructModule::error_type = nullptr;
+
+/* The format argument of a module function, the values that follow it
+ * start at args[first] */
+static M_BaseObject* format_arg(ThreadContext* context, const char* fname,
+                                const Arguments& args, std::size_t first)
+{
+    ObjSpace* space = context->get_space();
+
+    if (args.size() < first) {
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "%s() missing required arguments", fname);
+    }
+
+    return args[0];
+}
+
+static std::vector<M_BaseObject*> values_from(const Arguments& args,
+                                              std::size_t first)
+{
+    std::vector<M_BaseObject*> values;
+    for (std::size_t i = first; i < args.size(); i++)
+        values.push_back(args[i]);
+    return values;
+}
+
+static M_BaseObject* struct_calcsize(ThreadContext* context,
+                                     M_BaseObject* format)
+{
+    return context->get_space()->wrap_int(
+        context, (int)StructLayout::get(context, format)->get_size());
+}
+
+static M_BaseObject* struct_pack(ThreadContext* context, const Arguments& args)
+{
+    M_BaseObject* format = format_arg(context, "pack", args, 1);
+
+    return StructLayout::get(context, format)
+        ->pack(context, "pack", values_from(args, 1));
+}
+
+static M_BaseObject* struct_pack_into(ThreadContext* context,
+                                      const Arguments& args)
+{
+    M_BaseObject* format = format_arg(context, "pack_into", args, 3);
+
+    StructLayout::get(context, format)
+        ->pack_into(context, args[1], args[2], values_from(args, 3));
+    return nullptr;
+}
+
+static M_BaseObject* struct_unpack(ThreadContext* context,
+                                   M_BaseObject* format, M_BaseObject* buffer)
+{
+    return StructLayout::get(context, format)->unpack(context, buffer);
+}
+
+static M_BaseObject* struct_unpack_from(ThreadContext* context,
+                                        const Arguments& args)
+{
+    static Signature unpack_from_signature({"format", "buffer", "offset"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("unpack_from", nullptr, unpack_from_signature, scope,
+               {space->wrap_int(context, 0)});
+
+    return StructLayout::get(context, scope[0])
+        ->unpack_from(context, scope[1], scope[2]);
+}
+
+static M_BaseObject* struct_iter_unpack(ThreadContext* context,
+                                        M_BaseObject* format,
+                                        M_BaseObject* buffer)
+{
+    M_Struct* record =
+        new (context) M_Struct(format, StructLayout::get(context, format));
+    return record->iter_records(context, buffer);
+}
+
+static M_BaseObject* struct__clearcache(ThreadContext* context)
+{
+    StructLayout::clear_cache();
+    return nullptr;
+}
+
+StructModule::StructModule(ObjSpace* space, M_BaseObject* name)
+    : BuiltinModule(space, name)
+{
+    ThreadContext* context = ThreadContext::current_thread();
+
+    M_BaseObject* error_dict = space->new_dict(context);
+    space->setitem(error_dict, space->wrap_str(context, "__module__"),
+                   space->wrap_str(context, "struct"));
+    error_type = space->call_function(
+        context, space->get_type_by_name("type"),
+        {space->wrap_str(context, "error"),
+         space->new_tuple(context, {BaseException::get_bltin_exception_type(
+                                       space, "Exception")}),
+         error_dict});
+
+    add_def("__doc__",
+            space->wrap_str(context, "Functions to convert between Python "
+                                     "values and C structs."));
+    add_def("error", error_type);
+    add_def("Struct", space->get_typeobject(M_Struct::_struct_typedef()));
+    add_def("calcsize",
+            new InterpFunctionWrapper("calcsize", struct_calcsize));
+    add_def("pack", new InterpFunctionWrapper("pack", struct_pack));
+    add_def("pack_into",
+            new InterpFunctionWrapper("pack_into", struct_pack_into));
+    add_def("unpack", new InterpFunctionWrapper("unpack", struct_unpack));
+    add_def("unpack_from",
+            new InterpFunctionWrapper("unpack_from", struct_unpack_from));
+    add_def("iter_unpack",
+            new InterpFunctionWrapper("iter_unpack", struct_iter_unpack));
+    add_def("_clearcache",
+            new InterpFunctionWrapper("_clearcache", struct__clearcache));
+}
+
+} // namespace modules
+} // namespace mtpython
@@ -0,0 +1,1246 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include "modules/array/array.h"
+#include "objects/std/int_object.h"
+#include "objects/std/float_object.h"
+#include "objects/std/iter_object.h"
+#include "objects/std/list_object.h"
+#include "objects/std/slice_object.h"
+#include "objects/std/unicode_object.h"
+#include "interpreter/typedef.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+#include "interpreter/descriptor.h"
+
+using namespace mtpython::modules;
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+#define M_ARRAY(obj) (static_cast<M_Array*>(obj))
+
+/* bytes written to a file per call of write() by tofile() */
+#define ARRAY_BLOCK_SIZE 65536
+
+static const ArrayDescr array_descrs[] = {
+    {'b', sizeof(signed char), "b"},    {'B', sizeof(unsigned char), "B"},
+    {'h', sizeof(short), "h"},          {'H', sizeof(unsigned short), "H"},
+    {'i', sizeof(int), "i"},            {'I', sizeof(unsigned int), "I"},
+    {'l', sizeof(long), "l"},           {'L', sizeof(unsigned long), "L"},
+    {'q', sizeof(long long), "q"},      {'Q', sizeof(unsigned long long), "Q"},
+    {'f', sizeof(float), "f"},          {'d', sizeof(double), "d"},
+};
+
+namespace {
+
+template <typename T> struct TypeTag {
+    using type = T;
+};
+
+} // namespace
+
+/* Call f with the TypeTag of the C type behind typecode, so that the kernels
+ * below are instantiated once per item type */
+template <typename F> static auto visit_items(char typecode, F&& f)
+{
+    switch (typecode) {
+    case 'b':
+        return f(TypeTag<signed char>());
+    case 'B':
+        return f(TypeTag<unsigned char>());
+    case 'h':
+        return f(TypeTag<short>());
+    case 'H':
+        return f(TypeTag<unsigned short>());
+    case 'i':
+        return f(TypeTag<int>());
+    case 'I':
+        return f(TypeTag<unsigned int>());
+    case 'l':
+        return f(TypeTag<long>());
+    case 'L':
+        return f(TypeTag<unsigned long>());
+    case 'q':
+        return f(TypeTag<long long>());
+    case 'Q':
+        return f(TypeTag<unsigned long long>());
+    case 'f':
+        return f(TypeTag<float>());
+    default:
+        return f(TypeTag<double>());
+    }
+}
+
+/* Whether every value of T is representable as an interpreter int */
+template <typename T> static constexpr bool always_fits_int()
+{
+    return std::is_floating_point<T>::value || sizeof(T) < sizeof(int) ||
+           (std::is_signed<T>::value && sizeof(T) == sizeof(int));
+}
+
+template <typename T> static bool fits_int(T value)
+{
+    if constexpr (always_fits_int<T>()) {
+        return true;
+    } else if constexpr (std::is_signed<T>::value) {
+        return (long long)value >= std::numeric_limits<int>::min() &&
+               (long long)value <= std::numeric_limits<int>::max();
+    } else {
+        return (unsigned long long)value <=
+               (unsigned long long)std::numeric_limits<int>::max();
+    }
+}
+
+static void item_overflow(ThreadContext* context)
+{
+    ObjSpace* space = context->get_space();
+    throw InterpError(space->OverflowError_type(),
+                      space->wrap_str(context, "array item does not fit "
+                                               "in an int"));
+}
+
+template <typename T>
+static M_BaseObject* box_item(ThreadContext* context, T value)
+{
+    ObjSpace* space = context->get_space();
+
+    if constexpr (std::is_floating_point<T>::value) {
+        return space->wrap_float(context, (double)value);
+    } else {
+        if (!fits_int(value)) item_overflow(context);
+        return space->wrap_int(context, (int)value);
+    }
+}
+
+/* Convert value to T and store it at dst */
+template <typename T>
+static void pack_item(ThreadContext* context, M_BaseObject* value,
+                      std::uint8_t* dst)
+{
+    ObjSpace* space = context->get_space();
+    T item;
+
+    if constexpr (std::is_floating_point<T>::value) {
+        item = (T)space->unwrap_float(value);
+    } else {
+        if (!dynamic_cast<M_StdIntObject*>(value)) {
+            throw InterpError::format(space, space->TypeError_type(),
+                                      "integer argument expected, got %s",
+                                      space->get_type_name(value).c_str());
+        }
+
+        long long v = space->unwrap_int(value);
+        if (v < (long long)std::numeric_limits<T>::min() ||
+            (v > 0 && (unsigned long long)v >
+                          (unsigned long long)std::numeric_limits<T>::max())) {
+            throw InterpError(space->OverflowError_type(),
+                              space->wrap_str(context, "array item out of "
+                                                       "range"));
+        }
+        item = (T)v;
+    }
+
+    std::memcpy(dst, &item, sizeof(T));
+}
+
+/* Sum of integral items. Four independent accumulators break the dependency
+ * chain between additions so that the compiler vectorizes the loop */
+template <typename T>
+static long long sum_integers(const T* items, std::size_t n)
+{
+    long long acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+    std::size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        acc0 += (long long)items[i];
+        acc1 += (long long)items[i + 1];
+        acc2 += (long long)items[i + 2];
+        acc3 += (long long)items[i + 3];
+    }
+    for (; i < n; i++)
+        acc0 += (long long)items[i];
+
+    return (acc0 + acc1) + (acc2 + acc3);
+}
+
+/* Smallest or largest of n > 0 integral items, with the same lane split as
+ * sum_integers() */
+template <typename T>
+static T extreme_integer(const T* items, std::size_t n, bool largest)
+{
+    T lane[4] = {items[0], items[0], items[0], items[0]};
+    std::size_t i = 0;
+
+    if (largest) {
+        for (; i + 4 <= n; i += 4)
+            for (int k = 0; k < 4; k++)
+                lane[k] = std::max(lane[k], items[i + k]);
+        for (; i < n; i++)
+            lane[0] = std::max(lane[0], items[i]);
+        return std::max(std::max(lane[0], lane[1]), std::max(lane[2], lane[3]));
+    }
+
+    for (; i + 4 <= n; i += 4)
+        for (int k = 0; k < 4; k++)
+            lane[k] = std::min(lane[k], items[i + k]);
+    for (; i < n; i++)
+        lane[0] = std::min(lane[0], items[i]);
+    return std::min(std::min(lane[0], lane[1]), std::min(lane[2], lane[3]));
+}
+
+/* Raise OverflowError unless all items can be boxed, so that a reduction
+ * over them gives the same result as one over the boxed values */
+template <typename T>
+static void check_int_range(ThreadContext* context, const T* items,
+                            std::size_t n)
+{
+    if constexpr (!always_fits_int<T>()) {
+        if (n && (!fits_int(extreme_integer(items, n, false)) ||
+                  !fits_int(extreme_integer(items, n, true))))
+            item_overflow(context);
+    }
+}
+
+const ArrayDescr* M_Array::find_descr(char typecode)
+{
+    for (const auto& descr : array_descrs) {
+        if (descr.typecode == typecode) return &descr;
+    }
+
+    return nullptr;
+}
+
+void M_Array::reserve(ThreadContext* context, std::size_t capacity)
+{
+    std::size_t old_capacity = storage ? storage->size() / itemsize() : 0;
+    if (capacity <= old_capacity) return;
+
+    /* over-allocate like list so that appending takes amortized O(1) */
+    std::size_t new_capacity = capacity + (capacity >> 3) + 8;
+    M_GCArray<std::uint8_t>* new_storage =
+        M_GCArray<std::uint8_t>::create(context, new_capacity * itemsize());
+    if (length)
+        std::memcpy(new_storage->begin(), storage->begin(),
+                    length * itemsize());
+    storage = new_storage;
+}
+
+void M_Array::resize(ThreadContext* context, std::size_t size)
+{
+    if (size > length) {
+        reserve(context, size);
+        std::memset(storage->begin() + length * itemsize(), 0,
+                    (size - length) * itemsize());
+    }
+    length = size;
+}
+
+void M_Array::replace_range(ThreadContext* context, std::size_t lo,
+                            std::size_t hi, const std::uint8_t* src,
+                            std::size_t n)
+{
+    std::size_t new_length = length - (hi - lo) + n;
+    std::size_t size = itemsize();
+    reserve(context, new_length);
+
+    std::uint8_t* p = data();
+    if (p && hi != length)
+        std::memmove(p + (lo + n) * size, p + hi * size, (length - hi) * size);
+    if (n) std::memcpy(p + lo * size, src, n * size);
+    length = new_length;
+}
+
+M_BaseObject* M_Array::get_item(ThreadContext* context, std::size_t i)
+{
+    const std::uint8_t* p = data() + i * itemsize();
+
+    return visit_items(typecode(), [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        T item;
+        std::memcpy(&item, p, sizeof(T));
+        return box_item(context, item);
+    });
+}
+
+void M_Array::set_item(ThreadContext* context, std::size_t i,
+                       M_BaseObject* value)
+{
+    std::uint8_t* p = data() + i * itemsize();
+
+    visit_items(typecode(), [&](auto tag) {
+        pack_item<typename decltype(tag)::type>(context, value, p);
+    });
+}
+
+M_BaseObject* M_Array::sum(ThreadContext* context, M_BaseObject* start)
+{
+    ObjSpace* space = context->get_space();
+    bool int_start = typeid(*start) == typeid(M_StdIntObject);
+    bool float_start = typeid(*start) == typeid(M_StdFloatObject);
+    if (!int_start && !float_start) return nullptr;
+
+    return visit_items(typecode(), [&](auto tag) -> M_BaseObject* {
+        using T = typename decltype(tag)::type;
+        const T* items = reinterpret_cast<const T*>(data());
+
+        if constexpr (std::is_integral<T>::value) {
+            check_int_range(context, items, length);
+        }
+
+        if (std::is_integral<T>::value && int_start) {
+
+            long long total = M_STDINTOBJECT(start)->get_value() +
+                              sum_integers(items, length);
+            if (total < std::numeric_limits<int>::min() ||
+                total > std::numeric_limits<int>::max()) {
+                throw InterpError(space->OverflowError_type(),
+                                  space->wrap_str(context, "sum does not "
+                                                           "fit in an int"));
+            }
+
+            return space->wrap_int(context, (int)total);
+        }
+
+        /* floating point addition is not associative, the items are added
+         * one by one from the left like the boxed values would be */
+        double total = int_start ? M_STDINTOBJECT(start)->get_value()
+                                 : M_STDFLOATOBJECT(start)->get_value();
+        for (std::size_t i = 0; i < length; i++)
+            total += (double)items[i];
+
+        return space->wrap_float(context, total);
+    });
+}
+
+M_BaseObject* M_Array::extreme(ThreadContext* context, bool largest)
+{
+    return visit_items(typecode(), [&](auto tag) -> M_BaseObject* {
+        using T = typename decltype(tag)::type;
+        const T* items = reinterpret_cast<const T*>(data());
+
+        if constexpr (std::is_integral<T>::value) {
+            return box_item(context, extreme_integer(items, length, largest));
+        } else {
+            /* NaNs and signed zeros make the result depend on the order of
+             * the comparisons, keep the one of min() and max() */
+            T best = items[0];
+            for (std::size_t i = 1; i < length; i++) {
+                if (largest ? items[i] > best : items[i] < best)
+                    best = items[i];
+            }
+
+            return box_item(context, best);
+        }
+    });
+}
+
+/* Index of the first item equal to value at or after start, or -1. Exact
+ * ints and floats are compared with the unboxed items */
+static long find_item(ThreadContext* context, M_Array* array,
+                      M_BaseObject* value, std::size_t start)
+{
+    ObjSpace* space = context->get_space();
+    bool is_int = typeid(*value) == typeid(M_StdIntObject);
+    bool is_float = typeid(*value) == typeid(M_StdFloatObject);
+    std::size_t n = array->size();
+
+    if (is_int || is_float) {
+        double fv = is_int ? M_STDINTOBJECT(value)->get_value()
+                           : M_STDFLOATOBJECT(value)->get_value();
+        long long iv = is_int ? M_STDINTOBJECT(value)->get_value() : 0;
+
+        return visit_items(array->typecode(), [&](auto tag) -> long {
+            using T = typename decltype(tag)::type;
+            const T* items = reinterpret_cast<const T*>(array->data());
+
+            for (std::size_t i = start; i < n; i++) {
+                bool equal;
+                if constexpr (std::is_floating_point<T>::value) {
+                    equal = (double)items[i] == fv;
+                } else if (is_float) {
+                    equal = (double)items[i] == fv;
+                } else if constexpr (std::is_unsigned<T>::value) {
+                    equal = iv >= 0 && (unsigned long long)items[i] ==
+                                           (unsigned long long)iv;
+                } else {
+                    equal = (long long)items[i] == iv;
+                }
+
+                if (equal) return (long)i;
+            }
+            return -1;
+        });
+    }
+
+    for (std::size_t i = start; i < array->size(); i++) {
+        if (space->i_eq(array->get_item(context, i), value)) return (long)i;
+    }
+
+    return -1;
+}
+
+static std::size_t array_index(ThreadContext* context, M_Array* array,
+                               M_BaseObject* index, const char* msg)
+{
+    ObjSpace* space = context->get_space();
+
+    int i = space->i_get_index(index, space->IndexError_type(),
+                               space->wrap_str(context, "array index"));
+    int size = (int)array->size();
+
+    if (i < 0) i += size;
+    if (i < 0 || i >= size)
+        throw InterpError(space->IndexError_type(),
+                          space->wrap_str(context, msg));
+
+    return (std::size_t)i;
+}
+
+static M_Array* check_same_kind(ThreadContext* context, M_Array* array,
+                                M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_Array* as_array = dynamic_cast<M_Array*>(other);
+
+    if (!as_array) {
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "can only extend with array (not \"%s\")",
+                                  space->get_type_name(other).c_str());
+    }
+    if (as_array->typecode() != array->typecode()) {
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "can only extend with "
+                                                   "array of same kind"));
+    }
+
+    return as_array;
+}
+
+/* Append the items of iterable, which are converted before the array is
+ * changed if it is a list */
+static void extend_items(ThreadContext* context, M_Array* array,
+                         M_BaseObject* iterable)
+{
+    ObjSpace* space = context->get_space();
+    std::size_t size = array->itemsize();
+
+    if (M_Array* other = dynamic_cast<M_Array*>(iterable)) {
+        if (other->typecode() == array->typecode()) {
+            /* copy first, other may be array itself */
+            std::vector<std::uint8_t> bytes(other->data(),
+                                            other->data() +
+                                                other->size() * size);
+            array->replace_range(context, array->size(), array->size(),
+                                 bytes.data(), other->size());
+            return;
+        }
+    }
+
+    M_BaseObject* it = space->iter(iterable);
+    std::vector<std::uint8_t> bytes;
+    M_BaseObject* item;
+
+    while ((item = space->next_item(it)) != nullptr) {
+        bytes.resize(bytes.size() + size);
+        visit_items(array->typecode(), [&](auto tag) {
+            pack_item<typename decltype(tag)::type>(
+                context, item, bytes.data() + bytes.size() - size);
+        });
+    }
+
+    array->replace_range(context, array->size(), array->size(), bytes.data(),
+                         bytes.size() / size);
+}
+
+static M_Array* new_array(ThreadContext* context, const ArrayDescr* descr,
+                          const std::uint8_t* src, std::size_t n)
+{
+    M_Array* array = new (context) M_Array(descr);
+    array->replace_range(context, 0, 0, src, n);
+    return array;
+}
+
+M_BaseObject* M_Array::__new__(ThreadContext* context, const Arguments& args)
+{
+    static Signature new_signature({"type", "typecode", "initializer"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("array", nullptr, new_signature, scope, {nullptr});
+
+    if (typeid(*scope[1]) != typeid(M_StdUnicodeObject)) {
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "array() argument 1 must be a unicode "
+                                  "character, not %s",
+                                  space->get_type_name(scope[1]).c_str());
+    }
+
+    std::string code = space->unwrap_str(scope[1]);
+    const ArrayDescr* descr = code.size() == 1 ? find_descr(code[0]) : nullptr;
+    if (!descr) {
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "bad typecode (must be b, "
+                                                   "B, h, H, i, I, l, L, q, "
+                                                   "Q, f or d)"));
+    }
+
+    M_Array* array = new (context) M_Array(descr);
+    M_BaseObject* init = scope[2];
+    if (!init) return array;
+
+    if (typeid(*init) == typeid(M_StdUnicodeObject)) {
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "cannot use a str to initialize an array "
+                                  "with typecode '%c'",
+                                  descr->typecode);
+    }
+
+    if (!dynamic_cast<M_Array*>(init)) {
+        Buffer view;
+        bool has_buffer = true;
+        try {
+            init->get_buffer(space, view);
+        } catch (const mtpython::NotImplementedException&) {
+            has_buffer = false;
+        }
+
+        if (has_buffer) {
+            frombytes(context, array, init);
+            return array;
+        }
+    }
+
+    extend_items(context, array, init);
+    return array;
+}
+
+M_BaseObject* M_Array::__repr__(ThreadContext* context, M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_Array* array = M_ARRAY(self);
+
+    std::string str = "array('";
+    str += array->typecode();
+    str += "'";
+    if (array->size()) {
+        str += ", ";
+        str += space->unwrap_str(space->repr(tolist(context, self)));
+    }
+    str += ")";
+
+    return space->wrap_str(context, str);
+}
+
+M_BaseObject* M_Array::__len__(ThreadContext* context, M_BaseObject* self)
+{
+    return context->get_space()->wrap_int(context, (int)M_ARRAY(self)->size());
+}
+
+namespace {
+
+class M_ArrayIter : public M_StdNativeIterObject {
+private:
+    M_Array* array;
+    std::size_t index;
+
+public:
+    M_ArrayIter(M_Array* array) : array(array), index(0) {}
+
+    M_BaseObject* next_item(ThreadContext* context)
+    {
+        if (index >= array->size()) return nullptr;
+        return array->get_item(context, index++);
+    }
+
+    virtual void mark_children(mtpython::gc::GarbageCollector* gc)
+    {
+        gc->mark_object(array);
+    }
+
+    static Typedef* _array_iterator_typedef()
+    {
+        static Typedef array_iterator_typedef(
+            "arrayiterator",
+            {
+                {"__iter__", new InterpFunctionWrapper(
+                                 "__iter__", M_StdNativeIterObject::__iter__)},
+                {"__next__", new InterpFunctionWrapper(
+                                 "__next__", M_StdNativeIterObject::__next__)},
+            });
+
+        return &array_iterator_typedef;
+    }
+
+    Typedef* get_typedef() { return _array_iterator_typedef(); }
+};
+
+} // namespace
+
+M_BaseObject* M_Array::__iter__(ThreadContext* context, M_BaseObject* self)
+{
+    return new (context) M_ArrayIter(M_ARRAY(self));
+}
+
+M_BaseObject* M_Array::__contains__(ThreadContext* context, M_BaseObject* self,
+                                    M_BaseObject* value)
+{
+    return context->get_space()->new_bool(
+        find_item(context, M_ARRAY(self), value, 0) >= 0);
+}
+
+M_BaseObject* M_Array::__getitem__(ThreadContext* context, M_BaseObject* self,
+                                   M_BaseObject* index)
+{
+    ObjSpace* space = context->get_space();
+    M_Array* array = M_ARRAY(self);
+
+    M_StdSliceObject* slice = dynamic_cast<M_StdSliceObject*>(index);
+    if (!slice) {
+        std::size_t i =
+            array_index(context, array, index, "array index out of range");
+        return array->get_item(context, i);
+    }
+
+    long start, stop, step;
+    std::size_t n = slice->unpack_indices(space, array->size(), start, stop,
+                                          step);
+    std::size_t size = array->itemsize();
+
+    if (step == 1)
+        return new_array(context, array->descr, array->data() + start * size,
+                         n);
+
+    M_Array* result = new (context) M_Array(array->descr);
+    result->resize(context, n);
+    for (std::size_t i = 0; i < n; i++, start += step)
+        std::memcpy(result->data() + i * size, array->data() + start * size,
+                    size);
+
+    return result;
+}
+
+M_BaseObject* M_Array::__setitem__(ThreadContext* context, M_BaseObject* self,
+                                   M_BaseObject* index, M_BaseObject* value)
+{
+    ObjSpace* space = context->get_space();
+    M_Array* array = M_ARRAY(self);
+
+    M_StdSliceObject* slice = dynamic_cast<M_StdSliceObject*>(index);
+    if (!slice) {
+        std::size_t i =
+            array_index(context, array, index, "array assignment index out "
+                                               "of range");
+        array->set_item(context, i, value);
+        return nullptr;
+    }
+
+    M_Array* other = dynamic_cast<M_Array*>(value);
+    if (!other) {
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "can only assign array (not \"%s\") to "
+                                  "array slice",
+                                  space->get_type_name(value).c_str());
+    }
+    if (other->typecode() != array->typecode()) {
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "bad argument type for "
+                                                   "built-in operation"));
+    }
+
+    long start, stop, step;
+    std::size_t n = slice->unpack_indices(space, array->size(), start, stop,
+                                          step);
+    std::size_t size = array->itemsize();
+
+    /* copy the new items first, value may be self */
+    std::vector<std::uint8_t> items(other->data(),
+                                    other->data() + other->size() * size);
+
+    if (step == 1) {
+        array->replace_range(context, start, start + n, items.data(),
+                             other->size());
+        return nullptr;
+    }
+
+    if (other->size() != n) {
+        throw InterpError::format(space, space->ValueError_type(),
+                                  "attempt to assign array of size %d to "
+                                  "extended slice of size %d",
+                                  (int)other->size(), (int)n);
+    }
+
+    for (std::size_t i = 0; i < n; i++, start += step)
+        std::memcpy(array->data() + start * size, items.data() + i * size,
+                    size);
+
+    return nullptr;
+}
+
+M_BaseObject* M_Array::__delitem__(ThreadContext* context, M_BaseObject* self,
+                                   M_BaseObject* index)
+{
+    ObjSpace* space = context->get_space();
+    M_Array* array = M_ARRAY(self);
+
+    M_StdSliceObject* slice = dynamic_cast<M_StdSliceObject*>(index);
+    if (!slice) {
+        std::size_t i = array_index(context, array, index,
+                                    "array assignment index out of range");
+        array->replace_range(context, i, i + 1, nullptr, 0);
+        return nullptr;
+    }
+
+    long start, stop, step;
+    std::size_t n = slice->unpack_indices(space, array->size(), start, stop,
+                                          step);
+    if (n == 0) return nullptr;
+
+    if (step == 1) {
+        array->replace_range(context, start, start + n, nullptr, 0);
+        return nullptr;
+    }
+
+    if (step < 0) {
+        start += step * (long)(n - 1);
+        step = -step;
+    }
+
+    /* compact the survivors in a single pass */
+    std::uint8_t* p = array->data();
+    std::size_t size = array->itemsize();
+    std::size_t dst = start, next = start, deleted = 0;
+    for (std::size_t src = start; src < array->size(); src++) {
+        if (deleted < n && src == next) {
+            deleted++;
+            next += step;
+            continue;
+        }
+        std::memcpy(p + dst++ * size, p + src * size, size);
+    }
+    array->length = dst;
+
+    return nullptr;
+}
+
+namespace {
+
+enum class CompareOp { EQ, NE, LT, LE, GT, GE };
+
+} // namespace
+
+/* Compare two arrays like sequences: the first pair of unequal items decides,
+ * otherwise the lengths do. Arrays of the same kind are scanned without
+ * boxing the items */
+static M_BaseObject* compare_arrays(ThreadContext* context, M_BaseObject* self,
+                                    M_BaseObject* other, CompareOp op)
+{
+    ObjSpace* space = context->get_space();
+    M_Array* a = M_ARRAY(self);
+    M_Array* b = dynamic_cast<M_Array*>(other);
+    if (!b) return space->wrap_NotImplemented();
+
+    if (a->size() != b->size() && (op == CompareOp::EQ || op == CompareOp::NE))
+        return space->new_bool(op == CompareOp::NE);
+
+    std::size_t n = std::min(a->size(), b->size());
+    std::size_t i = 0;
+
+    if (a->typecode() == b->typecode()) {
+        i = visit_items(a->typecode(), [&](auto tag) {
+            using T = typename decltype(tag)::type;
+            const T* x = reinterpret_cast<const T*>(a->data());
+            const T* y = reinterpret_cast<const T*>(b->data());
+
+            std::size_t j = 0;
+            while (j < n && x[j] == y[j])
+                j++;
+            return j;
+        });
+    } else {
+        while (i < n &&
+               space->i_eq(a->get_item(context, i), b->get_item(context, i)))
+            i++;
+    }
+
+    if (i == n) {
+        std::size_t la = a->size(), lb = b->size();
+        switch (op) {
+        case CompareOp::EQ:
+            return space->new_bool(la == lb);
+        case CompareOp::NE:
+            return space->new_bool(la != lb);
+        case CompareOp::LT:
+            return space->new_bool(la < lb);
+        case CompareOp::LE:
+            return space->new_bool(la <= lb);
+        case CompareOp::GT:
+            return space->new_bool(la > lb);
+        default:
+            return space->new_bool(la >= lb);
+        }
+    }
+
+    if (op == CompareOp::EQ) return space->wrap_False();
+    if (op == CompareOp::NE) return space->wrap_True();
+
+    M_BaseObject* x = a->get_item(context, i);
+    M_BaseObject* y = b->get_item(context, i);
+    switch (op) {
+    case CompareOp::LT:
+        return space->lt(x, y);
+    case CompareOp::LE:
+        return space->le(x, y);
+    case CompareOp::GT:
+        return space->gt(x, y);
+    default:
+        return space->ge(x, y);
+    }
+}
+
+M_BaseObject* M_Array::__eq__(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* other)
+{
+    return compare_arrays(context, self, other, CompareOp::EQ);
+}
+
+M_BaseObject* M_Array::__ne__(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* other)
+{
+    return compare_arrays(context, self, other, CompareOp::NE);
+}
+
+M_BaseObject* M_Array::__lt__(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* other)
+{
+    return compare_arrays(context, self, other, CompareOp::LT);
+}
+
+M_BaseObject* M_Array::__le__(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* other)
+{
+    return compare_arrays(context, self, other, CompareOp::LE);
+}
+
+M_BaseObject* M_Array::__gt__(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* other)
+{
+    return compare_arrays(context, self, other, CompareOp::GT);
+}
+
+M_BaseObject* M_Array::__ge__(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* other)
+{
+    return compare_arrays(context, self, other, CompareOp::GE);
+}
+
+M_BaseObject* M_Array::__add__(ThreadContext* context, M_BaseObject* self,
+                               M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_Array* array = M_ARRAY(self);
+    M_Array* as_array = dynamic_cast<M_Array*>(other);
+
+    if (!as_array) {
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "can only append array (not \"%s\") to "
+                                  "array",
+                                  space->get_type_name(other).c_str());
+    }
+    if (as_array->typecode() != array->typecode()) {
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "bad argument type for "
+                                                   "built-in operation"));
+    }
+
+    M_Array* result = new_array(context, array->descr, array->data(),
+                                array->size());
+    result->replace_range(context, result->size(), result->size(),
+                          as_array->data(), as_array->size());
+    return result;
+}
+
+M_BaseObject* M_Array::__iadd__(ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* other)
+{
+    M_Array* array = M_ARRAY(self);
+
+    extend_items(context, array, check_same_kind(context, array, other));
+    return self;
+}
+
+/* Repeat the items of array in place */
+static void repeat_items(ThreadContext* context, M_Array* array,
+                         M_BaseObject* times)
+{
+    ObjSpace* space = context->get_space();
+    int n = space->i_get_index(times, space->TypeError_type(),
+                               space->wrap_str(context, "count"));
+    std::size_t size = array->size() * array->itemsize();
+
+    if (n <= 0 || !size) {
+        array->resize(context, 0);
+        return;
+    }
+
+    std::size_t count = array->size();
+    array->resize(context, count * n);
+
+    /* double the copied prefix until the array is filled */
+    std::uint8_t* p = array->data();
+    std::size_t filled = size, total = size * n;
+    while (filled < total) {
+        std::size_t chunk = std::min(filled, total - filled);
+        std::memcpy(p + filled, p, chunk);
+        filled += chunk;
+    }
+}
+
+M_BaseObject* M_Array::__mul__(ThreadContext* context, M_BaseObject* self,
+                               M_BaseObject* times)
+{
+    M_Array* array = M_ARRAY(self);
+    M_Array* result =
+        new_array(context, array->descr, array->data(), array->size());
+
+    repeat_items(context, result, times);
+    return result;
+}
+
+M_BaseObject* M_Array::__imul__(ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* times)
+{
+    repeat_items(context, M_ARRAY(self), times);
+    return self;
+}
+
+M_BaseObject* M_Array::append(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* value)
+{
+    M_Array* array = M_ARRAY(self);
+    std::uint8_t item[sizeof(long double)];
+
+    visit_items(array->typecode(), [&](auto tag) {
+        pack_item<typename decltype(tag)::type>(context, value, item);
+    });
+    array->replace_range(context, array->size(), array->size(), item, 1);
+
+    return nullptr;
+}
+
+M_BaseObject* M_Array::extend(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* iterable)
+{
+    M_Array* array = M_ARRAY(self);
+
+    if (dynamic_cast<M_Array*>(iterable))
+        check_same_kind(context, array, iterable);
+    extend_items(context, array, iterable);
+
+    return nullptr;
+}
+
+M_BaseObject* M_Array::insert(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* index, M_BaseObject* value)
+{
+    ObjSpace* space = context->get_space();
+    M_Array* array = M_ARRAY(self);
+    std::uint8_t item[sizeof(long double)];
+
+    int i = space->i_get_index(index, space->TypeError_type(),
+                               space->wrap_str(context, "index"));
+    int size = (int)array->size();
+    if (i < 0) i = std::max(i + size, 0);
+    if (i > size) i = size;
+
+    visit_items(array->typecode(), [&](auto tag) {
+        pack_item<typename decltype(tag)::type>(context, value, item);
+    });
+    array->replace_range(context, i, i, item, 1);
+
+    return nullptr;
+}
+
+M_BaseObject* M_Array::pop(ThreadContext* context, const Arguments& args)
+{
+    static Signature pop_signature({"self", "index"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("pop", nullptr, pop_signature, scope,
+               {space->wrap_int(context, -1)});
+    M_Array* array = M_ARRAY(scope[0]);
+
+    if (!array->size())
+        throw InterpError(space->IndexError_type(),
+                          space->wrap_str(context, "pop from empty array"));
+
+    std::size_t i =
+        array_index(context, array, scope[1], "pop index out of range");
+    M_BaseObject* item = array->get_item(context, i);
+    array->replace_range(context, i, i + 1, nullptr, 0);
+
+    return item;
+}
+
+M_BaseObject* M_Array::remove(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* value)
+{
+    ObjSpace* space = context->get_space();
+    M_Array* array = M_ARRAY(self);
+
+    long i = find_item(context, array, value, 0);
+    if (i < 0)
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "array.remove(x): x not "
+                                                   "in array"));
+
+    array->replace_range(context, i, i + 1, nullptr, 0);
+    return nullptr;
+}
+
+M_BaseObject* M_Array::index(ThreadContext* context, M_BaseObject* self,
+                             M_BaseObject* value)
+{
+    ObjSpace* space = context->get_space();
+
+    long i = find_item(context, M_ARRAY(self), value, 0);
+    if (i < 0)
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "array.index(x): x not "
+                                                   "in list"));
+
+    return space->wrap_int(context, (int)i);
+}
+
+M_BaseObject* M_Array::count(ThreadContext* context, M_BaseObject* self,
+                             M_BaseObject* value)
+{
+    M_Array* array = M_ARRAY(self);
+    int n = 0;
+
+    for (long i = find_item(context, array, value, 0); i >= 0;
+         i = find_item(context, array, value, i + 1))
+        n++;
+
+    return context->get_space()->wrap_int(context, n);
+}
+
+M_BaseObject* M_Array::reverse(ThreadContext* context, M_BaseObject* self)
+{
+    M_Array* array = M_ARRAY(self);
+
+    visit_items(array->typecode(), [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        T* items = reinterpret_cast<T*>(array->data());
+        std::reverse(items, items + array->size());
+    });
+
+    return nullptr;
+}
+
+M_BaseObject* M_Array::byteswap(ThreadContext* context, M_BaseObject* self)
+{
+    M_Array* array = M_ARRAY(self);
+    std::size_t size = array->itemsize();
+    std::uint8_t* p = array->data();
+
+    for (std::size_t i = 0; i < array->size(); i++, p += size)
+        std::reverse(p, p + size);
+
+    return nullptr;
+}
+
+M_BaseObject* M_Array::copy(ThreadContext* context, M_BaseObject* self)
+{
+    M_Array* array = M_ARRAY(self);
+    return new_array(context, array->descr, array->data(), array->size());
+}
+
+M_BaseObject* M_Array::frombytes(ThreadContext* context, M_BaseObject* self,
+                                 M_BaseObject* data)
+{
+    ObjSpace* space = context->get_space();
+    M_Array* array = M_ARRAY(self);
+
+    Buffer view;
+    space->get_buffer(data, view, false, false);
+
+    std::vector<std::uint8_t> bytes(view.nbytes());
+    view.copy_to(bytes.data());
+    if (bytes.size() % array->itemsize()) {
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "bytes length not a "
+                                                   "multiple of item size"));
+    }
+
+    array->replace_range(context, array->size(), array->size(), bytes.data(),
+                         bytes.size() / array->itemsize());
+    return nullptr;
+}
+
+M_BaseObject* M_Array::tobytes(ThreadContext* context, M_BaseObject* self)
+{
+    M_Array* array = M_ARRAY(self);
+    return context->get_space()->new_bytes(
+        context, array->data(), array->size() * array->itemsize());
+}
+
+M_BaseObject* M_Array::fromlist(ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* list)
+{
+    ObjSpace* space = context->get_space();
+
+    if (!dynamic_cast<M_StdListObject*>(list)) {
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "arg must be list"));
+    }
+
+    extend_items(context, M_ARRAY(self), list);
+    return nullptr;
+}
+
+M_BaseObject* M_Array::tolist(ThreadContext* context, M_BaseObject* self)
+{
+    M_Array* array = M_ARRAY(self);
+    std::vector<M_BaseObject*> items;
+
+    items.reserve(array->size());
+    for (std::size_t i = 0; i < array->size(); i++)
+        items.push_back(array->get_item(context, i));
+
+    return context->get_space()->new_list(context, items);
+}
+
+M_BaseObject* M_Array::fromfile(ThreadContext* context, M_BaseObject* self,
+                                M_BaseObject* file, M_BaseObject* n)
+{
+    ObjSpace* space = context->get_space();
+    M_Array* array = M_ARRAY(self);
+
+    int count = space->unwrap_int(n);
+    if (count < 0) {
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "negative count"));
+    }
+
+    std::size_t nbytes = (std::size_t)count * array->itemsize();
+    M_BaseObject* data = space->call_function(
+        context, space->getattr_str(file, "read"),
+        {space->wrap_int(context, (int)nbytes)});
+
+    Buffer view;
+    space->get_buffer(data, view);
+
+    /* the complete items that were read are kept */
+    std::size_t got = std::min(view.nbytes(), nbytes) / array->itemsize();
+    array->replace_range(context, array->size(), array->size(), view.buf,
+                         got);
+
+    if (got < (std::size_t)count) {
+        throw InterpError(space->EOFError_type(),
+                          space->wrap_str(context, "read() didn't return "
+                                                   "enough bytes"));
+    }
+
+    return nullptr;
+}
+
+M_BaseObject* M_Array::tofile(ThreadContext* context, M_BaseObject* self,
+                              M_BaseObject* file)
+{
+    ObjSpace* space = context->get_space();
+    M_Array* array = M_ARRAY(self);
+    M_BaseObject* write = space->getattr_str(file, "write");
+
+    /* write in blocks so that a large array is not copied all at once */
+    std::size_t nbytes = array->size() * array->itemsize();
+    for (std::size_t offset = 0; offset < nbytes; offset += ARRAY_BLOCK_SIZE) {
+        std::size_t chunk =
+            std::min((std::size_t)ARRAY_BLOCK_SIZE, nbytes - offset);
+        space->call_function(
+            context, write,
+            {space->new_bytes(context, array->data() + offset, chunk)});
+    }
+
+    return nullptr;
+}
+
+M_BaseObject* M_Array::typecode_get(ThreadContext* context, M_BaseObject* self)
+{
+    return context->get_space()->wrap_str(
+        context, std::string(1, M_ARRAY(self)->typecode()));
+}
+
+M_BaseObject* M_Array::itemsize_get(ThreadContext* context, M_BaseObject* self)
+{
+    return context->get_space()->wrap_int(context,
+                                          (int)M_ARRAY(self)->itemsize());
+}
+
+Typedef* M_Array::_array_typedef()
+{
+    static Typedef array_typedef(
+        "array",
+        {
+            {"__new__", new InterpFunctionWrapper("__new__", M_Array::__new__)},
+            {"__repr__",
+             new InterpFunctionWrapper("__repr__", M_Array::__repr__)},
+            {"__len__", new InterpFunctionWrapper("__len__", M_Array::__len__)},
+            {"__iter__",
+             new InterpFunctionWrapper("__iter__", M_Array::__iter__)},
+            {"__contains__",
+             new InterpFunctionWrapper("__contains__", M_Array::__contains__)},
+            {"__getitem__",
+             new InterpFunctionWrapper("__getitem__", M_Array::__getitem__)},
+            {"__setitem__",
+             new InterpFunctionWrapper("__setitem__", M_Array::__setitem__)},
+            {"__delitem__",
+             new InterpFunctionWrapper("__delitem__", M_Array::__delitem__)},
+            {"__eq__", new InterpFunctionWrapper("__eq__", M_Array::__eq__)},
+            {"__ne__", new InterpFunctionWrapper("__ne__", M_Array::__ne__)},
+            {"__lt__", new InterpFunctionWrapper("__lt__", M_Array::__lt__)},
+            {"__le__", new InterpFunctionWrapper("__le__", M_Array::__le__)},
+            {"__gt__", new InterpFunctionWrapper("__gt__", M_Array::__gt__)},
+            {"__ge__", new InterpFunctionWrapper("__ge__", M_Array::__ge__)},
+            {"__add__", new InterpFunctionWrapper("__add__", M_Array::__add__)},
+            {"__iadd__",
+             new InterpFunctionWrapper("__iadd__", M_Array::__iadd__)},
+            {"__mul__", new InterpFunctionWrapper("__mul__", M_Array::__mul__)},
+            {"__rmul__",
+             new InterpFunctionWrapper("__rmul__", M_Array::__mul__)},
+            {"__imul__",
+             new InterpFunctionWrapper("__imul__", M_Array::__imul__)},
+            {"__copy__", new InterpFunctionWrapper("__copy__", M_Array::copy)},
+            {"append", new InterpFunctionWrapper("append", M_Array::append)},
+            {"extend", new InterpFunctionWrapper("extend", M_Array::extend)},
+            {"insert", new InterpFunctionWrapper("insert", M_Array::insert)},
+            {"pop", new InterpFunctionWrapper("pop", M_Array::pop)},
+            {"remove", new InterpFunctionWrapper("remove", M_Array::remove)},
+            {"index", new InterpFunctionWrapper("index", M_Array::index)},
+            {"count", new InterpFunctionWrapper("count", M_Array::count)},
+            {"reverse", new InterpFunctionWrapper("reverse", M_Array::reverse)},
+            {"byteswap",
+             new InterpFunctionWrapper("byteswap", M_Array::byteswap)},
+            {"frombytes",
+             new InterpFunctionWrapper("frombytes", M_Array::frombytes)},
+            {"tobytes", new InterpFunctionWrapper("tobytes", M_Array::tobytes)},
+            {"fromlist",
+             new InterpFunctionWrapper("fromlist", M_Array::fromlist)},
+            {"tolist", new InterpFunctionWrapper("tolist", M_Array::tolist)},
+            {"fromfile",
+             new InterpFunctionWrapper("fromfile", M_Array::fromfile)},
+            {"tofile", new InterpFunctionWrapper("tofile", M_Array::tofile)},
+            {"typecode", new GetSetDescriptor(M_Array::typecode_get)},
+            {"itemsize", new GetSetDescriptor(M_Array::itemsize_get)},
+        });
+
+    return &array_typedef;
+}
+
+Typedef* M_Array::get_typedef() { return _array_typedef(); }
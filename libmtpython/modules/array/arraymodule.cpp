@@ -0,0 +1,23 @@
+#include "modules/array/arraymodule.h"
+#include "modules/array/array.h"
+
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+namespace mtpython {
+namespace modules {
+
+ArrayModule::ArrayModule(ObjSpace* space, M_BaseObject* name)
+    : BuiltinModule(space, name)
+{
+    ThreadContext* context = ThreadContext::current_thread();
+    M_BaseObject* array_type = space->get_typeobject(M_Array::_array_typedef());
+
+    add_def("array", array_type);
+    add_def("ArrayType", array_type);
+    add_def("typecodes", space->wrap_str(context, "bBhHiIlLqQfd"));
+}
+
+} // namespace modules
+} // namespace mtpython
@@ -1,10 +1,19 @@
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <vector>
 #include <filesystem>
+#include <typeinfo>
 
 #include "modules/builtins/bltinmodule.h"
+#include "modules/array/array.h"
 #include "objects/bltin_exceptions.h"
+#include "objects/std/iter_object.h"
+#include "objects/std/int_object.h"
+#include "objects/std/float_object.h"
+#include "objects/std/unicode_object.h"
+#include "objects/std/bytes_object.h"
+#include "objects/std/bytearray_object.h"
 #include "interpreter/gateway.h"
 #include "interpreter/function.h"
 #include "interpreter/pycode.h"
@@ -388,6 +397,29 @@ static M_BaseObject* builtin_abs(mtpython::vm::ThreadContext* context,
     return result;
 }
 
+static M_BaseObject* builtin_callable(mtpython::vm::ThreadContext* context,
+                                      M_BaseObject* obj)
+{
+    ObjSpace* space = context->get_space();
+    return space->new_bool(dynamic_cast<Function*>(obj) ||
+                           dynamic_cast<Method*>(obj) ||
+                           space->lookup(obj, "__call__"));
+}
+
+static M_BaseObject* builtin_chr(mtpython::vm::ThreadContext* context,
+                                 M_BaseObject* i)
+{
+    ObjSpace* space = context->get_space();
+    int cp = space->i_get_index(i, space->TypeError_type(), nullptr);
+
+    if (cp < 0 || cp > 0x10ffff)
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context,
+                                          "chr() arg not in range(0x110000)"));
+
+    return space->wrap_str(context, M_StdUnicodeObject::from_code_point(cp));
+}
+
 static M_BaseObject* builtin_compile(mtpython::vm::ThreadContext* context,
                                      const std::vector<M_BaseObject*>& args)
 {
@@ -559,6 +591,12 @@ static M_BaseObject* builtin_iter(mtpython::vm::ThreadContext* context,
     return space->wrap_None();
 }
 
+static M_BaseObject* builtin_hash(mtpython::vm::ThreadContext* context,
+                                  M_BaseObject* obj)
+{
+    return context->get_space()->hash(obj);
+}
+
 static M_BaseObject* builtin_len(mtpython::vm::ThreadContext* context,
                                  M_BaseObject* obj)
 {
@@ -572,6 +610,100 @@ static M_BaseObject* builtin_len(mtpython::vm::ThreadContext* context,
     return result;
 }
 
+/* Shared by min() and max(). Arrays are scanned by their typed kernel when
+ * there is no key function */
+static M_BaseObject* min_max(mtpython::vm::ThreadContext* context,
+                             M_BaseObject* args, M_BaseObject* kwargs,
+                             bool largest)
+{
+    ObjSpace* space = context->get_space();
+    const char* fname = largest ? "max" : "min";
+    std::vector<M_BaseObject*> values;
+    space->unwrap_tuple(args, values);
+
+    M_BaseObject* key = space->finditem_str(kwargs, "key");
+    if (key && space->i_is(key, space->wrap_None())) key = nullptr;
+    M_BaseObject* default_value = space->finditem_str(kwargs, "default");
+
+    if (values.empty()) {
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "%s expected 1 arguments, got 0", fname);
+    }
+    if (values.size() > 1 && default_value) {
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "Cannot specify a default for %s() with "
+                                  "multiple positional arguments",
+                                  fname);
+    }
+
+    if (values.size() == 1) {
+        M_Array* array = dynamic_cast<M_Array*>(values[0]);
+        if (array && !key && array->size())
+            return array->extreme(context, largest);
+
+        M_BaseObject* iterator = space->iter(values[0]);
+        values.clear();
+        while (M_BaseObject* item = space->next_item(iterator))
+            values.push_back(item);
+    }
+
+    M_BaseObject* best = nullptr;
+    M_BaseObject* best_key = nullptr;
+    for (auto* item : values) {
+        M_BaseObject* item_key =
+            key ? space->call_function(context, key, {item}) : item;
+
+        if (!best || (largest ? space->i_lt(best_key, item_key)
+                              : space->i_lt(item_key, best_key))) {
+            best = item;
+            best_key = item_key;
+        }
+    }
+
+    if (best) return best;
+    if (default_value) return default_value;
+
+    throw InterpError::format(space, space->ValueError_type(),
+                              "%s() arg is an empty sequence", fname);
+}
+
+static M_BaseObject* builtin_max(mtpython::vm::ThreadContext* context,
+                                 M_BaseObject* args, M_BaseObject* kwargs)
+{
+    return min_max(context, args, kwargs, true);
+}
+
+static M_BaseObject* builtin_min(mtpython::vm::ThreadContext* context,
+                                 M_BaseObject* args, M_BaseObject* kwargs)
+{
+    return min_max(context, args, kwargs, false);
+}
+
+static M_BaseObject* builtin_ord(mtpython::vm::ThreadContext* context,
+                                 M_BaseObject* c)
+{
+    ObjSpace* space = context->get_space();
+    std::size_t length;
+
+    if (M_StdUnicodeObject* str = dynamic_cast<M_StdUnicodeObject*>(c)) {
+        length = str->char_length();
+        if (length == 1) return space->wrap_int(context, str->code_point(0));
+    } else if (M_StdBytesObject* bytes = dynamic_cast<M_StdBytesObject*>(c)) {
+        length = bytes->size();
+        if (length == 1) return space->wrap_int(context, bytes->data()[0]);
+    } else {
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "ord() expected string of length 1, but %s "
+                                  "found",
+                                  space->get_type_name(c).c_str());
+    }
+
+    throw InterpError::format(space, space->TypeError_type(),
+                              "ord() expected a character, but string of "
+                              "length %d found",
+                              (int)length);
+}
+
 /* The famous print() */
 static M_BaseObject* builtin_print(mtpython::vm::ThreadContext* context,
                                    M_BaseObject* args, M_BaseObject* kwargs)
@@ -598,10 +730,111 @@ static M_BaseObject* builtin_print(mtpython::vm::ThreadContext* context,
     return nullptr;
 }
 
+static M_BaseObject* builtin_repr(mtpython::vm::ThreadContext* context,
+                                  M_BaseObject* obj)
+{
+    return context->get_space()->repr(obj);
+}
+
+static M_BaseObject* builtin_sorted(mtpython::vm::ThreadContext* context,
+                                    const Arguments& args)
+{
+    static Signature sorted_signature({"iterable", "key", "reverse"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("sorted", nullptr, sorted_signature, scope,
+               {space->wrap_None(), space->wrap_False()});
+
+    std::vector<M_BaseObject*> items;
+    space->unpack_iterable(scope[0], items);
+    M_BaseObject* list = space->new_list(context, items);
+
+    space->call_function(context, space->getattr_str(list, "sort"),
+                         {scope[1], scope[2]});
+
+    return list;
+}
+
+/* Runs of exact ints and floats are added without boxing the partial sums,
+ * arrays are handed to their typed kernel */
+static M_BaseObject* builtin_sum(mtpython::vm::ThreadContext* context,
+                                 const Arguments& args)
+{
+    static Signature sum_signature({"iterable", "start"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("sum", nullptr, sum_signature, scope,
+               {space->wrap_int(context, 0)});
+    M_BaseObject* result = scope[1];
+
+    if (typeid(*result) == typeid(M_StdUnicodeObject)) {
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "sum() can't sum strings "
+                                                   "[use ''.join(seq) "
+                                                   "instead]"));
+    }
+    if (typeid(*result) == typeid(M_StdBytesObject) ||
+        typeid(*result) == typeid(M_StdByteArrayObject)) {
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "sum() can't sum bytes "
+                                                   "[use b''.join(seq) "
+                                                   "instead]"));
+    }
+
+    if (M_Array* array = dynamic_cast<M_Array*>(scope[0])) {
+        M_BaseObject* total = array->sum(context, result);
+        if (total) return total;
+    }
+
+    M_BaseObject* iterator = space->iter(scope[0]);
+    M_BaseObject* item;
+
+    if (typeid(*result) == typeid(M_StdIntObject)) {
+        long long total = M_STDINTOBJECT(result)->get_value();
+        while ((item = space->next_item(iterator)) &&
+               typeid(*item) == typeid(M_StdIntObject))
+            total += M_STDINTOBJECT(item)->get_value();
+
+        if (total < std::numeric_limits<int>::min() ||
+            total > std::numeric_limits<int>::max()) {
+            throw InterpError(space->OverflowError_type(),
+                              space->wrap_str(context, "sum does not fit in "
+                                                       "an int"));
+        }
+
+        result = space->wrap_int(context, (int)total);
+        if (!item) return result;
+        result = space->add(result, item);
+    }
+
+    if (typeid(*result) == typeid(M_StdFloatObject)) {
+        double total = M_STDFLOATOBJECT(result)->get_value();
+        while ((item = space->next_item(iterator))) {
+            if (typeid(*item) == typeid(M_StdFloatObject))
+                total += M_STDFLOATOBJECT(item)->get_value();
+            else if (typeid(*item) == typeid(M_StdIntObject))
+                total += M_STDINTOBJECT(item)->get_value();
+            else
+                break;
+        }
+
+        result = space->wrap_float(context, total);
+        if (!item) return result;
+        result = space->add(result, item);
+    }
+
+    while ((item = space->next_item(iterator)))
+        result = space->add(result, item);
+
+    return result;
+}
+
 /*
  * Range
  */
-class M_RangeIter : public M_BaseObject {
+class M_RangeIter : public M_StdNativeIterObject {
 private:
     ObjSpace* space;
     int current;
@@ -615,22 +848,20 @@ public:
 
     Typedef* get_typedef();
 
-    static M_BaseObject* __next__(mtpython::vm::ThreadContext* context,
-                                  M_BaseObject* self)
+    virtual M_BaseObject* next_item(mtpython::vm::ThreadContext* context)
     {
-        ObjSpace* space = context->get_space();
-
-        M_RangeIter* iter = static_cast<M_RangeIter*>(self);
-        if (iter->remaining > 0) {
-            iter->lock();
-            int index = iter->current;
-            iter->current = index + iter->step;
-            iter->remaining--;
-            iter->unlock();
-            return space->wrap_int(context, index);
+        lock();
+        if (remaining <= 0) {
+            unlock();
+            return nullptr;
         }
 
-        throw InterpError(space->StopIteration_type(), space->wrap_None());
+        int index = current;
+        current = index + step;
+        remaining--;
+        unlock();
+
+        return space->wrap_int(context, index);
     }
 };
 
@@ -639,8 +870,10 @@ Typedef* M_RangeIter::get_typedef()
     static Typedef range_iterator_typedef(
         "range_iterator",
         {
-            {"__next__",
-             new InterpFunctionWrapper("__next__", M_RangeIter::__next__)},
+            {"__iter__", new InterpFunctionWrapper(
+                             "__iter__", M_StdNativeIterObject::__iter__)},
+            {"__next__", new InterpFunctionWrapper(
+                             "__next__", M_StdNativeIterObject::__next__)},
         });
 
     return &range_iterator_typedef;
@@ -1212,6 +1445,64 @@ public:
     Typedef* get_typedef() { return _zip_typedef(); }
 };
 
+class M_Enumerate : public M_StdNativeIterObject {
+private:
+    M_BaseObject* it;
+    int index;
+
+public:
+    M_Enumerate(M_BaseObject* it, int index) : it(it), index(index) {}
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(it);
+    }
+
+    virtual M_BaseObject* next_item(mtpython::vm::ThreadContext* context)
+    {
+        ObjSpace* space = context->get_space();
+
+        M_BaseObject* value = space->next_item(it);
+        if (!value) return nullptr;
+
+        return space->new_tuple(context,
+                                {space->wrap_int(context, index++), value});
+    }
+
+    static M_BaseObject* __new__(mtpython::vm::ThreadContext* context,
+                                 const Arguments& args)
+    {
+        static Signature new_signature({"type", "iterable", "start"});
+        ObjSpace* space = context->get_space();
+
+        std::vector<M_BaseObject*> scope;
+        args.parse("enumerate", nullptr, new_signature, scope,
+                   {space->wrap_int(context, 0)});
+
+        int start =
+            space->i_get_index(scope[2], space->TypeError_type(), nullptr);
+        return new (context) M_Enumerate(space->iter(scope[1]), start);
+    }
+
+    static Typedef* _enumerate_typedef()
+    {
+        static Typedef enumerate_typedef(
+            "enumerate",
+            {
+                {"__new__",
+                 new InterpFunctionWrapper("__new__", M_Enumerate::__new__)},
+                {"__iter__", new InterpFunctionWrapper(
+                                 "__iter__", M_StdNativeIterObject::__iter__)},
+                {"__next__", new InterpFunctionWrapper(
+                                 "__next__", M_StdNativeIterObject::__next__)},
+            });
+
+        return &enumerate_typedef;
+    }
+
+    Typedef* get_typedef() { return _enumerate_typedef(); }
+};
+
 BuiltinsModule::BuiltinsModule(ObjSpace* space, M_BaseObject* name)
     : BuiltinModule(space, name)
 {
@@ -1223,9 +1514,9 @@ BuiltinsModule::BuiltinsModule(ObjSpace* space, M_BaseObject* name)
 
     /* builtin type */
     std::vector<std::string> builtin_type_names = {
-        "bool", "bytearray", "bytes",     "dict", "frozenset",
-        "int",  "object",    "set",       "str",  "tuple",
-        "list", "type",      "memoryview"};
+        "bool", "bytearray", "bytes", "dict", "float", "frozenset", "int",
+        "object", "set", "str", "tuple", "list", "type", "memoryview",
+        "slice"};
     for (const auto& name : builtin_type_names) {
         add_def(name, space->get_type_by_name(name));
     }
@@ -1245,8 +1536,18 @@ BuiltinsModule::BuiltinsModule(ObjSpace* space, M_BaseObject* name)
     ADD_EXCEPTION(ValueError);
     ADD_EXCEPTION(SystemError);
     ADD_EXCEPTION(KeyError);
+    ADD_EXCEPTION(LookupError);
     ADD_EXCEPTION(IndexError);
     ADD_EXCEPTION(SyntaxError);
+    ADD_EXCEPTION(ArithmeticError);
+    ADD_EXCEPTION(ZeroDivisionError);
+    ADD_EXCEPTION(OverflowError);
+    ADD_EXCEPTION(OSError);
+    ADD_EXCEPTION(RuntimeError);
+    ADD_EXCEPTION(EOFError);
+    ADD_EXCEPTION(UnicodeError);
+    ADD_EXCEPTION(UnicodeEncodeError);
+    ADD_EXCEPTION(UnicodeDecodeError);
 
     add_def("__doc__",
             new InterpDocstringWrapper("Built-in functions, exceptions, "
@@ -1263,27 +1564,41 @@ BuiltinsModule::BuiltinsModule(ObjSpace* space, M_BaseObject* name)
                 Signature({"func", "name"}, "bases", "kwargs", {})));
 
     add_def("abs", new InterpFunctionWrapper("abs", builtin_abs));
+    add_def("callable",
+            new InterpFunctionWrapper("callable", builtin_callable));
+    add_def("chr", new InterpFunctionWrapper("chr", builtin_chr));
     add_def("classmethod",
             space->get_typeobject(ClassMethod::_classmethod_typedef()));
     add_def("compile", new InterpFunctionWrapper(
                            "compile", builtin_compile,
                            Signature({"source", "filename", "mode", "flags",
                                       "dont_inherit", "optimize"})));
+    add_def("enumerate",
+            space->get_typeobject(M_Enumerate::_enumerate_typedef()));
     add_def("getattr", new InterpFunctionWrapper("getattr", builtin_getattr));
     add_def("globals", new InterpFunctionWrapper("globals", builtin_globals));
+    add_def("hash", new InterpFunctionWrapper("hash", builtin_hash));
     add_def("isinstance",
             new InterpFunctionWrapper("isinstance", builtin_isinstance));
     add_def("issubclass",
             new InterpFunctionWrapper("issubclass", builtin_issubclass));
     add_def("iter", new InterpFunctionWrapper("iter", builtin_iter));
     add_def("len", new InterpFunctionWrapper("len", builtin_len));
+    add_def("max", new InterpFunctionWrapper("max", builtin_max,
+                                             Signature("args", "kwargs")));
+    add_def("min", new InterpFunctionWrapper("min", builtin_min,
+                                             Signature("args", "kwargs")));
     add_def("open", space->getattr_str(space->get__io(), "open"));
+    add_def("ord", new InterpFunctionWrapper("ord", builtin_ord));
     add_def("print", new InterpFunctionWrapper("print", builtin_print,
                                                Signature("args", "kwargs")));
     add_def("property", space->get_typeobject(M_Property::_property_typedef()));
     add_def("range", space->get_typeobject(M_Range::_range_typedef()));
+    add_def("repr", new InterpFunctionWrapper("repr", builtin_repr));
     add_def("reversed",
             new InterpFunctionWrapper("reversed", builtin_reversed));
+    add_def("sorted", new InterpFunctionWrapper("sorted", builtin_sorted));
+    add_def("sum", new InterpFunctionWrapper("sum", builtin_sum));
     add_def("staticmethod",
             space->get_typeobject(StaticMethod::_staticmethod_typedef()));
     add_def("super", space->get_typeobject(M_Super::_super_typedef()));
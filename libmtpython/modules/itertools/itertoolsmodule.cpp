@@ -0,0 +1,1304 @@
+#include <string>
+#include <vector>
+
+#include "modules/itertools/itertoolsmodule.h"
+#include "objects/gc_array.h"
+#include "objects/std/iter_object.h"
+#include "objects/std/list_object.h"
+#include "objects/std/tuple_object.h"
+#include "interpreter/typedef.h"
+#include "interpreter/gateway.h"
+#include "interpreter/function.h"
+#include "interpreter/error.h"
+
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+namespace mtpython {
+namespace modules {
+
+/* All iterators in this module implement next_item() and share the
+ * __iter__ and __next__ of M_StdNativeIterObject. They pull from their
+ * inputs with ObjSpace::next_item(), so a pipeline of native iterators only
+ * raises StopIteration once, when the outermost one is exhausted. */
+#define ITERATOR_ENTRIES                                            \
+    {"__iter__", new InterpFunctionWrapper(                         \
+                     "__iter__", M_StdNativeIterObject::__iter__)}, \
+    {"__next__", new InterpFunctionWrapper(                         \
+                     "__next__", M_StdNativeIterObject::__next__)}
+
+/* Non-negative integer argument, or -1 if it is None */
+static long index_arg(ThreadContext* context, M_BaseObject* obj,
+                      const char* msg)
+{
+    ObjSpace* space = context->get_space();
+
+    if (space->i_is(obj, space->wrap_None())) return -1;
+    if (space->i_isinstance(obj, space->get_type_by_name("int"))) {
+        long value = space->unwrap_int(obj);
+        if (value >= 0) return value;
+    }
+
+    throw InterpError(space->ValueError_type(), space->wrap_str(context, msg));
+}
+
+/* Keyword-only arguments end up in kwargs, take name out of it and reject
+ * any other keyword */
+static M_BaseObject* kwonly_arg(ThreadContext* context, const char* fname,
+                                M_BaseObject* kwargs, const char* name,
+                                M_BaseObject* default_value)
+{
+    ObjSpace* space = context->get_space();
+    M_BaseObject* value = space->finditem_str(kwargs, name);
+    int expected = value ? 1 : 0;
+
+    if (space->unwrap_int(space->len(kwargs)) > expected) {
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "%s() got an unexpected keyword argument",
+                                  fname);
+    }
+
+    return value ? value : default_value;
+}
+
+static M_StdTupleObject* collect_tuple(ThreadContext* context,
+                                       M_BaseObject* iterable)
+{
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> items;
+
+    space->unpack_iterable(iterable, items);
+    return M_STDTUPLEOBJECT(space->new_tuple(context, items));
+}
+
+static M_StdTupleObject* tuple_from_indices(ThreadContext* context,
+                                            M_StdTupleObject* pool,
+                                            std::size_t* indices,
+                                            std::size_t n)
+{
+    M_StdTupleObject* result =
+        M_STDTUPLEOBJECT(context->get_space()->new_tuple(context, n));
+
+    for (std::size_t i = 0; i < n; i++)
+        (*result)[i] = (*pool)[indices[i]];
+
+    return result;
+}
+
+/*
+ * count
+ */
+class M_Count : public M_StdNativeIterObject {
+private:
+    M_BaseObject* cnt;
+    M_BaseObject* step;
+
+public:
+    M_Count(M_BaseObject* start, M_BaseObject* step) : cnt(start), step(step)
+    {}
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(cnt);
+        gc->mark_object(step);
+    }
+
+    virtual M_BaseObject* next_item(ThreadContext* context)
+    {
+        ObjSpace* space = context->get_space();
+        M_BaseObject* value = cnt;
+
+        cnt = space->add(value, step);
+        return value;
+    }
+
+    static M_BaseObject* __new__(ThreadContext* context, const Arguments& args)
+    {
+        static Signature new_signature({"type", "start", "step"});
+        ObjSpace* space = context->get_space();
+
+        std::vector<M_BaseObject*> scope;
+        args.parse("count", nullptr, new_signature, scope,
+                   {space->wrap_int(context, 0), space->wrap_int(context, 1)});
+
+        return new (context) M_Count(scope[1], scope[2]);
+    }
+
+    static M_BaseObject* __repr__(ThreadContext* context, M_BaseObject* self)
+    {
+        ObjSpace* space = context->get_space();
+        M_Count* as_count = static_cast<M_Count*>(self);
+
+        std::string str = "count(";
+        str += space->unwrap_str(space->repr(as_count->cnt));
+        if (!space->i_isinstance(as_count->step,
+                                 space->get_type_by_name("int")) ||
+            space->unwrap_int(as_count->step) != 1) {
+            str += ", ";
+            str += space->unwrap_str(space->repr(as_count->step));
+        }
+        str += ")";
+
+        return space->wrap_str(context, str);
+    }
+
+    static Typedef* _count_typedef()
+    {
+        static Typedef count_typedef(
+            "count", {
+                         {"__new__", new InterpFunctionWrapper(
+                                         "__new__", M_Count::__new__)},
+                         {"__repr__", new InterpFunctionWrapper(
+                                          "__repr__", M_Count::__repr__)},
+                         ITERATOR_ENTRIES,
+                     });
+        return &count_typedef;
+    }
+
+    Typedef* get_typedef() { return _count_typedef(); }
+};
+
+/*
+ * repeat
+ */
+class M_Repeat : public M_StdNativeIterObject {
+private:
+    M_BaseObject* element;
+    long cnt; /* -1 if unbounded */
+
+public:
+    M_Repeat(M_BaseObject* element, long cnt) : element(element), cnt(cnt) {}
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(element);
+    }
+
+    virtual M_BaseObject* next_item(ThreadContext* context)
+    {
+        ScopedObjectLock lock(this);
+
+        if (cnt == 0) return nullptr;
+        if (cnt > 0) cnt--;
+        return element;
+    }
+
+    static M_BaseObject* __new__(ThreadContext* context, const Arguments& args)
+    {
+        static Signature new_signature({"type", "object", "times"});
+        ObjSpace* space = context->get_space();
+
+        std::vector<M_BaseObject*> scope;
+        args.parse("repeat", nullptr, new_signature, scope, {nullptr});
+
+        long cnt = -1;
+        if (scope[2]) {
+            cnt = space->unwrap_int(scope[2]);
+            if (cnt < 0) cnt = 0;
+        }
+
+        return new (context) M_Repeat(scope[1], cnt);
+    }
+
+    static M_BaseObject* __repr__(ThreadContext* context, M_BaseObject* self)
+    {
+        ObjSpace* space = context->get_space();
+        M_Repeat* as_repeat = static_cast<M_Repeat*>(self);
+
+        std::string str = "repeat(";
+        str += space->unwrap_str(space->repr(as_repeat->element));
+        if (as_repeat->cnt >= 0) {
+            str += ", ";
+            str += std::to_string(as_repeat->cnt);
+        }
+        str += ")";
+
+        return space->wrap_str(context, str);
+    }
+
+    static Typedef* _repeat_typedef()
+    {
+        static Typedef repeat_typedef(
+            "repeat", {
+                          {"__new__", new InterpFunctionWrapper(
+                                          "__new__", M_Repeat::__new__)},
+                          {"__repr__", new InterpFunctionWrapper(
+                                           "__repr__", M_Repeat::__repr__)},
+                          ITERATOR_ENTRIES,
+                      });
+        return &repeat_typedef;
+    }
+
+    Typedef* get_typedef() { return _repeat_typedef(); }
+};
+
+/*
+ * cycle
+ */
+class M_Cycle : public M_StdNativeIterObject {
+private:
+    M_BaseObject* it; /* nullptr once the input is exhausted */
+    M_StdListObject* saved;
+    std::size_t index;
+
+public:
+    M_Cycle(M_BaseObject* it, M_StdListObject* saved)
+        : it(it), saved(saved), index(0)
+    {}
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        if (it) gc->mark_object(it);
+        gc->mark_object(saved);
+    }
+
+    virtual M_BaseObject* next_item(ThreadContext* context)
+    {
+        ObjSpace* space = context->get_space();
+
+        /* the first pass saves the items that the later passes replay */
+        if (it) {
+            M_BaseObject* item = space->next_item(it);
+            if (item) {
+                saved->push_back(context, item);
+                return item;
+            }
+            it = nullptr;
+        }
+
+        ScopedObjectLock lock(this);
+        if (!saved->size()) return nullptr;
+
+        M_BaseObject* item = (*saved)[index];
+        if (++index == saved->size()) index = 0;
+        return item;
+    }
+
+    static M_BaseObject* __new__(ThreadContext* context, const Arguments& args)
+    {
+        static Signature new_signature({"type", "iterable"});
+        ObjSpace* space = context->get_space();
+
+        std::vector<M_BaseObject*> scope;
+        args.parse("cycle", nullptr, new_signature, scope);
+
+        return new (context)
+            M_Cycle(space->iter(scope[1]), new (context) M_StdListObject());
+    }
+
+    static Typedef* _cycle_typedef()
+    {
+        static Typedef cycle_typedef(
+            "cycle", {
+                         {"__new__", new InterpFunctionWrapper(
+                                         "__new__", M_Cycle::__new__)},
+                         ITERATOR_ENTRIES,
+                     });
+        return &cycle_typedef;
+    }
+
+    Typedef* get_typedef() { return _cycle_typedef(); }
+};
+
+/*
+ * islice
+ */
+class M_ISlice : public M_StdNativeIterObject {
+private:
+    M_BaseObject* it; /* nullptr once the slice is exhausted */
+    long next;        /* index of the next item to return */
+    long stop;        /* -1 if unbounded */
+    long step;
+    long cnt; /* number of items consumed from it */
+
+public:
+    M_ISlice(M_BaseObject* it, long start, long stop, long step)
+        : it(it), next(start), stop(stop), step(step), cnt(0)
+    {}
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        if (it) gc->mark_object(it);
+    }
+
+    virtual M_BaseObject* next_item(ThreadContext* context)
+    {
+        ObjSpace* space = context->get_space();
+
+        if (!it) return nullptr;
+
+        /* skip to the next item in the slice */
+        while (cnt < next) {
+            if (!space->next_item(it)) {
+                it = nullptr;
+                return nullptr;
+            }
+            cnt++;
+        }
+
+        if (stop != -1 && cnt >= stop) {
+            it = nullptr;
+            return nullptr;
+        }
+
+        M_BaseObject* item = space->next_item(it);
+        if (!item) {
+            it = nullptr;
+            return nullptr;
+        }
+        cnt++;
+
+        long oldnext = next;
+        next += step;
+        if (next < oldnext || (stop != -1 && next > stop)) next = stop;
+
+        return item;
+    }
+
+    static M_BaseObject* __new__(ThreadContext* context, const Arguments& args)
+    {
+        static Signature new_signature(
+            {"type", "iterable", "start", "stop", "step"});
+        ObjSpace* space = context->get_space();
+        M_BaseObject* None = space->wrap_None();
+
+        std::vector<M_BaseObject*> scope;
+        args.parse("islice", nullptr, new_signature, scope,
+                   {nullptr, nullptr, nullptr});
+        if (!scope[2])
+            throw InterpError(space->TypeError_type(),
+                              space->wrap_str(context, "islice expected at "
+                                                       "least 2 arguments"));
+
+        long start = 0, stop, step = 1;
+        if (!scope[3]) {
+            /* islice(iterable, stop) */
+            stop = index_arg(context, scope[2],
+                             "Stop argument for islice() must be None or an "
+                             "integer: 0 <= x <= sys.maxsize.");
+        } else {
+            start = index_arg(context, scope[2],
+                              "Indices for islice() must be None or an "
+                              "integer: 0 <= x <= sys.maxsize.");
+            if (start == -1) start = 0;
+            stop = index_arg(context, scope[3],
+                             "Stop argument for islice() must be None or an "
+                             "integer: 0 <= x <= sys.maxsize.");
+
+            if (scope[4] && !space->i_is(scope[4], None)) {
+                step = index_arg(context, scope[4],
+                                 "Step for islice() must be a positive "
+                                 "integer or None.");
+                if (step == 0)
+                    throw InterpError(
+                        space->ValueError_type(),
+                        space->wrap_str(context, "Step for islice() must be "
+                                                 "a positive integer or "
+                                                 "None."));
+            }
+        }
+
+        return new (context)
+            M_ISlice(space->iter(scope[1]), start, stop, step);
+    }
+
+    static Typedef* _islice_typedef()
+    {
+        static Typedef islice_typedef(
+            "islice", {
+                          {"__new__", new InterpFunctionWrapper(
+                                          "__new__", M_ISlice::__new__)},
+                          ITERATOR_ENTRIES,
+                      });
+        return &islice_typedef;
+    }
+
+    Typedef* get_typedef() { return _islice_typedef(); }
+};
+
+/*
+ * chain
+ */
+class M_Chain : public M_StdNativeIterObject {
+private:
+    M_BaseObject* source; /* iterator over the iterables */
+    M_BaseObject* active; /* iterator of the current iterable */
+
+public:
+    M_Chain(M_BaseObject* source) : source(source), active(nullptr) {}
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        if (source) gc->mark_object(source);
+        if (active) gc->mark_object(active);
+    }
+
+    virtual M_BaseObject* next_item(ThreadContext* context)
+    {
+        ObjSpace* space = context->get_space();
+
+        while (source) {
+            if (!active) {
+                M_BaseObject* iterable = space->next_item(source);
+                if (!iterable) {
+                    source = nullptr;
+                    break;
+                }
+                active = space->iter(iterable);
+            }
+
+            M_BaseObject* item = space->next_item(active);
+            if (item) return item;
+            active = nullptr;
+        }
+
+        return nullptr;
+    }
+
+    static M_BaseObject* __new__(ThreadContext* context, const Arguments& args)
+    {
+        static Signature new_signature({"type"}, "iterables", "", {});
+        ObjSpace* space = context->get_space();
+
+        std::vector<M_BaseObject*> scope;
+        args.parse("chain", nullptr, new_signature, scope);
+
+        return new (context) M_Chain(space->iter(scope[1]));
+    }
+
+    static M_BaseObject* from_iterable(ThreadContext* context,
+                                       M_BaseObject* type,
+                                       M_BaseObject* iterable)
+    {
+        return new (context) M_Chain(context->get_space()->iter(iterable));
+    }
+
+    static Typedef* _chain_typedef()
+    {
+        static Typedef chain_typedef(
+            "chain", {
+                         {"__new__", new InterpFunctionWrapper(
+                                         "__new__", M_Chain::__new__)},
+                         ITERATOR_ENTRIES,
+                     });
+        return &chain_typedef;
+    }
+
+    Typedef* get_typedef() { return _chain_typedef(); }
+};
+
+/*
+ * accumulate
+ */
+class M_Accumulate : public M_StdNativeIterObject {
+private:
+    M_BaseObject* it;
+    M_BaseObject* func;    /* nullptr for addition */
+    M_BaseObject* total;   /* nullptr before the first item */
+    M_BaseObject* initial; /* nullptr once it has been returned */
+
+public:
+    M_Accumulate(M_BaseObject* it, M_BaseObject* func, M_BaseObject* initial)
+        : it(it), func(func), total(nullptr), initial(initial)
+    {}
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(it);
+        if (func) gc->mark_object(func);
+        if (total) gc->mark_object(total);
+        if (initial) gc->mark_object(initial);
+    }
+
+    virtual M_BaseObject* next_item(ThreadContext* context)
+    {
+        ObjSpace* space = context->get_space();
+
+        if (initial) {
+            total = initial;
+            initial = nullptr;
+            return total;
+        }
+
+        M_BaseObject* value = space->next_item(it);
+        if (!value) return nullptr;
+
+        if (!total)
+            total = value;
+        else if (!func)
+            total = space->add(total, value);
+        else
+            total = space->call_function(context, func, {total, value});
+
+        return total;
+    }
+
+    static M_BaseObject* __new__(ThreadContext* context, const Arguments& args)
+    {
+        static Signature new_signature({"type", "iterable", "func"}, "",
+                                       "kwargs", {});
+        ObjSpace* space = context->get_space();
+        M_BaseObject* None = space->wrap_None();
+
+        std::vector<M_BaseObject*> scope;
+        args.parse("accumulate", nullptr, new_signature, scope, {None});
+
+        M_BaseObject* func = space->i_is(scope[2], None) ? nullptr : scope[2];
+        M_BaseObject* initial =
+            kwonly_arg(context, "accumulate", scope[3], "initial", None);
+        if (space->i_is(initial, None)) initial = nullptr;
+
+        return new (context)
+            M_Accumulate(space->iter(scope[1]), func, initial);
+    }
+
+    static Typedef* _accumulate_typedef()
+    {
+        static Typedef accumulate_typedef(
+            "accumulate",
+            {
+                {"__new__",
+                 new InterpFunctionWrapper("__new__", M_Accumulate::__new__)},
+                ITERATOR_ENTRIES,
+            });
+        return &accumulate_typedef;
+    }
+
+    Typedef* get_typedef() { return _accumulate_typedef(); }
+};
+
+/*
+ * groupby
+ */
+class M_GroupBy : public M_StdNativeIterObject {
+private:
+    M_BaseObject* it;
+    M_BaseObject* keyfunc; /* nullptr for identity */
+    M_BaseObject* tgtkey;  /* key of the current group */
+    M_BaseObject* currkey;
+    M_BaseObject* currvalue; /* nullptr if taken by a grouper */
+    /* only the grouper of the current group may advance the input */
+    M_BaseObject* currgrouper;
+
+    friend class M_Grouper;
+
+    /* Read the next value and its key, false if the input is exhausted */
+    bool step(ThreadContext* context)
+    {
+        ObjSpace* space = context->get_space();
+
+        M_BaseObject* value = space->next_item(it);
+        if (!value) return false;
+
+        M_BaseObject* key =
+            keyfunc ? space->call_function(context, keyfunc, {value}) : value;
+        currvalue = value;
+        currkey = key;
+        return true;
+    }
+
+public:
+    M_GroupBy(M_BaseObject* it, M_BaseObject* keyfunc)
+        : it(it), keyfunc(keyfunc), tgtkey(nullptr), currkey(nullptr),
+          currvalue(nullptr), currgrouper(nullptr)
+    {}
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(it);
+        if (keyfunc) gc->mark_object(keyfunc);
+        if (tgtkey) gc->mark_object(tgtkey);
+        if (currkey) gc->mark_object(currkey);
+        if (currvalue) gc->mark_object(currvalue);
+        if (currgrouper) gc->mark_object(currgrouper);
+    }
+
+    virtual M_BaseObject* next_item(ThreadContext* context);
+
+    static M_BaseObject* __new__(ThreadContext* context, const Arguments& args)
+    {
+        static Signature new_signature({"type", "iterable", "key"});
+        ObjSpace* space = context->get_space();
+        M_BaseObject* None = space->wrap_None();
+
+        std::vector<M_BaseObject*> scope;
+        args.parse("groupby", nullptr, new_signature, scope, {None});
+
+        M_BaseObject* keyfunc =
+            space->i_is(scope[2], None) ? nullptr : scope[2];
+        return new (context) M_GroupBy(space->iter(scope[1]), keyfunc);
+    }
+
+    static Typedef* _groupby_typedef()
+    {
+        static Typedef groupby_typedef(
+            "groupby", {
+                           {"__new__", new InterpFunctionWrapper(
+                                           "__new__", M_GroupBy::__new__)},
+                           ITERATOR_ENTRIES,
+                       });
+        return &groupby_typedef;
+    }
+
+    Typedef* get_typedef() { return _groupby_typedef(); }
+};
+
+class M_Grouper : public M_StdNativeIterObject {
+private:
+    M_GroupBy* parent;
+    M_BaseObject* tgtkey;
+
+public:
+    M_Grouper(M_GroupBy* parent, M_BaseObject* tgtkey)
+        : parent(parent), tgtkey(tgtkey)
+    {}
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(parent);
+        gc->mark_object(tgtkey);
+    }
+
+    virtual M_BaseObject* next_item(ThreadContext* context)
+    {
+        ObjSpace* space = context->get_space();
+
+        if (parent->currgrouper != this) return nullptr;
+        if (!parent->currvalue && !parent->step(context)) return nullptr;
+        if (!space->i_eq(tgtkey, parent->currkey)) return nullptr;
+
+        M_BaseObject* value = parent->currvalue;
+        parent->currvalue = nullptr;
+        return value;
+    }
+
+    static Typedef* _grouper_typedef()
+    {
+        static Typedef grouper_typedef("_grouper", {
+                                                       ITERATOR_ENTRIES,
+                                                   });
+        return &grouper_typedef;
+    }
+
+    Typedef* get_typedef() { return _grouper_typedef(); }
+};
+
+M_BaseObject* M_GroupBy::next_item(ThreadContext* context)
+{
+    ObjSpace* space = context->get_space();
+
+    currgrouper = nullptr;
+
+    /* skip the rest of the current group */
+    while (true) {
+        if (currkey) {
+            if (!tgtkey || !space->i_eq(tgtkey, currkey)) break;
+        }
+        if (!step(context)) return nullptr;
+    }
+
+    tgtkey = currkey;
+    M_Grouper* grouper = new (context) M_Grouper(this, tgtkey);
+    currgrouper = grouper;
+
+    M_StdTupleObject* result = M_STDTUPLEOBJECT(space->new_tuple(context, 2));
+    (*result)[0] = currkey;
+    (*result)[1] = grouper;
+    return result;
+}
+
+/*
+ * zip_longest
+ */
+class M_ZipLongest : public M_StdNativeIterObject {
+private:
+    /* iterators of the inputs, nullptr once exhausted */
+    M_GCArray<M_BaseObject*>* iterators;
+    std::size_t numactive;
+    M_BaseObject* fillvalue;
+
+public:
+    M_ZipLongest(M_GCArray<M_BaseObject*>* iterators, M_BaseObject* fillvalue)
+        : iterators(iterators), numactive(iterators->size()),
+          fillvalue(fillvalue)
+    {}
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(iterators);
+        gc->mark_object(fillvalue);
+    }
+
+    virtual M_BaseObject* next_item(ThreadContext* context)
+    {
+        ObjSpace* space = context->get_space();
+        std::size_t size = iterators->size();
+
+        if (!numactive) return nullptr;
+
+        M_StdTupleObject* result =
+            M_STDTUPLEOBJECT(space->new_tuple(context, size));
+        for (std::size_t i = 0; i < size; i++) {
+            M_BaseObject* it = (*iterators)[i];
+            M_BaseObject* item = it ? space->next_item(it) : nullptr;
+
+            if (it && !item) {
+                (*iterators)[i] = nullptr;
+                if (!--numactive) return nullptr;
+            }
+
+            (*result)[i] = item ? item : fillvalue;
+        }
+
+        return result;
+    }
+
+    static M_BaseObject* __new__(ThreadContext* context, const Arguments& args)
+    {
+        static Signature new_signature({"type"}, "iterables", "kwargs", {});
+        ObjSpace* space = context->get_space();
+
+        std::vector<M_BaseObject*> scope;
+        args.parse("zip_longest", nullptr, new_signature, scope);
+
+        M_BaseObject* fillvalue = kwonly_arg(context, "zip_longest", scope[2],
+                                             "fillvalue", space->wrap_None());
+
+        M_StdTupleObject* iterables = M_STDTUPLEOBJECT(scope[1]);
+        auto* iterators =
+            M_GCArray<M_BaseObject*>::create(context, iterables->size());
+        for (std::size_t i = 0; i < iterables->size(); i++)
+            (*iterators)[i] = space->iter((*iterables)[i]);
+
+        return new (context) M_ZipLongest(iterators, fillvalue);
+    }
+
+    static Typedef* _zip_longest_typedef()
+    {
+        static Typedef zip_longest_typedef(
+            "zip_longest",
+            {
+                {"__new__",
+                 new InterpFunctionWrapper("__new__", M_ZipLongest::__new__)},
+                ITERATOR_ENTRIES,
+            });
+        return &zip_longest_typedef;
+    }
+
+    Typedef* get_typedef() { return _zip_longest_typedef(); }
+};
+
+/*
+ * product
+ */
+class M_Product : public M_StdNativeIterObject {
+private:
+    M_StdTupleObject* pools; /* tuple of tuples */
+    M_GCArray<std::size_t>* indices;
+    bool first;
+    bool stopped;
+
+public:
+    M_Product(ThreadContext* context, M_StdTupleObject* pools)
+        : pools(pools), first(true), stopped(false)
+    {
+        indices = M_GCArray<std::size_t>::create(context, pools->size());
+    }
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(pools);
+        gc->mark_object(indices);
+    }
+
+    virtual M_BaseObject* next_item(ThreadContext* context)
+    {
+        ObjSpace* space = context->get_space();
+        ScopedObjectLock lock(this);
+        std::size_t npools = pools->size();
+
+        if (stopped) return nullptr;
+
+        if (first) {
+            first = false;
+            for (auto* pool : *pools) {
+                if (!M_STDTUPLEOBJECT(pool)->size()) {
+                    stopped = true;
+                    return nullptr;
+                }
+            }
+        } else {
+            /* advance the rightmost index that has not wrapped around */
+            long i = (long)npools - 1;
+            for (; i >= 0; i--) {
+                M_StdTupleObject* pool = M_STDTUPLEOBJECT((*pools)[i]);
+                if (++(*indices)[i] < pool->size()) break;
+                (*indices)[i] = 0;
+            }
+
+            if (i < 0) {
+                stopped = true;
+                return nullptr;
+            }
+        }
+
+        M_StdTupleObject* result =
+            M_STDTUPLEOBJECT(space->new_tuple(context, npools));
+        for (std::size_t i = 0; i < npools; i++)
+            (*result)[i] = (*M_STDTUPLEOBJECT((*pools)[i]))[(*indices)[i]];
+
+        return result;
+    }
+
+    static M_BaseObject* __new__(ThreadContext* context, const Arguments& args)
+    {
+        static Signature new_signature({"type"}, "iterables", "kwargs", {});
+        ObjSpace* space = context->get_space();
+
+        std::vector<M_BaseObject*> scope;
+        args.parse("product", nullptr, new_signature, scope);
+
+        M_BaseObject* wrapped_repeat =
+            kwonly_arg(context, "product", scope[2], "repeat",
+                       space->wrap_int(context, 1));
+        int repeat = space->unwrap_int(wrapped_repeat);
+        if (repeat < 0)
+            throw InterpError(space->ValueError_type(),
+                              space->wrap_str(context, "repeat argument "
+                                                       "cannot be negative"));
+
+        /* every input is read into a tuple up front */
+        M_StdTupleObject* iterables = M_STDTUPLEOBJECT(scope[1]);
+        std::vector<M_BaseObject*> pools;
+        for (auto* iterable : *iterables)
+            pools.push_back(collect_tuple(context, iterable));
+
+        std::size_t npools = pools.size();
+        for (int i = 1; i < repeat; i++)
+            pools.insert(pools.end(), pools.begin(), pools.begin() + npools);
+        if (!repeat) pools.clear();
+
+        return new (context) M_Product(
+            context, M_STDTUPLEOBJECT(space->new_tuple(context, pools)));
+    }
+
+    static Typedef* _product_typedef()
+    {
+        static Typedef product_typedef(
+            "product", {
+                           {"__new__", new InterpFunctionWrapper(
+                                           "__new__", M_Product::__new__)},
+                           ITERATOR_ENTRIES,
+                       });
+        return &product_typedef;
+    }
+
+    Typedef* get_typedef() { return _product_typedef(); }
+};
+
+/*
+ * permutations
+ */
+class M_Permutations : public M_StdNativeIterObject {
+private:
+    M_StdTupleObject* pool;
+    std::size_t r;
+    M_GCArray<std::size_t>* indices; /* n entries */
+    M_GCArray<std::size_t>* cycles;  /* r entries */
+    bool first;
+    bool stopped;
+
+public:
+    M_Permutations(ThreadContext* context, M_StdTupleObject* pool,
+                   std::size_t r)
+        : pool(pool), r(r), first(true), stopped(false)
+    {
+        std::size_t n = pool->size();
+
+        indices = M_GCArray<std::size_t>::create(context, n);
+        for (std::size_t i = 0; i < n; i++)
+            (*indices)[i] = i;
+
+        cycles = M_GCArray<std::size_t>::create(context, r);
+        for (std::size_t i = 0; i < r && i < n; i++)
+            (*cycles)[i] = n - i;
+    }
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(pool);
+        gc->mark_object(indices);
+        gc->mark_object(cycles);
+    }
+
+    virtual M_BaseObject* next_item(ThreadContext* context)
+    {
+        ScopedObjectLock lock(this);
+        std::size_t n = pool->size();
+
+        if (stopped) return nullptr;
+
+        if (first) {
+            first = false;
+            if (r > n) {
+                stopped = true;
+                return nullptr;
+            }
+            return tuple_from_indices(context, pool, indices->begin(), r);
+        }
+
+        if (!n) {
+            stopped = true;
+            return nullptr;
+        }
+
+        /* decrement the rightmost cycle, rotating the indices that ran out */
+        for (long i = (long)r - 1; i >= 0; i--) {
+            std::size_t& cycle = (*cycles)[i];
+
+            if (--cycle == 0) {
+                std::size_t index = (*indices)[i];
+                for (std::size_t j = i; j < n - 1; j++)
+                    (*indices)[j] = (*indices)[j + 1];
+                (*indices)[n - 1] = index;
+                cycle = n - i;
+            } else {
+                std::swap((*indices)[i], (*indices)[n - cycle]);
+                return tuple_from_indices(context, pool, indices->begin(), r);
+            }
+        }
+
+        stopped = true;
+        return nullptr;
+    }
+
+    static M_BaseObject* __new__(ThreadContext* context, const Arguments& args)
+    {
+        static Signature new_signature({"type", "iterable", "r"});
+        ObjSpace* space = context->get_space();
+        M_BaseObject* None = space->wrap_None();
+
+        std::vector<M_BaseObject*> scope;
+        args.parse("permutations", nullptr, new_signature, scope, {None});
+
+        M_StdTupleObject* pool = collect_tuple(context, scope[1]);
+        long r = pool->size();
+        if (!space->i_is(scope[2], None)) {
+            r = space->unwrap_int(scope[2]);
+            if (r < 0)
+                throw InterpError(
+                    space->ValueError_type(),
+                    space->wrap_str(context, "r must be non-negative"));
+        }
+
+        return new (context) M_Permutations(context, pool, r);
+    }
+
+    static Typedef* _permutations_typedef()
+    {
+        static Typedef permutations_typedef(
+            "permutations", {
+                                {"__new__", new InterpFunctionWrapper(
+                                                "__new__",
+                                                M_Permutations::__new__)},
+                                ITERATOR_ENTRIES,
+                            });
+        return &permutations_typedef;
+    }
+
+    Typedef* get_typedef() { return _permutations_typedef(); }
+};
+
+/*
+ * combinations
+ */
+class M_Combinations : public M_StdNativeIterObject {
+private:
+    M_StdTupleObject* pool;
+    M_GCArray<std::size_t>* indices; /* r entries */
+    bool first;
+    bool stopped;
+
+public:
+    M_Combinations(ThreadContext* context, M_StdTupleObject* pool,
+                   std::size_t r)
+        : pool(pool), first(true), stopped(false)
+    {
+        indices = M_GCArray<std::size_t>::create(context, r);
+        for (std::size_t i = 0; i < r; i++)
+            (*indices)[i] = i;
+    }
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(pool);
+        gc->mark_object(indices);
+    }
+
+    virtual M_BaseObject* next_item(ThreadContext* context)
+    {
+        ScopedObjectLock lock(this);
+        std::size_t n = pool->size();
+        std::size_t r = indices->size();
+
+        if (stopped) return nullptr;
+
+        if (first) {
+            first = false;
+            if (r > n) {
+                stopped = true;
+                return nullptr;
+            }
+            return tuple_from_indices(context, pool, indices->begin(), r);
+        }
+
+        /* find the rightmost index that can still be incremented */
+        long i = (long)r - 1;
+        while (i >= 0 && (*indices)[i] == i + n - r)
+            i--;
+
+        if (i < 0) {
+            stopped = true;
+            return nullptr;
+        }
+
+        (*indices)[i]++;
+        for (std::size_t j = i + 1; j < r; j++)
+            (*indices)[j] = (*indices)[j - 1] + 1;
+
+        return tuple_from_indices(context, pool, indices->begin(), r);
+    }
+
+    static M_BaseObject* __new__(ThreadContext* context, const Arguments& args)
+    {
+        static Signature new_signature({"type", "iterable", "r"});
+        ObjSpace* space = context->get_space();
+
+        std::vector<M_BaseObject*> scope;
+        args.parse("combinations", nullptr, new_signature, scope);
+
+        M_StdTupleObject* pool = collect_tuple(context, scope[1]);
+        long r = space->unwrap_int(scope[2]);
+        if (r < 0)
+            throw InterpError(space->ValueError_type(),
+                              space->wrap_str(context, "r must be "
+                                                       "non-negative"));
+
+        return new (context) M_Combinations(context, pool, r);
+    }
+
+    static Typedef* _combinations_typedef()
+    {
+        static Typedef combinations_typedef(
+            "combinations", {
+                                {"__new__", new InterpFunctionWrapper(
+                                                "__new__",
+                                                M_Combinations::__new__)},
+                                ITERATOR_ENTRIES,
+                            });
+        return &combinations_typedef;
+    }
+
+    Typedef* get_typedef() { return _combinations_typedef(); }
+};
+
+/*
+ * tee
+ */
+#define TEE_BLOCKLEN 57
+
+/* Items read from the input of a tee, shared by all of its iterators. The
+ * blocks form a singly-linked list, so blocks that every iterator has
+ * moved past are released by the collector. */
+class M_TeeData : public M_BaseObject {
+private:
+    M_BaseObject* it;
+    M_TeeData* nextlink;
+    int numread;
+    bool running;
+    M_BaseObject* values[TEE_BLOCKLEN];
+
+public:
+    M_TeeData(M_BaseObject* it)
+        : it(it), nextlink(nullptr), numread(0), running(false), values{}
+    {}
+
+    void* operator new(std::size_t size, ThreadContext* context)
+    {
+        return context->get_gc()->allocate(size, false);
+    }
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(it);
+        if (nextlink) gc->mark_object(nextlink);
+        for (int i = 0; i < numread; i++)
+            gc->mark_object(values[i]);
+    }
+
+    M_TeeData* jump_link(ThreadContext* context)
+    {
+        ScopedObjectLock lock(this);
+
+        if (!nextlink) nextlink = new (context) M_TeeData(it);
+        return nextlink;
+    }
+
+    M_BaseObject* get_item(ThreadContext* context, int i)
+    {
+        ObjSpace* space = context->get_space();
+
+        if (i < numread) return values[i];
+
+        if (running)
+            throw InterpError(space->RuntimeError_type(),
+                              space->wrap_str(context, "cannot re-enter the "
+                                                       "tee iterator"));
+
+        running = true;
+        M_BaseObject* value;
+        try {
+            value = space->next_item(it);
+        } catch (InterpError&) {
+            running = false;
+            throw;
+        }
+        running = false;
+
+        if (!value) return nullptr;
+        values[numread++] = value;
+        return value;
+    }
+};
+
+class M_Tee : public M_StdNativeIterObject {
+private:
+    M_TeeData* data;
+    int index;
+
+public:
+    M_Tee(M_TeeData* data, int index) : data(data), index(index) {}
+
+    virtual void mark_children(gc::GarbageCollector* gc)
+    {
+        gc->mark_object(data);
+    }
+
+    M_Tee* copy(ThreadContext* context)
+    {
+        return new (context) M_Tee(data, index);
+    }
+
+    virtual M_BaseObject* next_item(ThreadContext* context)
+    {
+        if (index >= TEE_BLOCKLEN) {
+            data = data->jump_link(context);
+            index = 0;
+        }
+
+        M_BaseObject* value = data->get_item(context, index);
+        if (value) index++;
+        return value;
+    }
+
+    /* Start a tee on iterable, or copy it if it already is one */
+    static M_Tee* from_iterable(ThreadContext* context, M_BaseObject* iterable)
+    {
+        M_BaseObject* it = context->get_space()->iter(iterable);
+        M_Tee* as_tee = dynamic_cast<M_Tee*>(it);
+
+        if (as_tee) return as_tee->copy(context);
+        return new (context) M_Tee(new (context) M_TeeData(it), 0);
+    }
+
+    static M_BaseObject* __new__(ThreadContext* context, M_BaseObject* type,
+                                 M_BaseObject* iterable)
+    {
+        return from_iterable(context, iterable);
+    }
+
+    static M_BaseObject* __copy__(ThreadContext* context, M_BaseObject* self)
+    {
+        return static_cast<M_Tee*>(self)->copy(context);
+    }
+
+    static Typedef* _tee_typedef()
+    {
+        static Typedef tee_typedef(
+            "_tee",
+            {
+                {"__new__",
+                 new InterpFunctionWrapper("__new__", M_Tee::__new__)},
+                {"__copy__",
+                 new InterpFunctionWrapper("__copy__", M_Tee::__copy__)},
+                ITERATOR_ENTRIES,
+            });
+        return &tee_typedef;
+    }
+
+    Typedef* get_typedef() { return _tee_typedef(); }
+};
+
+static M_BaseObject* itertools_tee(ThreadContext* context,
+                                   const Arguments& args)
+{
+    static Signature tee_signature({"iterable", "n"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("tee", nullptr, tee_signature, scope,
+               {space->wrap_int(context, 2)});
+
+    int n = space->unwrap_int(scope[1]);
+    if (n < 0)
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "n must be >= 0"));
+
+    M_BaseObject* result = space->new_tuple(context, n);
+    if (!n) return result;
+
+    M_BaseObject** items = space->tuple_items(result);
+    M_Tee* tee = M_Tee::from_iterable(context, scope[0]);
+    items[0] = tee;
+    for (int i = 1; i < n; i++)
+        items[i] = tee->copy(context);
+
+    return result;
+}
+
+ItertoolsModule::ItertoolsModule(ObjSpace* space, M_BaseObject* name)
+    : BuiltinModule(space, name)
+{
+    ThreadContext* context = ThreadContext::current_thread();
+
+    add_def("count", space->get_typeobject(M_Count::_count_typedef()));
+    add_def("repeat", space->get_typeobject(M_Repeat::_repeat_typedef()));
+    add_def("cycle", space->get_typeobject(M_Cycle::_cycle_typedef()));
+    add_def("islice", space->get_typeobject(M_ISlice::_islice_typedef()));
+    add_def("accumulate",
+            space->get_typeobject(M_Accumulate::_accumulate_typedef()));
+    add_def("groupby", space->get_typeobject(M_GroupBy::_groupby_typedef()));
+    add_def("zip_longest",
+            space->get_typeobject(M_ZipLongest::_zip_longest_typedef()));
+    add_def("product", space->get_typeobject(M_Product::_product_typedef()));
+    add_def("permutations",
+            space->get_typeobject(M_Permutations::_permutations_typedef()));
+    add_def("combinations",
+            space->get_typeobject(M_Combinations::_combinations_typedef()));
+    add_def("_tee", space->get_typeobject(M_Tee::_tee_typedef()));
+    add_def("tee", new InterpFunctionWrapper("tee", itertools_tee));
+
+    /* chain.from_iterable is a classmethod, which typedefs cannot express */
+    M_BaseObject* chain_type =
+        space->get_typeobject(M_Chain::_chain_typedef());
+    M_BaseObject* from_iterable = space->wrap(
+        context,
+        new InterpFunctionWrapper("from_iterable", M_Chain::from_iterable));
+    chain_type->set_dict_value(space, "from_iterable",
+                               new (context) ClassMethod(from_iterable));
+    add_def("chain", chain_type);
+}
+
+} // namespace modules
+} // namespace mtpython
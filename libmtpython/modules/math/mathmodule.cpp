@@ -0,0 +1,529 @@
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "modules/math/mathmodule.h"
+#include "objects/std/int_object.h"
+#include "interpreter/arguments.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+namespace mtpython {
+namespace modules {
+
+/* Interpreter-level float of x. Ints and floats are converted directly,
+ * other objects through __float__ */
+static double float_arg(ThreadContext* context, M_BaseObject* x)
+{
+    ObjSpace* space = context->get_space();
+
+    try {
+        return x->to_float(space);
+    } catch (const NotImplementedException&) {
+    }
+
+    M_BaseObject* impl = space->lookup(x, "__float__");
+    if (!impl) {
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "must be real number, not %s",
+                                  space->get_type_name(x).c_str());
+    }
+
+    M_BaseObject* value = space->get_and_call_function(context, impl, {x});
+    return space->unwrap_float(value);
+}
+
+static M_StdIntObject* int_arg(M_BaseObject* x)
+{
+    return dynamic_cast<M_StdIntObject*>(x);
+}
+
+static InterpError domain_error(ThreadContext* context)
+{
+    ObjSpace* space = context->get_space();
+    return InterpError(space->ValueError_type(),
+                       space->wrap_str(context, "math domain error"));
+}
+
+static InterpError range_error(ThreadContext* context)
+{
+    ObjSpace* space = context->get_space();
+    return InterpError(space->OverflowError_type(),
+                       space->wrap_str(context, "math range error"));
+}
+
+/* int of an integral double, OverflowError if it does not fit in an
+ * interpreter int */
+static M_BaseObject* int_from_double(ThreadContext* context, double x)
+{
+    ObjSpace* space = context->get_space();
+
+    if (std::isnan(x))
+        throw InterpError(
+            space->ValueError_type(),
+            space->wrap_str(context, "cannot convert float NaN to integer"));
+    if (std::isinf(x))
+        throw InterpError(
+            space->OverflowError_type(),
+            space->wrap_str(context,
+                            "cannot convert float infinity to integer"));
+    if (x < (double)INT_MIN || x > (double)INT_MAX)
+        throw InterpError(space->OverflowError_type(),
+                          space->wrap_str(context, "int too large to convert"));
+
+    return space->wrap_int(context, (int)x);
+}
+
+/* f(x) with the errors of CPython's math_1(): a NaN out of a non-NaN is a
+ * domain error, an infinity out of a finite value is a range error if f
+ * can overflow and a domain error (a pole) otherwise */
+static M_BaseObject* math_1(ThreadContext* context, M_BaseObject* arg,
+                            double (*f)(double), bool can_overflow)
+{
+    double x = float_arg(context, arg);
+    double r = f(x);
+
+    if (std::isnan(r) && !std::isnan(x)) throw domain_error(context);
+    if (std::isinf(r) && std::isfinite(x)) {
+        if (can_overflow) throw range_error(context);
+        throw domain_error(context);
+    }
+
+    return context->get_space()->wrap_float(context, r);
+}
+
+static M_BaseObject* math_2(ThreadContext* context, M_BaseObject* arg1,
+                            M_BaseObject* arg2, double (*f)(double, double),
+                            bool can_overflow)
+{
+    double x = float_arg(context, arg1);
+    double y = float_arg(context, arg2);
+    double r = f(x, y);
+
+    if (std::isnan(r) && !std::isnan(x) && !std::isnan(y))
+        throw domain_error(context);
+    if (std::isinf(r) && std::isfinite(x) && std::isfinite(y)) {
+        if (can_overflow) throw range_error(context);
+        throw domain_error(context);
+    }
+
+    return context->get_space()->wrap_float(context, r);
+}
+
+#define DEF_MATH_FUNC1(name, func, can_overflow)                      \
+    static M_BaseObject* math_##name(ThreadContext* context,          \
+                                     M_BaseObject* x)                 \
+    {                                                                 \
+        return math_1(                                                \
+            context, x, [](double v) { return func(v); }, can_overflow); \
+    }
+
+#define DEF_MATH_FUNC2(name, func, can_overflow)                             \
+    static M_BaseObject* math_##name(ThreadContext* context, M_BaseObject* x, \
+                                     M_BaseObject* y)                        \
+    {                                                                        \
+        return math_2(                                                       \
+            context, x, y, [](double a, double b) { return func(a, b); },    \
+            can_overflow);                                                   \
+    }
+
+DEF_MATH_FUNC1(acos, std::acos, false)
+DEF_MATH_FUNC1(acosh, std::acosh, false)
+DEF_MATH_FUNC1(asin, std::asin, false)
+DEF_MATH_FUNC1(asinh, std::asinh, false)
+DEF_MATH_FUNC1(atan, std::atan, false)
+DEF_MATH_FUNC1(atanh, std::atanh, false)
+DEF_MATH_FUNC1(cos, std::cos, false)
+DEF_MATH_FUNC1(cosh, std::cosh, true)
+DEF_MATH_FUNC1(erf, std::erf, false)
+DEF_MATH_FUNC1(erfc, std::erfc, false)
+DEF_MATH_FUNC1(exp, std::exp, true)
+DEF_MATH_FUNC1(expm1, std::expm1, true)
+DEF_MATH_FUNC1(fabs, std::fabs, false)
+DEF_MATH_FUNC1(log1p, std::log1p, false)
+DEF_MATH_FUNC1(log2, std::log2, false)
+DEF_MATH_FUNC1(log10, std::log10, false)
+DEF_MATH_FUNC1(sin, std::sin, false)
+DEF_MATH_FUNC1(sinh, std::sinh, true)
+DEF_MATH_FUNC1(sqrt, std::sqrt, false)
+DEF_MATH_FUNC1(tan, std::tan, false)
+DEF_MATH_FUNC1(tanh, std::tanh, false)
+
+DEF_MATH_FUNC2(atan2, std::atan2, false)
+DEF_MATH_FUNC2(copysign, std::copysign, false)
+DEF_MATH_FUNC2(fmod, std::fmod, false)
+DEF_MATH_FUNC2(hypot, std::hypot, true)
+
+static M_BaseObject* math_pow(ThreadContext* context, M_BaseObject* arg1,
+                              M_BaseObject* arg2)
+{
+    double x = float_arg(context, arg1);
+    double y = float_arg(context, arg2);
+    double r = std::pow(x, y);
+
+    if (std::isnan(r) && !std::isnan(x) && !std::isnan(y))
+        throw domain_error(context);
+    /* 0 ** negative is a pole, everything else overflowed */
+    if (std::isinf(r) && std::isfinite(x) && std::isfinite(y)) {
+        if (x == 0.0) throw domain_error(context);
+        throw range_error(context);
+    }
+
+    return context->get_space()->wrap_float(context, r);
+}
+
+/* gamma and lgamma have poles at the non-positive integers */
+static M_BaseObject* math_gamma(ThreadContext* context, M_BaseObject* arg)
+{
+    double x = float_arg(context, arg);
+    if (x <= 0.0 && x == std::floor(x)) throw domain_error(context);
+
+    return math_1(
+        context, arg, [](double v) { return std::tgamma(v); }, true);
+}
+
+static M_BaseObject* math_lgamma(ThreadContext* context, M_BaseObject* arg)
+{
+    double x = float_arg(context, arg);
+    if (x <= 0.0 && x == std::floor(x)) throw domain_error(context);
+
+    return math_1(
+        context, arg, [](double v) { return std::lgamma(v); }, true);
+}
+
+static M_BaseObject* math_log(ThreadContext* context, const Arguments& args)
+{
+    static Signature log_signature({"x", "base"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("log", nullptr, log_signature, scope, {nullptr});
+
+    double x = float_arg(context, scope[0]);
+    if (x <= 0.0) throw domain_error(context);
+    double num = std::log(x);
+    if (!scope[1]) return space->wrap_float(context, num);
+
+    double base = float_arg(context, scope[1]);
+    if (base <= 0.0) throw domain_error(context);
+    double den = std::log(base);
+    if (den == 0.0)
+        throw InterpError(space->ZeroDivisionError_type(),
+                          space->wrap_str(context, "float division by zero"));
+
+    return space->wrap_float(context, num / den);
+}
+
+static M_BaseObject* math_ceil(ThreadContext* context, M_BaseObject* x)
+{
+    if (int_arg(x)) return x;
+    return int_from_double(context, std::ceil(float_arg(context, x)));
+}
+
+static M_BaseObject* math_floor(ThreadContext* context, M_BaseObject* x)
+{
+    if (int_arg(x)) return x;
+    return int_from_double(context, std::floor(float_arg(context, x)));
+}
+
+static M_BaseObject* math_trunc(ThreadContext* context, M_BaseObject* x)
+{
+    ObjSpace* space = context->get_space();
+
+    if (int_arg(x)) return x;
+    M_BaseObject* impl = space->lookup(x, "__trunc__");
+    if (impl) return space->get_and_call_function(context, impl, {x});
+
+    try {
+        return int_from_double(context, std::trunc(x->to_float(space)));
+    } catch (const NotImplementedException&) {
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "type %s doesn't define __trunc__ method",
+                                  space->get_type_name(x).c_str());
+    }
+}
+
+static M_BaseObject* math_degrees(ThreadContext* context, M_BaseObject* x)
+{
+    return context->get_space()->wrap_float(
+        context, float_arg(context, x) * (180.0 / M_PI));
+}
+
+static M_BaseObject* math_radians(ThreadContext* context, M_BaseObject* x)
+{
+    return context->get_space()->wrap_float(
+        context, float_arg(context, x) * (M_PI / 180.0));
+}
+
+static M_BaseObject* math_isfinite(ThreadContext* context, M_BaseObject* x)
+{
+    return context->get_space()->new_bool(
+        std::isfinite(float_arg(context, x)));
+}
+
+static M_BaseObject* math_isinf(ThreadContext* context, M_BaseObject* x)
+{
+    return context->get_space()->new_bool(std::isinf(float_arg(context, x)));
+}
+
+static M_BaseObject* math_isnan(ThreadContext* context, M_BaseObject* x)
+{
+    return context->get_space()->new_bool(std::isnan(float_arg(context, x)));
+}
+
+static M_BaseObject* math_frexp(ThreadContext* context, M_BaseObject* arg)
+{
+    ObjSpace* space = context->get_space();
+    double x = float_arg(context, arg);
+    int exp = 0;
+
+    /* frexp() leaves exp unspecified for infinities and NaNs */
+    double m = std::isfinite(x) ? std::frexp(x, &exp) : x;
+
+    return space->new_tuple(context, {space->wrap_float(context, m),
+                                      space->wrap_int(context, exp)});
+}
+
+static M_BaseObject* math_ldexp(ThreadContext* context, M_BaseObject* arg,
+                                M_BaseObject* i)
+{
+    ObjSpace* space = context->get_space();
+    double x = float_arg(context, arg);
+
+    if (!int_arg(i))
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "Expected an int as second "
+                                                   "argument to ldexp."));
+
+    double r = std::ldexp(x, space->unwrap_int(i));
+    if (std::isinf(r) && std::isfinite(x)) throw range_error(context);
+
+    return space->wrap_float(context, r);
+}
+
+static M_BaseObject* math_modf(ThreadContext* context, M_BaseObject* arg)
+{
+    ObjSpace* space = context->get_space();
+    double x = float_arg(context, arg);
+    double ip;
+    double frac;
+
+    if (std::isinf(x)) {
+        ip = x;
+        frac = std::copysign(0.0, x);
+    } else {
+        frac = std::modf(x, &ip);
+    }
+
+    return space->new_tuple(context, {space->wrap_float(context, frac),
+                                      space->wrap_float(context, ip)});
+}
+
+static M_BaseObject* math_factorial(ThreadContext* context, M_BaseObject* x)
+{
+    ObjSpace* space = context->get_space();
+    int n;
+
+    if (int_arg(x)) {
+        n = int_arg(x)->get_value();
+    } else {
+        double v = float_arg(context, x);
+        if (!std::isfinite(v) || v != std::floor(v))
+            throw InterpError(
+                space->ValueError_type(),
+                space->wrap_str(context,
+                                "factorial() only accepts integral values"));
+        if (v < 0.0)
+            n = -1;
+        else
+            n = v > (double)INT_MAX ? INT_MAX : (int)v;
+    }
+
+    if (n < 0)
+        throw InterpError(
+            space->ValueError_type(),
+            space->wrap_str(context,
+                            "factorial() not defined for negative values"));
+
+    /* 12! is the largest factorial that fits in an interpreter int */
+    int result = 1;
+    for (int i = 2; i <= n; i++) {
+        if (result > INT_MAX / i)
+            throw InterpError(
+                space->OverflowError_type(),
+                space->wrap_str(context, "factorial() result too large"));
+        result *= i;
+    }
+
+    return space->wrap_int(context, result);
+}
+
+static M_BaseObject* math_isqrt(ThreadContext* context, M_BaseObject* x)
+{
+    ObjSpace* space = context->get_space();
+
+    if (!int_arg(x))
+        throw InterpError::format(
+            space, space->TypeError_type(),
+            "'%s' object cannot be interpreted as an integer",
+            space->get_type_name(x).c_str());
+
+    int n = int_arg(x)->get_value();
+    if (n < 0)
+        throw InterpError(
+            space->ValueError_type(),
+            space->wrap_str(context, "isqrt() argument must be nonnegative"));
+
+    /* the double estimate is off by at most one for 31-bit arguments */
+    std::int64_t r = (std::int64_t)std::sqrt((double)n);
+    while (r * r > n)
+        r--;
+    while ((r + 1) * (r + 1) <= n)
+        r++;
+
+    return space->wrap_int(context, (int)r);
+}
+
+/* Exactly rounded sum of the floats of an iterable, with Shewchuk's
+ * algorithm like CPython's math_fsum(). partials holds non-overlapping
+ * doubles in increasing magnitude that add up to the exact sum so far. */
+static M_BaseObject* math_fsum(ThreadContext* context, M_BaseObject* seq)
+{
+    ObjSpace* space = context->get_space();
+    std::vector<double> partials;
+    double special_sum = 0.0;
+    double inf_sum = 0.0;
+    volatile double hi, yr, lo = 0.0;
+
+    M_BaseObject* iterator = space->iter(seq);
+    while (M_BaseObject* item = space->next_item(iterator)) {
+        double x = float_arg(context, item);
+        double xsave = x;
+        std::size_t i = 0;
+
+        for (double y : partials) {
+            if (std::fabs(x) < std::fabs(y)) std::swap(x, y);
+            hi = x + y;
+            yr = hi - x;
+            lo = y - yr;
+            if (lo != 0.0) partials[i++] = lo;
+            x = hi;
+        }
+        partials.resize(i);
+
+        if (x == 0.0) continue;
+        if (std::isfinite(x)) {
+            partials.push_back(x);
+            continue;
+        }
+
+        /* a non-finite partial is an overflow unless the item itself was
+         * an infinity or a NaN */
+        if (std::isfinite(xsave))
+            throw InterpError(
+                space->OverflowError_type(),
+                space->wrap_str(context, "intermediate overflow in fsum"));
+        if (std::isinf(xsave)) inf_sum += xsave;
+        special_sum += xsave;
+        partials.clear();
+    }
+
+    if (special_sum != 0.0) {
+        if (std::isnan(inf_sum))
+            throw InterpError(space->ValueError_type(),
+                              space->wrap_str(context, "-inf + inf in fsum"));
+        return space->wrap_float(context, special_sum);
+    }
+
+    hi = 0.0;
+    std::size_t n = partials.size();
+    if (n > 0) {
+        hi = partials[--n];
+        /* add the partials from the top, stopping when the sum becomes
+         * inexact */
+        while (n > 0) {
+            double x = hi;
+            double y = partials[--n];
+            hi = x + y;
+            yr = hi - x;
+            lo = y - yr;
+            if (lo != 0.0) break;
+        }
+        /* round half-way cases to even by looking at the next partial */
+        if (n > 0 && ((lo < 0.0 && partials[n - 1] < 0.0) ||
+                      (lo > 0.0 && partials[n - 1] > 0.0))) {
+            double y = lo * 2.0;
+            double x = hi + y;
+            yr = x - hi;
+            if (y == yr) hi = x;
+        }
+    }
+
+    return space->wrap_float(context, hi);
+}
+
+MathModule::MathModule(ObjSpace* space, M_BaseObject* name)
+    : BuiltinModule(space, name)
+{
+    ThreadContext* context = ThreadContext::current_thread();
+
+    add_def("__doc__",
+            space->wrap_str(context, "This module is always available.  It "
+                                     "provides access to the\nmathematical "
+                                     "functions defined by the C standard."));
+    add_def("pi", space->wrap_float(context, M_PI));
+    add_def("e", space->wrap_float(context, M_E));
+
+    add_def("acos", new InterpFunctionWrapper("acos", math_acos));
+    add_def("acosh", new InterpFunctionWrapper("acosh", math_acosh));
+    add_def("asin", new InterpFunctionWrapper("asin", math_asin));
+    add_def("asinh", new InterpFunctionWrapper("asinh", math_asinh));
+    add_def("atan", new InterpFunctionWrapper("atan", math_atan));
+    add_def("atan2", new InterpFunctionWrapper("atan2", math_atan2));
+    add_def("atanh", new InterpFunctionWrapper("atanh", math_atanh));
+    add_def("ceil", new InterpFunctionWrapper("ceil", math_ceil));
+    add_def("copysign", new InterpFunctionWrapper("copysign", math_copysign));
+    add_def("cos", new InterpFunctionWrapper("cos", math_cos));
+    add_def("cosh", new InterpFunctionWrapper("cosh", math_cosh));
+    add_def("degrees", new InterpFunctionWrapper("degrees", math_degrees));
+    add_def("erf", new InterpFunctionWrapper("erf", math_erf));
+    add_def("erfc", new InterpFunctionWrapper("erfc", math_erfc));
+    add_def("exp", new InterpFunctionWrapper("exp", math_exp));
+    add_def("expm1", new InterpFunctionWrapper("expm1", math_expm1));
+    add_def("fabs", new InterpFunctionWrapper("fabs", math_fabs));
+    add_def("factorial",
+            new InterpFunctionWrapper("factorial", math_factorial));
+    add_def("floor", new InterpFunctionWrapper("floor", math_floor));
+    add_def("fmod", new InterpFunctionWrapper("fmod", math_fmod));
+    add_def("frexp", new InterpFunctionWrapper("frexp", math_frexp));
+    add_def("fsum", new InterpFunctionWrapper("fsum", math_fsum));
+    add_def("gamma", new InterpFunctionWrapper("gamma", math_gamma));
+    add_def("hypot", new InterpFunctionWrapper("hypot", math_hypot));
+    add_def("isfinite", new InterpFunctionWrapper("isfinite", math_isfinite));
+    add_def("isinf", new InterpFunctionWrapper("isinf", math_isinf));
+    add_def("isnan", new InterpFunctionWrapper("isnan", math_isnan));
+    add_def("isqrt", new InterpFunctionWrapper("isqrt", math_isqrt));
+    add_def("ldexp", new InterpFunctionWrapper("ldexp", math_ldexp));
+    add_def("lgamma", new InterpFunctionWrapper("lgamma", math_lgamma));
+    add_def("log", new InterpFunctionWrapper("log", math_log));
+    add_def("log10", new InterpFunctionWrapper("log10", math_log10));
+    add_def("log1p", new InterpFunctionWrapper("log1p", math_log1p));
+    add_def("log2", new InterpFunctionWrapper("log2", math_log2));
+    add_def("modf", new InterpFunctionWrapper("modf", math_modf));
+    add_def("pow", new InterpFunctionWrapper("pow", math_pow));
+    add_def("radians", new InterpFunctionWrapper("radians", math_radians));
+    add_def("sin", new InterpFunctionWrapper("sin", math_sin));
+    add_def("sinh", new InterpFunctionWrapper("sinh", math_sinh));
+    add_def("sqrt", new InterpFunctionWrapper("sqrt", math_sqrt));
+    add_def("tan", new InterpFunctionWrapper("tan", math_tan));
+    add_def("tanh", new InterpFunctionWrapper("tanh", math_tanh));
+    add_def("trunc", new InterpFunctionWrapper("trunc", math_trunc));
+}
+
+} // namespace modules
+} // namespace mtpython
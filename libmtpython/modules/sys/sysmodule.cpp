@@ -29,6 +29,8 @@ SysModule::SysModule(mtpython::vm::ThreadContext* context, M_BaseObject* name)
     add_def("platform",
             space->wrap_str(vm::ThreadContext::current_thread(), PLATFORM));
     add_def("implementation", space->wrap_None());
+    /* the version of the standard library in lib-python, 3.4.0 final */
+    add_def("hexversion", space->wrap_int(context, 0x030400f0));
     add_def("getfilesystemencoding",
             new InterpFunctionWrapper("getfilesystemencoding",
                                       SysModule::getfilesystemencoding));
@@ -0,0 +1,43 @@
+#include <chrono>
+
+#include "modules/time/timemodule.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+
+using namespace mtpython::modules;
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+
+template <typename Clock> static double clock_seconds()
+{
+    return std::chrono::duration<double>(Clock::now().time_since_epoch())
+        .count();
+}
+
+static M_BaseObject* time_time(mtpython::vm::ThreadContext* context)
+{
+    return context->get_space()->wrap_float(
+        context, clock_seconds<std::chrono::system_clock>());
+}
+
+static M_BaseObject* time_monotonic(mtpython::vm::ThreadContext* context)
+{
+    return context->get_space()->wrap_float(
+        context, clock_seconds<std::chrono::steady_clock>());
+}
+
+static M_BaseObject* time_perf_counter(mtpython::vm::ThreadContext* context)
+{
+    return context->get_space()->wrap_float(
+        context, clock_seconds<std::chrono::high_resolution_clock>());
+}
+
+TimeModule::TimeModule(ObjSpace* space, M_BaseObject* name)
+    : BuiltinModule(space, name)
+{
+    add_def("time", new InterpFunctionWrapper("time", time_time));
+    add_def("monotonic",
+            new InterpFunctionWrapper("monotonic", time_monotonic));
+    add_def("perf_counter",
+            new InterpFunctionWrapper("perf_counter", time_perf_counter));
+}
@@ -76,6 +76,18 @@ bool M_BaseObject::del_dict_value(ObjSpace* space, const std::string& attr)
     return false;
 }
 
+M_BaseObject* M_BaseObject::next_item(vm::ThreadContext* context)
+{
+    ObjSpace* space = context->get_space();
+
+    try {
+        return space->next(this);
+    } catch (mtpython::interpreter::InterpError& e) {
+        if (!e.match(space, space->StopIteration_type())) throw e;
+        return nullptr;
+    }
+}
+
 bool mtpython::objects::M_BaseObject::i_is(ObjSpace* space, M_BaseObject* other)
 {
     return this == other;
@@ -1,11 +1,24 @@
 #include "objects/bltin_exceptions.h"
 #include "objects/space_cache.h"
+#include "objects/std/object_object.h"
+#include "objects/std/type_object.h"
+#include "interpreter/arguments.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
 
 using namespace mtpython::objects;
 using namespace mtpython::interpreter;
 
-static mtpython::interpreter::Typedef BaseException_typedef("BaseException",
-                                                            {});
+static mtpython::interpreter::Typedef BaseException_typedef(
+    "BaseException",
+    {
+        {"__new__",
+         new InterpFunctionWrapper("__new__", BaseException::__new__)},
+        {"__init__",
+         new InterpFunctionWrapper("__init__", BaseException::__init__)},
+        {"__str__",
+         new InterpFunctionWrapper("__str__", BaseException::__str__)},
+    });
 
 static mtpython::interpreter::Typedef
     Exception_typedef("Exception", {&BaseException_typedef}, {});
@@ -30,11 +43,33 @@ static mtpython::interpreter::Typedef
     LookupError_typedef("LookupError", {&Exception_typedef}, {});
 static mtpython::interpreter::Typedef
     SyntaxError_typedef("SyntaxError", {&Exception_typedef}, {});
+static mtpython::interpreter::Typedef
+    ArithmeticError_typedef("ArithmeticError", {&Exception_typedef}, {});
+static mtpython::interpreter::Typedef
+    OSError_typedef("OSError", {&Exception_typedef}, {});
+static mtpython::interpreter::Typedef
+    RuntimeError_typedef("RuntimeError", {&Exception_typedef}, {});
+static mtpython::interpreter::Typedef
+    EOFError_typedef("EOFError", {&Exception_typedef}, {});
 
 static mtpython::interpreter::Typedef
     IndexError_typedef("IndexError", {&LookupError_typedef}, {});
 static mtpython::interpreter::Typedef
     UnboundLocalError_typedef("UnboundLocalError", {&NameError_typedef}, {});
+static mtpython::interpreter::Typedef
+    ZeroDivisionError_typedef("ZeroDivisionError", {&ArithmeticError_typedef},
+                              {});
+static mtpython::interpreter::Typedef
+    OverflowError_typedef("OverflowError", {&ArithmeticError_typedef}, {});
+static mtpython::interpreter::Typedef
+    UnicodeError_typedef("UnicodeError", {&ValueError_typedef}, {});
+
+static mtpython::interpreter::Typedef
+    UnicodeEncodeError_typedef("UnicodeEncodeError", {&UnicodeError_typedef},
+                               {});
+static mtpython::interpreter::Typedef
+    UnicodeDecodeError_typedef("UnicodeDecodeError", {&UnicodeError_typedef},
+                               {});
 
 static std::unordered_map<std::string, Typedef*> exception_typedefs{
     {"BaseException", &BaseException_typedef},
@@ -48,8 +83,18 @@ static std::unordered_map<std::string, Typedef*> exception_typedefs{
     {"ValueError", &ValueError_typedef},
     {"SystemError", &SystemError_typedef},
     {"KeyError", &KeyError_typedef},
+    {"LookupError", &LookupError_typedef},
     {"IndexError", &IndexError_typedef},
     {"SyntaxError", &SyntaxError_typedef},
+    {"ArithmeticError", &ArithmeticError_typedef},
+    {"ZeroDivisionError", &ZeroDivisionError_typedef},
+    {"OverflowError", &OverflowError_typedef},
+    {"OSError", &OSError_typedef},
+    {"RuntimeError", &RuntimeError_typedef},
+    {"EOFError", &EOFError_typedef},
+    {"UnicodeError", &UnicodeError_typedef},
+    {"UnicodeEncodeError", &UnicodeEncodeError_typedef},
+    {"UnicodeDecodeError", &UnicodeDecodeError_typedef},
 };
 
 M_BaseObject* BaseException::get_bltin_exception_type(ObjSpace* space,
@@ -58,3 +103,53 @@ M_BaseObject* BaseException::get_bltin_exception_type(ObjSpace* space,
     Typedef* def = exception_typedefs[name];
     return space->get_typeobject(def);
 }
+
+M_BaseObject* BaseException::__new__(mtpython::vm::ThreadContext* context,
+                                     const Arguments& args)
+{
+    static Signature new_signature({"type"}, "args", "kwargs", {});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("__new__", nullptr, new_signature, scope);
+
+    if (!dynamic_cast<M_StdTypeObject*>(scope[0]))
+        throw InterpError::format(
+            space, space->TypeError_type(),
+            "BaseException.__new__(X): X is not a type object (%s)",
+            space->get_type_name(scope[0]).c_str());
+
+    /* exceptions always have a dict to hold args */
+    M_StdObjectObject* instance = new (context) M_StdObjectObject(scope[0]);
+    instance->set_dict(space->new_dict(context));
+    instance->set_dict_value(space, "args", scope[1]);
+
+    return instance;
+}
+
+M_BaseObject* BaseException::__init__(mtpython::vm::ThreadContext* context,
+                                      const Arguments& args)
+{
+    static Signature init_signature({"self"}, "args", "", {});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("__init__", nullptr, init_signature, scope);
+    space->setattr(scope[0], space->wrap_str(context, "args"), scope[1]);
+
+    return space->wrap_None();
+}
+
+M_BaseObject* BaseException::__str__(mtpython::vm::ThreadContext* context,
+                                     M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_BaseObject* args = space->getattr(self, space->wrap_str(context, "args"));
+
+    std::vector<M_BaseObject*> items;
+    space->unwrap_tuple(args, items);
+    if (items.empty()) return space->wrap_str(context, "");
+    if (items.size() == 1) return space->str(items[0]);
+
+    return space->str(args);
+}
@@ -3,14 +3,26 @@
 #include "interpreter/function.h"
 #include "interpreter/error.h"
 #include "objects/space_cache.h"
+#include "objects/buffer.h"
 
+#include "modules/_bisect/bisectmodule.h"
 #include "modules/_collections/collectionsmodule.h"
+#include "modules/_functools/functoolsmodule.h"
+#include "modules/_heapq/heapqmodule.h"
 #include "modules/_io/iomodule.h"
+#include "modules/_json/jsonmodule.h"
+#include "modules/_random/randommodule.h"
+#include "modules/_sre/sremodule.h"
+#include "modules/_struct/structmodule.h"
+#include "modules/array/arraymodule.h"
 #include "modules/builtins/bltinmodule.h"
+#include "modules/itertools/itertoolsmodule.h"
+#include "modules/math/mathmodule.h"
 #include "modules/posix/posixmodule.h"
 #include "modules/sys/sysmodule.h"
 #include "modules/_weakref/weakrefmodule.h"
 #include "modules/errno/errnomodule.h"
+#include "modules/time/timemodule.h"
 
 #include "macros.h"
 
@@ -76,6 +88,12 @@ void ObjSpace::make_builtins()
     errno_mod->install();
     builtin_names.push_back(wrap_str(ThreadContext::current_thread(), "errno"));
 
+    M_BaseObject* time_name = wrap_str(ThreadContext::current_thread(), "time");
+    mtpython::modules::TimeModule* time_mod =
+        new mtpython::modules::TimeModule(this, time_name);
+    time_mod->install();
+    builtin_names.push_back(wrap_str(ThreadContext::current_thread(), "time"));
+
     M_BaseObject* _collections_name =
         wrap_str(ThreadContext::current_thread(), "_collections");
     mtpython::modules::CollectionsModule* collections_mod =
@@ -84,6 +102,80 @@ void ObjSpace::make_builtins()
     builtin_names.push_back(
         wrap_str(ThreadContext::current_thread(), "_collections"));
 
+    M_BaseObject* itertools_name =
+        wrap_str(ThreadContext::current_thread(), "itertools");
+    mtpython::modules::ItertoolsModule* itertools_mod =
+        new mtpython::modules::ItertoolsModule(this, itertools_name);
+    itertools_mod->install();
+    builtin_names.push_back(
+        wrap_str(ThreadContext::current_thread(), "itertools"));
+
+    M_BaseObject* _heapq_name =
+        wrap_str(ThreadContext::current_thread(), "_heapq");
+    mtpython::modules::HeapqModule* heapq_mod =
+        new mtpython::modules::HeapqModule(this, _heapq_name);
+    heapq_mod->install();
+    builtin_names.push_back(
+        wrap_str(ThreadContext::current_thread(), "_heapq"));
+
+    M_BaseObject* _bisect_name =
+        wrap_str(ThreadContext::current_thread(), "_bisect");
+    mtpython::modules::BisectModule* bisect_mod =
+        new mtpython::modules::BisectModule(this, _bisect_name);
+    bisect_mod->install();
+    builtin_names.push_back(
+        wrap_str(ThreadContext::current_thread(), "_bisect"));
+
+    M_BaseObject* _functools_name =
+        wrap_str(ThreadContext::current_thread(), "_functools");
+    mtpython::modules::FunctoolsModule* functools_mod =
+        new mtpython::modules::FunctoolsModule(this, _functools_name);
+    functools_mod->install();
+    builtin_names.push_back(
+        wrap_str(ThreadContext::current_thread(), "_functools"));
+
+    M_BaseObject* array_name =
+        wrap_str(ThreadContext::current_thread(), "array");
+    mtpython::modules::ArrayModule* array_mod =
+        new mtpython::modules::ArrayModule(this, array_name);
+    array_mod->install();
+    builtin_names.push_back(wrap_str(ThreadContext::current_thread(), "array"));
+
+    M_BaseObject* _struct_name =
+        wrap_str(ThreadContext::current_thread(), "_struct");
+    mtpython::modules::StructModule* struct_mod =
+        new mtpython::modules::StructModule(this, _struct_name);
+    struct_mod->install();
+    builtin_names.push_back(
+        wrap_str(ThreadContext::current_thread(), "_struct"));
+
+    M_BaseObject* _json_name =
+        wrap_str(ThreadContext::current_thread(), "_json");
+    mtpython::modules::JsonModule* json_mod =
+        new mtpython::modules::JsonModule(this, _json_name);
+    json_mod->install();
+    builtin_names.push_back(wrap_str(ThreadContext::current_thread(), "_json"));
+
+    M_BaseObject* _sre_name = wrap_str(ThreadContext::current_thread(), "_sre");
+    mtpython::modules::SreModule* sre_mod =
+        new mtpython::modules::SreModule(this, _sre_name);
+    sre_mod->install();
+    builtin_names.push_back(wrap_str(ThreadContext::current_thread(), "_sre"));
+
+    M_BaseObject* math_name = wrap_str(ThreadContext::current_thread(), "math");
+    mtpython::modules::MathModule* math_mod =
+        new mtpython::modules::MathModule(this, math_name);
+    math_mod->install();
+    builtin_names.push_back(wrap_str(ThreadContext::current_thread(), "math"));
+
+    M_BaseObject* _random_name =
+        wrap_str(ThreadContext::current_thread(), "_random");
+    mtpython::modules::RandomModule* random_mod =
+        new mtpython::modules::RandomModule(this, _random_name);
+    random_mod->install();
+    builtin_names.push_back(
+        wrap_str(ThreadContext::current_thread(), "_random"));
+
     setitem(sys_mod->get_dict(this),
             wrap_str(ThreadContext::current_thread(), "builtin_module_names"),
             new_tuple(ThreadContext::current_thread(), builtin_names));
@@ -97,7 +189,18 @@ void ObjSpace::setup_builtin_modules()
     get_builtin_module("posix");
     get_builtin_module("_weakref");
     get_builtin_module("errno");
+    get_builtin_module("time");
     get_builtin_module("_collections");
+    get_builtin_module("itertools");
+    get_builtin_module("_heapq");
+    get_builtin_module("_bisect");
+    get_builtin_module("_functools");
+    get_builtin_module("array");
+    get_builtin_module("_struct");
+    get_builtin_module("_json");
+    get_builtin_module("_sre");
+    get_builtin_module("math");
+    get_builtin_module("_random");
 }
 
 void ObjSpace::init_builtin_exceptions()
@@ -115,6 +218,14 @@ void ObjSpace::init_builtin_exceptions()
     SET_EXCEPTION_TYPE(KeyError);
     SET_EXCEPTION_TYPE(IndexError);
     SET_EXCEPTION_TYPE(SyntaxError);
+    SET_EXCEPTION_TYPE(ZeroDivisionError);
+    SET_EXCEPTION_TYPE(OverflowError);
+    SET_EXCEPTION_TYPE(LookupError);
+    SET_EXCEPTION_TYPE(UnicodeEncodeError);
+    SET_EXCEPTION_TYPE(UnicodeDecodeError);
+    SET_EXCEPTION_TYPE(OSError);
+    SET_EXCEPTION_TYPE(RuntimeError);
+    SET_EXCEPTION_TYPE(EOFError);
 }
 
 void ObjSpace::mark_roots(gc::GarbageCollector* gc)
@@ -157,42 +268,60 @@ std::string ObjSpace::get_type_name(M_BaseObject* obj)
     return def->get_name();
 }
 
-M_BaseObject* ObjSpace::execute_binop(M_BaseObject* impl, M_BaseObject* left,
-                                      M_BaseObject* right)
+/* Try the left operand's slot, then the reflected slot of the right operand.
+ * Returns nullptr if neither side implements the operation. */
+M_BaseObject* ObjSpace::call_binary_slots(BinarySlot left, BinarySlot right,
+                                          M_BaseObject* obj1,
+                                          M_BaseObject* obj2, bool compare)
 {
-    Function* func = dynamic_cast<Function*>(impl);
-    if (!func) return nullptr;
+    ThreadContext* context = ThreadContext::current_thread();
+    M_BaseObject* not_implemented = wrap_NotImplemented();
+
+    if (left) {
+        M_BaseObject* result = left(context, obj1, obj2);
+        if (result && result != not_implemented) return result;
+    }
+
+    /* Comparisons try the reflected operation even for operands of the same
+     * type so that only __lt__ is needed for both a < b and b > a */
+    if (right && (compare || type(obj1) != type(obj2))) {
+        M_BaseObject* result = right(context, obj2, obj1);
+        if (result && result != not_implemented) return result;
+    }
 
-    return call_function(ThreadContext::current_thread(), func, {left, right});
+    return nullptr;
 }
 
 M_BaseObject* ObjSpace::hash(M_BaseObject* obj)
 {
-    M_BaseObject* descr = lookup(obj, "__hash__");
-    if (!descr) {
+    UnarySlot slot = type_slots(obj)->hash;
+    if (!slot) {
         return obj->unique_id(this);
     }
 
-    M_BaseObject* hash_value =
-        get_and_call_function(ThreadContext::current_thread(), descr, {obj});
+    M_BaseObject* hash_value = slot(ThreadContext::current_thread(), obj);
+    if (!hash_value)
+        throw InterpError::format(this, TypeError_type(),
+                                  "unhashable type: '%s'",
+                                  get_type_name(obj).c_str());
 
     return hash_value;
 }
 
 bool ObjSpace::is_true(M_BaseObject* obj)
 {
-    M_BaseObject* descr = lookup(obj, "__bool__");
-    if (!descr) {
-        descr = lookup(obj, "__len__");
-        if (!descr) return true;
+    if (obj == wrap_True()) return true;
+    if (obj == wrap_False() || obj == wrap_None()) return false;
 
-        M_BaseObject* result = get_and_call_function(
-            ThreadContext::current_thread(), descr, {obj});
+    const TypeSlots* slots = type_slots(obj);
+    if (!slots->bool_) {
+        if (!slots->len) return true;
+
+        M_BaseObject* result = slots->len(ThreadContext::current_thread(), obj);
         return unwrap_int(result) != 0;
     }
 
-    M_BaseObject* result =
-        get_and_call_function(ThreadContext::current_thread(), descr, {obj});
+    M_BaseObject* result = slots->bool_(ThreadContext::current_thread(), obj);
 
     if (i_is(result, wrap_True())) return true;
     if (i_is(result, wrap_False())) return false;
@@ -216,108 +345,130 @@ std::size_t ObjSpace::i_hash(M_BaseObject* obj)
     return value;
 }
 
-#define DEF_BINARY_OPER(name, lname, rname)                                 \
-    M_BaseObject* ObjSpace::name(M_BaseObject* obj1, M_BaseObject* obj2)    \
-    {                                                                       \
-        M_BaseObject* type1 = type(obj1);                                   \
-        M_BaseObject* type2 = type(obj2);                                   \
-        M_BaseObject* left_cls;                                             \
-        M_BaseObject* left_impl = lookup_type_cls(type1, #lname, left_cls); \
-        if (!left_impl)                                                     \
-            throw InterpError::format(                                      \
-                this, TypeError_type(),                                     \
-                "unsupported operand type(s) for %s: '%s' and '%s'", #name, \
-                get_type_name(obj1).c_str(), get_type_name(obj2).c_str());  \
-        M_BaseObject* result = execute_binop(left_impl, obj1, obj2);        \
-        return result;                                                      \
+#define DEF_BINARY_OPER(name, rname, symbol)                                 \
+    M_BaseObject* ObjSpace::name(M_BaseObject* obj1, M_BaseObject* obj2)     \
+    {                                                                        \
+        M_BaseObject* result = call_binary_slots(                            \
+            type_slots(obj1)->name, type_slots(obj2)->rname, obj1, obj2);    \
+        if (!result)                                                         \
+            throw InterpError::format(                                       \
+                this, TypeError_type(),                                      \
+                "unsupported operand type(s) for %s: '%s' and '%s'", symbol, \
+                get_type_name(obj1).c_str(), get_type_name(obj2).c_str());   \
+        return result;                                                       \
+    }
+
+/* Fall back to the binary operation if there is no in-place version */
+#define DEF_INPLACE_OPER(name, binop)                                     \
+    M_BaseObject* ObjSpace::name(M_BaseObject* obj1, M_BaseObject* obj2)  \
+    {                                                                     \
+        BinarySlot slot = type_slots(obj1)->name;                         \
+        if (slot) {                                                       \
+            M_BaseObject* result =                                        \
+                slot(ThreadContext::current_thread(), obj1, obj2);        \
+            if (result && result != wrap_NotImplemented()) return result; \
+        }                                                                 \
+        return binop(obj1, obj2);                                         \
     }
 
-#define DEF_UNARY_OPER(name, special_name)                                  \
-    M_BaseObject* ObjSpace::name(M_BaseObject* obj)                         \
-    {                                                                       \
-        M_BaseObject* impl = lookup(obj, #special_name);                    \
-        if (!impl)                                                          \
-            throw InterpError::format(                                      \
-                this, TypeError_type(),                                     \
-                "unsupported operand type for unary %s: '%s'", #name,       \
-                get_type_name(obj).c_str());                                \
-        return get_and_call_function(ThreadContext::current_thread(), impl, \
-                                     {obj});                                \
+#define DEF_UNARY_OPER(name, symbol)                                   \
+    M_BaseObject* ObjSpace::name(M_BaseObject* obj)                    \
+    {                                                                  \
+        UnarySlot slot = type_slots(obj)->name;                        \
+        if (!slot)                                                     \
+            throw InterpError::format(                                 \
+                this, TypeError_type(),                                \
+                "unsupported operand type for unary %s: '%s'", symbol, \
+                get_type_name(obj).c_str());                           \
+        return slot(ThreadContext::current_thread(), obj);             \
     }
 
-#define DEF_CMP_OPER(name, lname, rname, symbol)                            \
-    M_BaseObject* ObjSpace::name(M_BaseObject* obj1, M_BaseObject* obj2)    \
-    {                                                                       \
-        M_BaseObject* type1 = type(obj1);                                   \
-        M_BaseObject* type2 = type(obj2);                                   \
-        M_BaseObject* left_cls;                                             \
-        M_BaseObject* left_impl = lookup_type_cls(type1, #lname, left_cls); \
-        if (!left_impl)                                                     \
-            throw InterpError::format(this, TypeError_type(),               \
-                                      "unorderable types: '%s' %s '%s'",    \
-                                      get_type_name(obj1).c_str(), #symbol, \
-                                      get_type_name(obj2).c_str());         \
-        M_BaseObject* result = execute_binop(left_impl, obj1, obj2);        \
-        return result;                                                      \
+#define DEF_CMP_OPER(name, rname, symbol)                                  \
+    M_BaseObject* ObjSpace::name(M_BaseObject* obj1, M_BaseObject* obj2)   \
+    {                                                                      \
+        M_BaseObject* result = call_binary_slots(                          \
+            type_slots(obj1)->name, type_slots(obj2)->rname, obj1, obj2,   \
+            true);                                                         \
+        if (!result)                                                       \
+            throw InterpError::format(this, TypeError_type(),              \
+                                      "unorderable types: %s() %s %s()",   \
+                                      get_type_name(obj1).c_str(), symbol, \
+                                      get_type_name(obj2).c_str());        \
+        return result;                                                     \
     }
 
-DEF_BINARY_OPER(add, __add__, __radd__)
-DEF_BINARY_OPER(sub, __sub__, __rsub__)
-DEF_BINARY_OPER(mul, __mul__, __rmul__)
-DEF_BINARY_OPER(truediv, __truediv__, __rtruediv__)
-DEF_BINARY_OPER(floordiv, __floodiv__, __rfloordiv__)
-DEF_BINARY_OPER(mod, __mod__, __rmod__)
-DEF_BINARY_OPER(lshift, __lshift__, __rlshift__)
-DEF_BINARY_OPER(rshift, __rshift__, __rrshift__)
-DEF_BINARY_OPER(and_, __and__, __rand__)
-DEF_BINARY_OPER(or_, __or__, __ror__)
-DEF_BINARY_OPER(xor_, __xor__, __rxor__)
-DEF_BINARY_OPER(pow, __pow__, __rpow__)
-
-DEF_BINARY_OPER(inplace_add, __iadd__, __iadd__)
-DEF_BINARY_OPER(inplace_sub, __isub__, __isub__)
-DEF_BINARY_OPER(inplace_mul, __imul__, __imul__)
-DEF_BINARY_OPER(inplace_truediv, __itruediv__, __itruediv__)
-DEF_BINARY_OPER(inplace_floordiv, __ifloodiv__, __ifloordiv__)
-DEF_BINARY_OPER(inplace_mod, __imod__, __imod__)
-DEF_BINARY_OPER(inplace_lshift, __ilshift__, __ilshift__)
-DEF_BINARY_OPER(inplace_rshift, __irshift__, __irshift__)
-DEF_BINARY_OPER(inplace_and, __iand__, __iand__)
-DEF_BINARY_OPER(inplace_or, __ior__, __ior__)
-DEF_BINARY_OPER(inplace_xor, __ixor__, __ixor__)
-DEF_BINARY_OPER(inplace_pow, __ipow__, __ipow__)
-
-DEF_UNARY_OPER(pos, __pos__)
-DEF_UNARY_OPER(neg, __neg__)
-DEF_UNARY_OPER(invert, __invert__)
+DEF_BINARY_OPER(add, radd, "+")
+DEF_BINARY_OPER(sub, rsub, "-")
+DEF_BINARY_OPER(mul, rmul, "*")
+DEF_BINARY_OPER(truediv, rtruediv, "/")
+DEF_BINARY_OPER(floordiv, rfloordiv, "//")
+DEF_BINARY_OPER(mod, rmod, "%")
+DEF_BINARY_OPER(lshift, rlshift, "<<")
+DEF_BINARY_OPER(rshift, rrshift, ">>")
+DEF_BINARY_OPER(and_, rand, "&")
+DEF_BINARY_OPER(or_, ror, "|")
+DEF_BINARY_OPER(xor_, rxor, "^")
+DEF_BINARY_OPER(pow, rpow, "**")
+
+DEF_INPLACE_OPER(inplace_add, add)
+DEF_INPLACE_OPER(inplace_sub, sub)
+DEF_INPLACE_OPER(inplace_mul, mul)
+DEF_INPLACE_OPER(inplace_truediv, truediv)
+DEF_INPLACE_OPER(inplace_floordiv, floordiv)
+DEF_INPLACE_OPER(inplace_mod, mod)
+DEF_INPLACE_OPER(inplace_lshift, lshift)
+DEF_INPLACE_OPER(inplace_rshift, rshift)
+DEF_INPLACE_OPER(inplace_and, and_)
+DEF_INPLACE_OPER(inplace_or, or_)
+DEF_INPLACE_OPER(inplace_xor, xor_)
+DEF_INPLACE_OPER(inplace_pow, pow)
+
+DEF_UNARY_OPER(pos, "+")
+DEF_UNARY_OPER(neg, "-")
+DEF_UNARY_OPER(invert, "~")
 
 M_BaseObject* ObjSpace::eq(M_BaseObject* obj1, M_BaseObject* obj2)
 {
-    M_BaseObject* type1 = type(obj1);
-    M_BaseObject* type2 = type(obj2);
-    M_BaseObject* left_cls;
-    M_BaseObject* left_impl = lookup_type_cls(type1, "__eq__", left_cls);
-    if (!left_impl) return new_bool(i_is(obj1, obj2));
-    M_BaseObject* result = execute_binop(left_impl, obj1, obj2);
+    M_BaseObject* result = call_binary_slots(
+        type_slots(obj1)->eq, type_slots(obj2)->eq, obj1, obj2, true);
+    if (!result) return new_bool(i_is(obj1, obj2));
     return result;
 }
 
 M_BaseObject* ObjSpace::ne(M_BaseObject* obj1, M_BaseObject* obj2)
 {
-    M_BaseObject* type1 = type(obj1);
-    M_BaseObject* type2 = type(obj2);
-    M_BaseObject* left_cls;
-    M_BaseObject* left_impl = lookup_type_cls(type1, "__ne__", left_cls);
-    if (!left_impl) return not_(eq(obj1, obj2));
-    M_BaseObject* result = execute_binop(left_impl, obj1, obj2);
+    M_BaseObject* result = call_binary_slots(
+        type_slots(obj1)->ne, type_slots(obj2)->ne, obj1, obj2, true);
+    if (!result) return not_(eq(obj1, obj2));
     return result;
 }
 
-DEF_CMP_OPER(lt, __lt__, __lt__, <)
-DEF_CMP_OPER(le, __le__, __le__, <=)
-DEF_CMP_OPER(gt, __gt__, __gt__, >)
-DEF_CMP_OPER(ge, __ge__, __ge__, >=)
-DEF_CMP_OPER(contains, __contains__, __contains__, in)
+DEF_CMP_OPER(lt, gt, "<")
+DEF_CMP_OPER(le, ge, "<=")
+DEF_CMP_OPER(gt, lt, ">")
+DEF_CMP_OPER(ge, le, ">=")
+
+M_BaseObject* ObjSpace::contains(M_BaseObject* obj1, M_BaseObject* obj2)
+{
+    BinarySlot slot = type_slots(obj1)->contains;
+    if (slot) return slot(ThreadContext::current_thread(), obj1, obj2);
+
+    /* no __contains__, search the iterable */
+    M_BaseObject* iterator = iter(obj1);
+    while (true) {
+        M_BaseObject* item;
+        try {
+            item = next(iterator);
+        } catch (InterpError& e) {
+            if (!e.match(this, StopIteration_type())) throw e;
+            break;
+        }
+
+        if (i_eq(item, obj2)) return wrap_True();
+    }
+
+    return wrap_False();
+}
 
 int ObjSpace::unwrap_int(M_BaseObject* obj, bool allow_conversion)
 {
@@ -334,6 +485,44 @@ int ObjSpace::unwrap_int(M_BaseObject* obj, bool allow_conversion)
     return result;
 }
 
+double ObjSpace::unwrap_float(M_BaseObject* obj)
+{
+    double result;
+    try {
+        result = obj->to_float(this);
+    } catch (const NotImplementedException&) {
+        throw InterpError::format(
+            this, TypeError_type(),
+            "'%s' object cannot be converted to interpreter-level float",
+            get_type_name(obj).c_str());
+    }
+
+    return result;
+}
+
+void ObjSpace::get_buffer(M_BaseObject* obj, Buffer& view, bool writable,
+                          bool contiguous)
+{
+    try {
+        obj->get_buffer(this, view);
+    } catch (const NotImplementedException&) {
+        throw InterpError::format(this, TypeError_type(),
+                                  "a bytes-like object is required, not '%s'",
+                                  get_type_name(obj).c_str());
+    }
+
+    if (writable && view.readonly)
+        throw InterpError::format(
+            this, TypeError_type(),
+            "a read-write bytes-like object is required, not '%s'",
+            get_type_name(obj).c_str());
+    if (contiguous && !view.is_contiguous())
+        throw InterpError::format(this, TypeError_type(),
+                                  "a contiguous bytes-like object is "
+                                  "required, not '%s'",
+                                  get_type_name(obj).c_str());
+}
+
 M_BaseObject* ObjSpace::not_(M_BaseObject* obj)
 {
     return new_bool(!is_true(obj));
@@ -341,57 +530,63 @@ M_BaseObject* ObjSpace::not_(M_BaseObject* obj)
 
 M_BaseObject* ObjSpace::str(M_BaseObject* obj)
 {
-    M_BaseObject* descr = lookup(obj, "__str__");
-    if (!descr) {
+    UnarySlot slot = type_slots(obj)->str;
+    if (!slot) {
         throw InterpError::format(this, TypeError_type(),
                                   "unsupported operand type for str '%s'",
                                   get_type_name(obj).c_str());
     }
-    return get_and_call_function(ThreadContext::current_thread(), descr, {obj});
+    return slot(ThreadContext::current_thread(), obj);
 }
 
 M_BaseObject* ObjSpace::repr(M_BaseObject* obj)
 {
-    M_BaseObject* descr = lookup(obj, "__repr__");
-    if (!descr) {
+    UnarySlot slot = type_slots(obj)->repr;
+    if (!slot) {
         throw InterpError::format(this, TypeError_type(),
                                   "unsupported operand type for repr '%s'",
                                   get_type_name(obj).c_str());
     }
-    return get_and_call_function(ThreadContext::current_thread(), descr, {obj});
+    return slot(ThreadContext::current_thread(), obj);
 }
 
 M_BaseObject* ObjSpace::iter(M_BaseObject* obj)
 {
-    M_BaseObject* descr = lookup(obj, "__iter__");
-    if (!descr) {
-        descr = lookup(obj, "__getitem__");
-        if (!descr)
-            throw InterpError::format(this, TypeError_type(),
-                                      "'%s' object is not iterable",
-                                      get_type_name(obj).c_str());
+    ThreadContext* context = ThreadContext::current_thread();
+    const TypeSlots* slots = type_slots(obj);
+    M_BaseObject* iterator;
+
+    if (slots->iter) {
+        iterator = slots->iter(context, obj);
+    } else if (slots->getitem) {
+        iterator = new_seqiter(context, obj);
+    } else {
+        throw InterpError::format(this, TypeError_type(),
+                                  "'%s' object is not iterable",
+                                  get_type_name(obj).c_str());
     }
 
-    M_BaseObject* iterator =
-        get_and_call_function(ThreadContext::current_thread(), descr, {obj});
-    M_BaseObject* next = lookup(iterator, "__next__");
-    if (!next)
+    if (!type_slots(iterator)->next)
         throw InterpError(TypeError_type(),
-                          wrap_str(ThreadContext::current_thread(),
-                                   "iter() returned non-iterator"));
+                          wrap_str(context, "iter() returned non-iterator"));
 
     return iterator;
 }
 
 M_BaseObject* ObjSpace::next(M_BaseObject* obj)
 {
-    M_BaseObject* descr = lookup(obj, "__next__");
-    if (!descr) {
+    UnarySlot slot = type_slots(obj)->next;
+    if (!slot) {
         throw InterpError::format(this, TypeError_type(),
                                   "'%s' object is not an iterator",
                                   get_type_name(obj).c_str());
     }
-    return get_and_call_function(ThreadContext::current_thread(), descr, {obj});
+    return slot(ThreadContext::current_thread(), obj);
+}
+
+M_BaseObject* ObjSpace::next_item(M_BaseObject* obj)
+{
+    return obj->next_item(ThreadContext::current_thread());
 }
 
 M_BaseObject* ObjSpace::new_interned_str(const std::string& x)
@@ -448,7 +643,9 @@ M_BaseObject* ObjSpace::call_obj_args(ThreadContext* context,
         return as_func->call_obj_args(context, obj, args);
     }
 
-    return nullptr;
+    /* methods bound to other callables pass the instance first */
+    args.prepend(obj);
+    return call_args(context, func, args);
 }
 
 M_BaseObject* ObjSpace::get(M_BaseObject* descr, M_BaseObject* obj,
@@ -496,6 +693,20 @@ ObjSpace::call_function(ThreadContext* context, M_BaseObject* func,
     return call_args(context, func, arguments);
 }
 
+void ObjSpace::unpack_iterable(M_BaseObject* iterable,
+                               std::vector<M_BaseObject*>& items)
+{
+    try {
+        iterable->unpack_iterable(this, items);
+        return;
+    } catch (const NotImplementedException&) {
+    }
+
+    M_BaseObject* iterator = iter(iterable);
+    while (M_BaseObject* item = next_item(iterator))
+        items.push_back(item);
+}
+
 M_BaseObject* ObjSpace::getitem_str(M_BaseObject* obj, const std::string& key)
 {
     M_BaseObject* wrapped_key = wrap_str(ThreadContext::current_thread(), key);
@@ -506,15 +717,14 @@ M_BaseObject* ObjSpace::getitem_str(M_BaseObject* obj, const std::string& key)
 
 M_BaseObject* ObjSpace::getitem(M_BaseObject* obj, M_BaseObject* key)
 {
-    M_BaseObject* descr = lookup(obj, "__getitem__");
+    BinarySlot slot = type_slots(obj)->getitem;
 
-    if (!descr)
+    if (!slot)
         throw InterpError::format(this, TypeError_type(),
                                   "'%s' object is not subscriptable",
                                   get_type_name(obj).c_str());
 
-    return get_and_call_function(ThreadContext::current_thread(), descr,
-                                 {obj, key});
+    return slot(ThreadContext::current_thread(), obj, key);
 }
 
 M_BaseObject* ObjSpace::finditem_str(M_BaseObject* obj, const std::string& key)
@@ -548,29 +758,27 @@ void ObjSpace::setitem_str(M_BaseObject* obj, const std::string& key,
 void ObjSpace::setitem(M_BaseObject* obj, M_BaseObject* key,
                        M_BaseObject* value)
 {
-    M_BaseObject* descr = lookup(obj, "__setitem__");
+    TernarySlot slot = type_slots(obj)->setitem;
 
-    if (!descr)
+    if (!slot)
         throw InterpError::format(
             this, TypeError_type(),
             "'%s' object does not support item assignment",
             get_type_name(obj).c_str());
 
-    get_and_call_function(ThreadContext::current_thread(), descr,
-                          {obj, key, value});
+    slot(ThreadContext::current_thread(), obj, key, value);
 }
 
 M_BaseObject* ObjSpace::delitem(M_BaseObject* obj, M_BaseObject* key)
 {
-    M_BaseObject* descr = lookup(obj, "__delitem__");
+    BinarySlot slot = type_slots(obj)->delitem;
 
-    if (!descr)
+    if (!slot)
         throw InterpError::format(this, TypeError_type(),
                                   "'%s' object does not support item deletion",
                                   get_type_name(obj).c_str());
 
-    return get_and_call_function(ThreadContext::current_thread(), descr,
-                                 {obj, key});
+    return slot(ThreadContext::current_thread(), obj, key);
 }
 
 M_BaseObject* ObjSpace::getattr(M_BaseObject* obj, M_BaseObject* name)
@@ -657,20 +865,20 @@ M_BaseObject* ObjSpace::delattr(M_BaseObject* obj, M_BaseObject* name)
 
 M_BaseObject* ObjSpace::abs(M_BaseObject* obj)
 {
-    M_BaseObject* descr = lookup(obj, "__abs__");
+    UnarySlot slot = type_slots(obj)->abs;
 
-    if (!descr) return nullptr;
+    if (!slot) return nullptr;
 
-    return get_and_call_function(ThreadContext::current_thread(), descr, {obj});
+    return slot(ThreadContext::current_thread(), obj);
 }
 
 M_BaseObject* ObjSpace::len(M_BaseObject* obj)
 {
-    M_BaseObject* descr = lookup(obj, "__len__");
+    UnarySlot slot = type_slots(obj)->len;
 
-    if (!descr) return nullptr;
+    if (!slot) return nullptr;
 
-    return get_and_call_function(ThreadContext::current_thread(), descr, {obj});
+    return slot(ThreadContext::current_thread(), obj);
 }
 
 M_BaseObject* ObjSpace::issubtype(M_BaseObject* sub, M_BaseObject* type)
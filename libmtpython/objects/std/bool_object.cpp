@@ -53,6 +53,10 @@ mtpython::interpreter::Typedef* M_StdBoolObject::_bool_typedef()
              new InterpFunctionWrapper("__str__", M_StdBoolObject::__str__)},
             {"__and__",
              new InterpFunctionWrapper("__and__", M_StdBoolObject::__and__)},
+            {"__or__",
+             new InterpFunctionWrapper("__or__", M_StdBoolObject::__or__)},
+            {"__xor__",
+             new InterpFunctionWrapper("__xor__", M_StdBoolObject::__xor__)},
         });
 
     return &bool_typedef;
@@ -87,3 +91,31 @@ M_BaseObject* M_StdBoolObject::__and__(mtpython::vm::ThreadContext* context,
 
     return space->new_bool(z);
 }
+
+M_BaseObject* M_StdBoolObject::__or__(mtpython::vm::ThreadContext* context,
+                                      M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+
+    M_StdBoolObject* self_as_bool = static_cast<M_StdBoolObject*>(self);
+    M_StdBoolObject* other_as_bool = dynamic_cast<M_StdBoolObject*>(other);
+    if (!other_as_bool) {
+        return M_StdIntObject::__or__(context, self, other);
+    }
+
+    return space->new_bool(self_as_bool->intval || other_as_bool->intval);
+}
+
+M_BaseObject* M_StdBoolObject::__xor__(mtpython::vm::ThreadContext* context,
+                                       M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+
+    M_StdBoolObject* self_as_bool = static_cast<M_StdBoolObject*>(self);
+    M_StdBoolObject* other_as_bool = dynamic_cast<M_StdBoolObject*>(other);
+    if (!other_as_bool) {
+        return M_StdIntObject::__xor__(context, self, other);
+    }
+
+    return space->new_bool(self_as_bool->intval != other_as_bool->intval);
+}
@@ -1,34 +1,408 @@
 #include <string>
-#include <iostream>
-#include <unordered_map>
-#include <functional>
+#include <vector>
+#include <algorithm>
+#include <cstring>
 
 #include "interpreter/typedef.h"
 #include "interpreter/gateway.h"
+#include "interpreter/error.h"
 #include "objects/std/bytearray_object.h"
+#include "objects/std/bytes_object.h"
+#include "objects/std/slice_object.h"
 
 using namespace mtpython::objects;
 using namespace mtpython::interpreter;
 
-M_StdByteArrayObject::M_StdByteArrayObject() {}
+M_StdByteArrayObject*
+M_StdByteArrayObject::create(mtpython::vm::ThreadContext* context,
+                             const void* data, std::size_t size)
+{
+    M_StdByteArrayObject* array = new (context) M_StdByteArrayObject();
+    array->resize(context, size);
+    if (size && data) std::memcpy(array->data(), data, size);
+    return array;
+}
+
+void M_StdByteArrayObject::reserve(mtpython::vm::ThreadContext* context,
+                                   std::size_t capacity)
+{
+    std::size_t old_capacity = storage ? storage->size() : 0;
+    if (capacity <= old_capacity) return;
+
+    /* over-allocate like list so that appending takes amortized O(1) */
+    std::size_t new_capacity = capacity + (capacity >> 3) + 8;
+    M_GCArray<std::uint8_t>* new_storage =
+        M_GCArray<std::uint8_t>::create(context, new_capacity);
+    if (length) std::memcpy(new_storage->begin(), storage->begin(), length);
+    storage = new_storage;
+}
+
+void M_StdByteArrayObject::resize(mtpython::vm::ThreadContext* context,
+                                  std::size_t size)
+{
+    if (size > length) {
+        reserve(context, size);
+        std::memset(storage->begin() + length, 0, size - length);
+    }
+    length = size;
+}
+
+void M_StdByteArrayObject::replace_range(mtpython::vm::ThreadContext* context,
+                                         std::size_t lo, std::size_t hi,
+                                         const std::uint8_t* src, std::size_t n)
+{
+    std::size_t new_length = length - (hi - lo) + n;
+    reserve(context, new_length);
+
+    std::uint8_t* p = data();
+    if (p && hi != length) std::memmove(p + lo + n, p + hi, length - hi);
+    if (n) std::memcpy(p + lo, src, n);
+    length = new_length;
+}
+
+M_BaseObject*
+M_StdByteArrayObject::__new__(mtpython::vm::ThreadContext* context,
+                              const Arguments& args)
+{
+    ObjSpace* space = context->get_space();
+    M_BaseObject* instance = new (context) M_StdByteArrayObject();
+    return space->wrap(context, instance);
+}
+
+M_BaseObject*
+M_StdByteArrayObject::__init__(mtpython::vm::ThreadContext* context,
+                               const Arguments& args)
+{
+    static Signature init_signature({"self", "source", "encoding", "errors"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("bytearray", nullptr, init_signature, scope,
+               {nullptr, nullptr, nullptr});
+
+    M_StdByteArrayObject* self = M_STDBYTEARRAYOBJECT(scope[0]);
+    std::string value =
+        bytes_from_object(context, scope[1], scope[2], scope[3]);
+
+    self->length = 0;
+    self->replace_range(context, 0, 0,
+                        reinterpret_cast<const std::uint8_t*>(value.data()),
+                        value.size());
+
+    return space->wrap_None();
+}
+
+M_BaseObject*
+M_StdByteArrayObject::__iter__(mtpython::vm::ThreadContext* context,
+                               M_BaseObject* self)
+{
+    return context->get_space()->new_seqiter(context, self);
+}
+
+/* A byte value assigned to a bytearray item */
+static std::uint8_t byte_value(mtpython::vm::ThreadContext* context,
+                               M_BaseObject* value)
+{
+    ObjSpace* space = context->get_space();
+    int i = space->i_get_index(value, space->TypeError_type(),
+                               space->wrap_str(context, "byte"));
+
+    if (i < 0 || i > 255)
+        throw InterpError(
+            space->ValueError_type(),
+            space->wrap_str(context, "byte must be in range(0, 256)"));
+    return (std::uint8_t)i;
+}
+
+static std::size_t bytearray_index(mtpython::vm::ThreadContext* context,
+                                   M_StdByteArrayObject* array,
+                                   M_BaseObject* index, const char* msg)
+{
+    ObjSpace* space = context->get_space();
+
+    int i = space->i_get_index(index, space->IndexError_type(),
+                               space->wrap_str(context, "bytearray index"));
+    int size = (int)array->size();
+
+    if (i < 0) i += size;
+    if (i < 0 || i >= size)
+        throw InterpError(space->IndexError_type(),
+                          space->wrap_str(context, msg));
+
+    return (std::size_t)i;
+}
+
+M_BaseObject*
+M_StdByteArrayObject::__setitem__(mtpython::vm::ThreadContext* context,
+                                  M_BaseObject* self, M_BaseObject* index,
+                                  M_BaseObject* value)
+{
+    ObjSpace* space = context->get_space();
+    M_StdByteArrayObject* as_array = M_STDBYTEARRAYOBJECT(self);
+
+    M_StdSliceObject* slice = dynamic_cast<M_StdSliceObject*>(index);
+    if (!slice) {
+        std::size_t i = bytearray_index(context, as_array, index,
+                                        "bytearray index out of range");
+        as_array->data()[i] = byte_value(context, value);
+        return nullptr;
+    }
+
+    long start, stop, step;
+    std::size_t n =
+        slice->unpack_indices(space, as_array->length, start, stop, step);
+
+    /* copy the new bytes first, value may share memory with self */
+    std::string seq = bytes_from_object(context, value, nullptr, nullptr);
+
+    if (step == 1) {
+        as_array->replace_range(
+            context, start, start + n,
+            reinterpret_cast<const std::uint8_t*>(seq.data()), seq.size());
+        return nullptr;
+    }
+
+    if (seq.size() != n) {
+        throw InterpError::format(space, space->ValueError_type(),
+                                  "attempt to assign bytes of size %d to "
+                                  "extended slice of size %d",
+                                  (int)seq.size(), (int)n);
+    }
+
+    for (std::size_t i = 0; i < n; i++, start += step)
+        as_array->data()[start] = seq[i];
+
+    return nullptr;
+}
+
+M_BaseObject*
+M_StdByteArrayObject::__delitem__(mtpython::vm::ThreadContext* context,
+                                  M_BaseObject* self, M_BaseObject* index)
+{
+    ObjSpace* space = context->get_space();
+    M_StdByteArrayObject* as_array = M_STDBYTEARRAYOBJECT(self);
+
+    M_StdSliceObject* slice = dynamic_cast<M_StdSliceObject*>(index);
+    if (!slice) {
+        std::size_t i = bytearray_index(context, as_array, index,
+                                        "bytearray index out of range");
+        as_array->replace_range(context, i, i + 1, nullptr, 0);
+        return nullptr;
+    }
+
+    long start, stop, step;
+    std::size_t n =
+        slice->unpack_indices(space, as_array->length, start, stop, step);
+    if (n == 0) return nullptr;
+
+    if (step == 1) {
+        as_array->replace_range(context, start, start + n, nullptr, 0);
+        return nullptr;
+    }
+
+    if (step < 0) {
+        start += step * (long)(n - 1);
+        step = -step;
+    }
+
+    /* compact the survivors in a single pass */
+    std::uint8_t* p = as_array->data();
+    std::size_t dst = start, next = start, deleted = 0;
+    for (std::size_t src = start; src < as_array->length; src++) {
+        if (deleted < n && src == next) {
+            deleted++;
+            next += step;
+            continue;
+        }
+        p[dst++] = p[src];
+    }
+    as_array->length = dst;
+
+    return nullptr;
+}
+
+M_BaseObject*
+M_StdByteArrayObject::__iadd__(mtpython::vm::ThreadContext* context,
+                               M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_StdByteArrayObject* as_array = M_STDBYTEARRAYOBJECT(self);
+
+    Buffer view;
+    try {
+        other->get_buffer(space, view);
+    } catch (const mtpython::NotImplementedException&) {
+        return space->wrap_NotImplemented();
+    }
+
+    std::string bytes(view.nbytes(), '\0');
+    view.copy_to(reinterpret_cast<std::uint8_t*>(&bytes[0]));
+    as_array->replace_range(context, as_array->length, as_array->length,
+                            reinterpret_cast<const std::uint8_t*>(bytes.data()),
+                            bytes.size());
+
+    return self;
+}
+
+M_BaseObject* M_StdByteArrayObject::append(mtpython::vm::ThreadContext* context,
+                                           M_BaseObject* self,
+                                           M_BaseObject* item)
+{
+    M_StdByteArrayObject* as_array = M_STDBYTEARRAYOBJECT(self);
+    std::uint8_t c = byte_value(context, item);
+
+    as_array->replace_range(context, as_array->length, as_array->length, &c,
+                            1);
+
+    return nullptr;
+}
+
+M_BaseObject* M_StdByteArrayObject::extend(mtpython::vm::ThreadContext* context,
+                                           M_BaseObject* self,
+                                           M_BaseObject* iterable)
+{
+    M_StdByteArrayObject* as_array = M_STDBYTEARRAYOBJECT(self);
+    std::string bytes = bytes_from_object(context, iterable, nullptr, nullptr);
+
+    as_array->replace_range(context, as_array->length, as_array->length,
+                            reinterpret_cast<const std::uint8_t*>(bytes.data()),
+                            bytes.size());
+
+    return nullptr;
+}
+
+M_BaseObject* M_StdByteArrayObject::pop(mtpython::vm::ThreadContext* context,
+                                        const Arguments& args)
+{
+    static Signature pop_signature({"self", "index"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("pop", nullptr, pop_signature, scope,
+               {space->wrap_int(context, -1)});
+    M_StdByteArrayObject* as_array = M_STDBYTEARRAYOBJECT(scope[0]);
+
+    if (!as_array->length)
+        throw InterpError(
+            space->IndexError_type(),
+            space->wrap_str(context, "pop from empty bytearray"));
+
+    std::size_t i = bytearray_index(context, as_array, scope[1],
+                                    "pop index out of range");
+    std::uint8_t c = as_array->data()[i];
+    as_array->replace_range(context, i, i + 1, nullptr, 0);
+
+    return space->wrap_int(context, c);
+}
+
+M_BaseObject* M_StdByteArrayObject::clear(mtpython::vm::ThreadContext* context,
+                                          M_BaseObject* self)
+{
+    M_StdByteArrayObject* as_array = M_STDBYTEARRAYOBJECT(self);
+    as_array->storage = nullptr;
+    as_array->length = 0;
+
+    return nullptr;
+}
+
+M_BaseObject* M_StdByteArrayObject::copy(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self)
+{
+    M_StdByteArrayObject* as_array = M_STDBYTEARRAYOBJECT(self);
+    return create(context, as_array->data(), as_array->length);
+}
 
 Typedef* M_StdByteArrayObject::_bytearray_typedef()
 {
+    /* the methods that don't modify the array are shared with bytes */
     static mtpython::interpreter::Typedef bytearray_typedef(
         "bytearray",
         {
+            {"__new__", new InterpFunctionWrapper(
+                            "__new__", M_StdByteArrayObject::__new__)},
+            {"__init__", new InterpFunctionWrapper(
+                             "__init__", M_StdByteArrayObject::__init__)},
             {"__iter__", new InterpFunctionWrapper(
                              "__iter__", M_StdByteArrayObject::__iter__)},
+            {"__setitem__",
+             new InterpFunctionWrapper("__setitem__",
+                                       M_StdByteArrayObject::__setitem__)},
+            {"__delitem__",
+             new InterpFunctionWrapper("__delitem__",
+                                       M_StdByteArrayObject::__delitem__)},
+            {"__iadd__", new InterpFunctionWrapper(
+                             "__iadd__", M_StdByteArrayObject::__iadd__)},
+            {"append", new InterpFunctionWrapper(
+                           "append", M_StdByteArrayObject::append)},
+            {"extend", new InterpFunctionWrapper(
+                           "extend", M_StdByteArrayObject::extend)},
+            {"pop",
+             new InterpFunctionWrapper("pop", M_StdByteArrayObject::pop)},
+            {"clear",
+             new InterpFunctionWrapper("clear", M_StdByteArrayObject::clear)},
+            {"copy",
+             new InterpFunctionWrapper("copy", M_StdByteArrayObject::copy)},
+            {"__repr__",
+             new InterpFunctionWrapper("__repr__", M_StdBytesObject::__repr__)},
+            {"__len__",
+             new InterpFunctionWrapper("__len__", M_StdBytesObject::__len__)},
+            {"__getitem__", new InterpFunctionWrapper(
+                                "__getitem__", M_StdBytesObject::__getitem__)},
+            {"__contains__",
+             new InterpFunctionWrapper("__contains__",
+                                       M_StdBytesObject::__contains__)},
+            {"__eq__",
+             new InterpFunctionWrapper("__eq__", M_StdBytesObject::__eq__)},
+            {"__ne__",
+             new InterpFunctionWrapper("__ne__", M_StdBytesObject::__ne__)},
+            {"__lt__",
+             new InterpFunctionWrapper("__lt__", M_StdBytesObject::__lt__)},
+            {"__le__",
+             new InterpFunctionWrapper("__le__", M_StdBytesObject::__le__)},
+            {"__gt__",
+             new InterpFunctionWrapper("__gt__", M_StdBytesObject::__gt__)},
+            {"__ge__",
+             new InterpFunctionWrapper("__ge__", M_StdBytesObject::__ge__)},
+            {"__add__",
+             new InterpFunctionWrapper("__add__", M_StdBytesObject::__add__)},
+            {"__mul__",
+             new InterpFunctionWrapper("__mul__", M_StdBytesObject::__mul__)},
+            {"__rmul__",
+             new InterpFunctionWrapper("__rmul__", M_StdBytesObject::__mul__)},
+            {"decode",
+             new InterpFunctionWrapper("decode", M_StdBytesObject::decode)},
+            {"find", new InterpFunctionWrapper("find", M_StdBytesObject::find)},
+            {"rfind",
+             new InterpFunctionWrapper("rfind", M_StdBytesObject::rfind)},
+            {"index",
+             new InterpFunctionWrapper("index", M_StdBytesObject::index)},
+            {"count",
+             new InterpFunctionWrapper("count", M_StdBytesObject::count)},
+            {"startswith", new InterpFunctionWrapper(
+                               "startswith", M_StdBytesObject::startswith)},
+            {"endswith", new InterpFunctionWrapper(
+                             "endswith", M_StdBytesObject::endswith)},
+            {"split",
+             new InterpFunctionWrapper("split", M_StdBytesObject::split)},
+            {"join", new InterpFunctionWrapper("join", M_StdBytesObject::join)},
+            {"strip",
+             new InterpFunctionWrapper("strip", M_StdBytesObject::strip)},
+            {"lstrip",
+             new InterpFunctionWrapper("lstrip", M_StdBytesObject::lstrip)},
+            {"rstrip",
+             new InterpFunctionWrapper("rstrip", M_StdBytesObject::rstrip)},
+            {"replace",
+             new InterpFunctionWrapper("replace", M_StdBytesObject::replace)},
+            {"translate", new InterpFunctionWrapper(
+                              "translate", M_StdBytesObject::translate)},
+            {"lower",
+             new InterpFunctionWrapper("lower", M_StdBytesObject::lower)},
+            {"upper",
+             new InterpFunctionWrapper("upper", M_StdBytesObject::upper)},
+            {"hex", new InterpFunctionWrapper("hex", M_StdBytesObject::hex)},
         });
 
     return &bytearray_typedef;
 }
 
 Typedef* M_StdByteArrayObject::get_typedef() { return _bytearray_typedef(); }
-
-M_BaseObject*
-M_StdByteArrayObject::__iter__(mtpython::vm::ThreadContext* context,
-                               M_BaseObject* self)
-{
-    return context->get_space()->new_seqiter(context, self);
-}
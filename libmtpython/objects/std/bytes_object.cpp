@@ -1,14 +1,1113 @@
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <typeinfo>
+
 #include "interpreter/typedef.h"
 #include "interpreter/gateway.h"
+#include "interpreter/error.h"
 #include "objects/std/bytes_object.h"
+#include "objects/std/bytearray_object.h"
+#include "objects/std/slice_object.h"
+#include "objects/std/tuple_object.h"
+#include "objects/std/unicode_object.h"
+#include "objects/std/int_object.h"
+#include "objects/std/bool_object.h"
+#include "utils/hash_helper.h"
+#include "utils/string_helper.h"
 
 using namespace mtpython::objects;
 using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+using mtpython::StringHelper;
+
+/*
+ * codecs
+ */
+std::string mtpython::objects::normalize_encoding(const std::string& encoding)
+{
+    std::string name;
+    for (char c : encoding)
+        name += c == '_' ? '-' : (char)std::tolower((unsigned char)c);
+
+    if (name == "utf8") return "utf-8";
+    if (name == "us-ascii") return "ascii";
+    if (name == "latin1" || name == "iso-8859-1" || name == "iso8859-1" ||
+        name == "l1")
+        return "latin-1";
+    return name;
+}
+
+static void check_errors(ObjSpace* space, const std::string& errors)
+{
+    if (errors != "strict" && errors != "ignore" && errors != "replace")
+        throw InterpError::format(space, space->LookupError_type(),
+                                  "unknown error handler name '%s'",
+                                  errors.c_str());
+}
+
+/* Length of the valid UTF-8 sequence at p, or 0 if there is none */
+static std::size_t utf8_sequence_length(const std::uint8_t* p, std::size_t n)
+{
+    std::uint8_t c = p[0];
+    std::size_t len;
+    std::uint8_t lo = 0x80, hi = 0xbf;
+
+    if (c < 0x80) return 1;
+    if (c < 0xc2) return 0;
+    if (c < 0xe0) {
+        len = 2;
+    } else if (c < 0xf0) {
+        len = 3;
+        if (c == 0xe0) lo = 0xa0;
+        if (c == 0xed) hi = 0x9f; /* no surrogates */
+    } else if (c < 0xf5) {
+        len = 4;
+        if (c == 0xf0) lo = 0x90;
+        if (c == 0xf4) hi = 0x8f;
+    } else {
+        return 0;
+    }
+
+    if (n < len || p[1] < lo || p[1] > hi) return 0;
+    for (std::size_t i = 2; i < len; i++) {
+        if ((p[i] & 0xc0) != 0x80) return 0;
+    }
+    return len;
+}
+
+std::size_t mtpython::objects::utf8_valid_prefix(const std::uint8_t* data,
+                                                 std::size_t size)
+{
+    std::size_t i = 0;
+    while (i < size) {
+        if (data[i] < 0x80) {
+            i++;
+            continue;
+        }
+
+        std::size_t len = utf8_sequence_length(data + i, size - i);
+        if (!len) break;
+        i += len;
+    }
+    return i;
+}
+
+/* Why utf8_sequence_length() rejected the sequence at p */
+static const char* utf8_error_reason(const std::uint8_t* p, std::size_t n)
+{
+    std::uint8_t c = p[0];
+    if (c < 0xc2 || c >= 0xf5) return "invalid start byte";
+
+    std::size_t len = c < 0xe0 ? 2 : (c < 0xf0 ? 3 : 4);
+    for (std::size_t i = 1; i < len; i++) {
+        if (i == n) return "unexpected end of data";
+        if ((p[i] & 0xc0) != 0x80) break;
+    }
+    return "invalid continuation byte";
+}
+
+static void append_utf8(std::string& s, std::uint32_t cp)
+{
+    if (cp < 0x80) {
+        s += (char)cp;
+    } else if (cp < 0x800) {
+        s += (char)(0xc0 | (cp >> 6));
+        s += (char)(0x80 | (cp & 0x3f));
+    } else {
+        s += (char)(0xe0 | (cp >> 12));
+        s += (char)(0x80 | ((cp >> 6) & 0x3f));
+        s += (char)(0x80 | (cp & 0x3f));
+    }
+}
+
+std::string mtpython::objects::encode_str(ObjSpace* space, const std::string& s,
+                                          const std::string& encoding,
+                                          const std::string& errors)
+{
+    std::string codec = normalize_encoding(encoding);
+    check_errors(space, errors);
+
+    /* str values are already UTF-8 */
+    if (codec == "utf-8") return s;
+
+    std::uint32_t limit;
+    if (codec == "ascii")
+        limit = 0x80;
+    else if (codec == "latin-1")
+        limit = 0x100;
+    else
+        throw InterpError::format(space, space->LookupError_type(),
+                                  "unknown encoding: %s", encoding.c_str());
+
+    std::string result;
+    result.reserve(s.size());
+    const std::uint8_t* p = reinterpret_cast<const std::uint8_t*>(s.data());
+    std::size_t n = s.size();
+
+    for (std::size_t i = 0, index = 0; i < n; index++) {
+        std::size_t len = utf8_sequence_length(p + i, n - i);
+        std::uint32_t cp;
+        if (len <= 1) {
+            cp = p[i];
+            len = 1;
+        } else {
+            cp = p[i] & (0x7f >> len);
+            for (std::size_t j = 1; j < len; j++)
+                cp = (cp << 6) | (p[i + j] & 0x3f);
+        }
+        i += len;
+
+        if (cp < limit) {
+            result += (char)cp;
+        } else if (errors == "replace") {
+            result += '?';
+        } else if (errors == "strict") {
+            throw InterpError::format(
+                space, space->UnicodeEncodeError_type(),
+                "'%s' codec can't encode character '\\u%04x' in position %d: "
+                "ordinal not in range(%d)",
+                codec.c_str(), cp, (int)index, (int)limit);
+        }
+    }
+
+    return result;
+}
+
+std::string mtpython::objects::decode_bytes(ObjSpace* space,
+                                            const std::uint8_t* data,
+                                            std::size_t size,
+                                            const std::string& encoding,
+                                            const std::string& errors)
+{
+    std::string codec = normalize_encoding(encoding);
+    check_errors(space, errors);
+
+    std::string result;
+    result.reserve(size);
+
+    if (codec == "latin-1") {
+        for (std::size_t i = 0; i < size; i++)
+            append_utf8(result, data[i]);
+        return result;
+    }
+
+    bool ascii = codec == "ascii";
+    if (!ascii && codec != "utf-8")
+        throw InterpError::format(space, space->LookupError_type(),
+                                  "unknown encoding: %s", encoding.c_str());
+
+    std::size_t i = 0;
+    while (i < size) {
+        /* copy runs of valid input at once */
+        std::size_t start = i;
+        while (i < size) {
+            std::size_t len =
+                ascii ? (data[i] < 0x80) : utf8_sequence_length(data + i,
+                                                                size - i);
+            if (!len) break;
+            i += len;
+        }
+        result.append(reinterpret_cast<const char*>(data) + start, i - start);
+        if (i == size) break;
+
+        if (errors == "strict") {
+            if (ascii)
+                throw InterpError::format(
+                    space, space->UnicodeDecodeError_type(),
+                    "'ascii' codec can't decode byte 0x%02x in position %d: "
+                    "ordinal not in range(128)",
+                    data[i], (int)i);
+            throw InterpError::format(
+                space, space->UnicodeDecodeError_type(),
+                "'utf-8' codec can't decode byte 0x%02x in position %d: %s",
+                data[i], (int)i, utf8_error_reason(data + i, size - i));
+        }
+        if (errors == "replace") result += "\xef\xbf\xbd";
+        i++;
+    }
+
+    return result;
+}
+
+std::string mtpython::objects::bytes_from_object(
+    mtpython::vm::ThreadContext* context, M_BaseObject* source,
+    M_BaseObject* encoding, M_BaseObject* errors)
+{
+    ObjSpace* space = context->get_space();
+
+    if (!source) {
+        if (encoding || errors)
+            throw InterpError(space->TypeError_type(),
+                              space->wrap_str(context, "encoding or errors "
+                                                       "without sequence "
+                                                       "argument"));
+        return "";
+    }
+
+    M_StdUnicodeObject* as_str = dynamic_cast<M_StdUnicodeObject*>(source);
+    if (as_str) {
+        if (!encoding)
+            throw InterpError(
+                space->TypeError_type(),
+                space->wrap_str(context,
+                                "string argument without an encoding"));
+        return encode_str(space, as_str->get_value(),
+                          space->unwrap_str(encoding),
+                          errors ? space->unwrap_str(errors) : "strict");
+    }
+    if (encoding || errors)
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "encoding without a string "
+                                                   "argument"));
+
+    /* bytes(n) is n zero bytes */
+    if (typeid(*source) == typeid(M_StdIntObject)) {
+        int n = space->unwrap_int(source);
+        if (n < 0)
+            throw InterpError(space->ValueError_type(),
+                              space->wrap_str(context, "negative count"));
+        return std::string(n, '\0');
+    }
+
+    Buffer view;
+    bool has_buffer = true;
+    try {
+        source->get_buffer(space, view);
+    } catch (const mtpython::NotImplementedException&) {
+        has_buffer = false;
+    }
+
+    std::string result;
+    if (has_buffer) {
+        result.resize(view.nbytes());
+        view.copy_to(reinterpret_cast<std::uint8_t*>(&result[0]));
+        return result;
+    }
+
+    std::vector<M_BaseObject*> items;
+    space->unpack_iterable(source, items);
+    result.reserve(items.size());
+    for (auto* item : items) {
+        int value = space->i_get_index(item, space->TypeError_type(), nullptr);
+        if (value < 0 || value > 255)
+            throw InterpError(
+                space->ValueError_type(),
+                space->wrap_str(context, "bytes must be in range(0, 256)"));
+        result += (char)value;
+    }
+
+    return result;
+}
+
+/*
+ * bytes
+ */
+void* M_StdBytesObject::operator new(std::size_t size,
+                                     mtpython::vm::ThreadContext* context,
+                                     std::size_t length)
+{
+    /* bytes have no children and nothing to finalize */
+    return context->get_gc()->allocate(size + length, false);
+}
+
+M_StdBytesObject* M_StdBytesObject::create(mtpython::vm::ThreadContext* context,
+                                           const void* data, std::size_t size)
+{
+    M_StdBytesObject* bytes = new (context, size) M_StdBytesObject(size);
+    if (data)
+        std::memcpy(bytes->data(), data, size);
+    else
+        std::memset(bytes->data(), 0, size);
+    return bytes;
+}
+
+std::size_t M_StdBytesObject::hash()
+{
+    if (!hash_cached) {
+        hash_value = mtpython::HashHelper::hash_bytes(data(), length);
+        hash_cached = true;
+    }
+    return hash_value;
+}
+
+/* The buffer of self, which is bytes or bytearray */
+static inline Buffer self_buffer(ObjSpace* space, M_BaseObject* self)
+{
+    Buffer view;
+    self->get_buffer(space, view);
+    return view;
+}
+
+/* Object of the same type as self holding a copy of data */
+static M_BaseObject* new_like(mtpython::vm::ThreadContext* context,
+                              M_BaseObject* self, const void* data,
+                              std::size_t size)
+{
+    if (dynamic_cast<M_StdByteArrayObject*>(self))
+        return M_StdByteArrayObject::create(context, data, size);
+    return M_StdBytesObject::create(context, data, size);
+}
+
+static inline M_BaseObject* new_like(mtpython::vm::ThreadContext* context,
+                                     M_BaseObject* self, const std::string& s)
+{
+    return new_like(context, self, s.data(), s.size());
+}
+
+/* Contents of a bytes-like argument */
+static std::string buffer_arg(ObjSpace* space, M_BaseObject* obj)
+{
+    Buffer view;
+    space->get_buffer(obj, view, false, false);
+
+    std::string s(view.nbytes(), '\0');
+    view.copy_to(reinterpret_cast<std::uint8_t*>(&s[0]));
+    return s;
+}
+
+M_BaseObject* M_StdBytesObject::__new__(mtpython::vm::ThreadContext* context,
+                                        const Arguments& args)
+{
+    static Signature new_signature({"type", "source", "encoding", "errors"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("bytes", nullptr, new_signature, scope,
+               {nullptr, nullptr, nullptr});
+
+    /* bytes are immutable, return an exact bytes argument unchanged */
+    if (scope[1] && !scope[2] && typeid(*scope[1]) == typeid(M_StdBytesObject))
+        return scope[1];
+
+    std::string value =
+        bytes_from_object(context, scope[1], scope[2], scope[3]);
+    return space->wrap(context, create(context, value.data(), value.size()));
+}
+
+M_BaseObject* M_StdBytesObject::__hash__(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self)
+{
+    return context->get_space()->wrap_int(context,
+                                          (int)M_STDBYTESOBJECT(self)->hash());
+}
+
+M_BaseObject* M_StdBytesObject::__repr__(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self)
+{
+    static const char digits[] = "0123456789abcdef";
+    ObjSpace* space = context->get_space();
+    Buffer view = self_buffer(space, self);
+    const std::uint8_t* p = view.buf;
+    std::size_t n = view.len;
+
+    /* use double quotes only if that avoids escaping */
+    char quote = '\'';
+    if (std::memchr(p, '\'', n) && !std::memchr(p, '"', n)) quote = '"';
+
+    std::string result = "b";
+    result += quote;
+    for (std::size_t i = 0; i < n; i++) {
+        std::uint8_t c = p[i];
+        if (c == quote || c == '\\') {
+            result += '\\';
+            result += (char)c;
+        } else if (c == '\t') {
+            result += "\\t";
+        } else if (c == '\n') {
+            result += "\\n";
+        } else if (c == '\r') {
+            result += "\\r";
+        } else if (c < 0x20 || c >= 0x7f) {
+            result += "\\x";
+            result += digits[c >> 4];
+            result += digits[c & 0xf];
+        } else {
+            result += (char)c;
+        }
+    }
+    result += quote;
+
+    if (dynamic_cast<M_StdByteArrayObject*>(self))
+        result = "bytearray(" + result + ")";
+
+    return space->wrap_str(context, result);
+}
+
+M_BaseObject* M_StdBytesObject::__len__(mtpython::vm::ThreadContext* context,
+                                        M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    return space->wrap_int(context, (int)self_buffer(space, self).len);
+}
+
+M_BaseObject* M_StdBytesObject::__iter__(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self)
+{
+    return context->get_space()->new_seqiter(context, self);
+}
+
+M_BaseObject*
+M_StdBytesObject::__getitem__(mtpython::vm::ThreadContext* context,
+                              M_BaseObject* self, M_BaseObject* index)
+{
+    ObjSpace* space = context->get_space();
+    Buffer view = self_buffer(space, self);
+
+    M_StdSliceObject* slice = dynamic_cast<M_StdSliceObject*>(index);
+    if (slice) {
+        long start, stop, step;
+        std::size_t n =
+            slice->unpack_indices(space, view.len, start, stop, step);
+
+        if (step == 1) return new_like(context, self, view.buf + start, n);
+
+        std::string result(n, '\0');
+        for (std::size_t i = 0; i < n; i++, start += step)
+            result[i] = (char)view.buf[start];
+        return new_like(context, self, result);
+    }
+
+    int i = space->i_get_index(index, space->IndexError_type(),
+                               space->wrap_str(context, "index"));
+    if (i < 0) i += (int)view.len;
+    if (i < 0 || i >= (int)view.len)
+        throw InterpError(space->IndexError_type(),
+                          space->wrap_str(context, "index out of range"));
+
+    return space->wrap_int(context, view.buf[i]);
+}
+
+M_BaseObject*
+M_StdBytesObject::__contains__(mtpython::vm::ThreadContext* context,
+                               M_BaseObject* self, M_BaseObject* obj)
+{
+    ObjSpace* space = context->get_space();
+    Buffer view = self_buffer(space, self);
+
+    if (typeid(*obj) == typeid(M_StdIntObject)) {
+        int value = space->unwrap_int(obj);
+        if (value < 0 || value > 255)
+            throw InterpError(
+                space->ValueError_type(),
+                space->wrap_str(context, "byte must be in range(0, 256)"));
+        return space->new_bool(view.len &&
+                               std::memchr(view.buf, value, view.len));
+    }
+
+    std::string sub = buffer_arg(space, obj);
+    return space->new_bool(StringHelper::find(
+                               reinterpret_cast<const char*>(view.buf),
+                               view.len, sub.data(),
+                               sub.size()) != StringHelper::npos);
+}
+
+/* Three-way comparison of self with another bytes or bytearray, or false if
+ * other is neither */
+static bool compare_bytes(ObjSpace* space, M_BaseObject* self,
+                          M_BaseObject* other, int& result)
+{
+    if (!dynamic_cast<M_StdBytesObject*>(other) &&
+        !dynamic_cast<M_StdByteArrayObject*>(other))
+        return false;
+
+    Buffer a = self_buffer(space, self);
+    Buffer b = self_buffer(space, other);
+    std::size_t n = std::min(a.len, b.len);
+
+    result = n ? std::memcmp(a.buf, b.buf, n) : 0;
+    if (!result) result = (a.len > b.len) - (a.len < b.len);
+    return true;
+}
+
+#define BYTES_COMPARE_OPER(name, op)                                         \
+    M_BaseObject* M_StdBytesObject::name(mtpython::vm::ThreadContext* context, \
+                                         M_BaseObject* self,                   \
+                                         M_BaseObject* other)                  \
+    {                                                                         \
+        ObjSpace* space = context->get_space();                               \
+        int result;                                                           \
+        if (!compare_bytes(space, self, other, result))                       \
+            return space->wrap_NotImplemented();                              \
+        return space->new_bool(result op 0);                                  \
+    }
+
+BYTES_COMPARE_OPER(__eq__, ==)
+BYTES_COMPARE_OPER(__ne__, !=)
+BYTES_COMPARE_OPER(__lt__, <)
+BYTES_COMPARE_OPER(__le__, <=)
+BYTES_COMPARE_OPER(__gt__, >)
+BYTES_COMPARE_OPER(__ge__, >=)
+
+M_BaseObject* M_StdBytesObject::__add__(mtpython::vm::ThreadContext* context,
+                                        M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    Buffer a = self_buffer(space, self);
+    Buffer b;
+
+    try {
+        other->get_buffer(space, b);
+    } catch (const mtpython::NotImplementedException&) {
+        return space->wrap_NotImplemented();
+    }
+
+    std::string result(a.len + b.nbytes(), '\0');
+    std::uint8_t* dst = reinterpret_cast<std::uint8_t*>(&result[0]);
+    a.copy_to(dst);
+    b.copy_to(dst + a.len);
+
+    return new_like(context, self, result);
+}
+
+M_BaseObject* M_StdBytesObject::__mul__(mtpython::vm::ThreadContext* context,
+                                        M_BaseObject* self, M_BaseObject* times)
+{
+    ObjSpace* space = context->get_space();
+    if (typeid(*times) != typeid(M_StdIntObject) &&
+        typeid(*times) != typeid(M_StdBoolObject))
+        return space->wrap_NotImplemented();
+
+    Buffer view = self_buffer(space, self);
+    int n = std::max(space->unwrap_int(times), 0);
+
+    std::string result;
+    result.reserve(view.len * n);
+    for (int i = 0; i < n; i++)
+        result.append(reinterpret_cast<const char*>(view.buf), view.len);
+
+    return new_like(context, self, result);
+}
+
+M_BaseObject* M_StdBytesObject::decode(mtpython::vm::ThreadContext* context,
+                                       const Arguments& args)
+{
+    static Signature decode_signature({"self", "encoding", "errors"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("decode", nullptr, decode_signature, scope,
+               {space->wrap_str(context, "utf-8"),
+                space->wrap_str(context, "strict")});
+    Buffer view = self_buffer(space, scope[0]);
+
+    return space->wrap_str(context,
+                           decode_bytes(space, view.buf, view.len,
+                                        space->unwrap_str(scope[1]),
+                                        space->unwrap_str(scope[2])));
+}
+
+/* Clamp the optional start and end arguments to [0, len]. Returns false if
+ * the range is empty because start is past end */
+static bool adjust_range(ObjSpace* space, std::size_t len,
+                         M_BaseObject* start_obj, M_BaseObject* end_obj,
+                         std::size_t& start, std::size_t& end)
+{
+    long n = (long)len, lo = 0, hi = n;
+
+    if (!space->i_is(start_obj, space->wrap_None()))
+        lo = space->unwrap_int(start_obj);
+    if (!space->i_is(end_obj, space->wrap_None()))
+        hi = space->unwrap_int(end_obj);
+
+    if (lo < 0) lo = std::max(lo + n, 0L);
+    if (hi < 0) hi = std::max(hi + n, 0L);
+    hi = std::min(hi, n);
+    if (lo > hi) return false;
+
+    start = lo;
+    end = hi;
+    return true;
+}
+
+/* The byte value or bytes-like object searched for by find() and count() */
+static std::string sub_arg(ObjSpace* space, M_BaseObject* obj)
+{
+    if (typeid(*obj) == typeid(M_StdIntObject)) {
+        int value = space->unwrap_int(obj);
+        if (value < 0 || value > 255)
+            throw InterpError(space->ValueError_type(),
+                              space->wrap_str(ThreadContext::current_thread(),
+                                              "byte must be in range(0, 256)"));
+        return std::string(1, (char)value);
+    }
+
+    return buffer_arg(space, obj);
+}
+
+static M_BaseObject* bytes_find(mtpython::vm::ThreadContext* context,
+                                const Arguments& args, const char* name,
+                                bool reverse, bool raise)
+{
+    static Signature find_signature({"self", "sub", "start", "end"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse(name, nullptr, find_signature, scope,
+               {space->wrap_None(), space->wrap_None()});
+    std::string sub = sub_arg(space, scope[1]);
+    Buffer view = self_buffer(space, scope[0]);
+    const char* value = reinterpret_cast<const char*>(view.buf);
+
+    std::size_t start, end, pos = StringHelper::npos;
+    if (adjust_range(space, view.len, scope[2], scope[3], start, end)) {
+        if (reverse)
+            pos = StringHelper::rfind(value + start, end - start, sub.data(),
+                                      sub.size());
+        else
+            pos = StringHelper::find(value + start, end - start, sub.data(),
+                                     sub.size());
+    }
+
+    if (pos == StringHelper::npos) {
+        if (raise)
+            throw InterpError(space->ValueError_type(),
+                              space->wrap_str(context, "subsection not found"));
+        return space->wrap_int(context, -1);
+    }
+
+    return space->wrap_int(context, (int)(start + pos));
+}
+
+M_BaseObject* M_StdBytesObject::find(mtpython::vm::ThreadContext* context,
+                                     const Arguments& args)
+{
+    return bytes_find(context, args, "find", false, false);
+}
+
+M_BaseObject* M_StdBytesObject::rfind(mtpython::vm::ThreadContext* context,
+                                      const Arguments& args)
+{
+    return bytes_find(context, args, "rfind", true, false);
+}
+
+M_BaseObject* M_StdBytesObject::index(mtpython::vm::ThreadContext* context,
+                                      const Arguments& args)
+{
+    return bytes_find(context, args, "index", false, true);
+}
+
+M_BaseObject* M_StdBytesObject::count(mtpython::vm::ThreadContext* context,
+                                      const Arguments& args)
+{
+    static Signature count_signature({"self", "sub", "start", "end"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("count", nullptr, count_signature, scope,
+               {space->wrap_None(), space->wrap_None()});
+    std::string sub = sub_arg(space, scope[1]);
+    Buffer view = self_buffer(space, scope[0]);
+
+    std::size_t start, end, n = 0;
+    if (adjust_range(space, view.len, scope[2], scope[3], start, end)) {
+        if (sub.empty())
+            n = end - start + 1;
+        else
+            n = StringHelper::count(
+                reinterpret_cast<const char*>(view.buf) + start, end - start,
+                sub.data(), sub.size());
+    }
+
+    return space->wrap_int(context, (int)n);
+}
+
+static M_BaseObject* bytes_startswith(mtpython::vm::ThreadContext* context,
+                                      const Arguments& args, const char* name,
+                                      bool at_end)
+{
+    static Signature startswith_signature({"self", "prefix", "start", "end"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse(name, nullptr, startswith_signature, scope,
+               {space->wrap_None(), space->wrap_None()});
+
+    std::vector<M_BaseObject*> prefixes;
+    M_StdTupleObject* as_tuple = dynamic_cast<M_StdTupleObject*>(scope[1]);
+    if (as_tuple)
+        prefixes.assign(as_tuple->begin(), as_tuple->end());
+    else
+        prefixes.push_back(scope[1]);
+
+    Buffer view = self_buffer(space, scope[0]);
+    std::size_t start, end;
+    bool in_range =
+        adjust_range(space, view.len, scope[2], scope[3], start, end);
+
+    for (auto* prefix : prefixes) {
+        std::string s = buffer_arg(space, prefix);
+        if (!in_range || s.size() > end - start) continue;
+
+        std::size_t pos = at_end ? end - s.size() : start;
+        if (!std::memcmp(view.buf + pos, s.data(), s.size()))
+            return space->new_bool(true);
+    }
+
+    return space->new_bool(false);
+}
+
+M_BaseObject* M_StdBytesObject::startswith(mtpython::vm::ThreadContext* context,
+                                           const Arguments& args)
+{
+    return bytes_startswith(context, args, "startswith", false);
+}
+
+M_BaseObject* M_StdBytesObject::endswith(mtpython::vm::ThreadContext* context,
+                                         const Arguments& args)
+{
+    return bytes_startswith(context, args, "endswith", true);
+}
+
+static inline bool is_ascii_space(std::uint8_t c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+M_BaseObject* M_StdBytesObject::split(mtpython::vm::ThreadContext* context,
+                                      const Arguments& args)
+{
+    static Signature split_signature({"self", "sep", "maxsplit"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("split", nullptr, split_signature, scope,
+               {space->wrap_None(), space->wrap_int(context, -1)});
+    M_BaseObject* self = scope[0];
+    int maxsplit = space->unwrap_int(scope[2]);
+    std::size_t limit = maxsplit < 0 ? StringHelper::npos : maxsplit;
+    std::vector<M_BaseObject*> parts;
+
+    if (space->i_is(scope[1], space->wrap_None())) {
+        Buffer view = self_buffer(space, self);
+        const std::uint8_t* p = view.buf;
+        std::size_t n = view.len, i = 0;
+
+        while (true) {
+            while (i < n && is_ascii_space(p[i]))
+                i++;
+            if (i == n) break;
+            if (parts.size() == limit) {
+                parts.push_back(new_like(context, self, p + i, n - i));
+                break;
+            }
+
+            std::size_t j = i;
+            while (j < n && !is_ascii_space(p[j]))
+                j++;
+            parts.push_back(new_like(context, self, p + i, j - i));
+            i = j;
+        }
+    } else {
+        std::string sep = buffer_arg(space, scope[1]);
+        std::size_t m = sep.size();
+        if (!m)
+            throw InterpError(space->ValueError_type(),
+                              space->wrap_str(context, "empty separator"));
+
+        Buffer view = self_buffer(space, self);
+        const char* p = reinterpret_cast<const char*>(view.buf);
+        std::size_t n = view.len, i = 0;
+        while (parts.size() < limit) {
+            std::size_t pos = StringHelper::find(p + i, n - i, sep.data(), m);
+            if (pos == StringHelper::npos) break;
+            parts.push_back(new_like(context, self, p + i, pos));
+            i += pos + m;
+        }
+        parts.push_back(new_like(context, self, p + i, n - i));
+    }
+
+    return space->new_list(context, parts);
+}
+
+M_BaseObject* M_StdBytesObject::join(mtpython::vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* iterable)
+{
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> items;
+    space->unpack_iterable(iterable, items);
+
+    Buffer sep = self_buffer(space, self);
+    std::vector<Buffer> views(items.size());
+    std::size_t size = items.empty() ? 0 : sep.len * (items.size() - 1);
+
+    for (std::size_t i = 0; i < items.size(); i++) {
+        try {
+            items[i]->get_buffer(space, views[i]);
+        } catch (const mtpython::NotImplementedException&) {
+            throw InterpError::format(
+                space, space->TypeError_type(),
+                "sequence item %d: expected a bytes-like object, %s found",
+                (int)i, space->get_type_name(items[i]).c_str());
+        }
+        size += views[i].nbytes();
+    }
+
+    std::string result(size, '\0');
+    std::uint8_t* dst = reinterpret_cast<std::uint8_t*>(&result[0]);
+    for (std::size_t i = 0; i < views.size(); i++) {
+        if (i) {
+            std::memcpy(dst, sep.buf, sep.len);
+            dst += sep.len;
+        }
+        views[i].copy_to(dst);
+        dst += views[i].nbytes();
+    }
+
+    return new_like(context, self, result);
+}
+
+static M_BaseObject* bytes_strip(mtpython::vm::ThreadContext* context,
+                                 const Arguments& args, const char* name,
+                                 bool left, bool right)
+{
+    static Signature strip_signature({"self", "chars"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse(name, nullptr, strip_signature, scope, {space->wrap_None()});
+
+    bool table[256] = {false};
+    if (space->i_is(scope[1], space->wrap_None())) {
+        for (int c = 0; c < 256; c++)
+            table[c] = is_ascii_space(c);
+    } else {
+        for (unsigned char c : buffer_arg(space, scope[1]))
+            table[c] = true;
+    }
+
+    Buffer view = self_buffer(space, scope[0]);
+    std::size_t start = 0, end = view.len;
+    while (left && start < end && table[view.buf[start]])
+        start++;
+    while (right && end > start && table[view.buf[end - 1]])
+        end--;
+
+    return new_like(context, scope[0], view.buf + start, end - start);
+}
+
+M_BaseObject* M_StdBytesObject::strip(mtpython::vm::ThreadContext* context,
+                                      const Arguments& args)
+{
+    return bytes_strip(context, args, "strip", true, true);
+}
+
+M_BaseObject* M_StdBytesObject::lstrip(mtpython::vm::ThreadContext* context,
+                                       const Arguments& args)
+{
+    return bytes_strip(context, args, "lstrip", true, false);
+}
+
+M_BaseObject* M_StdBytesObject::rstrip(mtpython::vm::ThreadContext* context,
+                                       const Arguments& args)
+{
+    return bytes_strip(context, args, "rstrip", false, true);
+}
+
+M_BaseObject* M_StdBytesObject::replace(mtpython::vm::ThreadContext* context,
+                                        const Arguments& args)
+{
+    static Signature replace_signature({"self", "old", "new", "count"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("replace", nullptr, replace_signature, scope,
+               {space->wrap_int(context, -1)});
+    std::string old_bytes = buffer_arg(space, scope[1]);
+    std::string new_bytes = buffer_arg(space, scope[2]);
+    int maxcount = space->unwrap_int(scope[3]);
+    std::size_t limit = maxcount < 0 ? StringHelper::npos : maxcount;
+
+    Buffer view = self_buffer(space, scope[0]);
+    const char* value = reinterpret_cast<const char*>(view.buf);
+    std::size_t n = view.len, m = old_bytes.size();
+    std::string result;
+
+    if (!m) {
+        /* insert before every byte and at the end */
+        std::size_t k = std::min(n + 1, limit);
+        result.reserve(n + k * new_bytes.size());
+        for (std::size_t i = 0; i < k; i++) {
+            result += new_bytes;
+            if (i < n) result += value[i];
+        }
+        if (k <= n) result.append(value + k, n - k);
+    } else {
+        std::size_t k =
+            StringHelper::count(value, n, old_bytes.data(), m, limit);
+        result.reserve(n - k * m + k * new_bytes.size());
+        std::size_t i = 0;
+        for (; k > 0; k--) {
+            std::size_t pos =
+                StringHelper::find(value + i, n - i, old_bytes.data(), m);
+            result.append(value + i, pos);
+            result += new_bytes;
+            i += pos + m;
+        }
+        result.append(value + i, n - i);
+    }
+
+    return new_like(context, scope[0], result);
+}
+
+M_BaseObject* M_StdBytesObject::translate(mtpython::vm::ThreadContext* context,
+                                          const Arguments& args)
+{
+    static Signature translate_signature({"self", "table", "delete"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("translate", nullptr, translate_signature, scope, {nullptr});
+
+    std::string table;
+    if (scope[1] != space->wrap_None()) {
+        table = buffer_arg(space, scope[1]);
+        if (table.size() != 256)
+            throw InterpError(space->ValueError_type(),
+                              space->wrap_str(context, "translation table "
+                                                       "must be 256 "
+                                                       "characters long"));
+    }
+
+    bool deleted[256] = {};
+    if (scope[2]) {
+        for (unsigned char c : buffer_arg(space, scope[2]))
+            deleted[c] = true;
+    }
+
+    Buffer view = self_buffer(space, scope[0]);
+    std::string result;
+    result.reserve(view.len);
+    for (std::size_t i = 0; i < view.len; i++) {
+        unsigned char c = view.buf[i];
+        if (deleted[c]) continue;
+        result += table.empty() ? (char)c : table[c];
+    }
+
+    return new_like(context, scope[0], result);
+}
+
+M_BaseObject* M_StdBytesObject::lower(mtpython::vm::ThreadContext* context,
+                                      M_BaseObject* self)
+{
+    Buffer view = self_buffer(context->get_space(), self);
+    std::string result(reinterpret_cast<const char*>(view.buf), view.len);
+
+    for (auto& c : result) {
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+    }
+
+    return new_like(context, self, result);
+}
+
+M_BaseObject* M_StdBytesObject::upper(mtpython::vm::ThreadContext* context,
+                                      M_BaseObject* self)
+{
+    Buffer view = self_buffer(context->get_space(), self);
+    std::string result(reinterpret_cast<const char*>(view.buf), view.len);
+
+    for (auto& c : result) {
+        if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+    }
+
+    return new_like(context, self, result);
+}
+
+M_BaseObject* M_StdBytesObject::hex(mtpython::vm::ThreadContext* context,
+                                    M_BaseObject* self)
+{
+    static const char digits[] = "0123456789abcdef";
+    ObjSpace* space = context->get_space();
+    Buffer view;
+    space->get_buffer(self, view, false, false);
+
+    std::string bytes(view.nbytes(), '\0');
+    view.copy_to(reinterpret_cast<std::uint8_t*>(&bytes[0]));
+
+    std::string result;
+    result.reserve(bytes.size() * 2);
+    for (unsigned char c : bytes) {
+        result += digits[c >> 4];
+        result += digits[c & 0xf];
+    }
 
-static mtpython::interpreter::Typedef bytes_typedef("bytes", {});
+    return space->wrap_str(context, result);
+}
 
-M_StdBytesObject::M_StdBytesObject() {}
+Typedef* M_StdBytesObject::_bytes_typedef()
+{
+    static Typedef bytes_typedef(
+        "bytes",
+        {
+            {"__new__",
+             new InterpFunctionWrapper("__new__", M_StdBytesObject::__new__)},
+            {"__hash__",
+             new InterpFunctionWrapper("__hash__", M_StdBytesObject::__hash__)},
+            {"__repr__",
+             new InterpFunctionWrapper("__repr__", M_StdBytesObject::__repr__)},
+            {"__len__",
+             new InterpFunctionWrapper("__len__", M_StdBytesObject::__len__)},
+            {"__iter__",
+             new InterpFunctionWrapper("__iter__", M_StdBytesObject::__iter__)},
+            {"__getitem__", new InterpFunctionWrapper(
+                                "__getitem__", M_StdBytesObject::__getitem__)},
+            {"__contains__",
+             new InterpFunctionWrapper("__contains__",
+                                       M_StdBytesObject::__contains__)},
+            {"__eq__",
+             new InterpFunctionWrapper("__eq__", M_StdBytesObject::__eq__)},
+            {"__ne__",
+             new InterpFunctionWrapper("__ne__", M_StdBytesObject::__ne__)},
+            {"__lt__",
+             new InterpFunctionWrapper("__lt__", M_StdBytesObject::__lt__)},
+            {"__le__",
+             new InterpFunctionWrapper("__le__", M_StdBytesObject::__le__)},
+            {"__gt__",
+             new InterpFunctionWrapper("__gt__", M_StdBytesObject::__gt__)},
+            {"__ge__",
+             new InterpFunctionWrapper("__ge__", M_StdBytesObject::__ge__)},
+            {"__add__",
+             new InterpFunctionWrapper("__add__", M_StdBytesObject::__add__)},
+            {"__mul__",
+             new InterpFunctionWrapper("__mul__", M_StdBytesObject::__mul__)},
+            {"__rmul__",
+             new InterpFunctionWrapper("__rmul__", M_StdBytesObject::__mul__)},
+            {"decode",
+             new InterpFunctionWrapper("decode", M_StdBytesObject::decode)},
+            {"find", new InterpFunctionWrapper("find", M_StdBytesObject::find)},
+            {"rfind",
+             new InterpFunctionWrapper("rfind", M_StdBytesObject::rfind)},
+            {"index",
+             new InterpFunctionWrapper("index", M_StdBytesObject::index)},
+            {"count",
+             new InterpFunctionWrapper("count", M_StdBytesObject::count)},
+            {"startswith", new InterpFunctionWrapper(
+                               "startswith", M_StdBytesObject::startswith)},
+            {"endswith", new InterpFunctionWrapper(
+                             "endswith", M_StdBytesObject::endswith)},
+            {"split",
+             new InterpFunctionWrapper("split", M_StdBytesObject::split)},
+            {"join", new InterpFunctionWrapper("join", M_StdBytesObject::join)},
+            {"strip",
+             new InterpFunctionWrapper("strip", M_StdBytesObject::strip)},
+            {"lstrip",
+             new InterpFunctionWrapper("lstrip", M_StdBytesObject::lstrip)},
+            {"rstrip",
+             new InterpFunctionWrapper("rstrip", M_StdBytesObject::rstrip)},
+            {"replace",
+             new InterpFunctionWrapper("replace", M_StdBytesObject::replace)},
+            {"translate", new InterpFunctionWrapper(
+                              "translate", M_StdBytesObject::translate)},
+            {"lower",
+             new InterpFunctionWrapper("lower", M_StdBytesObject::lower)},
+            {"upper",
+             new InterpFunctionWrapper("upper", M_StdBytesObject::upper)},
+            {"hex", new InterpFunctionWrapper("hex", M_StdBytesObject::hex)},
+        });
 
-Typedef* M_StdBytesObject::_bytes_typedef() { return &bytes_typedef; }
+    return &bytes_typedef;
+}
 
-Typedef* M_StdBytesObject::get_typedef() { return &bytes_typedef; }
+Typedef* M_StdBytesObject::get_typedef() { return _bytes_typedef(); }
@@ -1,26 +1,381 @@
 #include <string>
-#include <unordered_map>
+#include <typeinfo>
+#include <algorithm>
 #include <assert.h>
 
 #include "interpreter/typedef.h"
 #include "interpreter/gateway.h"
 #include "interpreter/error.h"
 #include "objects/std/dict_object.h"
+#include "objects/std/unicode_object.h"
+#include "objects/std/int_object.h"
+#include "objects/std/bool_object.h"
+#include "objects/std/type_object.h"
 
 using namespace mtpython::objects;
 using namespace mtpython::interpreter;
 
+static inline bool is_exact_str(M_BaseObject* obj)
+{
+    return typeid(*obj) == typeid(M_StdUnicodeObject);
+}
+
+static inline bool is_exact_int(M_BaseObject* obj)
+{
+    const std::type_info& type = typeid(*obj);
+    return type == typeid(M_StdIntObject) || type == typeid(M_StdBoolObject);
+}
+
+std::size_t mtpython::objects::hash_key(ObjSpace* space, M_BaseObject* key)
+{
+    if (is_exact_str(key)) return M_STDUNICODEOBJECT(key)->hash();
+    if (is_exact_int(key)) return (std::size_t)M_STDINTOBJECT(key)->get_value();
+
+    return space->i_hash(key);
+}
+
+bool mtpython::objects::keys_equal(ObjSpace* space, M_BaseObject* lhs,
+                                   M_BaseObject* rhs)
+{
+    if (lhs == rhs) return true;
+
+    if (is_exact_str(lhs) && is_exact_str(rhs)) {
+        M_StdUnicodeObject* lhs_str = M_STDUNICODEOBJECT(lhs);
+        M_StdUnicodeObject* rhs_str = M_STDUNICODEOBJECT(rhs);
+        if (lhs_str->is_interned() && rhs_str->is_interned()) return false;
+        return lhs_str->get_value() == rhs_str->get_value();
+    }
+    if (is_exact_int(lhs) && is_exact_int(rhs))
+        return M_STDINTOBJECT(lhs)->get_value() ==
+               M_STDINTOBJECT(rhs)->get_value();
+
+    return space->i_eq(lhs, rhs);
+}
+
+/* Probe the index table for an entry with the given hash that satisfies eq.
+ * Returns the entry index or IX_EMPTY and stores the table slot of the entry
+ * in slot if it is found. */
+template <typename Eq>
+std::int32_t M_StdDictObject::lookup(std::size_t hash, Eq eq, std::size_t* slot)
+{
+    if (!indices) return IX_EMPTY;
+
+    auto* cur_indices = indices;
+    auto* cur_entries = entries;
+    std::size_t mask = indices->size() - 1;
+    std::size_t perturb = hash;
+    std::size_t i = hash & mask;
+
+    while (true) {
+        std::int32_t ix = (*indices)[i];
+        if (ix == IX_EMPTY) return IX_EMPTY;
+
+        if (ix != IX_DUMMY && (*entries)[ix].hash == hash) {
+            /* eq may call back into Python code and resize the dict, don't
+             * hold a reference to the entry */
+            M_BaseObject* key = (*entries)[ix].key;
+            bool found = eq(key);
+            if (indices != cur_indices || entries != cur_entries ||
+                (*entries)[ix].key != key)
+                return lookup(hash, eq, slot);
+            if (found) {
+                if (slot) *slot = i;
+                return ix;
+            }
+        }
+
+        perturb >>= 5;
+        i = (i * 5 + perturb + 1) & mask;
+    }
+}
+
+std::int32_t M_StdDictObject::lookup_key(M_BaseObject* key, std::size_t hash,
+                                         std::size_t* slot)
+{
+    if (str_keys && is_exact_str(key)) {
+        M_StdUnicodeObject* str = M_STDUNICODEOBJECT(key);
+        bool interned = str->is_interned();
+        return lookup(
+            hash,
+            [str, interned](M_BaseObject* other) {
+                if (other == str) return true;
+                M_StdUnicodeObject* other_str = M_STDUNICODEOBJECT(other);
+                if (interned && other_str->is_interned()) return false;
+                return other_str->get_value() == str->get_value();
+            },
+            slot);
+    }
+
+    return lookup(
+        hash,
+        [this, key](M_BaseObject* other) {
+            return keys_equal(space, other, key);
+        },
+        slot);
+}
+
+std::int32_t M_StdDictObject::lookup_str(const std::string& key,
+                                         std::size_t hash)
+{
+    assert(str_keys);
+    return lookup(
+        hash,
+        [&key](M_BaseObject* other) {
+            return M_STDUNICODEOBJECT(other)->get_value() == key;
+        },
+        nullptr);
+}
+
+std::size_t M_StdDictObject::find_free_slot(std::size_t hash) const
+{
+    std::size_t mask = indices->size() - 1;
+    std::size_t perturb = hash;
+    std::size_t i = hash & mask;
+
+    while ((*indices)[i] >= 0) {
+        perturb >>= 5;
+        i = (i * 5 + perturb + 1) & mask;
+    }
+
+    return i;
+}
+
+void M_StdDictObject::resize(std::size_t min_used)
+{
+    vm::ThreadContext* context = vm::ThreadContext::current_thread();
+    std::size_t new_size = MIN_SIZE;
+    while (new_size * 2 <= min_used * 3)
+        new_size <<= 1;
+
+    M_GCArray<Entry>* new_entries =
+        M_GCArray<Entry>::create(context, new_size * 2 / 3);
+    M_GCArray<std::int32_t>* new_indices =
+        M_GCArray<std::int32_t>::create(context, new_size);
+    std::fill(new_indices->begin(), new_indices->end(), IX_EMPTY);
+
+    /* drop deleted entries */
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < nentries; i++) {
+        if ((*entries)[i].key) (*new_entries)[j++] = (*entries)[i];
+    }
+
+    entries = new_entries;
+    indices = new_indices;
+    nentries = j;
+    for (std::size_t i = 0; i < nentries; i++) {
+        (*indices)[find_free_slot((*entries)[i].hash)] = (std::int32_t)i;
+    }
+}
+
+void M_StdDictObject::insert(M_BaseObject* key, std::size_t hash,
+                             M_BaseObject* value)
+{
+    /* the entry array fills up before the index table is two thirds full */
+    if (!entries || nentries == entries->size()) resize(used * 2 + 1);
+
+    if (str_keys && !is_exact_str(key)) str_keys = false;
+
+    (*indices)[find_free_slot(hash)] = (std::int32_t)nentries;
+    (*entries)[nentries++] = {hash, key, value};
+    used++;
+}
+
 M_BaseObject* M_StdDictObject::getitem(M_BaseObject* key)
 {
-    auto got = dict.find(key);
-    if (got == dict.end()) return nullptr;
+    std::int32_t ix = lookup_key(key, hash_key(space, key));
+    if (ix < 0) return nullptr;
 
-    return got->second;
+    return (*entries)[ix].value;
 }
 
 void M_StdDictObject::setitem(M_BaseObject* key, M_BaseObject* value)
 {
-    dict[key] = value;
+    std::size_t hash = hash_key(space, key);
+    std::int32_t ix = lookup_key(key, hash);
+
+    if (ix >= 0) {
+        (*entries)[ix].value = value;
+        return;
+    }
+
+    insert(key, hash, value);
+}
+
+M_BaseObject*& M_StdDictObject::lookup_or_insert(M_BaseObject* key,
+                                                 M_BaseObject* value)
+{
+    std::size_t hash = hash_key(space, key);
+    std::int32_t ix = lookup_key(key, hash);
+
+    if (ix < 0) {
+        insert(key, hash, value);
+        ix = (std::int32_t)nentries - 1;
+    }
+
+    return (*entries)[ix].value;
+}
+
+M_BaseObject* M_StdDictObject::delitem(M_BaseObject* key)
+{
+    std::size_t slot;
+    std::int32_t ix = lookup_key(key, hash_key(space, key), &slot);
+    if (ix < 0) return nullptr;
+
+    M_BaseObject* value = (*entries)[ix].value;
+    (*indices)[slot] = IX_DUMMY;
+    (*entries)[ix].key = nullptr;
+    (*entries)[ix].value = nullptr;
+    used--;
+
+    return value;
+}
+
+void M_StdDictObject::clear_entries()
+{
+    entries = nullptr;
+    indices = nullptr;
+    nentries = 0;
+    used = 0;
+    str_keys = true;
+}
+
+M_BaseObject* M_StdDictObject::getitem_str(const std::string& key)
+{
+    std::size_t hash = M_StdUnicodeObject::hash_string(key);
+    std::int32_t ix;
+
+    if (str_keys) {
+        ix = lookup_str(key, hash);
+    } else {
+        M_BaseObject* wrapped_key =
+            space->wrap_str(vm::ThreadContext::current_thread(), key);
+        ix = lookup_key(wrapped_key, hash);
+    }
+
+    if (ix < 0) return nullptr;
+    return (*entries)[ix].value;
+}
+
+void M_StdDictObject::setitem_str(vm::ThreadContext* context,
+                                  const std::string& key, M_BaseObject* value)
+{
+    if (!str_keys) {
+        setitem(space->wrap_str(context, key), value);
+        return;
+    }
+
+    std::size_t hash = M_StdUnicodeObject::hash_string(key);
+    std::int32_t ix = lookup_str(key, hash);
+
+    if (ix >= 0) {
+        (*entries)[ix].value = value;
+        return;
+    }
+
+    insert(space->wrap_str(context, key), hash, value);
+}
+
+bool M_StdDictObject::next_entry(std::size_t& pos, M_BaseObject*& key,
+                                 M_BaseObject*& value)
+{
+    while (pos < nentries) {
+        const Entry& entry = (*entries)[pos++];
+        if (entry.key) {
+            key = entry.key;
+            value = entry.value;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void mtpython::objects::update_dict(mtpython::vm::ThreadContext* context,
+                                   M_StdDictObject* dict, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_StdDictObject* other_dict = dynamic_cast<M_StdDictObject*>(other);
+
+    if (other_dict) {
+        std::size_t pos = 0;
+        M_BaseObject *key, *value;
+
+        while (other_dict->next_entry(pos, key, value)) {
+            dict->setitem(key, value);
+        }
+        return;
+    }
+
+    M_BaseObject* keys_method = space->findattr_str(other, "keys");
+    M_BaseObject* iterator;
+
+    if (keys_method) {
+        iterator =
+            space->iter(space->call_function(context, keys_method, {}));
+    } else {
+        iterator = space->iter(other);
+    }
+
+    while (true) {
+        M_BaseObject* item;
+        try {
+            item = space->next(iterator);
+        } catch (InterpError& e) {
+            if (!e.match(space, space->StopIteration_type())) throw e;
+            break;
+        }
+
+        if (keys_method) {
+            dict->setitem(item, space->getitem(other, item));
+            continue;
+        }
+
+        std::vector<M_BaseObject*> pair;
+        M_BaseObject* pair_iter = space->iter(item);
+        while (true) {
+            try {
+                pair.push_back(space->next(pair_iter));
+            } catch (InterpError& e) {
+                if (!e.match(space, space->StopIteration_type())) throw e;
+                break;
+            }
+        }
+
+        if (pair.size() != 2)
+            throw InterpError::format(space, space->ValueError_type(),
+                                      "dictionary update sequence element "
+                                      "has length %d; 2 is required",
+                                      (int)pair.size());
+
+        dict->setitem(pair[0], pair[1]);
+    }
+}
+
+M_BaseObject* M_StdDictObject::__new__(mtpython::vm::ThreadContext* context,
+                                       const Arguments& args)
+{
+    static Signature new_signature({"type", "iterable"}, "", "kwargs", {});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("__new__", nullptr, new_signature, scope, {nullptr});
+
+    M_StdDictObject* dict = new (context) M_StdDictObject(space);
+    if (!space->i_is(scope[0], space->get_typeobject(_dict_typedef()))) {
+        M_StdTypeObject* type_obj = dynamic_cast<M_StdTypeObject*>(scope[0]);
+        if (!type_obj)
+            throw InterpError::format(
+                space, space->TypeError_type(),
+                "dict.__new__(X): X is not a type object (%s)",
+                space->get_type_name(scope[0]).c_str());
+
+        dict->obj_type = type_obj;
+        if (type_obj->has_dict()) dict->obj_dict = space->new_dict(context);
+    }
+    if (scope[1]) update_dict(context, dict, scope[1]);
+    if (scope[2]) update_dict(context, dict, scope[2]);
+
+    return dict;
 }
 
 M_BaseObject* M_StdDictObject::__repr__(mtpython::vm::ThreadContext* context,
@@ -33,13 +388,15 @@ M_BaseObject* M_StdDictObject::__repr__(mtpython::vm::ThreadContext* context,
 
     as_dict->lock();
     str += "{";
+    std::size_t pos = 0;
+    M_BaseObject *key, *value;
     int i = 0;
-    for (auto& item : as_dict->dict) {
+    while (as_dict->next_entry(pos, key, value)) {
         if (i > 0) str += ", ";
-        M_BaseObject* repr_item = space->repr(item.first);
+        M_BaseObject* repr_item = space->repr(key);
         str += space->unwrap_str(repr_item);
         str += ": ";
-        repr_item = space->repr(item.second);
+        repr_item = space->repr(value);
         str += space->unwrap_str(repr_item);
         i++;
     }
@@ -49,6 +406,20 @@ M_BaseObject* M_StdDictObject::__repr__(mtpython::vm::ThreadContext* context,
     return space->wrap_str(context, str);
 }
 
+M_BaseObject* M_StdDictObject::__len__(mtpython::vm::ThreadContext* context,
+                                       M_BaseObject* self)
+{
+    M_StdDictObject* as_dict = static_cast<M_StdDictObject*>(self);
+    return context->get_space()->wrap_int(context, (int)as_dict->size());
+}
+
+M_BaseObject* M_StdDictObject::__iter__(mtpython::vm::ThreadContext* context,
+                                        M_BaseObject* self)
+{
+    M_StdDictObject* as_dict = static_cast<M_StdDictObject*>(self);
+    return new (context) M_StdDictIterObject(as_dict);
+}
+
 M_BaseObject* M_StdDictObject::__getitem__(mtpython::vm::ThreadContext* context,
                                            M_BaseObject* obj, M_BaseObject* key)
 {
@@ -60,6 +431,7 @@ M_BaseObject* M_StdDictObject::__getitem__(mtpython::vm::ThreadContext* context,
     M_BaseObject* value = as_dict->getitem(key);
     as_dict->unlock();
 
+    if (!value) value = as_dict->missing(context, key);
     if (!value) throw InterpError(space->KeyError_type(), key);
     return value;
 }
@@ -77,17 +449,39 @@ M_BaseObject* M_StdDictObject::__setitem__(mtpython::vm::ThreadContext* context,
     return nullptr;
 }
 
+M_BaseObject* M_StdDictObject::__delitem__(mtpython::vm::ThreadContext* context,
+                                           M_BaseObject* obj, M_BaseObject* key)
+{
+    ObjSpace* space = context->get_space();
+    M_StdDictObject* as_dict = static_cast<M_StdDictObject*>(obj);
+
+    as_dict->lock();
+    M_BaseObject* value = as_dict->delitem(key);
+    as_dict->unlock();
+
+    if (!value) throw InterpError(space->KeyError_type(), key);
+    return space->wrap_None();
+}
+
 mtpython::interpreter::Typedef* M_StdDictObject::_dict_typedef()
 {
     static mtpython::interpreter::Typedef dict_typedef(
         "dict",
         {
+            {"__new__",
+             new InterpFunctionWrapper("__new__", M_StdDictObject::__new__)},
             {"__repr__",
              new InterpFunctionWrapper("__repr__", M_StdDictObject::__repr__)},
+            {"__len__",
+             new InterpFunctionWrapper("__len__", M_StdDictObject::__len__)},
+            {"__iter__",
+             new InterpFunctionWrapper("__iter__", M_StdDictObject::__iter__)},
             {"__getitem__", new InterpFunctionWrapper(
                                 "__getitem__", M_StdDictObject::__getitem__)},
             {"__setitem__", new InterpFunctionWrapper(
                                 "__setitem__", M_StdDictObject::__setitem__)},
+            {"__delitem__", new InterpFunctionWrapper(
+                                "__delitem__", M_StdDictObject::__delitem__)},
             {"__contains__",
              new InterpFunctionWrapper("__contains__",
                                        M_StdDictObject::__contains__)},
@@ -96,6 +490,15 @@ mtpython::interpreter::Typedef* M_StdDictObject::_dict_typedef()
              new InterpFunctionWrapper("values", M_StdDictObject::values)},
             {"items",
              new InterpFunctionWrapper("items", M_StdDictObject::items)},
+            {"get", new InterpFunctionWrapper("get", M_StdDictObject::get)},
+            {"pop", new InterpFunctionWrapper("pop", M_StdDictObject::pop)},
+            {"setdefault", new InterpFunctionWrapper(
+                               "setdefault", M_StdDictObject::setdefault)},
+            {"update",
+             new InterpFunctionWrapper("update", M_StdDictObject::update)},
+            {"clear",
+             new InterpFunctionWrapper("clear", M_StdDictObject::clear)},
+            {"copy", new InterpFunctionWrapper("copy", M_StdDictObject::copy)},
         });
 
     return &dict_typedef;
@@ -113,8 +516,8 @@ M_StdDictObject::__contains__(mtpython::vm::ThreadContext* context,
     M_StdDictObject* as_dict = static_cast<M_StdDictObject*>(self);
 
     as_dict->lock();
-    M_BaseObject* result = context->get_space()->new_bool(
-        as_dict->dict.find(obj) != as_dict->dict.end());
+    M_BaseObject* result =
+        context->get_space()->new_bool(as_dict->getitem(obj) != nullptr);
     as_dict->unlock();
 
     return result;
@@ -125,11 +528,12 @@ M_BaseObject* M_StdDictObject::keys(mtpython::vm::ThreadContext* context,
 {
     M_StdDictObject* as_dict = static_cast<M_StdDictObject*>(self);
     std::vector<M_BaseObject*> keys;
+    std::size_t pos = 0;
+    M_BaseObject *key, *value;
 
     as_dict->lock();
-    for (const auto& iter : as_dict->dict) {
-        keys.push_back(iter.first);
-    }
+    while (as_dict->next_entry(pos, key, value))
+        keys.push_back(key);
     as_dict->unlock();
 
     return context->get_space()->new_tuple(context, keys);
@@ -140,11 +544,12 @@ M_BaseObject* M_StdDictObject::values(mtpython::vm::ThreadContext* context,
 {
     M_StdDictObject* as_dict = static_cast<M_StdDictObject*>(self);
     std::vector<M_BaseObject*> values;
+    std::size_t pos = 0;
+    M_BaseObject *key, *value;
 
     as_dict->lock();
-    for (const auto& iter : as_dict->dict) {
-        values.push_back(iter.second);
-    }
+    while (as_dict->next_entry(pos, key, value))
+        values.push_back(value);
     as_dict->unlock();
 
     return context->get_space()->new_tuple(context, values);
@@ -157,14 +562,166 @@ M_BaseObject* M_StdDictObject::items(mtpython::vm::ThreadContext* context,
     std::vector<M_BaseObject*> items;
     ObjSpace* space = context->get_space();
 
+    std::size_t pos = 0;
+    M_BaseObject *key, *value;
+
     as_dict->lock();
-    for (const auto& iter : as_dict->dict) {
-        std::vector<M_BaseObject*> item;
-        item.push_back(iter.first);
-        item.push_back(iter.second);
-        items.push_back(space->new_tuple(context, item));
-    }
+    while (as_dict->next_entry(pos, key, value))
+        items.push_back(space->new_tuple(context, {key, value}));
     as_dict->unlock();
 
     return context->get_space()->new_list(context, items);
 }
+
+M_BaseObject* M_StdDictObject::get(mtpython::vm::ThreadContext* context,
+                                   const Arguments& args)
+{
+    static Signature get_signature({"self", "key", "default"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("get", nullptr, get_signature, scope, {space->wrap_None()});
+    M_StdDictObject* as_dict = static_cast<M_StdDictObject*>(scope[0]);
+
+    as_dict->lock();
+    M_BaseObject* value = as_dict->getitem(scope[1]);
+    as_dict->unlock();
+
+    return value ? value : scope[2];
+}
+
+M_BaseObject* M_StdDictObject::pop(mtpython::vm::ThreadContext* context,
+                                   const Arguments& args)
+{
+    static Signature pop_signature({"self", "key", "default"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("pop", nullptr, pop_signature, scope, {nullptr});
+    M_StdDictObject* as_dict = static_cast<M_StdDictObject*>(scope[0]);
+
+    as_dict->lock();
+    M_BaseObject* value = as_dict->delitem(scope[1]);
+    as_dict->unlock();
+
+    if (value) return value;
+    if (scope[2]) return scope[2];
+    throw InterpError(space->KeyError_type(), scope[1]);
+}
+
+M_BaseObject* M_StdDictObject::setdefault(mtpython::vm::ThreadContext* context,
+                                          const Arguments& args)
+{
+    static Signature setdefault_signature({"self", "key", "default"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("setdefault", nullptr, setdefault_signature, scope,
+               {space->wrap_None()});
+    M_StdDictObject* as_dict = static_cast<M_StdDictObject*>(scope[0]);
+
+    as_dict->lock();
+    M_BaseObject* value = as_dict->getitem(scope[1]);
+    if (!value) {
+        value = scope[2];
+        as_dict->setitem(scope[1], value);
+    }
+    as_dict->unlock();
+
+    return value;
+}
+
+M_BaseObject* M_StdDictObject::update(mtpython::vm::ThreadContext* context,
+                                      const Arguments& args)
+{
+    static Signature update_signature({"self", "other"}, "", "kwargs", {});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("update", nullptr, update_signature, scope, {nullptr});
+    M_StdDictObject* as_dict = static_cast<M_StdDictObject*>(scope[0]);
+
+    if (scope[1]) update_dict(context, as_dict, scope[1]);
+    if (scope[2]) update_dict(context, as_dict, scope[2]);
+
+    return space->wrap_None();
+}
+
+M_BaseObject* M_StdDictObject::clear(mtpython::vm::ThreadContext* context,
+                                     M_BaseObject* self)
+{
+    M_StdDictObject* as_dict = static_cast<M_StdDictObject*>(self);
+
+    as_dict->lock();
+    as_dict->clear_entries();
+    as_dict->unlock();
+
+    return context->get_space()->wrap_None();
+}
+
+M_BaseObject* M_StdDictObject::copy(mtpython::vm::ThreadContext* context,
+                                    M_BaseObject* self)
+{
+    M_StdDictObject* as_dict = static_cast<M_StdDictObject*>(self);
+    M_StdDictObject* copy = new (context) M_StdDictObject(as_dict->space);
+
+    as_dict->lock();
+    if (as_dict->used) {
+        /* resize() compacts the entries into new arrays */
+        copy->entries = as_dict->entries;
+        copy->nentries = as_dict->nentries;
+        copy->used = as_dict->used;
+        copy->resize(as_dict->used);
+    }
+    copy->str_keys = as_dict->str_keys;
+    as_dict->unlock();
+
+    return copy;
+}
+
+mtpython::interpreter::Typedef* M_StdDictIterObject::get_typedef()
+{
+    static Typedef dict_iter_typedef(
+        "dict_keyiterator",
+        {
+            {"__iter__", new InterpFunctionWrapper(
+                             "__iter__", M_StdDictIterObject::__iter__)},
+            {"__next__", new InterpFunctionWrapper(
+                             "__next__", M_StdDictIterObject::__next__)},
+        });
+
+    return &dict_iter_typedef;
+}
+
+M_BaseObject*
+M_StdDictIterObject::__iter__(mtpython::vm::ThreadContext* context,
+                              M_BaseObject* self)
+{
+    return self;
+}
+
+M_BaseObject*
+M_StdDictIterObject::__next__(mtpython::vm::ThreadContext* context,
+                              M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_StdDictIterObject* as_iter = static_cast<M_StdDictIterObject*>(self);
+    M_BaseObject *key, *value;
+
+    as_iter->dict->lock();
+    if (as_iter->dict->size() != as_iter->used) {
+        as_iter->dict->unlock();
+        /* keep failing on later calls even if the size is restored */
+        as_iter->used = (std::size_t)-1;
+        throw InterpError(space->RuntimeError_type(),
+                          space->wrap_str(context, "dictionary changed size "
+                                                   "during iteration"));
+    }
+    bool found = as_iter->dict->next_entry(as_iter->pos, key, value);
+    as_iter->dict->unlock();
+
+    if (!found)
+        throw InterpError(space->StopIteration_type(), space->wrap_None());
+
+    return key;
+}
@@ -0,0 +1,545 @@
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "interpreter/typedef.h"
+#include "interpreter/gateway.h"
+#include "interpreter/error.h"
+#include "objects/std/float_object.h"
+#include "objects/std/int_object.h"
+#include "exceptions.h"
+
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+
+M_StdFloatObject::M_StdFloatObject(double x) { floatval = x; }
+
+M_StdFloatObject::M_StdFloatObject(const std::string& x)
+{
+    floatval = std::strtod(x.c_str(), nullptr);
+}
+
+mtpython::interpreter::Typedef* M_StdFloatObject::_float_typedef()
+{
+    static mtpython::interpreter::Typedef float_typedef(
+        "float",
+        {
+            {"__new__",
+             new InterpFunctionWrapper("__new__", M_StdFloatObject::__new__)},
+            {"__repr__",
+             new InterpFunctionWrapper("__repr__", M_StdFloatObject::__repr__)},
+            {"__str__",
+             new InterpFunctionWrapper("__str__", M_StdFloatObject::__repr__)},
+            {"__bool__",
+             new InterpFunctionWrapper("__bool__", M_StdFloatObject::__bool__)},
+            {"__hash__",
+             new InterpFunctionWrapper("__hash__", M_StdFloatObject::__hash__)},
+            {"__int__",
+             new InterpFunctionWrapper("__int__", M_StdFloatObject::__int__)},
+            {"__float__", new InterpFunctionWrapper(
+                              "__float__", M_StdFloatObject::__float__)},
+            {"__add__",
+             new InterpFunctionWrapper("__add__", M_StdFloatObject::__add__)},
+            {"__radd__",
+             new InterpFunctionWrapper("__radd__", M_StdFloatObject::__add__)},
+            {"__sub__",
+             new InterpFunctionWrapper("__sub__", M_StdFloatObject::__sub__)},
+            {"__rsub__",
+             new InterpFunctionWrapper("__rsub__", M_StdFloatObject::__rsub__)},
+            {"__mul__",
+             new InterpFunctionWrapper("__mul__", M_StdFloatObject::__mul__)},
+            {"__rmul__",
+             new InterpFunctionWrapper("__rmul__", M_StdFloatObject::__mul__)},
+            {"__truediv__", new InterpFunctionWrapper(
+                                "__truediv__", M_StdFloatObject::__truediv__)},
+            {"__rtruediv__",
+             new InterpFunctionWrapper("__rtruediv__",
+                                       M_StdFloatObject::__rtruediv__)},
+            {"__floordiv__",
+             new InterpFunctionWrapper("__floordiv__",
+                                       M_StdFloatObject::__floordiv__)},
+            {"__rfloordiv__",
+             new InterpFunctionWrapper("__rfloordiv__",
+                                       M_StdFloatObject::__rfloordiv__)},
+            {"__mod__",
+             new InterpFunctionWrapper("__mod__", M_StdFloatObject::__mod__)},
+            {"__rmod__",
+             new InterpFunctionWrapper("__rmod__", M_StdFloatObject::__rmod__)},
+            {"__pow__",
+             new InterpFunctionWrapper("__pow__", M_StdFloatObject::__pow__)},
+            {"__rpow__",
+             new InterpFunctionWrapper("__rpow__", M_StdFloatObject::__rpow__)},
+            {"__eq__",
+             new InterpFunctionWrapper("__eq__", M_StdFloatObject::__eq__)},
+            {"__ne__",
+             new InterpFunctionWrapper("__ne__", M_StdFloatObject::__ne__)},
+            {"__lt__",
+             new InterpFunctionWrapper("__lt__", M_StdFloatObject::__lt__)},
+            {"__le__",
+             new InterpFunctionWrapper("__le__", M_StdFloatObject::__le__)},
+            {"__gt__",
+             new InterpFunctionWrapper("__gt__", M_StdFloatObject::__gt__)},
+            {"__ge__",
+             new InterpFunctionWrapper("__ge__", M_StdFloatObject::__ge__)},
+            {"__abs__",
+             new InterpFunctionWrapper("__abs__", M_StdFloatObject::__abs__)},
+            {"__neg__",
+             new InterpFunctionWrapper("__neg__", M_StdFloatObject::__neg__)},
+            {"__pos__",
+             new InterpFunctionWrapper("__pos__", M_StdFloatObject::__pos__)},
+            {"is_integer", new InterpFunctionWrapper(
+                               "is_integer", M_StdFloatObject::is_integer)},
+        });
+
+    return &float_typedef;
+}
+
+mtpython::interpreter::Typedef* M_StdFloatObject::get_typedef()
+{
+    return _float_typedef();
+}
+
+void M_StdFloatObject::dbg_print() { std::cout << format_repr(floatval); }
+
+std::string M_StdFloatObject::format_repr(double x)
+{
+    if (std::isnan(x)) return "nan";
+    if (std::isinf(x)) return x > 0 ? "inf" : "-inf";
+
+    /* std::to_chars without a precision gives the shortest representation
+     * that round-trips. repr() switches to the exponent form outside of
+     * [1e-4, 1e16), like CPython's float_repr_style 'short'. */
+    char buf[64];
+    auto res =
+        std::to_chars(buf, buf + sizeof(buf), x, std::chars_format::scientific);
+    std::string sci(buf, res.ptr);
+
+    std::size_t epos = sci.find('e');
+    int exponent = std::atoi(sci.c_str() + epos + 1);
+    if (exponent < -4 || exponent >= 16) return sci;
+
+    res = std::to_chars(buf, buf + sizeof(buf), x, std::chars_format::fixed);
+    std::string fixed(buf, res.ptr);
+    if (fixed.find('.') == std::string::npos) fixed += ".0";
+
+    return fixed;
+}
+
+std::size_t M_StdFloatObject::hash_double(double x)
+{
+    /* Integral values hash like the equal int so that 1 and 1.0 can be used
+     * interchangeably as dict keys */
+    if (x == std::floor(x) && x >= (double)INT_MIN && x <= (double)INT_MAX)
+        return (std::size_t)(long)x;
+
+    if (std::isinf(x)) return x > 0 ? 314159 : (std::size_t)-314159;
+    if (std::isnan(x)) return 0;
+
+    /* Reduce the mantissa modulo the Mersenne prime 2**61 - 1 (as CPython
+     * does) so the result does not depend on the platform representation */
+    const unsigned long long modulus = (1ULL << 61) - 1;
+    int e;
+    double m = std::frexp(x, &e);
+    int sign = 1;
+    if (m < 0) {
+        sign = -1;
+        m = -m;
+    }
+
+    unsigned long long h = 0;
+    while (m) {
+        h = ((h << 28) & modulus) | h >> (61 - 28);
+        m *= 268435456.0; /* 2**28 */
+        e -= 28;
+        unsigned long long y = (unsigned long long)m;
+        m -= y;
+        h += y;
+        if (h >= modulus) h -= modulus;
+    }
+
+    e = e >= 0 ? e % 61 : 61 - 1 - ((-1 - e) % 61);
+    h = ((h << e) & modulus) | h >> (61 - e);
+
+    return (std::size_t)((long long)h * sign);
+}
+
+/* Fetch a double from a float or an int operand. Returns false for any other
+ * type so that the caller can report NotImplemented. */
+static inline bool unwrap_operand(M_BaseObject* obj, double& value)
+{
+    M_StdFloatObject* as_float = dynamic_cast<M_StdFloatObject*>(obj);
+    if (as_float) {
+        value = as_float->get_value();
+        return true;
+    }
+
+    M_StdIntObject* as_int = dynamic_cast<M_StdIntObject*>(obj);
+    if (as_int) {
+        value = (double)as_int->to_int(nullptr, false);
+        return true;
+    }
+
+    return false;
+}
+
+M_BaseObject* M_StdFloatObject::__new__(mtpython::vm::ThreadContext* context,
+                                        const Arguments& args)
+{
+    static Signature new_signature({"type", "x"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("__new__", nullptr, new_signature, scope, {nullptr});
+    M_BaseObject* value = scope[1];
+
+    if (!value) return space->wrap_float(context, 0.0);
+    if (dynamic_cast<M_StdFloatObject*>(value)) return value;
+
+    double x;
+    if (unwrap_operand(value, x)) return space->wrap_float(context, x);
+
+    if (space->i_isinstance(value, space->get_type_by_name("str"))) {
+        std::string str = space->unwrap_str(value);
+        const char* start = str.c_str();
+        while (std::isspace(*start))
+            start++;
+        char* end;
+        x = std::strtod(start, &end);
+        while (std::isspace(*end))
+            end++;
+
+        if (end == start || *end != '\0' ||
+            !std::strncmp(start, "0x", 2) || !std::strncmp(start, "0X", 2))
+            throw InterpError::format(
+                space, space->ValueError_type(),
+                "could not convert string to float: '%s'", str.c_str());
+
+        return space->wrap_float(context, x);
+    }
+
+    M_BaseObject* descr = space->lookup(value, "__float__");
+    if (!descr)
+        throw InterpError::format(
+            space, space->TypeError_type(),
+            "float() argument must be a string or a number, not '%s'",
+            space->get_type_name(value).c_str());
+
+    return space->get_and_call_function(context, descr, {value});
+}
+
+M_BaseObject* M_StdFloatObject::__repr__(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    return space->wrap_str(context,
+                           format_repr(M_STDFLOATOBJECT(self)->floatval));
+}
+
+M_BaseObject* M_StdFloatObject::__bool__(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    return space->new_bool(M_STDFLOATOBJECT(self)->floatval != 0.0);
+}
+
+M_BaseObject* M_StdFloatObject::__hash__(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    long long h = (long long)hash_double(M_STDFLOATOBJECT(self)->floatval);
+
+    /* ints are only 32 bits wide, fold hashes of large values into the int
+     * range instead of relying on the narrowing conversion */
+    if (h < INT_MIN || h > INT_MAX) h %= INT_MAX;
+
+    return space->wrap_int(context, (int)h);
+}
+
+/* Truncate x towards zero, raising if the result does not fit in an int */
+static int checked_int(ObjSpace* space, double x)
+{
+    mtpython::vm::ThreadContext* context =
+        mtpython::vm::ThreadContext::current_thread();
+
+    if (std::isnan(x))
+        throw InterpError(
+            space->ValueError_type(),
+            space->wrap_str(context, "cannot convert float NaN to integer"));
+    if (std::isinf(x))
+        throw InterpError(
+            space->OverflowError_type(),
+            space->wrap_str(context,
+                            "cannot convert float infinity to integer"));
+
+    double t = std::trunc(x);
+    if (t < (double)INT_MIN || t > (double)INT_MAX)
+        throw InterpError(
+            space->OverflowError_type(),
+            space->wrap_str(context, "float too large to convert to int"));
+
+    return (int)t;
+}
+
+int M_StdFloatObject::to_int(ObjSpace* space, bool allow_conversion)
+{
+    if (!allow_conversion) throw NotImplementedException("to_int()");
+    return checked_int(space, floatval);
+}
+
+M_BaseObject* M_StdFloatObject::__int__(mtpython::vm::ThreadContext* context,
+                                        M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    int x = checked_int(space, M_STDFLOATOBJECT(self)->floatval);
+    return space->wrap_int(context, x);
+}
+
+M_BaseObject* M_StdFloatObject::__float__(mtpython::vm::ThreadContext* context,
+                                          M_BaseObject* self)
+{
+    return self;
+}
+
+M_BaseObject*
+M_StdFloatObject::is_integer(mtpython::vm::ThreadContext* context,
+                             M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    double x = M_STDFLOATOBJECT(self)->floatval;
+
+    return space->new_bool(std::isfinite(x) && x == std::floor(x));
+}
+
+M_BaseObject* M_StdFloatObject::__add__(mtpython::vm::ThreadContext* context,
+                                        M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+
+    double y;
+    if (!unwrap_operand(other, y))
+        return context->get_space()->wrap_NotImplemented();
+
+    return space->wrap_float(context, M_STDFLOATOBJECT(self)->floatval + y);
+}
+
+M_BaseObject* M_StdFloatObject::__sub__(mtpython::vm::ThreadContext* context,
+                                        M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+
+    double y;
+    if (!unwrap_operand(other, y))
+        return context->get_space()->wrap_NotImplemented();
+
+    return space->wrap_float(context, M_STDFLOATOBJECT(self)->floatval - y);
+}
+
+M_BaseObject* M_StdFloatObject::__rsub__(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self,
+                                         M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+
+    double y;
+    if (!unwrap_operand(other, y))
+        return context->get_space()->wrap_NotImplemented();
+
+    return space->wrap_float(context, y - M_STDFLOATOBJECT(self)->floatval);
+}
+
+M_BaseObject* M_StdFloatObject::__mul__(mtpython::vm::ThreadContext* context,
+                                        M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+
+    double y;
+    if (!unwrap_operand(other, y))
+        return context->get_space()->wrap_NotImplemented();
+
+    return space->wrap_float(context, M_STDFLOATOBJECT(self)->floatval * y);
+}
+
+M_BaseObject*
+M_StdFloatObject::__truediv__(mtpython::vm::ThreadContext* context,
+                              M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+
+    double y;
+    if (!unwrap_operand(other, y))
+        return context->get_space()->wrap_NotImplemented();
+    if (y == 0.0)
+        throw InterpError(space->ZeroDivisionError_type(),
+                          space->wrap_str(context, "float division by zero"));
+
+    return space->wrap_float(context, M_STDFLOATOBJECT(self)->floatval / y);
+}
+
+M_BaseObject*
+M_StdFloatObject::__rtruediv__(mtpython::vm::ThreadContext* context,
+                               M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+
+    double y;
+    if (!unwrap_operand(other, y))
+        return context->get_space()->wrap_NotImplemented();
+    double x = M_STDFLOATOBJECT(self)->floatval;
+    if (x == 0.0)
+        throw InterpError(space->ZeroDivisionError_type(),
+                          space->wrap_str(context, "float division by zero"));
+
+    return space->wrap_float(context, y / x);
+}
+
+/* Python semantics: the remainder takes the sign of the divisor */
+static double float_mod(double x, double y)
+{
+    double mod = std::fmod(x, y);
+    if (mod) {
+        if ((y < 0) != (mod < 0)) mod += y;
+    } else {
+        mod = std::copysign(0.0, y);
+    }
+    return mod;
+}
+
+static M_BaseObject* float_floordiv(mtpython::vm::ThreadContext* context,
+                                    double x, double y)
+{
+    ObjSpace* space = context->get_space();
+    if (y == 0.0)
+        throw InterpError(space->ZeroDivisionError_type(),
+                          space->wrap_str(context, "float divmod()"));
+
+    return space->wrap_float(context, std::floor((x - float_mod(x, y)) / y));
+}
+
+static M_BaseObject* float_modulo(mtpython::vm::ThreadContext* context,
+                                  double x, double y)
+{
+    ObjSpace* space = context->get_space();
+    if (y == 0.0)
+        throw InterpError(space->ZeroDivisionError_type(),
+                          space->wrap_str(context, "float modulo"));
+
+    return space->wrap_float(context, float_mod(x, y));
+}
+
+static M_BaseObject* float_pow(mtpython::vm::ThreadContext* context, double x,
+                               double y)
+{
+    ObjSpace* space = context->get_space();
+
+    if (x == 0.0 && y < 0.0)
+        throw InterpError(space->ZeroDivisionError_type(),
+                          space->wrap_str(context, "0.0 cannot be raised to a "
+                                                   "negative power"));
+    if (x < 0.0 && y != std::floor(y) && std::isfinite(y))
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "negative number cannot be "
+                                                   "raised to a fractional "
+                                                   "power"));
+
+    return space->wrap_float(context, std::pow(x, y));
+}
+
+M_BaseObject*
+M_StdFloatObject::__floordiv__(mtpython::vm::ThreadContext* context,
+                               M_BaseObject* self, M_BaseObject* other)
+{
+    double y;
+    if (!unwrap_operand(other, y))
+        return context->get_space()->wrap_NotImplemented();
+    return float_floordiv(context, M_STDFLOATOBJECT(self)->floatval, y);
+}
+
+M_BaseObject*
+M_StdFloatObject::__rfloordiv__(mtpython::vm::ThreadContext* context,
+                                M_BaseObject* self, M_BaseObject* other)
+{
+    double y;
+    if (!unwrap_operand(other, y))
+        return context->get_space()->wrap_NotImplemented();
+    return float_floordiv(context, y, M_STDFLOATOBJECT(self)->floatval);
+}
+
+M_BaseObject* M_StdFloatObject::__mod__(mtpython::vm::ThreadContext* context,
+                                        M_BaseObject* self, M_BaseObject* other)
+{
+    double y;
+    if (!unwrap_operand(other, y))
+        return context->get_space()->wrap_NotImplemented();
+    return float_modulo(context, M_STDFLOATOBJECT(self)->floatval, y);
+}
+
+M_BaseObject* M_StdFloatObject::__rmod__(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self,
+                                         M_BaseObject* other)
+{
+    double y;
+    if (!unwrap_operand(other, y))
+        return context->get_space()->wrap_NotImplemented();
+    return float_modulo(context, y, M_STDFLOATOBJECT(self)->floatval);
+}
+
+M_BaseObject* M_StdFloatObject::__pow__(mtpython::vm::ThreadContext* context,
+                                        M_BaseObject* self, M_BaseObject* other)
+{
+    double y;
+    if (!unwrap_operand(other, y))
+        return context->get_space()->wrap_NotImplemented();
+    return float_pow(context, M_STDFLOATOBJECT(self)->floatval, y);
+}
+
+M_BaseObject* M_StdFloatObject::__rpow__(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self,
+                                         M_BaseObject* other)
+{
+    double y;
+    if (!unwrap_operand(other, y))
+        return context->get_space()->wrap_NotImplemented();
+    return float_pow(context, y, M_STDFLOATOBJECT(self)->floatval);
+}
+
+#define DEF_FLOAT_CMP_OPER(name, op)                                         \
+    M_BaseObject* M_StdFloatObject::name(mtpython::vm::ThreadContext* context, \
+                                         M_BaseObject* self,                 \
+                                         M_BaseObject* other)                \
+    {                                                                        \
+        ObjSpace* space = context->get_space();                              \
+        double y;                                                            \
+        if (!unwrap_operand(other, y)) return space->wrap_NotImplemented();  \
+        return space->new_bool(M_STDFLOATOBJECT(self)->floatval op y);       \
+    }
+
+DEF_FLOAT_CMP_OPER(__eq__, ==)
+DEF_FLOAT_CMP_OPER(__ne__, !=)
+DEF_FLOAT_CMP_OPER(__lt__, <)
+DEF_FLOAT_CMP_OPER(__le__, <=)
+DEF_FLOAT_CMP_OPER(__gt__, >)
+DEF_FLOAT_CMP_OPER(__ge__, >=)
+
+M_BaseObject* M_StdFloatObject::__abs__(mtpython::vm::ThreadContext* context,
+                                        M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    return space->wrap_float(context,
+                             std::fabs(M_STDFLOATOBJECT(self)->floatval));
+}
+
+M_BaseObject* M_StdFloatObject::__neg__(mtpython::vm::ThreadContext* context,
+                                        M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    return space->wrap_float(context, -M_STDFLOATOBJECT(self)->floatval);
+}
+
+M_BaseObject* M_StdFloatObject::__pos__(mtpython::vm::ThreadContext* context,
+                                        M_BaseObject* self)
+{
+    return self;
+}
@@ -1,10 +1,15 @@
+#include <cctype>
+#include <cstdint>
 #include <string>
+#include <vector>
 #include <iostream>
 #include <unordered_map>
 #include "interpreter/typedef.h"
 #include "interpreter/gateway.h"
 #include "interpreter/error.h"
 #include "objects/std/int_object.h"
+#include "objects/std/float_object.h"
+#include "objects/buffer.h"
 #include "exceptions.h"
 
 using namespace mtpython::objects;
@@ -41,8 +46,26 @@ mtpython::interpreter::Typedef* M_StdIntObject::_int_typedef()
              new InterpFunctionWrapper("__sub__", M_StdIntObject::__sub__)},
             {"__mul__",
              new InterpFunctionWrapper("__mul__", M_StdIntObject::__mul__)},
+            {"__hash__",
+             new InterpFunctionWrapper("__hash__", M_StdIntObject::__hash__)},
+            {"__float__",
+             new InterpFunctionWrapper("__float__", M_StdIntObject::__float__)},
+            {"__truediv__", new InterpFunctionWrapper(
+                                "__truediv__", M_StdIntObject::__truediv__)},
+            {"__floordiv__", new InterpFunctionWrapper(
+                                 "__floordiv__", M_StdIntObject::__floordiv__)},
+            {"__mod__",
+             new InterpFunctionWrapper("__mod__", M_StdIntObject::__mod__)},
             {"__and__",
              new InterpFunctionWrapper("__and__", M_StdIntObject::__and__)},
+            {"__or__",
+             new InterpFunctionWrapper("__or__", M_StdIntObject::__or__)},
+            {"__xor__",
+             new InterpFunctionWrapper("__xor__", M_StdIntObject::__xor__)},
+            {"__lshift__", new InterpFunctionWrapper(
+                               "__lshift__", M_StdIntObject::__lshift__)},
+            {"__rshift__", new InterpFunctionWrapper(
+                               "__rshift__", M_StdIntObject::__rshift__)},
             {"__eq__",
              new InterpFunctionWrapper("__eq__", M_StdIntObject::__eq__)},
             {"__ne__",
@@ -59,6 +82,8 @@ mtpython::interpreter::Typedef* M_StdIntObject::_int_typedef()
              new InterpFunctionWrapper("__abs__", M_StdIntObject::__abs__)},
             {"__neg__",
              new InterpFunctionWrapper("__neg__", M_StdIntObject::__neg__)},
+            {"__invert__", new InterpFunctionWrapper(
+                               "__invert__", M_StdIntObject::__invert__)},
         });
 
     return &int_typedef;
@@ -71,14 +96,105 @@ mtpython::interpreter::Typedef* M_StdIntObject::get_typedef()
 
 void M_StdIntObject::dbg_print() { std::cout << intval; }
 
+/* Parse an integer literal the way int(str, base) does: surrounding
+ * whitespace, an optional sign and a 0x/0o/0b prefix matching the base are
+ * allowed, base 0 takes the base from the prefix. Values wrap to 32 bits. */
+static bool parse_int_literal(const std::string& str, int base, int& result)
+{
+    std::size_t pos = 0, end = str.size();
+    while (pos < end && std::isspace((unsigned char)str[pos]))
+        pos++;
+    while (end > pos && std::isspace((unsigned char)str[end - 1]))
+        end--;
+
+    bool negative = false;
+    if (pos < end && (str[pos] == '+' || str[pos] == '-'))
+        negative = str[pos++] == '-';
+
+    if (end - pos >= 2 && str[pos] == '0') {
+        char prefix = std::tolower((unsigned char)str[pos + 1]);
+        int prefix_base =
+            prefix == 'x' ? 16 : prefix == 'o' ? 8 : prefix == 'b' ? 2 : 0;
+        if (prefix_base && (base == 0 || base == prefix_base)) {
+            base = prefix_base;
+            pos += 2;
+        }
+    }
+    if (base == 0) base = 10;
+    if (pos == end) return false;
+
+    std::uint32_t value = 0;
+    for (; pos < end; pos++) {
+        int c = std::tolower((unsigned char)str[pos]);
+        int digit = std::isdigit(c) ? c - '0' : std::isalpha(c) ? c - 'a' + 10
+                                                                : base;
+        if (digit >= base) return false;
+        value = value * base + digit;
+    }
+
+    result = (int)(negative ? 0u - value : value);
+    return true;
+}
+
 M_BaseObject* M_StdIntObject::__new__(mtpython::vm::ThreadContext* context,
-                                      mtpython::objects::M_BaseObject* int_type,
-                                      mtpython::objects::M_BaseObject* value)
+                                      const Arguments& args)
 {
+    static Signature new_signature({"type", "x", "base"});
     ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("__new__", nullptr, new_signature, scope, {nullptr, nullptr});
+    M_BaseObject* value = scope[1];
+    M_BaseObject* wbase = scope[2];
+
     int ivalue = 0;
-    if (space->i_isinstance(value, space->get_type_by_name("int"))) {
+    if (!value) {
+        if (wbase)
+            throw InterpError(space->TypeError_type(),
+                              space->wrap_str(context, "int() missing string "
+                                                       "argument"));
+        return space->wrap_int(context, 0);
+    }
+
+    bool is_str = space->i_isinstance(value, space->get_type_by_name("str"));
+    bool is_bytes =
+        space->i_isinstance(value, space->get_type_by_name("bytes")) ||
+        space->i_isinstance(value, space->get_type_by_name("bytearray"));
+
+    if (is_str || is_bytes) {
+        int base = 10;
+        if (wbase) {
+            base = space->i_get_index(wbase, space->TypeError_type(), nullptr);
+            if (base == 1 || base < 0 || base > 36)
+                throw InterpError(
+                    space->ValueError_type(),
+                    space->wrap_str(context,
+                                    "int() base must be >= 2 and <= 36"));
+        }
+
+        std::string str;
+        if (is_str) {
+            str = space->unwrap_str(value);
+        } else {
+            Buffer view;
+            value->get_buffer(space, view);
+            str.assign((const char*)view.buf, view.len);
+        }
+
+        if (!parse_int_literal(str, base, ivalue))
+            throw InterpError::format(
+                space, space->ValueError_type(),
+                "invalid literal for int() with base %d: '%s'", base,
+                str.c_str());
+    } else if (wbase) {
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "int() can't convert "
+                                                   "non-string with explicit "
+                                                   "base"));
+    } else if (space->i_isinstance(value, space->get_type_by_name("int"))) {
         ivalue = space->unwrap_int(value);
+    } else if (space->i_isinstance(value, space->get_type_by_name("float"))) {
+        return M_StdFloatObject::__int__(context, value);
     }
 
     return space->wrap_int(context, ivalue);
@@ -112,6 +228,19 @@ M_BaseObject* M_StdIntObject::__bool__(mtpython::vm::ThreadContext* context,
     return space->new_bool(as_int->intval != 0);
 }
 
+M_BaseObject* M_StdIntObject::__hash__(mtpython::vm::ThreadContext* context,
+                                       M_BaseObject* self)
+{
+    return self;
+}
+
+M_BaseObject* M_StdIntObject::__float__(mtpython::vm::ThreadContext* context,
+                                        M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    return space->wrap_float(context, (double)M_STDINTOBJECT(self)->intval);
+}
+
 M_BaseObject* M_StdIntObject::__add__(mtpython::vm::ThreadContext* context,
                                       M_BaseObject* self, M_BaseObject* other)
 {
@@ -119,7 +248,11 @@ M_BaseObject* M_StdIntObject::__add__(mtpython::vm::ThreadContext* context,
 
     M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
     M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
-    if (!other_as_int) return nullptr;
+    if (!other_as_int) {
+        if (dynamic_cast<M_StdFloatObject*>(other))
+            return M_StdFloatObject::__add__(context, other, self);
+        return space->wrap_NotImplemented();
+    }
 
     int x = self_as_int->intval;
     int y = other_as_int->intval;
@@ -136,7 +269,11 @@ M_BaseObject* M_StdIntObject::__sub__(mtpython::vm::ThreadContext* context,
 
     M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
     M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
-    if (!other_as_int) return nullptr;
+    if (!other_as_int) {
+        if (dynamic_cast<M_StdFloatObject*>(other))
+            return M_StdFloatObject::__rsub__(context, other, self);
+        return space->wrap_NotImplemented();
+    }
 
     int x = self_as_int->intval;
     int y = other_as_int->intval;
@@ -153,7 +290,11 @@ M_BaseObject* M_StdIntObject::__mul__(mtpython::vm::ThreadContext* context,
 
     M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
     M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
-    if (!other_as_int) return nullptr;
+    if (!other_as_int) {
+        if (dynamic_cast<M_StdFloatObject*>(other))
+            return M_StdFloatObject::__mul__(context, other, self);
+        return space->wrap_NotImplemented();
+    }
 
     int x = self_as_int->intval;
     int y = other_as_int->intval;
@@ -163,6 +304,94 @@ M_BaseObject* M_StdIntObject::__mul__(mtpython::vm::ThreadContext* context,
     return space->wrap_int(context, z);
 }
 
+M_BaseObject* M_StdIntObject::__truediv__(mtpython::vm::ThreadContext* context,
+                                          M_BaseObject* self,
+                                          M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+
+    M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
+    M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
+    if (!other_as_int) {
+        if (dynamic_cast<M_StdFloatObject*>(other))
+            return M_StdFloatObject::__rtruediv__(context, other, self);
+        return space->wrap_NotImplemented();
+    }
+
+    int x = self_as_int->intval;
+    int y = other_as_int->intval;
+    if (y == 0)
+        throw InterpError(space->ZeroDivisionError_type(),
+                          space->wrap_str(context, "division by zero"));
+
+    return space->wrap_float(context, (double)x / (double)y);
+}
+
+M_BaseObject*
+M_StdIntObject::__floordiv__(mtpython::vm::ThreadContext* context,
+                             M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+
+    M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
+    M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
+    if (!other_as_int) {
+        if (dynamic_cast<M_StdFloatObject*>(other))
+            return M_StdFloatObject::__floordiv__(
+                context, space->wrap_float(context, self_as_int->intval),
+                other);
+        return space->wrap_NotImplemented();
+    }
+
+    int x = self_as_int->intval;
+    int y = other_as_int->intval;
+    if (y == 0)
+        throw InterpError(
+            space->ZeroDivisionError_type(),
+            space->wrap_str(context, "integer division or modulo by zero"));
+
+    /* INT_MIN / -1 traps, the result wraps around like multiplication */
+    if (y == -1) return space->wrap_int(context, (int)(0u - (unsigned)x));
+
+    /* round towards negative infinity */
+    int z = x / y;
+    if ((x % y != 0) && ((x < 0) != (y < 0))) z--;
+
+    return space->wrap_int(context, z);
+}
+
+M_BaseObject* M_StdIntObject::__mod__(mtpython::vm::ThreadContext* context,
+                                      M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+
+    M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
+    M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
+    if (!other_as_int) {
+        if (dynamic_cast<M_StdFloatObject*>(other))
+            return M_StdFloatObject::__mod__(
+                context, space->wrap_float(context, self_as_int->intval),
+                other);
+        return space->wrap_NotImplemented();
+    }
+
+    int x = self_as_int->intval;
+    int y = other_as_int->intval;
+    if (y == 0)
+        throw InterpError(
+            space->ZeroDivisionError_type(),
+            space->wrap_str(context, "integer division or modulo by zero"));
+
+    /* INT_MIN % -1 traps as well */
+    if (y == -1) return space->wrap_int(context, 0);
+
+    /* the result has the sign of the divisor */
+    int z = x % y;
+    if (z != 0 && ((z < 0) != (y < 0))) z += y;
+
+    return space->wrap_int(context, z);
+}
+
 M_BaseObject* M_StdIntObject::__and__(mtpython::vm::ThreadContext* context,
                                       M_BaseObject* self, M_BaseObject* other)
 {
@@ -170,7 +399,7 @@ M_BaseObject* M_StdIntObject::__and__(mtpython::vm::ThreadContext* context,
 
     M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
     M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
-    if (!other_as_int) return nullptr;
+    if (!other_as_int) return space->wrap_NotImplemented();
 
     int x = self_as_int->intval;
     int y = other_as_int->intval;
@@ -180,6 +409,73 @@ M_BaseObject* M_StdIntObject::__and__(mtpython::vm::ThreadContext* context,
     return space->wrap_int(context, z);
 }
 
+M_BaseObject* M_StdIntObject::__or__(mtpython::vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+
+    M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
+    M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
+    if (!other_as_int) return space->wrap_NotImplemented();
+
+    return space->wrap_int(context, self_as_int->intval | other_as_int->intval);
+}
+
+M_BaseObject* M_StdIntObject::__xor__(mtpython::vm::ThreadContext* context,
+                                      M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+
+    M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
+    M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
+    if (!other_as_int) return space->wrap_NotImplemented();
+
+    return space->wrap_int(context, self_as_int->intval ^ other_as_int->intval);
+}
+
+static int shift_count(mtpython::vm::ThreadContext* context, int count)
+{
+    ObjSpace* space = context->get_space();
+
+    if (count < 0)
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "negative shift count"));
+    return count;
+}
+
+M_BaseObject* M_StdIntObject::__lshift__(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self,
+                                         M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+
+    M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
+    M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
+    if (!other_as_int) return space->wrap_NotImplemented();
+
+    /* bits shifted out of the 32-bit value are lost */
+    int n = shift_count(context, other_as_int->intval);
+    std::uint32_t x = (std::uint32_t)self_as_int->intval;
+
+    return space->wrap_int(context, n >= 32 ? 0 : (int)(x << n));
+}
+
+M_BaseObject* M_StdIntObject::__rshift__(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self,
+                                         M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+
+    M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
+    M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
+    if (!other_as_int) return space->wrap_NotImplemented();
+
+    int n = shift_count(context, other_as_int->intval);
+    int x = self_as_int->intval;
+
+    return space->wrap_int(context, n >= 32 ? (x < 0 ? -1 : 0) : x >> n);
+}
+
 M_BaseObject* M_StdIntObject::__eq__(mtpython::vm::ThreadContext* context,
                                      mtpython::objects::M_BaseObject* self,
                                      mtpython::objects::M_BaseObject* other)
@@ -188,7 +484,11 @@ M_BaseObject* M_StdIntObject::__eq__(mtpython::vm::ThreadContext* context,
 
     M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
     M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
-    if (!other_as_int) return nullptr;
+    if (!other_as_int) {
+        if (dynamic_cast<M_StdFloatObject*>(other))
+            return M_StdFloatObject::__eq__(context, other, self);
+        return space->wrap_NotImplemented();
+    }
 
     int x = self_as_int->intval;
     int y = other_as_int->intval;
@@ -204,7 +504,11 @@ M_BaseObject* M_StdIntObject::__ne__(mtpython::vm::ThreadContext* context,
 
     M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
     M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
-    if (!other_as_int) return nullptr;
+    if (!other_as_int) {
+        if (dynamic_cast<M_StdFloatObject*>(other))
+            return M_StdFloatObject::__ne__(context, other, self);
+        return space->wrap_NotImplemented();
+    }
 
     int x = self_as_int->intval;
     int y = other_as_int->intval;
@@ -220,7 +524,11 @@ M_BaseObject* M_StdIntObject::__lt__(mtpython::vm::ThreadContext* context,
 
     M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
     M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
-    if (!other_as_int) return nullptr;
+    if (!other_as_int) {
+        if (dynamic_cast<M_StdFloatObject*>(other))
+            return M_StdFloatObject::__gt__(context, other, self);
+        return space->wrap_NotImplemented();
+    }
 
     int x = self_as_int->intval;
     int y = other_as_int->intval;
@@ -236,7 +544,11 @@ M_BaseObject* M_StdIntObject::__le__(mtpython::vm::ThreadContext* context,
 
     M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
     M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
-    if (!other_as_int) return nullptr;
+    if (!other_as_int) {
+        if (dynamic_cast<M_StdFloatObject*>(other))
+            return M_StdFloatObject::__ge__(context, other, self);
+        return space->wrap_NotImplemented();
+    }
 
     int x = self_as_int->intval;
     int y = other_as_int->intval;
@@ -252,7 +564,11 @@ M_BaseObject* M_StdIntObject::__gt__(mtpython::vm::ThreadContext* context,
 
     M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
     M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
-    if (!other_as_int) return nullptr;
+    if (!other_as_int) {
+        if (dynamic_cast<M_StdFloatObject*>(other))
+            return M_StdFloatObject::__lt__(context, other, self);
+        return space->wrap_NotImplemented();
+    }
 
     int x = self_as_int->intval;
     int y = other_as_int->intval;
@@ -268,7 +584,11 @@ M_BaseObject* M_StdIntObject::__ge__(mtpython::vm::ThreadContext* context,
 
     M_StdIntObject* self_as_int = static_cast<M_StdIntObject*>(self);
     M_StdIntObject* other_as_int = dynamic_cast<M_StdIntObject*>(other);
-    if (!other_as_int) return nullptr;
+    if (!other_as_int) {
+        if (dynamic_cast<M_StdFloatObject*>(other))
+            return M_StdFloatObject::__le__(context, other, self);
+        return space->wrap_NotImplemented();
+    }
 
     int x = self_as_int->intval;
     int y = other_as_int->intval;
@@ -296,3 +616,12 @@ M_BaseObject* M_StdIntObject::__neg__(mtpython::vm::ThreadContext* context,
 
     return space->wrap_int(context, -(as_int->intval));
 }
+
+M_BaseObject* M_StdIntObject::__invert__(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_StdIntObject* as_int = M_STDINTOBJECT(self);
+
+    return space->wrap_int(context, ~(as_int->intval));
+}
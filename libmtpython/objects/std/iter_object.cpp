@@ -6,27 +6,50 @@ using namespace mtpython::objects;
 using namespace mtpython::interpreter;
 using namespace mtpython::vm;
 
-M_BaseObject* M_StdSeqIterObject::__next__(ThreadContext* context,
-                                           M_BaseObject* self)
+M_BaseObject* M_StdNativeIterObject::__iter__(ThreadContext* context,
+                                              M_BaseObject* self)
+{
+    return self;
+}
+
+M_BaseObject* M_StdNativeIterObject::__next__(ThreadContext* context,
+                                              M_BaseObject* self)
 {
     ObjSpace* space = context->get_space();
+    M_BaseObject* item =
+        static_cast<M_StdNativeIterObject*>(self)->next_item(context);
 
-    M_StdSeqIterObject* iter = static_cast<M_StdSeqIterObject*>(self);
-    iter->lock();
-    if (!iter->obj) {
+    if (!item) {
         throw InterpError(space->StopIteration_type(), space->wrap_None());
     }
 
+    return item;
+}
+
+M_BaseObject* M_StdSeqIterObject::next_item(ThreadContext* context)
+{
+    ObjSpace* space = context->get_space();
+
+    lock();
+    M_BaseObject* seq = obj;
+    int i = index;
+    unlock();
+    if (!seq) return nullptr;
+
     M_BaseObject* item;
     try {
-        item = space->getitem(iter->obj, space->wrap_int(context, iter->index));
+        item = space->getitem(seq, space->wrap_int(context, i));
     } catch (InterpError& exc) {
-        iter->obj = nullptr;
         if (!exc.match(space, space->IndexError_type())) throw exc;
-        throw InterpError(space->StopIteration_type(), space->wrap_None());
+        lock();
+        obj = nullptr;
+        unlock();
+        return nullptr;
     }
-    iter->index++;
-    iter->unlock();
+
+    lock();
+    index++;
+    unlock();
 
     return item;
 }
@@ -36,8 +59,10 @@ Typedef* M_StdSeqIterObject::get_typedef()
     static Typedef seq_iter_typedef(
         "seq_iterator",
         {
+            {"__iter__", new InterpFunctionWrapper(
+                             "__iter__", M_StdNativeIterObject::__iter__)},
             {"__next__", new InterpFunctionWrapper(
-                             "__next__", M_StdSeqIterObject::__next__)},
+                             "__next__", M_StdNativeIterObject::__next__)},
         });
     return &seq_iter_typedef;
 }
@@ -47,29 +72,19 @@ mtpython::interpreter::Typedef* M_StdTupleIterObject::get_typedef()
     static Typedef tuple_iter_typedef(
         "tuple_iterator",
         {
+            {"__iter__", new InterpFunctionWrapper(
+                             "__iter__", M_StdNativeIterObject::__iter__)},
             {"__next__", new InterpFunctionWrapper(
-                             "__next__", M_StdTupleIterObject::__next__)},
+                             "__next__", M_StdNativeIterObject::__next__)},
         });
 
     return &tuple_iter_typedef;
 }
 
-M_BaseObject* M_StdTupleIterObject::__next__(ThreadContext* context,
-                                             M_BaseObject* self)
+M_BaseObject* M_StdTupleIterObject::next_item(ThreadContext* context)
 {
-    ObjSpace* space = context->get_space();
-    M_StdTupleIterObject* as_iter = dynamic_cast<M_StdTupleIterObject*>(self);
-    if (!as_iter)
-        throw InterpError(
-            space->TypeError_type(),
-            space->wrap_str(context, "object is not tuple iterator"));
+    ScopedObjectLock lock(this);
 
-    if (as_iter->index == as_iter->items.size()) {
-        throw InterpError(space->StopIteration_type(), space->wrap_None());
-    }
-
-    M_BaseObject* item = as_iter->items[as_iter->index];
-    as_iter->index++;
-
-    return item;
+    if (index == tuple->size()) return nullptr;
+    return (*tuple)[index++];
 }
@@ -1,20 +1,116 @@
 #include <string>
 #include <unordered_map>
+#include <algorithm>
+#include <typeinfo>
+#include <limits>
 #include <assert.h>
 
+#include "exceptions.h"
 #include "interpreter/typedef.h"
 #include "interpreter/error.h"
 #include "interpreter/gateway.h"
 #include "objects/std/list_object.h"
+#include "objects/std/int_object.h"
+#include "objects/std/bool_object.h"
+#include "objects/std/float_object.h"
+#include "objects/std/unicode_object.h"
+#include "objects/std/slice_object.h"
+#include "utils/timsort.h"
 
 using namespace mtpython::objects;
 using namespace mtpython::interpreter;
 
+M_StdListObject::M_StdListObject(mtpython::vm::ThreadContext* context,
+                                 const std::vector<M_BaseObject*>& items)
+    : items(nullptr), length(0)
+{
+    if (items.empty()) return;
+
+    reserve(context, items.size());
+    std::copy(items.begin(), items.end(), begin());
+    length = items.size();
+}
+
+void M_StdListObject::reserve(mtpython::vm::ThreadContext* context,
+                              std::size_t capacity)
+{
+    if (items && items->size() >= capacity) return;
+
+    M_GCArray<M_BaseObject*>* new_items =
+        M_GCArray<M_BaseObject*>::create(context, capacity);
+    std::copy(begin(), end(), new_items->begin());
+    items = new_items;
+}
+
+void M_StdListObject::grow(mtpython::vm::ThreadContext* context,
+                           std::size_t size)
+{
+    if (items && items->size() >= size) return;
+
+    /* over-allocate proportionally to the list size */
+    reserve(context, size + (size >> 3) + (size < 9 ? 3 : 6));
+}
+
+void M_StdListObject::push_back(mtpython::vm::ThreadContext* context,
+                                M_BaseObject* item)
+{
+    grow(context, length + 1);
+    (*items)[length++] = item;
+}
+
+void M_StdListObject::replace_range(mtpython::vm::ThreadContext* context,
+                                    std::size_t lo, std::size_t hi,
+                                    M_BaseObject* const* first, std::size_t n)
+{
+    std::size_t removed = hi - lo;
+
+    if (n > removed) {
+        std::size_t delta = n - removed;
+        grow(context, length + delta);
+        std::copy_backward(begin() + hi, end(), end() + delta);
+    } else if (n < removed) {
+        std::size_t delta = removed - n;
+        std::copy(begin() + hi, end(), begin() + hi - delta);
+        std::fill(end() - delta, end(), nullptr);
+    }
+
+    length = length + n - removed;
+    std::copy(first, first + n, begin() + lo);
+}
+
+M_StdListObject* M_StdListObject::create(mtpython::vm::ThreadContext* context,
+                                         std::size_t size)
+{
+    M_StdListObject* list = new (context) M_StdListObject();
+
+    if (size > 0) {
+        list->reserve(context, size);
+        list->length = size;
+    }
+
+    return list;
+}
+
+M_BaseObject* M_StdListObject::erase(std::size_t pos)
+{
+    M_BaseObject* item = (*items)[pos];
+
+    std::copy(begin() + pos + 1, end(), begin() + pos);
+    /* unused slots must not keep objects alive */
+    (*items)[--length] = nullptr;
+
+    return item;
+}
+
 mtpython::interpreter::Typedef* M_StdListObject::_list_typedef()
 {
     static mtpython::interpreter::Typedef list_typedef(
         "list",
         {
+            {"__new__",
+             new InterpFunctionWrapper("__new__", M_StdListObject::__new__)},
+            {"__init__",
+             new InterpFunctionWrapper("__init__", M_StdListObject::__init__)},
             {"__repr__",
              new InterpFunctionWrapper("__repr__", M_StdListObject::__repr__)},
             {"__len__",
@@ -26,15 +122,43 @@ mtpython::interpreter::Typedef* M_StdListObject::_list_typedef()
              new InterpFunctionWrapper("__iter__", M_StdListObject::__iter__)},
             {"__getitem__", new InterpFunctionWrapper(
                                 "__getitem__", M_StdListObject::__getitem__)},
-
+            {"__setitem__", new InterpFunctionWrapper(
+                                "__setitem__", M_StdListObject::__setitem__)},
+            {"__delitem__", new InterpFunctionWrapper(
+                                "__delitem__", M_StdListObject::__delitem__)},
+
+            {"__eq__",
+             new InterpFunctionWrapper("__eq__", M_StdListObject::__eq__)},
+            {"__ne__",
+             new InterpFunctionWrapper("__ne__", M_StdListObject::__ne__)},
+
+            {"__add__",
+             new InterpFunctionWrapper("__add__", M_StdListObject::__add__)},
+            {"__mul__",
+             new InterpFunctionWrapper("__mul__", M_StdListObject::__mul__)},
+            {"__rmul__",
+             new InterpFunctionWrapper("__rmul__", M_StdListObject::__mul__)},
             {"__iadd__",
              new InterpFunctionWrapper("__iadd__", M_StdListObject::__iadd__)},
+            {"__imul__",
+             new InterpFunctionWrapper("__imul__", M_StdListObject::__imul__)},
 
             {"append",
              new InterpFunctionWrapper("append", M_StdListObject::append)},
             {"extend",
              new InterpFunctionWrapper("extend", M_StdListObject::extend)},
+            {"insert",
+             new InterpFunctionWrapper("insert", M_StdListObject::insert)},
             {"pop", new InterpFunctionWrapper("pop", M_StdListObject::pop)},
+            {"index",
+             new InterpFunctionWrapper("index", M_StdListObject::index)},
+            {"count",
+             new InterpFunctionWrapper("count", M_StdListObject::count)},
+            {"remove",
+             new InterpFunctionWrapper("remove", M_StdListObject::remove)},
+            {"reverse",
+             new InterpFunctionWrapper("reverse", M_StdListObject::reverse)},
+            {"sort", new InterpFunctionWrapper("sort", M_StdListObject::sort)},
         });
 
     return &list_typedef;
@@ -52,7 +176,32 @@ M_BaseObject* M_StdListObject::__len__(mtpython::vm::ThreadContext* context,
     M_StdListObject* as_list = M_STDLISTOBJECT(self);
     assert(as_list);
 
-    return space->wrap_int(context, as_list->items.size());
+    return space->wrap_int(context, (int)as_list->length);
+}
+
+M_BaseObject* M_StdListObject::__new__(mtpython::vm::ThreadContext* context,
+                                       const Arguments& args)
+{
+    return new (context) M_StdListObject();
+}
+
+M_BaseObject* M_StdListObject::__init__(mtpython::vm::ThreadContext* context,
+                                        const Arguments& args)
+{
+    static Signature init_signature({"self", "iterable"});
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("list", nullptr, init_signature, scope, {nullptr});
+
+    M_StdListObject* as_list = M_STDLISTOBJECT(scope[0]);
+    {
+        ScopedObjectLock lock(as_list);
+        as_list->items = nullptr;
+        as_list->length = 0;
+    }
+    if (scope[1]) extend(context, as_list, scope[1]);
+
+    return nullptr;
 }
 
 M_BaseObject* M_StdListObject::__repr__(mtpython::vm::ThreadContext* context,
@@ -63,9 +212,9 @@ M_BaseObject* M_StdListObject::__repr__(mtpython::vm::ThreadContext* context,
     assert(as_list);
 
     std::string str = "[";
-    for (std::size_t i = 0; i < as_list->items.size(); i++) {
+    for (std::size_t i = 0; i < as_list->length; i++) {
         if (i > 0) str += ", ";
-        M_BaseObject* repr_item = space->repr(as_list->items[i]);
+        M_BaseObject* repr_item = space->repr((*as_list)[i]);
         str += space->unwrap_str(repr_item);
     }
     str += "]";
@@ -79,8 +228,8 @@ M_StdListObject::__contains__(mtpython::vm::ThreadContext* context,
 {
     ObjSpace* space = context->get_space();
     M_StdListObject* as_list = static_cast<M_StdListObject*>(self);
-    for (auto item : as_list->items) {
-        if (space->i_eq(item, obj)) {
+    for (std::size_t i = 0; i < as_list->length; i++) {
+        if (space->i_eq((*as_list)[i], obj)) {
             return space->wrap_True();
         }
     }
@@ -100,7 +249,7 @@ M_BaseObject* M_StdListObject::append(mtpython::vm::ThreadContext* context,
     M_StdListObject* as_list = M_STDLISTOBJECT(self);
 
     as_list->lock();
-    as_list->items.push_back(item);
+    as_list->push_back(context, item);
     as_list->unlock();
 
     return nullptr;
@@ -111,13 +260,31 @@ M_BaseObject* M_StdListObject::extend(mtpython::vm::ThreadContext* context,
                                       M_BaseObject* iterable)
 {
     ObjSpace* space = context->get_space();
-    M_BaseObject* iter = space->iter(iterable);
     M_StdListObject* as_list = M_STDLISTOBJECT(self);
 
+    M_StdListObject* other_list = dynamic_cast<M_StdListObject*>(iterable);
+    if (other_list) {
+        ScopedObjectLock lock(self);
+
+        if (other_list == as_list) {
+            /* copy first, growing the list replaces its item array */
+            std::vector<M_BaseObject*> seq(as_list->begin(), as_list->end());
+            as_list->replace_range(context, as_list->length, as_list->length,
+                                   seq.data(), seq.size());
+        } else {
+            as_list->replace_range(context, as_list->length, as_list->length,
+                                   other_list->begin(), other_list->length);
+        }
+
+        return nullptr;
+    }
+
+    M_BaseObject* iter = space->iter(iterable);
+
     as_list->lock();
     while (true) {
         try {
-            as_list->items.push_back(space->next(iter));
+            as_list->push_back(context, space->next(iter));
         } catch (InterpError& e) {
             if (!e.match(space, space->StopIteration_type())) throw e;
             break;
@@ -128,6 +295,26 @@ M_BaseObject* M_StdListObject::extend(mtpython::vm::ThreadContext* context,
     return nullptr;
 }
 
+/* Normalize an integer index into the list, raising IndexError with msg if
+ * it is out of range */
+static std::size_t list_index(mtpython::vm::ThreadContext* context,
+                              M_StdListObject* list, M_BaseObject* index,
+                              const char* msg)
+{
+    ObjSpace* space = context->get_space();
+
+    int i = space->i_get_index(index, space->IndexError_type(),
+                               space->wrap_str(context, "list index"));
+    int size = (int)list->size();
+
+    if (i < 0) i += size;
+    if (i < 0 || i >= size)
+        throw InterpError(space->IndexError_type(),
+                          space->wrap_str(context, msg));
+
+    return (std::size_t)i;
+}
+
 M_BaseObject* M_StdListObject::__getitem__(mtpython::vm::ThreadContext* context,
                                            M_BaseObject* self,
                                            M_BaseObject* index)
@@ -137,24 +324,122 @@ M_BaseObject* M_StdListObject::__getitem__(mtpython::vm::ThreadContext* context,
 
     M_StdListObject* as_list = static_cast<M_StdListObject*>(self);
 
-    int i = space->i_get_index(index, space->IndexError_type(),
-                               space->wrap_str(context, "list index"));
-    M_BaseObject* item = nullptr;
-    if (i < 0) {
-        if (i < -(int)(as_list->items.size()))
-            throw InterpError(
-                space->IndexError_type(),
-                space->wrap_str(context, "list index out of range"));
-        item = as_list->items[as_list->items.size() + i];
-    } else {
-        if (i >= (int)as_list->items.size())
-            throw InterpError(
-                space->IndexError_type(),
-                space->wrap_str(context, "list index out of range"));
-        item = as_list->items[i];
+    M_StdSliceObject* slice = dynamic_cast<M_StdSliceObject*>(index);
+    if (slice) {
+        long start, stop, step;
+        std::size_t n =
+            slice->unpack_indices(space, as_list->length, start, stop, step);
+
+        M_StdListObject* result = create(context, n);
+        if (step == 1) {
+            std::copy(as_list->begin() + start, as_list->begin() + start + n,
+                      result->begin());
+        } else {
+            for (std::size_t i = 0; i < n; i++, start += step)
+                (*result)[i] = (*as_list)[start];
+        }
+
+        return result;
     }
 
-    return item;
+    return (*as_list)[list_index(context, as_list, index,
+                                 "list index out of range")];
+}
+
+M_BaseObject* M_StdListObject::__setitem__(mtpython::vm::ThreadContext* context,
+                                           M_BaseObject* self,
+                                           M_BaseObject* index,
+                                           M_BaseObject* value)
+{
+    ObjSpace* space = context->get_space();
+    ScopedObjectLock lock(self);
+
+    M_StdListObject* as_list = static_cast<M_StdListObject*>(self);
+
+    M_StdSliceObject* slice = dynamic_cast<M_StdSliceObject*>(index);
+    if (!slice) {
+        (*as_list)[list_index(context, as_list, index,
+                              "list assignment index out of range")] = value;
+        return nullptr;
+    }
+
+    long start, stop, step;
+    std::size_t n =
+        slice->unpack_indices(space, as_list->length, start, stop, step);
+
+    /* copy the new items first, value may be the list itself */
+    std::vector<M_BaseObject*> seq;
+    space->unpack_iterable(value, seq);
+
+    if (step == 1) {
+        as_list->replace_range(context, start, start + n, seq.data(),
+                               seq.size());
+        return nullptr;
+    }
+
+    if (seq.size() != n) {
+        throw InterpError::format(space, space->ValueError_type(),
+                                  "attempt to assign sequence of size %d to "
+                                  "extended slice of size %d",
+                                  (int)seq.size(), (int)n);
+    }
+
+    for (std::size_t i = 0; i < n; i++, start += step)
+        (*as_list)[start] = seq[i];
+
+    return nullptr;
+}
+
+M_BaseObject* M_StdListObject::__delitem__(mtpython::vm::ThreadContext* context,
+                                           M_BaseObject* self,
+                                           M_BaseObject* index)
+{
+    ObjSpace* space = context->get_space();
+    ScopedObjectLock lock(self);
+
+    M_StdListObject* as_list = static_cast<M_StdListObject*>(self);
+
+    M_StdSliceObject* slice = dynamic_cast<M_StdSliceObject*>(index);
+    if (!slice) {
+        as_list->erase(list_index(context, as_list, index,
+                                  "list assignment index out of range"));
+        return nullptr;
+    }
+
+    long start, stop, step;
+    std::size_t n =
+        slice->unpack_indices(space, as_list->length, start, stop, step);
+    if (n == 0) return nullptr;
+
+    if (step == 1) {
+        as_list->replace_range(context, start, start + n, nullptr, 0);
+        return nullptr;
+    }
+
+    /* delete the same items walking forwards */
+    if (step < 0) {
+        start += step * (long)(n - 1);
+        step = -step;
+    }
+
+    /* compact the survivors in a single pass */
+    M_BaseObject** items = as_list->begin();
+    std::size_t dst = start;
+    std::size_t next = start;
+    std::size_t deleted = 0;
+    for (std::size_t src = start; src < as_list->length; src++) {
+        if (deleted < n && src == next) {
+            deleted++;
+            next += step;
+            continue;
+        }
+        items[dst++] = items[src];
+    }
+
+    std::fill(items + dst, as_list->end(), nullptr);
+    as_list->length = dst;
+
+    return nullptr;
 }
 
 M_BaseObject* M_StdListObject::pop(mtpython::vm::ThreadContext* context,
@@ -180,22 +465,13 @@ M_BaseObject* M_StdListObject::pop(mtpython::vm::ThreadContext* context,
                           space->wrap_str(context, "pop from empty list"));
     }
 
-    if (index == -1) {
-        M_BaseObject* result = as_list->items.back();
-        as_list->items.pop_back();
-        return result;
-    }
-
     if (index < 0) index += size;
-    if (index >= size) {
+    if (index < 0 || index >= size) {
         throw InterpError(space->IndexError_type(),
                           space->wrap_str(context, "pop index out of range"));
     }
 
-    M_BaseObject* result = as_list->items[index];
-    as_list->items.erase(as_list->items.begin() + index);
-
-    return result;
+    return as_list->erase(index);
 }
 
 M_BaseObject* M_StdListObject::__iadd__(mtpython::vm::ThreadContext* context,
@@ -211,3 +487,353 @@ M_BaseObject* M_StdListObject::__iadd__(mtpython::vm::ThreadContext* context,
 
     return space->wrap_NotImplemented();
 }
+
+/* Fill dst[0:n*times] with times copies of src[0:n], doubling the copied
+ * block on each step. dst and src may be the same array */
+static void repeat_items(M_BaseObject** dst, M_BaseObject** src,
+                         std::size_t n, std::size_t times)
+{
+    std::size_t total = n * times;
+    std::size_t filled = n;
+
+    if (dst != src) std::copy(src, src + n, dst);
+    while (filled < total) {
+        std::size_t chunk = std::min(filled, total - filled);
+        std::copy(dst, dst + chunk, dst + filled);
+        filled += chunk;
+    }
+}
+
+static bool repeat_count(ObjSpace* space, M_BaseObject* times, int& n)
+{
+    try {
+        n = times->to_int(space, false);
+    } catch (const mtpython::NotImplementedException&) {
+        return false;
+    }
+
+    return true;
+}
+
+M_BaseObject* M_StdListObject::__imul__(mtpython::vm::ThreadContext* context,
+                                        M_BaseObject* self, M_BaseObject* times)
+{
+    ObjSpace* space = context->get_space();
+    M_StdListObject* as_list = static_cast<M_StdListObject*>(self);
+    ScopedObjectLock lock(self);
+
+    int n;
+    if (!repeat_count(space, times, n)) return space->wrap_NotImplemented();
+
+    std::size_t size = as_list->length;
+    if (n <= 0 || size == 0) {
+        std::fill(as_list->begin(), as_list->end(), nullptr);
+        as_list->length = 0;
+        return self;
+    }
+
+    as_list->reserve(context, size * n);
+    repeat_items(as_list->begin(), as_list->begin(), size, n);
+    as_list->length = size * n;
+
+    return self;
+}
+
+M_BaseObject* M_StdListObject::__add__(mtpython::vm::ThreadContext* context,
+                                       M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_StdListObject* as_list = static_cast<M_StdListObject*>(self);
+    M_StdListObject* other_list = dynamic_cast<M_StdListObject*>(other);
+
+    if (!other_list) return space->wrap_NotImplemented();
+
+    M_StdListObject* result =
+        create(context, as_list->length + other_list->length);
+    std::copy(other_list->begin(), other_list->end(),
+              std::copy(as_list->begin(), as_list->end(), result->begin()));
+
+    return result;
+}
+
+M_BaseObject* M_StdListObject::__mul__(mtpython::vm::ThreadContext* context,
+                                       M_BaseObject* self, M_BaseObject* times)
+{
+    ObjSpace* space = context->get_space();
+    M_StdListObject* as_list = static_cast<M_StdListObject*>(self);
+
+    int n;
+    if (!repeat_count(space, times, n)) return space->wrap_NotImplemented();
+    if (n <= 0 || as_list->length == 0) return create(context, 0);
+
+    M_StdListObject* result = create(context, as_list->length * n);
+    repeat_items(result->begin(), as_list->begin(), as_list->length, n);
+
+    return result;
+}
+
+static bool list_equal(ObjSpace* space, M_StdListObject* lhs,
+                       M_StdListObject* rhs)
+{
+    if (lhs->size() != rhs->size()) return false;
+
+    /* __eq__ may mutate either list, so the sizes are checked every time */
+    for (std::size_t i = 0; i < lhs->size() && i < rhs->size(); i++) {
+        M_BaseObject* x = (*lhs)[i];
+        M_BaseObject* y = (*rhs)[i];
+        if (x != y && !space->i_eq(x, y)) return false;
+    }
+
+    return lhs->size() == rhs->size();
+}
+
+M_BaseObject* M_StdListObject::__eq__(mtpython::vm::ThreadContext* context,
+                                      M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_StdListObject* other_list = dynamic_cast<M_StdListObject*>(other);
+
+    if (!other_list) return space->wrap_NotImplemented();
+
+    return space->new_bool(
+        list_equal(space, static_cast<M_StdListObject*>(self), other_list));
+}
+
+M_BaseObject* M_StdListObject::__ne__(mtpython::vm::ThreadContext* context,
+                                      M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_StdListObject* other_list = dynamic_cast<M_StdListObject*>(other);
+
+    if (!other_list) return space->wrap_NotImplemented();
+
+    return space->new_bool(
+        !list_equal(space, static_cast<M_StdListObject*>(self), other_list));
+}
+
+M_BaseObject* M_StdListObject::insert(mtpython::vm::ThreadContext* context,
+                                      M_BaseObject* self, M_BaseObject* index,
+                                      M_BaseObject* item)
+{
+    ObjSpace* space = context->get_space();
+    M_StdListObject* as_list = static_cast<M_StdListObject*>(self);
+    ScopedObjectLock lock(self);
+
+    int size = (int)as_list->length;
+    int i = space->i_get_index(index, space->TypeError_type(),
+                               space->wrap_str(context, "list index"));
+    if (i < 0) {
+        i += size;
+        if (i < 0) i = 0;
+    } else if (i > size) {
+        i = size;
+    }
+
+    as_list->replace_range(context, i, i, &item, 1);
+
+    return nullptr;
+}
+
+M_BaseObject* M_StdListObject::index(mtpython::vm::ThreadContext* context,
+                                     const Arguments& args)
+{
+    static Signature index_signature({"self", "value", "start", "stop"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("index", nullptr, index_signature, scope,
+               {space->wrap_int(context, 0),
+                space->wrap_int(context, std::numeric_limits<int>::max())});
+
+    M_StdListObject* as_list = static_cast<M_StdListObject*>(scope[0]);
+    M_BaseObject* value = scope[1];
+    int size = (int)as_list->length;
+    int start = space->unwrap_int(scope[2]);
+    int stop = space->unwrap_int(scope[3]);
+
+    if (start < 0) start = std::max(start + size, 0);
+    if (stop < 0) stop = std::max(stop + size, 0);
+
+    for (int i = start; i < stop && i < (int)as_list->length; i++) {
+        M_BaseObject* item = (*as_list)[i];
+        if (item == value || space->i_eq(item, value))
+            return space->wrap_int(context, i);
+    }
+
+    throw InterpError::format(space, space->ValueError_type(),
+                              "%s is not in list",
+                              space->unwrap_str(space->repr(value)).c_str());
+}
+
+M_BaseObject* M_StdListObject::remove(mtpython::vm::ThreadContext* context,
+                                      M_BaseObject* self, M_BaseObject* value)
+{
+    ObjSpace* space = context->get_space();
+    M_StdListObject* as_list = static_cast<M_StdListObject*>(self);
+
+    for (std::size_t i = 0; i < as_list->length; i++) {
+        M_BaseObject* item = (*as_list)[i];
+        if (item == value || space->i_eq(item, value)) {
+            ScopedObjectLock lock(self);
+            /* __eq__ may have mutated the list, don't erase another item */
+            if (i >= as_list->length || (*as_list)[i] != item)
+                throw InterpError(
+                    space->RuntimeError_type(),
+                    space->wrap_str(context,
+                                    "list modified during remove()"));
+            as_list->erase(i);
+            return nullptr;
+        }
+    }
+
+    throw InterpError(
+        space->ValueError_type(),
+        space->wrap_str(context, "list.remove(x): x not in list"));
+}
+
+M_BaseObject* M_StdListObject::count(mtpython::vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* value)
+{
+    ObjSpace* space = context->get_space();
+    M_StdListObject* as_list = static_cast<M_StdListObject*>(self);
+
+    int n = 0;
+    for (std::size_t i = 0; i < as_list->length; i++) {
+        M_BaseObject* item = (*as_list)[i];
+        if (item == value || space->i_eq(item, value)) n++;
+    }
+
+    return space->wrap_int(context, n);
+}
+
+M_BaseObject* M_StdListObject::reverse(mtpython::vm::ThreadContext* context,
+                                       M_BaseObject* self)
+{
+    M_StdListObject* as_list = static_cast<M_StdListObject*>(self);
+    ScopedObjectLock lock(self);
+
+    std::reverse(as_list->begin(), as_list->end());
+
+    return nullptr;
+}
+
+namespace {
+struct SortItem {
+    M_BaseObject* key;
+    M_BaseObject* value;
+};
+} // namespace
+
+/* Sort the decorated items by key. If all keys are exact ints, floats or strs
+ * they are compared natively, otherwise through the object space */
+static void sort_items(ObjSpace* space, std::vector<SortItem>& items)
+{
+    bool all_int = true, all_float = true, all_str = true;
+    for (auto& item : items) {
+        const std::type_info& type = typeid(*item.key);
+        all_int &=
+            type == typeid(M_StdIntObject) || type == typeid(M_StdBoolObject);
+        all_float &= type == typeid(M_StdFloatObject);
+        all_str &= type == typeid(M_StdUnicodeObject);
+    }
+
+    SortItem* first = items.data();
+    SortItem* last = first + items.size();
+
+    if (all_int) {
+        mtpython::timsort(first, last,
+                          [](const SortItem& lhs, const SortItem& rhs) {
+                              return M_STDINTOBJECT(lhs.key)->get_value() <
+                                     M_STDINTOBJECT(rhs.key)->get_value();
+                          });
+    } else if (all_float) {
+        mtpython::timsort(first, last,
+                          [](const SortItem& lhs, const SortItem& rhs) {
+                              return M_STDFLOATOBJECT(lhs.key)->get_value() <
+                                     M_STDFLOATOBJECT(rhs.key)->get_value();
+                          });
+    } else if (all_str) {
+        /* UTF-8 byte order is code point order */
+        mtpython::timsort(first, last,
+                          [](const SortItem& lhs, const SortItem& rhs) {
+                              return M_STDUNICODEOBJECT(lhs.key)->get_value() <
+                                     M_STDUNICODEOBJECT(rhs.key)->get_value();
+                          });
+    } else {
+        mtpython::timsort(first, last,
+                          [space](const SortItem& lhs, const SortItem& rhs) {
+                              return space->is_true(
+                                  space->lt(lhs.key, rhs.key));
+                          });
+    }
+}
+
+M_BaseObject* M_StdListObject::sort(mtpython::vm::ThreadContext* context,
+                                    const Arguments& args)
+{
+    static Signature sort_signature({"self", "key", "reverse"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("sort", nullptr, sort_signature, scope,
+               {space->wrap_None(), space->wrap_False()});
+
+    M_StdListObject* as_list = static_cast<M_StdListObject*>(scope[0]);
+    M_BaseObject* key = scope[1];
+    bool reverse = space->is_true(scope[2]);
+
+    /* the list appears empty while it is sorted. The saved item array keeps
+     * the values alive and is left untouched if a key or comparison raises */
+    M_GCArray<M_BaseObject*>* saved_items = as_list->items;
+    std::size_t n = as_list->length;
+    as_list->items = nullptr;
+    as_list->length = 0;
+
+    auto restore = [as_list, saved_items, n]() {
+        bool modified = as_list->items != nullptr;
+        as_list->items = saved_items;
+        as_list->length = n;
+        return modified;
+    };
+
+    /* The sort buffers live on the native heap, which the collector does
+     * not scan, and comparisons may run Python code that allocates. The key
+     * array keeps the keys alive until the list is undecorated; it is
+     * volatile so that it stays in the stack frame scanned for roots. */
+    M_GCArray<M_BaseObject*>* volatile keys = nullptr;
+    std::vector<SortItem> items(n);
+    try {
+        /* compute each key once */
+        if (key != space->wrap_None()) {
+            keys = M_GCArray<M_BaseObject*>::create(context, n);
+            for (std::size_t i = 0; i < n; i++)
+                (*keys)[i] = space->call_function(context, key,
+                                                  {(*saved_items)[i]});
+        }
+
+        for (std::size_t i = 0; i < n; i++) {
+            M_BaseObject* value = (*saved_items)[i];
+            items[i] = {keys ? (*keys)[i] : value, value};
+        }
+
+        /* reversing before and after keeps equal items in original order */
+        if (reverse) std::reverse(items.begin(), items.end());
+        sort_items(space, items);
+        if (reverse) std::reverse(items.begin(), items.end());
+    } catch (InterpError&) {
+        restore();
+        throw;
+    }
+
+    for (std::size_t i = 0; i < n; i++)
+        (*saved_items)[i] = items[i].value;
+    keys = nullptr;
+
+    if (restore()) {
+        throw InterpError(
+            space->ValueError_type(),
+            space->wrap_str(context, "list modified during sort"));
+    }
+
+    return nullptr;
+}
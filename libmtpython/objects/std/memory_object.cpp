@@ -1,17 +1,544 @@
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
 #include "interpreter/typedef.h"
 #include "interpreter/gateway.h"
+#include "interpreter/error.h"
+#include "interpreter/descriptor.h"
 #include "objects/std/memory_object.h"
+#include "objects/std/bytes_object.h"
+#include "objects/std/slice_object.h"
 
 using namespace mtpython::objects;
 using namespace mtpython::interpreter;
+using namespace mtpython::vm;
+
+/* Python value of the item at p */
+static M_BaseObject* unpack_item(ThreadContext* context, const char* format,
+                                 const std::uint8_t* p)
+{
+    ObjSpace* space = context->get_space();
+
+#define UNPACK_INT(type)                        \
+    {                                           \
+        type value;                             \
+        std::memcpy(&value, p, sizeof(value));  \
+        return space->wrap_int(context, (int)value); \
+    }
+
+    switch (format[0]) {
+    case 'B':
+        return space->wrap_int(context, *p);
+    case 'b':
+        return space->wrap_int(context, (std::int8_t)*p);
+    case 'c':
+        return space->new_bytes(context, p, 1);
+    case '?':
+        return space->new_bool(*p != 0);
+    case 'h':
+        UNPACK_INT(short)
+    case 'H':
+        UNPACK_INT(unsigned short)
+    case 'i':
+        UNPACK_INT(int)
+    case 'I':
+        UNPACK_INT(unsigned int)
+    case 'l':
+        UNPACK_INT(long)
+    case 'L':
+        UNPACK_INT(unsigned long)
+    case 'q':
+        UNPACK_INT(long long)
+    case 'Q':
+        UNPACK_INT(unsigned long long)
+    case 'f': {
+        float value;
+        std::memcpy(&value, p, sizeof(value));
+        return space->wrap_float(context, value);
+    }
+    case 'd': {
+        double value;
+        std::memcpy(&value, p, sizeof(value));
+        return space->wrap_float(context, value);
+    }
+    }
+
+#undef UNPACK_INT
+
+    throw InterpError::format(space, space->TypeError_type(),
+                              "memoryview: format %s not supported", format);
+}
+
+/* Store value as an item at p */
+static void pack_item(ThreadContext* context, const char* format,
+                      std::uint8_t* p, M_BaseObject* value)
+{
+    ObjSpace* space = context->get_space();
+    auto invalid_value = [&]() {
+        return InterpError::format(space, space->ValueError_type(),
+                                   "memoryview: invalid value for format '%s'",
+                                   format);
+    };
+
+#define PACK_INT(type)                                 \
+    {                                                  \
+        type item = (type)space->unwrap_int(value);    \
+        std::memcpy(p, &item, sizeof(item));           \
+        return;                                        \
+    }
+
+    switch (format[0]) {
+    case 'B': {
+        int item = space->unwrap_int(value);
+        if (item < 0 || item > 255) throw invalid_value();
+        *p = (std::uint8_t)item;
+        return;
+    }
+    case 'b': {
+        int item = space->unwrap_int(value);
+        if (item < -128 || item > 127) throw invalid_value();
+        *p = (std::uint8_t)item;
+        return;
+    }
+    case 'c': {
+        Buffer view;
+        space->get_buffer(value, view);
+        if (view.len != 1) throw invalid_value();
+        *p = *view.buf;
+        return;
+    }
+    case '?':
+        *p = space->is_true(value);
+        return;
+    case 'h':
+        PACK_INT(short)
+    case 'H':
+        PACK_INT(unsigned short)
+    case 'i':
+        PACK_INT(int)
+    case 'I':
+        PACK_INT(unsigned int)
+    case 'l':
+        PACK_INT(long)
+    case 'L':
+        PACK_INT(unsigned long)
+    case 'q':
+        PACK_INT(long long)
+    case 'Q':
+        PACK_INT(unsigned long long)
+    case 'f': {
+        float item = (float)space->unwrap_float(value);
+        std::memcpy(p, &item, sizeof(item));
+        return;
+    }
+    case 'd': {
+        double item = space->unwrap_float(value);
+        std::memcpy(p, &item, sizeof(item));
+        return;
+    }
+    }
+
+#undef PACK_INT
+
+    throw InterpError::format(space, space->TypeError_type(),
+                              "memoryview: format %s not supported", format);
+}
+
+M_StdMemoryViewObject::M_StdMemoryViewObject(M_BaseObject* obj,
+                                             const Buffer& view)
+    : obj(obj), offset(0), length(view.len), stride(view.stride),
+      itemsize(view.itemsize), format(view.format), readonly(view.readonly)
+{}
+
+Buffer M_StdMemoryViewObject::acquire(ThreadContext* context)
+{
+    ObjSpace* space = context->get_space();
+
+    if (!obj)
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "operation forbidden on "
+                                                   "released memoryview "
+                                                   "object"));
+
+    Buffer base;
+    obj->get_buffer(space, base);
+
+    if (length) {
+        std::ptrdiff_t first = (std::ptrdiff_t)offset;
+        std::ptrdiff_t last = first + (std::ptrdiff_t)(length - 1) * stride;
+        std::ptrdiff_t lo = std::min(first, last);
+        std::ptrdiff_t hi = std::max(first, last) + (std::ptrdiff_t)itemsize;
+
+        if (lo < 0 || hi > (std::ptrdiff_t)base.nbytes())
+            throw InterpError(space->ValueError_type(),
+                              space->wrap_str(context, "memoryview: underlying "
+                                                       "buffer was resized"));
+    }
+
+    Buffer view;
+    view.buf = base.buf + offset;
+    view.len = length;
+    view.itemsize = itemsize;
+    view.stride = stride;
+    view.readonly = readonly;
+    view.format = format;
+    return view;
+}
+
+M_StdMemoryViewObject* M_StdMemoryViewObject::subview(ThreadContext* context,
+                                                      std::size_t start,
+                                                      std::size_t n,
+                                                      std::ptrdiff_t step)
+{
+    M_StdMemoryViewObject* view = new (context) M_StdMemoryViewObject(*this);
+
+    view->offset = offset + (std::ptrdiff_t)start * stride;
+    view->length = n;
+    view->stride = stride * step;
+    return view;
+}
+
+void M_StdMemoryViewObject::get_buffer(ObjSpace* space, Buffer& view)
+{
+    view = acquire(ThreadContext::current_thread());
+}
+
+M_BaseObject* M_StdMemoryViewObject::__new__(ThreadContext* context,
+                                             M_BaseObject* type,
+                                             M_BaseObject* object)
+{
+    ObjSpace* space = context->get_space();
+
+    /* a view of a view refers directly to the original exporter */
+    M_StdMemoryViewObject* as_view =
+        dynamic_cast<M_StdMemoryViewObject*>(object);
+    if (as_view) {
+        as_view->acquire(context);
+        return new (context) M_StdMemoryViewObject(*as_view);
+    }
+
+    Buffer view;
+    space->get_buffer(object, view, false, false);
+    return new (context) M_StdMemoryViewObject(object, view);
+}
+
+M_BaseObject* M_StdMemoryViewObject::__repr__(ThreadContext* context,
+                                              M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_StdMemoryViewObject* as_view = M_STDMEMORYOBJECT(self);
+
+    return self->get_repr(space, as_view->obj ? "memory" : "released memory");
+}
+
+M_BaseObject* M_StdMemoryViewObject::__len__(ThreadContext* context,
+                                             M_BaseObject* self)
+{
+    Buffer view = M_STDMEMORYOBJECT(self)->acquire(context);
+    return context->get_space()->wrap_int(context, (int)view.len);
+}
+
+M_BaseObject* M_StdMemoryViewObject::__iter__(ThreadContext* context,
+                                              M_BaseObject* self)
+{
+    M_STDMEMORYOBJECT(self)->acquire(context);
+    return context->get_space()->new_seqiter(context, self);
+}
+
+static std::size_t view_index(ThreadContext* context, const Buffer& view,
+                              M_BaseObject* index)
+{
+    ObjSpace* space = context->get_space();
+
+    int i = space->i_get_index(index, space->IndexError_type(),
+                               space->wrap_str(context, "memoryview index"));
+    if (i < 0) i += (int)view.len;
+    if (i < 0 || i >= (int)view.len)
+        throw InterpError(space->IndexError_type(),
+                          space->wrap_str(context, "index out of bounds on "
+                                                   "dimension 1"));
+
+    return (std::size_t)i;
+}
+
+M_BaseObject* M_StdMemoryViewObject::__getitem__(ThreadContext* context,
+                                                 M_BaseObject* self,
+                                                 M_BaseObject* index)
+{
+    ObjSpace* space = context->get_space();
+    M_StdMemoryViewObject* as_view = M_STDMEMORYOBJECT(self);
+    Buffer view = as_view->acquire(context);
+
+    M_StdSliceObject* slice = dynamic_cast<M_StdSliceObject*>(index);
+    if (slice) {
+        long start, stop, step;
+        std::size_t n =
+            slice->unpack_indices(space, view.len, start, stop, step);
+        return as_view->subview(context, start, n, step);
+    }
+
+    std::size_t i = view_index(context, view, index);
+    return unpack_item(context, view.format, view.buf + i * view.stride);
+}
+
+M_BaseObject* M_StdMemoryViewObject::__setitem__(ThreadContext* context,
+                                                 M_BaseObject* self,
+                                                 M_BaseObject* index,
+                                                 M_BaseObject* value)
+{
+    ObjSpace* space = context->get_space();
+    M_StdMemoryViewObject* as_view = M_STDMEMORYOBJECT(self);
+    Buffer view = as_view->acquire(context);
+
+    if (view.readonly)
+        throw InterpError(space->TypeError_type(),
+                          space->wrap_str(context, "cannot modify read-only "
+                                                   "memory"));
+
+    M_StdSliceObject* slice = dynamic_cast<M_StdSliceObject*>(index);
+    if (!slice) {
+        std::size_t i = view_index(context, view, index);
+        pack_item(context, view.format, view.buf + i * view.stride, value);
+        return nullptr;
+    }
+
+    long start, stop, step;
+    std::size_t n =
+        slice->unpack_indices(space, view.len, start, stop, step);
 
-static mtpython::interpreter::Typedef memoryview_typedef("memoryview", {});
+    Buffer src;
+    space->get_buffer(value, src, false, false);
+    if (src.len != n || src.itemsize != view.itemsize ||
+        std::strcmp(src.format, view.format))
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "memoryview assignment: "
+                                                   "lvalue and rvalue have "
+                                                   "different structures"));
 
-M_StdMemoryViewObject::M_StdMemoryViewObject() {}
+    /* copy out first, source and destination may overlap */
+    std::vector<std::uint8_t> items(src.nbytes());
+    src.copy_to(items.data());
+
+    std::uint8_t* dst = view.buf + start * view.stride;
+    for (std::size_t i = 0; i < n; i++, dst += step * view.stride)
+        std::memcpy(dst, &items[i * view.itemsize], view.itemsize);
+
+    return nullptr;
+}
+
+M_BaseObject* M_StdMemoryViewObject::__eq__(ThreadContext* context,
+                                            M_BaseObject* self,
+                                            M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_StdMemoryViewObject* as_view = M_STDMEMORYOBJECT(self);
+
+    if (!as_view->obj) return space->new_bool(self == other);
+    Buffer a = as_view->acquire(context);
+    Buffer b;
+    try {
+        other->get_buffer(space, b);
+    } catch (const mtpython::NotImplementedException&) {
+        return space->wrap_NotImplemented();
+    }
+
+    if (a.len != b.len) return space->wrap_False();
+
+    /* views of the same format compare their memory, others compare the
+     * values of their items */
+    if (!std::strcmp(a.format, b.format)) {
+        std::vector<std::uint8_t> lhs(a.nbytes()), rhs(b.nbytes());
+        a.copy_to(lhs.data());
+        b.copy_to(rhs.data());
+        return space->new_bool(lhs == rhs);
+    }
+
+    for (std::size_t i = 0; i < a.len; i++) {
+        if (!space->i_eq(unpack_item(context, a.format, a.buf + i * a.stride),
+                         unpack_item(context, b.format, b.buf + i * b.stride)))
+            return space->wrap_False();
+    }
+
+    return space->wrap_True();
+}
+
+M_BaseObject* M_StdMemoryViewObject::__ne__(ThreadContext* context,
+                                            M_BaseObject* self,
+                                            M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_BaseObject* eq = __eq__(context, self, other);
+    if (eq == space->wrap_NotImplemented()) return eq;
+
+    return space->new_bool(eq != space->wrap_True());
+}
+
+M_BaseObject* M_StdMemoryViewObject::__enter__(ThreadContext* context,
+                                               M_BaseObject* self)
+{
+    M_STDMEMORYOBJECT(self)->acquire(context);
+    return self;
+}
+
+M_BaseObject* M_StdMemoryViewObject::__exit__(ThreadContext* context,
+                                              const Arguments& args)
+{
+    static Signature exit_signature(
+        {"self", "exc_type", "exc_value", "traceback"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("__exit__", nullptr, exit_signature, scope,
+               {space->wrap_None(), space->wrap_None(), space->wrap_None()});
+
+    release(context, scope[0]);
+    return space->wrap_None();
+}
+
+M_BaseObject* M_StdMemoryViewObject::tobytes(ThreadContext* context,
+                                             M_BaseObject* self)
+{
+    Buffer view = M_STDMEMORYOBJECT(self)->acquire(context);
+
+    /* the only copy a memoryview makes */
+    M_StdBytesObject* bytes =
+        M_StdBytesObject::create(context, nullptr, view.nbytes());
+    view.copy_to(bytes->data());
+
+    return bytes;
+}
+
+M_BaseObject* M_StdMemoryViewObject::tolist(ThreadContext* context,
+                                            M_BaseObject* self)
+{
+    Buffer view = M_STDMEMORYOBJECT(self)->acquire(context);
+    std::vector<M_BaseObject*> items;
+
+    items.reserve(view.len);
+    for (std::size_t i = 0; i < view.len; i++)
+        items.push_back(
+            unpack_item(context, view.format, view.buf + i * view.stride));
+
+    return context->get_space()->new_list(context, items);
+}
+
+M_BaseObject* M_StdMemoryViewObject::hex(ThreadContext* context,
+                                         M_BaseObject* self)
+{
+    M_STDMEMORYOBJECT(self)->acquire(context);
+    return M_StdBytesObject::hex(context, self);
+}
+
+M_BaseObject* M_StdMemoryViewObject::release(ThreadContext* context,
+                                             M_BaseObject* self)
+{
+    M_STDMEMORYOBJECT(self)->obj = nullptr;
+    return nullptr;
+}
+
+M_BaseObject* M_StdMemoryViewObject::obj_get(ThreadContext* context,
+                                             M_BaseObject* self)
+{
+    M_STDMEMORYOBJECT(self)->acquire(context);
+    return M_STDMEMORYOBJECT(self)->obj;
+}
+
+M_BaseObject* M_StdMemoryViewObject::nbytes_get(ThreadContext* context,
+                                                M_BaseObject* self)
+{
+    Buffer view = M_STDMEMORYOBJECT(self)->acquire(context);
+    return context->get_space()->wrap_int(context, (int)view.nbytes());
+}
+
+M_BaseObject* M_StdMemoryViewObject::readonly_get(ThreadContext* context,
+                                                  M_BaseObject* self)
+{
+    Buffer view = M_STDMEMORYOBJECT(self)->acquire(context);
+    return context->get_space()->new_bool(view.readonly);
+}
+
+M_BaseObject* M_StdMemoryViewObject::itemsize_get(ThreadContext* context,
+                                                  M_BaseObject* self)
+{
+    Buffer view = M_STDMEMORYOBJECT(self)->acquire(context);
+    return context->get_space()->wrap_int(context, (int)view.itemsize);
+}
+
+M_BaseObject* M_StdMemoryViewObject::format_get(ThreadContext* context,
+                                                M_BaseObject* self)
+{
+    Buffer view = M_STDMEMORYOBJECT(self)->acquire(context);
+    return context->get_space()->wrap_str(context, view.format);
+}
+
+M_BaseObject* M_StdMemoryViewObject::strides_get(ThreadContext* context,
+                                                 M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    Buffer view = M_STDMEMORYOBJECT(self)->acquire(context);
+    return space->new_tuple(context,
+                            {space->wrap_int(context, (int)view.stride)});
+}
+
+M_BaseObject* M_StdMemoryViewObject::contiguous_get(ThreadContext* context,
+                                                    M_BaseObject* self)
+{
+    Buffer view = M_STDMEMORYOBJECT(self)->acquire(context);
+    return context->get_space()->new_bool(view.is_contiguous());
+}
 
 Typedef* M_StdMemoryViewObject::_memoryview_typedef()
 {
+    static Typedef memoryview_typedef(
+        "memoryview",
+        {
+            {"__new__", new InterpFunctionWrapper(
+                            "__new__", M_StdMemoryViewObject::__new__)},
+            {"__repr__", new InterpFunctionWrapper(
+                             "__repr__", M_StdMemoryViewObject::__repr__)},
+            {"__len__", new InterpFunctionWrapper(
+                            "__len__", M_StdMemoryViewObject::__len__)},
+            {"__iter__", new InterpFunctionWrapper(
+                             "__iter__", M_StdMemoryViewObject::__iter__)},
+            {"__getitem__",
+             new InterpFunctionWrapper("__getitem__",
+                                       M_StdMemoryViewObject::__getitem__)},
+            {"__setitem__",
+             new InterpFunctionWrapper("__setitem__",
+                                       M_StdMemoryViewObject::__setitem__)},
+            {"__eq__", new InterpFunctionWrapper(
+                           "__eq__", M_StdMemoryViewObject::__eq__)},
+            {"__ne__", new InterpFunctionWrapper(
+                           "__ne__", M_StdMemoryViewObject::__ne__)},
+            {"__enter__", new InterpFunctionWrapper(
+                              "__enter__", M_StdMemoryViewObject::__enter__)},
+            {"__exit__", new InterpFunctionWrapper(
+                             "__exit__", M_StdMemoryViewObject::__exit__)},
+            {"tobytes", new InterpFunctionWrapper(
+                            "tobytes", M_StdMemoryViewObject::tobytes)},
+            {"tolist", new InterpFunctionWrapper(
+                           "tolist", M_StdMemoryViewObject::tolist)},
+            {"hex",
+             new InterpFunctionWrapper("hex", M_StdMemoryViewObject::hex)},
+            {"release", new InterpFunctionWrapper(
+                            "release", M_StdMemoryViewObject::release)},
+            {"obj", new GetSetDescriptor(M_StdMemoryViewObject::obj_get)},
+            {"nbytes", new GetSetDescriptor(M_StdMemoryViewObject::nbytes_get)},
+            {"readonly",
+             new GetSetDescriptor(M_StdMemoryViewObject::readonly_get)},
+            {"itemsize",
+             new GetSetDescriptor(M_StdMemoryViewObject::itemsize_get)},
+            {"format", new GetSetDescriptor(M_StdMemoryViewObject::format_get)},
+            {"strides",
+             new GetSetDescriptor(M_StdMemoryViewObject::strides_get)},
+            {"contiguous",
+             new GetSetDescriptor(M_StdMemoryViewObject::contiguous_get)},
+        });
+
     return &memoryview_typedef;
 }
 
-Typedef* M_StdMemoryViewObject::get_typedef() { return &memoryview_typedef; }
+Typedef* M_StdMemoryViewObject::get_typedef() { return _memoryview_typedef(); }
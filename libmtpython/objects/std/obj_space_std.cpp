@@ -4,6 +4,7 @@
 #include "objects/std/obj_space_std.h"
 #include "objects/std/type_object.h"
 #include "objects/std/int_object.h"
+#include "objects/std/float_object.h"
 #include "objects/std/iter_object.h"
 #include "objects/std/list_object.h"
 #include "objects/std/bool_object.h"
@@ -16,9 +17,11 @@
 #include "objects/std/bytearray_object.h"
 #include "objects/std/bytes_object.h"
 #include "objects/std/memory_object.h"
+#include "objects/std/slice_object.h"
 #include "objects/std/frame.h"
 
 #include <string>
+#include <typeinfo>
 
 using namespace mtpython::objects;
 using namespace mtpython::vm;
@@ -59,6 +62,8 @@ void StdObjSpace::initialize()
         new (ThreadContext::current_thread()) M_StdBoolObject(false);
     wrapped_NotImplemented =
         new (ThreadContext::current_thread()) M_NotImplemented();
+    empty_tuple =
+        M_StdTupleObject::create(ThreadContext::current_thread(), 0);
 
     /* type of all types */
     M_BaseObject* type_obj = get_typeobject(M_StdTypeObject::_type_typedef());
@@ -74,15 +79,24 @@ void StdObjSpace::initialize()
     builtin_types["bytearray"] =
         get_typeobject(M_StdByteArrayObject::_bytearray_typedef());
     builtin_types["dict"] = get_typeobject(M_StdDictObject::_dict_typedef());
+    builtin_types["float"] =
+        get_typeobject(M_StdFloatObject::_float_typedef());
     builtin_types["int"] = get_typeobject(M_StdIntObject::_int_typedef());
     builtin_types["set"] = get_typeobject(M_StdSetObject::_set_typedef());
-    builtin_types["frozenset"] = get_typeobject(M_StdSetObject::_set_typedef());
+    builtin_types["frozenset"] =
+        get_typeobject(M_StdFrozenSetObject::_frozenset_typedef());
     builtin_types["str"] = get_typeobject(M_StdUnicodeObject::_str_typedef());
     builtin_types["tuple"] = get_typeobject(M_StdTupleObject::_tuple_typedef());
     builtin_types["list"] = get_typeobject(M_StdListObject::_list_typedef());
     builtin_types["bytes"] = get_typeobject(M_StdBytesObject::_bytes_typedef());
     builtin_types["memoryview"] =
         get_typeobject(M_StdMemoryViewObject::_memoryview_typedef());
+    builtin_types["slice"] =
+        get_typeobject(M_StdSliceObject::_slice_typedef());
+
+    for (int c = 0; c < 128; c++) {
+        ascii_chars[c] = new_interned_str(std::string(1, (char)c));
+    }
 
     make_builtins();
     setup_builtin_modules();
@@ -96,6 +110,7 @@ void StdObjSpace::mark_roots(gc::GarbageCollector* gc)
     gc->mark_object_maybe(wrapped_True);
     gc->mark_object_maybe(wrapped_False);
     gc->mark_object_maybe(wrapped_NotImplemented);
+    gc->mark_object_maybe(empty_tuple);
 
     for (const auto& [k, v] : builtin_types)
         gc->mark_object(v);
@@ -178,6 +193,11 @@ std::string StdObjSpace::get_type_name(M_BaseObject* obj)
     return type_obj->get_name();
 }
 
+const TypeSlots* StdObjSpace::type_slots(M_BaseObject* obj)
+{
+    return static_cast<M_StdTypeObject*>(type(obj))->get_slots();
+}
+
 M_BaseObject* StdObjSpace::wrap_int(ThreadContext* context, int x)
 {
     return new (context) M_StdIntObject(x);
@@ -189,22 +209,54 @@ M_BaseObject* StdObjSpace::wrap_int(ThreadContext* context,
     return new (context) M_StdIntObject(x);
 }
 
+M_BaseObject* StdObjSpace::wrap_float(ThreadContext* context, double x)
+{
+    return new (context) M_StdFloatObject(x);
+}
+
+M_BaseObject* StdObjSpace::wrap_float(ThreadContext* context,
+                                      const std::string& x)
+{
+    return new (context) M_StdFloatObject(x);
+}
+
 M_BaseObject* StdObjSpace::wrap_str(ThreadContext* context,
                                     const std::string& x)
 {
     return new (context) M_StdUnicodeObject(x);
 }
 
+M_BaseObject* StdObjSpace::new_interned_str(const std::string& x)
+{
+    M_BaseObject* wrapped = ObjSpace::new_interned_str(x);
+    M_STDUNICODEOBJECT(wrapped)->set_interned();
+    return wrapped;
+}
+
 M_BaseObject* StdObjSpace::new_tuple(ThreadContext* context,
                                      const std::vector<M_BaseObject*>& items)
 {
-    return new (context) M_StdTupleObject(items);
+    M_BaseObject* tuple = new_tuple(context, items.size());
+    std::copy(items.begin(), items.end(), tuple_items(tuple));
+    return tuple;
+}
+
+M_BaseObject* StdObjSpace::new_tuple(ThreadContext* context, std::size_t size)
+{
+    /* tuples are immutable so all empty tuples can be the same object */
+    if (!size) return empty_tuple;
+    return M_StdTupleObject::create(context, size);
+}
+
+M_BaseObject** StdObjSpace::tuple_items(M_BaseObject* tuple)
+{
+    return M_STDTUPLEOBJECT(tuple)->begin();
 }
 
 M_BaseObject* StdObjSpace::new_list(ThreadContext* context,
                                     const std::vector<M_BaseObject*>& items)
 {
-    return new (context) M_StdListObject(items);
+    return new (context) M_StdListObject(context, items);
 }
 
 M_BaseObject* StdObjSpace::new_dict(ThreadContext* context)
@@ -217,21 +269,109 @@ M_BaseObject* StdObjSpace::new_set(ThreadContext* context)
     return new (context) M_StdSetObject(this);
 }
 
+M_BaseObject* StdObjSpace::new_bytes(ThreadContext* context, const void* data,
+                                     std::size_t size)
+{
+    return M_StdBytesObject::create(context, data, size);
+}
+
 M_BaseObject* StdObjSpace::new_seqiter(ThreadContext* context,
                                        M_BaseObject* obj)
 {
     return new (context) M_StdSeqIterObject(obj);
 }
 
+M_BaseObject* StdObjSpace::new_slice(ThreadContext* context,
+                                     M_BaseObject* start, M_BaseObject* stop,
+                                     M_BaseObject* step)
+{
+    return new (context) M_StdSliceObject(start, stop, step);
+}
+
 void StdObjSpace::unwrap_tuple(M_BaseObject* obj,
                                std::vector<M_BaseObject*>& list)
 {
-    M_StdTupleObject* tuple = M_STDTUPLEOBJECT(obj);
-    if (!tuple) return;
-    std::vector<M_BaseObject*>& items = tuple->get_items();
+    M_StdTupleObject* tuple = dynamic_cast<M_StdTupleObject*>(obj);
 
     list.clear();
-    list.insert(list.end(), items.begin(), items.end());
+    if (tuple)
+        list.assign(tuple->begin(), tuple->end());
+    else
+        unpack_iterable(obj, list);
+}
+
+/* Exact dicts are accessed directly, without wrapping str keys or raising
+ * KeyError for missing items */
+static inline M_StdDictObject* as_exact_dict(M_BaseObject* obj)
+{
+    if (typeid(*obj) != typeid(M_StdDictObject)) return nullptr;
+    return static_cast<M_StdDictObject*>(obj);
+}
+
+M_BaseObject* StdObjSpace::getitem_str(M_BaseObject* obj,
+                                       const std::string& key)
+{
+    M_StdDictObject* dict = as_exact_dict(obj);
+    if (!dict) return ObjSpace::getitem_str(obj, key);
+
+    ScopedObjectLock lock(dict);
+    M_BaseObject* value = dict->getitem_str(key);
+    if (!value)
+        throw InterpError(KeyError_type(),
+                          wrap_str(ThreadContext::current_thread(), key));
+    return value;
+}
+
+M_BaseObject* StdObjSpace::finditem(M_BaseObject* obj, M_BaseObject* key)
+{
+    M_StdDictObject* dict = as_exact_dict(obj);
+    if (!dict) return ObjSpace::finditem(obj, key);
+
+    ScopedObjectLock lock(dict);
+    return dict->getitem(key);
+}
+
+M_BaseObject* StdObjSpace::finditem_str(M_BaseObject* obj,
+                                        const std::string& key)
+{
+    M_StdDictObject* dict = as_exact_dict(obj);
+    if (!dict) return ObjSpace::finditem_str(obj, key);
+
+    ScopedObjectLock lock(dict);
+    return dict->getitem_str(key);
+}
+
+void StdObjSpace::setitem_str(M_BaseObject* obj, const std::string& key,
+                              M_BaseObject* value)
+{
+    M_StdDictObject* dict = as_exact_dict(obj);
+    if (!dict) {
+        ObjSpace::setitem_str(obj, key, value);
+        return;
+    }
+
+    ScopedObjectLock lock(dict);
+    dict->setitem_str(ThreadContext::current_thread(), key, value);
+}
+
+bool StdObjSpace::i_lt(M_BaseObject* obj1, M_BaseObject* obj2)
+{
+    const std::type_info& type = typeid(*obj1);
+
+    if (type == typeid(*obj2)) {
+        if (type == typeid(M_StdIntObject))
+            return M_STDINTOBJECT(obj1)->get_value() <
+                   M_STDINTOBJECT(obj2)->get_value();
+        if (type == typeid(M_StdFloatObject))
+            return M_STDFLOATOBJECT(obj1)->get_value() <
+                   M_STDFLOATOBJECT(obj2)->get_value();
+        /* UTF-8 byte order is code point order */
+        if (type == typeid(M_StdUnicodeObject))
+            return M_STDUNICODEOBJECT(obj1)->get_value() <
+                   M_STDUNICODEOBJECT(obj2)->get_value();
+    }
+
+    return is_true(lt(obj1, obj2));
 }
 
 int StdObjSpace::i_get_index(M_BaseObject* obj, M_BaseObject* exc,
@@ -1,5 +1,9 @@
 #include <string>
-#include <unordered_set>
+#include <algorithm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "interpreter/typedef.h"
 #include "interpreter/gateway.h"
@@ -10,36 +14,280 @@ using namespace mtpython::objects;
 using namespace mtpython::interpreter;
 using namespace mtpython::vm;
 
+static constexpr std::size_t GROUP_WIDTH = 16;
+static constexpr std::uint8_t CTRL_EMPTY = 0x80;
+static constexpr std::uint8_t CTRL_DELETED = 0xfe;
+
+/* Spread the key hash over all bits. int keys hash to themselves, so
+ * without this consecutive ints would share a group and their 7-bit tags */
+static inline std::size_t mix_hash(std::size_t hash)
+{
+    return hash * (std::size_t)0x9e3779b97f4a7c15ULL;
+}
+
+static inline std::uint8_t hash_tag(std::size_t mixed)
+{
+    return (std::uint8_t)(mixed >> (sizeof(std::size_t) * 8 - 7));
+}
+
+/* Bit i is set if control byte i of the group equals b */
+static inline std::uint32_t match_byte(const std::uint8_t* group,
+                                       std::uint8_t b)
+{
+#ifdef __SSE2__
+    __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return (std::uint32_t)_mm_movemask_epi8(
+        _mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)b)));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < GROUP_WIDTH; i++) {
+        if (group[i] == b) mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+/* Bit i is set if slot i of the group is empty or deleted */
+static inline std::uint32_t match_free(const std::uint8_t* group)
+{
+#ifdef __SSE2__
+    return (std::uint32_t)_mm_movemask_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(group)));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < GROUP_WIDTH; i++) {
+        if (group[i] & 0x80) mask |= 1u << i;
+    }
+    return mask;
+#endif
+}
+
+static inline std::size_t lowest_bit(std::uint32_t mask)
+{
+    return (std::size_t)__builtin_ctz(mask);
+}
+
 void M_StdSetIterObject::mark_children(gc::GarbageCollector* gc)
 {
-    gc->mark_object(set);
+    if (set) gc->mark_object(set);
+}
+
+/* Slot holding key, or npos if it is not in the set. Groups are probed in a
+ * triangular sequence, which visits every group of a power-of-two table */
+std::size_t M_StdSetObject::lookup(M_BaseObject* key, std::size_t hash)
+{
+    if (!slots) return npos;
+
+    M_GCArray<Slot>* cur_slots = slots;
+    std::size_t mixed = mix_hash(hash);
+    std::uint8_t tag = hash_tag(mixed);
+    std::size_t group_mask = slots->size() / GROUP_WIDTH - 1;
+    std::size_t g = mixed & group_mask;
+
+    for (std::size_t stride = 1;; stride++) {
+        const std::uint8_t* group = ctrl->begin() + g * GROUP_WIDTH;
+
+        for (std::uint32_t m = match_byte(group, tag); m; m &= m - 1) {
+            std::size_t i = g * GROUP_WIDTH + lowest_bit(m);
+            const Slot& slot = (*slots)[i];
+            if (slot.hash != hash) continue;
+
+            /* keys_equal may call back into Python code and resize the set,
+             * don't hold a reference to the slot */
+            M_BaseObject* other = slot.key;
+            if (keys_equal(space, other, key)) return i;
+            if (slots != cur_slots) return lookup(key, hash);
+        }
+
+        if (match_byte(group, CTRL_EMPTY)) return npos;
+        g = (g + stride) & group_mask;
+    }
+}
+
+/* First empty or deleted slot in the probe sequence of hash */
+std::size_t M_StdSetObject::find_free_slot(std::size_t hash)
+{
+    std::size_t mixed = mix_hash(hash);
+    std::size_t group_mask = slots->size() / GROUP_WIDTH - 1;
+    std::size_t g = mixed & group_mask;
+
+    for (std::size_t stride = 1;; stride++) {
+        std::uint32_t m = match_free(ctrl->begin() + g * GROUP_WIDTH);
+        if (m) return g * GROUP_WIDTH + lowest_bit(m);
+        g = (g + stride) & group_mask;
+    }
+}
+
+void M_StdSetObject::resize(std::size_t min_used)
+{
+    /* at most 7/8 of the slots are filled, grow to leave room for as many
+     * insertions as there are items */
+    std::size_t new_size = GROUP_WIDTH;
+    while (new_size / 8 * 7 < min_used * 2)
+        new_size <<= 1;
+
+    ThreadContext* context = ThreadContext::current_thread();
+    M_GCArray<std::uint8_t>* old_ctrl = ctrl;
+    M_GCArray<Slot>* old_slots = slots;
+
+    ctrl = M_GCArray<std::uint8_t>::create(context, new_size);
+    std::fill(ctrl->begin(), ctrl->end(), CTRL_EMPTY);
+    slots = M_GCArray<Slot>::create(context, new_size);
+    fill = used;
+
+    if (!old_slots) return;
+    for (std::size_t i = 0; i < old_slots->size(); i++) {
+        if ((*old_ctrl)[i] & 0x80) continue;
+
+        const Slot& slot = (*old_slots)[i];
+        std::size_t j = find_free_slot(slot.hash);
+        (*ctrl)[j] = hash_tag(mix_hash(slot.hash));
+        (*slots)[j] = slot;
+    }
+}
+
+/* Insert a key that is known not to be in the set */
+void M_StdSetObject::insert_hashed(M_BaseObject* key, std::size_t hash)
+{
+    if (!slots || fill + 1 > slots->size() / 8 * 7) resize(used + 1);
+
+    std::size_t i = find_free_slot(hash);
+    if ((*ctrl)[i] == CTRL_EMPTY) fill++;
+    (*ctrl)[i] = hash_tag(mix_hash(hash));
+    (*slots)[i] = {hash, key};
+    used++;
+}
+
+void M_StdSetObject::erase_slot(std::size_t i)
+{
+    /* a probe stops at the first group with an empty slot, so the slot can
+     * only become empty again if its group already has one */
+    const std::uint8_t* group = ctrl->begin() + i / GROUP_WIDTH * GROUP_WIDTH;
+    if (match_byte(group, CTRL_EMPTY)) {
+        (*ctrl)[i] = CTRL_EMPTY;
+        fill--;
+    } else {
+        (*ctrl)[i] = CTRL_DELETED;
+    }
+
+    (*slots)[i] = {0, nullptr};
+    used--;
+}
+
+void M_StdSetObject::copy_from(ThreadContext* context, M_StdSetObject* other)
+{
+    if (!other->slots) return;
+
+    ctrl = M_GCArray<std::uint8_t>::create(context, other->ctrl->size());
+    std::copy(other->ctrl->begin(), other->ctrl->end(), ctrl->begin());
+    slots = M_GCArray<Slot>::create(context, other->slots->size());
+    std::copy(other->slots->begin(), other->slots->end(), slots->begin());
+    used = other->used;
+    fill = other->fill;
+}
+
+bool M_StdSetObject::contains(M_BaseObject* key)
+{
+    return lookup(key, hash_key(space, key)) != npos;
+}
+
+void M_StdSetObject::insert(M_BaseObject* key)
+{
+    std::size_t hash = hash_key(space, key);
+    if (lookup(key, hash) != npos) return;
+
+    insert_hashed(key, hash);
+}
+
+bool M_StdSetObject::erase(M_BaseObject* key)
+{
+    std::size_t i = lookup(key, hash_key(space, key));
+    if (i == npos) return false;
+
+    erase_slot(i);
+    return true;
+}
+
+void M_StdSetObject::clear_entries()
+{
+    ctrl = nullptr;
+    slots = nullptr;
+    used = fill = 0;
+}
+
+void M_StdSetObject::update_from(M_BaseObject* iterable)
+{
+    M_StdSetObject* other = dynamic_cast<M_StdSetObject*>(iterable);
+
+    if (!other) {
+        std::vector<M_BaseObject*> items;
+        space->unpack_iterable(iterable, items);
+        for (auto* item : items)
+            insert(item);
+        return;
+    }
+
+    if (other == this || !other->slots) return;
+    for (std::size_t i = 0; i < other->slots->size(); i++) {
+        if ((*other->ctrl)[i] & 0x80) continue;
+
+        Slot slot = (*other->slots)[i];
+        if (lookup(slot.key, slot.hash) == npos)
+            insert_hashed(slot.key, slot.hash);
+    }
+}
+
+bool M_StdSetObject::next_entry(std::size_t& pos, M_BaseObject*& key)
+{
+    if (!slots) return false;
+
+    while (pos < slots->size()) {
+        std::size_t i = pos++;
+        if (!((*ctrl)[i] & 0x80)) {
+            key = (*slots)[i].key;
+            return true;
+        }
+    }
+
+    return false;
 }
 
 M_BaseObject* M_StdSetObject::_discard(ThreadContext* context,
                                        M_BaseObject* item)
 {
-    M_BaseObject* result = nullptr;
     lock();
-    auto iter = set.find(item);
-    if (iter != set.end()) {
-        set.erase(iter);
-        result = item;
-    }
+    bool found = erase(item);
     unlock();
 
-    return result;
+    return found ? item : nullptr;
 }
 
 bool M_StdSetObject::i_issubset(M_StdSetObject* other)
 {
-    for (auto& item : set) {
-        auto got = other->set.find(item);
-        if (got == other->set.end()) return false;
+    if (used > other->used) return false;
+    if (!slots) return true;
+
+    for (std::size_t i = 0; i < slots->size(); i++) {
+        if ((*ctrl)[i] & 0x80) continue;
+
+        Slot slot = (*slots)[i];
+        if (other->lookup(slot.key, slot.hash) == npos) return false;
     }
 
     return true;
 }
 
+/* other as a set, building a temporary one from any other iterable */
+static M_StdSetObject* to_set(ThreadContext* context, M_BaseObject* other)
+{
+    M_StdSetObject* other_as_set = dynamic_cast<M_StdSetObject*>(other);
+    if (other_as_set) return other_as_set;
+
+    other_as_set = new (context) M_StdSetObject(context->get_space());
+    other_as_set->update_from(other);
+    return other_as_set;
+}
+
 M_BaseObject* M_StdSetObject::__new__(mtpython::vm::ThreadContext* context,
                                       const Arguments& args)
 {
@@ -51,7 +299,18 @@ M_BaseObject* M_StdSetObject::__new__(mtpython::vm::ThreadContext* context,
 M_BaseObject* M_StdSetObject::__init__(mtpython::vm::ThreadContext* context,
                                        const Arguments& args)
 {
+    static Signature init_signature({"self", "iterable"});
+
     ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("set", nullptr, init_signature, scope, {nullptr});
+
+    M_StdSetObject* as_set = static_cast<M_StdSetObject*>(scope[0]);
+    as_set->lock();
+    as_set->clear_entries();
+    if (scope[1]) as_set->update_from(scope[1]);
+    as_set->unlock();
+
     return space->wrap_None();
 }
 
@@ -60,11 +319,16 @@ M_BaseObject* M_StdSetObject::__repr__(mtpython::vm::ThreadContext* context,
 {
     ObjSpace* space = context->get_space();
     M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
+    std::string type_name = space->get_type_name(self);
+
+    if (!as_set->size()) return space->wrap_str(context, type_name + "()");
 
     std::string str = "{";
     int i = 0;
+    std::size_t pos = 0;
+    M_BaseObject* item;
     as_set->lock();
-    for (auto& item : as_set->set) {
+    while (as_set->next_entry(pos, item)) {
         if (i > 0) str += ", ";
         M_BaseObject* repr_item = space->repr(item);
         str += space->unwrap_str(repr_item);
@@ -73,9 +337,18 @@ M_BaseObject* M_StdSetObject::__repr__(mtpython::vm::ThreadContext* context,
     as_set->unlock();
     str += "}";
 
+    if (type_name != "set") str = type_name + "(" + str + ")";
+
     return space->wrap_str(context, str);
 }
 
+M_BaseObject* M_StdSetObject::__len__(mtpython::vm::ThreadContext* context,
+                                      M_BaseObject* self)
+{
+    M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
+    return context->get_space()->wrap_int(context, (int)as_set->size());
+}
+
 M_BaseObject* M_StdSetObject::__contains__(mtpython::vm::ThreadContext* context,
                                            M_BaseObject* self,
                                            M_BaseObject* obj)
@@ -84,34 +357,238 @@ M_BaseObject* M_StdSetObject::__contains__(mtpython::vm::ThreadContext* context,
     M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
 
     as_set->lock();
-    auto got = as_set->set.find(obj);
-    bool result = got != as_set->set.end();
+    bool result = as_set->contains(obj);
     as_set->unlock();
 
     return space->new_bool(result);
 }
 
+M_BaseObject* M_StdSetObject::__iter__(mtpython::vm::ThreadContext* context,
+                                       M_BaseObject* self)
+{
+    M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
+    return new (context) M_StdSetIterObject(as_set);
+}
+
+M_BaseObject* M_StdSetObject::__eq__(mtpython::vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_StdSetObject* self_as_set = static_cast<M_StdSetObject*>(self);
+    M_StdSetObject* other_as_set = dynamic_cast<M_StdSetObject*>(other);
+    if (!other_as_set) return space->wrap_NotImplemented();
+
+    return space->new_bool(self_as_set->size() == other_as_set->size() &&
+                           self_as_set->i_issubset(other_as_set));
+}
+
+M_BaseObject* M_StdSetObject::__ne__(mtpython::vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_BaseObject* eq = __eq__(context, self, other);
+    if (eq == space->wrap_NotImplemented()) return eq;
+
+    return space->new_bool(eq != space->wrap_True());
+}
+
 M_BaseObject* M_StdSetObject::__le__(mtpython::vm::ThreadContext* context,
                                      M_BaseObject* self, M_BaseObject* other)
 {
     ObjSpace* space = context->get_space();
+    M_StdSetObject* self_as_set = static_cast<M_StdSetObject*>(self);
+    M_StdSetObject* other_as_set = dynamic_cast<M_StdSetObject*>(other);
+    if (!other_as_set) return space->wrap_NotImplemented();
+
+    return space->new_bool(self_as_set->i_issubset(other_as_set));
+}
 
+M_BaseObject* M_StdSetObject::__lt__(mtpython::vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_StdSetObject* self_as_set = static_cast<M_StdSetObject*>(self);
     M_StdSetObject* other_as_set = dynamic_cast<M_StdSetObject*>(other);
-    if (!other_as_set) return nullptr;
+    if (!other_as_set) return space->wrap_NotImplemented();
+
+    return space->new_bool(self_as_set->size() < other_as_set->size() &&
+                           self_as_set->i_issubset(other_as_set));
+}
+
+M_BaseObject* M_StdSetObject::__ge__(mtpython::vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
     M_StdSetObject* self_as_set = static_cast<M_StdSetObject*>(self);
+    M_StdSetObject* other_as_set = dynamic_cast<M_StdSetObject*>(other);
+    if (!other_as_set) return space->wrap_NotImplemented();
 
-    if (self_as_set->set.size() > other_as_set->set.size())
-        return space->wrap_False();
-    return space->new_bool(self_as_set->i_issubset(other_as_set));
+    return space->new_bool(other_as_set->i_issubset(self_as_set));
 }
 
-M_BaseObject* M_StdSetObject::__iter__(mtpython::vm::ThreadContext* context,
-                                       M_BaseObject* self)
+M_BaseObject* M_StdSetObject::__gt__(mtpython::vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_StdSetObject* self_as_set = static_cast<M_StdSetObject*>(self);
+    M_StdSetObject* other_as_set = dynamic_cast<M_StdSetObject*>(other);
+    if (!other_as_set) return space->wrap_NotImplemented();
+
+    return space->new_bool(other_as_set->size() < self_as_set->size() &&
+                           other_as_set->i_issubset(self_as_set));
+}
+
+M_BaseObject* M_StdSetObject::union_(mtpython::vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* other)
 {
     M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
-    return new (context) M_StdSetIterObject(as_set);
+    M_StdSetObject* result = as_set->new_empty(context);
+
+    result->copy_from(context, as_set);
+    result->update_from(other);
+
+    return result;
 }
 
+M_BaseObject*
+M_StdSetObject::intersection(mtpython::vm::ThreadContext* context,
+                             M_BaseObject* self, M_BaseObject* other)
+{
+    M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
+    M_StdSetObject* other_as_set = to_set(context, other);
+    M_StdSetObject* result = as_set->new_empty(context);
+
+    /* walk the smaller set and probe the larger one */
+    M_StdSetObject* small = as_set;
+    M_StdSetObject* large = other_as_set;
+    if (small->size() > large->size()) std::swap(small, large);
+    if (!small->slots) return result;
+
+    for (std::size_t i = 0; i < small->slots->size(); i++) {
+        if ((*small->ctrl)[i] & 0x80) continue;
+
+        Slot slot = (*small->slots)[i];
+        if (large->lookup(slot.key, slot.hash) != npos)
+            result->insert_hashed(slot.key, slot.hash);
+    }
+
+    return result;
+}
+
+M_BaseObject* M_StdSetObject::difference(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self,
+                                         M_BaseObject* other)
+{
+    M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
+    M_StdSetObject* other_as_set = to_set(context, other);
+    M_StdSetObject* result = as_set->new_empty(context);
+
+    if (!as_set->slots) return result;
+
+    for (std::size_t i = 0; i < as_set->slots->size(); i++) {
+        if ((*as_set->ctrl)[i] & 0x80) continue;
+
+        Slot slot = (*as_set->slots)[i];
+        if (other_as_set->lookup(slot.key, slot.hash) == npos)
+            result->insert_hashed(slot.key, slot.hash);
+    }
+
+    return result;
+}
+
+M_BaseObject*
+M_StdSetObject::symmetric_difference(mtpython::vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* other)
+{
+    M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
+    M_StdSetObject* result = as_set->new_empty(context);
+
+    result->copy_from(context, as_set);
+    symmetric_difference_update(context, result, other);
+
+    return result;
+}
+
+M_BaseObject* M_StdSetObject::issubset(mtpython::vm::ThreadContext* context,
+                                       M_BaseObject* self, M_BaseObject* other)
+{
+    M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
+    return context->get_space()->new_bool(
+        as_set->i_issubset(to_set(context, other)));
+}
+
+M_BaseObject* M_StdSetObject::issuperset(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self,
+                                         M_BaseObject* other)
+{
+    M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
+    return context->get_space()->new_bool(
+        to_set(context, other)->i_issubset(as_set));
+}
+
+M_BaseObject* M_StdSetObject::isdisjoint(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self,
+                                         M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_StdSetObject* small = static_cast<M_StdSetObject*>(self);
+    M_StdSetObject* large = to_set(context, other);
+    if (small->size() > large->size()) std::swap(small, large);
+    if (!small->slots) return space->wrap_True();
+
+    for (std::size_t i = 0; i < small->slots->size(); i++) {
+        if ((*small->ctrl)[i] & 0x80) continue;
+
+        Slot slot = (*small->slots)[i];
+        if (large->lookup(slot.key, slot.hash) != npos)
+            return space->wrap_False();
+    }
+
+    return space->wrap_True();
+}
+
+M_BaseObject* M_StdSetObject::copy(mtpython::vm::ThreadContext* context,
+                                   M_BaseObject* self)
+{
+    M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
+    M_StdSetObject* result = as_set->new_empty(context);
+
+    result->copy_from(context, as_set);
+
+    return result;
+}
+
+#define SET_BINARY_OPER(name, impl)                                       \
+    M_BaseObject* M_StdSetObject::name(mtpython::vm::ThreadContext* context, \
+                                       M_BaseObject* self,                  \
+                                       M_BaseObject* other)                 \
+    {                                                                      \
+        if (!dynamic_cast<M_StdSetObject*>(other))                         \
+            return context->get_space()->wrap_NotImplemented();            \
+        return impl(context, self, other);                                 \
+    }
+
+SET_BINARY_OPER(__or__, union_)
+SET_BINARY_OPER(__and__, intersection)
+SET_BINARY_OPER(__sub__, difference)
+SET_BINARY_OPER(__xor__, symmetric_difference)
+
+#define SET_INPLACE_OPER(name, impl)                                      \
+    M_BaseObject* M_StdSetObject::name(mtpython::vm::ThreadContext* context, \
+                                       M_BaseObject* self,                  \
+                                       M_BaseObject* other)                 \
+    {                                                                      \
+        if (!dynamic_cast<M_StdSetObject*>(other))                         \
+            return context->get_space()->wrap_NotImplemented();            \
+        impl(context, self, other);                                        \
+        return self;                                                       \
+    }
+
+SET_INPLACE_OPER(__ior__, update)
+SET_INPLACE_OPER(__iand__, intersection_update)
+SET_INPLACE_OPER(__isub__, difference_update)
+SET_INPLACE_OPER(__ixor__, symmetric_difference_update)
+
 Typedef* M_StdSetObject::_set_typedef()
 {
     static Typedef set_typedef(
@@ -123,17 +600,77 @@ Typedef* M_StdSetObject::_set_typedef()
              new InterpFunctionWrapper("__init__", M_StdSetObject::__init__)},
             {"__repr__",
              new InterpFunctionWrapper("__repr__", M_StdSetObject::__repr__)},
+            {"__len__",
+             new InterpFunctionWrapper("__len__", M_StdSetObject::__len__)},
             {"__contains__", new InterpFunctionWrapper(
                                  "__contains__", M_StdSetObject::__contains__)},
-            {"__le__",
-             new InterpFunctionWrapper("__le__", M_StdSetObject::__le__)},
             {"__iter__",
              new InterpFunctionWrapper("__iter__", M_StdSetObject::__iter__)},
+            {"__eq__",
+             new InterpFunctionWrapper("__eq__", M_StdSetObject::__eq__)},
+            {"__ne__",
+             new InterpFunctionWrapper("__ne__", M_StdSetObject::__ne__)},
+            {"__le__",
+             new InterpFunctionWrapper("__le__", M_StdSetObject::__le__)},
+            {"__lt__",
+             new InterpFunctionWrapper("__lt__", M_StdSetObject::__lt__)},
+            {"__ge__",
+             new InterpFunctionWrapper("__ge__", M_StdSetObject::__ge__)},
+            {"__gt__",
+             new InterpFunctionWrapper("__gt__", M_StdSetObject::__gt__)},
+            {"__or__",
+             new InterpFunctionWrapper("__or__", M_StdSetObject::__or__)},
+            {"__and__",
+             new InterpFunctionWrapper("__and__", M_StdSetObject::__and__)},
+            {"__sub__",
+             new InterpFunctionWrapper("__sub__", M_StdSetObject::__sub__)},
+            {"__xor__",
+             new InterpFunctionWrapper("__xor__", M_StdSetObject::__xor__)},
+            {"__ior__",
+             new InterpFunctionWrapper("__ior__", M_StdSetObject::__ior__)},
+            {"__iand__",
+             new InterpFunctionWrapper("__iand__", M_StdSetObject::__iand__)},
+            {"__isub__",
+             new InterpFunctionWrapper("__isub__", M_StdSetObject::__isub__)},
+            {"__ixor__",
+             new InterpFunctionWrapper("__ixor__", M_StdSetObject::__ixor__)},
+            {"union",
+             new InterpFunctionWrapper("union", M_StdSetObject::union_)},
+            {"intersection",
+             new InterpFunctionWrapper("intersection",
+                                       M_StdSetObject::intersection)},
+            {"difference", new InterpFunctionWrapper(
+                               "difference", M_StdSetObject::difference)},
+            {"symmetric_difference",
+             new InterpFunctionWrapper("symmetric_difference",
+                                       M_StdSetObject::symmetric_difference)},
+            {"issubset",
+             new InterpFunctionWrapper("issubset", M_StdSetObject::issubset)},
+            {"issuperset", new InterpFunctionWrapper(
+                               "issuperset", M_StdSetObject::issuperset)},
+            {"isdisjoint", new InterpFunctionWrapper(
+                               "isdisjoint", M_StdSetObject::isdisjoint)},
+            {"copy", new InterpFunctionWrapper("copy", M_StdSetObject::copy)},
             {"add", new InterpFunctionWrapper("add", M_StdSetObject::add)},
             {"remove",
              new InterpFunctionWrapper("remove", M_StdSetObject::remove)},
             {"discard",
              new InterpFunctionWrapper("discard", M_StdSetObject::discard)},
+            {"pop", new InterpFunctionWrapper("pop", M_StdSetObject::pop)},
+            {"clear",
+             new InterpFunctionWrapper("clear", M_StdSetObject::clear)},
+            {"update",
+             new InterpFunctionWrapper("update", M_StdSetObject::update)},
+            {"intersection_update",
+             new InterpFunctionWrapper("intersection_update",
+                                       M_StdSetObject::intersection_update)},
+            {"difference_update",
+             new InterpFunctionWrapper("difference_update",
+                                       M_StdSetObject::difference_update)},
+            {"symmetric_difference_update",
+             new InterpFunctionWrapper(
+                 "symmetric_difference_update",
+                 M_StdSetObject::symmetric_difference_update)},
         });
 
     return &set_typedef;
@@ -147,7 +684,7 @@ M_BaseObject* M_StdSetObject::add(mtpython::vm::ThreadContext* context,
     M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
 
     as_set->lock();
-    as_set->set.insert(item);
+    as_set->insert(item);
     as_set->unlock();
 
     return context->get_space()->wrap_None();
@@ -166,6 +703,237 @@ M_BaseObject* M_StdSetObject::remove(mtpython::vm::ThreadContext* context,
     return nullptr;
 }
 
+M_BaseObject* M_StdSetObject::discard(mtpython::vm::ThreadContext* context,
+                                      M_BaseObject* self, M_BaseObject* item)
+{
+    (static_cast<M_StdSetObject*>(self))->_discard(context, item);
+
+    return nullptr;
+}
+
+M_BaseObject* M_StdSetObject::pop(mtpython::vm::ThreadContext* context,
+                                  M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
+    ScopedObjectLock lock(as_set);
+
+    std::size_t pos = 0;
+    M_BaseObject* item;
+    if (!as_set->next_entry(pos, item))
+        throw InterpError(space->KeyError_type(),
+                          space->wrap_str(context, "pop from an empty set"));
+
+    as_set->erase_slot(pos - 1);
+    return item;
+}
+
+M_BaseObject* M_StdSetObject::clear(mtpython::vm::ThreadContext* context,
+                                    M_BaseObject* self)
+{
+    M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
+
+    as_set->lock();
+    as_set->clear_entries();
+    as_set->unlock();
+
+    return nullptr;
+}
+
+M_BaseObject* M_StdSetObject::update(mtpython::vm::ThreadContext* context,
+                                     M_BaseObject* self, M_BaseObject* other)
+{
+    M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
+
+    as_set->lock();
+    as_set->update_from(other);
+    as_set->unlock();
+
+    return nullptr;
+}
+
+M_BaseObject*
+M_StdSetObject::intersection_update(mtpython::vm::ThreadContext* context,
+                                    M_BaseObject* self, M_BaseObject* other)
+{
+    M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
+    M_StdSetObject* result =
+        static_cast<M_StdSetObject*>(intersection(context, self, other));
+
+    /* take over the table of the result */
+    as_set->lock();
+    as_set->ctrl = result->ctrl;
+    as_set->slots = result->slots;
+    as_set->used = result->used;
+    as_set->fill = result->fill;
+    as_set->unlock();
+
+    return nullptr;
+}
+
+M_BaseObject*
+M_StdSetObject::difference_update(mtpython::vm::ThreadContext* context,
+                                  M_BaseObject* self, M_BaseObject* other)
+{
+    M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
+    M_StdSetObject* other_as_set = to_set(context, other);
+    ScopedObjectLock lock(as_set);
+
+    if (other_as_set == as_set) {
+        as_set->clear_entries();
+        return nullptr;
+    }
+    if (!other_as_set->slots) return nullptr;
+
+    for (std::size_t i = 0; i < other_as_set->slots->size(); i++) {
+        if ((*other_as_set->ctrl)[i] & 0x80) continue;
+
+        Slot slot = (*other_as_set->slots)[i];
+        std::size_t j = as_set->lookup(slot.key, slot.hash);
+        if (j != npos) as_set->erase_slot(j);
+    }
+
+    return nullptr;
+}
+
+M_BaseObject* M_StdSetObject::symmetric_difference_update(
+    mtpython::vm::ThreadContext* context, M_BaseObject* self,
+    M_BaseObject* other)
+{
+    M_StdSetObject* as_set = static_cast<M_StdSetObject*>(self);
+    M_StdSetObject* other_as_set = to_set(context, other);
+    ScopedObjectLock lock(as_set);
+
+    if (other_as_set == as_set) {
+        as_set->clear_entries();
+        return nullptr;
+    }
+    if (!other_as_set->slots) return nullptr;
+
+    for (std::size_t i = 0; i < other_as_set->slots->size(); i++) {
+        if ((*other_as_set->ctrl)[i] & 0x80) continue;
+
+        Slot slot = (*other_as_set->slots)[i];
+        std::size_t j = as_set->lookup(slot.key, slot.hash);
+        if (j != npos)
+            as_set->erase_slot(j);
+        else
+            as_set->insert_hashed(slot.key, slot.hash);
+    }
+
+    return nullptr;
+}
+
+/*
+ * frozenset
+ */
+M_BaseObject*
+M_StdFrozenSetObject::__new__(mtpython::vm::ThreadContext* context,
+                              const Arguments& args)
+{
+    static Signature new_signature({"type", "iterable"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("frozenset", nullptr, new_signature, scope, {nullptr});
+
+    M_BaseObject* iterable = scope[1];
+    if (iterable && typeid(*iterable) == typeid(M_StdFrozenSetObject))
+        return iterable;
+
+    M_StdFrozenSetObject* instance = new (context) M_StdFrozenSetObject(space);
+    if (iterable) instance->update_from(iterable);
+
+    return space->wrap(context, instance);
+}
+
+/* Order independent hash of the element hashes, following CPython */
+M_BaseObject*
+M_StdFrozenSetObject::__hash__(mtpython::vm::ThreadContext* context,
+                               M_BaseObject* self)
+{
+    M_StdFrozenSetObject* as_set = static_cast<M_StdFrozenSetObject*>(self);
+    std::size_t hash = 0;
+
+    std::size_t n = as_set->slots ? as_set->slots->size() : 0;
+    for (std::size_t i = 0; i < n; i++) {
+        if ((*as_set->ctrl)[i] & 0x80) continue;
+
+        std::size_t h = (*as_set->slots)[i].hash;
+        hash ^= ((h ^ 89869747UL) ^ (h << 16)) * 3644798167UL;
+    }
+
+    hash ^= (as_set->used + 1) * 1927868237UL;
+    hash ^= (hash >> 11) ^ (hash >> 25);
+    hash = hash * 69069U + 907133923UL;
+
+    return context->get_space()->wrap_int(context, (int)hash);
+}
+
+Typedef* M_StdFrozenSetObject::_frozenset_typedef()
+{
+    static Typedef frozenset_typedef(
+        "frozenset",
+        {
+            {"__new__", new InterpFunctionWrapper(
+                            "__new__", M_StdFrozenSetObject::__new__)},
+            {"__repr__",
+             new InterpFunctionWrapper("__repr__", M_StdSetObject::__repr__)},
+            {"__hash__", new InterpFunctionWrapper(
+                             "__hash__", M_StdFrozenSetObject::__hash__)},
+            {"__len__",
+             new InterpFunctionWrapper("__len__", M_StdSetObject::__len__)},
+            {"__contains__", new InterpFunctionWrapper(
+                                 "__contains__", M_StdSetObject::__contains__)},
+            {"__iter__",
+             new InterpFunctionWrapper("__iter__", M_StdSetObject::__iter__)},
+            {"__eq__",
+             new InterpFunctionWrapper("__eq__", M_StdSetObject::__eq__)},
+            {"__ne__",
+             new InterpFunctionWrapper("__ne__", M_StdSetObject::__ne__)},
+            {"__le__",
+             new InterpFunctionWrapper("__le__", M_StdSetObject::__le__)},
+            {"__lt__",
+             new InterpFunctionWrapper("__lt__", M_StdSetObject::__lt__)},
+            {"__ge__",
+             new InterpFunctionWrapper("__ge__", M_StdSetObject::__ge__)},
+            {"__gt__",
+             new InterpFunctionWrapper("__gt__", M_StdSetObject::__gt__)},
+            {"__or__",
+             new InterpFunctionWrapper("__or__", M_StdSetObject::__or__)},
+            {"__and__",
+             new InterpFunctionWrapper("__and__", M_StdSetObject::__and__)},
+            {"__sub__",
+             new InterpFunctionWrapper("__sub__", M_StdSetObject::__sub__)},
+            {"__xor__",
+             new InterpFunctionWrapper("__xor__", M_StdSetObject::__xor__)},
+            {"union",
+             new InterpFunctionWrapper("union", M_StdSetObject::union_)},
+            {"intersection",
+             new InterpFunctionWrapper("intersection",
+                                       M_StdSetObject::intersection)},
+            {"difference", new InterpFunctionWrapper(
+                               "difference", M_StdSetObject::difference)},
+            {"symmetric_difference",
+             new InterpFunctionWrapper("symmetric_difference",
+                                       M_StdSetObject::symmetric_difference)},
+            {"issubset",
+             new InterpFunctionWrapper("issubset", M_StdSetObject::issubset)},
+            {"issuperset", new InterpFunctionWrapper(
+                               "issuperset", M_StdSetObject::issuperset)},
+            {"isdisjoint", new InterpFunctionWrapper(
+                               "isdisjoint", M_StdSetObject::isdisjoint)},
+            {"copy", new InterpFunctionWrapper("copy", M_StdSetObject::copy)},
+        });
+
+    return &frozenset_typedef;
+}
+
+Typedef* M_StdFrozenSetObject::get_typedef() { return _frozenset_typedef(); }
+
+/*
+ * set iterator
+ */
 static Typedef set_iterator_typedef(
     "set_iterator",
     {
@@ -174,14 +942,8 @@ static Typedef set_iterator_typedef(
     });
 
 M_StdSetIterObject::M_StdSetIterObject(M_StdSetObject* set)
-{
-    this->set = set;
-    set->lock();
-    size = set->size();
-    iter = set->begin();
-    index = size == 0 ? -1 : 0;
-    set->unlock();
-}
+    : set(set), pos(0), size(set->size())
+{}
 
 M_BaseObject* M_StdSetIterObject::__next__(mtpython::vm::ThreadContext* context,
                                            M_BaseObject* self)
@@ -189,7 +951,7 @@ M_BaseObject* M_StdSetIterObject::__next__(mtpython::vm::ThreadContext* context,
     ObjSpace* space = context->get_space();
     M_StdSetIterObject* iter = static_cast<M_StdSetIterObject*>(self);
 
-    if (iter->index < 0)
+    if (!iter->set)
         throw InterpError(space->StopIteration_type(), space->wrap_None());
     iter->set->lock();
 
@@ -200,25 +962,16 @@ M_BaseObject* M_StdSetIterObject::__next__(mtpython::vm::ThreadContext* context,
             space->wrap_str(context, "Set changed size during iteration"));
     }
 
-    M_BaseObject* item = *(iter->iter);
-
-    iter->iter++;
-    iter->index++;
+    M_BaseObject* item;
+    bool found = iter->set->next_entry(iter->pos, item);
+    iter->set->unlock();
 
-    if (iter->index == iter->size) {
-        iter->index = -1;
+    if (!found) {
+        iter->set = nullptr;
+        throw InterpError(space->StopIteration_type(), space->wrap_None());
     }
-    iter->set->unlock();
 
     return item;
 }
 
 Typedef* M_StdSetIterObject::get_typedef() { return &set_iterator_typedef; }
-
-M_BaseObject* M_StdSetObject::discard(mtpython::vm::ThreadContext* context,
-                                      M_BaseObject* self, M_BaseObject* item)
-{
-    (static_cast<M_StdSetObject*>(self))->_discard(context, item);
-
-    return nullptr;
-}
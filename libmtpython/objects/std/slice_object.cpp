@@ -0,0 +1,171 @@
+#include <string>
+
+#include "interpreter/typedef.h"
+#include "interpreter/error.h"
+#include "interpreter/gateway.h"
+#include "interpreter/descriptor.h"
+#include "objects/std/slice_object.h"
+
+using namespace mtpython::objects;
+using namespace mtpython::interpreter;
+
+mtpython::interpreter::Typedef* M_StdSliceObject::_slice_typedef()
+{
+    static mtpython::interpreter::Typedef slice_typedef(
+        "slice",
+        {
+            {"__new__",
+             new InterpFunctionWrapper("__new__", M_StdSliceObject::__new__)},
+            {"__repr__",
+             new InterpFunctionWrapper("__repr__", M_StdSliceObject::__repr__)},
+            {"indices",
+             new InterpFunctionWrapper("indices", M_StdSliceObject::indices)},
+            {"start", new GetSetDescriptor(M_StdSliceObject::start_get)},
+            {"stop", new GetSetDescriptor(M_StdSliceObject::stop_get)},
+            {"step", new GetSetDescriptor(M_StdSliceObject::step_get)},
+        });
+
+    return &slice_typedef;
+}
+
+mtpython::interpreter::Typedef* M_StdSliceObject::get_typedef()
+{
+    return _slice_typedef();
+}
+
+static long slice_index(ObjSpace* space, M_BaseObject* obj)
+{
+    return space->i_get_index(
+        obj, space->TypeError_type(),
+        space->wrap_str(mtpython::vm::ThreadContext::current_thread(),
+                        "slice indices must be integers or None or have an "
+                        "__index__ method"));
+}
+
+std::size_t M_StdSliceObject::unpack_indices(ObjSpace* space,
+                                             std::size_t length,
+                                             long& start, long& stop,
+                                             long& step)
+{
+    M_BaseObject* none = space->wrap_None();
+
+    step = 1;
+    if (this->step != none) {
+        step = slice_index(space, this->step);
+        if (step == 0)
+            throw InterpError(
+                space->ValueError_type(),
+                space->wrap_str(vm::ThreadContext::current_thread(),
+                                "slice step cannot be zero"));
+    }
+
+    long len = (long)length;
+    long lower = step < 0 ? -1 : 0;
+    long upper = step < 0 ? len - 1 : len;
+
+    auto clamp = [lower, upper, len](long i) {
+        if (i < 0) {
+            i += len;
+            return i < lower ? lower : i;
+        }
+        return i > upper ? upper : i;
+    };
+
+    if (this->start == none)
+        start = step < 0 ? upper : lower;
+    else
+        start = clamp(slice_index(space, this->start));
+
+    if (this->stop == none)
+        stop = step < 0 ? lower : upper;
+    else
+        stop = clamp(slice_index(space, this->stop));
+
+    if (step < 0) {
+        if (stop < start) return (start - stop - 1) / (-step) + 1;
+    } else {
+        if (start < stop) return (stop - start - 1) / step + 1;
+    }
+
+    return 0;
+}
+
+M_BaseObject* M_StdSliceObject::__new__(mtpython::vm::ThreadContext* context,
+                                        const Arguments& args)
+{
+    static Signature new_signature({"type", "start", "stop", "step"});
+
+    ObjSpace* space = context->get_space();
+    std::vector<M_BaseObject*> scope;
+    args.parse("slice", nullptr, new_signature, scope,
+               {nullptr, space->wrap_None()});
+
+    M_BaseObject* start = scope[1];
+    M_BaseObject* stop = scope[2];
+
+    /* slice(stop) */
+    if (!stop) {
+        stop = start;
+        start = space->wrap_None();
+    }
+
+    return space->new_slice(context, start, stop, scope[3]);
+}
+
+M_BaseObject* M_StdSliceObject::__repr__(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_StdSliceObject* as_slice = static_cast<M_StdSliceObject*>(self);
+
+    std::string str = "slice(";
+    str += space->unwrap_str(space->repr(as_slice->start));
+    str += ", ";
+    str += space->unwrap_str(space->repr(as_slice->stop));
+    str += ", ";
+    str += space->unwrap_str(space->repr(as_slice->step));
+    str += ")";
+
+    return space->wrap_str(context, str);
+}
+
+M_BaseObject* M_StdSliceObject::indices(mtpython::vm::ThreadContext* context,
+                                        M_BaseObject* self,
+                                        M_BaseObject* length)
+{
+    ObjSpace* space = context->get_space();
+    M_StdSliceObject* as_slice = static_cast<M_StdSliceObject*>(self);
+
+    int len = space->i_get_index(
+        length, space->TypeError_type(),
+        space->wrap_str(context, "length must be an integer"));
+    if (len < 0)
+        throw InterpError(space->ValueError_type(),
+                          space->wrap_str(context, "length should not be "
+                                                   "negative"));
+
+    long start, stop, step;
+    as_slice->unpack_indices(space, len, start, stop, step);
+
+    return space->new_tuple(context, {space->wrap_int(context, (int)start),
+                                      space->wrap_int(context, (int)stop),
+                                      space->wrap_int(context, (int)step)});
+}
+
+M_BaseObject* M_StdSliceObject::start_get(mtpython::vm::ThreadContext* context,
+                                          M_BaseObject* self)
+{
+    return static_cast<M_StdSliceObject*>(self)->start;
+}
+
+M_BaseObject* M_StdSliceObject::stop_get(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self)
+{
+    return static_cast<M_StdSliceObject*>(self)->stop;
+}
+
+M_BaseObject* M_StdSliceObject::step_get(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self)
+{
+    return static_cast<M_StdSliceObject*>(self)->step;
+}
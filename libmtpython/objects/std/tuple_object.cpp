@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <assert.h>
@@ -7,10 +8,26 @@
 #include "interpreter/gateway.h"
 #include "objects/std/tuple_object.h"
 #include "objects/std/iter_object.h"
+#include "objects/std/slice_object.h"
 
 using namespace mtpython::objects;
 using namespace mtpython::interpreter;
 
+void* M_StdTupleObject::operator new(std::size_t size,
+                                     mtpython::vm::ThreadContext* context,
+                                     std::size_t count)
+{
+    /* the items are GC references, there is nothing to finalize */
+    return context->get_gc()->allocate(size + count * sizeof(M_BaseObject*),
+                                       false);
+}
+
+M_StdTupleObject* M_StdTupleObject::create(mtpython::vm::ThreadContext* context,
+                                           std::size_t count)
+{
+    return new (context, count) M_StdTupleObject(count);
+}
+
 mtpython::interpreter::Typedef* M_StdTupleObject::_tuple_typedef()
 {
     static mtpython::interpreter::Typedef tuple_typedef(
@@ -18,6 +35,12 @@ mtpython::interpreter::Typedef* M_StdTupleObject::_tuple_typedef()
         {
             {"__repr__",
              new InterpFunctionWrapper("__repr__", M_StdTupleObject::__repr__)},
+            {"__hash__",
+             new InterpFunctionWrapper("__hash__", M_StdTupleObject::__hash__)},
+            {"__eq__",
+             new InterpFunctionWrapper("__eq__", M_StdTupleObject::__eq__)},
+            {"__ne__",
+             new InterpFunctionWrapper("__ne__", M_StdTupleObject::__ne__)},
             {"__iter__",
              new InterpFunctionWrapper("__iter__", M_StdTupleObject::__iter__)},
             {"__len__",
@@ -44,7 +67,7 @@ M_BaseObject* M_StdTupleObject::__iter__(mtpython::vm::ThreadContext* context,
     M_StdTupleObject* as_tuple = M_STDTUPLEOBJECT(self);
     assert(as_tuple);
 
-    return new (context) M_StdTupleIterObject(as_tuple->items);
+    return new (context) M_StdTupleIterObject(as_tuple);
 }
 
 M_BaseObject* M_StdTupleObject::__len__(mtpython::vm::ThreadContext* context,
@@ -54,7 +77,7 @@ M_BaseObject* M_StdTupleObject::__len__(mtpython::vm::ThreadContext* context,
     M_StdTupleObject* as_tuple = M_STDTUPLEOBJECT(self);
     assert(as_tuple);
 
-    return space->wrap_int(context, as_tuple->items.size());
+    return space->wrap_int(context, (int)as_tuple->count);
 }
 
 M_BaseObject* M_StdTupleObject::__repr__(mtpython::vm::ThreadContext* context,
@@ -65,21 +88,98 @@ M_BaseObject* M_StdTupleObject::__repr__(mtpython::vm::ThreadContext* context,
     assert(as_tuple);
 
     std::string str = "(";
-    for (std::size_t i = 0; i < as_tuple->items.size(); i++) {
+    for (std::size_t i = 0; i < as_tuple->count; i++) {
         if (i > 0) str += ", ";
-        M_BaseObject* repr_item = space->repr(as_tuple->items[i]);
+        M_BaseObject* repr_item = space->repr((*as_tuple)[i]);
         str += space->unwrap_str(repr_item);
     }
+    if (as_tuple->count == 1) str += ",";
     str += ")";
 
     return space->wrap_str(context, str);
 }
 
+M_BaseObject* M_StdTupleObject::__hash__(mtpython::vm::ThreadContext* context,
+                                         M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_StdTupleObject* as_tuple = M_STDTUPLEOBJECT(self);
+
+    /* tuplehash() of CPython */
+    std::uint32_t x = 0x345678;
+    std::uint32_t mult = 1000003;
+    std::uint32_t len = (std::uint32_t)as_tuple->count;
+    for (auto item : *as_tuple) {
+        std::uint32_t y = (std::uint32_t)space->i_hash(item);
+        x = (x ^ y) * mult;
+        mult += 82520 + len + len;
+        len--;
+    }
+    x += 97531;
+
+    return space->wrap_int(context, (int)x);
+}
+
+static bool tuple_equal(ObjSpace* space, M_StdTupleObject* lhs,
+                        M_StdTupleObject* rhs)
+{
+    if (lhs->size() != rhs->size()) return false;
+
+    for (std::size_t i = 0; i < lhs->size(); i++) {
+        M_BaseObject* x = (*lhs)[i];
+        M_BaseObject* y = (*rhs)[i];
+        if (x != y && !space->i_eq(x, y)) return false;
+    }
+
+    return true;
+}
+
+M_BaseObject* M_StdTupleObject::__eq__(mtpython::vm::ThreadContext* context,
+                                       M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_StdTupleObject* other_tuple = dynamic_cast<M_StdTupleObject*>(other);
+
+    if (!other_tuple) return space->wrap_NotImplemented();
+
+    return space->new_bool(
+        tuple_equal(space, M_STDTUPLEOBJECT(self), other_tuple));
+}
+
+M_BaseObject* M_StdTupleObject::__ne__(mtpython::vm::ThreadContext* context,
+                                       M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_StdTupleObject* other_tuple = dynamic_cast<M_StdTupleObject*>(other);
+
+    if (!other_tuple) return space->wrap_NotImplemented();
+
+    return space->new_bool(
+        !tuple_equal(space, M_STDTUPLEOBJECT(self), other_tuple));
+}
+
 M_BaseObject*
 M_StdTupleObject::__getitem__(mtpython::vm::ThreadContext* context,
                               M_BaseObject* obj, M_BaseObject* key)
 {
     ObjSpace* space = context->get_space();
+    M_StdTupleObject* as_tuple = static_cast<M_StdTupleObject*>(obj);
+
+    M_StdSliceObject* slice = dynamic_cast<M_StdSliceObject*>(key);
+    if (slice) {
+        long start, stop, step;
+        std::size_t n =
+            slice->unpack_indices(space, as_tuple->count, start, stop, step);
+        if (n == as_tuple->count && step == 1) return obj;
+
+        M_BaseObject* result = space->new_tuple(context, n);
+        M_BaseObject** items = space->tuple_items(result);
+        for (std::size_t i = 0; i < n; i++, start += step)
+            items[i] = (*as_tuple)[start];
+
+        return result;
+    }
+
     int index;
     try {
         index = space->unwrap_int(key, false);
@@ -90,19 +190,18 @@ M_StdTupleObject::__getitem__(mtpython::vm::ThreadContext* context,
     };
 
     M_BaseObject* item = nullptr;
-    M_StdTupleObject* as_tuple = static_cast<M_StdTupleObject*>(obj);
     if (index < 0) {
-        if (index < -(int)(as_tuple->items.size()))
+        if (index < -(int)(as_tuple->count))
             throw InterpError(
                 space->IndexError_type(),
                 space->wrap_str(context, "tuple index out of range"));
-        item = as_tuple->items[as_tuple->items.size() + index];
+        item = (*as_tuple)[as_tuple->count + index];
     } else {
-        if (index >= (int)as_tuple->items.size())
+        if (index >= (int)as_tuple->count)
             throw InterpError(
                 space->IndexError_type(),
                 space->wrap_str(context, "tuple index out of range"));
-        item = as_tuple->items[index];
+        item = (*as_tuple)[index];
     }
 
     return item;
@@ -114,7 +213,7 @@ M_StdTupleObject::__contains__(mtpython::vm::ThreadContext* context,
 {
     ObjSpace* space = context->get_space();
     M_StdTupleObject* as_tuple = static_cast<M_StdTupleObject*>(self);
-    for (auto item : as_tuple->items) {
+    for (auto item : *as_tuple) {
         if (space->i_eq(item, obj)) {
             return space->wrap_True();
         }
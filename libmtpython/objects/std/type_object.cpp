@@ -1,8 +1,10 @@
+#include <algorithm>
 #include <list>
 
 #include "objects/std/type_object.h"
 #include "objects/std/object_object.h"
 #include "interpreter/gateway.h"
+#include "interpreter/function.h"
 #include "interpreter/descriptor.h"
 #include "interpreter/error.h"
 
@@ -17,7 +19,15 @@ M_StdTypeObject::M_StdTypeObject(
 {
     _has_dict = false;
     wrapped_dict = nullptr;
+    handle = std::make_shared<M_StdTypeObject*>(this);
     init_mro();
+
+    for (auto base : bases) {
+        M_StdTypeObject* base_type = dynamic_cast<M_StdTypeObject*>(base);
+        if (base_type) base_type->add_subclass(this);
+    }
+
+    update_slots();
 }
 
 mtpython::interpreter::Typedef* M_StdTypeObject::get_typedef()
@@ -119,13 +129,174 @@ M_BaseObject* M_StdTypeObject::get_dict_value(ObjSpace* space,
     return got->second;
 }
 
+static inline bool is_special_name(const std::string& name)
+{
+    return name.size() > 4 && name[0] == '_' && name[1] == '_' &&
+           name[name.size() - 1] == '_' && name[name.size() - 2] == '_';
+}
+
 bool M_StdTypeObject::set_dict_value(ObjSpace* space, const std::string& attr,
                                      M_BaseObject* value)
 {
     dict[attr] = value;
+    if (is_special_name(attr)) update_slots();
     return true;
 }
 
+bool M_StdTypeObject::del_dict_value(ObjSpace* space, const std::string& attr)
+{
+    if (!dict.erase(attr)) return false;
+    if (is_special_name(attr)) update_slots();
+    return true;
+}
+
+/* Trampolines for dunders that are not backed by a native function of the
+ * expected arity, e.g. methods defined in a Python class */
+#define DEF_UNARY_TRAMPOLINE(slot, name)                                   \
+    static M_BaseObject* slot_##slot(mtpython::vm::ThreadContext* context, \
+                                     M_BaseObject* self)                   \
+    {                                                                      \
+        ObjSpace* space = context->get_space();                            \
+        return space->get_and_call_function(                               \
+            context, space->lookup(self, #name), {self});                  \
+    }
+
+#define DEF_BINARY_TRAMPOLINE(slot, name)                                  \
+    static M_BaseObject* slot_##slot(mtpython::vm::ThreadContext* context, \
+                                     M_BaseObject* self,                   \
+                                     M_BaseObject* other)                  \
+    {                                                                      \
+        ObjSpace* space = context->get_space();                            \
+        return space->get_and_call_function(                               \
+            context, space->lookup(self, #name), {self, other});           \
+    }
+
+#define DEF_TERNARY_TRAMPOLINE(slot, name)                                   \
+    static M_BaseObject* slot_##slot(mtpython::vm::ThreadContext* context,   \
+                                     M_BaseObject* self, M_BaseObject* arg1, \
+                                     M_BaseObject* arg2)                     \
+    {                                                                        \
+        ObjSpace* space = context->get_space();                              \
+        return space->get_and_call_function(                                 \
+            context, space->lookup(self, #name), {self, arg1, arg2});        \
+    }
+
+#define UNARY_SLOTS(X)    \
+    X(pos, __pos__)       \
+    X(neg, __neg__)       \
+    X(invert, __invert__) \
+    X(abs, __abs__)       \
+    X(hash, __hash__)     \
+    X(bool_, __bool__)    \
+    X(len, __len__)       \
+    X(str, __str__)       \
+    X(repr, __repr__)     \
+    X(iter, __iter__)     \
+    X(next, __next__)
+
+#define BINARY_SLOTS(X)                \
+    X(add, __add__)                    \
+    X(sub, __sub__)                    \
+    X(mul, __mul__)                    \
+    X(truediv, __truediv__)            \
+    X(floordiv, __floordiv__)          \
+    X(mod, __mod__)                    \
+    X(lshift, __lshift__)              \
+    X(rshift, __rshift__)              \
+    X(and_, __and__)                   \
+    X(or_, __or__)                     \
+    X(xor_, __xor__)                   \
+    X(pow, __pow__)                    \
+    X(radd, __radd__)                  \
+    X(rsub, __rsub__)                  \
+    X(rmul, __rmul__)                  \
+    X(rtruediv, __rtruediv__)          \
+    X(rfloordiv, __rfloordiv__)        \
+    X(rmod, __rmod__)                  \
+    X(rlshift, __rlshift__)            \
+    X(rrshift, __rrshift__)            \
+    X(rand, __rand__)                  \
+    X(ror, __ror__)                    \
+    X(rxor, __rxor__)                  \
+    X(rpow, __rpow__)                  \
+    X(inplace_add, __iadd__)           \
+    X(inplace_sub, __isub__)           \
+    X(inplace_mul, __imul__)           \
+    X(inplace_truediv, __itruediv__)   \
+    X(inplace_floordiv, __ifloordiv__) \
+    X(inplace_mod, __imod__)           \
+    X(inplace_lshift, __ilshift__)     \
+    X(inplace_rshift, __irshift__)     \
+    X(inplace_and, __iand__)           \
+    X(inplace_or, __ior__)             \
+    X(inplace_xor, __ixor__)           \
+    X(inplace_pow, __ipow__)           \
+    X(eq, __eq__)                      \
+    X(ne, __ne__)                      \
+    X(lt, __lt__)                      \
+    X(le, __le__)                      \
+    X(gt, __gt__)                      \
+    X(ge, __ge__)                      \
+    X(contains, __contains__)          \
+    X(getitem, __getitem__)            \
+    X(delitem, __delitem__)
+
+#define TERNARY_SLOTS(X) X(setitem, __setitem__)
+
+UNARY_SLOTS(DEF_UNARY_TRAMPOLINE)
+BINARY_SLOTS(DEF_BINARY_TRAMPOLINE)
+TERNARY_SLOTS(DEF_TERNARY_TRAMPOLINE)
+
+template <typename SlotType> struct SlotDef {
+    const char* name;
+    SlotType TypeSlots::*slot;
+    SlotType trampoline;
+};
+
+#define DEF_SLOT_ENTRY(slot, name) {#name, &TypeSlots::slot, slot_##slot},
+
+static const SlotDef<UnarySlot> unary_slot_defs[] = {
+    UNARY_SLOTS(DEF_SLOT_ENTRY)};
+static const SlotDef<BinarySlot> binary_slot_defs[] = {
+    BINARY_SLOTS(DEF_SLOT_ENTRY)};
+static const SlotDef<TernarySlot> ternary_slot_defs[] = {
+    TERNARY_SLOTS(DEF_SLOT_ENTRY)};
+
+/* Use the native function directly if the dunder is a builtin function with
+ * the same arity as the slot */
+template <typename CodeType, typename SlotType>
+static SlotType resolve_slot(M_BaseObject* impl, SlotType trampoline)
+{
+    if (!impl) return nullptr;
+
+    Function* func = dynamic_cast<Function*>(impl);
+    if (func) {
+        CodeType* code = dynamic_cast<CodeType*>(func->get_code());
+        if (code) return code->get_func();
+    }
+
+    return trampoline;
+}
+
+void M_StdTypeObject::update_slots()
+{
+    for (const auto& def : unary_slot_defs)
+        slots.*def.slot =
+            resolve_slot<BuiltinCode1>(lookup(def.name), def.trampoline);
+    for (const auto& def : binary_slot_defs)
+        slots.*def.slot =
+            resolve_slot<BuiltinCode2>(lookup(def.name), def.trampoline);
+    for (const auto& def : ternary_slot_defs)
+        slots.*def.slot =
+            resolve_slot<BuiltinCode3>(lookup(def.name), def.trampoline);
+
+    /* subclasses inherit the slots through their MRO */
+    for (const auto& ref : subclasses) {
+        auto sub = ref.lock();
+        if (sub) (*sub)->update_slots();
+    }
+}
+
 M_BaseObject* M_StdTypeObject::lookup(const std::string& name)
 {
     for (auto base : mro) {
@@ -226,8 +397,6 @@ void M_StdTypeObject::mark_children(gc::GarbageCollector* gc)
 
     for (const auto& obj : mro)
         gc->mark_object(obj);
-    for (const auto& obj : subclasses)
-        gc->mark_object(obj);
     gc->mark_object(cls);
 }
 
@@ -377,19 +546,34 @@ M_StdTypeObject::__getattribute__(mtpython::vm::ThreadContext* context,
 
 void M_StdTypeObject::add_subclass(M_BaseObject* cls)
 {
-    /* TODO: use weak ref */
-    for (auto p : subclasses) {
-        if (p == cls) {
+    M_StdTypeObject* sub = static_cast<M_StdTypeObject*>(cls);
+
+    /* forget the subclasses that have been collected */
+    subclasses.erase(std::remove_if(subclasses.begin(), subclasses.end(),
+                                    [](const auto& ref) {
+                                        return ref.expired();
+                                    }),
+                     subclasses.end());
+
+    for (const auto& ref : subclasses) {
+        if (ref.lock() == sub->handle) {
             return;
         }
     }
 
-    subclasses.push_back(cls);
+    subclasses.push_back(sub->handle);
 }
 
-const std::vector<M_BaseObject*>& M_StdTypeObject::get_subclasses()
+std::vector<M_BaseObject*> M_StdTypeObject::get_subclasses()
 {
-    return subclasses;
+    std::vector<M_BaseObject*> live;
+
+    for (const auto& ref : subclasses) {
+        auto sub = ref.lock();
+        if (sub) live.push_back(*sub);
+    }
+
+    return live;
 }
 
 M_BaseObject*
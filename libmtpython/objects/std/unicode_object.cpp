@@ -2,16 +2,325 @@
 #include <iostream>
 #include <unordered_map>
 #include <functional>
+#include <cctype>
+#include <cstring>
+#include <algorithm>
 #include <assert.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "interpreter/typedef.h"
 #include "interpreter/gateway.h"
+#include "interpreter/error.h"
 #include "objects/std/unicode_object.h"
+#include "objects/std/tuple_object.h"
+#include "objects/std/bytes_object.h"
+#include "objects/std/slice_object.h"
+#include "utils/hash_helper.h"
+#include "utils/string_helper.h"
 
 using namespace mtpython::objects;
 using namespace mtpython::interpreter;
+using mtpython::StringHelper;
+
+/* Number of leading ASCII bytes in s */
+static std::size_t ascii_prefix(const unsigned char* s, std::size_t len)
+{
+    std::size_t i = 0;
+
+#ifdef __SSE2__
+    for (; i + 16 <= len; i += 16) {
+        __m128i chunk =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        int mask = _mm_movemask_epi8(chunk);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+#else
+    for (; i + 8 <= len; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, s + i, sizeof(word));
+        if (word & 0x8080808080808080ULL) break;
+    }
+#endif
+
+    while (i < len && s[i] < 0x80)
+        i++;
+    return i;
+}
+
+/* Length of the well-formed UTF-8 sequence starting at s, or 0 if it is
+ * malformed: stray continuation bytes, overlong forms, truncated sequences
+ * and code points above 0x10ffff. Surrogates are accepted because str holds
+ * lone surrogates (from chr() or escapes) as three byte sequences. */
+static std::size_t utf8_seq_length(const unsigned char* s, std::size_t avail)
+{
+    unsigned char lead = s[0];
+    unsigned char lo = 0x80, hi = 0xbf; /* range of the second byte */
+    std::size_t n;
+
+    if (lead < 0x80) return 1;
+    if (lead < 0xc2) return 0;
+
+    if (lead < 0xe0) {
+        n = 2;
+    } else if (lead < 0xf0) {
+        n = 3;
+        if (lead == 0xe0) lo = 0xa0;
+    } else if (lead < 0xf5) {
+        n = 4;
+        if (lead == 0xf0) lo = 0x90;
+        if (lead == 0xf4) hi = 0x8f;
+    } else {
+        return 0;
+    }
+
+    if (n > avail) return 0;
+    if (s[1] < lo || s[1] > hi) return 0;
+    for (std::size_t i = 2; i < n; i++) {
+        if ((s[i] & 0xc0) != 0x80) return 0;
+    }
+
+    return n;
+}
+
+/* Sequence length given by the lead byte of a validated string */
+static inline std::size_t utf8_lead_length(unsigned char lead)
+{
+    if (lead < 0x80) return 1;
+    if (lead < 0xe0) return 2;
+    return lead < 0xf0 ? 3 : 4;
+}
+
+/* Offset of the first malformed sequence at or after pos, or len if the rest
+ * of s is valid. ASCII runs are skipped with ascii_prefix() */
+static std::size_t utf8_validate(const unsigned char* s, std::size_t pos,
+                                 std::size_t len)
+{
+    while (pos < len) {
+        if (s[pos] < 0x80) {
+            pos += ascii_prefix(s + pos, len - pos);
+            continue;
+        }
+
+        std::size_t n = utf8_seq_length(s + pos, len - pos);
+        if (!n) return pos;
+        pos += n;
+    }
+
+    return len;
+}
+
+M_StdUnicodeObject::M_StdUnicodeObject(const std::string& s)
+    : value(s), hash_value(0), hash_cached(false), interned(false),
+      left(nullptr), right(nullptr)
+{
+    scan();
+}
+
+M_StdUnicodeObject::M_StdUnicodeObject(std::string&& s)
+    : value(std::move(s)), hash_value(0), hash_cached(false), interned(false),
+      left(nullptr), right(nullptr)
+{
+    scan();
+}
+
+M_StdUnicodeObject::M_StdUnicodeObject(M_StdUnicodeObject* left,
+                                       M_StdUnicodeObject* right)
+    : size(left->size + right->size), length(left->length + right->length),
+      ascii(left->ascii && right->ascii), hash_value(0), hash_cached(false),
+      interned(false), left(left), right(right)
+{}
+
+void M_StdUnicodeObject::scan()
+{
+    const unsigned char* s =
+        reinterpret_cast<const unsigned char*>(value.data());
+    std::size_t pos = ascii_prefix(s, value.size());
+
+    size = value.size();
+    ascii = (pos == size);
+    if (ascii) {
+        length = size;
+        return;
+    }
+
+    std::size_t bad = utf8_validate(s, pos, size);
+    if (bad != size) replace_invalid(bad);
 
-M_StdUnicodeObject::M_StdUnicodeObject(const std::string& s) { value = s; }
+    length = index_offsets(pos);
+}
+
+/* Replace each byte of the malformed sequences from pos on with U+FFFD, as
+ * decoding with errors="replace" does */
+void M_StdUnicodeObject::replace_invalid(std::size_t pos)
+{
+    const unsigned char* s =
+        reinterpret_cast<const unsigned char*>(value.data());
+    std::string result(value, 0, pos);
+    result.reserve(size + 2);
+
+    while (pos < size) {
+        std::size_t good = utf8_validate(s, pos, size);
+        result.append(value, pos, good - pos);
+        if (good == size) break;
+
+        result += "\xef\xbf\xbd";
+        pos = good + 1;
+    }
+
+    value = std::move(result);
+    size = value.size();
+}
+
+/* Record the byte offset of every INDEX_STEP-th code point given that the
+ * first prefix bytes are ASCII. Returns the number of code points */
+std::size_t M_StdUnicodeObject::index_offsets(std::size_t prefix) const
+{
+    const unsigned char* s =
+        reinterpret_cast<const unsigned char*>(value.data());
+    std::size_t pos = prefix, count = prefix;
+
+    /* code points in the ASCII prefix are one byte each */
+    for (std::size_t i = 0; i < pos; i += INDEX_STEP)
+        offsets.push_back((std::uint32_t)i);
+
+    while (pos < size) {
+        if (s[pos] < 0x80) {
+            /* ASCII runs are skipped as a whole, one code point per byte */
+            std::size_t run = ascii_prefix(s + pos, size - pos);
+            std::size_t k = (INDEX_STEP - count % INDEX_STEP) % INDEX_STEP;
+            for (; k < run; k += INDEX_STEP)
+                offsets.push_back((std::uint32_t)(pos + k));
+
+            pos += run;
+            count += run;
+            continue;
+        }
+
+        if (count % INDEX_STEP == 0) offsets.push_back((std::uint32_t)pos);
+        pos += utf8_lead_length(s[pos]);
+        count++;
+    }
+
+    return count;
+}
+
+void M_StdUnicodeObject::flatten() const
+{
+    std::string result;
+    result.reserve(size);
+
+    /* walk the operands iteratively as += builds very deep trees */
+    std::vector<const M_StdUnicodeObject*> stack{this};
+    while (!stack.empty()) {
+        const M_StdUnicodeObject* node = stack.back();
+        stack.pop_back();
+
+        if (node->left) {
+            stack.push_back(node->right);
+            stack.push_back(node->left);
+        } else {
+            result += node->value;
+        }
+    }
+
+    value = std::move(result);
+    left = right = nullptr;
+
+    if (!ascii)
+        index_offsets(ascii_prefix(
+            reinterpret_cast<const unsigned char*>(value.data()), size));
+}
+
+std::size_t M_StdUnicodeObject::char_size(std::size_t pos) const
+{
+    if (ascii) return 1;
+
+    const std::string& str = get_value();
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(str.data());
+
+    return utf8_lead_length(s[pos]);
+}
+
+std::size_t M_StdUnicodeObject::byte_offset(std::size_t i) const
+{
+    if (ascii) return i;
+    if (i >= length) return size;
+    if (left) flatten();
+
+    std::size_t pos = offsets[i / INDEX_STEP];
+    for (std::size_t k = i % INDEX_STEP; k > 0; k--)
+        pos += char_size(pos);
+
+    return pos;
+}
+
+std::size_t M_StdUnicodeObject::char_index(std::size_t pos) const
+{
+    if (ascii) return pos;
+    if (left) flatten();
+
+    /* start from the last indexed code point at or before pos */
+    auto it =
+        std::upper_bound(offsets.begin(), offsets.end(), (std::uint32_t)pos);
+    std::size_t k = (it - offsets.begin()) - 1;
+    std::size_t i = k * INDEX_STEP;
+
+    for (std::size_t p = offsets[k]; p < pos; p += char_size(p))
+        i++;
+
+    return i;
+}
+
+std::uint32_t M_StdUnicodeObject::code_point(std::size_t pos) const
+{
+    const std::string& str = get_value();
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(str.data());
+    std::size_t n = utf8_lead_length(s[pos]);
+
+    if (n == 1) return s[pos];
+
+    std::uint32_t cp = s[pos] & (0x7f >> n);
+    for (std::size_t i = 1; i < n; i++)
+        cp = (cp << 6) | (s[pos + i] & 0x3f);
+    return cp;
+}
+
+std::string M_StdUnicodeObject::from_code_point(std::uint32_t cp)
+{
+    if (cp < 0x80) return std::string(1, (char)cp);
+    if (cp < 0x800)
+        return std::string{(char)(0xc0 | (cp >> 6)),
+                           (char)(0x80 | (cp & 0x3f))};
+    if (cp < 0x10000)
+        return std::string{(char)(0xe0 | (cp >> 12)),
+                           (char)(0x80 | ((cp >> 6) & 0x3f)),
+                           (char)(0x80 | (cp & 0x3f))};
+    return std::string{(char)(0xf0 | (cp >> 18)),
+                       (char)(0x80 | ((cp >> 12) & 0x3f)),
+                       (char)(0x80 | ((cp >> 6) & 0x3f)),
+                       (char)(0x80 | (cp & 0x3f))};
+}
+
+M_BaseObject* M_StdUnicodeObject::char_at(mtpython::vm::ThreadContext* context,
+                                          std::size_t pos) const
+{
+    ObjSpace* space = context->get_space();
+    const std::string& str = get_value();
+    unsigned char c = (unsigned char)str[pos];
+
+    if (c < 0x80) return space->wrap_ascii_char(c);
+    return space->wrap_str(context, str.substr(pos, char_size(pos)));
+}
+
+std::size_t M_StdUnicodeObject::hash_string(const std::string& s)
+{
+    std::size_t hash = mtpython::HashHelper::hash_bytes(s.data(), s.size());
+    /* Truncated like the int returned by __hash__ */
+    return (std::size_t)(int)hash;
+}
 
 Typedef* M_StdUnicodeObject::_str_typedef()
 {
@@ -30,6 +339,51 @@ Typedef* M_StdUnicodeObject::_str_typedef()
              new InterpFunctionWrapper("__eq__", M_StdUnicodeObject::__eq__)},
             {"__iter__", new InterpFunctionWrapper(
                              "__iter__", M_StdUnicodeObject::__iter__)},
+            {"__len__",
+             new InterpFunctionWrapper("__len__", M_StdUnicodeObject::__len__)},
+            {"__getitem__",
+             new InterpFunctionWrapper("__getitem__",
+                                       M_StdUnicodeObject::__getitem__)},
+            {"__add__",
+             new InterpFunctionWrapper("__add__", M_StdUnicodeObject::__add__)},
+            {"__contains__",
+             new InterpFunctionWrapper("__contains__",
+                                       M_StdUnicodeObject::__contains__)},
+            {"find",
+             new InterpFunctionWrapper("find", M_StdUnicodeObject::find)},
+            {"rfind",
+             new InterpFunctionWrapper("rfind", M_StdUnicodeObject::rfind)},
+            {"index",
+             new InterpFunctionWrapper("index", M_StdUnicodeObject::index)},
+            {"rindex",
+             new InterpFunctionWrapper("rindex", M_StdUnicodeObject::rindex)},
+            {"count",
+             new InterpFunctionWrapper("count", M_StdUnicodeObject::count)},
+            {"split",
+             new InterpFunctionWrapper("split", M_StdUnicodeObject::split)},
+            {"rsplit",
+             new InterpFunctionWrapper("rsplit", M_StdUnicodeObject::rsplit)},
+            {"replace", new InterpFunctionWrapper(
+                            "replace", M_StdUnicodeObject::replace)},
+            {"join",
+             new InterpFunctionWrapper("join", M_StdUnicodeObject::join)},
+            {"strip",
+             new InterpFunctionWrapper("strip", M_StdUnicodeObject::strip)},
+            {"lstrip",
+             new InterpFunctionWrapper("lstrip", M_StdUnicodeObject::lstrip)},
+            {"rstrip",
+             new InterpFunctionWrapper("rstrip", M_StdUnicodeObject::rstrip)},
+            {"startswith", new InterpFunctionWrapper(
+                               "startswith", M_StdUnicodeObject::startswith)},
+            {"endswith", new InterpFunctionWrapper(
+                             "endswith", M_StdUnicodeObject::endswith)},
+            {"encode",
+             new InterpFunctionWrapper("encode", M_StdUnicodeObject::encode)},
+            {"isdigit",
+             new InterpFunctionWrapper("isdigit", M_StdUnicodeObject::isdigit)},
+            {"isidentifier",
+             new InterpFunctionWrapper("isidentifier",
+                                       M_StdUnicodeObject::isidentifier)},
         });
 
     return &str_typedef;
@@ -72,7 +426,54 @@ M_StdUnicodeObject::__new__(mtpython::vm::ThreadContext* context,
 M_BaseObject* M_StdUnicodeObject::__iter__(mtpython::vm::ThreadContext* context,
                                            M_BaseObject* self)
 {
-    return context->get_space()->new_seqiter(context, self);
+    return new (context) M_StdUnicodeIterObject(M_STDUNICODEOBJECT(self));
+}
+
+M_BaseObject* M_StdUnicodeObject::__len__(mtpython::vm::ThreadContext* context,
+                                          M_BaseObject* self)
+{
+    M_StdUnicodeObject* as_str = M_STDUNICODEOBJECT(self);
+    return context->get_space()->wrap_int(context, (int)as_str->length);
+}
+
+M_BaseObject*
+M_StdUnicodeObject::__getitem__(mtpython::vm::ThreadContext* context,
+                                M_BaseObject* self, M_BaseObject* index)
+{
+    ObjSpace* space = context->get_space();
+    M_StdUnicodeObject* as_str = M_STDUNICODEOBJECT(self);
+
+    if (M_StdSliceObject* slice = dynamic_cast<M_StdSliceObject*>(index)) {
+        long start, stop, step;
+        std::size_t n =
+            slice->unpack_indices(space, as_str->length, start, stop, step);
+        const std::string& value = as_str->get_value();
+
+        if (step == 1) {
+            std::size_t first = as_str->byte_offset(start);
+            return space->wrap_str(
+                context,
+                value.substr(first, as_str->byte_offset(start + n) - first));
+        }
+
+        std::string result;
+        for (std::size_t k = 0; k < n; k++, start += step) {
+            std::size_t pos = as_str->byte_offset(start);
+            result.append(value, pos, as_str->char_size(pos));
+        }
+        return space->wrap_str(context, result);
+    }
+
+    int i = space->i_get_index(index, space->IndexError_type(),
+                               space->wrap_str(context, "string index"));
+    if (i < 0) i += (int)as_str->length;
+
+    if (i < 0 || (std::size_t)i >= as_str->length)
+        throw InterpError(
+            space->IndexError_type(),
+            space->wrap_str(context, "string index out of range"));
+
+    return as_str->char_at(context, as_str->byte_offset(i));
 }
 
 M_BaseObject* M_StdUnicodeObject::__repr__(mtpython::vm::ThreadContext* context,
@@ -81,7 +482,8 @@ M_BaseObject* M_StdUnicodeObject::__repr__(mtpython::vm::ThreadContext* context,
     M_StdUnicodeObject* as_str = M_STDUNICODEOBJECT(self);
     assert(as_str);
 
-    return context->get_space()->wrap_str(context, "'" + as_str->value + "'");
+    return context->get_space()->wrap_str(context,
+                                          "'" + as_str->get_value() + "'");
 }
 
 M_BaseObject* M_StdUnicodeObject::__str__(mtpython::vm::ThreadContext* context,
@@ -94,24 +496,630 @@ M_BaseObject* M_StdUnicodeObject::__hash__(mtpython::vm::ThreadContext* context,
                                            M_BaseObject* self)
 {
     M_StdUnicodeObject* as_str = M_STDUNICODEOBJECT(self);
-    std::hash<std::string> hash_fn;
-    std::size_t hash = hash_fn(as_str->value);
 
-    return context->get_space()->wrap_int(context, hash);
+    return context->get_space()->wrap_int(context, (int)as_str->hash());
 }
 
 M_BaseObject* M_StdUnicodeObject::__eq__(mtpython::vm::ThreadContext* context,
                                          mtpython::objects::M_BaseObject* self,
                                          mtpython::objects::M_BaseObject* other)
 {
-    M_StdUnicodeObject* self_as_str = M_STDUNICODEOBJECT(self);
-    M_StdUnicodeObject* other_as_str = M_STDUNICODEOBJECT(other);
+    M_StdUnicodeObject* self_as_str = dynamic_cast<M_StdUnicodeObject*>(self);
+    M_StdUnicodeObject* other_as_str = dynamic_cast<M_StdUnicodeObject*>(other);
 
     if (!self_as_str || !other_as_str)
         return context->get_space()->new_bool(false);
+    if (self_as_str == other_as_str)
+        return context->get_space()->new_bool(true);
+    if (self_as_str->interned && other_as_str->interned)
+        return context->get_space()->new_bool(false);
+    if (self_as_str->size != other_as_str->size)
+        return context->get_space()->new_bool(false);
+
+    return context->get_space()->new_bool(self_as_str->get_value() ==
+                                          other_as_str->get_value());
+}
+
+M_BaseObject* M_StdUnicodeObject::__add__(mtpython::vm::ThreadContext* context,
+                                          M_BaseObject* self,
+                                          M_BaseObject* other)
+{
+    M_StdUnicodeObject* lhs = M_STDUNICODEOBJECT(self);
+    M_StdUnicodeObject* rhs = dynamic_cast<M_StdUnicodeObject*>(other);
+
+    if (!rhs) return context->get_space()->wrap_NotImplemented();
+    if (!rhs->size) return lhs;
+    if (!lhs->size) return rhs;
+
+    if (lhs->size + rhs->size < ROPE_MIN_SIZE) {
+        std::string result;
+        result.reserve(lhs->size + rhs->size);
+        result += lhs->get_value();
+        result += rhs->get_value();
+        return new (context) M_StdUnicodeObject(std::move(result));
+    }
+
+    return new (context) M_StdUnicodeObject(lhs, rhs);
+}
+
+static M_StdUnicodeObject* str_arg(ObjSpace* space, M_BaseObject* obj)
+{
+    M_StdUnicodeObject* as_str = dynamic_cast<M_StdUnicodeObject*>(obj);
+    if (!as_str)
+        throw InterpError::format(space, space->TypeError_type(),
+                                  "must be str, not %s",
+                                  space->get_type_name(obj).c_str());
+    return as_str;
+}
+
+static M_BaseObject* new_str(mtpython::vm::ThreadContext* context,
+                             std::string&& s)
+{
+    return new (context) M_StdUnicodeObject(std::move(s));
+}
+
+/* Byte range of str[start:end] for the optional start and end arguments of
+ * the search methods. Returns false if the range is empty and starts past the
+ * end of the string. */
+static bool adjust_range(ObjSpace* space, M_StdUnicodeObject* str,
+                         M_BaseObject* start_obj, M_BaseObject* end_obj,
+                         std::size_t& byte_start, std::size_t& byte_end)
+{
+    long len = (long)str->char_length();
+    long start = 0, end = len;
+
+    if (!space->i_is(start_obj, space->wrap_None()))
+        start = space->unwrap_int(start_obj);
+    if (!space->i_is(end_obj, space->wrap_None()))
+        end = space->unwrap_int(end_obj);
+
+    if (start < 0) start = std::max(start + len, 0L);
+    if (end < 0) end = std::max(end + len, 0L);
+    end = std::min(end, len);
+    if (start > end) return false;
+
+    byte_start = str->byte_offset(start);
+    byte_end = str->byte_offset(end);
+    return true;
+}
+
+static M_BaseObject* str_find(mtpython::vm::ThreadContext* context,
+                              const Arguments& args, const char* name,
+                              bool reverse, bool raise)
+{
+    static Signature find_signature({"self", "sub", "start", "end"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse(name, nullptr, find_signature, scope,
+               {space->wrap_None(), space->wrap_None()});
+    M_StdUnicodeObject* self = M_STDUNICODEOBJECT(scope[0]);
+    const std::string& sub = str_arg(space, scope[1])->get_value();
+    const std::string& value = self->get_value();
+
+    std::size_t start, end, pos = StringHelper::npos;
+    if (adjust_range(space, self, scope[2], scope[3], start, end)) {
+        if (reverse)
+            pos = StringHelper::rfind(value.data() + start, end - start,
+                                      sub.data(), sub.size());
+        else
+            pos = StringHelper::find(value.data() + start, end - start,
+                                     sub.data(), sub.size());
+    }
+
+    if (pos == StringHelper::npos) {
+        if (raise)
+            throw InterpError(space->ValueError_type(),
+                              space->wrap_str(context, "substring not found"));
+        return space->wrap_int(context, -1);
+    }
+
+    return space->wrap_int(context, (int)self->char_index(start + pos));
+}
+
+M_BaseObject* M_StdUnicodeObject::find(mtpython::vm::ThreadContext* context,
+                                       const Arguments& args)
+{
+    return str_find(context, args, "find", false, false);
+}
+
+M_BaseObject* M_StdUnicodeObject::rfind(mtpython::vm::ThreadContext* context,
+                                        const Arguments& args)
+{
+    return str_find(context, args, "rfind", true, false);
+}
 
-    return context->get_space()->new_bool(self_as_str->value ==
-                                          other_as_str->value);
+M_BaseObject* M_StdUnicodeObject::index(mtpython::vm::ThreadContext* context,
+                                        const Arguments& args)
+{
+    return str_find(context, args, "index", false, true);
+}
+
+M_BaseObject* M_StdUnicodeObject::rindex(mtpython::vm::ThreadContext* context,
+                                         const Arguments& args)
+{
+    return str_find(context, args, "rindex", true, true);
+}
+
+M_BaseObject* M_StdUnicodeObject::count(mtpython::vm::ThreadContext* context,
+                                        const Arguments& args)
+{
+    static Signature count_signature({"self", "sub", "start", "end"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("count", nullptr, count_signature, scope,
+               {space->wrap_None(), space->wrap_None()});
+    M_StdUnicodeObject* self = M_STDUNICODEOBJECT(scope[0]);
+    M_StdUnicodeObject* sub = str_arg(space, scope[1]);
+
+    std::size_t start, end, n = 0;
+    if (adjust_range(space, self, scope[2], scope[3], start, end)) {
+        if (!sub->size) {
+            n = self->char_index(end) - self->char_index(start) + 1;
+        } else {
+            const std::string& value = self->get_value();
+            const std::string& s = sub->get_value();
+            n = StringHelper::count(value.data() + start, end - start,
+                                    s.data(), s.size());
+        }
+    }
+
+    return space->wrap_int(context, (int)n);
+}
+
+M_BaseObject*
+M_StdUnicodeObject::__contains__(mtpython::vm::ThreadContext* context,
+                                 M_BaseObject* self, M_BaseObject* other)
+{
+    ObjSpace* space = context->get_space();
+    M_StdUnicodeObject* sub = dynamic_cast<M_StdUnicodeObject*>(other);
+
+    if (!sub)
+        throw InterpError::format(
+            space, space->TypeError_type(),
+            "'in <string>' requires string as left operand, not %s",
+            space->get_type_name(other).c_str());
+
+    const std::string& value = M_STDUNICODEOBJECT(self)->get_value();
+    const std::string& s = sub->get_value();
+    return space->new_bool(StringHelper::find(value.data(), value.size(),
+                                              s.data(), s.size()) !=
+                           StringHelper::npos);
+}
+
+static inline bool is_ascii_space(unsigned char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r') || (c >= 0x1c && c <= 0x1f);
+}
+
+static M_BaseObject* str_split(mtpython::vm::ThreadContext* context,
+                               const Arguments& args, const char* name,
+                               bool reverse)
+{
+    static Signature split_signature({"self", "sep", "maxsplit"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse(name, nullptr, split_signature, scope,
+               {space->wrap_None(), space->wrap_int(context, -1)});
+    const std::string& value = M_STDUNICODEOBJECT(scope[0])->get_value();
+    int maxsplit = space->unwrap_int(scope[2]);
+    std::size_t limit = maxsplit < 0 ? StringHelper::npos : maxsplit;
+    std::size_t n = value.size();
+    std::vector<M_BaseObject*> parts;
+
+    if (space->i_is(scope[1], space->wrap_None())) {
+        /* runs of whitespace separate fields and empty fields are dropped */
+        if (!reverse) {
+            std::size_t i = 0;
+            while (true) {
+                while (i < n && is_ascii_space(value[i]))
+                    i++;
+                if (i == n) break;
+                if (parts.size() == limit) {
+                    parts.push_back(new_str(context, value.substr(i)));
+                    break;
+                }
+
+                std::size_t j = i;
+                while (j < n && !is_ascii_space(value[j]))
+                    j++;
+                parts.push_back(new_str(context, value.substr(i, j - i)));
+                i = j;
+            }
+        } else {
+            std::size_t i = n;
+            while (true) {
+                while (i > 0 && is_ascii_space(value[i - 1]))
+                    i--;
+                if (i == 0) break;
+                if (parts.size() == limit) {
+                    parts.push_back(new_str(context, value.substr(0, i)));
+                    break;
+                }
+
+                std::size_t j = i;
+                while (j > 0 && !is_ascii_space(value[j - 1]))
+                    j--;
+                parts.push_back(new_str(context, value.substr(j, i - j)));
+                i = j;
+            }
+        }
+    } else {
+        const std::string& sep = str_arg(space, scope[1])->get_value();
+        std::size_t m = sep.size();
+        if (!m)
+            throw InterpError(space->ValueError_type(),
+                              space->wrap_str(context, "empty separator"));
+
+        if (!reverse) {
+            std::size_t i = 0;
+            while (parts.size() < limit) {
+                std::size_t pos =
+                    StringHelper::find(value.data() + i, n - i, sep.data(), m);
+                if (pos == StringHelper::npos) break;
+                parts.push_back(new_str(context, value.substr(i, pos)));
+                i += pos + m;
+            }
+            parts.push_back(new_str(context, value.substr(i)));
+        } else {
+            std::size_t end = n;
+            while (parts.size() < limit) {
+                std::size_t pos =
+                    StringHelper::rfind(value.data(), end, sep.data(), m);
+                if (pos == StringHelper::npos) break;
+                parts.push_back(
+                    new_str(context, value.substr(pos + m, end - pos - m)));
+                end = pos;
+            }
+            parts.push_back(new_str(context, value.substr(0, end)));
+        }
+    }
+
+    if (reverse) std::reverse(parts.begin(), parts.end());
+    return space->new_list(context, parts);
 }
 
-void M_StdUnicodeObject::dbg_print() { std::cout << value; }
+M_BaseObject* M_StdUnicodeObject::split(mtpython::vm::ThreadContext* context,
+                                        const Arguments& args)
+{
+    return str_split(context, args, "split", false);
+}
+
+M_BaseObject* M_StdUnicodeObject::rsplit(mtpython::vm::ThreadContext* context,
+                                         const Arguments& args)
+{
+    return str_split(context, args, "rsplit", true);
+}
+
+M_BaseObject* M_StdUnicodeObject::replace(mtpython::vm::ThreadContext* context,
+                                          const Arguments& args)
+{
+    static Signature replace_signature({"self", "old", "new", "count"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("replace", nullptr, replace_signature, scope,
+               {space->wrap_int(context, -1)});
+    M_StdUnicodeObject* self = M_STDUNICODEOBJECT(scope[0]);
+    const std::string& value = self->get_value();
+    const std::string& old_str = str_arg(space, scope[1])->get_value();
+    const std::string& new_str = str_arg(space, scope[2])->get_value();
+    int maxcount = space->unwrap_int(scope[3]);
+    std::size_t limit = maxcount < 0 ? StringHelper::npos : maxcount;
+    std::size_t n = value.size(), m = old_str.size();
+    std::string result;
+
+    if (!m) {
+        /* insert before every code point and at the end */
+        std::size_t k = std::min(self->length + 1, limit);
+        if (!k) return self;
+
+        result.reserve(n + k * new_str.size());
+        std::size_t pos = 0;
+        for (std::size_t i = 0; i < k; i++) {
+            result += new_str;
+            if (pos < n) {
+                std::size_t size = self->char_size(pos);
+                result.append(value, pos, size);
+                pos += size;
+            }
+        }
+        result.append(value, pos, std::string::npos);
+    } else {
+        /* count first so that the result is allocated exactly once */
+        std::size_t k =
+            StringHelper::count(value.data(), n, old_str.data(), m, limit);
+        if (!k) return self;
+
+        result.reserve(n - k * m + k * new_str.size());
+        std::size_t i = 0;
+        for (; k > 0; k--) {
+            std::size_t pos =
+                StringHelper::find(value.data() + i, n - i, old_str.data(), m);
+            result.append(value, i, pos);
+            result += new_str;
+            i += pos + m;
+        }
+        result.append(value, i, std::string::npos);
+    }
+
+    return new (context) M_StdUnicodeObject(std::move(result));
+}
+
+M_BaseObject* M_StdUnicodeObject::join(mtpython::vm::ThreadContext* context,
+                                       M_BaseObject* self,
+                                       M_BaseObject* iterable)
+{
+    ObjSpace* space = context->get_space();
+    const std::string& sep = M_STDUNICODEOBJECT(self)->get_value();
+    std::vector<M_BaseObject*> items;
+
+    space->unpack_iterable(iterable, items);
+    if (items.empty()) return space->wrap_str(context, "");
+
+    std::size_t size = sep.size() * (items.size() - 1);
+    for (std::size_t i = 0; i < items.size(); i++) {
+        M_StdUnicodeObject* item = dynamic_cast<M_StdUnicodeObject*>(items[i]);
+        if (!item)
+            throw InterpError::format(
+                space, space->TypeError_type(),
+                "sequence item %d: expected str instance, %s found", (int)i,
+                space->get_type_name(items[i]).c_str());
+        size += item->size;
+    }
+
+    if (items.size() == 1) return items[0];
+
+    std::string result;
+    result.reserve(size);
+    for (std::size_t i = 0; i < items.size(); i++) {
+        if (i) result += sep;
+        result += M_STDUNICODEOBJECT(items[i])->get_value();
+    }
+
+    return new_str(context, std::move(result));
+}
+
+/* Start of the code point ending at byte offset end */
+static std::size_t prev_char_start(M_StdUnicodeObject* str, std::size_t start,
+                                   std::size_t end)
+{
+    const std::string& value = str->get_value();
+    std::size_t pos = end - 1;
+
+    while (pos > start && end - pos < 4 &&
+           ((unsigned char)value[pos] & 0xc0) == 0x80)
+        pos--;
+    if (str->char_size(pos) != end - pos) pos = end - 1;
+
+    return pos;
+}
+
+static M_BaseObject* str_strip(mtpython::vm::ThreadContext* context,
+                               const Arguments& args, const char* name,
+                               bool left, bool right)
+{
+    static Signature strip_signature({"self", "chars"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse(name, nullptr, strip_signature, scope, {space->wrap_None()});
+    M_StdUnicodeObject* self = M_STDUNICODEOBJECT(scope[0]);
+    const std::string& value = self->get_value();
+    std::size_t start = 0, end = value.size();
+
+    if (space->i_is(scope[1], space->wrap_None())) {
+        while (left && start < end && is_ascii_space(value[start]))
+            start++;
+        while (right && end > start && is_ascii_space(value[end - 1]))
+            end--;
+    } else {
+        M_StdUnicodeObject* chars = str_arg(space, scope[1]);
+
+        if (chars->is_ascii()) {
+            bool table[256] = {false};
+            for (unsigned char c : chars->get_value())
+                table[c] = true;
+
+            while (left && start < end && table[(unsigned char)value[start]])
+                start++;
+            while (right && end > start && table[(unsigned char)value[end - 1]])
+                end--;
+        } else {
+            /* compare whole code points against the characters to strip */
+            const std::string& set = chars->get_value();
+            auto in_set = [&](std::size_t pos, std::size_t size) {
+                for (std::size_t i = 0; i < set.size();
+                     i += chars->char_size(i)) {
+                    if (chars->char_size(i) == size &&
+                        !set.compare(i, size, value, pos, size))
+                        return true;
+                }
+                return false;
+            };
+
+            while (left && start < end) {
+                std::size_t size = self->char_size(start);
+                if (!in_set(start, size)) break;
+                start += size;
+            }
+            while (right && end > start) {
+                std::size_t pos = prev_char_start(self, start, end);
+                if (!in_set(pos, end - pos)) break;
+                end = pos;
+            }
+        }
+    }
+
+    if (start == 0 && end == value.size()) return self;
+    return new_str(context, value.substr(start, end - start));
+}
+
+M_BaseObject* M_StdUnicodeObject::strip(mtpython::vm::ThreadContext* context,
+                                        const Arguments& args)
+{
+    return str_strip(context, args, "strip", true, true);
+}
+
+M_BaseObject* M_StdUnicodeObject::lstrip(mtpython::vm::ThreadContext* context,
+                                         const Arguments& args)
+{
+    return str_strip(context, args, "lstrip", true, false);
+}
+
+M_BaseObject* M_StdUnicodeObject::rstrip(mtpython::vm::ThreadContext* context,
+                                         const Arguments& args)
+{
+    return str_strip(context, args, "rstrip", false, true);
+}
+
+static M_BaseObject* str_startswith(mtpython::vm::ThreadContext* context,
+                                    const Arguments& args, const char* name,
+                                    bool at_end)
+{
+    static Signature startswith_signature({"self", "prefix", "start", "end"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse(name, nullptr, startswith_signature, scope,
+               {space->wrap_None(), space->wrap_None()});
+    M_StdUnicodeObject* self = M_STDUNICODEOBJECT(scope[0]);
+    const std::string& value = self->get_value();
+
+    std::vector<M_BaseObject*> prefixes;
+    M_StdTupleObject* as_tuple = dynamic_cast<M_StdTupleObject*>(scope[1]);
+    if (as_tuple)
+        prefixes.assign(as_tuple->begin(), as_tuple->end());
+    else
+        prefixes.push_back(scope[1]);
+
+    std::size_t start, end;
+    bool in_range = adjust_range(space, self, scope[2], scope[3], start, end);
+
+    for (auto* prefix : prefixes) {
+        M_StdUnicodeObject* as_str = dynamic_cast<M_StdUnicodeObject*>(prefix);
+        if (!as_str)
+            throw InterpError::format(
+                space, space->TypeError_type(),
+                "%s first arg must be str or a tuple of str, not %s", name,
+                space->get_type_name(prefix).c_str());
+
+        const std::string& s = as_str->get_value();
+        if (!in_range || s.size() > end - start) continue;
+
+        std::size_t pos = at_end ? end - s.size() : start;
+        if (!value.compare(pos, s.size(), s)) return space->new_bool(true);
+    }
+
+    return space->new_bool(false);
+}
+
+M_BaseObject*
+M_StdUnicodeObject::startswith(mtpython::vm::ThreadContext* context,
+                               const Arguments& args)
+{
+    return str_startswith(context, args, "startswith", false);
+}
+
+M_BaseObject* M_StdUnicodeObject::endswith(mtpython::vm::ThreadContext* context,
+                                           const Arguments& args)
+{
+    return str_startswith(context, args, "endswith", true);
+}
+
+M_BaseObject* M_StdUnicodeObject::encode(mtpython::vm::ThreadContext* context,
+                                         const Arguments& args)
+{
+    static Signature encode_signature({"self", "encoding", "errors"});
+    ObjSpace* space = context->get_space();
+
+    std::vector<M_BaseObject*> scope;
+    args.parse("encode", nullptr, encode_signature, scope,
+               {space->wrap_str(context, "utf-8"),
+                space->wrap_str(context, "strict")});
+
+    std::string encoded = encode_str(
+        space, M_STDUNICODEOBJECT(scope[0])->get_value(),
+        space->unwrap_str(scope[1]), space->unwrap_str(scope[2]));
+    return space->new_bytes(context, encoded.data(), encoded.size());
+}
+
+void M_StdUnicodeObject::dbg_print() { std::cout << get_value(); }
+
+Typedef* M_StdUnicodeIterObject::get_typedef()
+{
+    static Typedef str_iter_typedef(
+        "str_iterator",
+        {
+            {"__iter__", new InterpFunctionWrapper(
+                             "__iter__", M_StdUnicodeIterObject::__iter__)},
+            {"__next__", new InterpFunctionWrapper(
+                             "__next__", M_StdUnicodeIterObject::__next__)},
+        });
+
+    return &str_iter_typedef;
+}
+
+M_BaseObject*
+M_StdUnicodeIterObject::__iter__(mtpython::vm::ThreadContext* context,
+                                 M_BaseObject* self)
+{
+    return self;
+}
+
+M_BaseObject*
+M_StdUnicodeIterObject::__next__(mtpython::vm::ThreadContext* context,
+                                 M_BaseObject* self)
+{
+    ObjSpace* space = context->get_space();
+    M_StdUnicodeIterObject* as_iter =
+        static_cast<M_StdUnicodeIterObject*>(self);
+
+    as_iter->lock();
+    std::size_t pos = as_iter->pos;
+    if (pos >= as_iter->str->get_value().size()) {
+        as_iter->unlock();
+        throw InterpError(space->StopIteration_type(), space->wrap_None());
+    }
+    as_iter->pos = pos + as_iter->str->char_size(pos);
+    as_iter->unlock();
+
+    return as_iter->str->char_at(context, pos);
+}
+
+/* Only ASCII digits are recognized */
+M_BaseObject* M_StdUnicodeObject::isdigit(mtpython::vm::ThreadContext* context,
+                                          M_BaseObject* self)
+{
+    const std::string& value = M_STDUNICODEOBJECT(self)->get_value();
+    bool result = !value.empty();
+
+    for (unsigned char c : value) {
+        if (c < '0' || c > '9') {
+            result = false;
+            break;
+        }
+    }
+
+    return context->get_space()->new_bool(result);
+}
+
+/* Any non-ASCII character is accepted as a letter */
+M_BaseObject*
+M_StdUnicodeObject::isidentifier(mtpython::vm::ThreadContext* context,
+                                 M_BaseObject* self)
+{
+    const std::string& value = M_STDUNICODEOBJECT(self)->get_value();
+    bool result = !value.empty() && !(value[0] >= '0' && value[0] <= '9');
+
+    for (unsigned char c : value) {
+        if (c < 0x80 && c != '_' && !std::isalnum(c)) {
+            result = false;
+            break;
+        }
+    }
+
+    return context->get_space()->new_bool(result);
+}
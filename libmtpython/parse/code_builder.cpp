@@ -95,6 +95,8 @@ static std::unordered_map<unsigned char, int> static_opcode_stack_effect = {
 static std::unordered_map<unsigned char, int (*)(int)> dyn_opcode_stack_effect =
     {
         {UNPACK_SEQUENCE, [](int arg) { return arg - 1; }},
+        {BUILD_SLICE, [](int arg) { return arg == 3 ? -2 : -1; }},
+        {RAISE_VARARGS, [](int arg) { return -arg; }},
 };
 
 void CodeBlock::get_code(std::vector<unsigned char>& code)
@@ -281,6 +283,8 @@ int CodeBuilder::expr_constant(mtpython::tree::ASTNode* node)
             dynamic_cast<mtpython::tree::ConstNode*>(node);
         return space->is_true(const_node->get_value()) ? 1 : 0;
     }
+    default:
+        break;
     }
 
     return -1;
@@ -34,6 +34,8 @@ static std::unordered_map<int, int> subscr_op = {
     {EC_LOAD, BINARY_SUBSCR},
     {EC_STORE, STORE_SUBSCR},
     {EC_DEL, DELETE_SUBSCR},
+    {EC_AUGLOAD, BINARY_SUBSCR},
+    {EC_AUGSTORE, STORE_SUBSCR},
 };
 
 static std::unordered_map<int, int> augassign_op = {
@@ -144,10 +146,11 @@ ASTNode* BaseCodeGenerator::visit_assign(AssignNode* node)
     node->get_value()->visit(this);
     std::vector<ASTNode*>& targets = node->get_targets();
 
-    if (targets.size() > 1) emit_op(UNPACK_SEQUENCE);
-
-    for (auto target = targets.begin(); target != targets.end(); target++) {
-        (*target)->visit(this);
+    /* a = b = value stores the same value into every target, tuple targets
+     * unpack it themselves */
+    for (std::size_t i = 0; i < targets.size(); i++) {
+        if (i + 1 < targets.size()) emit_op(DUP_TOP);
+        targets[i]->visit(this);
     }
 
     return node;
@@ -167,6 +170,19 @@ ASTNode* BaseCodeGenerator::visit_augassign(AugAssignNode* node)
         gen_name(name->get_name(), ExprContext::EC_STORE);
         break;
     }
+    case NT_ATTRIBUTE:
+    case NT_SUBSCRIPT:
+        /* the container (and index) are evaluated once and kept on the
+         * stack for the store */
+        target->set_context(ExprContext::EC_AUGLOAD);
+        target->visit(this);
+        node->get_value()->visit(this);
+        emit_op(augassign_op[node->get_op()]);
+        target->set_context(ExprContext::EC_AUGSTORE);
+        target->visit(this);
+        break;
+    default:
+        break;
     }
     return node;
 }
@@ -216,6 +232,33 @@ ASTNode* BaseCodeGenerator::visit_break(BreakNode* node)
     return node;
 }
 
+ASTNode* BaseCodeGenerator::visit_continue(ContinueNode* node)
+{
+    set_lineno(node->get_line());
+    if (frame_block.empty())
+        throw mtpython::SyntaxError("'continue' not properly in loop");
+
+    auto& top = frame_block.back();
+    if (top.first == FrameType::F_LOOP) {
+        emit_jump(JUMP_ABSOLUTE, top.second, true);
+        return node;
+    }
+
+    /* inside a try block: unwind the blocks up to the loop */
+    for (auto it = frame_block.rbegin(); it != frame_block.rend(); it++) {
+        if (it->first == FrameType::F_LOOP) {
+            emit_jump(CONTINUE_LOOP, it->second, true);
+            return node;
+        }
+
+        if (it->first == FrameType::F_FINALLY_END)
+            throw mtpython::SyntaxError(
+                "'continue' not supported inside 'finally' clause");
+    }
+
+    throw mtpython::SyntaxError("'continue' not properly in loop");
+}
+
 void BaseCodeGenerator::make_call(int n, const std::vector<ASTNode*>& args,
                                   const std::vector<KeywordNode*>& keywords)
 {
@@ -685,6 +728,34 @@ BaseCodeGenerator::visit_lambda(mtpython::tree::LambdaNode* node)
     return node;
 }
 
+void BaseCodeGenerator::compile_comprehension(ASTNode* node,
+                                              const std::string& name,
+                                              ComprehensionNode* outermost)
+{
+    set_lineno(node->get_line());
+
+    ComprehensionCodeGenerator sub_gen(name, context, node, symtab,
+                                       node->get_line(), compile_info);
+    PyCode* code = sub_gen.build();
+
+    make_closure(code, 0, get_qualname());
+    outermost->get_iter()->visit(this);
+    emit_op(GET_ITER);
+    emit_op_arg(CALL_FUNCTION, 1);
+}
+
+ASTNode* BaseCodeGenerator::visit_generatorexp(GeneratorExpNode* node)
+{
+    compile_comprehension(node, "<genexpr>", node->get_comprehensions()[0]);
+    return node;
+}
+
+ASTNode* BaseCodeGenerator::visit_listcomp(ListCompNode* node)
+{
+    compile_comprehension(node, "<listcomp>", node->get_comprehensions()[0]);
+    return node;
+}
+
 ASTNode* BaseCodeGenerator::visit_const(ConstNode* node)
 {
     set_lineno(node->get_line());
@@ -708,6 +779,24 @@ ASTNode* BaseCodeGenerator::visit_pass(PassNode* node)
     return node;
 }
 
+ASTNode* BaseCodeGenerator::visit_raise(RaiseNode* node)
+{
+    set_lineno(node->get_line());
+    int nargs = 0;
+    if (node->get_exc()) {
+        node->get_exc()->visit(this);
+        nargs++;
+        if (node->get_cause()) {
+            node->get_cause()->visit(this);
+            nargs++;
+        }
+    }
+
+    emit_op_arg(RAISE_VARARGS, nargs);
+
+    return node;
+}
+
 ASTNode* BaseCodeGenerator::visit_return(ReturnNode* node)
 {
     set_lineno(node->get_line());
@@ -757,18 +846,45 @@ ASTNode* BaseCodeGenerator::visit_subscript(SubscriptNode* node)
 
     ASTNode* slice = node->get_slice();
     ExprContext ctx = node->get_context();
-    if (slice->get_tag() == NT_INDEX) {
-        if (ctx != EC_AUGSTORE) {
+    if (ctx != EC_AUGSTORE) {
+        if (slice->get_tag() == NT_INDEX) {
             IndexNode* index = dynamic_cast<IndexNode*>(slice);
             index->get_value()->visit(this);
+        } else if (slice->get_tag() == NT_SLICE) {
+            slice->visit(this);
         }
     }
 
+    if (ctx == EC_AUGLOAD)
+        emit_op(DUP_TOP_TWO);
+    else if (ctx == EC_AUGSTORE)
+        emit_op(ROT_THREE);
     emit_op(subscr_op[ctx]);
 
     return node;
 }
 
+ASTNode* BaseCodeGenerator::visit_slice(SliceNode* node)
+{
+    /* missing bounds are passed as None */
+    ASTNode* bounds[] = {node->get_lower(), node->get_upper()};
+    for (ASTNode* bound : bounds) {
+        if (bound)
+            bound->visit(this);
+        else
+            load_const(space->wrap_None());
+    }
+
+    if (node->get_step()) {
+        node->get_step()->visit(this);
+        emit_op_arg(BUILD_SLICE, 3);
+    } else {
+        emit_op_arg(BUILD_SLICE, 2);
+    }
+
+    return node;
+}
+
 ASTNode* BaseCodeGenerator::visit_try(TryNode* node)
 {
     if (!(node->get_finalbody()))
@@ -804,7 +920,7 @@ ASTNode* BaseCodeGenerator::visit_try_except(TryNode* node)
             emit_op(DUP_TOP);
             type->visit(this);
             emit_op_arg(COMPARE_OP, 10);
-            emit_jump(JUMP_IF_FALSE_OR_POP, next_exc, true);
+            emit_jump(POP_JUMP_IF_FALSE, next_exc, true);
         }
         emit_op(POP_TOP);
         std::string& name = handler->get_name();
@@ -900,6 +1016,8 @@ ASTNode* BaseCodeGenerator::visit_tuple(TupleNode* node)
             ASTNode* elt = elements[i];
             /* TODO: Starred assignment PEP 3132 */
         }
+
+        emit_op_arg(UNPACK_SEQUENCE, eltcount);
     }
 
     for (auto elt : elements) {
@@ -1096,6 +1214,73 @@ void LambdaCodeGenerator::compile(ASTNode* tree)
     emit_op(RETURN_VALUE);
 }
 
+ComprehensionCodeGenerator::ComprehensionCodeGenerator(
+    const std::string& name, mtpython::vm::ThreadContext* context,
+    mtpython::tree::ASTNode* tree, SymtableVisitor* symtab, int lineno,
+    CompileInfo* info)
+    : AbstractFunctionCodeGenerator(name, context, tree, symtab, lineno, info)
+{
+    compile(tree);
+}
+
+void ComprehensionCodeGenerator::compile(ASTNode* tree)
+{
+    set_argcount(1);
+
+    if (ListCompNode* listcomp = dynamic_cast<ListCompNode*>(tree)) {
+        emit_op_arg(BUILD_LIST, 0);
+        gen_loop(listcomp->get_comprehensions(), 0, listcomp->get_elt(),
+                 true);
+    } else {
+        GeneratorExpNode* genexp = static_cast<GeneratorExpNode*>(tree);
+        gen_loop(genexp->get_comprehensions(), 0, genexp->get_elt(), false);
+        load_const(space->wrap_None());
+    }
+
+    emit_op(RETURN_VALUE);
+}
+
+void ComprehensionCodeGenerator::gen_loop(
+    std::vector<ComprehensionNode*>& comprehensions, std::size_t index,
+    ASTNode* elt, bool is_list)
+{
+    ComprehensionNode* comp = comprehensions[index];
+    CodeBlock* start = new_block();
+    CodeBlock* anchor = new_block();
+
+    if (index == 0) {
+        gen_name(".0", EC_LOAD);
+    } else {
+        comp->get_iter()->visit(this);
+        emit_op(GET_ITER);
+    }
+
+    use_next_block(start);
+    emit_jump(FOR_ITER, anchor);
+    comp->get_target()->visit(this);
+
+    for (auto ifexp : comp->get_ifs()) {
+        ifexp->visit(this);
+        emit_jump(POP_JUMP_IF_FALSE, start, true);
+    }
+
+    if (index + 1 < comprehensions.size()) {
+        gen_loop(comprehensions, index + 1, elt, is_list);
+    } else {
+        elt->visit(this);
+        if (is_list) {
+            /* the list is below the iterators of all loops */
+            emit_op_arg(LIST_APPEND, comprehensions.size() + 1);
+        } else {
+            emit_op(YIELD_VALUE);
+            emit_op(POP_TOP);
+        }
+    }
+
+    emit_jump(JUMP_ABSOLUTE, start, true);
+    use_next_block(anchor);
+}
+
 ClassCodeGenerator::ClassCodeGenerator(const std::string& name,
                                        mtpython::vm::ThreadContext* context,
                                        mtpython::tree::ASTNode* tree,
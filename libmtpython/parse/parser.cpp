@@ -1,4 +1,5 @@
 /* LL(1) Python parse */
+#include <cstdlib>
 #include <iostream>
 
 #include "vm/vm.h"
@@ -116,23 +117,31 @@ ASTNode* Parser::mod()
     return node;
 }
 
+/* Last statement of a list of statements, simple_stmt returns all the small
+ * statements of a line linked as siblings */
+static ASTNode* last_sibling(ASTNode* node)
+{
+    while (node && node->get_sibling())
+        node = node->get_sibling();
+    return node;
+}
+
 ASTNode* Parser::module()
 {
     ModuleNode* module = new ModuleNode(s.get_line());
 
     ASTNode* body = stmt();
     if (cur_tok == TOK_SEMICOLON) match(TOK_SEMICOLON);
-    ASTNode* tn = body;
+    ASTNode* tn = last_sibling(body);
     while (cur_tok != TOK_EOF) {
         ASTNode* n = stmt();
         if (cur_tok == TOK_SEMICOLON) match(TOK_SEMICOLON);
         if (n != nullptr) {
             if (tn == nullptr)
-                body = tn = n;
-            else {
+                body = n;
+            else
                 tn->set_sibling(n);
-                tn = n;
-            }
+            tn = last_sibling(n);
         }
     }
 
@@ -153,17 +162,16 @@ ASTNode* Parser::suite()
 
         node = stmt();
         if (cur_tok == TOK_SEMICOLON) match(TOK_SEMICOLON);
-        ASTNode* tn = node;
+        ASTNode* tn = last_sibling(node);
         while (cur_tok != TOK_DEDENT) {
             ASTNode* n = stmt();
             if (cur_tok == TOK_SEMICOLON) match(TOK_SEMICOLON);
             if (n != nullptr) {
                 if (tn == nullptr)
-                    node = tn = n;
-                else {
+                    node = n;
+                else
                     tn->set_sibling(n);
-                    tn = n;
-                }
+                tn = last_sibling(n);
             }
         }
 
@@ -218,6 +226,8 @@ ASTNode* Parser::stmt()
     case TOK_LAMBDA:
     case TOK_IDENT:
     case TOK_INTLITERAL:
+    case TOK_FLOATLITERAL:
+    case TOK_DOUBLELITERAL:
     case TOK_STRINGLITERAL:
     case TOK_NONE:
     case TOK_NEWLINE:
@@ -303,6 +313,8 @@ ASTNode* Parser::small_stmt()
     case TOK_LAMBDA:
     case TOK_IDENT:
     case TOK_INTLITERAL:
+    case TOK_FLOATLITERAL:
+    case TOK_DOUBLELITERAL:
     case TOK_STRINGLITERAL:
     case TOK_NONE:
         node = expr_stmt();
@@ -319,12 +331,7 @@ ASTNode* Parser::expr_stmt()
     if (cur_tok == TOK_EQL) {
         expression->set_context(EC_STORE);
         AssignNode* asgn = new AssignNode(s.get_line());
-
-        if (TupleNode* tuple = dynamic_cast<TupleNode*>(expression)) {
-            asgn->set_targets(tuple->get_elements());
-        } else {
-            asgn->push_target(expression);
-        }
+        asgn->push_target(expression);
 
         ASTNode* tgt;
         while (cur_tok == TOK_EQL) {
@@ -419,14 +426,19 @@ ASTNode* Parser::testlist_comp_list()
         }
         elt = list;
     } else if (cur_tok == TOK_FOR) {
-        GeneratorExpNode* genexp = new GeneratorExpNode(s.get_line());
-        genexp->set_elt(elt);
+        ListCompNode* listcomp = new ListCompNode(s.get_line());
+        listcomp->set_elt(elt);
 
         while (cur_tok == TOK_FOR) {
-            genexp->push_comprehension(comp_for());
+            listcomp->push_comprehension(comp_for());
         }
 
-        elt = genexp;
+        elt = listcomp;
+    } else {
+        /* single element list */
+        ListNode* list = new ListNode(s.get_line());
+        list->push_element(elt);
+        elt = list;
     }
 
     return elt;
@@ -443,6 +455,7 @@ ComprehensionNode* Parser::comp_for()
     ComprehensionNode* node = new ComprehensionNode(s.get_line());
     match(TOK_FOR);
     ASTNode* target = exprlist();
+    target->set_context(EC_STORE);
     node->set_target(target);
     match(TOK_IN);
     ASTNode* iter = or_test();
@@ -814,20 +827,36 @@ ASTNode* Parser::slice()
     if (cur_tok == TOK_RSQUARE)
         diag.error(s.get_line(), s.get_col(), "invalid syntax");
 
-    ASTNode* first = test();
+    /* subscript: test | [test] ':' [test] [':' [test]] */
+    ASTNode* first = nullptr;
     ASTNode* second = nullptr;
     ASTNode* third = nullptr;
+    bool is_slice = false;
 
+    if (cur_tok != TOK_COLON) first = test();
     if (cur_tok == TOK_COLON) {
+        is_slice = true;
         match(TOK_COLON);
-        second = test();
+        if (cur_tok != TOK_COLON && cur_tok != TOK_RSQUARE) second = test();
     }
-    if (cur_tok == TOK_COLON) {
+    if (is_slice && cur_tok == TOK_COLON) {
         match(TOK_COLON);
-        third = test();
+        if (cur_tok != TOK_RSQUARE) third = test();
+    }
+
+    if (!is_slice && cur_tok == TOK_COMMA) {
+        /* subscriptlist: x[a, b] indexes x with the tuple (a, b) */
+        TupleNode* tuple = new TupleNode(s.get_line());
+        tuple->push_element(first);
+        while (cur_tok == TOK_COMMA) {
+            match(TOK_COMMA);
+            if (cur_tok == TOK_RSQUARE) break;
+            tuple->push_element(test());
+        }
+        first = tuple;
     }
 
-    if (first && !second && !third) {
+    if (!is_slice) {
         IndexNode* index = new IndexNode(s.get_line());
         index->set_value(first);
 
@@ -999,14 +1028,24 @@ ASTNode* Parser::atom()
 
 M_BaseObject* Parser::parsestrplus()
 {
-    M_BaseObject* str = space->wrap_str(context, s.get_last_string());
+    bool bytes = s.get_last_string_prefix().find('b') != std::string::npos;
+    std::string str = s.get_last_string();
     match(TOK_STRINGLITERAL);
 
+    /* adjacent literals are concatenated */
     while (cur_tok == TOK_STRINGLITERAL) {
+        bool next_bytes =
+            s.get_last_string_prefix().find('b') != std::string::npos;
+        if (next_bytes != bytes) {
+            diag.error(s.get_line(), s.get_col(),
+                       "cannot mix bytes and nonbytes literals");
+        }
+        str += s.get_last_string();
         match(TOK_STRINGLITERAL);
     }
 
-    return str;
+    if (bytes) return space->new_bytes(context, str.data(), str.size());
+    return space->wrap_str(context, str);
 }
 
 M_BaseObject* Parser::parsestr()
@@ -1160,9 +1199,22 @@ ASTNode* Parser::parse_number()
 {
     NumberNode* node = new NumberNode(s.get_line());
 
-    if (cur_tok == TOK_INTLITERAL) {
-        node->set_value(space->wrap_int(context, s.get_last_strnum()));
-        match(TOK_INTLITERAL);
+    if (cur_tok == TOK_INTLITERAL || cur_tok == TOK_LONGLITERAL) {
+        int radix = s.get_radix();
+
+        if (radix == 10) {
+            node->set_value(space->wrap_int(context, s.get_last_strnum()));
+        } else {
+            /* The scanner strips the 0x/0o prefix. Hex and octal literals
+             * keep their low 32 bits, so masks like 0xFFFFFFFF still work */
+            unsigned long long value =
+                std::strtoull(s.get_last_strnum().c_str(), nullptr, radix);
+            node->set_value(space->wrap_int(context, (int)value));
+        }
+        match(cur_tok);
+    } else if (cur_tok == TOK_FLOATLITERAL || cur_tok == TOK_DOUBLELITERAL) {
+        node->set_value(space->wrap_float(context, s.get_last_strnum()));
+        match(cur_tok);
     }
 
     return node;
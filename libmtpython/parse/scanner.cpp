@@ -1,4 +1,5 @@
 #include "parse/scanner.h"
+#include <cstring>
 #include <sstream>
 
 using namespace std;
@@ -190,42 +191,128 @@ Token Scanner::scan_hex_exponent_and_suffix()
     }
 }
 
-char Scanner::scan_char_lit()
+/* Code point cp encoded as UTF-8, the storage format of str literals */
+static std::string utf8_encode(unsigned int cp)
 {
+    if (cp < 0x80) return std::string(1, (char)cp);
+    if (cp < 0x800)
+        return std::string{(char)(0xc0 | (cp >> 6)),
+                           (char)(0x80 | (cp & 0x3f))};
+    if (cp < 0x10000)
+        return std::string{(char)(0xe0 | (cp >> 12)),
+                           (char)(0x80 | ((cp >> 6) & 0x3f)),
+                           (char)(0x80 | (cp & 0x3f))};
+    return std::string{(char)(0xf0 | (cp >> 18)),
+                       (char)(0x80 | ((cp >> 12) & 0x3f)),
+                       (char)(0x80 | ((cp >> 6) & 0x3f)),
+                       (char)(0x80 | (cp & 0x3f))};
+}
+
+std::string Scanner::scan_char_lit(bool bytes, bool raw)
+{
+    if (last_char == '\\' && raw) {
+        /* the backslash is kept, it only stops a quote or another backslash
+         * from ending the literal */
+        last_char = read_char();
+        if (last_char != '\\' && last_char != '\'' && last_char != '\"')
+            return "\\";
+
+        char tmp = last_char;
+        last_char = read_char();
+        return std::string{'\\', tmp};
+    }
+
     if (last_char == '\\') { /* escape */
         last_char = read_char();
         switch (last_char) {
+        case 'x':
+        case 'u':
+        case 'U': {
+            /* \u and \U are not escapes in bytes literals */
+            if (bytes && last_char != 'x') return "\\";
+            int ndigits = last_char == 'x' ? 2 : last_char == 'u' ? 4 : 8;
+
+            unsigned int value = 0;
+            for (int i = 0; i < ndigits; i++) {
+                last_char = read_char();
+                int digit = char2digit(16, last_char);
+                if (digit < 0) {
+                    diagnostics->error(line, col, "truncated escape sequence");
+                    return "";
+                }
+                value = value * 16 + digit;
+            }
+            last_char = read_char();
+            if (value > 0x10ffff) {
+                diagnostics->error(line, col, "illegal Unicode character");
+                return "";
+            }
+            /* \xXX is a byte in bytes literals and a code point in str
+             * literals, which are stored as UTF-8 */
+            if (bytes) return std::string(1, (char)value);
+            return utf8_encode(value);
+        }
+        case '0':
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+        case '5':
+        case '6':
+        case '7': {
+            unsigned int value = 0;
+            for (int i = 0; i < 3 && last_char >= '0' && last_char <= '7';
+                 i++) {
+                value = value * 8 + (last_char - '0');
+                last_char = read_char();
+            }
+            if (bytes) return std::string(1, (char)value);
+            return utf8_encode(value);
+        }
+        case '\n':
+            /* line continuation */
+            line++;
+            col = 0;
+            last_char = read_char();
+            return "";
+        case 'a':
+            last_char = read_char();
+            return "\a";
         case 'b':
             last_char = read_char();
-            return '\b';
+            return "\b";
+        case 'f':
+            last_char = read_char();
+            return "\f";
         case 't':
             last_char = read_char();
-            return '\t';
+            return "\t";
         case 'n':
             last_char = read_char();
-            return '\n';
+            return "\n";
         case 'r':
             last_char = read_char();
-            return '\r';
+            return "\r";
+        case 'v':
+            last_char = read_char();
+            return "\v";
         case '\'':
             last_char = read_char();
-            return '\'';
+            return "'";
         case '\"':
             last_char = read_char();
-            return '\"';
+            return "\"";
         case '\\':
             last_char = read_char();
-            return '\\';
+            return "\\";
         }
-        char tmp;
-        tmp = last_char;
-        last_char = read_char();
-        return tmp;
+        /* unknown escapes are left in the string */
+        return "\\";
     } else {
         char tmp;
         tmp = last_char;
         last_char = read_char();
-        return tmp;
+        return std::string(1, tmp);
     }
 }
 
@@ -282,18 +369,36 @@ Token Scanner::get_token()
 
     if (update_indent) { /* calculate indentation */
         update_indent = false;
-        int indentation_level = 0;
-        char indentation_char = last_char;
-        while ((last_char == ' ') || (last_char == '\t')) {
-            if (last_char !=
-                indentation_char) { /* error: mixed tabs and spaces */
-                diagnostics->error(
-                    line, col,
-                    "inconsistent use of tabs and spaces in indentation");
-                return TOK_ERROR;
+        int indentation_level;
+        for (;;) {
+            indentation_level = 0;
+            char indentation_char = last_char;
+            while ((last_char == ' ') || (last_char == '\t')) {
+                if (last_char !=
+                    indentation_char) { /* error: mixed tabs and spaces */
+                    diagnostics->error(
+                        line, col,
+                        "inconsistent use of tabs and spaces in indentation");
+                    return TOK_ERROR;
+                }
+                indentation_level++;
+                last_char = read_char();
+            }
+
+            /* blank and comment-only lines don't change the indentation */
+            if (last_char == '#') {
+                while (last_char != '\n' && last_char != '\r' &&
+                       last_char != -1)
+                    last_char = read_char();
+            }
+            if ((last_char != '\n') && (last_char != '\r')) break;
+            while ((last_char == '\n') || (last_char == '\r')) {
+                if (last_char == '\n') {
+                    line++;
+                    col = 0;
+                }
+                last_char = read_char();
             }
-            indentation_level++;
-            last_char = read_char();
         }
 
         /* indent */
@@ -312,7 +417,7 @@ Token Scanner::get_token()
 
     std::string str_prefix = "";
     if (isalpha(last_char) || last_char == '_') { // reserved word or id
-        while (last_char == 'r' || last_char == 'u' || last_char == 'b') {
+        while (last_char && std::strchr("rRuUbB", last_char)) {
             str_prefix += last_char;
             last_char = read_char();
             if (last_char == '"' || last_char == '\'') goto scan_str_lit;
@@ -402,6 +507,7 @@ Token Scanner::get_token()
     /* string literal */
     else if (last_char == '\"' || last_char == '\'') {
     scan_str_lit:
+        last_string_prefix = str_prefix;
         char end_char = last_char;
         bool triple = false;
         last_string = "";
@@ -434,7 +540,9 @@ Token Scanner::get_token()
             if (last_char == '\n') line++;
             if (last_char == -1) break;
 
-            last_string = last_string + scan_char_lit();
+            last_string += scan_char_lit(
+                str_prefix.find_first_of("bB") != std::string::npos,
+                str_prefix.find_first_of("rR") != std::string::npos);
         }
         if (last_char == end_char) {
             last_char = read_char();
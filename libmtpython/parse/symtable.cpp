@@ -324,6 +324,45 @@ ASTNode* SymtableVisitor::visit_lambda(LambdaNode* node)
     return node;
 }
 
+/* Comprehensions run in a function scope of their own which receives the
+ * iterator of the outermost loop as its only argument ".0". That iterable
+ * is evaluated in the enclosing scope. */
+void SymtableVisitor::visit_comprehension_scope(
+    ASTNode* node, const std::string& name, ASTNode* elt,
+    std::vector<ComprehensionNode*>& comprehensions, bool is_generator)
+{
+    ComprehensionNode* outermost = comprehensions[0];
+    outermost->get_iter()->visit(this);
+
+    FunctionScope* scope =
+        new FunctionScope(space, name, node->get_line(), 0);
+    push_scope(scope, node);
+    if (is_generator) scope->note_yield(nullptr);
+    add_name(".0", SYM_PARAM);
+
+    outermost->get_target()->visit(this);
+    for (auto ifexp : outermost->get_ifs())
+        ifexp->visit(this);
+    for (std::size_t i = 1; i < comprehensions.size(); i++)
+        comprehensions[i]->visit(this);
+    elt->visit(this);
+    pop_scope();
+}
+
+ASTNode* SymtableVisitor::visit_generatorexp(GeneratorExpNode* node)
+{
+    visit_comprehension_scope(node, "genexpr", node->get_elt(),
+                              node->get_comprehensions(), true);
+    return node;
+}
+
+ASTNode* SymtableVisitor::visit_listcomp(ListCompNode* node)
+{
+    visit_comprehension_scope(node, "listcomp", node->get_elt(),
+                              node->get_comprehensions(), false);
+    return node;
+}
+
 ASTNode* SymtableVisitor::visit_name(NameNode* node)
 {
     add_name(node->get_name(),
@@ -126,6 +126,8 @@ NODE_CONSTRUCTOR(ComprehensionNode)
 
 NODE_CONSTRUCTOR(GeneratorExpNode) { elt = nullptr; }
 
+NODE_CONSTRUCTOR(ListCompNode) { elt = nullptr; }
+
 NODE_CONSTRUCTOR(SubscriptNode)
 {
     value = nullptr;
@@ -0,0 +1,101 @@
+#include "utils/hash_helper.h"
+
+#include <cstdint>
+#include <cstring>
+
+static const std::uint64_t PRIME1 = 11400714785074694791ULL;
+static const std::uint64_t PRIME2 = 14029467366897019727ULL;
+static const std::uint64_t PRIME3 = 1609587929392839161ULL;
+static const std::uint64_t PRIME4 = 9650029242287828579ULL;
+static const std::uint64_t PRIME5 = 2870177450012600261ULL;
+
+static inline std::uint64_t rotl(std::uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline std::uint64_t read64(const unsigned char* p)
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline std::uint32_t read32(const unsigned char* p)
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline std::uint64_t xxh_round(std::uint64_t acc, std::uint64_t input)
+{
+    acc += input * PRIME2;
+    acc = rotl(acc, 31);
+    return acc * PRIME1;
+}
+
+static inline std::uint64_t merge_round(std::uint64_t acc, std::uint64_t val)
+{
+    acc ^= xxh_round(0, val);
+    return acc * PRIME1 + PRIME4;
+}
+
+std::size_t mtpython::HashHelper::hash_bytes(const void* data, std::size_t len)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* end = p + len;
+    std::uint64_t h;
+
+    if (len >= 32) {
+        const unsigned char* limit = end - 32;
+        std::uint64_t v1 = PRIME1 + PRIME2;
+        std::uint64_t v2 = PRIME2;
+        std::uint64_t v3 = 0;
+        std::uint64_t v4 = -PRIME1;
+
+        do {
+            v1 = xxh_round(v1, read64(p));
+            v2 = xxh_round(v2, read64(p + 8));
+            v3 = xxh_round(v3, read64(p + 16));
+            v4 = xxh_round(v4, read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        h = merge_round(h, v1);
+        h = merge_round(h, v2);
+        h = merge_round(h, v3);
+        h = merge_round(h, v4);
+    } else {
+        h = PRIME5;
+    }
+
+    h += (std::uint64_t)len;
+
+    while (p + 8 <= end) {
+        h ^= xxh_round(0, read64(p));
+        h = rotl(h, 27) * PRIME1 + PRIME4;
+        p += 8;
+    }
+
+    if (p + 4 <= end) {
+        h ^= (std::uint64_t)read32(p) * PRIME1;
+        h = rotl(h, 23) * PRIME2 + PRIME3;
+        p += 4;
+    }
+
+    while (p < end) {
+        h ^= (*p) * PRIME5;
+        h = rotl(h, 11) * PRIME1;
+        p++;
+    }
+
+    h ^= h >> 33;
+    h *= PRIME2;
+    h ^= h >> 29;
+    h *= PRIME3;
+    h ^= h >> 32;
+
+    return (std::size_t)h;
+}
@@ -0,0 +1,149 @@
+#include "utils/string_helper.h"
+
+#include <cstring>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using mtpython::StringHelper;
+
+std::size_t StringHelper::find(const char* haystack, std::size_t n,
+                               const char* needle, std::size_t m)
+{
+    if (m == 0) return 0;
+    if (m > n) return npos;
+
+    if (m == 1) {
+        const void* p = std::memchr(haystack, needle[0], n);
+        return p ? static_cast<const char*>(p) - haystack : npos;
+    }
+
+    std::size_t i = 0;
+
+#ifdef __AVX2__
+    /* Compare the first and the last byte of the needle against 32
+     * candidate positions at once and only check the candidates where both
+     * match */
+    const __m256i first32 = _mm256_set1_epi8(needle[0]);
+    const __m256i last32 = _mm256_set1_epi8(needle[m - 1]);
+
+    for (; i + m - 1 + 32 <= n; i += 32) {
+        __m256i block_first =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i));
+        __m256i block_last = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(haystack + i + m - 1));
+        __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(first32, block_first),
+                                      _mm256_cmpeq_epi8(last32, block_last));
+        unsigned int mask = _mm256_movemask_epi8(eq);
+
+        while (mask) {
+            unsigned int bit = __builtin_ctz(mask);
+            if (!std::memcmp(haystack + i + bit + 1, needle + 1, m - 2))
+                return i + bit;
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+#ifdef __SSE2__
+    /* Same with 16 candidates, also used for the tail of the AVX2 loop */
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[m - 1]);
+
+    for (; i + m - 1 + 16 <= n; i += 16) {
+        __m128i block_first =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+        __m128i block_last = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(haystack + i + m - 1));
+        __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(first, block_first),
+                                   _mm_cmpeq_epi8(last, block_last));
+        unsigned int mask = _mm_movemask_epi8(eq);
+
+        while (mask) {
+            unsigned int bit = __builtin_ctz(mask);
+            if (!std::memcmp(haystack + i + bit + 1, needle + 1, m - 2))
+                return i + bit;
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    while (i + m <= n) {
+        const void* p = std::memchr(haystack + i, needle[0], n - m + 1 - i);
+        if (!p) return npos;
+
+        i = static_cast<const char*>(p) - haystack;
+        if (!std::memcmp(haystack + i + 1, needle + 1, m - 1)) return i;
+        i++;
+    }
+
+    return npos;
+}
+
+std::size_t StringHelper::rfind(const char* haystack, std::size_t n,
+                                const char* needle, std::size_t m)
+{
+    if (m > n) return npos;
+    if (m == 0) return n;
+
+    /* candidates are the start positions below i */
+    std::size_t i = n - m + 1;
+
+#ifdef __SSE2__
+    /* The first/last byte filter of find(), walking the blocks backwards and
+     * checking the highest candidate of each block first */
+    if (m > 1) {
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i last = _mm_set1_epi8(needle[m - 1]);
+
+        for (; i >= 16; i -= 16) {
+            std::size_t base = i - 16;
+            __m128i block_first = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(haystack + base));
+            __m128i block_last = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(haystack + base + m - 1));
+            __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(first, block_first),
+                                       _mm_cmpeq_epi8(last, block_last));
+            unsigned int mask = _mm_movemask_epi8(eq);
+
+            while (mask) {
+                unsigned int bit = 31 - __builtin_clz(mask);
+                if (!std::memcmp(haystack + base + bit + 1, needle + 1, m - 2))
+                    return base + bit;
+                mask &= ~(1u << bit);
+            }
+        }
+    }
+#endif
+
+    for (; i > 0; i--) {
+        if (haystack[i - 1] == needle[0] &&
+            !std::memcmp(haystack + i, needle + 1, m - 1))
+            return i - 1;
+    }
+
+    return npos;
+}
+
+std::size_t StringHelper::count(const char* haystack, std::size_t n,
+                                const char* needle, std::size_t m,
+                                std::size_t maxcount)
+{
+    std::size_t result = 0;
+    std::size_t pos = 0;
+
+    if (m == 0) return (n + 1 < maxcount) ? n + 1 : maxcount;
+
+    while (result < maxcount) {
+        std::size_t found = find(haystack + pos, n - pos, needle, m);
+        if (found == npos) break;
+
+        result++;
+        pos += found + m;
+    }
+
+    return result;
+}
@@ -106,7 +106,24 @@ void PyVM::run_toplevel(std::function<void()> f)
     try {
         f();
     } catch (interpreter::InterpError& e) {
-        spdlog::error("{}", space_->unwrap_str(e.get_value()));
+        spdlog::error("{}", space_->unwrap_str(space_->str(e.get_value())));
+    }
+
+    flush_std_files();
+}
+
+/* sys.stdout and sys.stderr are buffered, write out what is left in them
+ * before exiting */
+void PyVM::flush_std_files()
+{
+    for (const char* name : {"stdout", "stderr"}) {
+        try {
+            M_BaseObject* file = space_->findattr_str(space_->get_sys(), name);
+            if (!file) continue;
+            M_BaseObject* flush = space_->findattr_str(file, "flush");
+            if (flush) space_->call_function(&main_thread_, flush, {});
+        } catch (interpreter::InterpError&) {
+        }
     }
 }
 
@@ -0,0 +1,99 @@
+# Microbenchmark of the native str methods against pure-Python versions
+import time
+
+
+def py_find(s, sub):
+    n = len(s)
+    m = len(sub)
+    i = 0
+    while i + m <= n:
+        j = 0
+        while j < m and s[i + j] == sub[j]:
+            j += 1
+        if j == m:
+            return i
+        i += 1
+    return -1
+
+
+def py_count(s, sub):
+    n = 0
+    for c in s:
+        if c == sub:
+            n += 1
+    return n
+
+
+def py_split(s, sep):
+    parts = []
+    chars = []
+    for c in s:
+        if c == sep:
+            parts.append("".join(chars))
+            chars = []
+        else:
+            chars.append(c)
+    parts.append("".join(chars))
+    return parts
+
+
+def py_replace(s, old, new):
+    chars = []
+    for c in s:
+        if c == old:
+            chars.append(new)
+        else:
+            chars.append(c)
+    return "".join(chars)
+
+
+def py_strip(s):
+    start = 0
+    end = len(s)
+    while start < end and s[start] == " ":
+        start += 1
+    while end > start and s[end - 1] == " ":
+        end -= 1
+    chars = []
+    i = start
+    while i < end:
+        chars.append(s[i])
+        i += 1
+    return "".join(chars)
+
+
+def same(result, expected):
+    if not isinstance(result, list):
+        return result == expected
+    if len(result) != len(expected):
+        return False
+    for i in range(len(result)):
+        if result[i] != expected[i]:
+            return False
+    return True
+
+
+def bench(name, native, reference, rounds):
+    t0 = time.perf_counter()
+    for i in range(rounds):
+        expected = reference()
+    t1 = time.perf_counter()
+    for i in range(rounds):
+        result = native()
+    t2 = time.perf_counter()
+    print(name, same(result, expected), (t1 - t0) / (t2 - t1))
+
+
+words = []
+for i in range(400):
+    words.extend(["alpha", "beta", "gamma", "delta", "epsilon"])
+text = " ".join(words)
+padded = "".join(["      ", text, "      "])
+
+bench("find", lambda: text.find("needle"), lambda: py_find(text, "needle"), 5)
+bench("count", lambda: text.count("a"), lambda: py_count(text, "a"), 5)
+bench("split", lambda: text.split(" "), lambda: py_split(text, " "), 5)
+bench("replace", lambda: text.replace(" ", "_"),
+      lambda: py_replace(text, " ", "_"), 5)
+bench("join", lambda: ",".join(words), lambda: py_replace(text, " ", ","), 5)
+bench("strip", lambda: padded.strip(), lambda: py_strip(padded), 5)
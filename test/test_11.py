@@ -0,0 +1,21 @@
+# Testing float arithmetic and repr
+a = 1.5
+b = 2
+print(a + b)
+print(b * a)
+print(b - a)
+print(7 / 2)
+print(-7 // 2)
+print(-7.5 % 2)
+print(0.1 + 0.2)
+print(1e16, 1e-5, 123.456, 100.0)
+print(a < b, b >= a, 2 == 2.0)
+print(float("  3.25 "), float(3), int(2.75))
+print(7 // 2.0, 7 % 2.5, 2 ** 0.5, hash(1e10) == hash(1e10))
+try:
+    int(1e10)
+except OverflowError:
+    print("int(1e10) overflows")
+m = -2147483647 - 1
+print(m % -1, 7 // -1)
+print((1).__add__("a") is NotImplemented, (1.5).__lt__("a") is NotImplemented)
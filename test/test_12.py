@@ -0,0 +1,36 @@
+# Testing operator dispatch through type slots
+class Vec:
+
+    def __init__(self, x):
+        self.x = x
+
+    def __add__(self, other):
+        return Vec(self.x + other.x)
+
+    def __lt__(self, other):
+        return self.x < other.x
+
+    def __len__(self):
+        return self.x
+
+    def __repr__(self):
+        return str(self.x)
+
+
+a = Vec(1)
+b = Vec(2)
+print(a + b, a < b, b > a, len(b))
+
+a += b
+print(a)
+
+def vec_sub(self, other):
+    return Vec(self.x - other.x)
+
+Vec.__sub__ = vec_sub
+print(b - a)
+
+i = 1
+i += 2.5
+print(i)
+print(3 in (1, 2, 3))
@@ -0,0 +1,57 @@
+# Testing dict operations
+d = {}
+for i in range(100):
+    d[i] = i * i
+print(len(d), d[7], d[99])
+
+for i in range(0, 100, 2):
+    del d[i]
+print(len(d), 4 in d, 5 in d)
+
+s = {"b": 1, "a": 2}
+s["c"] = 3
+s[1.0] = "float"
+print(s, s[1], s.get("x"), s.get("x", 0))
+
+total = 0
+for k in d:
+    total = total + d[k]
+print(total)
+
+e = dict(s, z=26)
+print(e.pop("z"), e.setdefault("y", 5), len(e))
+e.clear()
+print(e, dict([(1, 2), (3, 4)]))
+
+class Counter(dict):
+    def total(self):
+        return len(self)
+c = Counter(a=1, b=2)
+c.note = "kept"
+print(type(c) is Counter, isinstance(c, dict), c.total(), c.note, c["b"])
+
+class Key:
+    def __init__(self, v):
+        self.v = v
+    def __hash__(self):
+        return 1
+    def __eq__(self, other):
+        m.clear()
+        return self.v == other.v
+m = {}
+m[Key(1)] = 1
+print(Key(1) in m, len(m))
+
+grow = {1: 1, 2: 2}
+try:
+    for k in grow:
+        grow[k + 10] = k
+except RuntimeError as e:
+    print(e)
+shrink = {1: 1, 2: 2, 3: 3}
+try:
+    for k in shrink:
+        del shrink[k]
+except RuntimeError as e:
+    print(e)
+print(len(grow), len(shrink))
@@ -0,0 +1,15 @@
+# Testing str hashing and interned name lookups
+d = {"alpha": 1, "beta": 2}
+key = str(12)
+d[key] = 3
+print(d["12"], d["alpha"], "beta" in d, "gamma" in d)
+print(hash("alpha") == hash("alpha"), "alpha" == "alpha", "alpha" == "beta")
+
+step = 3
+def bump(n):
+    return n + step
+
+counter = 0
+for i in range(1000):
+    counter = bump(counter)
+print(counter)
@@ -0,0 +1,22 @@
+# Testing str length, indexing and iteration
+s = "hello"
+print(len(s), s[0], s[-1])
+u = "héllo wörld ☃ 𝄞"
+print(len(u), u[1], u[12], u[14], u[-1])
+chars = []
+for c in u:
+    chars.append(c)
+print(len(chars), chars[7], chars[12])
+long = "ababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababababéxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyz"
+print(len(long), long[200], long[201], long[-1])
+
+lone = "a" + chr(0xd800) + "b"
+print(len(lone), lone[2], ord(lone[1]) == 0xd800)
+mixed = ""
+for i in range(70):
+    mixed += "é"
+for i in range(70):
+    mixed += "x"
+mixed = mixed + "€"
+print(len(mixed), mixed[69], mixed[70], mixed[139], mixed[140], mixed.index("€"))
+print(b"a\xc0\xafb".decode("utf-8", "replace") == "a��b")
@@ -0,0 +1,34 @@
+# Testing str search, split, replace, join and strip
+s = "the quick brown fox jumps over the lazy dog"
+print(s.find("the"), s.rfind("the"), s.find("cat"), s.find("o", 20, 30))
+print(s.index("fox"), s.rindex("o"), s.count("o"), s.count(""))
+print("fox" in s, "cat" in s)
+
+try:
+    s.index("cat")
+except ValueError:
+    print("not found")
+
+print(s.split())
+print(s.split(" ", 2))
+print(s.rsplit(" ", 2))
+print("a,b,,c".split(","), "  a  b  ".split(None, 1))
+
+print(s.replace("the", "a"), s.replace("o", "0", 2))
+print("abc".replace("", "-"))
+
+print("-".join(["a", "b", "c"]), ", ".join(("x", "y")), "".join([]))
+try:
+    "-".join(["a", 1])
+except TypeError:
+    print("join error")
+
+print("  hi  ".strip(), "\t\nhi\r".strip())
+print("xxhixx".strip("x"), "xxhixx".lstrip("x"), "xxhixx".rstrip("x"))
+print(s.startswith("the"), s.endswith("dog"), s.startswith(("a", "th")))
+print(s.startswith("quick", 4), s.endswith("lazy", 0, 39))
+
+u = "héllo wörld ünïcode"
+print(u.find("wörld"), u.find("ü"), u.count("l"), len(u.split()))
+print(u.replace("ö", "o"), "·".join(["a", "b"]))
+print("ééhiéé".strip("é"), u.rfind("o"), u.index("c"))
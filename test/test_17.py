@@ -0,0 +1,34 @@
+# Testing str concatenation
+s = "ab" + "cd"
+print(s, len(s))
+
+s = ""
+for i in range(2000):
+    s += "x"
+print(len(s), s.count("x"), s[1999])
+
+t = "é"
+for i in range(300):
+    t += "ü"
+print(len(t), t[0], t[299], t[300], t.find("é"))
+
+parts = ""
+for i in range(100):
+    parts = parts + str(i) + ","
+print(len(parts), parts.split(",")[99])
+
+a = "abc"
+for i in range(200):
+    a += "def"
+b = a
+a += "!"
+print(len(a), len(b), a == b, b.endswith("def"), a.endswith("!"))
+
+d = {}
+d[a] = 1
+print(d[a], hash(a) == hash(a + ""))
+
+try:
+    "a" + 1
+except TypeError:
+    print("TypeError")
@@ -0,0 +1,17 @@
+# Testing tuples
+t = (1, "two", 3.0)
+print(t, len(t), t[1], t[-1], 2 in t, "two" in t)
+print((), (5,), len(()))
+
+e = ()
+print(e is (), len(e), e)
+
+a, b, c = t
+print(a, b, c)
+x, y = [10, 20]
+print(x, y)
+
+for item in (4, 5, 6):
+    print(item)
+
+print(isinstance(1, (str, int)), "abc".startswith(("x", "a")))
@@ -0,0 +1,54 @@
+# Testing container storage growth
+l = []
+for i in range(1000):
+    l.append(i)
+print(len(l), l[0], l[999], l[-1])
+print(l.pop(), l.pop(0), l.pop(500), len(l))
+l.extend([1, 2, 3])
+print(len(l), l[-3], 2 in l)
+
+d = {}
+for i in range(1000):
+    d[i] = i * 2
+for i in range(0, 1000, 2):
+    del d[i]
+print(len(d), d[1], d.get(2), d[999])
+c = d.copy()
+c[1] = "changed"
+print(len(c), c[1], d[1])
+d.clear()
+print(len(d), len(c))
+d["a"] = 1
+print(d)
+
+def count(items):
+    n = 0
+    for x in items:
+        n += 1
+    return n
+
+s = set()
+for i in range(200):
+    s.add(i % 50)
+print(count(s), 49 in s, 50 in s)
+for i in range(25):
+    s.remove(i)
+print(count(s), 10 in s, 30 in s)
+t = set()
+t.add(30)
+print(t <= s, s <= t)
+total = 0
+for x in s:
+    total += x
+print(total)
+
+class Clearing:
+    def __eq__(self, other):
+        del victims[:]
+        return True
+victims = [1, 2, 3]
+try:
+    victims.remove(Clearing())
+except RuntimeError:
+    print("RuntimeError")
+print(victims)
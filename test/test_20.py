@@ -0,0 +1,73 @@
+a = [5, 3, 9, 1, 7, 3, 0, -4, 12]
+a.sort()
+print(a)
+a.sort(reverse=True)
+print(a)
+
+words = ["pear", "apple", "fig", "banana", "kiwi", "cherry"]
+print(sorted(words))
+print(sorted(words, key=len))
+print(sorted(words, key=len, reverse=True))
+
+floats = [2.5, -1.0, 3.25, 0.5]
+floats.sort()
+print(floats)
+
+pairs = [(2, "b"), (1, "z"), (2, "a"), (1, "y")]
+
+def first(p):
+    return p[0]
+
+print(sorted(pairs, key=first))
+print(sorted(pairs, key=first, reverse=True))
+
+print(sorted({3: 1, 1: 2, 2: 3}))
+print(sorted("hello"))
+print(sorted([True, 2, False, 1]))
+
+big = []
+x = 12345
+for i in range(5000):
+    x = (x * 1103 + 12345) % 65536
+    big.append(x)
+big.sort()
+ok = True
+for i in range(1, len(big)):
+    if big[i - 1] > big[i]:
+        ok = False
+print(ok)
+
+runs = []
+for i in range(1000):
+    runs.append(i % 100)
+runs.sort()
+print(runs[0], runs[99], runs[100], runs[999])
+
+try:
+    sorted([1, "a", 2])
+except TypeError:
+    print("TypeError")
+
+lst = [3, 1, 2]
+def mutate(v):
+    lst.append(v)
+    return v
+
+try:
+    lst.sort(key=mutate)
+except ValueError as e:
+    print(e)
+print(lst)
+
+class Boxed:
+    def __init__(self, v):
+        self.v = v
+    def __lt__(self, other):
+        garbage = [Boxed(0) for i in range(20)]
+        return self.v < other.v
+
+vals = []
+for i in range(300):
+    vals.append((i * 7919) % 300)
+vals.sort(key=lambda v: Boxed(v))
+print(vals[:5], vals[-1], len(vals))
@@ -0,0 +1,68 @@
+a = [0, 1, 2, 3, 4, 5, 6, 7, 8, 9]
+print(a[2:5], a[:3], a[7:], a[:], a[::2], a[::-1], a[-3:], a[8:2:-2])
+print(a[100:], a[-100:2], a[5:1])
+
+t = (0, 1, 2, 3, 4, 5)
+print(t[1:4], t[::-2], t[:])
+
+s = slice(1, 8, 3)
+print(s, s.start, s.stop, s.step, s.indices(5))
+print(a[s], slice(4))
+
+b = a[:]
+b[2:5] = ["x", "y"]
+print(b)
+b[1:1] = [10, 11, 12]
+print(b)
+b[::2] = [0, 0, 0, 0, 0, 0]
+print(b)
+b[:] = b
+print(b)
+try:
+    b[::2] = [1]
+except ValueError as e:
+    print(e)
+
+c = a[:]
+del c[2:4]
+print(c)
+del c[::3]
+print(c)
+del c[::-2]
+print(c)
+del c[0]
+print(c)
+c[-1] = 99
+print(c)
+
+print([1, 2] + [3], [1, 2] * 3, 2 * [0], [5] * 0)
+d = [1, 2]
+d *= 3
+print(d)
+d += d
+print(d)
+d.extend(d[:2])
+print(d, len(d))
+
+e = [1, 2, 3]
+e.insert(0, 0)
+e.insert(100, 4)
+e.insert(-1, 3.5)
+print(e)
+print(e.index(3), e.index(2, 1), e.count(2), [1, 1, 2].count(1))
+try:
+    e.index(42)
+except ValueError as err:
+    print(err)
+e.reverse()
+print(e)
+print([1, 2] == [1, 2], [1, 2] == [2, 1], [1] != [1, 2], [] == [])
+
+try:
+    a[10] = 1
+except IndexError as err:
+    print(err)
+
+big = [0] * 100000
+big[10:20] = []
+print(len(big))
@@ -0,0 +1,64 @@
+# Testing set algebra and frozenset
+a = set(range(10))
+b = set(range(5, 15))
+print(sorted(a | b))
+print(sorted(a & b))
+print(sorted(a - b))
+print(sorted(a ^ b))
+print(sorted(a.union([20, 21])), sorted(a.intersection(range(3))))
+print(sorted(a.difference(range(8))), sorted(a.symmetric_difference([0, 99])))
+print(a <= b, a & b <= b, a < a, a <= a, b > b & a, a >= set())
+print(a.issubset(range(20)), a.issuperset([1, 2]), a.isdisjoint([100, 200]))
+print(a == set(range(10)), a != b, a == [1])
+
+s = set()
+for i in range(2000):
+    s.add(i)
+for i in range(0, 2000, 3):
+    s.discard(i)
+print(len(s), 1 in s, 3 in s, 1999 in s)
+for i in range(2000):
+    s.add(i * 7)
+print(len(s), 6993 in s, 13993 in s)
+
+c = a.copy()
+c |= b
+c -= set([0, 1])
+c &= set(range(12))
+print(sorted(c))
+c ^= set([2, 100])
+print(sorted(c))
+c.intersection_update([3, 4, 100])
+print(sorted(c))
+c.update(["x", "y"])
+c.difference_update(["x"])
+c.symmetric_difference_update(["y", "z"])
+print(len(c), "z" in c, "y" in c)
+print(set(), set([1]), frozenset(), frozenset(["a"]))
+
+try:
+    set().pop()
+except KeyError:
+    print("KeyError")
+try:
+    c.remove(12345)
+except KeyError as e:
+    print("KeyError", e)
+
+f = frozenset([1, 2, 3])
+g = frozenset([3, 2, 1])
+print(f == g, hash(f) == hash(g), f == set([1, 2, 3]))
+def mutable(s):
+    try:
+        s.add(0)
+        return True
+    except AttributeError:
+        return False
+
+print(mutable(f | set([4])), mutable(set([4]) | f))
+print(sorted(f - frozenset([1])), frozenset(f) is f)
+d = {f: "frozen"}
+print(d[g])
+print(mutable(f), mutable(set()))
+x = set([f, frozenset([1])])
+print(len(x), g in x)
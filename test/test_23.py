@@ -0,0 +1,101 @@
+# Testing bytes, bytearray, memoryview and buffer-based file I/O
+import _io
+
+b = b"hello world"
+print(b, len(b), b[0], b[-1], b[1:5], b[::2])
+print(b"\x00\xff\n", "caf\xe9", b"ab" b"cd", "x" "y" "z")
+print(b.find(b"o"), b.rfind(b"o"), b.count(b"l"), b.index(b"w"))
+print(b.startswith(b"he"), b.endswith(b"ld"), b"lo w" in b, 104 in b)
+print(b.split(), b.split(b"o"), b"-".join([b"a", b"b", bytearray(b"c")]))
+print(b.replace(b"l", b"L"), b.upper(), b"  x ".strip(), b.hex())
+print(b == b"hello world", b < b"help", b + b"!", b * 2, 2 * b"ab")
+print(bytes(4), bytes([65, 66, 67]), bytes(range(3)), bytes(b"copy"))
+print(hash(b"abc") == hash(bytes([97, 98, 99])))
+print(memoryview(b"abc").tolist())
+
+e = "héllo €".encode("utf-8")
+print(e, len(e), e.decode("utf-8") == "héllo €")
+print("abc".encode("ascii"), "é".encode("latin-1"), bytes("hi", "ascii"))
+try:
+    "é".encode("ascii")
+except UnicodeEncodeError:
+    print("UnicodeEncodeError")
+try:
+    b"\xff".decode("utf-8")
+except UnicodeDecodeError:
+    print("UnicodeDecodeError")
+print(b"a\xffb".decode("utf-8", "replace") == "a�b")
+print(b"a\xffb".decode("ascii", "ignore"))
+try:
+    "x".encode("rot13")
+except LookupError:
+    print("LookupError")
+
+ba = bytearray(b"abc")
+ba.append(100)
+ba.extend(b"ef")
+ba += b"gh"
+print(ba, len(ba), ba[0], ba[1:3])
+ba[0] = 65
+ba[1:3] = b"XYZ"
+print(ba)
+del ba[0]
+del ba[::2]
+print(ba, ba.pop(), ba.pop(0), ba)
+c = ba.copy()
+ba.clear()
+print(ba, c, bytearray(3), bytearray("hé", "utf-8"))
+print(bytearray(b"abc") == b"abc", b"abc" == bytearray(b"abc"))
+try:
+    ba.append(256)
+except ValueError:
+    print("ValueError")
+try:
+    bytes("no encoding")
+except TypeError:
+    print("TypeError")
+
+buf = bytearray(b"0123456789")
+m = memoryview(buf)
+print(len(m), m[0], m[-1], m.nbytes, m.readonly, m.itemsize, m.format)
+s = m[2:8]
+print(s.tobytes(), s[0], len(s), s.contiguous)
+t = s[::2]
+print(t.tobytes(), t.tolist(), t.strides, t.contiguous)
+t[0] = 88
+s[1:3] = b"ab"
+print(buf)
+mm = memoryview(m[5:])
+print(mm.tobytes(), mm.obj is buf)
+print(m == buf, m[:3] == b"X01", m.hex(), bytes(m[4:6]))
+print(memoryview(b"xyz").readonly)
+try:
+    memoryview(b"xyz")[0] = 1
+except TypeError:
+    print("TypeError")
+try:
+    m[0:2] = b"abc"
+except ValueError:
+    print("ValueError")
+with memoryview(b"abc") as r:
+    print(r[1], r.tolist())
+try:
+    len(r)
+except ValueError:
+    print("released")
+try:
+    memoryview("str")
+except TypeError:
+    print("TypeError")
+
+path = "/tmp/mtpython_test_23.bin"
+f = _io.FileIO(path, "w")
+print(f.write(b"0123456789"), f.write(bytearray(b"abc")), f.write(m[:2]))
+f.close()
+print(f.closed)
+f = _io.FileIO(path, "r")
+target = bytearray(4)
+print(f.readinto(target), target)
+print(f.readinto(memoryview(target)[1:3]), target)
+print(f.read(3), f.read())
+f.close()
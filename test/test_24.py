@@ -0,0 +1,83 @@
+# Testing collections.deque
+from _collections import deque
+
+d = deque()
+for i in range(200):
+    d.append(i)
+    d.appendleft(-i)
+print(len(d), d[0], d[-1], d[200], d[199], d[100], d[-150])
+total = 0
+while d:
+    total += d.popleft()
+    if d:
+        total += d.pop()
+print(total, len(d), d)
+
+d = deque([1, 2, 3])
+d.extend([4, 5])
+d.extendleft([0, -1])
+print(d, len(d), 3 in d, 9 in d)
+d.rotate()
+print(d)
+d.rotate(-3)
+print(d)
+d.rotate(100)
+print(d)
+d.reverse()
+print(d, d.count(3), d.index(4))
+d.remove(3)
+del d[0]
+d[1] = 42
+print(d, d == deque([4, 42, 1, 0, -1]), d != deque([2]))
+print(d.copy(), deque(reversed(d)))
+d.clear()
+print(d, d.maxlen)
+
+w = deque(maxlen=3)
+for i in range(10):
+    w.append(i)
+print(w, w.maxlen, w[0] + w[1] + w[2])
+w.appendleft(100)
+print(w)
+w.extend(range(5))
+print(w)
+print(deque(range(10), 0), deque("abc", maxlen=2))
+
+big = deque(range(1000))
+big.rotate(333)
+print(big[0], big[333], big[999], len(big))
+big.rotate(-333)
+ok = True
+for i in range(1000):
+    if big[i] != i:
+        ok = False
+print(ok)
+s = 0
+for x in big:
+    s += x
+print(s)
+big += [1000, 1001]
+print(big[-1], len(big))
+
+d = deque([1, 2, 3])
+try:
+    for x in d:
+        d.append(x)
+except RuntimeError as e:
+    print("RuntimeError", e)
+try:
+    deque().pop()
+except IndexError as e:
+    print("IndexError", e)
+try:
+    d.remove(99)
+except ValueError as e:
+    print("ValueError", e)
+try:
+    d[10]
+except IndexError as e:
+    print("IndexError", e)
+try:
+    deque(maxlen=-1)
+except ValueError as e:
+    print("ValueError", e)
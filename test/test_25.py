@@ -0,0 +1,52 @@
+# Testing defaultdict and _count_elements
+from _collections import defaultdict, _count_elements
+
+d = defaultdict(list)
+d["a"].append(1)
+d["a"].append(2)
+d["b"].append(3)
+print(d["a"], d["b"], len(d), "c" in d, d.get("c"))
+print(d)
+
+words = "the quick brown fox jumps over the lazy dog the end".split()
+counts = defaultdict(int)
+for w in words:
+    counts[w] += 1
+print(counts["the"], counts["fox"], counts["missing"], len(counts))
+print(counts.default_factory, d.default_factory)
+
+n = defaultdict()
+try:
+    n["x"]
+except KeyError:
+    print("KeyError")
+print(n.default_factory)
+n.default_factory = lambda: 42
+print(n["y"], len(n))
+
+e = defaultdict(int, {"a": 1}, b=2)
+print(e["a"], e["b"], e["c"], sorted(e.keys()))
+c = e.copy()
+c["z"] += 5
+print(c["z"], "z" in e, c.default_factory)
+print(e.__missing__("q"), e["q"])
+try:
+    defaultdict(5)
+except TypeError as exc:
+    print("TypeError", exc)
+
+h = {}
+_count_elements(h, words)
+print(h["the"], h["dog"], len(h))
+_count_elements(h, ["the", "new"])
+print(h["the"], h["new"])
+nums = {}
+_count_elements(nums, range(100))
+print(len(nums), nums[3])
+mod = {}
+_count_elements(mod, [1, 2, 2, 3, 3, 3, 1.5, 1.5, "x"])
+print(mod[1], mod[2], mod[3], mod[1.5], mod["x"])
+
+dd = defaultdict(int)
+_count_elements(dd, "mississippi")
+print(dd["s"], dd["i"], dd["p"], dd["m"], dd["z"])
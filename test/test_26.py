@@ -0,0 +1,78 @@
+# Testing itertools
+from itertools import count, islice, chain, repeat, cycle, accumulate
+from itertools import groupby, product, permutations, combinations, tee
+from itertools import zip_longest
+
+print(list(islice(count(), 5)))
+print(list(islice(count(10, 3), 2, 8, 2)))
+print(list(islice(count(1.5, 0.5), 3)))
+print(count(5), count(1, 2), repeat("a", 3), repeat(1))
+print(list(islice("abcdefg", 2, None)), list(islice("abcdefg", None)))
+print(list(islice(range(10), 1, 9, 3)), list(islice([], 3)))
+try:
+    islice("abc", -1)
+except ValueError as e:
+    print("ValueError", e)
+try:
+    islice("abc", 0, 2, 0)
+except ValueError as e:
+    print("ValueError", e)
+
+
+def gen(n):
+    i = 0
+    while i < n:
+        yield i
+        i += 1
+
+
+print(list(chain([1, 2], "ab", gen(3))), list(chain()))
+print(list(chain.from_iterable([[1], [2, 3], [], "xy"])))
+it = chain([1])
+print(it.__next__())
+try:
+    it.__next__()
+except StopIteration:
+    print("StopIteration")
+
+print(list(repeat(7, 3)), list(repeat(7, -1)), list(islice(repeat(0), 2)))
+print(list(islice(cycle("abc"), 7)), list(cycle([])))
+print(list(islice(cycle(gen(2)), 5)))
+
+print(list(accumulate([1, 2, 3, 4])), list(accumulate([])))
+print(list(accumulate([1, 2, 3], lambda a, b: a * b)))
+print(list(accumulate([1, 2], initial=10)), list(accumulate([], initial=5)))
+
+for k, g in groupby("aaabccdd"):
+    print(k, list(g))
+words = ["apple", "avocado", "banana", "blueberry", "cherry"]
+for k, g in groupby(words, lambda w: w[0]):
+    print(k, len(list(g)))
+groups = list(groupby([1, 1, 2, 2, 2, 3]))
+print(len(groups), groups[0][0], list(groups[0][1]), list(groups[2][1]))
+
+print(list(product("ab", range(2))))
+print(list(product([0, 1], repeat=2)), list(product()), list(product([], [1])))
+print(len(list(product(range(3), range(3), range(3)))))
+print(list(permutations("abc", 2)))
+print(list(permutations(range(3))), list(permutations("ab", 3)))
+print(list(combinations(range(4), 3)), list(combinations("abc", 0)))
+print(list(combinations("ab", 3)), len(list(combinations(range(10), 4))))
+
+a, b = tee(iter(range(5)))
+print(list(a), list(b))
+a, b, c = tee(range(200), 3)
+print(list(islice(a, 3)), len(list(b)), list(islice(a, 2)))
+print(sorted(list(c))[199], tee([1], 0))
+d = a.__copy__()
+print(list(islice(a, 2)), list(islice(d, 2)))
+
+print(list(zip_longest("abc", [1], fillvalue="-")))
+print(list(zip_longest([1, 2], "xyz")), list(zip_longest()))
+
+total = 0
+for x, y in zip_longest(islice(count(), 4), repeat(10, 2), fillvalue=0):
+    total += x * y
+print(total)
+pipeline = accumulate(chain.from_iterable(repeat(range(3), 3)))
+print(list(pipeline))
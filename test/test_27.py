@@ -0,0 +1,41 @@
+import heapq
+import bisect
+
+h = []
+for x in [5, 1, 8, 3, 9, 2, 7]:
+    heapq.heappush(h, x)
+print(h[0])
+out = []
+while h:
+    out.append(heapq.heappop(h))
+print(out)
+
+h = ["pear", "apple", "fig", "kiwi"]
+heapq.heapify(h)
+print(heapq.heappop(h), heapq.heappop(h))
+print(heapq.heapreplace(h, "banana"))
+print(heapq.heappushpop(h, "aaa"))
+print(heapq.heappushpop(h, "zzz"))
+print(h)
+
+h = [3.5, 1.25, 2.0]
+heapq.heapify(h)
+print(heapq.heappop(h))
+
+try:
+    heapq.heappop([])
+except IndexError:
+    print("empty")
+
+import _heapq
+print(_heapq.nlargest(3, [4, 9, 1, 7, 3, 8]))
+print(_heapq.nsmallest(2, [4, 9, 1, 7, 3, 8]))
+
+a = [1, 2, 4, 4, 8]
+print(bisect.bisect_left(a, 4), bisect.bisect_right(a, 4), bisect.bisect(a, 5))
+print(bisect.bisect_left(a, 4, 3), bisect.bisect_right(a, 4, 0, 2))
+bisect.insort(a, 3)
+bisect.insort_left(a, 0)
+bisect.insort_right(a, 9)
+print(a)
+print(bisect.bisect_right("abdf", "c"))
@@ -0,0 +1,92 @@
+from _functools import partial, reduce, _lru_cache_wrapper
+
+
+def cache_info(hits, misses, maxsize, currsize):
+    return (hits, misses, maxsize, currsize)
+
+
+def lru_cache(maxsize=128, typed=False):
+    def decorating_function(user_function):
+        return _lru_cache_wrapper(user_function, maxsize, typed, cache_info)
+    return decorating_function
+
+
+def add(a, b, c=0):
+    return a + b * 10 + c * 100
+
+
+p = partial(add, 1)
+print(p(2), p(2, c=3), p.args, p.keywords)
+q = partial(p, 4, c=5)
+print(q(), q(c=6), q.func is add, q.args)
+print(partial(add, b=2)(3))
+print(str(partial(int, "5", c=2)))
+try:
+    partial(1)
+except TypeError:
+    print("not callable")
+
+print(reduce(add, [1, 2, 3]), reduce(add, [], 7), reduce(add, "", "x"))
+try:
+    reduce(add, [])
+except TypeError:
+    print("empty")
+
+calls = []
+
+
+@lru_cache(maxsize=None)
+def fib(n):
+    calls.append(n)
+    if n < 2:
+        return n
+    return fib(n - 1) + fib(n - 2)
+
+
+print(fib(25), len(calls), fib.cache_info())
+
+
+@lru_cache(maxsize=2)
+def square(x):
+    calls.append(x)
+    return x * x
+
+
+calls = []
+print(square(2), square(3), square(2), square(4), square(3))
+print(calls, square.cache_info())
+square.cache_clear()
+print(square.cache_info())
+
+
+@lru_cache(typed=True)
+def kind(x, y=1):
+    calls.append(x)
+    return x
+
+
+calls = []
+kind(1)
+kind(1.0)
+kind(1)
+kind(1, y=2)
+kind(1, y=2)
+kind("a")
+kind("a")
+print(len(calls), kind.cache_info())
+
+
+class C:
+    @lru_cache()
+    def method(self, x):
+        calls.append(x)
+        return x + 1
+
+
+calls = []
+c = C()
+print(c.method(1), c.method(1), calls)
+
+uncached = lru_cache(0)(square)
+uncached(1)
+print(uncached.cache_info())
@@ -0,0 +1,82 @@
+from array import array
+
+a = array('i', [3, 1, 4, 1, 5, 9, 2, 6])
+print(a)
+print(len(a), a.typecode, a.itemsize)
+print(a[0], a[-1], a[2:5], a[::3])
+print(sum(a), min(a), max(a), sum(a, 10))
+print(a.count(1), a.index(9), 5 in a, 7 in a)
+
+a.append(-7)
+a.insert(0, 100)
+a.extend([8, 8])
+print(a.pop(), a.pop(0), a)
+a.remove(1)
+a.reverse()
+print(a.tolist())
+del a[1:3]
+a[0] = 42
+print(a)
+
+b = array('b', [1, -2, 3])
+print(b + array('b', [4]), b * 2)
+b += b
+print(b, b == array('b', [1, -2, 3, 1, -2, 3]), b < array('b', [1, -1]))
+
+d = array('d', [1.5, -0.25, 8.0])
+print(sum(d), min(d), max(d), d.index(8), d.count(1.5))
+
+raw = array('h', [1, 2, 258]).tobytes()
+h = array('h')
+h.frombytes(raw)
+print(h, len(raw))
+h.byteswap()
+print(h)
+
+m = memoryview(array('H', [7, 65535]))
+print(m.format, m.itemsize, m[1])
+
+class File:
+    def __init__(self):
+        self.data = b''
+
+    def write(self, data):
+        self.data = self.data + data
+
+    def read(self, n):
+        return self.data
+
+f = File()
+array('I', [1, 2, 3]).tofile(f)
+c = array('I')
+c.fromfile(f, 3)
+print(c)
+try:
+    c.fromfile(f, 4)
+except EOFError:
+    print("eof", len(c))
+
+try:
+    array('B', [1]).append(-1)
+except OverflowError:
+    print("overflow")
+try:
+    array('i', [1]).append(1.5)
+except TypeError:
+    print("type")
+try:
+    array('z')
+except ValueError:
+    print("bad typecode")
+
+print(sum([1, 2, 3]), sum([1, 2.5]), sum([[1], [2]], []))
+print(min(3, 1, 2), max([4, 9, 2]), max([], default=0))
+print(min(["bb", "a", "ccc"], key=len), max("abc"))
+try:
+    min([])
+except ValueError:
+    print("empty")
+try:
+    sum(["a"], "")
+except TypeError:
+    print("strings")
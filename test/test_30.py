@@ -0,0 +1,51 @@
+import struct
+
+print(struct.calcsize("<iHb"), struct.calcsize("@bi"), struct.calcsize("3s2x"))
+data = struct.pack("<iHb", -2, 513, 7)
+print(data, len(data))
+print(struct.unpack("<iHb", data))
+print(struct.unpack(">hh", b'\x01\x02\xff\xfe'))
+print(struct.pack("!I", 258), struct.pack("@bi", 1, 2))
+print(struct.pack("<d", 1.5), struct.unpack("<f", struct.pack("<f", 0.25)))
+print(struct.pack("?c4s", True, b'z', b'ab'), struct.unpack("5p", b'\x03abcd'))
+
+s = struct.Struct("<hi")
+print(s.size, s.format)
+records = s.pack(1, 100) + s.pack(-1, 200) + s.pack(3, 300)
+print(s.unpack_from(records, 6), struct.unpack_from("<hi", records, offset=12))
+for rec in s.iter_unpack(records):
+    print(rec)
+for rec in struct.iter_unpack("<b", b'\x01\xff'):
+    print(rec)
+
+buf = bytearray(8)
+struct.pack_into("<hh", buf, 2, 5, -5)
+s.pack_into(buf, 0, 9, 1)
+print(buf)
+
+try:
+    struct.pack("<b", 200)
+except struct.error:
+    print("range")
+try:
+    struct.pack("<i", "x")
+except struct.error:
+    print("not an integer")
+try:
+    struct.unpack("<i", b'12')
+except struct.error:
+    print("short")
+try:
+    struct.pack("<ii", 1)
+except struct.error:
+    print("count")
+try:
+    struct.calcsize("<z")
+except struct.error:
+    print("bad char")
+try:
+    s.unpack_from(records, 14)
+except struct.error:
+    print("offset")
+struct._clearcache()
+print(struct.unpack(b"<H", b'\x00\x01'))
@@ -0,0 +1,105 @@
+import _json
+
+print(_json.scanstring('"abc" tail', 1))
+s, end = _json.scanstring('x = "a\\n\\"b\\u00e9\\ud83d\\ude00"', 5)
+print(s, end)
+s, end = _json.scanstring('"tab\there"', 1, False)
+print(s, end)
+print(_json.encode_basestring_ascii('café "q" \\ \n \x01 😀'))
+print(_json.encode_basestring('café "q" \t'))
+
+
+def parse_constant(name):
+    return "const " + name
+
+
+def pairs(items):
+    return items
+
+
+class Context:
+    def __init__(self):
+        self.strict = True
+        self.object_hook = None
+        self.object_pairs_hook = None
+        self.parse_float = float
+        self.parse_int = int
+        self.parse_constant = parse_constant
+
+
+ctx = Context()
+scan = _json.make_scanner(ctx)
+doc = '{"a": [1, 2.5, -3e2, true, false, null], "b": {"c": "d"}, "a2": []}'
+value, end = scan(doc, 0)
+print(value["a"], value["b"], value["a2"], end, len(doc))
+print(scan('  [ NaN , Infinity,-Infinity ]', 2))
+print(scan('[{"k": 1}, {"k": 2}]', 0))
+print(scan('x 123', 2))
+
+ctx.object_pairs_hook = pairs
+ctx.parse_int = float
+pair_scan = _json.make_scanner(ctx)
+print(pair_scan('{"x": 1, "y": {"z": 2}}', 0))
+
+try:
+    scan('{"a" 1}', 0)
+except ValueError as e:
+    print(e)
+try:
+    scan('[1,\n 2 x]', 0)
+except ValueError as e:
+    print(e)
+try:
+    scan('[1, ]', 0)
+except ValueError as e:
+    print(e)
+try:
+    scan('{"a": 1,}', 0)
+except ValueError as e:
+    print(e)
+try:
+    _json.scanstring('"abc', 1)
+except ValueError as e:
+    print(e)
+try:
+    _json.scanstring('"a\\qb"', 1)
+except ValueError as e:
+    print(e)
+try:
+    scan('@', 0)
+except StopIteration:
+    print("no value")
+
+
+def default(o):
+    return "set of " + str(len(o))
+
+
+enc = _json.make_encoder({}, default, _json.encode_basestring_ascii, None,
+                         ': ', ', ', False, False, True)
+print("".join(enc({"a": [1, 2.5, None, True], "b": "é", "c": (1, "x")}, 0)))
+print("".join(enc([{}, [], float("inf"), -0.0, 1e100, set([1, 2])], 0)))
+
+sorted_enc = _json.make_encoder(None, default, _json.encode_basestring, None,
+                                ':', ',', True, True, True)
+print("".join(sorted_enc({"b": 1, "a": "é", "c": [None]}, 0)))
+skip_enc = _json.make_encoder(None, default, _json.encode_basestring, None,
+                              ':', ',', False, True, True)
+print("".join(skip_enc({3: 4, (1,): 5, 1.5: 2, None: 0, True: 1}, 0)))
+
+strict_enc = _json.make_encoder({}, default, _json.encode_basestring, None,
+                                ':', ',', False, False, False)
+try:
+    strict_enc([float("nan")], 0)
+except ValueError as e:
+    print(e)
+cycle = [1]
+cycle.append(cycle)
+try:
+    enc(cycle, 0)
+except ValueError as e:
+    print(e)
+try:
+    enc({(1,): 2}, 0)
+except TypeError as e:
+    print(e)
@@ -0,0 +1,97 @@
+import re
+
+print(re.match(r"a(b|c)*d", "abcbd"))
+print(re.match(r"a+", "baaa"), re.search(r"a+", "baaa"))
+print(re.fullmatch(r"\d+", "123"), re.fullmatch(r"\d+", "123x"))
+
+m = re.search(r"(?P<area>\d{3})-(?P<num>\d{4})(x)?", "tel: 555-1234 ok")
+print(m.group(), m.group(1), m.group("num"), m.group(1, "num", 3))
+print(m.groups(), m.groups("-"), m.groupdict()["area"], len(m.groupdict()))
+print(m.span(), m.start("num"), m.end(2), m.lastindex, m.lastgroup)
+print(m.string, m.pos, m.endpos, m.regs, m.re.pattern)
+print(m.expand(r"\g<num>/\1"))
+
+print(re.findall(r"\w+", "hello big, wide world"))
+print(re.findall(r"(\w)(\d)", "a1 b2 c3 d"))
+print(re.findall(r"x(y)?", "xy x xy"))
+print([m.span() for m in re.finditer(r"o+", "foo boo zoooo")])
+
+print(re.sub(r"\s+", " ", "a   b \t c\n d"))
+print(re.sub(r"(\w+)@(\w+)", r"\2 at \1", "joe@home, ann@work"))
+print(re.sub(r"\d", lambda m: str(int(m.group()) * 2), "a1b2c3"))
+print(re.subn(r"o", "0", "foo boo", count=3))
+print(re.split(r",\s*", "a, b,c,  d"))
+print(re.split(r"(-)", "1-2-3", maxsplit=1))
+print(re.split(r"x*", "axbc"))
+
+# alternation, lazy and bounded repeats, backreferences
+print(re.match(r"(foo|foobar)baz", "foobarbaz").groups())
+print(re.match(r"<.*?>", "<a><b>").group(), re.match(r"<.*>", "<a><b>").group())
+print(re.match(r"(ab){2,3}", "abababab").group(), re.match(r"a{2}?", "aaa"))
+print(re.match(r"(a*)+b", "aaab").groups(), re.match(r"(a|b)*?c", "abac"))
+print(re.match(r"(\w+) \1", "hey hey you").group())
+print(re.match(r"(?i)(\w+) \1", "Hey HEY").group())
+print(re.match(r"(a)?(?(1)b|c)", "ab").group(), re.match(r"(a)?(?(1)b|c)", "c"))
+
+# anchors, lookarounds and classes
+print(re.findall(r"^\w+$", "one\ntwo\nthree", re.M))
+print(re.findall(r"\bcat\b", "cat concat cat."))
+print(re.findall(r"\Bon\B", "onion bonbon on"))
+print(re.findall(r"\d+(?=px)", "10px 20em 30px"))
+print(re.findall(r"(?<!\$)\b\d+", "$10 20 $30 40"))
+print(re.findall(r"(?<=@)\w+", "a@b c@dd"))
+print(re.findall(r"[^aeiou\s]+", "hello world"))
+print(re.findall(r"[a-fA-F0-9]+", "0x1F zz beef"))
+print(re.findall(r".", "a\nb"), len(re.findall(r"(?s).", "a\nb")))
+print(re.search(r"a$", "ba\n"), re.search(r"a\Z", "ba\n"))
+
+# case folding and non-ASCII subjects
+print(re.findall(r"(?i)straße", "STRASSE Straße STRAßE"))
+print(re.findall(r"(?i)[é-ë]+", "CAFÉ café ÊË"))
+print(re.findall(r"\w+", "naïve café 日本語 x_y"))
+print(re.findall(r"(?a)\w+", "naïve café"))
+print(re.sub(r"é", "e", "été à côté"))
+print(re.search(r"本(.)", "日本語").group(1), re.search(r"本(.)", "日本語").span())
+
+# bytes patterns
+print(re.findall(rb"\d+", b"a12b345"))
+print(re.sub(rb"[aeiou]", b"_", bytearray(b"education")))
+print(re.match(rb"(?i)ABC", b"abcd").group())
+try:
+    re.match(r"a", b"a")
+except TypeError as e:
+    print(e)
+try:
+    re.match(rb"a", "a")
+except TypeError as e:
+    print(e)
+
+# scanner, escape and errors
+scanner = re.Scanner([(r"\d+", lambda s, t: int(t)), (r"\s+", None),
+                      (r"[a-z]+", lambda s, t: t + t)])
+print(scanner.scan("12 abc 7 x!"))
+print(re.escape("a.b*c"))
+try:
+    re.compile(r"(ab")
+except re.error as e:
+    print("error:", e)
+try:
+    m.group(7)
+except IndexError as e:
+    print(e)
+
+p = re.compile(r"(?P<key>\w+)=(?P<value>[^;]*)")
+print(p.groups, p.groupindex["value"], p.flags & re.IGNORECASE)
+print(dict(p.findall("a=1;bb=two;c=")))
+print(p.search("   k=v", 2), p.search("   k=v", 4), p.match("k=v", 0, 2))
+print(re.compile("abc") is re.compile("abc"))
+haystack = "".join(["hay"] * 1000 + ["needle"] + ["hay"] * 1000)
+print(len(re.findall(r"needle", haystack)))
+
+# 32-bit code words: charset bitmaps with the top bit set, big charsets,
+# nested unbounded repeats and bounds above 65535
+print(re.findall(r"[?_\xff]", "a?b_c\xff"))
+print(re.findall("[ąćęłńóśźż]+", "zażółć gęślą"))
+print(re.search(r"(?:a*)*b(?:c+)+d", "xxaabccd").span())
+print(re.match(r"a{2,100000}", "aaa").group())
+print(re.search(r"abc", "xxabcx").span())
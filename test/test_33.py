@@ -0,0 +1,34 @@
+def classify(exc):
+    try:
+        raise exc
+    except KeyError:
+        return "key"
+    except IndexError:
+        return "index"
+    except ValueError as e:
+        return "value: " + str(e)
+    except ZeroDivisionError:
+        return "zero"
+
+
+print(classify(KeyError("k")))
+print(classify(IndexError("i")))
+print(classify(ValueError("v")))
+print(classify(ZeroDivisionError("z")))
+
+# the stack stays balanced across many unmatched clauses
+total = 0
+for i in [1, 2, 3, 4, 5]:
+    try:
+        if i % 2:
+            raise ValueError(i)
+        raise KeyError(i)
+    except IndexError:
+        total += 100
+    except TypeError:
+        total += 100
+    except KeyError:
+        total += 10
+    except ValueError:
+        total += 1
+print(total)
@@ -0,0 +1,26 @@
+# comprehensions nested in expressions the symtable has to descend into
+
+
+def compare(items):
+    return [x for x in items] == [y for y in items]
+
+
+def ifexp(items, flag):
+    return [x for x in items] if flag else [x * 2 for x in items]
+
+
+def unary(items):
+    return not [x for x in items if x > 10]
+
+
+def raising(items):
+    try:
+        raise ValueError([x + 1 for x in items])
+    except ValueError as e:
+        return e.args[0]
+
+
+print(compare([1, 2, 3]))
+print(ifexp([1, 2], True), ifexp([1, 2], False))
+print(unary([1, 2]), unary([20]))
+print(raising([1, 2]))
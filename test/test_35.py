@@ -0,0 +1,68 @@
+import math
+import _random
+
+print(math.pi, math.e)
+print(math.sqrt(2.0), math.sqrt(16), math.exp(1), math.log(100, 10))
+print(math.log(8, 2), math.log2(1024), math.log10(0.001), math.log1p(0.0))
+print(math.sin(0.5), math.cos(0.5), math.tan(0.5), math.atan2(1, -1))
+print(math.hypot(3, 4), math.copysign(2.0, -0.0), math.fmod(7.5, 2))
+print(math.floor(-2.5), math.ceil(2.1), math.trunc(-7.9), math.floor(3))
+print(math.degrees(math.pi), math.radians(180.0))
+print(math.frexp(40.0), math.ldexp(0.625, 6), math.modf(-3.25))
+print(math.isnan(float("nan")), math.isinf(float("-inf")), math.isfinite(1))
+print(math.gamma(5), abs(math.lgamma(10.0) - math.log(362880)) < 1e-12)
+print(math.erf(0.5), math.erfc(0.5))
+print(math.factorial(10), math.isqrt(99), math.isqrt(2147395600))
+print(math.fsum([0.1] * 10), sum([0.1] * 10))
+print(math.fsum([1e100, 1.0, -1e100, 1e-100, 1e50, -1.0, -1e50]))
+print(math.fsum([1.0, float("inf")]), math.fsum(x / 4 for x in range(9)))
+for f, arg in [(math.sqrt, -1.0), (math.log, 0), (math.exp, 1000.0),
+               (math.factorial, -1), (math.isqrt, -4), (math.gamma, 0)]:
+    try:
+        f(arg)
+    except ValueError as e:
+        print("ValueError", e)
+    except OverflowError as e:
+        print("OverflowError", e)
+try:
+    math.fsum([float("inf"), float("-inf")])
+except ValueError as e:
+    print("ValueError", e)
+try:
+    math.sqrt("x")
+except TypeError as e:
+    print("TypeError", e)
+
+r = _random.Random(42)
+print(r.random(), r.random(), r.getrandbits(16))
+r.seed(12345)
+print([r.getrandbits(8) for i in range(6)])
+state = r.getstate()
+a = [r.random() for i in range(3)]
+r.setstate(state)
+print(a == [r.random() for i in range(3)])
+r.seed(-7)
+x = r.random()
+r.seed(7)
+print(x == r.random())
+
+r.seed(2024)
+print(r.sample(range(20), 5), r.sample("abcdefgh", 3))
+print(r.sample(list(range(1000)), 4))
+print(r.choices("abc", k=6))
+print(r.choices(["x", "y", "z"], [1, 0, 3], k=5))
+print(r.choices(range(4), cum_weights=[1, 2, 3, 10], k=5))
+try:
+    r.sample([1, 2], 3)
+except ValueError:
+    print("ValueError")
+
+
+class MyRandom(_random.Random):
+    def coin(self):
+        return "heads" if self.random() < 0.5 else "tails"
+
+
+m = MyRandom(42)
+m.note = "kept"
+print(m.coin(), m.note, isinstance(m, _random.Random))
@@ -0,0 +1,82 @@
+# Testing buffered binary I/O
+import _io
+
+path = "/tmp/mtpython_test_36.bin"
+lines = [b"first line\n", b"\n", b"x" * 50 + b"\n", b"no newline at end"]
+text = b"".join(lines) + b" " + b"".join(lines)
+with _io.open(path, "wb") as f:
+    print(isinstance(f, _io.BufferedWriter), f.writable(), f.name == path)
+    for line in lines:
+        f.write(line)
+    f.write(b" " + b"".join(lines))
+    f.write(bytearray(b""))
+    f.flush()
+print(f.closed)
+
+with _io.open(path, "rb") as f:
+    print(isinstance(f, _io.BufferedReader), f.readable())
+    print(f.peek()[:5], f.read(5), f.read1(6), f.readline())
+    print(f.readline(), f.readline(10), f.readline())
+    print(f.read())
+    print(f.read(), f.readline(), f.read1(), f.peek())
+
+with _io.open(path, "rb") as f:
+    print(list(f) == lines[:3] + [lines[3] + b" " + lines[0]] + lines[1:])
+
+with _io.open(path, "rb") as f:
+    print(f.read() == text)
+
+# tiny buffers force refills and unbuffered large requests
+raw = _io.FileIO(path, "r")
+f = _io.BufferedReader(raw, 4)
+print(f.read(3), f.read(10), f.readline())
+a = f.read1(2)
+b = f.read1(20)
+print(0 < len(a) <= 2, 0 < len(b) <= 20, a + b + f.read(22 - len(a + b)))
+target = bytearray(7)
+print(f.readinto(target), target)
+view = memoryview(target)[2:5]
+print(f.readinto(view), target)
+print(f.readline(3), f.readline(), len(f.read(-1)))
+print(f.readinto(bytearray(3)), f.read(2))
+f.close()
+print(f.closed, raw.closed)
+try:
+    f.read()
+except ValueError:
+    print("ValueError")
+
+# coalesced writes larger and smaller than the buffer
+raw = _io.FileIO(path, "w")
+w = _io.BufferedWriter(raw, 8)
+print(w.write(b"abc"), w.write(b"defgh"), w.write(b"i"))
+print(w.write(b"0123456789ABCDEF"), w.write(memoryview(b"zyxwvutsrqp")[2:]))
+w.close()
+w.close()
+with _io.open(path, "rb", 0) as f:
+    print(isinstance(f, _io.FileIO), f.read())
+
+big = bytes(range(256)) * 100
+with _io.open(path, "wb") as f:
+    for i in range(0, len(big), 1000):
+        f.write(big[i:i + 1000])
+with _io.open(path, "rb") as f:
+    data = f.read()
+    print(len(data), data == big)
+with _io.open(path, "rb") as f:
+    chunks = []
+    while True:
+        chunk = f.read(3000)
+        if not chunk:
+            break
+        chunks.append(chunk)
+    print(len(chunks), b"".join(chunks) == big)
+
+try:
+    _io.BufferedReader(_io.FileIO(path, "r"), 0)
+except ValueError:
+    print("ValueError")
+try:
+    _io.open(path, "r", 0)
+except ValueError:
+    print("ValueError")
@@ -0,0 +1,122 @@
+# Testing text I/O with incremental UTF-8 decoding and universal newlines
+import _io
+
+path = "/tmp/mtpython_test_37.txt"
+
+
+def show(s):
+    # str repr doesn't escape control characters yet
+    return "<" + s.replace("\r", "\\r").replace("\n", "\\n") + ">"
+
+
+def show_all(lines):
+    return " ".join([show(line) for line in lines])
+
+
+with _io.open(path, "w") as f:
+    print(f.encoding, f.writable(), f.readable())
+    print(f.write("héllo wörld\n"), f.write("€uro\r\nmac\rend"))
+    f.write("\n" + "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxx" + "\n" + "日本語のテキスト\n")
+print(f.closed)
+
+with _io.open(path) as f:
+    print(f.readline(), f.readline(), f.readline())
+    print(f.readline(), f.readline(), show(f.readline()), show(f.readline()))
+
+with _io.open(path) as f:
+    print([len(line) for line in f])
+
+with _io.open(path, "r", newline="") as f:
+    print(show_all(list(f)))
+with _io.open(path, "r", -1, None, None, "\r") as f:
+    print(show_all(list(f)))
+with _io.open(path, "r", -1, None, None, "\n") as f:
+    print(show_all(list(f)))
+with _io.open(path, "r", -1, None, None, "\r\n") as f:
+    print(show_all(list(f)))
+
+with _io.open(path) as f:
+    print(f.read(3), f.read(10), f.readline(4), f.readline(2))
+    print(show(f.read()))
+    print(show(f.read()), show(f.readline()))
+
+# a 3 byte buffer splits characters and \r\n between chunks
+raw = _io.FileIO(path, "r")
+f = _io.TextIOWrapper(_io.BufferedReader(raw, 3))
+print(list(f) == list(_io.open(path)))
+f.close()
+print(f.closed, raw.closed)
+raw = _io.FileIO(path, "r")
+f = _io.TextIOWrapper(_io.BufferedReader(raw, 2), "utf-8", None, "")
+print(f.read(2), f.read(11), f.read(5), show(f.readline()), f.read(7))
+f.close()
+
+# streams other than BufferedReader are read with read1()
+class Chunks:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+        self.closed = False
+    def read1(self, n):
+        chunk = self.data[self.pos:self.pos + 3]
+        self.pos += 3
+        return chunk
+    def read(self):
+        rest = self.data[self.pos:]
+        self.pos = len(self.data)
+        return rest
+    def close(self):
+        self.closed = True
+    def readable(self):
+        return True
+    def writable(self):
+        return False
+    def seekable(self):
+        return False
+    def flush(self):
+        pass
+
+data = "ab\r\ncd\ré€\nlast".encode("utf-8")
+f = _io.TextIOWrapper(Chunks(data))
+print(show_all(list(f)))
+f = _io.TextIOWrapper(Chunks(data))
+print(f.readline(), show(f.read()))
+f.close()
+
+with _io.open(path, "w", -1, "latin-1", None, "\r\n") as f:
+    f.write("café\nau lait\n")
+with _io.open(path, "rb") as f:
+    print(f.read())
+with _io.open(path, "r", -1, "latin-1") as f:
+    print(show_all(list(f)))
+
+with _io.open(path, "wb") as f:
+    f.write(b"ok\n\xff\xfe bad\n")
+with _io.open(path) as f:
+    try:
+        f.readline()
+        f.readline()
+    except UnicodeDecodeError:
+        print("UnicodeDecodeError")
+with _io.open(path, "r", -1, "utf-8", "replace") as f:
+    print(f.read() == "ok\n�� bad\n")
+
+try:
+    _io.open(path, "r", -1, "rot13")
+except LookupError:
+    print("LookupError")
+try:
+    _io.open(path, "r", -1, None, None, "x")
+except ValueError:
+    print("ValueError")
+with _io.open(path, "w") as f:
+    try:
+        f.write(b"bytes")
+    except TypeError:
+        print("TypeError")
+f = _io.open(path)
+f.close()
+try:
+    f.read()
+except ValueError:
+    print("ValueError")